@@ -23,8 +23,10 @@
 
 #import "UBKAccessibilityConstants.h"
 #import "UBKAccessibilityColours.h"
+#import "UBKRuleProfile.h"
+#import "UBKColourVision.h"
 
-@class UBKAccessibilityWindow, UBKAccessibilityInspectorViewController, UBKNavigationController, UBKAccessibilityInspectorContainerView, UBKAccessibilityProperty, UBKAccessibilityValidColour, UBKAccessibilityFilter;
+@class UBKAccessibilityWindow, UBKAccessibilityInspectorViewController, UBKNavigationController, UBKAccessibilityInspectorContainerView, UBKAccessibilityProperty, UBKAccessibilityValidColour, UBKAccessibilityFilter, UBKAccessibilitySnapshot, UBKAccessibilitySessionRecorder, UBKAccessibilityAuditCache, UBKAccessibilitySection, UBKAccessibilityTargetSpacing, UBKAccessibilityReadingOrder, UBKAccessibilityVisibility, UBKAccessibilityLabels, UBKAccessibilityMetrics, UBKAccessibilityHierarchyWalker, UBKAccessibilitySubtreeGroups, UBKAccessibilityAppearances, UBKAccessibilityColourVision, UBKAccessibilityScreenPasses, UBKAccessibilityComponentAudit;
 
 @interface UBKAccessibilityManager : NSObject
 
@@ -37,6 +39,63 @@
 //All ui elements are passed through the Accessibility filter to either show or hide it while navigating the accessibility inspector.
 @property (nonatomic) UBKAccessibilityFilter *accessibilityFilter;
 
+//Snapshot of the window hierarchy from the last call to configureAllUIElments.
+@property (nonatomic, readonly) UBKAccessibilitySnapshot *currentSnapshot;
+
+//Screen level passes run on currentSnapshot, the current* results below come from these.
+@property (nonatomic, readonly) UBKAccessibilityScreenPasses *currentPasses;
+
+//Audit results from the last refresh, unchanged subtrees are reused between refreshes. Holds the reused and recomputed node counts.
+@property (nonatomic, readonly) UBKAccessibilityAuditCache *auditCache;
+
+//Skip elements that can't be seen, ie clipped by a scroll view or clipsToBounds ancestor, off screen or fully covered by opaque views. Default on.
+@property (nonatomic) BOOL isCullingInvisibleElements;
+
+//Visibility results for currentSnapshot, nil when isCullingInvisibleElements is off.
+@property (nonatomic, readonly) UBKAccessibilityVisibility *currentVisibility;
+
+//Conformance profile used for contrast ratings and the minimum size warning. Default UBKRuleProfileWCAG21.
+@property (nonatomic) UBKRuleProfileIdentifier ruleProfile;
+
+//Thresholds used when ruleProfile is UBKRuleProfileCustom. Defaults to the WCAG 2.1 thresholds.
+@property (nonatomic) UBKRuleThresholds customRuleThresholds;
+
+//Rules for the selected profile, changes when ruleProfile or customRuleThresholds change.
+@property (nonatomic, readonly) const UBKRuleEvaluator *ruleEvaluator;
+
+//Touch targets smaller than this in either direction need this much room around their centre, see WCAG 2.2 2.5.8. Default 24.
+@property (nonatomic) CGFloat minimumTargetSpacing;
+
+//Touch target overlap and spacing results for currentSnapshot.
+@property (nonatomic, readonly) UBKAccessibilityTargetSpacing *currentTargetSpacing;
+
+//Expected VoiceOver reading order for currentSnapshot, elements VoiceOver reaches out of order get a warning.
+@property (nonatomic, readonly) UBKAccessibilityReadingOrder *currentReadingOrder;
+
+//Duplicate labels and labels that repeat a name from code for currentSnapshot.
+@property (nonatomic, readonly) UBKAccessibilityLabels *currentLabels;
+
+//Rate the colours of each element in the light, dark and increased contrast appearances as well as the one on screen, so a screen doesn't have to be audited again after changing the system settings. Needs iOS 13. Default on.
+@property (nonatomic) BOOL isAuditingAppearances;
+
+//Contrast in every appearance for currentSnapshot, nil when isAuditingAppearances is off.
+@property (nonatomic, readonly) UBKAccessibilityAppearances *currentAppearances;
+
+//Contrast of every element's colours in currentSnapshot with each colour vision deficiency, simulated for the whole screen in one pass.
+@property (nonatomic, readonly) UBKAccessibilityColourVision *currentColourVision;
+
+//Audit one of each group of identical sibling subtrees, eg table cells, and share its warnings with the rest. The elements list and report show each group once with its count. Default on.
+@property (nonatomic) BOOL isGroupingRepeatedSubtrees;
+
+//Repeated sibling subtrees in currentSnapshot, nil when isGroupingRepeatedSubtrees is off.
+@property (nonatomic, readonly) UBKAccessibilitySubtreeGroups *currentSubtreeGroups;
+
+//Elements scanned, rules run, warnings, refresh durations and cache hits for every refresh. Set its refreshHandler or start an exporter to follow them.
+@property (nonatomic, readonly) UBKAccessibilityMetrics *metrics;
+
+//Set a session recorder to keep an audit of every distinct screen visited while the kit is running. Default nil.
+@property (nonatomic) UBKAccessibilitySessionRecorder *sessionRecorder;
+
 //Colours
 //isValidating colours is used to show a warning for colours not matching in the AccessibilityColours array.
 @property (nonatomic) BOOL isValidatingColours; // default off, set to true if
@@ -53,12 +112,27 @@
 @property (nonatomic) BOOL allowNormalTouchEvents;
 @property (nonatomic) BOOL isShowingHighlightedUI;
 @property (nonatomic) BOOL isShowingTouchAnimations;
+//Numbers each element on screen in its expected reading order. Default off.
+@property (nonatomic) BOOL isShowingReadingOrder;
+//Shows the app as it's seen with the deficiency, captured again on every refresh. Default UBKColourVisionTypical, which shows nothing.
+@property (nonatomic) UBKColourVisionDeficiency colourVisionSimulation;
+
+//Seconds configureAllUIElmentsIncrementally may spend walking the hierarchy per frame, 0 walks in one go. Default 0.002.
+@property (nonatomic) CFTimeInterval hierarchyWalkBudget;
+//True while configureAllUIElmentsIncrementally is waiting for the next frame.
+@property (nonatomic, readonly) BOOL isWalkingHierarchy;
 
 - (void)touchesBegan:(NSSet<UITouch *> *)touches withEvent:(UIEvent *)event;
 - (void)touchesMoved:(NSSet<UITouch *> *)touches withEvent:(UIEvent *)event;
 - (void)touchesEnded:(NSSet<UITouch *> *)touches withEvent:(UIEvent *)event;
 - (void)touchesCancelled:(NSSet<UITouch *> *)touches withEvent:(UIEvent *)event;
 
+//Allocation free variants used by UBKAccessibilityWindow. touches is a C array of count touches that is only valid for the duration of the call.
+- (void)touchesBegan:(__unsafe_unretained UITouch * const *)touches count:(NSUInteger)count withEvent:(UIEvent *)event;
+- (void)touchesMoved:(__unsafe_unretained UITouch * const *)touches count:(NSUInteger)count withEvent:(UIEvent *)event;
+- (void)touchesEnded:(__unsafe_unretained UITouch * const *)touches count:(NSUInteger)count withEvent:(UIEvent *)event;
+- (void)touchesCancelled:(__unsafe_unretained UITouch * const *)touches count:(NSUInteger)count withEvent:(UIEvent *)event;
+
 - (void)showInspector:(BOOL)popViewController;
 - (void)hideInspector;
 
@@ -67,8 +141,30 @@
 
 //Reloads all the UI elements on the elements in the UBKAccessibilityElementsTableViewController.
 - (void)configureAllUIElments;
+//Same as configureAllUIElments but the hierarchy is walked for at most hierarchyWalkBudget each frame, the elements list shows the progress. The last results stay in place until the walk finishes. Does nothing while a walk is already running, configureAllUIElments starts over.
+- (void)configureAllUIElmentsIncrementally;
+//Highest warning level of the elements from the last finished walk. Starts an incremental walk for the next call if none is running.
 - (UBKAccessibilityWarningLevel)showWarningLevelForView;
 
+//Class path of the view controllers on screen, eg UINavigationController/LoginViewController
+- (NSString *)visibleScreenName;
+- (NSString *)visibleScreenNameForWindow:(UIWindow *)window;
+//A walk of a window that finds the same elements as configureAllUIElments, for callers that walk the hierarchy on their own schedule, eg UBKAccessibilitySampler. The window doesn't have to be the manager's window.
+- (UBKAccessibilityHierarchyWalker *)hierarchyWalkerForWindow:(UIWindow *)window;
+//Audits only the view and its subviews rather than the whole window, eg a feature team's component in a unit test. The view doesn't have to be in a window. The elements and their details are read from the returned audit, the current results, the audit cache and the inspector are left as they are. The refresh is recorded in the metrics.
+- (UBKAccessibilityComponentAudit *)auditView:(UIView *)view;
+//Same as auditView: for the view controller's view, loading it if needed. The view controller's class is used as the screen name.
+- (UBKAccessibilityComponentAudit *)auditViewController:(UIViewController *)viewController;
+//Runs the screen level passes and the audit on a finished walk and records the metrics, leaving the inspector as it is. Elements outside visibleBounds are culled. The results are read with accessibilityDetailsForView: as usual.
+- (void)auditHierarchyWalk:(UBKAccessibilityHierarchyWalker *)hierarchyWalker visibleBounds:(CGRect)visibleBounds walkDuration:(CFTimeInterval)walkDuration;
+
+//Accessibility details for a ui element from the last refresh. Use this rather than ubk_accessibilityDetails when reading results for many elements.
+- (NSArray <UBKAccessibilitySection *> *)accessibilityDetailsForView:(UIView *)view;
+//How many elements the view's entry in the elements list stands for, 1 unless it represents a group of repeated subtrees.
+- (NSUInteger)repeatCountForView:(UIView *)view;
+//Call after changing a view from the inspector, the details for the view and its descendants are worked out again when next read.
+- (void)invalidateAccessibilityDetailsForView:(UIView *)view;
+
 //Reset all outlines
 - (void)removeAllOutlines;
 
@@ -34,12 +34,40 @@
 #import "UBKAccessibilityTouchView.h"
 #import "UBKAccessibilityVisibleWarningView.h"
 #import "UIView+HelperMethods.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityScanArena.h"
+#import "UBKAccessibilityClassInfo.h"
+#import "UBKAccessibilityTargetSpacing.h"
+#import "UBKAccessibilityReadingOrder.h"
+#import "UBKAccessibilityReadingOrderView.h"
+#import "UBKAccessibilityLabels.h"
+#import "UBKAccessibilityAppearances.h"
+#import "UBKAccessibilityColourVision.h"
+#import "UBKAccessibilitySubtreeGroups.h"
+#import "UBKAccessibilityVisibility.h"
+#import "UBKAccessibilitySessionRecorder.h"
+#import "UBKAccessibilityAuditCache.h"
+#import "UBKAccessibilityHierarchyWalker.h"
+#import "UBKAccessibilityMetrics.h"
+#import "UBKAccessibilityScreenPasses.h"
+#import "UBKAccessibilityComponentAudit.h"
+
+#import <QuartzCore/QuartzCore.h>
 
 const CGFloat maxWidth = 414;
 static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
 
 @interface UBKAccessibilityManager ()
-
+@property (nonatomic, readwrite) UBKAccessibilityScreenPasses *currentPasses;
+@property (nonatomic, readwrite) UBKAccessibilityAuditCache *auditCache;
+@property (nonatomic) UBKAccessibilityReadingOrderView *readingOrderView;
+@property (nonatomic) UIImageView *colourVisionView;
+@property (nonatomic) UBKAccessibilityHierarchyWalker *hierarchyWalker;
+@property (nonatomic) CADisplayLink *hierarchyWalkDisplayLink;
+//Time spent on the current walk so far, the frames in between aren't counted
+@property (nonatomic) CFTimeInterval hierarchyWalkDuration;
+@property (nonatomic, readwrite) UBKAccessibilityMetrics *metrics;
+@property (nonatomic) UBKRuleEvaluator customRuleEvaluator;
 @end
 
 @implementation UBKAccessibilityManager
@@ -74,19 +102,33 @@ static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
         self.isValidatingColours = false;
         self.accessibilityFilter = [[UBKAccessibilityFilter alloc]init];
         self.accessibilityColours = [[UBKAccessibilityColours alloc] init];
+        self.auditCache = [[UBKAccessibilityAuditCache alloc]init];
+        self.metrics = [[UBKAccessibilityMetrics alloc]init];
+        self.customRuleThresholds = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG21)->thresholds;
+        self.ruleProfile = UBKRuleProfileWCAG21;
+        self.minimumTargetSpacing = 24;
+        self.isCullingInvisibleElements = true;
+        self.isGroupingRepeatedSubtrees = true;
+        self.isAuditingAppearances = true;
+        self.hierarchyWalkBudget = 0.002;
+        
+        //Dynamic type changes the validation results without changing any view properties.
+        [[NSNotificationCenter defaultCenter]addObserver:self selector:@selector(invalidateAuditCache) name:UIContentSizeCategoryDidChangeNotification object:nil];
+        [[NSNotificationCenter defaultCenter]addObserver:self selector:@selector(invalidateAuditCache) name:@"traitCollectionDidChange" object:nil];
+        [[NSNotificationCenter defaultCenter]addObserver:self selector:@selector(invalidateAuditCache) name:kUBKAccessibilityDefaultColoursDidChangeNotification object:nil];
     }
     return self;
 }
 
-//Check if any UI elements have a warning.
+//Check if any UI elements have a warning. The window warning timer calls this every second, so it keeps an incremental walk going and reads the elements from the last one that finished.
 - (UBKAccessibilityWarningLevel)showWarningLevelForView
 {
-    [self configureAllUIElments];
+    [self configureAllUIElmentsIncrementally];
     
     UBKAccessibilityWarningLevel warningLevel = UBKAccessibilityWarningLevelPass;
     for (UIView *uiElement in self.accessibilityFilter.filteredObjects)
     {
-        NSArray *itemsArray = uiElement.ubk_accessibilityDetails;
+        NSArray *itemsArray = [self accessibilityDetailsForView:uiElement];
         for (UBKAccessibilitySection *section in itemsArray)
         {
             if (section.sectionType == SectionDisplayTypeWarnings)
@@ -102,6 +144,142 @@ static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
     return warningLevel;
 }
 
+- (NSArray<UBKAccessibilitySection *> *)accessibilityDetailsForView:(UIView *)view
+{
+    return [self.auditCache accessibilityDetailsForView:view];
+}
+
+- (void)invalidateAccessibilityDetailsForView:(UIView *)view
+{
+    [self.auditCache invalidateSubtreeOfView:view];
+}
+
+- (void)invalidateAuditCache
+{
+    [self.auditCache invalidate];
+}
+
+//Colour validation settings change the warnings without changing any view properties.
+- (void)setIsValidatingColours:(BOOL)isValidatingColours
+{
+    _isValidatingColours = isValidatingColours;
+    [self invalidateAuditCache];
+}
+
+- (void)setAccessibilityColours:(UBKAccessibilityColours *)accessibilityColours
+{
+    _accessibilityColours = accessibilityColours;
+    [self invalidateAuditCache];
+}
+
+- (void)setIsCullingInvisibleElements:(BOOL)isCullingInvisibleElements
+{
+    _isCullingInvisibleElements = isCullingInvisibleElements;
+    [self invalidateAuditCache];
+}
+
+- (void)setIsGroupingRepeatedSubtrees:(BOOL)isGroupingRepeatedSubtrees
+{
+    _isGroupingRepeatedSubtrees = isGroupingRepeatedSubtrees;
+    [self invalidateAuditCache];
+}
+
+- (void)setIsAuditingAppearances:(BOOL)isAuditingAppearances
+{
+    _isAuditingAppearances = isAuditingAppearances;
+    [self invalidateAuditCache];
+}
+
+- (void)setRuleProfile:(UBKRuleProfileIdentifier)ruleProfile
+{
+    _ruleProfile = ruleProfile;
+    [self invalidateAuditCache];
+}
+
+- (void)setCustomRuleThresholds:(UBKRuleThresholds)customRuleThresholds
+{
+    _customRuleThresholds = customRuleThresholds;
+    _customRuleEvaluator = UBKRuleEvaluatorMakeCustom(customRuleThresholds);
+    if (self.ruleProfile == UBKRuleProfileCustom)
+    {
+        [self invalidateAuditCache];
+    }
+}
+
+- (const UBKRuleEvaluator *)ruleEvaluator
+{
+    const UBKRuleEvaluator *evaluator = UBKRuleEvaluatorForProfile(self.ruleProfile);
+    if (evaluator)
+    {
+        return evaluator;
+    }
+    return &_customRuleEvaluator;
+}
+
+- (void)setMinimumTargetSpacing:(CGFloat)minimumTargetSpacing
+{
+    _minimumTargetSpacing = minimumTargetSpacing;
+    [self invalidateAuditCache];
+}
+
+- (void)setIsShowingReadingOrder:(BOOL)isShowingReadingOrder
+{
+    _isShowingReadingOrder = isShowingReadingOrder;
+    if (isShowingReadingOrder)
+    {
+        if (!self.readingOrderView)
+        {
+            //Left out of accessibilityViews, the window lets touches on those through to the app
+            self.readingOrderView = [[UBKAccessibilityReadingOrderView alloc]initWithFrame:self.window.bounds];
+        }
+        //Below the inspector so the badges don't cover it.
+        self.readingOrderView.frame = self.window.bounds;
+        [self.window insertSubview:self.readingOrderView belowSubview:self.inspectorContainerView];
+        [self.readingOrderView updateWithReadingOrder:self.currentReadingOrder];
+    }
+    else
+    {
+        [self.readingOrderView removeFromSuperview];
+    }
+}
+
+- (void)setColourVisionSimulation:(UBKColourVisionDeficiency)colourVisionSimulation
+{
+    _colourVisionSimulation = colourVisionSimulation;
+    if (colourVisionSimulation != UBKColourVisionTypical)
+    {
+        if (!self.colourVisionView)
+        {
+            //Image views don't take touches, so it stays out of accessibilityViews like the reading order badges
+            self.colourVisionView = [[UIImageView alloc]initWithFrame:self.window.bounds];
+            self.colourVisionView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+        }
+        self.colourVisionView.frame = self.window.bounds;
+        //Under the reading order badges and the inspector
+        [self.window insertSubview:self.colourVisionView belowSubview:(self.readingOrderView.superview == self.window) ? self.readingOrderView : self.inspectorContainerView];
+        [self updateColourVisionView];
+    }
+    else
+    {
+        [self.colourVisionView removeFromSuperview];
+        self.colourVisionView.image = nil;
+    }
+}
+
+//Captures the app's views, leaving out the inspector and the overlays
+- (void)updateColourVisionView
+{
+    NSMutableArray <UIView *> *appViews = [[NSMutableArray alloc]init];
+    for (UIView *viewTmp in self.window.subviews)
+    {
+        if ((![self.accessibilityViews containsObject:viewTmp]) && (![viewTmp isKindOfClass:[UBKAccessibilityTouchView class]]) && (![self isOverlayView:viewTmp]))
+        {
+            [appViews addObject:viewTmp];
+        }
+    }
+    self.colourVisionView.image = [UBKAccessibilityColourVision simulatedImageOfViews:appViews inView:self.window deficiency:self.colourVisionSimulation];
+}
+
 //Called when the inspector button has been enabled/disabled.
 - (void)setAllowNormalTouchEvents:(BOOL)allowNormalTouchEvents
 {
@@ -113,7 +291,7 @@ static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
     }
     else
     {
-        [self configureAllUIElments];
+        [self configureAllUIElmentsIncrementally];
     }
 
     //This will cause the first responder to resign.
@@ -129,40 +307,313 @@ static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
 //Get all UI elements on screen. This is only called when the accessbility inspector is enabled.
 - (void)configureAllUIElments
 {
-    [self.accessibilityFilter.filteredObjects removeAllObjects];
+    CFTimeInterval startTime = CACurrentMediaTime();
+    [self startHierarchyWalk];
+    [self.hierarchyWalker walkToEnd];
+    self.hierarchyWalkDuration += CACurrentMediaTime() - startTime;
+    [self finishHierarchyWalk];
+}
+
+- (void)configureAllUIElmentsIncrementally
+{
+    //Starting over would throw away the slices walked so far, a large screen might never finish
+    if (self.isWalkingHierarchy)
+    {
+        return;
+    }
+    if (self.hierarchyWalkBudget <= 0)
+    {
+        [self configureAllUIElments];
+        return;
+    }
+    CFTimeInterval startTime = CACurrentMediaTime();
+    [self startHierarchyWalk];
+    self.hierarchyWalkDuration += CACurrentMediaTime() - startTime;
+    //The first slice runs now, the rest once per frame until the walk is done
+    self.hierarchyWalkDisplayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(continueHierarchyWalk)];
+    [self.hierarchyWalkDisplayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    [self continueHierarchyWalk];
+}
+
+- (BOOL)isWalkingHierarchy
+{
+    return self.hierarchyWalker != nil;
+}
+
+//Starts a new walk of the window, dropping any walk still in progress. The last results stay in place until the walk finishes.
+- (void)startHierarchyWalk
+{
+    [self.hierarchyWalkDisplayLink invalidate];
+    self.hierarchyWalkDisplayLink = nil;
+    self.hierarchyWalkDuration = 0;
+    self.hierarchyWalker = [self hierarchyWalkerForWindow:self.window];
+}
+
+- (UBKAccessibilityHierarchyWalker *)hierarchyWalkerForWindow:(UIWindow *)window
+{
     [self configureAccessibiltyViewIgnoreList];
     
-    for (UIView *viewTmp in self.window.subviews)
+    NSMutableArray <UIView *> *rootViews = [[NSMutableArray alloc]init];
+    for (UIView *viewTmp in window.subviews)
     {
-        if (![self.accessibilityViews containsObject:viewTmp])
+        if ((![self.accessibilityViews containsObject:viewTmp]) && (![self isOverlayView:viewTmp]) && ([self canAddView:viewTmp]))
         {
-            if ([self canAddView:viewTmp])
-            {
-                [self getChildUIElements:viewTmp];
-            }
+            [rootViews addObject:viewTmp];
         }
     }
     
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:[self visibleScreenNameForWindow:window]];
+    return [[UBKAccessibilityHierarchyWalker alloc]initWithRootViews:rootViews snapshot:snapshot actionForView:[self hierarchyWalkAction]];
+}
+
+- (UBKAccessibilityWalkAction (^)(UIView *view))hierarchyWalkAction
+{
+    __weak UBKAccessibilityManager *weakSelf = self;
+    return ^UBKAccessibilityWalkAction(UIView *view) {
+        if (![weakSelf canAddView:view])
+        {
+            return UBKAccessibilityWalkActionSkip;
+        }
+        //Warning outlines are added by the kit, keep them out of the elements and the snapshot.
+        if ([view isKindOfClass:[UBKAccessibilityVisibleWarningView class]])
+        {
+            return UBKAccessibilityWalkActionSubviewsOnly;
+        }
+        return UBKAccessibilityWalkActionElement;
+    };
+}
+
+- (UBKAccessibilityComponentAudit *)auditView:(UIView *)view
+{
+    return [self auditView:view screenName:NSStringFromClass(view.class)];
+}
+
+- (UBKAccessibilityComponentAudit *)auditViewController:(UIViewController *)viewController
+{
+    return [self auditView:viewController.view screenName:NSStringFromClass(viewController.class)];
+}
+
+//Only the metrics are shared with the screen in the inspector
+- (UBKAccessibilityComponentAudit *)auditView:(UIView *)view screenName:(NSString *)screenName
+{
+    CFTimeInterval startTime = CACurrentMediaTime();
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:screenName];
+    UBKAccessibilityHierarchyWalker *hierarchyWalker = [[UBKAccessibilityHierarchyWalker alloc]initWithRootViews:@[view] snapshot:snapshot actionForView:[self hierarchyWalkAction]];
+    hierarchyWalker.rootViewsAreElements = true;
+    [hierarchyWalker walkToEnd];
+    [snapshot finishSnapshot];
+    
+    //Snapshot frames are in window coordinates, or in the coordinates of the top superview for a component that isn't in a window
+    CGRect visibleBounds = (view.window != nil) ? view.window.bounds : [view convertRect:view.bounds toView:nil];
+    UBKAccessibilityScreenPasses *passes = [[UBKAccessibilityScreenPasses alloc]initWithSnapshot:snapshot visibleBounds:visibleBounds];
+    NSMutableArray <UIView *> *elements = [hierarchyWalker.elements mutableCopy];
+    UBKAccessibilityAuditCache *auditCache = [[UBKAccessibilityAuditCache alloc]init];
+    __block UBKMetricsRefresh refresh;
+    [passes performAudit:^{
+        refresh = [self auditElements:elements passes:passes auditCache:auditCache];
+    }];
+    refresh.duration = CACurrentMediaTime() - startTime;
+    [self.metrics recordRefresh:&refresh];
+    return [[UBKAccessibilityComponentAudit alloc]initWithPasses:passes elements:elements auditCache:auditCache];
+}
+
+- (void)continueHierarchyWalk
+{
+    CFTimeInterval startTime = CACurrentMediaTime();
+    BOOL isFinished = [self.hierarchyWalker walkForDuration:self.hierarchyWalkBudget];
+    self.hierarchyWalkDuration += CACurrentMediaTime() - startTime;
+    if (isFinished)
+    {
+        [self finishHierarchyWalk];
+    }
+    else
+    {
+        [self.navigationViewController updateElementsProgress:self.hierarchyWalker.progress];
+    }
+}
+
+//Runs the screen level passes and the audit on the walked hierarchy, then updates the elements list.
+- (void)finishHierarchyWalk
+{
+    CFTimeInterval startTime = CACurrentMediaTime();
+    [self.hierarchyWalkDisplayLink invalidate];
+    self.hierarchyWalkDisplayLink = nil;
+    UBKAccessibilityHierarchyWalker *hierarchyWalker = self.hierarchyWalker;
+    self.hierarchyWalker = nil;
+    
+    UBKMetricsRefresh refresh = [self auditWalkedHierarchy:hierarchyWalker visibleBounds:self.window.bounds];
+    
+    if (self.isShowingReadingOrder)
+    {
+        [self.readingOrderView updateWithReadingOrder:self.currentReadingOrder];
+    }
+    if (self.colourVisionSimulation != UBKColourVisionTypical)
+    {
+        [self updateColourVisionView];
+    }
+    
     [self.accessibilityFilter applyFilter];
     [self.navigationViewController updateAllElements:self.accessibilityFilter.filteredObjects];
+    [self.navigationViewController updateElementsProgress:1];
+    
+    [self.sessionRecorder recordSnapshot:self.currentSnapshot];
+    
+    refresh.duration = self.hierarchyWalkDuration + (CACurrentMediaTime() - startTime);
+    [self.metrics recordRefresh:&refresh];
+}
+
+- (void)auditHierarchyWalk:(UBKAccessibilityHierarchyWalker *)hierarchyWalker visibleBounds:(CGRect)visibleBounds walkDuration:(CFTimeInterval)walkDuration
+{
+    CFTimeInterval startTime = CACurrentMediaTime();
+    UBKMetricsRefresh refresh = [self auditWalkedHierarchy:hierarchyWalker visibleBounds:visibleBounds];
+    refresh.duration = walkDuration + (CACurrentMediaTime() - startTime);
+    [self.metrics recordRefresh:&refresh];
+}
+
+//Everything in a refresh that doesn't touch the inspector. Elements outside visibleBounds are culled. The returned refresh has no duration.
+- (UBKMetricsRefresh)auditWalkedHierarchy:(UBKAccessibilityHierarchyWalker *)hierarchyWalker visibleBounds:(CGRect)visibleBounds
+{
+    UBKAccessibilitySnapshot *snapshot = hierarchyWalker.snapshot;
+    [snapshot finishSnapshot];
+    
+    //Screen level passes, these have to run before the audit so the element warnings can use them
+    self.currentPasses = [[UBKAccessibilityScreenPasses alloc]initWithSnapshot:snapshot visibleBounds:visibleBounds];
+    [self.accessibilityFilter.filteredObjects setArray:hierarchyWalker.elements];
+    return [self auditElements:self.accessibilityFilter.filteredObjects passes:self.currentPasses auditCache:self.auditCache];
+}
+
+//Audits the elements of the passes' snapshot through the cache, leaving only the elements to list. The validation rules read auditedPasses, so passes has to be either the current passes or performing an audit. The returned refresh has no duration.
+- (UBKMetricsRefresh)auditElements:(NSMutableArray <UIView *> *)elements passes:(UBKAccessibilityScreenPasses *)passes auditCache:(UBKAccessibilityAuditCache *)auditCache
+{
+    UBKAccessibilitySnapshot *snapshot = passes.snapshot;
+    [passes removeCulledElements:elements];
+    [auditCache updateWithSnapshot:snapshot subtreeGroups:passes.subtreeGroups];
+    
+    //Each pass counts as one rule run, on top of the elements the audit cache recomputes
+    UBKMetricsRefresh refresh = {0};
+    refresh.nodes = snapshot.nodeCount;
+    refresh.elements = elements.count;
+    [passes removeRepeatedElements:elements];
+    refresh.rulesRun = auditCache.recomputedElementCount + passes.passCount;
+    refresh.cacheHits = auditCache.reusedNodeCount;
+    refresh.cacheMisses = auditCache.recomputedNodeCount;
+    refresh.arenaAllocations = snapshot.scanArena.systemAllocations;
+    refresh.arenaBytes = snapshot.scanArena.bytesUsed;
+    [self countWarningsForRefresh:&refresh elements:elements passes:passes auditCache:auditCache];
+    return refresh;
 }
 
-//Recurrsion to get all child subviews.
-- (void)getChildUIElements:(UIView *)parentView
+//Warnings on the elements found by the refresh, before the filter hides any of them. Each group of repeated elements counts its warnings once per element.
+- (void)countWarningsForRefresh:(UBKMetricsRefresh *)refresh elements:(NSArray <UIView *> *)elements passes:(UBKAccessibilityScreenPasses *)passes auditCache:(UBKAccessibilityAuditCache *)auditCache
 {
-    for (UIView *viewTmp in parentView.subviews)
+    for (UIView *uiElement in elements)
     {
-        if ([self canAddView:viewTmp])
+        NSUInteger repeatCount = [passes repeatCountForView:uiElement];
+        for (UBKAccessibilitySection *section in [auditCache accessibilityDetailsForView:uiElement])
         {
-            if (![viewTmp isKindOfClass:[UBKAccessibilityVisibleWarningView class]])
+            if (section.sectionType != SectionDisplayTypeWarnings)
+            {
+                continue;
+            }
+            for (UBKAccessibilityProperty *property in section.items)
             {
-                [self.accessibilityFilter.filteredObjects addObject:viewTmp];
+                if (property.warningType < UBKMetricsWarningTypeCount)
+                {
+                    refresh->warningsByType[property.warningType] += (uint32_t)repeatCount;
+                }
+                if (property.warningLevel < UBKMetricsWarningLevelCount)
+                {
+                    refresh->warningsByLevel[property.warningLevel] += (uint32_t)repeatCount;
+                }
             }
-            [self getChildUIElements:viewTmp];
         }
     }
 }
 
+- (NSUInteger)repeatCountForView:(UIView *)view
+{
+    if (self.currentPasses == nil)
+    {
+        return 1;
+    }
+    return [self.currentPasses repeatCountForView:view];
+}
+
+#pragma mark - Current screen level results
+
+- (UBKAccessibilitySnapshot *)currentSnapshot
+{
+    return self.currentPasses.snapshot;
+}
+
+- (UBKAccessibilityVisibility *)currentVisibility
+{
+    return self.currentPasses.visibility;
+}
+
+- (UBKAccessibilityTargetSpacing *)currentTargetSpacing
+{
+    return self.currentPasses.targetSpacing;
+}
+
+- (UBKAccessibilityReadingOrder *)currentReadingOrder
+{
+    return self.currentPasses.readingOrder;
+}
+
+- (UBKAccessibilityLabels *)currentLabels
+{
+    return self.currentPasses.labels;
+}
+
+- (UBKAccessibilityAppearances *)currentAppearances
+{
+    return self.currentPasses.appearances;
+}
+
+- (UBKAccessibilityColourVision *)currentColourVision
+{
+    return self.currentPasses.colourVision;
+}
+
+- (UBKAccessibilitySubtreeGroups *)currentSubtreeGroups
+{
+    return self.currentPasses.subtreeGroups;
+}
+
+//Class path of the view controllers currently on screen, eg UINavigationController/LoginViewController
+- (NSString *)visibleScreenName
+{
+    return [self visibleScreenNameForWindow:self.window];
+}
+
+- (NSString *)visibleScreenNameForWindow:(UIWindow *)window
+{
+    NSMutableArray *classNames = [[NSMutableArray alloc]init];
+    UIViewController *viewController = window.rootViewController;
+    while (viewController)
+    {
+        [classNames addObject:NSStringFromClass(viewController.class)];
+        if ((viewController.presentedViewController) && (!viewController.presentedViewController.isBeingDismissed))
+        {
+            viewController = viewController.presentedViewController;
+        }
+        else if ([viewController isKindOfClass:[UINavigationController class]])
+        {
+            viewController = ((UINavigationController *)viewController).topViewController;
+        }
+        else if ([viewController isKindOfClass:[UITabBarController class]])
+        {
+            viewController = ((UITabBarController *)viewController).selectedViewController;
+        }
+        else
+        {
+            viewController = nil;
+        }
+    }
+    return [classNames componentsJoinedByString:@"/"];
+}
+
 - (void)removeAllOutlines
 {
     for (UIView *viewTmp in self.window.subviews)
@@ -203,7 +654,7 @@ static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
     [self.window addSubview:self.inspectorContainerView];
     
     [self configureAccessibiltyViewIgnoreList];
-    [self configureAllUIElments];
+    [self configureAllUIElmentsIncrementally];
 }
 
 - (void)configureAccessibiltyViewIgnoreList
@@ -233,25 +684,7 @@ static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
     [self.currentTouchedElements removeAllObjects];
     for (UITouch *touch in touches)
     {
-        CGRect buttonRectTmp = self.inspectorContainerView.frame;
-        CGPoint pointTmp = [touch locationInView:self.window];
-
-        //Check if user touched inside inspector view controller
-        if ((CGRectContainsPoint(buttonRectTmp, pointTmp)) && (self.navigationViewController.isShowingInspector))
-        {
-            
-        }
-        else
-        {
-            for (UIView *view in self.window.subviews)
-            {
-                //Make sure we're not adding any of the inspector views or helper views.
-                if ((![self.accessibilityViews containsObject:view]) && (![view isKindOfClass:[UBKAccessibilityTouchView class]]))
-                {
-                    [self checkHitTest:view withTouches:touch];
-                }
-            }
-        }
+        [self checkTouchedElementsForTouch:touch];
     }
 }
 
@@ -262,6 +695,62 @@ static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
 
 - (void)touchesEnded:(NSSet<UITouch *> *)touches withEvent:(UIEvent *)event;
 {    
+    [self updateInspectorForTouchedElements];
+}
+
+- (void)touchesCancelled:(NSSet<UITouch *> *)touches withEvent:(UIEvent *)event
+{
+    
+}
+
+- (void)touchesBegan:(__unsafe_unretained UITouch * const *)touches count:(NSUInteger)count withEvent:(UIEvent *)event
+{
+    [self.currentTouchedElements removeAllObjects];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [self checkTouchedElementsForTouch:touches[i]];
+    }
+}
+
+- (void)touchesMoved:(__unsafe_unretained UITouch * const *)touches count:(NSUInteger)count withEvent:(UIEvent *)event
+{
+    
+}
+
+- (void)touchesEnded:(__unsafe_unretained UITouch * const *)touches count:(NSUInteger)count withEvent:(UIEvent *)event
+{
+    [self updateInspectorForTouchedElements];
+}
+
+- (void)touchesCancelled:(__unsafe_unretained UITouch * const *)touches count:(NSUInteger)count withEvent:(UIEvent *)event
+{
+    
+}
+
+//Add the UI elements under the touch to the currentTouchedElements array.
+- (void)checkTouchedElementsForTouch:(UITouch *)touch
+{
+    CGRect buttonRectTmp = self.inspectorContainerView.frame;
+    CGPoint pointTmp = [touch locationInView:self.window];
+
+    //Check if user touched inside inspector view controller
+    if ((CGRectContainsPoint(buttonRectTmp, pointTmp)) && (self.navigationViewController.isShowingInspector))
+    {
+        return;
+    }
+    
+    for (UIView *view in self.window.subviews)
+    {
+        //Make sure we're not adding any of the inspector views or helper views.
+        if ((![self.accessibilityViews containsObject:view]) && (![view isKindOfClass:[UBKAccessibilityTouchView class]]) && (![self isOverlayView:view]))
+        {
+            [self checkHitTest:view withTouches:touch];
+        }
+    }
+}
+
+- (void)updateInspectorForTouchedElements
+{
     if (self.currentTouchedElements.count > 0)
     {
         [self sendItemsToInspector];
@@ -273,11 +762,6 @@ static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
     }
 }
 
-- (void)touchesCancelled:(NSSet<UITouch *> *)touches withEvent:(UIEvent *)event
-{
-    
-}
-
 #pragma mark - Hit test helper
 
 //Create an array of UI elements under the touch point.
@@ -301,8 +785,8 @@ static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
     {
         if (view != self.window.rootViewController.view)
         {
-            //Don't interact with Apple private classes
-            if ([self canAddView:view])
+            //Don't interact with Apple private classes or views that can't be seen. Children of culled views can still be visible.
+            if (([self canAddView:view]) && (![self.currentVisibility isViewCulled:view]))
             {
                 [self.currentTouchedElements addObject:view];
             }
@@ -316,14 +800,16 @@ static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
     }
 }
 
+//Views the kit draws over the app without taking touches, eg the reading order badges
+- (BOOL)isOverlayView:(UIView *)view
+{
+    return (view == self.readingOrderView) || (view == self.colourVisionView);
+}
+
 - (BOOL)canAddView:(UIView *)view
 {
     //Don't interact with Apple private classes
-    if (![[NSStringFromClass([view class])substringToIndex:1]isEqualToString:@"_"])
-    {
-        return true;
-    }
-    return false;
+    return ![UBKAccessibilityClassInfo classInfoForView:view].isPrivate;
 }
 
 #pragma mark - Inspector methods
@@ -369,7 +855,8 @@ static const UBKAccessibilityManager *_ubkAccessibilityManager = nil;
 //Find the elements superview in the global array of UI elements.
 - (UIView *)findParentView:(UIView *)childView
 {
-    if ([self.accessibilityFilter.filteredObjects containsObject:childView])
+    //Views that share the results of a listed element are still picked, the inspector works out their own details
+    if (([self.accessibilityFilter.filteredObjects containsObject:childView]) || ((self.currentSubtreeGroups) && ([self.accessibilityFilter.filteredObjects containsObject:[self.currentSubtreeGroups representativeOfView:childView]])))
     {
         return childView;
     }
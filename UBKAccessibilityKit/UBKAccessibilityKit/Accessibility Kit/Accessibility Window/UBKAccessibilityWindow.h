@@ -20,7 +20,15 @@
 
 #import <UIKit/UIKit.h>
 
-@class UBKAccessibilityButton;
+@class UBKAccessibilityButton, UBKAccessibilitySampler;
+
+//Counters for the touch router in sendEvent. Durations are in nanoseconds and only cover the routing work done by the window, not the time spent by the views receiving the event.
+typedef struct {
+    uint64_t eventCount;
+    uint64_t lastEventDuration;
+    uint64_t maximumEventDuration;
+    uint64_t totalEventDuration;
+} UBKTouchRoutingStatistics;
 
 @interface UBKAccessibilityWindow : UIWindow
 
@@ -28,11 +36,22 @@
 //Enable/Disable the accessibility inspector. Setting this to false will disable the custom UIWindow
 @property (nonatomic) BOOL enableInspector;
 
+//Audits a sample of screens without showing anything when enableInspector is false, eg in beta builds. Started when the window becomes key. Default nil.
+@property (nonatomic) UBKAccessibilitySampler *sampler;
+
 //Accessibility button shown on screen, button shows warnings and has an active and inactive state.
 @property (nonatomic) UBKAccessibilityButton *inspectorButton;
 
+//Per event latency of the touch router while the inspector is enabled.
+@property (nonatomic, readonly) UBKTouchRoutingStatistics touchRoutingStatistics;
+
 //Configures the screenshot service, screenshot service is only available in iOS 13+ and provides an Accessibility Report when a screenshot is taken.
 - (void)configureScreenshotService;
 
+//The touch exclusion rects for the inspector views are cached in window space. Call this when one of those views is moved without a layout pass on the window.
+- (void)setNeedsTouchExclusionUpdate;
+
+- (void)resetTouchRoutingStatistics;
+
 @end
 
@@ -27,9 +27,39 @@
 #import "UBKAccessibilityTouchAnimations.h"
 #import "UBKAccessibilityReportViewController.h"
 #import "UBKAccessibilityFilter.h"
+#import "UBKAccessibilitySampler.h"
 #import "UIView+HelperMethods.h"
 
+#import <mach/mach_time.h>
+
+//Touches are bucketed per phase in fixed arrays so sendEvent doesn't allocate.
+#define UBKTouchRoutingMaximumTouches 16
+#define UBKTouchExclusionMaximumRects 8
+
+//Touches this close to an inspector view are treated as touching the view.
+static const CGFloat UBKTouchExclusionBuffer = 10;
+
+typedef enum : NSUInteger {
+    UBKTouchPhaseBucketBegan,
+    UBKTouchPhaseBucketMoved,
+    UBKTouchPhaseBucketEnded,
+    UBKTouchPhaseBucketCancelled,
+    UBKTouchPhaseBucketCount
+} UBKTouchPhaseBucket;
+
 @interface UBKAccessibilityWindow () <UIScreenshotServiceDelegate>
+{
+    __unsafe_unretained UITouch *_phaseTouches[UBKTouchPhaseBucketCount][UBKTouchRoutingMaximumTouches];
+    NSUInteger _phaseTouchCounts[UBKTouchPhaseBucketCount];
+    
+    CGRect _inspectorButtonTouchRect;
+    CGRect _touchExclusionRects[UBKTouchExclusionMaximumRects];
+    NSUInteger _touchExclusionRectCount;
+    NSUInteger _touchExclusionViewCount;
+    BOOL _touchExclusionRectsValid;
+    
+    UBKTouchRoutingStatistics _touchRoutingStatistics;
+}
 @property (nonatomic) BOOL passTouchToWindow;
 @property (nonatomic) BOOL movingInspectorButton;
 @property (nonatomic) CGPoint startPoint;
@@ -46,6 +76,10 @@
     if (!self.enableInspector)
     {
         [super becomeKeyWindow];
+        if ((self.sampler) && (!self.sampler.isRunning))
+        {
+            [self.sampler startWithWindow:self];
+        }
         return;
     }
     
@@ -154,62 +188,63 @@
     }
     
     [self.inspectorButton setFrame:CGRectMake(point.x - 25, point.y - 25, 50, 50)];
+    [self setNeedsTouchExclusionUpdate];
 }
 
 //Called when a user touches any where within the UIWindow
+//This runs for every touch event in the app, so it must not allocate. Touches are sorted into fixed phase buckets and compared against cached window space exclusion rects.
 - (void)sendEvent:(UIEvent *)event
 {
     // Collect touches
     NSSet *touches = [event allTouches];
+    UBKAccessibilityManager *manager = [UBKAccessibilityManager sharedInstance];
     
-    if ([UBKAccessibilityManager sharedInstance].isShowingTouchAnimations)
+    if (manager.isShowingTouchAnimations)
     {
         [self.accessibilityTouchAnimations touchDidHappen:touches withEvent:event];
     }
     
     //Check if a UIAlertController is on screen when the user touches the alert. If so the inspector is dismissed.
-    if ([self.rootViewController.presentedViewController isKindOfClass:[UIAlertController class]])
+    BOOL alertOnScreen = [self.rootViewController.presentedViewController isKindOfClass:[UIAlertController class]];
+    if (alertOnScreen)
     {
-        [[UBKAccessibilityManager sharedInstance]hideInspector];
+        [manager hideInspector];
     }
 
     //If enableInspector is false, return as inspector has been turned off.
     //If a UIAlertController is onscreen when the user touches the screen, pass the touch through to the view so it can be dismissed.
-    if ((!self.enableInspector) || ([UBKAccessibilityManager sharedInstance].alertOnScreenAllowTouchEvents) || [self.rootViewController.presentedViewController isKindOfClass:[UIAlertController class]])
+    if ((!self.enableInspector) || (manager.alertOnScreenAllowTouchEvents) || (alertOnScreen))
     {
         [super sendEvent:event];
         return;
     }
     
-    NSMutableSet *began = nil;
-    NSMutableSet *moved = nil;
-    NSMutableSet *ended = nil;
-    NSMutableSet *cancelled = nil;
+    uint64_t routingStartTime = mach_absolute_time();
     
+    memset(_phaseTouchCounts, 0, sizeof(_phaseTouchCounts));
+    __unsafe_unretained UITouch *lastTouch = nil;
     
     // Sort the touches by phase for event dispatch
     for (UITouch *touch in touches)
     {
+        lastTouch = touch;
         switch ([touch phase])
         {
             case UITouchPhaseBegan:
             {
-                if (!began)
-                {
-                    began = [NSMutableSet set];
-                }
-                [began addObject:touch];
+                [self addTouch:touch toPhaseBucket:UBKTouchPhaseBucketBegan];
                 
                 //Save this to compare if the user has dragged on screen.
-                self.startPoint = [touch locationInView:self];
+                CGPoint touchPoint = [touch locationInView:self];
+                self.startPoint = touchPoint;
                 
                 //Has touched within the inspector button so we must be moving it or we have tapped it.
-                if ([self checkTouchPoint:touch withInView:self.inspectorButton])
+                if ([self isInspectorButtonTouchPoint:touchPoint])
                 {
                     //Touched the button, we don't know if it was a tap or a drag.
                     self.movingInspectorButton = TRUE;
                 }
-                else if ([self checkTouchPoint:touch inCollection:[UBKAccessibilityManager sharedInstance].accessibilityViews])
+                else if ([self isExcludedTouchPoint:touchPoint])
                 {
                     //Touched within the inspector container view
                     self.passTouchToWindow = TRUE;
@@ -223,11 +258,7 @@
             }
             case UITouchPhaseMoved:
             {
-                if (!moved)
-                {
-                    moved = [NSMutableSet set];
-                }
-                [moved addObject:touch];
+                [self addTouch:touch toPhaseBucket:UBKTouchPhaseBucketMoved];
                 
                 //Did we start our touch within the inspector button?
                 if (self.movingInspectorButton == TRUE)
@@ -246,18 +277,14 @@
             }
             case UITouchPhaseEnded:
             {
-                if (!ended)
-                {
-                    ended = [NSMutableSet set];
-                }
-                [ended addObject:touch];
+                [self addTouch:touch toPhaseBucket:UBKTouchPhaseBucketEnded];
+                
+                //Find the touch point in the view
+                CGPoint endPoint = [touch locationInView:self];
                 
                 //Check if the touch point is within the inspector button
-                if ([self checkTouchPoint:touch withInView:self.inspectorButton])
+                if ([self isInspectorButtonTouchPoint:endPoint])
                 {
-                    //Find the touch point in the view
-                    CGPoint endPoint = [touch locationInView:self];
-                    
                     //Check if the difference between the startPoint and the endPoint is greater than 20. If it is then the button was tapped. If it has moved, pass the touch to the window.
                     if ([self hasMovedUIElement:self.startPoint endTouchPoint:endPoint withTolerance:20])
                     {
@@ -279,11 +306,7 @@
             }
             case UITouchPhaseCancelled:
             {
-                if (!cancelled)
-                {
-                    cancelled = [NSMutableSet set];
-                }
-                [cancelled addObject:touch];
+                [self addTouch:touch toPhaseBucket:UBKTouchPhaseBucketCancelled];
                 //No longer moving the button
                 self.movingInspectorButton = FALSE;
                 break;
@@ -296,73 +319,175 @@
     }
     
     // Call normal handler for default responder chain
-    if (([UBKAccessibilityManager sharedInstance].allowNormalTouchEvents) || (self.passTouchToWindow == TRUE))
+    if ((manager.allowNormalTouchEvents) || (self.passTouchToWindow == TRUE))
     {
         //Has touched within the inspector container view or allow normal (inspector turned off) touches on window.
+        [self recordTouchRoutingSince:routingStartTime];
         [super sendEvent:event];
     }
     else
     {
         //Touch is not within the inspector container view.
         //Is touch within the inspecton button.
-        if (![self checkTouchPoint:touches.allObjects.lastObject withInView:self.inspectorButton])
+        BOOL touchedInspectorButton = (lastTouch != nil) && [self isInspectorButtonTouchPoint:[lastTouch locationInView:self]];
+        [self recordTouchRoutingSince:routingStartTime];
+        
+        if (!touchedInspectorButton)
         {
             // Create pseudo-event dispatch
-            if (began)
+            if (_phaseTouchCounts[UBKTouchPhaseBucketBegan] > 0)
             {
-                [[UBKAccessibilityManager sharedInstance] touchesBegan:began withEvent:event];
+                [manager touchesBegan:_phaseTouches[UBKTouchPhaseBucketBegan] count:_phaseTouchCounts[UBKTouchPhaseBucketBegan] withEvent:event];
             }
             
-            if (moved)
+            if (_phaseTouchCounts[UBKTouchPhaseBucketMoved] > 0)
             {
-                [[UBKAccessibilityManager sharedInstance] touchesMoved:moved withEvent:event];
+                [manager touchesMoved:_phaseTouches[UBKTouchPhaseBucketMoved] count:_phaseTouchCounts[UBKTouchPhaseBucketMoved] withEvent:event];
             }
             
-            if (ended)
+            if (_phaseTouchCounts[UBKTouchPhaseBucketEnded] > 0)
             {
-                [[UBKAccessibilityManager sharedInstance] touchesEnded:ended withEvent:event];
+                [manager touchesEnded:_phaseTouches[UBKTouchPhaseBucketEnded] count:_phaseTouchCounts[UBKTouchPhaseBucketEnded] withEvent:event];
             }
             
-            if (cancelled)
+            if (_phaseTouchCounts[UBKTouchPhaseBucketCancelled] > 0)
             {
-                [[UBKAccessibilityManager sharedInstance] touchesCancelled:cancelled withEvent:event];
+                [manager touchesCancelled:_phaseTouches[UBKTouchPhaseBucketCancelled] count:_phaseTouchCounts[UBKTouchPhaseBucketCancelled] withEvent:event];
             }
         }
         else if (self.movingInspectorButton == false)
         {
             //Inspector buton was disabled and is now being moved so show the elements views.
-            [[UBKAccessibilityManager sharedInstance]showInspector:true];
+            [manager showInspector:true];
         }
     }
+    
+    //The buckets don't retain the touches, clear them so nothing outlives the event.
+    memset(_phaseTouches, 0, sizeof(_phaseTouches));
+}
+
+//Touches past the bucket capacity are dropped, the inspector only needs the first few touches of a multi touch gesture.
+- (void)addTouch:(UITouch *)touch toPhaseBucket:(UBKTouchPhaseBucket)bucket
+{
+    if (_phaseTouchCounts[bucket] < UBKTouchRoutingMaximumTouches)
+    {
+        _phaseTouches[bucket][_phaseTouchCounts[bucket]] = touch;
+        _phaseTouchCounts[bucket]++;
+    }
+}
+
+- (void)recordTouchRoutingSince:(uint64_t)startTime
+{
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0)
+    {
+        mach_timebase_info(&timebase);
+    }
+    
+    uint64_t duration = (mach_absolute_time() - startTime) * timebase.numer / timebase.denom;
+    _touchRoutingStatistics.eventCount++;
+    _touchRoutingStatistics.lastEventDuration = duration;
+    _touchRoutingStatistics.totalEventDuration += duration;
+    if (duration > _touchRoutingStatistics.maximumEventDuration)
+    {
+        _touchRoutingStatistics.maximumEventDuration = duration;
+    }
+}
+
+- (UBKTouchRoutingStatistics)touchRoutingStatistics
+{
+    return _touchRoutingStatistics;
+}
+
+- (void)resetTouchRoutingStatistics
+{
+    memset(&_touchRoutingStatistics, 0, sizeof(_touchRoutingStatistics));
 }
 
 #pragma mark - Touch validation methods
 
-//Check if the touch point is within the view plus a buffer around the view.
-- (BOOL)checkTouchPoint:(UITouch *)touch withInView:(UIView *)view
+//Layout changes move the inspector views, so the cached exclusion rects need to be rebuilt before the next touch.
+- (void)layoutSubviews
 {
-    //Check if the touch point is within the bounds of the inspector button
-    CGFloat buffer = 10;
-    CGRect buttonRectTmp = CGRectMake(view.frame.origin.x - buffer, view.frame.origin.y - buffer, view.frame.size.width + buffer + buffer, view.frame.size.height + buffer + buffer);
-    CGPoint pointTmp = [touch locationInView:view.superview];
-    if (CGRectContainsPoint(buttonRectTmp, pointTmp))
+    [super layoutSubviews];
+    [self setNeedsTouchExclusionUpdate];
+}
+
+- (void)didAddSubview:(UIView *)subview
+{
+    [super didAddSubview:subview];
+    [self setNeedsTouchExclusionUpdate];
+}
+
+- (void)willRemoveSubview:(UIView *)subview
+{
+    [super willRemoveSubview:subview];
+    [self setNeedsTouchExclusionUpdate];
+}
+
+- (void)setNeedsTouchExclusionUpdate
+{
+    _touchExclusionRectsValid = FALSE;
+}
+
+//Rebuild the window space rects, plus a buffer, for the inspector button and the views in the accessibilityViews ignore list.
+- (void)updateTouchExclusionRectsIfNeeded
+{
+    NSSet *accessibilityViews = [UBKAccessibilityManager sharedInstance].accessibilityViews;
+    if ((_touchExclusionRectsValid) && (_touchExclusionViewCount == accessibilityViews.count))
     {
-        return true;
+        return;
     }
-    return false;
+    
+    _inspectorButtonTouchRect = [self touchRectForView:self.inspectorButton];
+    _touchExclusionRectCount = 0;
+    for (UIView *view in accessibilityViews)
+    {
+        if (_touchExclusionRectCount == UBKTouchExclusionMaximumRects)
+        {
+            break;
+        }
+        CGRect rect = [self touchRectForView:view];
+        if (!CGRectIsNull(rect))
+        {
+            _touchExclusionRects[_touchExclusionRectCount] = rect;
+            _touchExclusionRectCount++;
+        }
+    }
+    _touchExclusionViewCount = accessibilityViews.count;
+    _touchExclusionRectsValid = TRUE;
 }
 
-- (BOOL)checkTouchPoint:(UITouch *)touch inCollection:(NSSet *)collection
+//The rect of the view in window space with a buffer around the view.
+- (CGRect)touchRectForView:(UIView *)view
 {
-    BOOL touched = false;
-    for (UIView *view in collection)
+    if (view.window != self)
     {
-        if ([self checkTouchPoint:touch withInView:view])
+        return CGRectNull;
+    }
+    CGRect rect = [view convertRect:view.bounds toView:self];
+    return CGRectInset(rect, -UBKTouchExclusionBuffer, -UBKTouchExclusionBuffer);
+}
+
+//Check if the touch point is within the inspector button plus a buffer around the button.
+- (BOOL)isInspectorButtonTouchPoint:(CGPoint)point
+{
+    [self updateTouchExclusionRectsIfNeeded];
+    return CGRectContainsPoint(_inspectorButtonTouchRect, point);
+}
+
+//Check if the touch point is within any of the inspector views.
+- (BOOL)isExcludedTouchPoint:(CGPoint)point
+{
+    [self updateTouchExclusionRectsIfNeeded];
+    for (NSUInteger i = 0; i < _touchExclusionRectCount; i++)
+    {
+        if (CGRectContainsPoint(_touchExclusionRects[i], point))
         {
             return true;
         }
     }
-    return touched;
+    return false;
 }
 
 //Check if the user has moved a UI element, check difference between startTouch and endTouch.
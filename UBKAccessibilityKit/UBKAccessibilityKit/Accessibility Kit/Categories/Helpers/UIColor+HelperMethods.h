@@ -19,8 +19,16 @@
  */
 
 #import <UIKit/UIKit.h>
+#import "UBKColourValue.h"
 
 @interface UIColor (HelperMethods)
+//Canonical value used by every contrast check and colour comparison. Converted once per CGColor and cached.
+- (UBKColourValue)ubk_colourValue;
+//Extended sRGB colour for a colour value, nil when the value has no components.
++ (UIColor *)ubk_colourWithColourValue:(UBKColourValue)colourValue;
+//True when both colours have the same 8 bit sRGB value, whatever colour space they were made in.
+- (BOOL)ubk_isEqualToColour:(UIColor *)colour;
+
 - (NSString *)ubk_hexStringFromColour;
 - (NSString *)ubk_rgbStringFromColour;
 - (double)ubk_contrastRatio:(UIColor *)other;
@@ -29,7 +37,10 @@
 - (UIColor *)ubk_analagousColour:(CGFloat)value;
 
 + (UIColor *)ubk_findBetterContrastColour:(UIColor *)forground backgroundColour:(UIColor *)background previousContrast:(double)previousContrast;
+//Accepts RGB, RRGGBB or RRGGBBAA with or without a leading #, as well as rgb() and rgba(), see UBKColourTokensParseColour. Nil when the string isn't a colour.
 + (UIColor *)ubk_colourFromHexString:(NSString *)hexString;
+//Colour for a packed 8 bit sRGB value, 0xRRGGBBAA
++ (UIColor *)ubk_colourWithRGBA8:(uint32_t)rgba;
 
 + (UIColor *)ubk_warningLevelHighForegroundColour;
 + (UIColor *)ubk_warningLevelHighBackgroundColour;
@@ -19,144 +19,101 @@
  */
 
 #import "UIColor+HelperMethods.h"
+#import "UBKColourTokens.h"
 
 @implementation UIColor (HelperMethods)
 
-- (NSString *)ubk_hexStringFromColour
+//Keyed by CGColor, dynamic colours resolve to a different CGColor for each appearance.
++ (NSCache *)ubk_colourValueCache
 {
-    const CGFloat *components = CGColorGetComponents(self.CGColor);
-    size_t count = CGColorGetNumberOfComponents(self.CGColor);
-    
-    CGFloat r = components[0];
-    CGFloat g = 0;
-    CGFloat b = 0;
-    
-    if (r < 0)
-    {
-        r = 0;
-    }
-    if (count == 2)
+    static NSCache *colourValueCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        colourValueCache = [[NSCache alloc]init];
+        colourValueCache.countLimit = 1024;
+    });
+    return colourValueCache;
+}
+
+- (UBKColourValue)ubk_colourValue
+{
+    CGColorRef cgColour = self.CGColor;
+    if (cgColour == NULL)
     {
-        g = components[0];
-        b = components[0];
+        return UBKColourValueMakeUnknown();
     }
-    else
+    
+    UBKColourValue colourValue;
+    NSCache *colourValueCache = [UIColor ubk_colourValueCache];
+    NSValue *cachedValue = [colourValueCache objectForKey:(__bridge id)cgColour];
+    if (cachedValue)
     {
-        g = components[1];
-        if (g < 0)
-        {
-            g = 0;
-        }
-        
-        b = components[2];
-        if (b < 0)
-        {
-            b = 0;
-        }
+        [cachedValue getValue:&colourValue];
+        return colourValue;
     }
-    NSString *hextString = [NSString stringWithFormat:@"#%02lX%02lX%02lX", lroundf(r * 255), lroundf(g * 255), lroundf(b * 255)];
-    return hextString;
+    
+    colourValue = [UIColor ubk_convertColour:cgColour];
+    [colourValueCache setObject:[NSValue valueWithBytes:&colourValue objCType:@encode(UBKColourValue)] forKey:(__bridge id)cgColour];
+    return colourValue;
 }
 
-- (NSString *)ubk_rgbStringFromColour
+//Colour sync handles every colour space, including grey, Display P3 and extended range. Extended linear sRGB keeps out of gamut values instead of clipping them.
++ (UBKColourValue)ubk_convertColour:(CGColorRef)cgColour
 {
-    const CGFloat *components = CGColorGetComponents(self.CGColor);
-    size_t count = CGColorGetNumberOfComponents(self.CGColor);
+    static CGColorSpaceRef linearColourSpace = NULL;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        linearColourSpace = CGColorSpaceCreateWithName(kCGColorSpaceExtendedLinearSRGB);
+    });
     
-    CGFloat r = components[0];
-    CGFloat g = 0;
-    CGFloat b = 0;
-    CGFloat a = 0;
-    
-    if (r < 0)
+    //Pattern colours have no components to convert
+    CGColorRef linearColour = CGColorCreateCopyByMatchingToColorSpace(linearColourSpace, kCGRenderingIntentDefault, cgColour, NULL);
+    if (linearColour == NULL)
     {
-        r = 0;
+        return UBKColourValueMakeUnknown();
     }
-    if (count == 2)
-    {
-        g = components[0];
-        b = components[0];
-    }
-    else
+    const CGFloat *components = CGColorGetComponents(linearColour);
+    UBKColourValue colourValue = UBKColourValueMakeLinear(components[0], components[1], components[2], components[3]);
+    CGColorRelease(linearColour);
+    return colourValue;
+}
+
++ (UIColor *)ubk_colourWithColourValue:(UBKColourValue)colourValue
+{
+    if (!colourValue.hasComponents)
     {
-        g = components[1];
-        if (g < 0)
-        {
-            g = 0;
-        }
-        
-        b = components[2];
-        if (b < 0)
-        {
-            b = 0;
-        }
-        a = components[3];
-        if (a < 0)
-        {
-            a = 0;
-        }
+        return nil;
     }
-
-    NSString *rgbString = [NSString stringWithFormat:@"R: %0.0f B: %0.0f \nG: %0.0f A: %0.0f", r * 255, b * 255, g * 255, a * 100];
-    return rgbString;
+    //colorWithRed:green:blue:alpha: takes extended sRGB, so out of gamut values survive the trip
+    return [UIColor colorWithRed:UBKColourValueEncodedFromLinear(colourValue.linear[0]) green:UBKColourValueEncodedFromLinear(colourValue.linear[1]) blue:UBKColourValueEncodedFromLinear(colourValue.linear[2]) alpha:colourValue.linear[3]];
 }
 
-- (double)ubk_contrastRatio:(UIColor *)other
+- (BOOL)ubk_isEqualToColour:(UIColor *)colour
 {
-    double lum1 = [self luminance];
-    double lum2 = [other luminance];
-    return (MAX(lum1, lum2) + 0.05) / (MIN(lum1, lum2) + 0.05);
+    if (!colour)
+    {
+        return false;
+    }
+    return UBKColourValueEqual(self.ubk_colourValue, colour.ubk_colourValue);
 }
 
-- (double)luminance
+- (NSString *)ubk_hexStringFromColour
 {
-    NSArray *rgb = [self rgbComponents];
-    
-    double r = [rgb[0] integerValue]/255.0;
-    double g = [rgb[1] integerValue]/255.0;
-    double b = [rgb[2] integerValue]/255.0;
-    
-    r = [self convertSrgbLuminance:r];
-    g = [self convertSrgbLuminance:g];
-    b = [self convertSrgbLuminance:b];
-    
-    return (r * 0.2126) + (g * 0.7152) + (b * 0.0722);
+    UBKColourRGBA8 rgba = UBKColourValueRGBA8(self.ubk_colourValue);
+    NSString *hextString = [NSString stringWithFormat:@"#%02X%02X%02X", rgba.r, rgba.g, rgba.b];
+    return hextString;
 }
 
-- (double)convertSrgbLuminance:(double)input
+- (NSString *)ubk_rgbStringFromColour
 {
-    if (input > 0.03928)
-    {
-        return pow((input+0.055)/1.055,2.4);
-    }
-    else
-    {
-        return input / 12.92;
-    }
+    UBKColourRGBA8 rgba = UBKColourValueRGBA8(self.ubk_colourValue);
+    NSString *rgbString = [NSString stringWithFormat:@"R: %d B: %d \nG: %d A: %0.0f", rgba.r, rgba.b, rgba.g, rgba.a / 2.55];
+    return rgbString;
 }
 
-- (NSArray<NSNumber *> *)rgbComponents
+- (double)ubk_contrastRatio:(UIColor *)other
 {
-    CGColorSpaceModel colorSpace = CGColorSpaceGetModel(CGColorGetColorSpace(self.CGColor));
-    const CGFloat *components = CGColorGetComponents(self.CGColor);
-    
-    NSInteger r = 0;
-    NSInteger g = 0;
-    NSInteger b = 0;
-    
-    if (colorSpace == kCGColorSpaceModelMonochrome)
-    {
-        r = components[0] * 255;
-        g = components[0] * 255;
-        b = components[0] * 255;
-    }
-    else if (colorSpace == kCGColorSpaceModelRGB)
-    {
-        r = components[0] * 255;
-        g = components[1] * 255;
-        b = components[2] * 255;
-    }
-    return @[@(r),@(g),@(b)];
+    return UBKColourValueContrastRatio(self.ubk_colourValue, other.ubk_colourValue);
 }
 
 - (UIColor *)ubk_lighterColour
@@ -243,11 +200,22 @@
 
 + (UIColor *)ubk_colourFromHexString:(NSString *)hexString
 {
-    unsigned rgbValue = 0;
-    NSScanner *scanner = [NSScanner scannerWithString:hexString];
-    [scanner setScanLocation:0]; // bypass '#' character
-    [scanner scanHexInt:&rgbValue];
-    return [UIColor colorWithRed:((rgbValue & 0xFF0000) >> 16)/255.0 green:((rgbValue & 0xFF00) >> 8)/255.0 blue:(rgbValue & 0xFF)/255.0 alpha:1.0];
+    if ((hexString.length > 0) && (![hexString hasPrefix:@"#"]) && (![hexString hasPrefix:@"rgb"]))
+    {
+        hexString = [@"#" stringByAppendingString:hexString];
+    }
+    const char *text = hexString.UTF8String;
+    uint32_t rgba;
+    if ((text == NULL) || (!UBKColourTokensParseColour(text, strlen(text), &rgba)))
+    {
+        return nil;
+    }
+    return [UIColor ubk_colourWithRGBA8:rgba];
+}
+
++ (UIColor *)ubk_colourWithRGBA8:(uint32_t)rgba
+{
+    return [UIColor colorWithRed:((rgba >> 24) & 0xFF) / 255.0 green:((rgba >> 16) & 0xFF) / 255.0 blue:((rgba >> 8) & 0xFF) / 255.0 alpha:(rgba & 0xFF) / 255.0];
 }
 
 + (UIColor *)ubk_warningLevelHighForegroundColour
@@ -24,7 +24,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface UIView (HelperMethods)
 - (UIImage *)ubk_createImage;
-- (UIColor *)ubk_findBackgroundColour:(UIView *)view;
+//Background seen behind the content of view, translucent backgrounds and view alpha are composited down to the first opaque ancestor. nil when nothing on the way down has a background. Walks the superviews, UBKAccessibilitySnapshot works this out for a whole hierarchy in one pass.
+- (nullable UIColor *)ubk_findBackgroundColour:(UIView *)view;
+//Alpha of the view multiplied by the alpha of its superviews
+- (CGFloat)ubk_cumulativeAlpha;
+//Background drawn by the view itself, nil when it doesn't draw one. Tab bars draw their barTintColor.
++ (nullable UIColor *)ubk_ownBackgroundColourForView:(UIView *)view;
 - (NSString *)ubk_formattedAccessibilityTraitString;
 - (NSString *)ubk_formattedRect:(CGRect)frame;
 
@@ -20,6 +20,7 @@
 
 #import "UIView+HelperMethods.h"
 #import "UBKAccessibilityVisibleWarningView.h"
+#import "UIColor+HelperMethods.h"
 
 @implementation UIView (HelperMethods)
 
@@ -37,9 +38,8 @@
     return bezierImage;
 }
 
-- (UIColor *)ubk_findBackgroundColour:(UIView *)view
++ (UIColor *)ubk_ownBackgroundColourForView:(UIView *)view
 {
-    UIColor *bgColour = view.backgroundColor;
     if ([view isKindOfClass:[UITabBar class]])
     {
         UITabBar *tabbar = (UITabBar *)view;
@@ -48,11 +48,41 @@
             return tabbar.barTintColor;
         }
     }
-    if (((bgColour != nil) & (bgColour != [UIColor clearColor])) || (view == nil))
+    UIColor *bgColour = view.backgroundColor;
+    if ((bgColour != nil) && (bgColour != [UIColor clearColor]))
     {
         return bgColour;
     }
-    return [self ubk_findBackgroundColour:view.superview];
+    return nil;
+}
+
+- (UIColor *)ubk_findBackgroundColour:(UIView *)view
+{
+    //Composite from the window down, so collect the superviews first
+    NSMutableArray <UIView *> *views = [[NSMutableArray alloc]init];
+    for (UIView *viewTmp = view; viewTmp != nil; viewTmp = viewTmp.superview)
+    {
+        [views addObject:viewTmp];
+    }
+    
+    UBKColourValue background = UBKColourValueMakeUnknown();
+    float opacity = 1;
+    for (UIView *viewTmp in views.reverseObjectEnumerator)
+    {
+        opacity *= viewTmp.alpha;
+        background = UBKColourValueComposite([UIView ubk_ownBackgroundColourForView:viewTmp].ubk_colourValue, opacity, background);
+    }
+    return [UIColor ubk_colourWithColourValue:background];
+}
+
+- (CGFloat)ubk_cumulativeAlpha
+{
+    CGFloat alpha = 1;
+    for (UIView *viewTmp = self; viewTmp != nil; viewTmp = viewTmp.superview)
+    {
+        alpha *= viewTmp.alpha;
+    }
+    return alpha;
 }
 
 - (NSString *)ubk_formattedAccessibilityTraitString
@@ -29,6 +29,12 @@ NS_ASSUME_NONNULL_BEGIN
 //The accessibility details array is the back bone for validations and displaying information about the ui element.
 - (NSArray <UBKAccessibilitySection *> *)ubk_accessibilityDetails;
 
+//Hash of everything the validation rules and the accessibility details read from the ui element. Subtrees with an unchanged hash reuse their previous audit results. Override this method in your custom class if it adds properties to the accessibility details, combining with super.
+- (uint64_t)ubk_accessibilityAuditHash;
+
+//Hash of what decides which rules warn, leaving out content that doesn't, eg the text itself or the position. Sibling subtrees with the same structure hash share one audit, eg table cells. Override alongside ubk_accessibilityAuditHash, hashing whether text is set rather than the text.
+- (uint64_t)ubk_accessibilityStructureHash;
+
 //Used to set the foreground colour for the ui element, eg if a label the text colour or a view is the tint colour. Override this method in your custom class.
 - (void)ubk_setColour:(UIColor *)colour;
 
@@ -24,12 +24,20 @@
 
 #import "UBKAccessibilitySection.h"
 #import "UBKAccessibilityValidation.h"
+#import "UBKAccessibilityTextRuns.h"
+#import "UBKAccessibilityControlStates.h"
+#import "UIColor+HelperMethods.h"
+#import "UBKAccessibilityAuditHash.h"
 
 @implementation UIButton (UBKAccessibility)
 
 - (nonnull NSArray<UBKAccessibilitySection *> *)ubk_accessibilityDetails
 {
     double contrastScore = 0;
+    UIColor *contrastBackgroundColour = nil;
+    UIColor *contrastForegroundColour = nil;
+    UBKAccessibilityTextRuns *textRuns = nil;
+    UBKAccessibilityControlStates *controlStates = nil;
     NSArray *items = [super ubk_accessibilityDetails];
     for (UBKAccessibilitySection *accessibilitySection in items)
     {
@@ -46,8 +54,11 @@
                 }
             }
             
-            contrastScore = [UBKAccessibilityValidation getViewContrastRatio:self.titleLabel?self.titleLabel.textColor:self.tintColor backgroundColor:bgColour];
-            ColourContrastRating contrastRating = [UBKAccessibilityValidation getColourContrastRatingForText:contrastScore withTextSize:self.titleLabel.font.pointSize withBoldFont:[self.titleLabel.font ubk_isFontBold]];
+            textRuns = [[UBKAccessibilityTextRuns alloc]initWithAttributedText:self.titleLabel.attributedText textColour:self.titleLabel?self.titleLabel.textColor:self.tintColor font:self.titleLabel.font forView:self backgroundColour:bgColour];
+            contrastForegroundColour = textRuns.worstForegroundColour;
+            contrastScore = textRuns.worstContrast;
+            contrastBackgroundColour = textRuns.worstBackgroundColour;
+            ColourContrastRating contrastRating = textRuns.worstRating;
             if (!self.titleLabel)
             {
                 contrastRating = [UBKAccessibilityValidation getColourContrastRatingForNonText:contrastScore];
@@ -80,33 +91,45 @@
             textColourProperty.warningType =UBKAccessibilityWarningTypeColourContrast;
             textColourProperty.displayWarning = self.titleLabel.text.length > 0 ? contrastWarning : false;
             [accessibilitySection addProperty:textColourProperty];
-            [accessibilitySection addProperty:[[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_NormalStateColour withColour:[self titleColorForState:UIControlStateNormal] withColourUpdateCompletionBlock:^(UIColor * _Nonnull updatedColour) {
-                [self setTitleColor:updatedColour forState:UIControlStateNormal];
-            }]];
-            [accessibilitySection addProperty:[[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_HighlightedStateColour withColour:[self titleColorForState:UIControlStateHighlighted] withColourUpdateCompletionBlock:^(UIColor * _Nonnull updatedColour) {
-                [self setTitleColor:updatedColour forState:UIControlStateHighlighted];
-            }]];
-            [accessibilitySection addProperty:[[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_DisabledStateColour withColour:[self titleColorForState:UIControlStateDisabled] withColourUpdateCompletionBlock:^(UIColor * _Nonnull updatedColour) {
-                [self setTitleColor:updatedColour forState:UIControlStateDisabled];
-            }]];
-            [accessibilitySection addProperty:[[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_SelectedStateColour withColour:[self titleColorForState:UIControlStateSelected] withColourUpdateCompletionBlock:^(UIColor * _Nonnull updatedColour) {
-                [self setTitleColor:updatedColour forState:UIControlStateSelected];
-            }]];
+            
+            //Every state is rated in one pass, the state colours show a warning when their state fails
+            controlStates = [[UBKAccessibilityControlStates alloc]initWithControl:self backgroundColour:bgColour];
+            [accessibilitySection addProperty:[self ubk_stateColourPropertyWithTitle:kUBKAccessibilityAttributeTitle_NormalStateColour forState:UIControlStateNormal withControlStates:controlStates]];
+            [accessibilitySection addProperty:[self ubk_stateColourPropertyWithTitle:kUBKAccessibilityAttributeTitle_HighlightedStateColour forState:UIControlStateHighlighted withControlStates:controlStates]];
+            [accessibilitySection addProperty:[self ubk_stateColourPropertyWithTitle:kUBKAccessibilityAttributeTitle_DisabledStateColour forState:UIControlStateDisabled withControlStates:controlStates]];
+            [accessibilitySection addProperty:[self ubk_stateColourPropertyWithTitle:kUBKAccessibilityAttributeTitle_SelectedStateColour forState:UIControlStateSelected withControlStates:controlStates]];
             [accessibilitySection addProperty:[[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_TintColour withColour:self.tintColor withColourUpdateCompletionBlock:^(UIColor * _Nonnull updatedColour) {
                 self.tintColor = updatedColour;
             }]];
             
+            if (textRuns.runCount > 1)
+            {
+                NSRange worstRunRange = textRuns.worstRunRange;
+                UIControlState state = self.state;
+                [accessibilitySection addProperty:[[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_LowestContrastRun withValue:textRuns.worstRunText]];
+                UBKAccessibilityProperty *worstRunColourProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_LowestContrastRunColour withColour:textRuns.worstTextColour withColourUpdateCompletionBlock:^(UIColor * _Nonnull updatedColour) {
+                    [self setAttributedTitle:[UBKAccessibilityTextRuns attributedText:self.titleLabel.attributedText settingColour:updatedColour inRange:worstRunRange] forState:state];
+                }];
+                worstRunColourProperty.warningType = UBKAccessibilityWarningTypeColourContrast;
+                worstRunColourProperty.displayWarning = contrastWarning;
+                [accessibilitySection addProperty:worstRunColourProperty];
+            }
+            
             if (contrastRating == ColourContrastRatingNA)
             {
                 [accessibilitySection removePropertyWithDisplayTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio];
             }
             else
             {
-                UBKAccessibilityProperty *contrastProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:self.titleLabel.textColor withBackgroundColour:bgColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TextBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
+                UBKAccessibilityProperty *contrastProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:contrastForegroundColour withBackgroundColour:contrastBackgroundColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TextBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
                 contrastProperty.warningType = UBKAccessibilityWarningTypeColourContrastBackground;
                 contrastProperty.warningLevel = UBKAccessibilityWarningLevelHigh;
                 [accessibilitySection addProperty:contrastProperty];
             }
+            for (UBKAccessibilityProperty *stateContrastProperty in controlStates.contrastProperties)
+            {
+                [accessibilitySection addProperty:stateContrastProperty];
+            }
         }
         else if (accessibilitySection.sectionType == SectionDisplayTypeTypography)
         {
@@ -128,7 +151,11 @@
         }
     }
     
-    NSArray *warningsArray = [UBKAccessibilityValidation checkAccessibilityWarningForButton:self withContrast:contrastScore];
+    NSMutableArray *warningsArray = [[NSMutableArray alloc]initWithArray:[UBKAccessibilityValidation checkAccessibilityWarningForButton:self withTextRuns:textRuns withControlStates:controlStates]];
+    if (self.titleLabel.text.length > 0)
+    {
+        [warningsArray addObjectsFromArray:[UBKAccessibilityValidation checkColourVisionWarningsForText:contrastForegroundColour backgroundColor:contrastBackgroundColour withTextSize:textRuns.worstTextSize withBoldFont:textRuns.worstBoldFont]];
+    }
     if (warningsArray.count > 0)
     {
         //UI element has a warning. Check which warning should be showed.
@@ -149,19 +176,86 @@
     return items;
 }
 
+- (UBKAccessibilityProperty *)ubk_stateColourPropertyWithTitle:(NSString *)title forState:(UIControlState)state withControlStates:(UBKAccessibilityControlStates *)controlStates
+{
+    UBKAccessibilityProperty *stateColourProperty = [[UBKAccessibilityProperty alloc]initWithTitle:title withColour:[self titleColorForState:state] withColourUpdateCompletionBlock:^(UIColor * _Nonnull updatedColour) {
+        [self setTitleColor:updatedColour forState:state];
+    }];
+    stateColourProperty.warningType = UBKAccessibilityWarningTypeStateColourContrast;
+    stateColourProperty.displayWarning = (state != self.state) && [controlStates isFailingForState:state];
+    return stateColourProperty;
+}
+
 - (void)ubk_setColour:(UIColor *)colour
 {
+    UBKColourValue previousColour = self.titleLabel.textColor.ubk_colourValue;
     [super ubk_setColour:colour];
     self.titleLabel.textColor = colour;
     
     if (self.currentAttributedTitle)
     {
-        NSMutableAttributedString *attributedString = [[NSMutableAttributedString alloc]initWithAttributedString:self.currentAttributedTitle];
-        [attributedString addAttribute:NSForegroundColorAttributeName value:colour range:NSMakeRange(0, attributedString.length)];
+        //Only the runs drawn in the title colour change, runs with a colour of their own keep it. Titles without any run in the title colour change as a whole.
+        NSAttributedString *currentTitle = self.currentAttributedTitle;
+        NSMutableAttributedString *attributedString = [[NSMutableAttributedString alloc]initWithAttributedString:currentTitle];
+        __block BOOL hasUpdatedRun = false;
+        [currentTitle enumerateAttribute:NSForegroundColorAttributeName inRange:NSMakeRange(0, currentTitle.length) options:0 usingBlock:^(UIColor *runColour, NSRange range, BOOL *stop) {
+            if ((!runColour) || (UBKColourValueEqual(runColour.ubk_colourValue, previousColour)))
+            {
+                [attributedString addAttribute:NSForegroundColorAttributeName value:colour range:range];
+                hasUpdatedRun = true;
+            }
+        }];
+        if (!hasUpdatedRun)
+        {
+            [attributedString addAttribute:NSForegroundColorAttributeName value:colour range:NSMakeRange(0, attributedString.length)];
+        }
         [self setAttributedTitle:attributedString forState:UIControlStateNormal];
     }
 }
 
+- (uint64_t)ubk_accessibilityAuditHash
+{
+    uint64_t hash = [super ubk_accessibilityAuditHash];
+    hash = UBKHashCombine(hash, self.state);
+    hash = UBKHashCombine(hash, self.buttonType);
+    hash = UBKAuditHashString(hash, self.titleLabel.text);
+    hash = UBKAuditHashColour(hash, self.titleLabel.textColor);
+    hash = UBKAuditHashFont(hash, self.titleLabel.font);
+    hash = UBKAuditHashTextRuns(hash, self.titleLabel.attributedText, true);
+    hash = UBKHashCombine(hash, self.titleLabel.adjustsFontForContentSizeCategory);
+    return [self ubk_controlStatesHash:hash];
+}
+
+- (uint64_t)ubk_accessibilityStructureHash
+{
+    uint64_t hash = [super ubk_accessibilityStructureHash];
+    hash = UBKHashCombine(hash, self.state);
+    hash = UBKHashCombine(hash, self.buttonType);
+    hash = UBKAuditHashHasText(hash, self.titleLabel.text);
+    hash = UBKAuditHashColour(hash, self.titleLabel.textColor);
+    hash = UBKAuditHashFont(hash, self.titleLabel.font);
+    hash = UBKAuditHashTextRuns(hash, self.titleLabel.attributedText, false);
+    hash = UBKHashCombine(hash, self.titleLabel.adjustsFontForContentSizeCategory);
+    return [self ubk_controlStatesHash:hash];
+}
+
+//Everything UBKAccessibilityControlStates reads for the other states
+- (uint64_t)ubk_controlStatesHash:(uint64_t)hash
+{
+    hash = UBKAuditHashColour(hash, self.tintColor);
+    const UIControlState states[] = {UIControlStateNormal, UIControlStateHighlighted, UIControlStateDisabled, UIControlStateSelected};
+    for (size_t i = 0; i < sizeof(states) / sizeof(states[0]); i++)
+    {
+        NSAttributedString *attributedTitle = [self attributedTitleForState:states[i]];
+        UIImage *backgroundImage = [self backgroundImageForState:states[i]];
+        hash = UBKAuditHashColour(hash, [self titleColorForState:states[i]]);
+        hash = UBKAuditHashHasText(hash, [self titleForState:states[i]]);
+        hash = UBKAuditHashTextRuns(hash, attributedTitle, false);
+        hash = UBKHashCombine(hash, (backgroundImage != nil) ? (uint64_t)backgroundImage.renderingMode + 1 : 0);
+    }
+    return hash;
+}
+
 - (NSString *)ubk_classIconName
 {
     return @"icon_button";
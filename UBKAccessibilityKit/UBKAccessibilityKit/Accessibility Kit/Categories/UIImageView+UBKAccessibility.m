@@ -24,12 +24,15 @@
 
 #import "UBKAccessibilitySection.h"
 #import "UBKAccessibilityValidation.h"
+#import "UBKAccessibilityAuditHash.h"
 
 @implementation UIImageView (UBKAccessibility)
 
 - (nonnull NSArray<UBKAccessibilitySection *> *)ubk_accessibilityDetails
 {
     double contrastScore = 0;
+    UIColor *contrastBackgroundColour = nil;
+    UIColor *contrastForegroundColour = nil;
     NSArray *items = [super ubk_accessibilityDetails];
     for (UBKAccessibilitySection *accessibilitySection in items)
     {
@@ -47,7 +50,9 @@
                         break;
                     }
                 }
-                contrastScore = [UBKAccessibilityValidation getViewContrastRatio:self.tintColor backgroundColor:bgColour];
+                contrastForegroundColour = [UBKAccessibilityValidation getEffectiveForegroundColour:self.tintColor forView:self backgroundColour:bgColour];
+                contrastScore = [UBKAccessibilityValidation getViewContrastRatio:contrastForegroundColour backgroundColor:bgColour];
+                contrastBackgroundColour = bgColour;
                 ColourContrastRating contrastRating = [UBKAccessibilityValidation getColourContrastRatingForNonText:contrastScore];
                 BOOL contrastWarning = false;
                 if (contrastRating == ColourContrastRatingFail)
@@ -59,7 +64,7 @@
                     self.tintColor = updatedColour;
                 }]];
                 
-                UBKAccessibilityProperty *contrastProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:self.tintColor withBackgroundColour:bgColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TextBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
+                UBKAccessibilityProperty *contrastProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:contrastForegroundColour withBackgroundColour:bgColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TextBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
                 contrastProperty.warningLevel = UBKAccessibilityWarningLevelHigh;
                 [accessibilitySection addProperty:contrastProperty];
             }
@@ -71,7 +76,9 @@
     }
     
     NSMutableArray *itemsTmp = [[NSMutableArray alloc]initWithArray:items];
-    NSArray *warningsArray = [UBKAccessibilityValidation checkAccessibilityWarningForImageView:self withContrast:contrastScore];
+    NSMutableArray *warningsArray = [[NSMutableArray alloc]initWithArray:[UBKAccessibilityValidation checkAccessibilityWarningForImageView:self withContrast:contrastScore]];
+    //The contrast background colour is only set for template images
+    [warningsArray addObjectsFromArray:[UBKAccessibilityValidation checkColourVisionWarningsForNonText:contrastForegroundColour backgroundColor:contrastBackgroundColour]];
     if (warningsArray.count > 0)
     {
         //UI element has a warning. Check which warning should be showed.
@@ -91,6 +98,21 @@
     return itemsTmp;
 }
 
+- (uint64_t)ubk_accessibilityAuditHash
+{
+    uint64_t hash = [super ubk_accessibilityAuditHash];
+    hash = UBKHashCombine(hash, (uint64_t)(uintptr_t)self.image);
+    return UBKHashCombine(hash, self.image.renderingMode);
+}
+
+//The rendering mode decides whether the tint contrast is checked
+- (uint64_t)ubk_accessibilityStructureHash
+{
+    uint64_t hash = [super ubk_accessibilityStructureHash];
+    hash = UBKHashCombine(hash, self.image != nil);
+    return UBKHashCombine(hash, self.image.renderingMode);
+}
+
 - (NSString *)ubk_classIconName
 {
     return @"icon_image";
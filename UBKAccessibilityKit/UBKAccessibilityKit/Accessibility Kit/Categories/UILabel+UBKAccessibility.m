@@ -24,6 +24,8 @@
 
 #import "UBKAccessibilitySection.h"
 #import "UBKAccessibilityValidation.h"
+#import "UBKAccessibilityTextRuns.h"
+#import "UBKAccessibilityAuditHash.h"
 
 
 @implementation UILabel (UBKAccessibility)
@@ -31,6 +33,9 @@
 - (nonnull NSArray<UBKAccessibilitySection *> *)ubk_accessibilityDetails
 {
     double contrastScore = 0;
+    UIColor *contrastBackgroundColour = nil;
+    UIColor *contrastForegroundColour = nil;
+    UBKAccessibilityTextRuns *textRuns = nil;
     NSArray *items = [super ubk_accessibilityDetails];
     for (UBKAccessibilitySection *accessibilitySection in items)
     {
@@ -46,8 +51,12 @@
                     break;
                 }
             }
-            contrastScore = [UBKAccessibilityValidation getViewContrastRatio:self.textColor backgroundColor:bgColour];
-            ColourContrastRating contrastRating = [UBKAccessibilityValidation getColourContrastRatingForText:contrastScore withTextSize:self.font.pointSize withBoldFont:[self.font ubk_isFontBold]];
+            //Attributed text can mix colours and sizes, each run is rated and the worst one is reported
+            textRuns = [[UBKAccessibilityTextRuns alloc]initWithAttributedText:self.attributedText textColour:self.textColor font:self.font forView:self backgroundColour:bgColour];
+            contrastForegroundColour = textRuns.worstForegroundColour;
+            contrastScore = textRuns.worstContrast;
+            contrastBackgroundColour = textRuns.worstBackgroundColour;
+            ColourContrastRating contrastRating = textRuns.worstRating;
             BOOL contrastWarning = false;
             if (contrastRating == ColourContrastRatingFail)
             {
@@ -64,7 +73,19 @@
                 self.tintColor = updatedColour;
             }]];
             
-            UBKAccessibilityProperty *contrastProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:self.textColor withBackgroundColour:bgColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TextBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
+            if (textRuns.runCount > 1)
+            {
+                NSRange worstRunRange = textRuns.worstRunRange;
+                [accessibilitySection addProperty:[[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_LowestContrastRun withValue:textRuns.worstRunText]];
+                UBKAccessibilityProperty *worstRunColourProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_LowestContrastRunColour withColour:textRuns.worstTextColour withColourUpdateCompletionBlock:^(UIColor * _Nonnull updatedColour) {
+                    self.attributedText = [UBKAccessibilityTextRuns attributedText:self.attributedText settingColour:updatedColour inRange:worstRunRange];
+                }];
+                worstRunColourProperty.warningType = UBKAccessibilityWarningTypeColourContrast;
+                worstRunColourProperty.displayWarning = contrastWarning;
+                [accessibilitySection addProperty:worstRunColourProperty];
+            }
+            
+            UBKAccessibilityProperty *contrastProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:contrastForegroundColour withBackgroundColour:contrastBackgroundColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TextBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
             contrastProperty.warningType = UBKAccessibilityWarningTypeColourContrastBackground;
             contrastProperty.warningLevel = UBKAccessibilityWarningLevelHigh;
             [accessibilitySection addProperty:contrastProperty];
@@ -95,7 +116,8 @@
         }
     }
     
-    NSArray *warningsArray = [UBKAccessibilityValidation checkAccessibilityWarningForLabel:self withContrast:contrastScore];
+    NSMutableArray *warningsArray = [[NSMutableArray alloc]initWithArray:[UBKAccessibilityValidation checkAccessibilityWarningForLabel:self withTextRuns:textRuns]];
+    [warningsArray addObjectsFromArray:[UBKAccessibilityValidation checkColourVisionWarningsForText:contrastForegroundColour backgroundColor:contrastBackgroundColour withTextSize:textRuns.worstTextSize withBoldFont:textRuns.worstBoldFont]];
     if (warningsArray.count > 0)
     {
         //UI element has a warning. Check which warning should be showed.
@@ -121,6 +143,26 @@
     self.textColor = colour;
 }
 
+- (uint64_t)ubk_accessibilityAuditHash
+{
+    uint64_t hash = [super ubk_accessibilityAuditHash];
+    hash = UBKAuditHashString(hash, self.text);
+    hash = UBKAuditHashColour(hash, self.textColor);
+    hash = UBKAuditHashFont(hash, self.font);
+    hash = UBKAuditHashTextRuns(hash, self.attributedText, true);
+    return UBKHashCombine(hash, self.adjustsFontForContentSizeCategory);
+}
+
+- (uint64_t)ubk_accessibilityStructureHash
+{
+    uint64_t hash = [super ubk_accessibilityStructureHash];
+    hash = UBKAuditHashHasText(hash, self.text);
+    hash = UBKAuditHashColour(hash, self.textColor);
+    hash = UBKAuditHashFont(hash, self.font);
+    hash = UBKAuditHashTextRuns(hash, self.attributedText, false);
+    return UBKHashCombine(hash, self.adjustsFontForContentSizeCategory);
+}
+
 - (NSString *)ubk_classIconName
 {
     return @"icon_label";
@@ -24,15 +24,39 @@
 
 #import "UBKAccessibilitySection.h"
 #import "UBKAccessibilityValidation.h"
+#import "UBKAccessibilityControlStates.h"
+#import "UBKAccessibilityAuditHash.h"
 
 @implementation UISwitch (UBKAccessibility)
 
 - (nonnull NSArray<UBKAccessibilitySection *> *)ubk_accessibilityDetails
 {
+    UBKAccessibilityControlStates *controlStates = nil;
     NSArray *items = [super ubk_accessibilityDetails];
+    for (UBKAccessibilitySection *accessibilitySection in items)
+    {
+        if (accessibilitySection.sectionType == SectionDisplayTypeColour)
+        {
+            UIColor *bgColour = self.backgroundColor;
+            for (UBKAccessibilityProperty *accessibilityProperty in accessibilitySection.items)
+            {
+                if ([accessibilityProperty.displayTitle isEqualToString:kUBKAccessibilityAttributeTitle_BackgroundColour])
+                {
+                    bgColour = accessibilityProperty.displayColour;
+                    break;
+                }
+            }
+            
+            controlStates = [[UBKAccessibilityControlStates alloc]initWithControl:self backgroundColour:bgColour];
+            for (UBKAccessibilityProperty *contrastProperty in controlStates.contrastProperties)
+            {
+                [accessibilitySection addProperty:contrastProperty];
+            }
+        }
+    }
     NSMutableArray *itemsTmp = [[NSMutableArray alloc]initWithArray:items];
     
-    NSArray *warningsArray = [UBKAccessibilityValidation checkAccessibilityWarningForSwitch:self];
+    NSArray *warningsArray = [UBKAccessibilityValidation checkAccessibilityWarningForSwitch:self withControlStates:controlStates];
     if (warningsArray.count > 0)
     {
         //UI element has a warning. Check which warning should be showed.
@@ -52,6 +76,22 @@
     return itemsTmp;
 }
 
+- (uint64_t)ubk_accessibilityAuditHash
+{
+    uint64_t hash = [super ubk_accessibilityAuditHash];
+    hash = UBKHashCombine(hash, self.isOn);
+    hash = UBKAuditHashColour(hash, self.onTintColor);
+    return UBKAuditHashColour(hash, self.thumbTintColor);
+}
+
+- (uint64_t)ubk_accessibilityStructureHash
+{
+    uint64_t hash = [super ubk_accessibilityStructureHash];
+    hash = UBKHashCombine(hash, self.isOn);
+    hash = UBKAuditHashColour(hash, self.onTintColor);
+    return UBKAuditHashColour(hash, self.thumbTintColor);
+}
+
 - (NSString *)ubk_classIconName
 {
     return @"icon_switch";
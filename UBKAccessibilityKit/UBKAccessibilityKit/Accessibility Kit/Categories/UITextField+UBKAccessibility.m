@@ -24,12 +24,17 @@
 
 #import "UBKAccessibilitySection.h"
 #import "UBKAccessibilityValidation.h"
+#import "UBKAccessibilityTextRuns.h"
+#import "UBKAccessibilityAuditHash.h"
 
 @implementation UITextField (UBKAccessibility)
 
 - (nonnull NSArray<UBKAccessibilitySection *> *)ubk_accessibilityDetails
 {
     double contrastScore = 0;
+    UIColor *contrastBackgroundColour = nil;
+    UIColor *contrastForegroundColour = nil;
+    UBKAccessibilityTextRuns *textRuns = nil;
     NSArray *items = [super ubk_accessibilityDetails];
     for (UBKAccessibilitySection *accessibilitySection in items)
     {
@@ -46,8 +51,11 @@
                 }
             }
             
-            contrastScore = [UBKAccessibilityValidation getViewContrastRatio:self.textColor backgroundColor:bgColour];
-            ColourContrastRating contrastRating = [UBKAccessibilityValidation getColourContrastRatingForText:contrastScore withTextSize:self.font.pointSize withBoldFont:[self.font ubk_isFontBold]];
+            textRuns = [[UBKAccessibilityTextRuns alloc]initWithAttributedText:self.attributedText textColour:self.textColor font:self.font forView:self backgroundColour:bgColour];
+            contrastForegroundColour = textRuns.worstForegroundColour;
+            contrastScore = textRuns.worstContrast;
+            contrastBackgroundColour = textRuns.worstBackgroundColour;
+            ColourContrastRating contrastRating = textRuns.worstRating;
             BOOL contrastWarning = false;
             if (contrastRating == ColourContrastRatingFail)
             {
@@ -64,7 +72,19 @@
                 self.tintColor = updatedColour;
             }]];
             
-            UBKAccessibilityProperty *contrastRatioProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:self.textColor withBackgroundColour:bgColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TextBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
+            if (textRuns.runCount > 1)
+            {
+                NSRange worstRunRange = textRuns.worstRunRange;
+                [accessibilitySection addProperty:[[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_LowestContrastRun withValue:textRuns.worstRunText]];
+                UBKAccessibilityProperty *worstRunColourProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_LowestContrastRunColour withColour:textRuns.worstTextColour withColourUpdateCompletionBlock:^(UIColor * _Nonnull updatedColour) {
+                    self.attributedText = [UBKAccessibilityTextRuns attributedText:self.attributedText settingColour:updatedColour inRange:worstRunRange];
+                }];
+                worstRunColourProperty.warningType = UBKAccessibilityWarningTypeColourContrast;
+                worstRunColourProperty.displayWarning = contrastWarning;
+                [accessibilitySection addProperty:worstRunColourProperty];
+            }
+            
+            UBKAccessibilityProperty *contrastRatioProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:contrastForegroundColour withBackgroundColour:contrastBackgroundColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TextBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
             contrastRatioProperty.warningLevel = UBKAccessibilityWarningLevelHigh;
             textColourProperty.warningType = UBKAccessibilityWarningTypeColourContrast;
             contrastRatioProperty.displayWarning = contrastWarning;
@@ -85,7 +105,8 @@
         }
     }
     
-    NSArray *warningsArray = [UBKAccessibilityValidation checkAccessibilityWarningForTextfield:self withContrast:contrastScore];
+    NSMutableArray *warningsArray = [[NSMutableArray alloc]initWithArray:[UBKAccessibilityValidation checkAccessibilityWarningForTextfield:self withTextRuns:textRuns]];
+    [warningsArray addObjectsFromArray:[UBKAccessibilityValidation checkColourVisionWarningsForText:contrastForegroundColour backgroundColor:contrastBackgroundColour withTextSize:textRuns.worstTextSize withBoldFont:textRuns.worstBoldFont]];
     if (warningsArray.count > 0)
     {
         //UI element has a warning. Check which warning should be showed.
@@ -111,6 +132,28 @@
     self.textColor = colour;
 }
 
+- (uint64_t)ubk_accessibilityAuditHash
+{
+    uint64_t hash = [super ubk_accessibilityAuditHash];
+    hash = UBKAuditHashString(hash, self.text);
+    hash = UBKAuditHashString(hash, self.placeholder);
+    hash = UBKAuditHashColour(hash, self.textColor);
+    hash = UBKAuditHashFont(hash, self.font);
+    hash = UBKAuditHashTextRuns(hash, self.attributedText, true);
+    return UBKHashCombine(hash, self.adjustsFontForContentSizeCategory);
+}
+
+- (uint64_t)ubk_accessibilityStructureHash
+{
+    uint64_t hash = [super ubk_accessibilityStructureHash];
+    hash = UBKAuditHashHasText(hash, self.text);
+    hash = UBKAuditHashHasText(hash, self.placeholder);
+    hash = UBKAuditHashColour(hash, self.textColor);
+    hash = UBKAuditHashFont(hash, self.font);
+    hash = UBKAuditHashTextRuns(hash, self.attributedText, false);
+    return UBKHashCombine(hash, self.adjustsFontForContentSizeCategory);
+}
+
 - (NSString *)ubk_classIconName
 {
     return @"icon_textfield";
@@ -25,12 +25,17 @@
 
 #import "UBKAccessibilitySection.h"
 #import "UBKAccessibilityValidation.h"
+#import "UBKAccessibilityTextRuns.h"
+#import "UBKAccessibilityAuditHash.h"
 
 @implementation UITextView (UBKAccessibility)
 
 - (nonnull NSArray<UBKAccessibilitySection *> *)ubk_accessibilityDetails
 {
     double contrastScore = 0;
+    UIColor *contrastBackgroundColour = nil;
+    UIColor *contrastForegroundColour = nil;
+    UBKAccessibilityTextRuns *textRuns = nil;
     NSArray *items = [super ubk_accessibilityDetails];
     for (UBKAccessibilitySection *accessibilitySection in items)
     {
@@ -47,8 +52,11 @@
                 }
             }
             
-            contrastScore = [UBKAccessibilityValidation getViewContrastRatio:self.textColor backgroundColor:bgColour];
-            ColourContrastRating contrastRating = [UBKAccessibilityValidation getColourContrastRatingForText:contrastScore withTextSize:self.font.pointSize withBoldFont:[self.font ubk_isFontBold]];
+            textRuns = [[UBKAccessibilityTextRuns alloc]initWithAttributedText:self.attributedText textColour:self.textColor font:self.font forView:self backgroundColour:bgColour];
+            contrastForegroundColour = textRuns.worstForegroundColour;
+            contrastScore = textRuns.worstContrast;
+            contrastBackgroundColour = textRuns.worstBackgroundColour;
+            ColourContrastRating contrastRating = textRuns.worstRating;
             BOOL contrastWarning = false;
             if (contrastRating == ColourContrastRatingFail)
             {
@@ -65,7 +73,19 @@
                 self.tintColor = updatedColour;
             }]];
             
-            UBKAccessibilityProperty *contrastProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:self.textColor withBackgroundColour:bgColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TextBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
+            if (textRuns.runCount > 1)
+            {
+                NSRange worstRunRange = textRuns.worstRunRange;
+                [accessibilitySection addProperty:[[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_LowestContrastRun withValue:textRuns.worstRunText]];
+                UBKAccessibilityProperty *worstRunColourProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_LowestContrastRunColour withColour:textRuns.worstTextColour withColourUpdateCompletionBlock:^(UIColor * _Nonnull updatedColour) {
+                    self.attributedText = [UBKAccessibilityTextRuns attributedText:self.attributedText settingColour:updatedColour inRange:worstRunRange];
+                }];
+                worstRunColourProperty.warningType = UBKAccessibilityWarningTypeColourContrast;
+                worstRunColourProperty.displayWarning = contrastWarning;
+                [accessibilitySection addProperty:worstRunColourProperty];
+            }
+            
+            UBKAccessibilityProperty *contrastProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:contrastForegroundColour withBackgroundColour:contrastBackgroundColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TextBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
             contrastProperty.warningLevel = UBKAccessibilityWarningLevelHigh;
             [accessibilitySection addProperty:contrastProperty];
         }
@@ -90,7 +110,8 @@
         }
     }
     
-    NSArray *warningsArray = [UBKAccessibilityValidation checkAccessibilityWarningForTextView:self withContrast:contrastScore];
+    NSMutableArray *warningsArray = [[NSMutableArray alloc]initWithArray:[UBKAccessibilityValidation checkAccessibilityWarningForTextView:self withTextRuns:textRuns]];
+    [warningsArray addObjectsFromArray:[UBKAccessibilityValidation checkColourVisionWarningsForText:contrastForegroundColour backgroundColor:contrastBackgroundColour withTextSize:textRuns.worstTextSize withBoldFont:textRuns.worstBoldFont]];
     if (warningsArray.count > 0)
     {
         //UI element has a warning. Check which warning should be showed.
@@ -116,6 +137,26 @@
     self.textColor = colour;
 }
 
+- (uint64_t)ubk_accessibilityAuditHash
+{
+    uint64_t hash = [super ubk_accessibilityAuditHash];
+    hash = UBKAuditHashString(hash, self.text);
+    hash = UBKAuditHashColour(hash, self.textColor);
+    hash = UBKAuditHashFont(hash, self.font);
+    hash = UBKAuditHashTextRuns(hash, self.attributedText, true);
+    return UBKHashCombine(hash, self.adjustsFontForContentSizeCategory);
+}
+
+- (uint64_t)ubk_accessibilityStructureHash
+{
+    uint64_t hash = [super ubk_accessibilityStructureHash];
+    hash = UBKAuditHashHasText(hash, self.text);
+    hash = UBKAuditHashColour(hash, self.textColor);
+    hash = UBKAuditHashFont(hash, self.font);
+    hash = UBKAuditHashTextRuns(hash, self.attributedText, false);
+    return UBKHashCombine(hash, self.adjustsFontForContentSizeCategory);
+}
+
 - (NSString *)ubk_classIconName
 {
     return @"icon_textview";
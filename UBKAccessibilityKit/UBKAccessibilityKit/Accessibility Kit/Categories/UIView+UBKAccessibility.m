@@ -20,6 +20,8 @@
 
 #import "UIView+UBKAccessibility.h"
 
+#import <objc/runtime.h>
+
 //Categories
 #import "UIColor+HelperMethods.h"
 #import "UIFont+HelperMethods.h"
@@ -28,6 +30,7 @@
 
 #import "UBKAccessibilitySection.h"
 #import "UBKAccessibilityValidation.h"
+#import "UBKAccessibilityAuditHash.h"
 
 @implementation UIView (UBKAccessibility)
 
@@ -35,7 +38,7 @@
 
 - (NSArray<UBKAccessibilitySection *> *)ubk_accessibilityDetails
 {
-    UIColor *bgColour = [self ubk_findBackgroundColour:self];
+    UIColor *bgColour = [UBKAccessibilityValidation getEffectiveBackgroundColour:self];
     NSMutableArray *sectionsArray = [[NSMutableArray alloc]init];
     
     UBKAccessibilitySection *accessibilityAttributesSection = [[UBKAccessibilitySection alloc]initWithHeader:kUBKAccessibilityAttributeTitle_AccessibilityAttributes type:SectionDisplayTypeAccessibilityAttributes];
@@ -56,7 +59,8 @@
     }
     [sectionsArray addObject:attributesSection];
     
-    CGFloat contrastScore = [UBKAccessibilityValidation getViewContrastRatio:self.tintColor backgroundColor:bgColour];
+    UIColor *tintColour = [UBKAccessibilityValidation getEffectiveForegroundColour:self.tintColor forView:self backgroundColour:bgColour];
+    CGFloat contrastScore = [UBKAccessibilityValidation getViewContrastRatio:tintColour backgroundColor:bgColour];
     ColourContrastRating contrastRating = [UBKAccessibilityValidation getColourContrastRatingForNonText:contrastScore];
     BOOL contrastWarning = false;
     if (contrastRating == ColourContrastRatingFail)
@@ -67,7 +71,7 @@
     UBKAccessibilitySection *coloursSection = [[UBKAccessibilitySection alloc]initWithHeader:kUBKAccessibilityAttributeTitle_Colours type:SectionDisplayTypeColour];
     if (([self respondsToSelector:@selector(font)]) || ([self respondsToSelector:@selector(textLabel)]) || ([self isKindOfClass:[UIImageView class]]))
     {
-        UBKAccessibilityProperty *contrastProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:self.tintColor withBackgroundColour:bgColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TintBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
+        UBKAccessibilityProperty *contrastProperty = [[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_W3CContrastRatio withValue:[NSString stringWithFormat:@"%0.2f", contrastScore] withForegroundColour:tintColour withBackgroundColour:bgColour withAlternateTitle:kUBKAccessibilityAttributeTitle_TintBackgroundColour withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:contrastRating] showContrastWarning:contrastWarning];
         contrastProperty.warningLevel = UBKAccessibilityWarningLevelHigh;
         [coloursSection addProperty:contrastProperty];
     }
@@ -78,6 +82,10 @@
     [coloursSection addProperty:[[UBKAccessibilityProperty alloc]initWithTitle:kUBKAccessibilityAttributeTitle_TintColour withColour:self.tintColor withColourUpdateCompletionBlock:^(UIColor * _Nonnull updatedColour) {
         self.tintColor = updatedColour;
     }]];
+    for (UBKAccessibilityProperty *appearanceContrastProperty in [UBKAccessibilityValidation getAppearanceContrastProperties:self])
+    {
+        [coloursSection addProperty:appearanceContrastProperty];
+    }
     [sectionsArray addObject:coloursSection];
     
     if (([self respondsToSelector:@selector(font)]) || ([self respondsToSelector:@selector(textLabel)]))
@@ -91,6 +99,47 @@
     return sectionsArray;
 }
 
+- (uint64_t)ubk_accessibilityAuditHash
+{
+    uint64_t hash = UBKHashString(UBKHashInitialValue, object_getClassName(self));
+    hash = UBKAuditHashRect(hash, self.frame);
+    hash = UBKAuditHashDouble(hash, self.alpha);
+    hash = UBKHashCombine(hash, ((uint64_t)self.hidden << 2) | ((uint64_t)self.userInteractionEnabled << 1) | (uint64_t)self.isAccessibilityElement);
+    hash = UBKHashCombine(hash, self.accessibilityTraits);
+    hash = UBKAuditHashString(hash, self.accessibilityLabel);
+    hash = UBKAuditHashString(hash, self.accessibilityHint);
+    hash = UBKAuditHashString(hash, self.accessibilityValue);
+    hash = UBKAuditHashString(hash, self.accessibilityIdentifier);
+    hash = UBKAuditHashColour(hash, self.backgroundColor);
+    hash = UBKAuditHashColour(hash, self.tintColor);
+    return hash;
+}
+
+- (uint64_t)ubk_accessibilityStructureHash
+{
+    uint64_t hash = UBKHashString(UBKHashInitialValue, object_getClassName(self));
+    hash = UBKAuditHashDouble(UBKAuditHashDouble(hash, self.frame.size.width), self.frame.size.height);
+    hash = UBKAuditHashDouble(hash, self.alpha);
+    hash = UBKHashCombine(hash, ((uint64_t)self.hidden << 2) | ((uint64_t)self.userInteractionEnabled << 1) | (uint64_t)self.isAccessibilityElement);
+    hash = UBKHashCombine(hash, self.accessibilityTraits);
+    hash = UBKAuditHashHasText(hash, self.accessibilityLabel);
+    hash = UBKAuditHashHasText(hash, self.accessibilityHint);
+    hash = UBKAuditHashHasText(hash, self.accessibilityValue);
+    //Some rules warn when the label just repeats the identifier
+    hash = UBKHashCombine(hash, [self.accessibilityLabel isEqualToString:self.accessibilityIdentifier]);
+    hash = UBKAuditHashColour(hash, self.backgroundColor);
+    hash = UBKAuditHashColour(hash, self.tintColor);
+    if ([self isKindOfClass:[UITableViewCell class]])
+    {
+        hash = UBKAuditHashString(hash, ((UITableViewCell *)self).reuseIdentifier);
+    }
+    else if ([self isKindOfClass:[UICollectionReusableView class]])
+    {
+        hash = UBKAuditHashString(hash, ((UICollectionReusableView *)self).reuseIdentifier);
+    }
+    return hash;
+}
+
 - (void)ubk_setColour:(UIColor *)colour
 {
     self.tintColor = colour;
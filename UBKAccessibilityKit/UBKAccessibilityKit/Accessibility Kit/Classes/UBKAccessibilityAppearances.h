@@ -0,0 +1,70 @@
+/*
+ File: UBKAccessibilityAppearances.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@class UBKAccessibilitySnapshot, UBKAccessibilityProperty;
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef enum : NSUInteger {
+    UBKAccessibilityAppearanceLight,
+    UBKAccessibilityAppearanceDark,
+    UBKAccessibilityAppearanceLightIncreasedContrast,
+    UBKAccessibilityAppearanceDarkIncreasedContrast,
+    UBKAccessibilityAppearanceCount
+} UBKAccessibilityAppearance;
+
+//Screen level contrast check for a snapshot in the light, dark and increased contrast appearances. The text and template image colours of each visible element, and the backgrounds behind them, are resolved for every appearance from the one capture and rated together in one UBKContrastPairsEvaluate call. Dynamic colours need iOS 13, there are no elements before that.
+@interface UBKAccessibilityAppearances : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot NS_DESIGNATED_INITIALIZER;
+
+//Visible elements with a rated colour
+@property (nonatomic, readonly) NSUInteger elementCount;
+//Elements that fail in an appearance they aren't shown in
+@property (nonatomic, readonly) NSUInteger failingCount;
+
+//Bit (1 << appearance) is set for each appearance the view fails in, 0 if the view isn't rated
+- (uint32_t)failingAppearancesForView:(UIView *)view;
+
+//True when the view fails in an appearance other than the one it's shown in, the contrast checks of the view cover that one
+- (BOOL)hasWarningForView:(UIView *)view;
+
+//A contrast property for each appearance the view has known colours in
+- (NSArray <UBKAccessibilityProperty *> *)contrastPropertiesForView:(UIView *)view;
+
+//Folds the failing appearances into the snapshot node hashes. Call updateSubtreeHashes on the snapshot after.
+- (void)combineResultsIntoSnapshot;
+
+//The appearance the view is shown in
++ (UBKAccessibilityAppearance)appearanceForView:(UIView *)view;
+
+//The colour rated against the background, font is set for text. nil when the view doesn't draw one.
++ (nullable UIColor *)foregroundColourForView:(UIView *)view font:(UIFont * _Nullable * _Nonnull)font;
+
++ (NSString *)nameForAppearance:(UBKAccessibilityAppearance)appearance;
+
+@end
+
+NS_ASSUME_NONNULL_END
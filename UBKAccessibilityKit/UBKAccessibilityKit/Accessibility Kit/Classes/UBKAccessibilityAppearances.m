@@ -0,0 +1,321 @@
+/*
+ File: UBKAccessibilityAppearances.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import "UBKAccessibilityAppearances.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityScanArena.h"
+#import "UBKAccessibilityClassInfo.h"
+#import "UBKAccessibilityManager.h"
+#import "UBKAccessibilityProperty.h"
+#import "UBKAccessibilityValidation.h"
+#import "UBKContrastPairs.h"
+#import "UIColor+HelperMethods.h"
+#import "UIFont+HelperMethods.h"
+#import "UIView+HelperMethods.h"
+
+@interface UBKAccessibilityAppearances ()
+@property (nonatomic) UBKAccessibilitySnapshot *snapshot;
+@property (nonatomic, readwrite) NSUInteger elementCount;
+@property (nonatomic, readwrite) NSUInteger failingCount;
+//UBKAccessibilityAppearanceCount UBKContrastPairs for each element, in appearance order
+@property (nonatomic) const UBKContrastPair *pairs;
+//Snapshot node index for each element
+@property (nonatomic) const uint32_t *elementNodes;
+@property (nonatomic) NSMapTable <UIView *, NSNumber *> *elementIndexes;
+@end
+
+@implementation UBKAccessibilityAppearances
+
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    if (self = [super init])
+    {
+        self.snapshot = snapshot;
+        self.elementIndexes = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        if (@available(iOS 13.0, *))
+        {
+            [self analyseSnapshot];
+        }
+    }
+    return self;
+}
+
+- (void)analyseSnapshot API_AVAILABLE(ios(13.0))
+{
+    const UBKSnapshotNode *nodes = self.snapshot.nodes;
+    NSUInteger nodeCount = self.snapshot.nodeCount;
+    NSArray <UIView *> *views = self.snapshot.views;
+    
+    UITraitCollection *traitCollections[UBKAccessibilityAppearanceCount];
+    for (NSUInteger appearance = 0; appearance < UBKAccessibilityAppearanceCount; appearance++)
+    {
+        traitCollections[appearance] = [UBKAccessibilityAppearances traitCollectionForAppearance:appearance];
+    }
+    
+    //Backgrounds are composited the same way as the snapshot, once for each appearance. Parents always come first.
+    UBKAccessibilityScanArena *scanArena = self.snapshot.scanArena;
+    UBKColourValue *backgrounds = [scanArena allocateCount:nodeCount * UBKAccessibilityAppearanceCount size:sizeof(UBKColourValue)];
+    BOOL *hidden = [scanArena allocateCount:nodeCount size:sizeof(BOOL)];
+    UBKContrastPair *pairs = [scanArena allocateCount:nodeCount * UBKAccessibilityAppearanceCount size:sizeof(UBKContrastPair)];
+    uint32_t *nodeIndexes = [scanArena allocateCount:nodeCount size:sizeof(uint32_t)];
+    if ((backgrounds == NULL) || (hidden == NULL) || (pairs == NULL) || (nodeIndexes == NULL))
+    {
+        return;
+    }
+    uint32_t elementCount = 0;
+    
+    for (NSUInteger i = 0; i < nodeCount; i++)
+    {
+        UIView *view = views[i];
+        float opacity = [self.snapshot opacityAtIndex:i];
+        UIColor *ownBackgroundColour = [UIView ubk_ownBackgroundColourForView:view];
+        UIColor *windowBackgroundColour = (nodes[i].parent < 0) ? view.window.backgroundColor : nil;
+        float windowOpacity = (view.window != nil) ? view.window.alpha : 1;
+        for (NSUInteger appearance = 0; appearance < UBKAccessibilityAppearanceCount; appearance++)
+        {
+            UBKColourValue parentBackground;
+            if (nodes[i].parent >= 0)
+            {
+                parentBackground = backgrounds[nodes[i].parent * UBKAccessibilityAppearanceCount + appearance];
+            }
+            else
+            {
+                parentBackground = UBKColourValueComposite([windowBackgroundColour resolvedColorWithTraitCollection:traitCollections[appearance]].ubk_colourValue, windowOpacity, UBKColourValueMakeUnknown());
+            }
+            backgrounds[i * UBKAccessibilityAppearanceCount + appearance] = UBKColourValueComposite([ownBackgroundColour resolvedColorWithTraitCollection:traitCollections[appearance]].ubk_colourValue, opacity, parentBackground);
+        }
+        
+        hidden[i] = (nodes[i].flags & UBKSnapshotNodeFlagHidden) || ((nodes[i].parent >= 0) && (hidden[nodes[i].parent]));
+        if ((!(nodes[i].flags & UBKSnapshotNodeFlagElement)) || (hidden[i]))
+        {
+            continue;
+        }
+        
+        UIFont *font = nil;
+        UIColor *foregroundColour = [UBKAccessibilityAppearances foregroundColourForView:view font:&font];
+        if (!foregroundColour)
+        {
+            continue;
+        }
+        for (NSUInteger appearance = 0; appearance < UBKAccessibilityAppearanceCount; appearance++)
+        {
+            UBKContrastPair *pair = &pairs[elementCount * UBKAccessibilityAppearanceCount + appearance];
+            pair->foreground = [foregroundColour resolvedColorWithTraitCollection:traitCollections[appearance]].ubk_colourValue;
+            //The element's own background is part of the composited background, eg a label with a fill
+            pair->background = backgrounds[i * UBKAccessibilityAppearanceCount + appearance];
+            pair->opacity = opacity;
+            pair->tag = (uint32_t)appearance;
+            if (font)
+            {
+                pair->flags = UBKContrastPairFlagText;
+                pair->textSize = font.pointSize;
+                pair->boldFont = [font ubk_isFontBold];
+            }
+        }
+        nodeIndexes[elementCount] = (uint32_t)i;
+        [self.elementIndexes setObject:@(elementCount) forKey:view];
+        elementCount++;
+    }
+    
+    //Every appearance of every element is rated in one go
+    UBKContrastPairsEvaluate(pairs, elementCount * UBKAccessibilityAppearanceCount, [UBKAccessibilityManager sharedInstance].ruleEvaluator);
+    
+    for (uint32_t element = 0; element < elementCount; element++)
+    {
+        if ([self hasWarningForElement:element view:views[nodeIndexes[element]] pairs:pairs])
+        {
+            self.failingCount++;
+        }
+    }
+    
+    self.elementCount = elementCount;
+    self.pairs = pairs;
+    self.elementNodes = nodeIndexes;
+}
+
++ (UITraitCollection *)traitCollectionForAppearance:(UBKAccessibilityAppearance)appearance API_AVAILABLE(ios(13.0))
+{
+    BOOL isDark = (appearance == UBKAccessibilityAppearanceDark) || (appearance == UBKAccessibilityAppearanceDarkIncreasedContrast);
+    BOOL isIncreasedContrast = (appearance == UBKAccessibilityAppearanceLightIncreasedContrast) || (appearance == UBKAccessibilityAppearanceDarkIncreasedContrast);
+    return [UITraitCollection traitCollectionWithTraitsFromCollections:@[[UITraitCollection traitCollectionWithUserInterfaceStyle:isDark ? UIUserInterfaceStyleDark : UIUserInterfaceStyleLight], [UITraitCollection traitCollectionWithAccessibilityContrast:isIncreasedContrast ? UIAccessibilityContrastHigh : UIAccessibilityContrastNormal]]];
+}
+
++ (UIColor *)foregroundColourForView:(UIView *)view font:(UIFont **)font
+{
+    switch ([UBKAccessibilityClassInfo classInfoForView:view].objectClass)
+    {
+        case UBKAccessibilityObjectClassUILabel:
+        {
+            UILabel *label = (UILabel *)view;
+            *font = label.font;
+            return (label.text.length > 0) ? label.textColor : nil;
+        }
+        case UBKAccessibilityObjectClassUIButton:
+        {
+            UIButton *button = (UIButton *)view;
+            *font = button.titleLabel.font;
+            return (button.currentTitle.length > 0) ? (button.currentTitleColor ?: button.titleLabel.textColor) : nil;
+        }
+        case UBKAccessibilityObjectClassUITextfield:
+        {
+            *font = ((UITextField *)view).font;
+            return ((UITextField *)view).textColor;
+        }
+        case UBKAccessibilityObjectClassUITextView:
+        {
+            *font = ((UITextView *)view).font;
+            return ((UITextView *)view).textColor;
+        }
+        case UBKAccessibilityObjectClassUIImageView:
+        {
+            UIImage *image = ((UIImageView *)view).image;
+            return (image.renderingMode == UIImageRenderingModeAlwaysTemplate) ? view.tintColor : nil;
+        }
+        default:
+        {
+            return nil;
+        }
+    }
+}
+
++ (UBKAccessibilityAppearance)appearanceForView:(UIView *)view
+{
+    if (@available(iOS 13.0, *))
+    {
+        BOOL isDark = (view.traitCollection.userInterfaceStyle == UIUserInterfaceStyleDark);
+        if (view.traitCollection.accessibilityContrast == UIAccessibilityContrastHigh)
+        {
+            return isDark ? UBKAccessibilityAppearanceDarkIncreasedContrast : UBKAccessibilityAppearanceLightIncreasedContrast;
+        }
+        return isDark ? UBKAccessibilityAppearanceDark : UBKAccessibilityAppearanceLight;
+    }
+    return UBKAccessibilityAppearanceLight;
+}
+
++ (NSString *)nameForAppearance:(UBKAccessibilityAppearance)appearance
+{
+    switch (appearance)
+    {
+        case UBKAccessibilityAppearanceDark:
+        {
+            return kUBKAccessibilityAttributeTitle_DarkAppearanceContrast;
+        }
+        case UBKAccessibilityAppearanceLightIncreasedContrast:
+        {
+            return kUBKAccessibilityAttributeTitle_LightIncreasedContrast;
+        }
+        case UBKAccessibilityAppearanceDarkIncreasedContrast:
+        {
+            return kUBKAccessibilityAttributeTitle_DarkIncreasedContrast;
+        }
+        default:
+        {
+            return kUBKAccessibilityAttributeTitle_LightAppearanceContrast;
+        }
+    }
+}
+
+- (const UBKContrastPair *)pairsForView:(UIView *)view
+{
+    NSNumber *index = [self.elementIndexes objectForKey:view];
+    if (index == nil)
+    {
+        return NULL;
+    }
+    const UBKContrastPair *pairs = self.pairs;
+    return &pairs[index.unsignedIntegerValue * UBKAccessibilityAppearanceCount];
+}
+
+- (uint32_t)failingAppearancesForView:(UIView *)view
+{
+    const UBKContrastPair *pairs = [self pairsForView:view];
+    uint32_t failingAppearances = 0;
+    for (NSUInteger appearance = 0; (pairs != NULL) && (appearance < UBKAccessibilityAppearanceCount); appearance++)
+    {
+        if (pairs[appearance].isFailing)
+        {
+            failingAppearances |= (1 << appearance);
+        }
+    }
+    return failingAppearances;
+}
+
+- (BOOL)hasWarningForElement:(uint32_t)element view:(UIView *)view pairs:(const UBKContrastPair *)pairs
+{
+    UBKAccessibilityAppearance currentAppearance = [UBKAccessibilityAppearances appearanceForView:view];
+    for (NSUInteger appearance = 0; appearance < UBKAccessibilityAppearanceCount; appearance++)
+    {
+        if ((appearance != currentAppearance) && (pairs[element * UBKAccessibilityAppearanceCount + appearance].isFailing))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+- (BOOL)hasWarningForView:(UIView *)view
+{
+    NSNumber *index = [self.elementIndexes objectForKey:view];
+    return (index != nil) && [self hasWarningForElement:(uint32_t)index.unsignedIntegerValue view:view pairs:self.pairs];
+}
+
+- (NSArray<UBKAccessibilityProperty *> *)contrastPropertiesForView:(UIView *)view
+{
+    const UBKContrastPair *pairs = [self pairsForView:view];
+    if (pairs == NULL)
+    {
+        return @[];
+    }
+    NSMutableArray *properties = [[NSMutableArray alloc]init];
+    for (NSUInteger appearance = 0; appearance < UBKAccessibilityAppearanceCount; appearance++)
+    {
+        const UBKContrastPair *pair = &pairs[appearance];
+        if (pair->rating == UBKRuleRatingNA)
+        {
+            continue;
+        }
+        UIColor *foregroundColour = [UIColor ubk_colourWithColourValue:UBKColourValueComposite(pair->foreground, pair->opacity, pair->background)];
+        UIColor *backgroundColour = [UIColor ubk_colourWithColourValue:pair->background];
+        NSString *alternateTitle = (pair->flags & UBKContrastPairFlagText) ? kUBKAccessibilityAttributeTitle_TextBackgroundColour : kUBKAccessibilityAttributeTitle_TintBackgroundColour;
+        UBKAccessibilityProperty *property = [[UBKAccessibilityProperty alloc]initWithTitle:[UBKAccessibilityAppearances nameForAppearance:appearance] withValue:[NSString stringWithFormat:@"%0.2f", pair->contrast] withForegroundColour:foregroundColour withBackgroundColour:backgroundColour withAlternateTitle:alternateTitle withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:(ColourContrastRating)pair->rating] showContrastWarning:pair->isFailing];
+        property.warningType = UBKAccessibilityWarningTypeAppearanceContrast;
+        property.warningLevel = UBKAccessibilityWarningLevelHigh;
+        [properties addObject:property];
+    }
+    return properties;
+}
+
+- (void)combineResultsIntoSnapshot
+{
+    const uint32_t *nodeIndexes = self.elementNodes;
+    NSArray <UIView *> *views = self.snapshot.views;
+    for (NSUInteger i = 0; i < self.elementCount; i++)
+    {
+        uint32_t failingAppearances = [self failingAppearancesForView:views[nodeIndexes[i]]];
+        if (failingAppearances != 0)
+        {
+            //Shifted so the hash tells it apart from the other screen level results
+            [self.snapshot combineHash:((uint64_t)failingAppearances << 56) intoNodeAtIndex:nodeIndexes[i]];
+        }
+    }
+}
+
+@end
@@ -0,0 +1,58 @@
+/*
+ File: UBKAccessibilityAuditCache.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@class UBKAccessibilitySnapshot, UBKAccessibilitySection, UBKAccessibilitySubtreeGroups;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Keeps the accessibility details from the previous refresh. Subtrees whose Merkle hash matches the previous snapshot reuse their details wholesale, so the cost of a refresh scales with what changed on screen.
+@interface UBKAccessibilityAuditCache : NSObject
+
+//Counts for the last call to updateWithSnapshot:
+@property (nonatomic, readonly) NSUInteger reusedNodeCount;
+@property (nonatomic, readonly) NSUInteger recomputedNodeCount;
+//Recomputed nodes that are elements, ie the audits that actually ran
+@property (nonatomic, readonly) NSUInteger recomputedElementCount;
+//Recomputed elements that took the results of a repeated sibling rather than being audited
+@property (nonatomic, readonly) NSUInteger sharedElementCount;
+
+//Counts since the cache was created
+@property (nonatomic, readonly) NSUInteger totalReusedNodeCount;
+@property (nonatomic, readonly) NSUInteger totalRecomputedNodeCount;
+
+- (void)updateWithSnapshot:(UBKAccessibilitySnapshot *)snapshot;
+//Elements of repeated subtrees that need recomputing share the results of their representative. Their own details are only worked out if they are read with accessibilityDetailsForView:, eg when one is opened in the inspector.
+- (void)updateWithSnapshot:(UBKAccessibilitySnapshot *)snapshot subtreeGroups:(nullable UBKAccessibilitySubtreeGroups *)subtreeGroups;
+
+//Returns the cached details for a view in the current snapshot. Views not in the snapshot are audited directly.
+- (NSArray <UBKAccessibilitySection *> *)accessibilityDetailsForView:(UIView *)view;
+
+//Drop all cached results, eg when the colour palette or the rules change.
+- (void)invalidate;
+
+//Drop the cached results for a view and its descendants, eg after a colour was edited in the inspector. Descendants can take their background from the view so they're included. The snapshot's backgrounds for the subtree are read again, the results are recomputed the next time they are read and aren't reused by the next refresh.
+- (void)invalidateSubtreeOfView:(UIView *)view;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,194 @@
+/*
+ File: UBKAccessibilityAuditCache.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "UBKAccessibilityAuditCache.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilitySubtreeGroups.h"
+#import "UIView+UBKAccessibility.h"
+
+@interface UBKAccessibilityAuditCache ()
+@property (nonatomic) UBKAccessibilitySnapshot *snapshot;
+//Details for each node in the snapshot, NSNull for nodes that aren't audited
+@property (nonatomic) NSMutableArray *details;
+//Nodes edited since the snapshot was taken, their hashes no longer describe the view
+@property (nonatomic) NSMutableIndexSet *editedIndexes;
+//Edited nodes and shared nodes whose own details haven't been worked out yet
+@property (nonatomic) NSMutableIndexSet *staleIndexes;
+@property (nonatomic, readwrite) NSUInteger reusedNodeCount;
+@property (nonatomic, readwrite) NSUInteger recomputedNodeCount;
+@property (nonatomic, readwrite) NSUInteger recomputedElementCount;
+@property (nonatomic, readwrite) NSUInteger sharedElementCount;
+@property (nonatomic, readwrite) NSUInteger totalReusedNodeCount;
+@property (nonatomic, readwrite) NSUInteger totalRecomputedNodeCount;
+@end
+
+@implementation UBKAccessibilityAuditCache
+
+- (void)invalidate
+{
+    self.snapshot = nil;
+    self.details = nil;
+    self.editedIndexes = nil;
+    self.staleIndexes = nil;
+}
+
+- (void)invalidateSubtreeOfView:(UIView *)view
+{
+    NSInteger index = self.snapshot ? [self.snapshot indexOfView:view] : NSNotFound;
+    if (index == NSNotFound)
+    {
+        return;
+    }
+    NSRange range = NSMakeRange(index, self.snapshot.nodes[index].subtreeEnd - index);
+    [self.editedIndexes addIndexesInRange:range];
+    [self.staleIndexes addIndexesInRange:range];
+    //The recomputed details take their effective background from the snapshot
+    [self.snapshot updateCompositingOfSubtreeAtIndex:index];
+}
+
+- (void)updateWithSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    [self updateWithSnapshot:snapshot subtreeGroups:nil];
+}
+
+- (void)updateWithSnapshot:(UBKAccessibilitySnapshot *)snapshot subtreeGroups:(UBKAccessibilitySubtreeGroups *)subtreeGroups
+{
+    UBKAccessibilitySnapshot *previousSnapshot = self.snapshot;
+    NSArray *previousDetails = self.details;
+    const UBKSnapshotNode *nodes = snapshot.nodes;
+    const UBKSnapshotNode *previousNodes = previousSnapshot.nodes;
+    NSArray <UIView *> *views = snapshot.views;
+    NSArray <UIView *> *previousViews = previousSnapshot.views;
+    NSIndexSet *editedIndexes = self.editedIndexes;
+    NSIndexSet *previousStaleIndexes = self.staleIndexes;
+    const UBKSubtreeGroup *groups = subtreeGroups.groups;
+    
+    NSMutableArray *details = [[NSMutableArray alloc]initWithCapacity:snapshot.nodeCount];
+    NSMutableIndexSet *staleIndexes = [[NSMutableIndexSet alloc]init];
+    NSUInteger reused = 0;
+    NSUInteger recomputed = 0;
+    NSUInteger recomputedElements = 0;
+    NSUInteger sharedElements = 0;
+    NSUInteger index = 0;
+    while (index < snapshot.nodeCount)
+    {
+        UIView *view = views[index];
+        NSInteger previousIndex = previousSnapshot ? [previousSnapshot indexOfView:view] : NSNotFound;
+        if ((previousIndex != NSNotFound) && (![editedIndexes containsIndex:previousIndex]))
+        {
+            NSUInteger length = nodes[index].subtreeEnd - index;
+            const UBKSnapshotNode *previousNode = &previousNodes[previousIndex];
+            
+            //Unchanged subtree, take all of its results in one go
+            if ((previousNode->subtreeHash == nodes[index].subtreeHash) && ((previousNode->subtreeEnd - previousIndex) == length) && (![editedIndexes intersectsIndexesInRange:NSMakeRange(previousIndex, length)]) && ([self views:views matchViews:previousViews atIndex:index previousIndex:previousIndex length:length]))
+            {
+                [details addObjectsFromArray:[previousDetails subarrayWithRange:NSMakeRange(previousIndex, length)]];
+                //Edited nodes are never reused, so these are shared results still standing in for their own
+                [previousStaleIndexes enumerateIndexesInRange:NSMakeRange(previousIndex, length) options:0 usingBlock:^(NSUInteger staleIndex, BOOL *stop) {
+                    [staleIndexes addIndex:staleIndex - previousIndex + index];
+                }];
+                reused += length;
+                index += length;
+                continue;
+            }
+            
+            //Only something below this node changed, reuse the node itself and check the children
+            if (previousNode->nodeHash == nodes[index].nodeHash)
+            {
+                [details addObject:previousDetails[previousIndex]];
+                if ([previousStaleIndexes containsIndex:previousIndex])
+                {
+                    [staleIndexes addIndex:index];
+                }
+                reused++;
+                index++;
+                continue;
+            }
+        }
+        
+        NSUInteger representative = groups ? (NSUInteger)groups[index].representative : index;
+        if ((representative != index) && (details[representative] != [NSNull null]))
+        {
+            //The details reference their view, eg the colour blocks, so they only stand in until the view's own are read
+            [details addObject:details[representative]];
+            [staleIndexes addIndex:index];
+            sharedElements++;
+        }
+        else if (nodes[index].flags & UBKSnapshotNodeFlagElement)
+        {
+            [details addObject:view.ubk_accessibilityDetails];
+            recomputedElements++;
+        }
+        else
+        {
+            [details addObject:[NSNull null]];
+        }
+        recomputed++;
+        index++;
+    }
+    
+    self.snapshot = snapshot;
+    self.details = details;
+    self.editedIndexes = [[NSMutableIndexSet alloc]init];
+    self.staleIndexes = staleIndexes;
+    self.reusedNodeCount = reused;
+    self.recomputedNodeCount = recomputed;
+    self.recomputedElementCount = recomputedElements;
+    self.sharedElementCount = sharedElements;
+    self.totalReusedNodeCount += reused;
+    self.totalRecomputedNodeCount += recomputed;
+}
+
+//Equal hashes could come from a different view with identical content, eg a swapped cell. The cached details reference their views so only reuse them for the same views.
+- (BOOL)views:(NSArray *)views matchViews:(NSArray *)previousViews atIndex:(NSUInteger)index previousIndex:(NSUInteger)previousIndex length:(NSUInteger)length
+{
+    for (NSUInteger i = 0; i < length; i++)
+    {
+        if (views[index + i] != previousViews[previousIndex + i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+- (NSArray<UBKAccessibilitySection *> *)accessibilityDetailsForView:(UIView *)view
+{
+    NSInteger index = [self.snapshot indexOfView:view];
+    if ((index != NSNotFound) && (index < self.details.count))
+    {
+        if ([self.staleIndexes containsIndex:index])
+        {
+            [self.staleIndexes removeIndex:index];
+            if (self.details[index] != [NSNull null])
+            {
+                self.details[index] = view.ubk_accessibilityDetails;
+            }
+        }
+        id details = self.details[index];
+        if (details != [NSNull null])
+        {
+            return details;
+        }
+    }
+    return view.ubk_accessibilityDetails;
+}
+
+@end
@@ -0,0 +1,79 @@
+/*
+ File: UBKAccessibilityAuditHash.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <UIKit/UIKit.h>
+#import "UBKHash.h"
+
+//Helpers for the ubk_accessibilityAuditHash implementations. Only values the validation rules and inspector details read should be hashed.
+
+static inline uint64_t UBKAuditHashString(uint64_t hash, NSString *string)
+{
+    return UBKHashString(UBKHashCombine(hash, string.length), string.UTF8String);
+}
+
+//For structure hashes, whether there is any text rather than the text itself
+static inline uint64_t UBKAuditHashHasText(uint64_t hash, NSString *string)
+{
+    return UBKHashCombine(hash, string.length > 0);
+}
+
+static inline uint64_t UBKAuditHashColour(uint64_t hash, UIColor *colour)
+{
+    if (!colour)
+    {
+        return UBKHashCombine(hash, 0);
+    }
+    CGColorRef cgColour = colour.CGColor;
+    hash = UBKHashCombine(hash, (uint64_t)(uintptr_t)CGColorGetColorSpace(cgColour));
+    return UBKHashBytes(hash, CGColorGetComponents(cgColour), CGColorGetNumberOfComponents(cgColour) * sizeof(CGFloat));
+}
+
+static inline uint64_t UBKAuditHashFont(uint64_t hash, UIFont *font)
+{
+    hash = UBKAuditHashString(hash, font.fontName);
+    return UBKHashBytes(hash, &(double){font.pointSize}, sizeof(double));
+}
+
+//Colours and font of each attribute run of attributedText, with the run ranges when includeRanges is true. Structure hashes leave the ranges out as they follow the text.
+static inline uint64_t UBKAuditHashTextRuns(uint64_t hash, NSAttributedString *attributedText, BOOL includeRanges)
+{
+    __block uint64_t runsHash = UBKHashCombine(hash, attributedText.length > 0);
+    [attributedText enumerateAttributesInRange:NSMakeRange(0, attributedText.length) options:0 usingBlock:^(NSDictionary<NSAttributedStringKey, id> *attributes, NSRange range, BOOL *stop) {
+        if (includeRanges)
+        {
+            runsHash = UBKHashCombine(UBKHashCombine(runsHash, range.location), range.length);
+        }
+        runsHash = UBKAuditHashColour(runsHash, attributes[NSForegroundColorAttributeName]);
+        runsHash = UBKAuditHashColour(runsHash, attributes[NSBackgroundColorAttributeName]);
+        runsHash = UBKAuditHashFont(runsHash, attributes[NSFontAttributeName]);
+    }];
+    return runsHash;
+}
+
+static inline uint64_t UBKAuditHashDouble(uint64_t hash, double value)
+{
+    return UBKHashBytes(hash, &value, sizeof(double));
+}
+
+static inline uint64_t UBKAuditHashRect(uint64_t hash, CGRect rect)
+{
+    double values[4] = {rect.origin.x, rect.origin.y, rect.size.width, rect.size.height};
+    return UBKHashBytes(hash, values, sizeof(values));
+}
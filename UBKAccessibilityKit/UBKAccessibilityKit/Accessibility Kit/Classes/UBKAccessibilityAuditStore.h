@@ -0,0 +1,75 @@
+/*
+ File: UBKAccessibilityAuditStore.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "UBKAuditStore.h"
+
+@class UBKAccessibilitySection;
+@class UBKAccessibilitySnapshot;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Audit results kept across sessions and builds in a memory mapped file, see UBKAuditStore. Set one on a UBKAccessibilitySessionRecorder to store a record for every element with warnings on each screen it records, and a marker for the screen itself.
+//The file can be read on other platforms with UBKAuditStore, eg to ask which screens had contrast failures last week.
+@interface UBKAccessibilityAuditStore : NSObject
+
+@property (nonatomic, readonly) NSURL *fileURL;
+//Stored in each appended record as buildHash. Defaults to the app version and build number.
+@property (nonatomic, readonly) NSString *buildIdentifier;
+@property (nonatomic, readonly) uint64_t buildHash;
+@property (nonatomic, readonly) uint64_t recordCount;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+//Returns nil if the file can't be opened or isn't an audit store. The file is created if needed.
+- (nullable instancetype)initWithFileURL:(NSURL *)fileURL;
+- (nullable instancetype)initWithFileURL:(NSURL *)fileURL buildIdentifier:(NSString *)buildIdentifier;
+
++ (uint64_t)hashForBuildIdentifier:(NSString *)buildIdentifier;
+
+//Fills in the contrast and text size of a record from an element's accessibility details
++ (void)measureSections:(NSArray <UBKAccessibilitySection *> *)sections intoRecord:(UBKAuditRecord *)record;
+
+//The records for an audited snapshot, a screen marker and one for each element with warnings, read through the shared UBKAccessibilityManager. block, if set, is called with the details of every element on the screen, with or without warnings.
++ (NSData *)recordsForSnapshot:(UBKAccessibilitySnapshot *)snapshot buildHash:(uint64_t)buildHash date:(NSDate *)date usingBlock:(nullable void (NS_NOESCAPE ^)(NSUInteger index, NSArray <UBKAccessibilitySection *> *sections, uint64_t warningMask))block;
+
+- (BOOL)appendRecords:(const UBKAuditRecord *)records count:(NSUInteger)count;
+
+- (uint64_t)countRecordsMatchingQuery:(UBKAuditQuery)query;
+- (void)enumerateRecordsMatchingQuery:(UBKAuditQuery)query usingBlock:(void (NS_NOESCAPE ^)(const UBKAuditRecord *record, BOOL *stop))block;
+
+//Screen fingerprints with at least one matching record
+- (NSSet <NSNumber *> *)screensMatchingQuery:(UBKAuditQuery)query;
+
+//Writes the warnings that appeared, went away or changed between two builds as JSON lines, see UBKAuditDiff. The latest audit of each screen in each build is compared.
+- (BOOL)writeDiffFromBuild:(NSString *)baseBuildIdentifier toBuild:(NSString *)headBuildIdentifier toFileURL:(NSURL *)fileURL;
+
+//Drops records older than date, pass nil to keep them, and repeats of the same warnings on the same element in the same build.
+- (BOOL)compactRemovingRecordsOlderThan:(nullable NSDate *)date;
+
+//Picks up records appended by another process.
+- (BOOL)refresh;
+- (BOOL)synchronize;
+- (void)close;
+
+@end
+
+NS_ASSUME_NONNULL_END
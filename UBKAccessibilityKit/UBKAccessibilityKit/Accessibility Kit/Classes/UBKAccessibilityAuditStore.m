@@ -0,0 +1,284 @@
+/*
+ File: UBKAccessibilityAuditStore.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import "UBKAccessibilityAuditStore.h"
+#import "UBKHash.h"
+#import "UBKAuditDiff.h"
+#import "UBKAccessibilitySection.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityManager.h"
+
+typedef struct {
+    __unsafe_unretained void (^block)(const UBKAuditRecord *record, BOOL *stop);
+} UBKAccessibilityAuditStoreQueryContext;
+
+static bool UBKAccessibilityAuditStoreVisitRecord(const UBKAuditRecord *record, uint64_t recordNumber, void *context)
+{
+    UBKAccessibilityAuditStoreQueryContext *queryContext = context;
+    BOOL stop = false;
+    queryContext->block(record, &stop);
+    return !stop;
+}
+
+@interface UBKAccessibilityAuditStore ()
+{
+    UBKAuditStore _store;
+    BOOL _isOpen;
+}
+@end
+
+@implementation UBKAccessibilityAuditStore
+
++ (NSString *)defaultBuildIdentifier
+{
+    NSDictionary *info = [NSBundle mainBundle].infoDictionary;
+    return [NSString stringWithFormat:@"%@ (%@)", info[@"CFBundleShortVersionString"] ?: @"", info[@"CFBundleVersion"] ?: @""];
+}
+
++ (uint64_t)hashForBuildIdentifier:(NSString *)buildIdentifier
+{
+    return UBKHashString(UBKHashInitialValue, buildIdentifier.UTF8String);
+}
+
+//Contrast and text size come from the values shown in the inspector
++ (void)measureSections:(NSArray <UBKAccessibilitySection *> *)sections intoRecord:(UBKAuditRecord *)record
+{
+    record->contrast = 0;
+    record->textSize = 0;
+    for (UBKAccessibilitySection *section in sections)
+    {
+        if ((section.sectionType != SectionDisplayTypeColour) && (section.sectionType != SectionDisplayTypeTypography))
+        {
+            continue;
+        }
+        for (UBKAccessibilityProperty *property in section.items)
+        {
+            if ([property.displayTitle isEqualToString:kUBKAccessibilityAttributeTitle_W3CContrastRatio])
+            {
+                record->contrast = property.displayValue.floatValue;
+            }
+            else if ([property.displayTitle isEqualToString:kUBKAccessibilityAttributeTitle_FontSize])
+            {
+                record->textSize = property.displayValue.floatValue;
+            }
+        }
+    }
+}
+
++ (NSData *)recordsForSnapshot:(UBKAccessibilitySnapshot *)snapshot buildHash:(uint64_t)buildHash date:(NSDate *)date usingBlock:(void (NS_NOESCAPE ^)(NSUInteger, NSArray<UBKAccessibilitySection *> *, uint64_t))block
+{
+    NSMutableData *keys = [[NSMutableData alloc]initWithLength:MAX(snapshot.nodeCount, 1) * sizeof(uint64_t)];
+    [snapshot getElementKeys:keys.mutableBytes];
+    const uint64_t *elementKeys = keys.bytes;
+    
+    NSMutableData *records = [[NSMutableData alloc]init];
+    const UBKSnapshotNode *nodes = snapshot.nodes;
+    int64_t timestamp = (int64_t)date.timeIntervalSince1970;
+    
+    //Marks the screen as audited even when none of its elements have warnings
+    UBKAuditRecord marker = {0};
+    marker.screen = snapshot.fingerprint;
+    marker.build = buildHash;
+    marker.timestamp = timestamp;
+    [records appendBytes:&marker length:sizeof(marker)];
+    for (NSUInteger i = 0; i < snapshot.nodeCount; i++)
+    {
+        if (!(nodes[i].flags & UBKSnapshotNodeFlagElement))
+        {
+            continue;
+        }
+        
+        NSArray <UBKAccessibilitySection *> *sections = [[UBKAccessibilityManager sharedInstance] accessibilityDetailsForView:snapshot.views[i]];
+        uint64_t warningMask = 0;
+        for (UBKAccessibilitySection *section in sections)
+        {
+            if (section.sectionType != SectionDisplayTypeWarnings)
+            {
+                continue;
+            }
+            for (UBKAccessibilityProperty *property in section.items)
+            {
+                warningMask |= (1ULL << property.warningType);
+            }
+        }
+        if (block)
+        {
+            block(i, sections, warningMask);
+        }
+        //Only elements with warnings are stored
+        if (warningMask == 0)
+        {
+            continue;
+        }
+        
+        UBKAuditRecord record = {0};
+        record.screen = snapshot.fingerprint;
+        record.element = elementKeys[i];
+        record.build = buildHash;
+        record.warningMask = warningMask;
+        record.timestamp = timestamp;
+        record.x = (float)nodes[i].frame.x;
+        record.y = (float)nodes[i].frame.y;
+        record.width = (float)nodes[i].frame.width;
+        record.height = (float)nodes[i].frame.height;
+        [UBKAccessibilityAuditStore measureSections:sections intoRecord:&record];
+        [records appendBytes:&record length:sizeof(record)];
+    }
+    return records;
+}
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL
+{
+    return [self initWithFileURL:fileURL buildIdentifier:[UBKAccessibilityAuditStore defaultBuildIdentifier]];
+}
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL buildIdentifier:(NSString *)buildIdentifier
+{
+    if (self = [super init])
+    {
+        if (!UBKAuditStoreOpen(&_store, fileURL.fileSystemRepresentation, false))
+        {
+            return nil;
+        }
+        _isOpen = true;
+        _fileURL = fileURL;
+        _buildIdentifier = [buildIdentifier copy];
+        _buildHash = [UBKAccessibilityAuditStore hashForBuildIdentifier:buildIdentifier];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self close];
+}
+
+- (void)close
+{
+    if (_isOpen)
+    {
+        UBKAuditStoreSync(&_store);
+        UBKAuditStoreClose(&_store);
+        _isOpen = false;
+    }
+}
+
+- (uint64_t)recordCount
+{
+    return _isOpen ? UBKAuditStoreCount(&_store) : 0;
+}
+
+- (BOOL)appendRecords:(const UBKAuditRecord *)records count:(NSUInteger)count
+{
+    return _isOpen && UBKAuditStoreAppend(&_store, records, count);
+}
+
+- (uint64_t)countRecordsMatchingQuery:(UBKAuditQuery)query
+{
+    return _isOpen ? UBKAuditStoreQuery(&_store, &query, NULL, NULL) : 0;
+}
+
+- (void)enumerateRecordsMatchingQuery:(UBKAuditQuery)query usingBlock:(void (NS_NOESCAPE ^)(const UBKAuditRecord *, BOOL *))block
+{
+    if (!_isOpen)
+    {
+        return;
+    }
+    UBKAccessibilityAuditStoreQueryContext context;
+    context.block = block;
+    UBKAuditStoreQuery(&_store, &query, UBKAccessibilityAuditStoreVisitRecord, &context);
+}
+
+- (NSSet<NSNumber *> *)screensMatchingQuery:(UBKAuditQuery)query
+{
+    UBKHashSet screens;
+    if (!UBKHashSetInit(&screens, 64))
+    {
+        return [NSSet set];
+    }
+    NSMutableSet *screenNumbers = [[NSMutableSet alloc]init];
+    [self enumerateRecordsMatchingQuery:query usingBlock:^(const UBKAuditRecord *record, BOOL *stop) {
+        if (UBKHashSetInsert(&screens, record->screen))
+        {
+            [screenNumbers addObject:@(record->screen)];
+        }
+    }];
+    UBKHashSetDestroy(&screens);
+    return screenNumbers;
+}
+
+- (BOOL)writeDiffFromBuild:(NSString *)baseBuildIdentifier toBuild:(NSString *)headBuildIdentifier toFileURL:(NSURL *)fileURL
+{
+    if (!_isOpen)
+    {
+        return false;
+    }
+    UBKAuditRecord *baseRecords = NULL;
+    UBKAuditRecord *headRecords = NULL;
+    size_t baseCount = 0;
+    size_t headCount = 0;
+    UBKAuditDiff diff;
+    UBKAuditDiffInit(&diff);
+    BOOL success = UBKAuditDiffCollectBuild(&_store, [UBKAccessibilityAuditStore hashForBuildIdentifier:baseBuildIdentifier], &baseRecords, &baseCount) &&
+        UBKAuditDiffCollectBuild(&_store, [UBKAccessibilityAuditStore hashForBuildIdentifier:headBuildIdentifier], &headRecords, &headCount) &&
+        UBKAuditDiffCompute(&diff, baseRecords, baseCount, headRecords, headCount);
+    if (success)
+    {
+        FILE *file = fopen(fileURL.fileSystemRepresentation, "w");
+        success = (file != NULL) && UBKAuditDiffWriteJSONLines(&diff, baseRecords, headRecords, file);
+        if ((file) && (fclose(file) != 0))
+        {
+            success = false;
+        }
+    }
+    UBKAuditDiffDestroy(&diff);
+    free(baseRecords);
+    free(headRecords);
+    return success;
+}
+
+- (BOOL)compactRemovingRecordsOlderThan:(NSDate *)date
+{
+    if (!_isOpen)
+    {
+        return false;
+    }
+    int64_t olderThan = date ? (int64_t)date.timeIntervalSince1970 : 0;
+    if (!UBKAuditStoreCompact(&_store, olderThan))
+    {
+        //The store is closed if it couldn't be reopened after the swap
+        _isOpen = _store.map != NULL;
+        return false;
+    }
+    return true;
+}
+
+- (BOOL)refresh
+{
+    return _isOpen && UBKAuditStoreRefresh(&_store);
+}
+
+- (BOOL)synchronize
+{
+    return _isOpen && UBKAuditStoreSync(&_store);
+}
+
+@end
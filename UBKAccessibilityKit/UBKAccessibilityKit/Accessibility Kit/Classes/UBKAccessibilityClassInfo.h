@@ -0,0 +1,54 @@
+/*
+ File: UBKAccessibilityClassInfo.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "UBKAccessibilityConstants.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef enum : NSUInteger {
+    ///text colour contrast, text runs and dynamic type
+    UBKAccessibilityClassRuleText = 1 << 0,
+    ///colours are rated in every control state
+    UBKAccessibilityClassRuleControlStates = 1 << 1,
+    ///touch target size and spacing
+    UBKAccessibilityClassRuleTouchTarget = 1 << 2
+} UBKAccessibilityClassRules;
+
+//What the kit needs to know about a view class, worked out the first time a view of the class is seen and then shared by every view of it. Looking one up is a single map lookup on the class pointer, rather than building the class name for every view on every walk and hit test. Only use it from the main thread.
+@interface UBKAccessibilityClassInfo : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
++ (UBKAccessibilityClassInfo *)classInfoForView:(UIView *)view;
+
+//Apple private classes, eg _UILayoutGuide, are left out of the walk and the inspector
+@property (nonatomic, readonly) BOOL isPrivate;
+//Nearest class the filter knows, UBKAccessibilityObjectClassUIView for anything else
+@property (nonatomic, readonly) UBKAccessibilityObjectClass objectClass;
+@property (nonatomic, readonly) NSString *iconName;
+@property (nonatomic, readonly) UBKAccessibilityClassRules rules;
+//UBKHashString of the class name, used for the snapshot nodes
+@property (nonatomic, readonly) uint64_t classHash;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,116 @@
+/*
+ File: UBKAccessibilityClassInfo.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "UBKAccessibilityClassInfo.h"
+#import "UBKHash.h"
+#import "UIView+UBKAccessibility.h"
+
+#import <objc/runtime.h>
+
+@interface UBKAccessibilityClassInfo ()
+@property (nonatomic, readwrite) BOOL isPrivate;
+@property (nonatomic, readwrite) UBKAccessibilityObjectClass objectClass;
+@property (nonatomic, readwrite) NSString *iconName;
+@property (nonatomic, readwrite) UBKAccessibilityClassRules rules;
+@property (nonatomic, readwrite) uint64_t classHash;
+@end
+
+@implementation UBKAccessibilityClassInfo
+
++ (UBKAccessibilityClassInfo *)classInfoForView:(UIView *)view
+{
+    //Classes are never unloaded, so the class pointers are safe to keep as keys
+    static NSMapTable <Class, UBKAccessibilityClassInfo *> *classInfos = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        classInfos = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality valueOptions:NSPointerFunctionsStrongMemory];
+    });
+    
+    //The class the view reports rather than its isa, so KVO subclasses share the record of the class they observe
+    Class viewClass = [view class];
+    UBKAccessibilityClassInfo *classInfo = [classInfos objectForKey:viewClass];
+    if (classInfo == nil)
+    {
+        classInfo = [[UBKAccessibilityClassInfo alloc]initWithView:view];
+        [classInfos setObject:classInfo forKey:viewClass];
+    }
+    return classInfo;
+}
+
+- (instancetype)initWithView:(UIView *)view
+{
+    if (self = [super init])
+    {
+        const char *className = class_getName([view class]);
+        self.isPrivate = (className[0] == '_');
+        self.classHash = UBKHashString(UBKHashInitialValue, className);
+        //Every category returns a constant for its class
+        self.iconName = [view ubk_classIconName];
+        [self classifyView:view];
+    }
+    return self;
+}
+
+- (void)classifyView:(UIView *)view
+{
+    if ([view isKindOfClass:[UIButton class]])
+    {
+        self.objectClass = UBKAccessibilityObjectClassUIButton;
+        self.rules = UBKAccessibilityClassRuleText | UBKAccessibilityClassRuleControlStates | UBKAccessibilityClassRuleTouchTarget;
+    }
+    else if ([view isKindOfClass:[UISwitch class]])
+    {
+        self.objectClass = UBKAccessibilityObjectClassUISwitch;
+        self.rules = UBKAccessibilityClassRuleControlStates | UBKAccessibilityClassRuleTouchTarget;
+    }
+    else if ([view isKindOfClass:[UISlider class]])
+    {
+        self.objectClass = UBKAccessibilityObjectClassUISlider;
+        self.rules = UBKAccessibilityClassRuleControlStates | UBKAccessibilityClassRuleTouchTarget;
+    }
+    else if ([view isKindOfClass:[UITextField class]])
+    {
+        self.objectClass = UBKAccessibilityObjectClassUITextfield;
+        self.rules = UBKAccessibilityClassRuleText | UBKAccessibilityClassRuleTouchTarget;
+    }
+    else if ([view isKindOfClass:[UITextView class]])
+    {
+        self.objectClass = UBKAccessibilityObjectClassUITextView;
+        self.rules = UBKAccessibilityClassRuleText;
+    }
+    else if ([view isKindOfClass:[UILabel class]])
+    {
+        self.objectClass = UBKAccessibilityObjectClassUILabel;
+        self.rules = UBKAccessibilityClassRuleText;
+    }
+    else if ([view isKindOfClass:[UIImageView class]])
+    {
+        self.objectClass = UBKAccessibilityObjectClassUIImageView;
+        self.rules = 0;
+    }
+    else
+    {
+        self.objectClass = UBKAccessibilityObjectClassUIView;
+        //Other controls, eg a UISegmentedControl or UIStepper, are still touch targets
+        self.rules = [view isKindOfClass:[UIControl class]] ? UBKAccessibilityClassRuleTouchTarget : 0;
+    }
+}
+
+@end
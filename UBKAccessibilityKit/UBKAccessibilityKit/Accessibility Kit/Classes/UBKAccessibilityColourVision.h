@@ -0,0 +1,59 @@
+/*
+ File: UBKAccessibilityColourVision.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "UBKAccessibilityConstants.h"
+#import "UBKColourVision.h"
+
+@class UBKAccessibilitySnapshot;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Re-evaluates colour contrast as seen with a colour vision deficiency, eg a red on green error state that passes the W3C ratio but is unreadable with protanopia.
+@interface UBKAccessibilityColourVision : NSObject
+
+//All pairs are evaluated under every simulation in one pass when the object is created.
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithForegroundColours:(NSArray <UIColor *> *)foregroundColours backgroundColours:(NSArray <UIColor *> *)backgroundColours;
+//Screen level pass, the foreground colour of every visible element in the snapshot against the composited background behind it. Elements with the same colours share a pair.
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot;
+
+@property (nonatomic, readonly) NSUInteger pairCount;
+- (double)contrastRatioForPairAtIndex:(NSUInteger)index deficiency:(UBKColourVisionDeficiency)deficiency;
+//Index of the pair with the same 8 bit colours, NSNotFound if the pass didn't see them
+- (NSUInteger)indexOfPairWithForegroundColour:(UIColor *)foregroundColour backgroundColour:(UIColor *)backgroundColour;
+
+//8 bit sRGB value of ubk_colourValue, black for colours without components
++ (UBKColourRGBA8)rgbaColourForColour:(UIColor *)colour;
+
++ (UBKAccessibilityWarningType)warningTypeForDeficiency:(UBKColourVisionDeficiency)deficiency;
+
++ (NSString *)nameForDeficiency:(UBKColourVisionDeficiency)deficiency;
+
+//Captures the view, eg the key window, and simulates the deficiency on the captured pixels.
++ (nullable UIImage *)simulatedImageOfView:(UIView *)view deficiency:(UBKColourVisionDeficiency)deficiency;
+//Same as simulatedImageOfView: for some of the subviews of view, eg the app's views without the inspector drawn over them. The image is the size of view.
++ (nullable UIImage *)simulatedImageOfViews:(NSArray <UIView *> *)views inView:(UIView *)view deficiency:(UBKColourVisionDeficiency)deficiency;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,258 @@
+/*
+ File: UBKAccessibilityColourVision.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import "UBKAccessibilityColourVision.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityScanArena.h"
+#import "UBKAccessibilityAppearances.h"
+#import "UIColor+HelperMethods.h"
+
+@interface UBKAccessibilityColourVision ()
+@property (nonatomic, readwrite) NSUInteger pairCount;
+//Holds the buffers, the snapshot's scan arena or NSData
+@property (nonatomic) id storage;
+//pairCount * UBKColourVisionDeficiencyCount ratios, deficiency first
+@property (nonatomic) const float *ratios;
+//Pair index for each foreground and background key, only for the screen level pass
+@property (nonatomic) NSDictionary <NSNumber *, NSNumber *> *pairIndexes;
+@end
+
+@implementation UBKAccessibilityColourVision
+
+- (instancetype)initWithForegroundColours:(NSArray<UIColor *> *)foregroundColours backgroundColours:(NSArray<UIColor *> *)backgroundColours
+{
+    self = [super init];
+    if (self)
+    {
+        NSUInteger pairCount = MIN(foregroundColours.count, backgroundColours.count);
+        NSMutableData *data = [[NSMutableData alloc]initWithLength:pairCount * ((2 * sizeof(UBKColourRGBA8)) + (UBKColourVisionDeficiencyCount * sizeof(float)))];
+        float *ratios = data.mutableBytes;
+        UBKColourRGBA8 *foreground = (UBKColourRGBA8 *)&ratios[pairCount * UBKColourVisionDeficiencyCount];
+        UBKColourRGBA8 *background = &foreground[pairCount];
+        for (NSUInteger i = 0; i < pairCount; i++)
+        {
+            foreground[i] = [UBKAccessibilityColourVision rgbaColourForColour:foregroundColours[i]];
+            background[i] = [UBKAccessibilityColourVision rgbaColourForColour:backgroundColours[i]];
+        }
+        
+        UBKColourVisionContrastRatios(foreground, background, pairCount, ratios);
+        self.storage = data;
+        self.ratios = ratios;
+        self.pairCount = pairCount;
+    }
+    return self;
+}
+
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    self = [super init];
+    if (self)
+    {
+        [self analyseSnapshot:snapshot];
+    }
+    return self;
+}
+
+- (void)analyseSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    const UBKSnapshotNode *nodes = snapshot.nodes;
+    NSUInteger nodeCount = snapshot.nodeCount;
+    NSArray <UIView *> *views = snapshot.views;
+    UBKAccessibilityScanArena *scanArena = snapshot.scanArena;
+    UBKColourRGBA8 *foreground = [scanArena allocateCount:nodeCount size:sizeof(UBKColourRGBA8)];
+    UBKColourRGBA8 *background = [scanArena allocateCount:nodeCount size:sizeof(UBKColourRGBA8)];
+    float *ratios = [scanArena allocateCount:nodeCount * UBKColourVisionDeficiencyCount size:sizeof(float)];
+    if ((foreground == NULL) || (background == NULL) || (ratios == NULL))
+    {
+        return;
+    }
+    
+    NSMutableDictionary <NSNumber *, NSNumber *> *pairIndexes = [[NSMutableDictionary alloc]init];
+    NSUInteger pairCount = 0;
+    for (NSUInteger i = 0; i < nodeCount; i++)
+    {
+        if ((!(nodes[i].flags & UBKSnapshotNodeFlagElement)) || (nodes[i].flags & UBKSnapshotNodeFlagHidden))
+        {
+            continue;
+        }
+        UIFont *font = nil;
+        UBKColourValue foregroundValue = [UBKAccessibilityAppearances foregroundColourForView:views[i] font:&font].ubk_colourValue;
+        UBKColourValue backgroundValue = [snapshot backgroundColourValueAtIndex:i];
+        if ((!foregroundValue.hasComponents) || (!backgroundValue.hasComponents))
+        {
+            continue;
+        }
+        //The same compositing as getEffectiveForegroundColour:forView:backgroundColour:, so the element checks find their pair
+        float opacity = [snapshot opacityAtIndex:i];
+        if ((foregroundValue.linear[3] * opacity) < 1)
+        {
+            foregroundValue = UBKColourValueComposite(foregroundValue, opacity, backgroundValue);
+        }
+        
+        NSNumber *key = @([UBKAccessibilityColourVision keyForForeground:UBKColourValueRGBA8(foregroundValue) background:UBKColourValueRGBA8(backgroundValue)]);
+        if (pairIndexes[key] != nil)
+        {
+            continue;
+        }
+        foreground[pairCount] = UBKColourValueRGBA8(foregroundValue);
+        background[pairCount] = UBKColourValueRGBA8(backgroundValue);
+        pairIndexes[key] = @(pairCount);
+        pairCount++;
+    }
+    
+    //Every pair on the screen under every simulation in one kernel call
+    UBKColourVisionContrastRatios(foreground, background, pairCount, ratios);
+    self.storage = scanArena;
+    self.ratios = ratios;
+    self.pairIndexes = pairIndexes;
+    self.pairCount = pairCount;
+}
+
++ (uint64_t)keyForForeground:(UBKColourRGBA8)foreground background:(UBKColourRGBA8)background
+{
+    return ((uint64_t)foreground.r << 56) | ((uint64_t)foreground.g << 48) | ((uint64_t)foreground.b << 40) | ((uint64_t)foreground.a << 32) | ((uint64_t)background.r << 24) | ((uint64_t)background.g << 16) | ((uint64_t)background.b << 8) | (uint64_t)background.a;
+}
+
+- (NSUInteger)indexOfPairWithForegroundColour:(UIColor *)foregroundColour backgroundColour:(UIColor *)backgroundColour
+{
+    NSNumber *key = @([UBKAccessibilityColourVision keyForForeground:[UBKAccessibilityColourVision rgbaColourForColour:foregroundColour] background:[UBKAccessibilityColourVision rgbaColourForColour:backgroundColour]]);
+    NSNumber *index = self.pairIndexes[key];
+    return index ? index.unsignedIntegerValue : NSNotFound;
+}
+
+- (double)contrastRatioForPairAtIndex:(NSUInteger)index deficiency:(UBKColourVisionDeficiency)deficiency
+{
+    if ((index >= self.pairCount) || (deficiency >= UBKColourVisionDeficiencyCount))
+    {
+        return 0;
+    }
+    return self.ratios[(deficiency * self.pairCount) + index];
+}
+
++ (UBKColourRGBA8)rgbaColourForColour:(UIColor *)colour
+{
+    UBKColourValue colourValue = colour.ubk_colourValue;
+    if (!colourValue.hasComponents)
+    {
+        return (UBKColourRGBA8){ 0, 0, 0, 255 };
+    }
+    return UBKColourValueRGBA8(colourValue);
+}
+
++ (UBKAccessibilityWarningType)warningTypeForDeficiency:(UBKColourVisionDeficiency)deficiency
+{
+    switch (deficiency)
+    {
+        case UBKColourVisionDeuteranopia:
+        {
+            return UBKAccessibilityWarningTypeColourVisionDeuteranopia;
+        }
+        case UBKColourVisionTritanopia:
+        {
+            return UBKAccessibilityWarningTypeColourVisionTritanopia;
+        }
+        case UBKColourVisionAchromatopsia:
+        {
+            return UBKAccessibilityWarningTypeColourVisionAchromatopsia;
+        }
+        default:
+        {
+            return UBKAccessibilityWarningTypeColourVisionProtanopia;
+        }
+    }
+}
+
++ (NSString *)nameForDeficiency:(UBKColourVisionDeficiency)deficiency
+{
+    switch (deficiency)
+    {
+        case UBKColourVisionProtanopia:
+        {
+            return @"Protanopia";
+        }
+        case UBKColourVisionDeuteranopia:
+        {
+            return @"Deuteranopia";
+        }
+        case UBKColourVisionTritanopia:
+        {
+            return @"Tritanopia";
+        }
+        case UBKColourVisionAchromatopsia:
+        {
+            return @"Achromatopsia";
+        }
+        default:
+        {
+            return @"Off";
+        }
+    }
+}
+
++ (UIImage *)simulatedImageOfView:(UIView *)view deficiency:(UBKColourVisionDeficiency)deficiency
+{
+    return [self simulatedImageOfViews:@[view] inView:view deficiency:deficiency];
+}
+
++ (UIImage *)simulatedImageOfViews:(NSArray<UIView *> *)views inView:(UIView *)view deficiency:(UBKColourVisionDeficiency)deficiency
+{
+    CGFloat scale = view.window ? view.window.screen.scale : [UIScreen mainScreen].scale;
+    size_t width = (size_t)ceil(CGRectGetWidth(view.bounds) * scale);
+    size_t height = (size_t)ceil(CGRectGetHeight(view.bounds) * scale);
+    if ((width == 0) || (height == 0))
+    {
+        return nil;
+    }
+    
+    //Packed RGBA in memory order so the pixels can go straight to the kernel
+    CGColorSpaceRef colourSpace = CGColorSpaceCreateWithName(kCGColorSpaceSRGB);
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, width * sizeof(UBKColourRGBA8), colourSpace, kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big);
+    CGColorSpaceRelease(colourSpace);
+    if (context == NULL)
+    {
+        return nil;
+    }
+    
+    CGContextTranslateCTM(context, 0, height);
+    CGContextScaleCTM(context, scale, -scale);
+    UIGraphicsPushContext(context);
+    for (UIView *subview in views)
+    {
+        [subview drawViewHierarchyInRect:[subview convertRect:subview.bounds toView:view] afterScreenUpdates:false];
+    }
+    UIGraphicsPopContext();
+    
+    //Windows are opaque, so treating the premultiplied values as straight colour is exact for everything but translucent edges.
+    UBKColourRGBA8 *pixels = CGBitmapContextGetData(context);
+    UBKColourVisionSimulatePixels(deficiency, pixels, width * height, pixels);
+    
+    CGImageRef imageRef = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+    if (imageRef == NULL)
+    {
+        return nil;
+    }
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    return image;
+}
+
+@end
@@ -23,6 +23,9 @@
 
 @class UBKAccessibilityValidColour, UBKAccessibilityProperty;
 
+//Posted when the default colours change, the colour validation results are no longer valid.
+#define kUBKAccessibilityDefaultColoursDidChangeNotification @"UBKAccessibilityDefaultColoursDidChange"
+
 NS_ASSUME_NONNULL_BEGIN
 
 @interface UBKAccessibilityColours : NSObject
@@ -40,6 +43,12 @@ NS_ASSUME_NONNULL_BEGIN
 //Add single colour to colours array, checks if colour is already in array before adding, validates against colour
 - (void)addDefaultColour:(UIColor *)colour withTitle:(NSString *)title;
 
+//Replaces the default colours with the colours in a design token JSON file, see UBKColourTokens. The file is streamed rather than loaded whole, each colour is added once with the name of the first token that used it. Returns false and keeps the current colours if the file can't be read or isn't valid JSON.
+- (BOOL)loadDesignTokensFromFileURL:(NSURL *)fileURL;
+- (BOOL)loadDesignTokensFromData:(NSData *)data;
+//Loads name.json from the bundle
+- (BOOL)loadDesignTokensNamed:(NSString *)name inBundle:(NSBundle *)bundle;
+
 //Remove a colour from the colours array
 - (void)removeDefaultColour:(UBKAccessibilityProperty *)colourProperty;
 
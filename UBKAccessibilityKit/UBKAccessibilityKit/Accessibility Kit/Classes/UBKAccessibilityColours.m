@@ -21,6 +21,13 @@
 #import "UBKAccessibilityColours.h"
 #import "UBKAccessibilityProperty.h"
 #import "UBKAccessibilityValidColour.h"
+#import "UIColor+HelperMethods.h"
+#import "UBKColourTokens.h"
+
+@interface UBKAccessibilityColours ()
+//Packed colour of each default colour, so adding a colour doesn't search the array
+@property (nonatomic) NSCountedSet <NSNumber *> *defaultColourKeys;
+@end
 
 @implementation UBKAccessibilityColours
 
@@ -30,6 +37,7 @@
     {
         self.defaultColoursArray = [NSMutableArray new];
         self.suggestedColoursArray = [NSMutableArray new];
+        self.defaultColourKeys = [NSCountedSet new];
         [self resetDefaultsColours];
     }
     return self;
@@ -66,6 +74,8 @@
        [[UBKAccessibilityProperty alloc] initWithTitle:@"Grey" withColour:[UIColor colorWithRed:0.620 green:0.620 blue:0.620 alpha:1.000]],
        [[UBKAccessibilityProperty alloc] initWithTitle:@"Black" withColour:[UIColor colorWithRed:0.000 green:0.000 blue:0.000 alpha:1.000]]
        ]];
+    [self updateDefaultColourKeys];
+    [self postDefaultColoursDidChange];
 }
 
 //Removes all the standard colours and replaces with colours you have provided.
@@ -78,26 +88,110 @@
         UBKAccessibilityProperty *property = [[UBKAccessibilityProperty alloc]initWithTitle:validColour.title withColour:validColour.colour];
         [self.defaultColoursArray addObject:property];
     }
+    [self updateDefaultColourKeys];
+    [self postDefaultColoursDidChange];
 }
 
-//Add a colour to the colours array
-- (void)addDefaultColour:(UIColor *)colour withTitle:(NSString *)title
+- (void)updateDefaultColourKeys
+{
+    [self.defaultColourKeys removeAllObjects];
+    for (UBKAccessibilityProperty *property in self.defaultColoursArray)
+    {
+        [self.defaultColourKeys addObject:@(property.displayColour.ubk_colourValue.key)];
+    }
+}
+
+- (BOOL)loadDesignTokensFromFileURL:(NSURL *)fileURL
+{
+    UBKColourTokens tokens;
+    UBKColourTokensInit(&tokens);
+    BOOL loaded = UBKColourTokensParseFile(&tokens, fileURL.fileSystemRepresentation);
+    if (loaded)
+    {
+        [self replaceDefaultColoursWithTokens:&tokens];
+    }
+    UBKColourTokensDestroy(&tokens);
+    return loaded;
+}
+
+- (BOOL)loadDesignTokensFromData:(NSData *)data
+{
+    UBKColourTokens tokens;
+    UBKColourTokensInit(&tokens);
+    __block BOOL loaded = true;
+    //Data read from a file can be made of several ranges, parse each one in place
+    [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+        loaded = UBKColourTokensParse(&tokens, bytes, byteRange.length);
+        *stop = !loaded;
+    }];
+    loaded = loaded && UBKColourTokensFinish(&tokens);
+    if (loaded)
+    {
+        [self replaceDefaultColoursWithTokens:&tokens];
+    }
+    UBKColourTokensDestroy(&tokens);
+    return loaded;
+}
+
+- (BOOL)loadDesignTokensNamed:(NSString *)name inBundle:(NSBundle *)bundle
 {
-    for (UBKAccessibilityProperty *tmpProperty in self.defaultColoursArray)
+    NSURL *fileURL = [bundle URLForResource:name withExtension:@"json"];
+    if (!fileURL)
     {
-        if (tmpProperty.displayColour == colour)
+        return false;
+    }
+    return [self loadDesignTokensFromFileURL:fileURL];
+}
+
+//Tokens are already unique by colour, so the properties are added without checking the array
+- (void)replaceDefaultColoursWithTokens:(const UBKColourTokens *)tokens
+{
+    [self.defaultColoursArray removeAllObjects];
+    [self.defaultColourKeys removeAllObjects];
+    
+    for (uint32_t i = 0; i < tokens->count; i++)
+    {
+        const UBKColourTokenEntry *entry = &tokens->entries[i];
+        UIColor *colour = [UIColor ubk_colourWithRGBA8:entry->colour];
+        NSString *title = [[NSString alloc]initWithBytes:UBKColourTokensName(tokens, entry) length:entry->nameLength encoding:NSUTF8StringEncoding];
+        if (title.length == 0)
         {
-            return;
+            title = [colour ubk_hexStringFromColour];
         }
+        [self.defaultColoursArray addObject:[[UBKAccessibilityProperty alloc]initWithTitle:title withColour:colour]];
+        [self.defaultColourKeys addObject:@(entry->colour)];
+    }
+    [self postDefaultColoursDidChange];
+}
+
+//Add a colour to the colours array
+- (void)addDefaultColour:(UIColor *)colour withTitle:(NSString *)title
+{
+    NSNumber *colourKey = @(colour.ubk_colourValue.key);
+    if ([self.defaultColourKeys countForObject:colourKey] > 0)
+    {
+        return;
     }
     UBKAccessibilityProperty *property = [[UBKAccessibilityProperty alloc]initWithTitle:title withColour:colour];
     [self.defaultColoursArray addObject:property];
+    [self.defaultColourKeys addObject:colourKey];
+    [self postDefaultColoursDidChange];
 }
 
 //Remove colour from colour array
 - (void)removeDefaultColour:(UBKAccessibilityProperty *)colourProperty
 {
+    if ([self.defaultColoursArray containsObject:colourProperty])
+    {
+        [self.defaultColourKeys removeObject:@(colourProperty.displayColour.ubk_colourValue.key)];
+    }
     [self.defaultColoursArray removeObject:colourProperty];
+    [self postDefaultColoursDidChange];
+}
+
+- (void)postDefaultColoursDidChange
+{
+    [[NSNotificationCenter defaultCenter]postNotificationName:kUBKAccessibilityDefaultColoursDidChangeNotification object:self];
 }
 
 #pragma mark - Suggested colours
@@ -107,7 +201,7 @@
 {
     for (UBKAccessibilityProperty *tmpProperty in self.suggestedColoursArray)
     {
-        if (tmpProperty.displayColour == colour)
+        if ([tmpProperty.displayColour ubk_isEqualToColour:colour])
         {
             return;
         }
@@ -0,0 +1,47 @@
+/*
+ File: UBKAccessibilityComponentAudit.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@class UBKAccessibilitySnapshot, UBKAccessibilityScreenPasses, UBKAccessibilityAuditCache, UBKAccessibilitySection;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Results of UBKAccessibilityManager auditView:. A component has its own snapshot, screen level passes and cache, so auditing one leaves the results of the screen in the inspector as they were.
+@interface UBKAccessibilityComponentAudit : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+//auditCache has to have been updated with the snapshot of passes
+- (instancetype)initWithPasses:(UBKAccessibilityScreenPasses *)passes elements:(NSArray <UIView *> *)elements auditCache:(UBKAccessibilityAuditCache *)auditCache NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) UBKAccessibilitySnapshot *snapshot;
+@property (nonatomic, readonly) UBKAccessibilityScreenPasses *passes;
+//Elements audited, in the order they were found. Culled elements and all but the representative of repeated elements are left out.
+@property (nonatomic, readonly) NSArray <UIView *> *elements;
+
+//Accessibility details for an element of the component, the same details the inspector would show for it on a screen
+- (NSArray <UBKAccessibilitySection *> *)accessibilityDetailsForView:(UIView *)view;
+
+@end
+
+NS_ASSUME_NONNULL_END
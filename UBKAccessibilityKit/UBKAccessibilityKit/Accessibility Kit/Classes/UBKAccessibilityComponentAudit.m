@@ -0,0 +1,61 @@
+/*
+ File: UBKAccessibilityComponentAudit.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import "UBKAccessibilityComponentAudit.h"
+#import "UBKAccessibilityScreenPasses.h"
+#import "UBKAccessibilityAuditCache.h"
+
+@interface UBKAccessibilityComponentAudit ()
+@property (nonatomic, readwrite) UBKAccessibilityScreenPasses *passes;
+@property (nonatomic, readwrite) NSArray <UIView *> *elements;
+@property (nonatomic) UBKAccessibilityAuditCache *auditCache;
+@end
+
+@implementation UBKAccessibilityComponentAudit
+
+- (instancetype)initWithPasses:(UBKAccessibilityScreenPasses *)passes elements:(NSArray<UIView *> *)elements auditCache:(UBKAccessibilityAuditCache *)auditCache
+{
+    if (self = [super init])
+    {
+        self.passes = passes;
+        self.elements = [elements copy];
+        self.auditCache = auditCache;
+    }
+    return self;
+}
+
+- (UBKAccessibilitySnapshot *)snapshot
+{
+    return self.passes.snapshot;
+}
+
+//Details the cache hasn't worked out yet, eg repeated elements, are audited against the component's passes rather than the screen's
+- (NSArray<UBKAccessibilitySection *> *)accessibilityDetailsForView:(UIView *)view
+{
+    __block NSArray <UBKAccessibilitySection *> *details = nil;
+    [self.passes performAudit:^{
+        details = [self.auditCache accessibilityDetailsForView:view];
+    }];
+    return details;
+}
+
+@end
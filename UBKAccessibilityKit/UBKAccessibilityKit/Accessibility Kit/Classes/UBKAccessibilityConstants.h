@@ -36,11 +36,27 @@
 #define kUBKAccessibilityAttributeTitle_HighlightedStateColour             @"Highlighted State Colour"
 #define kUBKAccessibilityAttributeTitle_DisabledStateColour                @"Disabled State Colour"
 #define kUBKAccessibilityAttributeTitle_SelectedStateColour                @"Selected State Colour"
+#define kUBKAccessibilityAttributeTitle_LowestContrastRunColour            @"Lowest Contrast Run Colour"
+#define kUBKAccessibilityAttributeTitle_NormalStateContrast                @"Normal State Contrast"
+#define kUBKAccessibilityAttributeTitle_HighlightedStateContrast           @"Highlighted State Contrast"
+#define kUBKAccessibilityAttributeTitle_DisabledStateContrast              @"Disabled State Contrast"
+#define kUBKAccessibilityAttributeTitle_SelectedStateContrast              @"Selected State Contrast"
+#define kUBKAccessibilityAttributeTitle_OnTrackContrast                    @"On Track Contrast"
+#define kUBKAccessibilityAttributeTitle_ThumbOnContrast                    @"Thumb On Contrast"
+#define kUBKAccessibilityAttributeTitle_ThumbOffContrast                   @"Thumb Off Contrast"
+#define kUBKAccessibilityAttributeTitle_MinimumTrackContrast               @"Minimum Track Contrast"
+#define kUBKAccessibilityAttributeTitle_MaximumTrackContrast               @"Maximum Track Contrast"
+#define kUBKAccessibilityAttributeTitle_ThumbContrast                      @"Thumb Contrast"
+#define kUBKAccessibilityAttributeTitle_LightAppearanceContrast            @"Light Appearance Contrast"
+#define kUBKAccessibilityAttributeTitle_DarkAppearanceContrast             @"Dark Appearance Contrast"
+#define kUBKAccessibilityAttributeTitle_LightIncreasedContrast             @"Light Increased Contrast"
+#define kUBKAccessibilityAttributeTitle_DarkIncreasedContrast              @"Dark Increased Contrast"
 #define kUBKAccessibilityAttributeTitle_Typography                         @"Typography"
 #define kUBKAccessibilityAttributeTitle_Font                               @"Font"
 #define kUBKAccessibilityAttributeTitle_FontBold                           @"Bold Font"
 #define kUBKAccessibilityAttributeTitle_FontSize                           @"Font Size"
 #define kUBKAccessibilityAttributeTitle_FontStyle                          @"Font Style"
+#define kUBKAccessibilityAttributeTitle_LowestContrastRun                  @"Lowest Contrast Text"
 #define kUBKAccessibilityAttributeTitle_AccessibilityAttributes            @"Accessibility Attributes"
 #define kUBKAccessibilityAttributeTitle_VoiceOverGestures                  @"VoiceOver Gestures"
 #define kUBKAccessibilityAttributeTitle_GlobalAccessibilityProperties      @"Global Accessibility Properties"
@@ -77,6 +93,16 @@
 #define kUBKAccessibilityAttributeTitle_Warning_WrongColour                @"Invalid colour used"
 #define kUBKAccessibilityAttributeTitle_Warning_LabelNotSet                @"Missing accessibilityLabel not set"
 #define kUBKAccessibilityAttributeTitle_Warning_DynamicTextSize            @"Dynamic text sizes are not supported"
+#define kUBKAccessibilityAttributeTitle_Warning_Protanopia                 @"Colour contrast fails with protanopia"
+#define kUBKAccessibilityAttributeTitle_Warning_Deuteranopia               @"Colour contrast fails with deuteranopia"
+#define kUBKAccessibilityAttributeTitle_Warning_Tritanopia                 @"Colour contrast fails with tritanopia"
+#define kUBKAccessibilityAttributeTitle_Warning_Achromatopsia              @"Colour contrast fails with achromatopsia"
+#define kUBKAccessibilityAttributeTitle_Warning_TargetSpacing              @"Touch target overlaps or is too close"
+#define kUBKAccessibilityAttributeTitle_Warning_ReadingOrder               @"VoiceOver reading order jumps"
+#define kUBKAccessibilityAttributeTitle_Warning_DuplicateLabel             @"Same label as another control"
+#define kUBKAccessibilityAttributeTitle_Warning_LabelEchoesName            @"Label repeats a name from code"
+#define kUBKAccessibilityAttributeTitle_Warning_StateColourContrast        @"Colour contrast fails in a control state"
+#define kUBKAccessibilityAttributeTitle_Warning_AppearanceContrast         @"Colour contrast fails in another appearance"
 
 typedef enum : NSUInteger {
     UBKAccessibilityWarningLevelHigh,
@@ -102,12 +128,32 @@ typedef enum : NSUInteger {
     UBKAccessibilityWarningTypeColourContrastBackground,
     ///adjustsFontForContentSizeCategory
     UBKAccessibilityWarningTypeDynamicTextSize,
-    ///Less than 44 x 44
+    ///Smaller than the rule profile minimum target size
     UBKAccessibilityWarningTypeMinimumSize,
     ///accessibilityLabel
     UBKAccessibilityWarningTypeMissingLabel,
     ///checks against supplied colours and if colours don't match
-    UBKAccessibilityWarningTypeWrongColour
+    UBKAccessibilityWarningTypeWrongColour,
+    ///colour contrast passes with typical vision but fails without red cones
+    UBKAccessibilityWarningTypeColourVisionProtanopia,
+    ///colour contrast passes with typical vision but fails without green cones
+    UBKAccessibilityWarningTypeColourVisionDeuteranopia,
+    ///colour contrast passes with typical vision but fails without blue cones
+    UBKAccessibilityWarningTypeColourVisionTritanopia,
+    ///colour contrast passes with typical vision but fails without colour vision
+    UBKAccessibilityWarningTypeColourVisionAchromatopsia,
+    ///touch target overlaps another target, or is undersized and too close to one
+    UBKAccessibilityWarningTypeTargetSpacing,
+    ///VoiceOver reaches the element out of the order its frame is read in
+    UBKAccessibilityWarningTypeReadingOrder,
+    ///interactive element reads the same as another, same label with no hint or value to tell them apart
+    UBKAccessibilityWarningTypeDuplicateLabel,
+    ///label repeats the identifier, image name or class name of the element
+    UBKAccessibilityWarningTypeLabelEchoesName,
+    ///colour contrast fails in a state the control isn't in, or for a switch or slider tint
+    UBKAccessibilityWarningTypeStateColourContrast,
+    ///colour contrast fails in the light, dark or increased contrast appearance the element isn't shown in
+    UBKAccessibilityWarningTypeAppearanceContrast
 } UBKAccessibilityWarningType;
 
 typedef enum : NSUInteger {
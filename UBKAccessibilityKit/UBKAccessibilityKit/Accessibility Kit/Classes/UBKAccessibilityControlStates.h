@@ -0,0 +1,47 @@
+/*
+ File: UBKAccessibilityControlStates.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@class UBKAccessibilityProperty;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Colour pairs a control shows in its other states, see UBKContrastPairs.h. Buttons have a pair for the title in the normal, highlighted, disabled and selected states. Switches and sliders have a pair for each track and thumb colour the app sets, default system colours are left to the system.
+@interface UBKAccessibilityControlStates : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+//backgroundColour is the effective background of the control
+- (instancetype)initWithControl:(UIControl *)control backgroundColour:(nullable UIColor *)backgroundColour NS_DESIGNATED_INITIALIZER;
+
+//Failing pairs, leaving out the button state on screen as the button's own contrast check covers it
+@property (nonatomic, readonly) NSUInteger failingCount;
+
+//A contrast property for each pair with known colours, failing pairs show a warning
+@property (nonatomic, readonly) NSArray <UBKAccessibilityProperty *> *contrastProperties;
+
+//True when the button title fails in the state
+- (BOOL)isFailingForState:(UIControlState)state;
+
+@end
+
+NS_ASSUME_NONNULL_END
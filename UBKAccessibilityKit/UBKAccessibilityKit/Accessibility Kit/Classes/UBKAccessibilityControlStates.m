@@ -0,0 +1,291 @@
+/*
+ File: UBKAccessibilityControlStates.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import "UBKAccessibilityControlStates.h"
+#import "UBKAccessibilityManager.h"
+#import "UBKAccessibilityProperty.h"
+#import "UBKAccessibilityValidation.h"
+#import "UBKContrastPairs.h"
+#import "UIColor+HelperMethods.h"
+#import "UIFont+HelperMethods.h"
+
+//Button states that have a pair, the other states fall back to these
+static const UIControlState UBKControlStatesButtonStates[] = {UIControlStateNormal, UIControlStateHighlighted, UIControlStateDisabled, UIControlStateSelected};
+#define UBKControlStatesMaximumPairCount 4
+
+typedef enum : uint32_t {
+    UBKControlStatesPartOnTrack,
+    UBKControlStatesPartThumbOn,
+    UBKControlStatesPartThumbOff,
+    UBKControlStatesPartMinimumTrack,
+    UBKControlStatesPartMaximumTrack,
+    UBKControlStatesPartThumb
+} UBKControlStatesPart;
+
+@interface UBKAccessibilityControlStates ()
+{
+    UBKContrastPair _pairs[UBKControlStatesMaximumPairCount];
+    uint32_t _pairCount;
+}
+@property (nonatomic, readwrite) NSUInteger failingCount;
+@property (nonatomic, readwrite) NSArray <UBKAccessibilityProperty *> *contrastProperties;
+@property (nonatomic) BOOL isButton;
+//Index of the pair for the state the button is in, -1 when it isn't one of the rated states
+@property (nonatomic) NSInteger currentPairIndex;
+//Colours as set, for the properties
+@property (nonatomic) NSMutableArray *foregroundColours;
+@property (nonatomic) NSMutableArray *backgroundColours;
+@end
+
+@implementation UBKAccessibilityControlStates
+
+- (instancetype)initWithControl:(UIControl *)control backgroundColour:(UIColor *)backgroundColour
+{
+    if (self = [super init])
+    {
+        self.currentPairIndex = -1;
+        self.foregroundColours = [[NSMutableArray alloc]init];
+        self.backgroundColours = [[NSMutableArray alloc]init];
+        float opacity = [UBKAccessibilityValidation getEffectiveOpacity:control];
+        if ([control isKindOfClass:[UIButton class]])
+        {
+            self.isButton = true;
+            [self captureButton:(UIButton *)control backgroundColour:backgroundColour opacity:opacity];
+        }
+        else if ([control isKindOfClass:[UISwitch class]])
+        {
+            [self captureSwitch:(UISwitch *)control backgroundColour:backgroundColour opacity:opacity];
+        }
+        else if ([control isKindOfClass:[UISlider class]])
+        {
+            [self captureSlider:(UISlider *)control backgroundColour:backgroundColour opacity:opacity];
+        }
+        
+        //Every pair of the control is rated in one go
+        UBKContrastPairsEvaluate(_pairs, _pairCount, [UBKAccessibilityManager sharedInstance].ruleEvaluator);
+        NSUInteger failingCount = 0;
+        for (uint32_t i = 0; i < _pairCount; i++)
+        {
+            if ((_pairs[i].isFailing) && ((NSInteger)i != self.currentPairIndex))
+            {
+                failingCount++;
+            }
+        }
+        self.failingCount = failingCount;
+    }
+    return self;
+}
+
+- (void)addPairWithForeground:(UIColor *)foreground background:(UIColor *)background backgroundValue:(UBKColourValue)backgroundValue opacity:(float)opacity tag:(uint32_t)tag
+{
+    if (_pairCount >= UBKControlStatesMaximumPairCount)
+    {
+        return;
+    }
+    UBKContrastPair *pair = &_pairs[_pairCount];
+    *pair = (UBKContrastPair){0};
+    pair->foreground = foreground.ubk_colourValue;
+    pair->background = backgroundValue;
+    pair->opacity = opacity;
+    pair->tag = tag;
+    [self.foregroundColours addObject:foreground];
+    [self.backgroundColours addObject:background ?: [NSNull null]];
+    _pairCount++;
+}
+
+- (void)captureButton:(UIButton *)button backgroundColour:(UIColor *)backgroundColour opacity:(float)opacity
+{
+    UBKColourValue backgroundValue = backgroundColour.ubk_colourValue;
+    UIFont *font = button.titleLabel.font;
+    BOOL boldFont = [font ubk_isFontBold];
+    for (size_t i = 0; i < sizeof(UBKControlStatesButtonStates) / sizeof(UBKControlStatesButtonStates[0]); i++)
+    {
+        UIControlState state = UBKControlStatesButtonStates[i];
+        NSAttributedString *attributedTitle = [button attributedTitleForState:state];
+        if ((attributedTitle.length == 0) && ([button titleForState:state].length == 0))
+        {
+            continue;
+        }
+        UIColor *titleColour = (attributedTitle.length > 0) ? [attributedTitle attribute:NSForegroundColorAttributeName atIndex:0 effectiveRange:nil] : nil;
+        titleColour = titleColour ?: [button titleColorForState:state];
+        if (!titleColour)
+        {
+            continue;
+        }
+        
+        //Only template background images have a known colour, the tint. Other images can't be rated.
+        UIColor *stateBackgroundColour = backgroundColour;
+        UBKColourValue stateBackgroundValue = backgroundValue;
+        UIImage *backgroundImage = [button backgroundImageForState:state];
+        if (backgroundImage)
+        {
+            BOOL isTemplate = (backgroundImage.renderingMode == UIImageRenderingModeAlwaysTemplate);
+            stateBackgroundValue = isTemplate ? UBKColourValueComposite(button.tintColor.ubk_colourValue, opacity, backgroundValue) : UBKColourValueMakeUnknown();
+            stateBackgroundColour = isTemplate ? [UIColor ubk_colourWithColourValue:stateBackgroundValue] : nil;
+        }
+        
+        if (state == button.state)
+        {
+            self.currentPairIndex = _pairCount;
+        }
+        [self addPairWithForeground:titleColour background:stateBackgroundColour backgroundValue:stateBackgroundValue opacity:opacity tag:(uint32_t)state];
+        UBKContrastPair *pair = &_pairs[_pairCount - 1];
+        pair->flags = UBKContrastPairFlagText;
+        if (state == UIControlStateDisabled)
+        {
+            pair->flags |= UBKContrastPairFlagInactive;
+        }
+        pair->textSize = font.pointSize;
+        pair->boldFont = boldFont;
+    }
+}
+
+- (void)captureSwitch:(UISwitch *)switchObject backgroundColour:(UIColor *)backgroundColour opacity:(float)opacity
+{
+    UBKColourValue backgroundValue = backgroundColour.ubk_colourValue;
+    if (switchObject.onTintColor)
+    {
+        [self addPairWithForeground:switchObject.onTintColor background:backgroundColour backgroundValue:backgroundValue opacity:opacity tag:UBKControlStatesPartOnTrack];
+    }
+    if (switchObject.thumbTintColor)
+    {
+        if (switchObject.onTintColor)
+        {
+            UBKColourValue onTrackValue = UBKColourValueComposite(switchObject.onTintColor.ubk_colourValue, opacity, backgroundValue);
+            [self addPairWithForeground:switchObject.thumbTintColor background:[UIColor ubk_colourWithColourValue:onTrackValue] backgroundValue:onTrackValue opacity:opacity tag:UBKControlStatesPartThumbOn];
+        }
+        //The off track is only an outline, the thumb sits on the background
+        [self addPairWithForeground:switchObject.thumbTintColor background:backgroundColour backgroundValue:backgroundValue opacity:opacity tag:UBKControlStatesPartThumbOff];
+    }
+}
+
+- (void)captureSlider:(UISlider *)slider backgroundColour:(UIColor *)backgroundColour opacity:(float)opacity
+{
+    UBKColourValue backgroundValue = backgroundColour.ubk_colourValue;
+    if (slider.minimumTrackTintColor)
+    {
+        [self addPairWithForeground:slider.minimumTrackTintColor background:backgroundColour backgroundValue:backgroundValue opacity:opacity tag:UBKControlStatesPartMinimumTrack];
+    }
+    if (slider.maximumTrackTintColor)
+    {
+        [self addPairWithForeground:slider.maximumTrackTintColor background:backgroundColour backgroundValue:backgroundValue opacity:opacity tag:UBKControlStatesPartMaximumTrack];
+    }
+    if (slider.thumbTintColor)
+    {
+        [self addPairWithForeground:slider.thumbTintColor background:backgroundColour backgroundValue:backgroundValue opacity:opacity tag:UBKControlStatesPartThumb];
+    }
+}
+
+- (BOOL)isFailingForState:(UIControlState)state
+{
+    if (!self.isButton)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < _pairCount; i++)
+    {
+        if (_pairs[i].tag == (uint32_t)state)
+        {
+            return _pairs[i].isFailing;
+        }
+    }
+    return false;
+}
+
+- (NSArray<UBKAccessibilityProperty *> *)contrastProperties
+{
+    if (!_contrastProperties)
+    {
+        NSMutableArray *properties = [[NSMutableArray alloc]init];
+        for (uint32_t i = 0; i < _pairCount; i++)
+        {
+            const UBKContrastPair *pair = &_pairs[i];
+            if ((pair->rating == UBKRuleRatingNA) || (self.backgroundColours[i] == [NSNull null]))
+            {
+                continue;
+            }
+            NSString *title = self.isButton ? [self titleForState:pair->tag] : [self titleForPart:pair->tag];
+            NSString *alternateTitle = (pair->flags & UBKContrastPairFlagText) ? kUBKAccessibilityAttributeTitle_TextBackgroundColour : kUBKAccessibilityAttributeTitle_TintBackgroundColour;
+            UBKAccessibilityProperty *property = [[UBKAccessibilityProperty alloc]initWithTitle:title withValue:[NSString stringWithFormat:@"%0.2f", pair->contrast] withForegroundColour:self.foregroundColours[i] withBackgroundColour:self.backgroundColours[i] withAlternateTitle:alternateTitle withContrastScore:[UBKAccessibilityValidation getW3CRatingForColourContrast:(ColourContrastRating)pair->rating] showContrastWarning:pair->isFailing];
+            property.warningType = UBKAccessibilityWarningTypeStateColourContrast;
+            property.warningLevel = UBKAccessibilityWarningLevelHigh;
+            [properties addObject:property];
+        }
+        _contrastProperties = properties;
+    }
+    return _contrastProperties;
+}
+
+- (NSString *)titleForState:(UIControlState)state
+{
+    switch (state)
+    {
+        case UIControlStateHighlighted:
+        {
+            return kUBKAccessibilityAttributeTitle_HighlightedStateContrast;
+        }
+        case UIControlStateDisabled:
+        {
+            return kUBKAccessibilityAttributeTitle_DisabledStateContrast;
+        }
+        case UIControlStateSelected:
+        {
+            return kUBKAccessibilityAttributeTitle_SelectedStateContrast;
+        }
+        default:
+        {
+            return kUBKAccessibilityAttributeTitle_NormalStateContrast;
+        }
+    }
+}
+
+- (NSString *)titleForPart:(UBKControlStatesPart)part
+{
+    switch (part)
+    {
+        case UBKControlStatesPartOnTrack:
+        {
+            return kUBKAccessibilityAttributeTitle_OnTrackContrast;
+        }
+        case UBKControlStatesPartThumbOn:
+        {
+            return kUBKAccessibilityAttributeTitle_ThumbOnContrast;
+        }
+        case UBKControlStatesPartThumbOff:
+        {
+            return kUBKAccessibilityAttributeTitle_ThumbOffContrast;
+        }
+        case UBKControlStatesPartMinimumTrack:
+        {
+            return kUBKAccessibilityAttributeTitle_MinimumTrackContrast;
+        }
+        case UBKControlStatesPartMaximumTrack:
+        {
+            return kUBKAccessibilityAttributeTitle_MaximumTrackContrast;
+        }
+        case UBKControlStatesPartThumb:
+        {
+            return kUBKAccessibilityAttributeTitle_ThumbContrast;
+        }
+    }
+}
+
+@end
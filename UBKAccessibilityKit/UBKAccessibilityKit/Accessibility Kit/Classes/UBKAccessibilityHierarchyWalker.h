@@ -0,0 +1,62 @@
+/*
+ File: UBKAccessibilityHierarchyWalker.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@class UBKAccessibilitySnapshot;
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef enum : NSUInteger {
+    ///the view and its subviews are left out
+    UBKAccessibilityWalkActionSkip,
+    ///the view is an element, its subviews are walked
+    UBKAccessibilityWalkActionElement,
+    ///only the subviews are walked, eg views added by the kit
+    UBKAccessibilityWalkActionSubviewsOnly
+} UBKAccessibilityWalkAction;
+
+//Resumable walk of a view hierarchy that builds the element list and snapshot. The walk uses an explicit stack rather than recursion, so it can stop after a time budget and carry on from the same view later, eg on the next frame. Views are visited in the same pre-order as a recursive walk, so the elements and snapshot match a walk done in one go.
+@interface UBKAccessibilityHierarchyWalker : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+//Root views are added to the snapshot but not the elements. Their descendants are passed to actionForView in walk order. Views keep their subviews as they were when the walk reached them.
+- (instancetype)initWithRootViews:(NSArray <UIView *> *)rootViews snapshot:(UBKAccessibilitySnapshot *)snapshot actionForView:(UBKAccessibilityWalkAction (^)(UIView *view))actionForView NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) UBKAccessibilitySnapshot *snapshot;
+//Make the root views elements as well, eg when auditing a single component. Set before walking. Default false.
+@property (nonatomic) BOOL rootViewsAreElements;
+//Elements found so far, in walk order
+@property (nonatomic, readonly) NSArray <UIView *> *elements;
+@property (nonatomic, readonly) NSUInteger visitedCount;
+@property (nonatomic, readonly, getter=isFinished) BOOL finished;
+//Estimated fraction of the hierarchy walked from 0 to 1. Each view's share is split evenly between its subviews, so it is exact for even trees and never goes backwards.
+@property (nonatomic, readonly) double progress;
+
+//Walks until the hierarchy is finished or budget seconds have passed and returns isFinished. The clock is checked every few views, and at least one batch is walked per call so a walk always moves forward.
+- (BOOL)walkForDuration:(CFTimeInterval)budget;
+- (void)walkToEnd;
+
+@end
+
+NS_ASSUME_NONNULL_END
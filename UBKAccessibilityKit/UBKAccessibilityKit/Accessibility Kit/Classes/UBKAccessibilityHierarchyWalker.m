@@ -0,0 +1,180 @@
+/*
+ File: UBKAccessibilityHierarchyWalker.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import "UBKAccessibilityHierarchyWalker.h"
+#import "UBKAccessibilitySnapshot.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+//Views walked between clock checks, CACurrentMediaTime is cheap but not free
+static const NSUInteger UBKAccessibilityWalkBatchSize = 32;
+
+//One per view whose subviews are being walked, the subviews themselves are kept in subviewStack
+typedef struct {
+    NSUInteger nextIndex;
+    //Share of the whole walk covered by the subviews
+    double share;
+    //The view has a snapshot node to close once its subviews are done
+    BOOL isInSnapshot;
+} UBKAccessibilityWalkFrame;
+
+@interface UBKAccessibilityHierarchyWalker ()
+@property (nonatomic, readwrite) UBKAccessibilitySnapshot *snapshot;
+@property (nonatomic, copy) UBKAccessibilityWalkAction (^actionForView)(UIView *view);
+@property (nonatomic) NSMutableArray <UIView *> *mutableElements;
+@property (nonatomic) NSMutableArray <NSArray <UIView *> *> *subviewStack;
+@property (nonatomic) NSMutableData *frameStack;
+@property (nonatomic, readwrite) NSUInteger visitedCount;
+@property (nonatomic, readwrite) double progress;
+@end
+
+@implementation UBKAccessibilityHierarchyWalker
+
+- (instancetype)initWithRootViews:(NSArray<UIView *> *)rootViews snapshot:(UBKAccessibilitySnapshot *)snapshot actionForView:(UBKAccessibilityWalkAction (^)(UIView *))actionForView
+{
+    if (self = [super init])
+    {
+        self.snapshot = snapshot;
+        self.actionForView = actionForView;
+        self.mutableElements = [[NSMutableArray alloc]init];
+        self.subviewStack = [[NSMutableArray alloc]init];
+        self.frameStack = [[NSMutableData alloc]init];
+        [self pushSubviews:[rootViews copy] share:1 isInSnapshot:false];
+        if (self.subviewStack.count == 0)
+        {
+            self.progress = 1;
+        }
+    }
+    return self;
+}
+
+- (NSArray<UIView *> *)elements
+{
+    return self.mutableElements;
+}
+
+- (BOOL)isFinished
+{
+    return self.subviewStack.count == 0;
+}
+
+- (void)pushSubviews:(NSArray <UIView *> *)subviews share:(double)share isInSnapshot:(BOOL)isInSnapshot
+{
+    UBKAccessibilityWalkFrame frame = {0, share, isInSnapshot};
+    [self.subviewStack addObject:subviews];
+    [self.frameStack appendBytes:&frame length:sizeof(frame)];
+}
+
+//Visits the next view, or closes the top frame when its subviews are done
+- (void)step
+{
+    NSUInteger depth = self.subviewStack.count - 1;
+    NSArray <UIView *> *subviews = self.subviewStack[depth];
+    UBKAccessibilityWalkFrame *frame = &((UBKAccessibilityWalkFrame *)self.frameStack.mutableBytes)[depth];
+    
+    if (frame->nextIndex >= subviews.count)
+    {
+        if (frame->isInSnapshot)
+        {
+            [self.snapshot popView];
+        }
+        [self.subviewStack removeLastObject];
+        self.frameStack.length -= sizeof(UBKAccessibilityWalkFrame);
+        return;
+    }
+    
+    UIView *view = subviews[frame->nextIndex];
+    frame->nextIndex++;
+    self.visitedCount++;
+    double share = frame->share / subviews.count;
+    
+    //Root views are always walked, the action only applies below them
+    BOOL isRootView = (depth == 0);
+    UBKAccessibilityWalkAction action = isRootView ? UBKAccessibilityWalkActionElement : self.actionForView(view);
+    if (action == UBKAccessibilityWalkActionSkip)
+    {
+        self.progress += share;
+        return;
+    }
+    
+    BOOL isInSnapshot = (action == UBKAccessibilityWalkActionElement);
+    if (isInSnapshot)
+    {
+        BOOL isElement = (!isRootView) || (self.rootViewsAreElements);
+        //Nothing was pushed so there is nothing to pop, and the subviews would be pushed under the wrong parent. Leave the subtree out like a skipped view.
+        if (![self.snapshot pushView:view isElement:isElement])
+        {
+            self.progress += share;
+            return;
+        }
+        if (isElement)
+        {
+            [self.mutableElements addObject:view];
+        }
+    }
+    
+    //frame can move when the stack grows, it isn't used after this
+    NSArray <UIView *> *childViews = view.subviews;
+    if (childViews.count > 0)
+    {
+        [self pushSubviews:childViews share:share isInSnapshot:isInSnapshot];
+    }
+    else
+    {
+        if (isInSnapshot)
+        {
+            [self.snapshot popView];
+        }
+        self.progress += share;
+    }
+}
+
+- (BOOL)walkForDuration:(CFTimeInterval)budget
+{
+    CFTimeInterval deadline = CACurrentMediaTime() + budget;
+    do
+    {
+        for (NSUInteger i = 0; (i < UBKAccessibilityWalkBatchSize) && (!self.isFinished); i++)
+        {
+            [self step];
+        }
+    }
+    while ((!self.isFinished) && (CACurrentMediaTime() < deadline));
+    
+    if (self.isFinished)
+    {
+        //Rounding in the shares can leave it just under
+        self.progress = 1;
+    }
+    return self.isFinished;
+}
+
+- (void)walkToEnd
+{
+    while (!self.isFinished)
+    {
+        [self step];
+    }
+    self.progress = 1;
+}
+
+@end
@@ -0,0 +1,53 @@
+/*
+ File: UBKAccessibilityInspectionServer.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "UBKInspection.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Streams the hierarchy and its audit results to a desktop viewer, see UBKInspection.h for the protocol. Clients get a snapshot when they connect, then only what changed each time the manager refreshes.
+//The server only listens on the loopback interface. On a device forward the port over USB, eg iproxy 8765 8765, then connect to localhost.
+//Clients can select an element, which shows it in the inspector, and change the colours the inspector can change.
+@interface UBKAccessibilityInspectionServer : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+//Pass 0 for any free port, port holds the port once started
+- (instancetype)initWithPort:(uint16_t)port NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) uint16_t port;
+@property (nonatomic, readonly) BOOL isRunning;
+@property (nonatomic, readonly) NSUInteger connectionCount;
+@property (nonatomic, readonly) uint64_t bytesSent;
+
+//Seconds between refreshes of the manager while a client is connected, 0 only sends the refreshes made by the inspector. Default 0.5.
+@property (nonatomic) CFTimeInterval refreshInterval;
+
+//Returns false if the port couldn't be opened. The server is polled once a frame on the main thread until stopped.
+- (BOOL)start;
+- (void)stop;
+
+//Tells the clients the element was selected on the device
+- (void)sendSelectionForView:(UIView *)view;
+
+@end
+
+NS_ASSUME_NONNULL_END
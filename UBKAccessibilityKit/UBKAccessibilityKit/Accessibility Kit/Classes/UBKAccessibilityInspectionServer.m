@@ -0,0 +1,305 @@
+/*
+ File: UBKAccessibilityInspectionServer.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "UBKAccessibilityInspectionServer.h"
+#import "UBKAccessibilityManager.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilitySection.h"
+#import "UBKAccessibilityProperty.h"
+#import "UBKNavigationController.h"
+#import "UIColor+HelperMethods.h"
+
+#import <QuartzCore/QuartzCore.h>
+#import <objc/runtime.h>
+
+@interface UBKAccessibilityInspectionServer ()
+{
+    UBKInspectionServer _server;
+    UBKInspectionTree _tree;
+}
+@property (nonatomic) uint16_t requestedPort;
+@property (nonatomic) CADisplayLink *displayLink;
+@property (nonatomic, readwrite) BOOL isRunning;
+//The snapshot the last published tree was built from, and its views in node order
+@property (nonatomic, weak) UBKAccessibilitySnapshot *publishedSnapshot;
+@property (nonatomic) NSArray <UIView *> *publishedViews;
+@property (nonatomic) BOOL needsPublish;
+@property (nonatomic) CFTimeInterval lastRefreshTime;
+- (void)handleCommand:(const UBKInspectionCommand *)command;
+@end
+
+static void UBKAccessibilityInspectionServerHandleCommand(const UBKInspectionCommand *command, void *context)
+{
+    [(__bridge UBKAccessibilityInspectionServer *)context handleCommand:command];
+}
+
+@implementation UBKAccessibilityInspectionServer
+
+- (instancetype)initWithPort:(uint16_t)port
+{
+    if (self = [super init])
+    {
+        self.requestedPort = port;
+        self.refreshInterval = 0.5;
+        _server.listenFileDescriptor = -1;
+        UBKInspectionTreeInit(&_tree);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_displayLink invalidate];
+    UBKInspectionServerClose(&_server);
+    UBKInspectionTreeDestroy(&_tree);
+}
+
+- (uint16_t)port
+{
+    return self.isRunning ? _server.port : self.requestedPort;
+}
+
+- (NSUInteger)connectionCount
+{
+    return self.isRunning ? _server.connectionCount : 0;
+}
+
+- (uint64_t)bytesSent
+{
+    return self.isRunning ? _server.bytesSent : 0;
+}
+
+- (BOOL)start
+{
+    if (self.isRunning)
+    {
+        return true;
+    }
+    if (!UBKInspectionServerOpen(&_server, self.requestedPort))
+    {
+        return false;
+    }
+    self.isRunning = true;
+    self.publishedSnapshot = nil;
+    self.needsPublish = true;
+    
+    //The display link holds its target strongly, stop releases it
+    self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(frameDidFire:)];
+    [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    return true;
+}
+
+- (void)stop
+{
+    [self.displayLink invalidate];
+    self.displayLink = nil;
+    if (self.isRunning)
+    {
+        UBKInspectionServerClose(&_server);
+    }
+    self.publishedViews = nil;
+    self.isRunning = false;
+}
+
+- (void)frameDidFire:(CADisplayLink *)displayLink
+{
+    UBKInspectionServerPoll(&_server, UBKAccessibilityInspectionServerHandleCommand, (__bridge void *)self);
+    if (_server.connectionCount == 0)
+    {
+        return;
+    }
+    
+    UBKAccessibilityManager *manager = [UBKAccessibilityManager sharedInstance];
+    //Unchanged screens make empty deltas, so the refresh only costs the audit of the views that changed
+    CFTimeInterval now = CACurrentMediaTime();
+    if ((self.refreshInterval > 0) && (now - self.lastRefreshTime >= self.refreshInterval) && (!manager.isWalkingHierarchy) && (manager.window != nil))
+    {
+        self.lastRefreshTime = now;
+        [manager configureAllUIElmentsIncrementally];
+    }
+    
+    UBKAccessibilitySnapshot *snapshot = manager.currentSnapshot;
+    if ((snapshot != nil) && ((snapshot != self.publishedSnapshot) || (self.needsPublish)))
+    {
+        [self publishSnapshot:snapshot];
+    }
+}
+
+- (void)publishSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    UBKInspectionTreeReset(&_tree);
+    if ((![self buildTree:&_tree fromSnapshot:snapshot]) || (!UBKInspectionServerPublish(&_server, &_tree)))
+    {
+        //Try again next frame
+        return;
+    }
+    self.publishedSnapshot = snapshot;
+    self.publishedViews = snapshot.views;
+    self.needsPublish = false;
+}
+
+- (BOOL)buildTree:(UBKInspectionTree *)tree fromSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    NSUInteger nodeCount = snapshot.nodeCount;
+    NSMutableData *keyData = [[NSMutableData alloc]initWithLength:MAX(nodeCount, 1) * sizeof(uint64_t)];
+    uint64_t *keys = keyData.mutableBytes;
+    [snapshot getElementKeys:keys];
+    if (!UBKInspectionMakeKeysUnique(keys, nodeCount))
+    {
+        return false;
+    }
+    
+    //Children counted so far for each parent, top level nodes are counted in the last slot
+    NSMutableData *childCountData = [[NSMutableData alloc]initWithLength:(nodeCount + 1) * sizeof(uint32_t)];
+    uint32_t *childCounts = childCountData.mutableBytes;
+    
+    const UBKSnapshotNode *nodes = snapshot.nodes;
+    NSArray <UIView *> *views = snapshot.views;
+    UBKAccessibilityManager *manager = [UBKAccessibilityManager sharedInstance];
+    for (NSUInteger i = 0; i < nodeCount; i++)
+    {
+        UIView *view = views[i];
+        NSUInteger parentSlot = (nodes[i].parent >= 0) ? (NSUInteger)nodes[i].parent : nodeCount;
+        
+        UBKInspectionNode node = {0};
+        node.key = keys[i];
+        node.parentKey = (nodes[i].parent >= 0) ? keys[nodes[i].parent] : 0;
+        node.siblingIndex = childCounts[parentSlot]++;
+        node.flags = nodes[i].flags;
+        node.warningLevel = UBKAccessibilityWarningLevelPass;
+        node.x = (float)nodes[i].frame.x;
+        node.y = (float)nodes[i].frame.y;
+        node.width = (float)nodes[i].frame.width;
+        node.height = (float)nodes[i].frame.height;
+        
+        //Only elements are audited
+        NSArray <UBKAccessibilitySection *> *sections = (nodes[i].flags & UBKSnapshotNodeFlagElement) ? [manager accessibilityDetailsForView:view] : nil;
+        for (UBKAccessibilitySection *section in sections)
+        {
+            if (section.sectionType != SectionDisplayTypeWarnings)
+            {
+                continue;
+            }
+            for (UBKAccessibilityProperty *property in section.items)
+            {
+                node.warningMask |= (1ULL << property.warningType);
+                node.warningLevel = MIN(node.warningLevel, (uint32_t)property.warningLevel);
+            }
+        }
+        
+        if (!UBKInspectionTreeAddNode(tree, &node, object_getClassName(view), view.accessibilityLabel.UTF8String))
+        {
+            return false;
+        }
+        for (UBKAccessibilityProperty *property in [self colourPropertiesInSections:sections])
+        {
+            UBKColourRGBA8 rgba = UBKColourValueRGBA8(property.displayColour.ubk_colourValue);
+            uint32_t packed = ((uint32_t)rgba.r << 24) | ((uint32_t)rgba.g << 16) | ((uint32_t)rgba.b << 8) | rgba.a;
+            if (!UBKInspectionTreeAddColour(tree, property.displayTitle.UTF8String, packed))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//The colours the inspector can change, in the order they are numbered for UBKInspectionMessageSetColour
+- (NSArray <UBKAccessibilityProperty *> *)colourPropertiesInSections:(NSArray <UBKAccessibilitySection *> *)sections
+{
+    NSMutableArray <UBKAccessibilityProperty *> *properties = [[NSMutableArray alloc]init];
+    for (UBKAccessibilitySection *section in sections)
+    {
+        if (section.sectionType == SectionDisplayTypeWarnings)
+        {
+            continue;
+        }
+        for (UBKAccessibilityProperty *property in section.items)
+        {
+            if ((property.colourUpdateCompletionBlock != nil) && (property.displayColour != nil))
+            {
+                [properties addObject:property];
+            }
+        }
+    }
+    return properties;
+}
+
+- (UIView *)publishedViewForKey:(uint64_t)key
+{
+    int64_t index = UBKInspectionTreeFind(&_server.published, key);
+    if ((index < 0) || ((NSUInteger)index >= self.publishedViews.count))
+    {
+        return nil;
+    }
+    return self.publishedViews[(NSUInteger)index];
+}
+
+- (void)handleCommand:(const UBKInspectionCommand *)command
+{
+    UIView *view = [self publishedViewForKey:command->key];
+    UBKAccessibilityManager *manager = [UBKAccessibilityManager sharedInstance];
+    switch (command->type)
+    {
+        case UBKInspectionMessageSelect:
+        {
+            if (view != nil)
+            {
+                [manager.navigationViewController selectElement:view];
+                UBKInspectionServerSendSelection(&_server, command->key);
+            }
+            break;
+        }
+        case UBKInspectionMessageSetColour:
+        {
+            NSArray <UBKAccessibilityProperty *> *properties = [self colourPropertiesInSections:[manager accessibilityDetailsForView:view]];
+            if ((view == nil) || (command->colourIndex >= properties.count))
+            {
+                break;
+            }
+            //The same path as the colour picker, the block updates the view
+            properties[command->colourIndex].colourUpdateCompletionBlock([UIColor ubk_colourWithRGBA8:command->rgba]);
+            [manager invalidateAccessibilityDetailsForView:view];
+            self.needsPublish = true;
+            self.lastRefreshTime = 0;
+            break;
+        }
+        default:
+        {
+            //Snapshot requests are handled by the C server
+            break;
+        }
+    }
+}
+
+- (void)sendSelectionForView:(UIView *)view
+{
+    if (!self.isRunning)
+    {
+        return;
+    }
+    NSUInteger index = [self.publishedViews indexOfObjectIdenticalTo:view];
+    if (index != NSNotFound)
+    {
+        UBKInspectionServerSendSelection(&_server, _server.published.nodes[index].key);
+    }
+}
+
+@end
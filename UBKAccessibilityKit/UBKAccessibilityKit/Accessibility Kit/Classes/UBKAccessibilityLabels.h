@@ -0,0 +1,61 @@
+/*
+ File: UBKAccessibilityLabels.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "UBKLabels.h"
+
+@class UBKAccessibilitySnapshot;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Screen level label check for a snapshot, see UBKLabels.h. Visible interactive elements that VoiceOver reads the same way are duplicates, labels that repeat the identifier, image name or class name of the element echo a name.
+@interface UBKAccessibilityLabels : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot NS_DESIGNATED_INITIALIZER;
+
+//Visible elements with a label
+@property (nonatomic, readonly) NSUInteger labelledCount;
+@property (nonatomic, readonly) NSUInteger duplicateCount;
+@property (nonatomic, readonly) NSUInteger echoCount;
+
+//UBKLabelFlags for the view, 0 if the view isn't a labelled element
+- (uint32_t)flagsForView:(UIView *)view;
+
+//Other elements with the same label, hint and value as the view, empty when the view isn't a duplicate
+- (NSArray <UIView *> *)duplicatesOfView:(UIView *)view;
+
+//The kind of name the label of the view repeats, -1 when it doesn't
+- (NSInteger)echoedNameForView:(UIView *)view;
+
+//Folds the label results into the snapshot node hashes. Call updateSubtreeHashes on the snapshot after.
+- (void)combineResultsIntoSnapshot;
+
+//Asset name of the image shown by an image view or button, from the image accessibilityIdentifier or a name set with setImageName:forImage:. nil when it isn't known.
++ (nullable NSString *)imageNameForView:(UIView *)view;
+//For images that can't carry an accessibilityIdentifier, eg ones shared with other code. Pass nil to remove the name. Main thread only.
++ (void)setImageName:(nullable NSString *)name forImage:(UIImage *)image;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,248 @@
+/*
+ File: UBKAccessibilityLabels.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import "UBKAccessibilityLabels.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityScanArena.h"
+#import "UBKAccessibilityTargetSpacing.h"
+#import "UBKHash.h"
+
+@interface UBKAccessibilityLabels ()
+@property (nonatomic) UBKAccessibilitySnapshot *snapshot;
+@property (nonatomic, readwrite) NSUInteger labelledCount;
+@property (nonatomic, readwrite) NSUInteger duplicateCount;
+@property (nonatomic, readwrite) NSUInteger echoCount;
+//Snapshot node index for each label node
+@property (nonatomic) const uint32_t *labelNodes;
+@property (nonatomic) const UBKLabelResult *results;
+@property (nonatomic) NSUInteger labelNodeCount;
+@property (nonatomic) NSMapTable <UIView *, NSNumber *> *labelIndexes;
+@end
+
+@implementation UBKAccessibilityLabels
+
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    if (self = [super init])
+    {
+        self.snapshot = snapshot;
+        self.labelIndexes = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        [self analyseSnapshot];
+    }
+    return self;
+}
+
+- (void)analyseSnapshot
+{
+    const UBKSnapshotNode *nodes = self.snapshot.nodes;
+    NSUInteger nodeCount = self.snapshot.nodeCount;
+    NSArray <UIView *> *views = self.snapshot.views;
+    
+    UBKAccessibilityScanArena *scanArena = self.snapshot.scanArena;
+    UBKLabelNode *labels = [scanArena allocateCount:nodeCount size:sizeof(UBKLabelNode)];
+    uint32_t *nodeIndexes = [scanArena allocateCount:nodeCount size:sizeof(uint32_t)];
+    BOOL *hidden = [scanArena allocateCount:nodeCount size:sizeof(BOOL)];
+    if ((labels == NULL) || (nodeIndexes == NULL) || (hidden == NULL))
+    {
+        return;
+    }
+    size_t labelCount = 0;
+    
+    for (NSUInteger i = 0; i < nodeCount; i++)
+    {
+        //Parents always come first, so hidden ancestors have already been seen
+        hidden[i] = (nodes[i].flags & UBKSnapshotNodeFlagHidden) || ((nodes[i].parent >= 0) && (hidden[nodes[i].parent]));
+        if ((!(nodes[i].flags & UBKSnapshotNodeFlagElement)) || (hidden[i]))
+        {
+            continue;
+        }
+        
+        UIView *view = views[i];
+        NSString *label = view.accessibilityLabel;
+        uint64_t labelHash = [UBKAccessibilityLabels hashForText:label dropFirstWord:false];
+        if (labelHash == 0)
+        {
+            continue;
+        }
+        
+        UBKLabelNode *labelNode = &labels[labelCount];
+        labelNode->label = labelHash;
+        labelNode->labelIsCodeLike = UBKLabelIsCodeLike(label.UTF8String);
+        uint64_t hint = [UBKAccessibilityLabels hashForText:view.accessibilityHint dropFirstWord:false];
+        uint64_t value = [UBKAccessibilityLabels hashForText:view.accessibilityValue dropFirstWord:false];
+        labelNode->context = ((hint != 0) || (value != 0)) ? UBKHashCombine(hint, value) : 0;
+        labelNode->isInteractive = (nodes[i].flags & UBKSnapshotNodeFlagUserInteractionEnabled) && ([UBKAccessibilityTargetSpacing isTargetView:view]);
+        
+        //Swift classes are named Module.Class
+        NSString *className = [NSStringFromClass(view.class) componentsSeparatedByString:@"."].lastObject;
+        labelNode->names[UBKLabelNameIdentifier] = [UBKAccessibilityLabels hashForText:view.accessibilityIdentifier dropFirstWord:false];
+        labelNode->names[UBKLabelNameImage] = [UBKAccessibilityLabels hashForText:[UBKAccessibilityLabels imageNameForView:view] dropFirstWord:false];
+        labelNode->names[UBKLabelNameClass] = [UBKAccessibilityLabels hashForText:className dropFirstWord:false];
+        labelNode->names[UBKLabelNameClassWithoutPrefix] = [UBKAccessibilityLabels hashForText:className dropFirstWord:true];
+        
+        nodeIndexes[labelCount] = (uint32_t)i;
+        [self.labelIndexes setObject:@(labelCount) forKey:view];
+        labelCount++;
+    }
+    
+    UBKLabelResult *results = [scanArena allocateCount:labelCount size:sizeof(UBKLabelResult)];
+    if ((results == NULL) || (!UBKLabelsAnalyse(labels, labelCount, results)))
+    {
+        [self.labelIndexes removeAllObjects];
+        labelCount = 0;
+    }
+    
+    for (size_t i = 0; i < labelCount; i++)
+    {
+        if (results[i].flags & UBKLabelFlagDuplicate)
+        {
+            self.duplicateCount++;
+        }
+        if (results[i].flags & UBKLabelFlagEchoesName)
+        {
+            self.echoCount++;
+        }
+    }
+    
+    self.labelledCount = labelCount;
+    self.labelNodeCount = labelCount;
+    self.labelNodes = nodeIndexes;
+    self.results = results;
+}
+
+//Case and diacritics are folded here so UBKLabelHash only has to lowercase ASCII, eg "Café" and "CAFE" match
++ (uint64_t)hashForText:(NSString *)text dropFirstWord:(BOOL)dropFirstWord
+{
+    if (text.length == 0)
+    {
+        return 0;
+    }
+    NSString *folded = [text stringByFoldingWithOptions:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch | NSWidthInsensitiveSearch locale:nil];
+    return UBKLabelHash(folded.UTF8String, dropFirstWord);
+}
+
+//Names set with setImageName:forImage:, held weakly so images can still be released
++ (NSMapTable <UIImage *, NSString *> *)imageNames
+{
+    static NSMapTable <UIImage *, NSString *> *imageNames = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        imageNames = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsCopyIn];
+    });
+    return imageNames;
+}
+
++ (void)setImageName:(NSString *)name forImage:(UIImage *)image
+{
+    if (name.length > 0)
+    {
+        [[UBKAccessibilityLabels imageNames] setObject:name forKey:image];
+    }
+    else
+    {
+        [[UBKAccessibilityLabels imageNames] removeObjectForKey:image];
+    }
+}
+
++ (NSString *)imageNameForView:(UIView *)view
+{
+    UIImage *image = nil;
+    if ([view isKindOfClass:[UIImageView class]])
+    {
+        image = ((UIImageView *)view).image;
+    }
+    else if ([view isKindOfClass:[UIButton class]])
+    {
+        image = [((UIButton *)view) imageForState:UIControlStateNormal];
+    }
+    if (image == nil)
+    {
+        return nil;
+    }
+    if (image.accessibilityIdentifier.length > 0)
+    {
+        return image.accessibilityIdentifier;
+    }
+    return [[UBKAccessibilityLabels imageNames] objectForKey:image];
+}
+
+- (const UBKLabelResult *)resultForView:(UIView *)view
+{
+    NSNumber *index = [self.labelIndexes objectForKey:view];
+    if (index == nil)
+    {
+        return NULL;
+    }
+    const UBKLabelResult *results = self.results;
+    return &results[index.unsignedIntegerValue];
+}
+
+- (uint32_t)flagsForView:(UIView *)view
+{
+    const UBKLabelResult *result = [self resultForView:view];
+    return (result != NULL) ? result->flags : 0;
+}
+
+- (NSInteger)echoedNameForView:(UIView *)view
+{
+    const UBKLabelResult *result = [self resultForView:view];
+    return (result != NULL) ? result->echoedName : -1;
+}
+
+- (NSArray<UIView *> *)duplicatesOfView:(UIView *)view
+{
+    const UBKLabelResult *result = [self resultForView:view];
+    if ((result == NULL) || (!(result->flags & UBKLabelFlagDuplicate)))
+    {
+        return @[];
+    }
+    
+    const UBKLabelResult *results = self.results;
+    const uint32_t *nodeIndexes = self.labelNodes;
+    NSArray <UIView *> *views = self.snapshot.views;
+    NSMutableArray <UIView *> *duplicates = [[NSMutableArray alloc]initWithCapacity:result->duplicateCount];
+    //Duplicates can't come before the first one in the group
+    for (NSUInteger i = (NSUInteger)result->firstDuplicate; i < self.labelNodeCount; i++)
+    {
+        if ((results[i].firstDuplicate == result->firstDuplicate) && (views[nodeIndexes[i]] != view))
+        {
+            [duplicates addObject:views[nodeIndexes[i]]];
+        }
+    }
+    return duplicates;
+}
+
+- (void)combineResultsIntoSnapshot
+{
+    const UBKLabelResult *results = self.results;
+    const uint32_t *nodeIndexes = self.labelNodes;
+    for (NSUInteger i = 0; i < self.labelNodeCount; i++)
+    {
+        if (results[i].flags != 0)
+        {
+            //Shifted so the hash tells it apart from the target spacing and reading order flags
+            [self.snapshot combineHash:((uint64_t)results[i].flags << 40) intoNodeAtIndex:nodeIndexes[i]];
+        }
+    }
+}
+
+@end
@@ -0,0 +1,67 @@
+/*
+ File: UBKAccessibilityMetrics.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "UBKAccessibilityConstants.h"
+#import "UBKMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef enum : NSUInteger {
+    ///Counters, a timer and gauges for each refresh, written as the refresh is recorded
+    UBKAccessibilityMetricsFormatStatsD,
+    ///Prometheus text with the totals so far, the whole text is written after each refresh
+    UBKAccessibilityMetricsFormatPrometheus
+} UBKAccessibilityMetricsFormat;
+
+//What each refresh of the accessibility manager cost and found, see UBKMetrics. Recording a refresh is a handful of atomic adds so the metrics are always on, set refreshHandler or start an exporter to follow them over time.
+@interface UBKAccessibilityMetrics : NSObject
+
+//Live totals, read them with UBKMetricsRead from any thread
+@property (nonatomic, readonly) const UBKMetrics *metrics;
+
+//Called on the thread that recorded the refresh, the main queue for the manager's refreshes. refresh is only valid during the call.
+@property (nonatomic, copy, nullable) void (^refreshHandler)(UBKAccessibilityMetrics *metrics, const UBKMetricsRefresh *refresh);
+
+//Prefix of every metric name. Default ubk.
+@property (nonatomic, copy) NSString *prefix;
+
+//Share of snapshot nodes served by the audit cache since the metrics were created, 0 before the first refresh.
+@property (nonatomic, readonly) double cacheHitRate;
+
+- (void)recordRefresh:(const UBKMetricsRefresh *)refresh;
+
+- (NSString *)prometheusText;
+- (NSString *)statsDTextForRefresh:(const UBKMetricsRefresh *)refresh;
+
+//Exporting replaces any exporter already running. Text is written on a background queue so a slow file or listener doesn't hold up refreshes.
+//UDP to a local StatsD agent or any other listener, eg 127.0.0.1 port 8125.
+- (BOOL)startExportingToHost:(NSString *)host port:(uint16_t)port format:(UBKAccessibilityMetricsFormat)format;
+//StatsD lines are appended, Prometheus text replaces the file so it can be read by a textfile collector.
+- (BOOL)startExportingToFileURL:(NSURL *)fileURL format:(UBKAccessibilityMetricsFormat)format;
+- (void)stopExporting;
+
+//Warning type label used in metric names, eg colour_contrast_foreground
++ (NSString *)metricNameForWarningType:(UBKAccessibilityWarningType)warningType;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,193 @@
+/*
+ File: UBKAccessibilityMetrics.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import "UBKAccessibilityMetrics.h"
+#import "UBKAccessibilityFilter.h"
+
+@interface UBKAccessibilityMetrics ()
+{
+    UBKMetrics _metrics;
+    UBKMetricsSink _sink;
+}
+@property (nonatomic) dispatch_queue_t exportQueue;
+@property (nonatomic) BOOL isExporting;
+@property (nonatomic) UBKAccessibilityMetricsFormat exportFormat;
+@end
+
+@implementation UBKAccessibilityMetrics
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        UBKMetricsInit(&_metrics);
+        _prefix = @"ubk";
+        self.exportQueue = dispatch_queue_create("com.ubank.accessibility.metrics", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_isExporting)
+    {
+        UBKMetricsSinkClose(&_sink);
+    }
+}
+
+- (const UBKMetrics *)metrics
+{
+    return &_metrics;
+}
+
+//Names are made once from the filter names, eg "Colour contrast - Foreground" is colour_contrast_foreground, and kept as C strings for the formatters
++ (UBKMetricsTypeNames)typeNames
+{
+    static const char *names[UBKAccessibilityWarningTypeAppearanceContrast + 1];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (NSUInteger type = 0; type <= UBKAccessibilityWarningTypeAppearanceContrast; type++)
+        {
+            names[type] = strdup([self metricNameForWarningType:type].UTF8String);
+        }
+    });
+    return (UBKMetricsTypeNames){names, UBKAccessibilityWarningTypeAppearanceContrast + 1};
+}
+
++ (NSString *)metricNameForWarningType:(UBKAccessibilityWarningType)warningType
+{
+    NSString *warningName = [UBKAccessibilityFilter warningNameForWarningType:warningType].lowercaseString;
+    NSMutableString *metricName = [[NSMutableString alloc]init];
+    NSCharacterSet *allowedCharacters = [NSCharacterSet characterSetWithCharactersInString:@"abcdefghijklmnopqrstuvwxyz0123456789"];
+    BOOL needsSeparator = false;
+    for (NSUInteger i = 0; i < warningName.length; i++)
+    {
+        unichar character = [warningName characterAtIndex:i];
+        if (![allowedCharacters characterIsMember:character])
+        {
+            needsSeparator = (metricName.length > 0);
+            continue;
+        }
+        if (needsSeparator)
+        {
+            [metricName appendString:@"_"];
+            needsSeparator = false;
+        }
+        [metricName appendFormat:@"%C", character];
+    }
+    return metricName;
+}
+
+- (double)cacheHitRate
+{
+    UBKMetrics values;
+    UBKMetricsRead(&_metrics, &values);
+    uint64_t hits = values.counters[UBKMetricsCounterCacheHits];
+    uint64_t total = hits + values.counters[UBKMetricsCounterCacheMisses];
+    return (total > 0) ? (double)hits / total : 0;
+}
+
+- (void)recordRefresh:(const UBKMetricsRefresh *)refresh
+{
+    UBKMetricsRecordRefresh(&_metrics, refresh);
+    
+    if (self.isExporting)
+    {
+        //The text is made now so it matches this refresh, only the write waits on the queue
+        NSString *text = (self.exportFormat == UBKAccessibilityMetricsFormatStatsD) ? [self statsDTextForRefresh:refresh] : [self prometheusText];
+        NSData *data = [text dataUsingEncoding:NSUTF8StringEncoding];
+        dispatch_async(self.exportQueue, ^{
+            UBKMetricsSinkWrite(&self->_sink, data.bytes, data.length);
+        });
+    }
+    
+    if (self.refreshHandler)
+    {
+        self.refreshHandler(self, refresh);
+    }
+}
+
+- (NSString *)textWithLength:(size_t)length formatter:(size_t (^)(char *buffer, size_t capacity))formatter
+{
+    NSMutableData *data = [[NSMutableData alloc]initWithLength:length + 1];
+    length = formatter(data.mutableBytes, data.length);
+    return [[NSString alloc]initWithBytes:data.bytes length:MIN(length, data.length - 1) encoding:NSUTF8StringEncoding];
+}
+
+- (NSString *)prometheusText
+{
+    UBKMetricsTypeNames typeNames = [UBKAccessibilityMetrics typeNames];
+    const char *prefix = self.prefix.UTF8String;
+    size_t length = UBKMetricsFormatPrometheus(&_metrics, prefix, typeNames, NULL, 0);
+    //A refresh recorded in between can only make the numbers a few digits longer
+    return [self textWithLength:length + 256 formatter:^size_t(char *buffer, size_t capacity) {
+        return UBKMetricsFormatPrometheus(&self->_metrics, prefix, typeNames, buffer, capacity);
+    }];
+}
+
+- (NSString *)statsDTextForRefresh:(const UBKMetricsRefresh *)refresh
+{
+    UBKMetricsTypeNames typeNames = [UBKAccessibilityMetrics typeNames];
+    const char *prefix = self.prefix.UTF8String;
+    size_t length = UBKMetricsFormatStatsD(refresh, prefix, typeNames, NULL, 0);
+    return [self textWithLength:length formatter:^size_t(char *buffer, size_t capacity) {
+        return UBKMetricsFormatStatsD(refresh, prefix, typeNames, buffer, capacity);
+    }];
+}
+
+- (BOOL)startExportingToHost:(NSString *)host port:(uint16_t)port format:(UBKAccessibilityMetricsFormat)format
+{
+    [self stopExporting];
+    __block BOOL opened = false;
+    dispatch_sync(self.exportQueue, ^{
+        opened = UBKMetricsSinkOpenUDP(&self->_sink, host.UTF8String, port);
+    });
+    self.exportFormat = format;
+    self.isExporting = opened;
+    return opened;
+}
+
+- (BOOL)startExportingToFileURL:(NSURL *)fileURL format:(UBKAccessibilityMetricsFormat)format
+{
+    [self stopExporting];
+    __block BOOL opened = false;
+    dispatch_sync(self.exportQueue, ^{
+        opened = UBKMetricsSinkOpenFile(&self->_sink, fileURL.fileSystemRepresentation, format == UBKAccessibilityMetricsFormatPrometheus);
+    });
+    self.exportFormat = format;
+    self.isExporting = opened;
+    return opened;
+}
+
+- (void)stopExporting
+{
+    if (!self.isExporting)
+    {
+        return;
+    }
+    self.isExporting = false;
+    //Writes already queued finish first
+    dispatch_sync(self.exportQueue, ^{
+        UBKMetricsSinkClose(&self->_sink);
+    });
+}
+
+@end
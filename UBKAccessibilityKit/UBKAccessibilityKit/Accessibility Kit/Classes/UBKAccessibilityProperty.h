@@ -66,6 +66,9 @@ typedef enum : NSUInteger {
 
 - (id)mutableCopyWithZone:(NSZone *)zone;
 
+//True if both properties show the same row in the inspector, ie the same title, value, colours, contrast and warning.
+- (BOOL)hasSameDisplayAsProperty:(UBKAccessibilityProperty *)property;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -131,6 +131,32 @@
     return property;
 }
 
+- (BOOL)hasSameDisplayAsProperty:(UBKAccessibilityProperty *)property
+{
+    if ((self.displayType != property.displayType) || (self.displayWarning != property.displayWarning) || (self.warningLevel != property.warningLevel))
+    {
+        return false;
+    }
+    if ((![self.displayTitle isEqualToString:property.displayTitle]) || (![self.displayValue isEqualToString:property.displayValue]))
+    {
+        return false;
+    }
+    if ((![self colour:self.displayColour matchesColour:property.displayColour]) || (![self colour:self.displayAlternateColour matchesColour:property.displayAlternateColour]))
+    {
+        return false;
+    }
+    return ((self.displayContrastScore == property.displayContrastScore) || ([self.displayContrastScore isEqualToString:property.displayContrastScore]));
+}
+
+- (BOOL)colour:(UIColor *)colour matchesColour:(UIColor *)otherColour
+{
+    if ((colour == nil) || (otherColour == nil))
+    {
+        return colour == otherColour;
+    }
+    return [colour ubk_isEqualToColour:otherColour];
+}
+
 - (void)setWarningType:(UBKAccessibilityWarningType)warningType
 {
     _warningType = warningType;
@@ -0,0 +1,56 @@
+/*
+ File: UBKAccessibilityReadingOrder.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@class UBKAccessibilitySnapshot;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Screen level VoiceOver reading order check for a snapshot. The expected order comes from the element frames, see UBKReadingOrder.h, and is compared with the hierarchy order VoiceOver follows. Elements are the visible accessibility elements that aren't inside another one.
+@interface UBKAccessibilityReadingOrder : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot;
+//Rows are read right to left when rightToLeft is true. initWithSnapshot: uses the application layout direction.
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot rightToLeft:(BOOL)rightToLeft NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) BOOL rightToLeft;
+@property (nonatomic, readonly) NSUInteger elementCount;
+@property (nonatomic, readonly) NSUInteger outOfOrderCount;
+
+//Elements in expected reading order
+@property (nonatomic, readonly) NSArray <UIView *> *orderedViews;
+
+//0 based position in the expected reading order, NSNotFound if the view isn't an element
+- (NSUInteger)readingPositionForView:(UIView *)view;
+
+//True when VoiceOver focus jumps to or from the view out of reading order
+- (BOOL)isViewOutOfOrder:(UIView *)view;
+
+//Folds the out of order results into the snapshot node hashes. Positions aren't included, they shift for every element below an insertion. Call updateSubtreeHashes on the snapshot after.
+- (void)combineResultsIntoSnapshot;
+
+@end
+
+NS_ASSUME_NONNULL_END
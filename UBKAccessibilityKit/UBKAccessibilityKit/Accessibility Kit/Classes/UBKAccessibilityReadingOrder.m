@@ -0,0 +1,176 @@
+/*
+ File: UBKAccessibilityReadingOrder.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import "UBKAccessibilityReadingOrder.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityScanArena.h"
+#import "UBKReadingOrder.h"
+
+@interface UBKAccessibilityReadingOrder ()
+@property (nonatomic) UBKAccessibilitySnapshot *snapshot;
+@property (nonatomic, readwrite) BOOL rightToLeft;
+@property (nonatomic, readwrite) NSUInteger elementCount;
+@property (nonatomic, readwrite) NSUInteger outOfOrderCount;
+@property (nonatomic, readwrite) NSArray <UIView *> *orderedViews;
+//Snapshot node index for each reading order node
+@property (nonatomic) const uint32_t *readingNodes;
+@property (nonatomic) const UBKReadingOrderResult *results;
+@property (nonatomic) NSUInteger readingNodeCount;
+@property (nonatomic) NSMapTable <UIView *, NSNumber *> *readingIndexes;
+@end
+
+@implementation UBKAccessibilityReadingOrder
+
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    BOOL rightToLeft = [UIApplication sharedApplication].userInterfaceLayoutDirection == UIUserInterfaceLayoutDirectionRightToLeft;
+    return [self initWithSnapshot:snapshot rightToLeft:rightToLeft];
+}
+
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot rightToLeft:(BOOL)rightToLeft
+{
+    if (self = [super init])
+    {
+        self.snapshot = snapshot;
+        self.rightToLeft = rightToLeft;
+        self.readingIndexes = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        [self analyseSnapshot];
+    }
+    return self;
+}
+
+- (void)analyseSnapshot
+{
+    const UBKSnapshotNode *nodes = self.snapshot.nodes;
+    NSUInteger nodeCount = self.snapshot.nodeCount;
+    NSArray <UIView *> *views = self.snapshot.views;
+    
+    UBKAccessibilityScanArena *scanArena = self.snapshot.scanArena;
+    UBKReadingOrderNode *readingOrderNodes = [scanArena allocateCount:nodeCount size:sizeof(UBKReadingOrderNode)];
+    uint32_t *nodeIndexes = [scanArena allocateCount:nodeCount size:sizeof(uint32_t)];
+    //Per snapshot node, the reading order index of the group it's read in, -1 at the top level, or -2 when VoiceOver can't reach it
+    int32_t *enclosing = [scanArena allocateCount:nodeCount size:sizeof(int32_t)];
+    if ((readingOrderNodes == NULL) || (nodeIndexes == NULL) || (enclosing == NULL))
+    {
+        self.orderedViews = @[];
+        return;
+    }
+    size_t readingNodeCount = 0;
+    
+    for (NSUInteger i = 0; i < nodeCount; i++)
+    {
+        //Parents always come first
+        int32_t group = (nodes[i].parent >= 0) ? enclosing[nodes[i].parent] : -1;
+        if ((group == -2) || (nodes[i].flags & UBKSnapshotNodeFlagHidden))
+        {
+            enclosing[i] = -2;
+            continue;
+        }
+        enclosing[i] = group;
+        
+        BOOL isElement = (nodes[i].flags & UBKSnapshotNodeFlagAccessibilityElement) != 0;
+        BOOL isGroup = (!isElement) && (nodes[i].flags & UBKSnapshotNodeFlagGroupsAccessibilityChildren);
+        if ((!isElement) && (!isGroup))
+        {
+            continue;
+        }
+        
+        readingOrderNodes[readingNodeCount].frame = nodes[i].frame;
+        readingOrderNodes[readingNodeCount].group = group;
+        readingOrderNodes[readingNodeCount].isGroup = isGroup;
+        nodeIndexes[readingNodeCount] = (uint32_t)i;
+        //VoiceOver doesn't look inside accessibility elements
+        enclosing[i] = isElement ? -2 : (int32_t)readingNodeCount;
+        if (isElement)
+        {
+            [self.readingIndexes setObject:@(readingNodeCount) forKey:views[i]];
+        }
+        readingNodeCount++;
+    }
+    
+    UBKReadingOrderResult *results = [scanArena allocateCount:readingNodeCount size:sizeof(UBKReadingOrderResult)];
+    uint32_t *expectedOrder = [scanArena allocateCount:readingNodeCount size:sizeof(uint32_t)];
+    size_t elementCount = 0;
+    if ((results == NULL) || (expectedOrder == NULL) || (!UBKReadingOrderAnalyse(readingOrderNodes, readingNodeCount, self.rightToLeft, expectedOrder, &elementCount, results)))
+    {
+        [self.readingIndexes removeAllObjects];
+        readingNodeCount = 0;
+        elementCount = 0;
+    }
+    
+    NSMutableArray <UIView *> *orderedViews = [[NSMutableArray alloc]initWithCapacity:elementCount];
+    for (size_t i = 0; i < elementCount; i++)
+    {
+        [orderedViews addObject:views[nodeIndexes[expectedOrder[i]]]];
+    }
+    for (size_t i = 0; i < readingNodeCount; i++)
+    {
+        if (results[i].flags & UBKReadingOrderFlagOutOfOrder)
+        {
+            self.outOfOrderCount++;
+        }
+    }
+    
+    self.readingNodeCount = readingNodeCount;
+    self.elementCount = elementCount;
+    self.orderedViews = orderedViews;
+    self.readingNodes = nodeIndexes;
+    self.results = results;
+}
+
+- (NSUInteger)readingPositionForView:(UIView *)view
+{
+    NSNumber *index = [self.readingIndexes objectForKey:view];
+    if (index == nil)
+    {
+        return NSNotFound;
+    }
+    const UBKReadingOrderResult *results = self.results;
+    return (NSUInteger)results[index.unsignedIntegerValue].position;
+}
+
+- (BOOL)isViewOutOfOrder:(UIView *)view
+{
+    NSNumber *index = [self.readingIndexes objectForKey:view];
+    if (index == nil)
+    {
+        return false;
+    }
+    const UBKReadingOrderResult *results = self.results;
+    return (results[index.unsignedIntegerValue].flags & UBKReadingOrderFlagOutOfOrder) != 0;
+}
+
+- (void)combineResultsIntoSnapshot
+{
+    const UBKReadingOrderResult *results = self.results;
+    const uint32_t *nodeIndexes = self.readingNodes;
+    for (NSUInteger i = 0; i < self.readingNodeCount; i++)
+    {
+        if (results[i].flags != 0)
+        {
+            //Shifted so the hash tells it apart from a target spacing flag with the same value
+            [self.snapshot combineHash:((uint64_t)results[i].flags << 32) intoNodeAtIndex:nodeIndexes[i]];
+        }
+    }
+}
+
+@end
@@ -0,0 +1,85 @@
+/*
+ File: UBKAccessibilityReadingOrderView.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import "UBKAccessibilityReadingOrderView.h"
+#import "UBKAccessibilityReadingOrder.h"
+#import "UIColor+HelperMethods.h"
+
+@interface UBKAccessibilityReadingOrderView ()
+//Badges are reused between updates, extra badges are hidden.
+@property (nonatomic) NSMutableArray <UILabel *> *badgeLabels;
+@end
+
+@implementation UBKAccessibilityReadingOrderView
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    if (self = [super initWithFrame:frame])
+    {
+        self.badgeLabels = [[NSMutableArray alloc]init];
+        self.userInteractionEnabled = NO;
+        self.backgroundColor = [UIColor clearColor];
+        self.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+    }
+    return self;
+}
+
+- (void)updateWithReadingOrder:(UBKAccessibilityReadingOrder *)readingOrder
+{
+    //Magic numbers for the badge size and font.
+    UIFont *font = [UIFont boldSystemFontOfSize:11];
+    CGFloat height = 18;
+    
+    NSArray <UIView *> *orderedViews = readingOrder.orderedViews;
+    for (NSUInteger i = 0; i < orderedViews.count; i++)
+    {
+        UIView *view = orderedViews[i];
+        if (self.badgeLabels.count <= i)
+        {
+            UILabel *badgeLabel = [[UILabel alloc]init];
+            badgeLabel.font = font;
+            badgeLabel.textAlignment = NSTextAlignmentCenter;
+            badgeLabel.textColor = [UIColor whiteColor];
+            badgeLabel.layer.cornerRadius = height / 2;
+            badgeLabel.layer.masksToBounds = true;
+            [self addSubview:badgeLabel];
+            [self.badgeLabels addObject:badgeLabel];
+        }
+        
+        UILabel *badgeLabel = self.badgeLabels[i];
+        badgeLabel.text = [NSString stringWithFormat:@"%lu", (unsigned long)(i + 1)];
+        badgeLabel.backgroundColor = [readingOrder isViewOutOfOrder:view] ? [UIColor ubk_warningLevelMediumBackgroundColour] : [UIColor darkGrayColor];
+        CGFloat width = MAX(height, [badgeLabel sizeThatFits:CGSizeMake(CGFLOAT_MAX, height)].width + 8);
+        
+        //Pin the badge to the leading top corner of the element.
+        CGRect frame = [view convertRect:view.bounds toView:self];
+        CGFloat x = readingOrder.rightToLeft ? CGRectGetMaxX(frame) - width : CGRectGetMinX(frame);
+        badgeLabel.frame = CGRectMake(x, CGRectGetMinY(frame), width, height);
+        badgeLabel.hidden = false;
+    }
+    
+    for (NSUInteger i = orderedViews.count; i < self.badgeLabels.count; i++)
+    {
+        self.badgeLabels[i].hidden = true;
+    }
+}
+
+@end
@@ -0,0 +1,64 @@
+/*
+ File: UBKAccessibilitySampler.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "UBKSampling.h"
+
+@class UBKAccessibilityWindow;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Headless audits for release and beta builds, no inspector or button is shown. A fraction of screen appearances is audited and the results are queued as audit store records to upload later.
+//Views can only be read on the main thread, so the walk runs in short slices on later frames and the audit runs once the main thread budget allows, see UBKSamplingGovernor. Encoding and writing the results happens on a background queue.
+@interface UBKAccessibilitySampler : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+//Results are queued in an audit store at fileURL. Returns nil if the store can't be opened.
+- (nullable instancetype)initWithResultsFileURL:(NSURL *)fileURL;
+- (nullable instancetype)initWithResultsFileURL:(NSURL *)fileURL configuration:(UBKSamplingConfiguration)configuration NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) NSURL *resultsFileURL;
+//Decisions, back offs and time spent so far
+@property (nonatomic, readonly) const UBKSamplingGovernor *governor;
+
+//Seconds a new screen has to stay before it is walked, so transitions have finished. Default 0.5.
+@property (nonatomic) CFTimeInterval settleDuration;
+//Seconds between checks for a new screen. Default 1.
+@property (nonatomic) CFTimeInterval screenCheckInterval;
+//Longest slice of the walk per frame. Default 0.002.
+@property (nonatomic) CFTimeInterval maximumSliceDuration;
+
+@property (nonatomic, readonly) BOOL isRunning;
+//Records waiting in the results file
+@property (nonatomic, readonly) uint64_t queuedRecordCount;
+
+//Audits run through the shared UBKAccessibilityManager, but the window isn't set as its window so no inspector is added to it.
+- (void)startWithWindow:(UBKAccessibilityWindow *)window;
+//Any audit in progress is dropped
+- (void)stop;
+
+//Moves the queued records into a file of their own and starts a new queue. Returns nil when nothing is queued. Upload the file, eg with a background URLSession, then delete it. The file is an audit store, see UBKAuditStore.
+- (nullable NSURL *)takeQueuedResults;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,291 @@
+/*
+ File: UBKAccessibilitySampler.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import "UBKAccessibilitySampler.h"
+#import "UBKAccessibilityManager.h"
+#import "UBKAccessibilityWindow.h"
+#import "UBKAccessibilityAuditStore.h"
+#import "UBKAccessibilityHierarchyWalker.h"
+#import "UBKAccessibilitySnapshot.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+//A sampled screen that still hasn't been audited after this long is dropped so its views aren't held on to
+static const CFTimeInterval UBKSamplerMaximumSampleDuration = 30;
+
+typedef enum : NSUInteger {
+    UBKSamplerStateIdle,
+    //Waiting for the screen to settle
+    UBKSamplerStateSettling,
+    UBKSamplerStateWalking,
+    //Walked, waiting for enough budget to audit
+    UBKSamplerStateAuditing
+} UBKSamplerState;
+
+@interface UBKAccessibilitySampler ()
+{
+    UBKSamplingGovernor _governor;
+}
+@property (nonatomic, weak) UBKAccessibilityWindow *window;
+//Only used on resultsQueue once the sampler is set up, takeQueuedResults replaces it there
+@property (nonatomic) UBKAccessibilityAuditStore *auditStore;
+//Read on the main thread when the records are built, so it's kept apart from the store
+@property (nonatomic) uint64_t buildHash;
+@property (nonatomic) dispatch_queue_t resultsQueue;
+@property (nonatomic) NSTimer *screenCheckTimer;
+@property (nonatomic) CADisplayLink *displayLink;
+@property (nonatomic) CFTimeInterval lastFrameTimestamp;
+@property (nonatomic) NSString *screenName;
+@property (nonatomic) UBKSamplerState state;
+@property (nonatomic) CFTimeInterval sampleStartTime;
+@property (nonatomic) UBKAccessibilityHierarchyWalker *hierarchyWalker;
+@property (nonatomic) CFTimeInterval walkDuration;
+@property (nonatomic, readwrite) BOOL isRunning;
+@end
+
+@implementation UBKAccessibilitySampler
+
+- (instancetype)initWithResultsFileURL:(NSURL *)fileURL
+{
+    return [self initWithResultsFileURL:fileURL configuration:UBKSamplingDefaultConfiguration()];
+}
+
+- (instancetype)initWithResultsFileURL:(NSURL *)fileURL configuration:(UBKSamplingConfiguration)configuration
+{
+    if (self = [super init])
+    {
+        _resultsFileURL = fileURL;
+        self.auditStore = [[UBKAccessibilityAuditStore alloc]initWithFileURL:fileURL];
+        if (!self.auditStore)
+        {
+            return nil;
+        }
+        self.buildHash = self.auditStore.buildHash;
+        uint64_t seed = ((uint64_t)arc4random() << 32) | arc4random();
+        UBKSamplingGovernorInit(&_governor, &configuration, seed, CACurrentMediaTime());
+        self.resultsQueue = dispatch_queue_create("com.ubank.accessibility.sampler", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_BACKGROUND, 0));
+        self.settleDuration = 0.5;
+        self.screenCheckInterval = 1;
+        self.maximumSliceDuration = 0.002;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_screenCheckTimer invalidate];
+    [_displayLink invalidate];
+}
+
+- (const UBKSamplingGovernor *)governor
+{
+    return &_governor;
+}
+
+- (void)startWithWindow:(UBKAccessibilityWindow *)window
+{
+    [self stop];
+    //The manager doesn't get the window, setting it adds the inspector and starts walks outside the budget
+    self.window = window;
+    self.isRunning = true;
+    
+    //The timer only holds the sampler weakly so a running sampler can still be released
+    __weak UBKAccessibilitySampler *weakSelf = self;
+    self.screenCheckTimer = [NSTimer scheduledTimerWithTimeInterval:self.screenCheckInterval repeats:true block:^(NSTimer *timer) {
+        [weakSelf checkScreen];
+    }];
+    self.screenCheckTimer.tolerance = self.screenCheckInterval / 2;
+}
+
+- (void)stop
+{
+    [self.screenCheckTimer invalidate];
+    self.screenCheckTimer = nil;
+    if (self.state != UBKSamplerStateIdle)
+    {
+        [self finishSample:false];
+    }
+    self.screenName = nil;
+    self.isRunning = false;
+}
+
+//Each new screen is one appearance. Screens are told apart by their view controllers, the same name the snapshots use.
+- (void)checkScreen
+{
+    if (self.window == nil)
+    {
+        [self stop];
+        return;
+    }
+    NSString *screenName = [[UBKAccessibilityManager sharedInstance] visibleScreenNameForWindow:self.window];
+    if ([screenName isEqualToString:self.screenName])
+    {
+        return;
+    }
+    self.screenName = screenName;
+    
+    if (self.state != UBKSamplerStateIdle)
+    {
+        [self finishSample:false];
+    }
+    
+    CFTimeInterval now = CACurrentMediaTime();
+    if (UBKSamplingGovernorScreenDidAppear(&_governor, now) == UBKSamplingDecisionSample)
+    {
+        self.state = UBKSamplerStateSettling;
+        self.sampleStartTime = now;
+        self.lastFrameTimestamp = 0;
+        self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(frameDidFire:)];
+        [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    }
+}
+
+//The display link only runs while a sample is in progress. Frame times come from its timestamps.
+- (void)frameDidFire:(CADisplayLink *)displayLink
+{
+    CFTimeInterval now = CACurrentMediaTime();
+    if (self.lastFrameTimestamp > 0)
+    {
+        UBKSamplingGovernorRecordFrame(&_governor, displayLink.timestamp - self.lastFrameTimestamp, now);
+    }
+    self.lastFrameTimestamp = displayLink.timestamp;
+    
+    if ((UBKSamplingGovernorIsBackingOff(&_governor, now)) || (now - self.sampleStartTime > UBKSamplerMaximumSampleDuration))
+    {
+        [self finishSample:false];
+        return;
+    }
+    
+    switch (self.state)
+    {
+        case UBKSamplerStateSettling:
+        {
+            if (now - self.sampleStartTime >= self.settleDuration)
+            {
+                self.walkDuration = 0;
+                self.hierarchyWalker = [[UBKAccessibilityManager sharedInstance] hierarchyWalkerForWindow:self.window];
+                self.state = UBKSamplerStateWalking;
+            }
+            break;
+        }
+        case UBKSamplerStateWalking:
+        {
+            [self continueWalkAtTime:now];
+            break;
+        }
+        case UBKSamplerStateAuditing:
+        {
+            uint32_t nodeCount = (uint32_t)self.hierarchyWalker.snapshot.nodeCount;
+            if (UBKSamplingGovernorIsAuditTooExpensive(&_governor, nodeCount))
+            {
+                [self finishSample:false];
+            }
+            else if (UBKSamplingGovernorCanAudit(&_governor, nodeCount, now))
+            {
+                [self auditHierarchy];
+            }
+            break;
+        }
+        case UBKSamplerStateIdle:
+        {
+            break;
+        }
+    }
+}
+
+- (void)continueWalkAtTime:(CFTimeInterval)now
+{
+    CFTimeInterval available = UBKSamplingGovernorAvailableTime(&_governor, now);
+    if (available <= 0)
+    {
+        return;
+    }
+    
+    CFTimeInterval startTime = CACurrentMediaTime();
+    BOOL isFinished = [self.hierarchyWalker walkForDuration:MIN(available, self.maximumSliceDuration)];
+    CFTimeInterval duration = CACurrentMediaTime() - startTime;
+    UBKSamplingGovernorSpend(&_governor, duration);
+    self.walkDuration += duration;
+    
+    if (isFinished)
+    {
+        self.state = UBKSamplerStateAuditing;
+    }
+}
+
+- (void)auditHierarchy
+{
+    CFTimeInterval startTime = CACurrentMediaTime();
+    UBKAccessibilityManager *manager = [UBKAccessibilityManager sharedInstance];
+    [manager auditHierarchyWalk:self.hierarchyWalker visibleBounds:self.window.bounds walkDuration:self.walkDuration];
+    NSData *records = [UBKAccessibilityAuditStore recordsForSnapshot:manager.currentSnapshot buildHash:self.buildHash date:[NSDate date] usingBlock:nil];
+    UBKSamplingGovernorRecordAudit(&_governor, (uint32_t)manager.currentSnapshot.nodeCount, CACurrentMediaTime() - startTime);
+    [self finishSample:true];
+    
+    if (records.length > 0)
+    {
+        dispatch_async(self.resultsQueue, ^{
+            [self.auditStore appendRecords:records.bytes count:records.length / sizeof(UBKAuditRecord)];
+        });
+    }
+}
+
+- (void)finishSample:(BOOL)completed
+{
+    [self.displayLink invalidate];
+    self.displayLink = nil;
+    self.hierarchyWalker = nil;
+    self.state = UBKSamplerStateIdle;
+    UBKSamplingGovernorFinishSample(&_governor, completed);
+}
+
+- (uint64_t)queuedRecordCount
+{
+    __block uint64_t count = 0;
+    dispatch_sync(self.resultsQueue, ^{
+        count = self.auditStore.recordCount;
+    });
+    return count;
+}
+
+- (NSURL *)takeQueuedResults
+{
+    __block NSURL *uploadURL = nil;
+    dispatch_sync(self.resultsQueue, ^{
+        if (self.auditStore.recordCount == 0)
+        {
+            return;
+        }
+        [self.auditStore close];
+        
+        NSString *fileName = [NSString stringWithFormat:@"%@-%@.%@", self.resultsFileURL.URLByDeletingPathExtension.lastPathComponent, [NSUUID UUID].UUIDString, self.resultsFileURL.pathExtension];
+        NSURL *fileURL = [self.resultsFileURL.URLByDeletingLastPathComponent URLByAppendingPathComponent:fileName];
+        if ([[NSFileManager defaultManager] moveItemAtURL:self.resultsFileURL toURL:fileURL error:nil])
+        {
+            uploadURL = fileURL;
+        }
+        //Start a new queue, or carry on with the old one if the move failed
+        self.auditStore = [[UBKAccessibilityAuditStore alloc]initWithFileURL:self.resultsFileURL];
+    });
+    return uploadURL;
+}
+
+@end
@@ -0,0 +1,44 @@
+/*
+ File: UBKAccessibilityScanArena.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import "UBKArena.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Arena for the buffers of one refresh, shared by its snapshot and the screen level passes. Arenas are pooled, once every object from a refresh has been released its arena is reset and handed to the next one, so a screen that has been scanned before is scanned again without asking the system for memory.
+@interface UBKAccessibilityScanArena : NSObject
+
+//Takes an arena from the pool, or makes a new one when the pool is empty
++ (instancetype)scanArena;
+
+@property (nonatomic, readonly) UBKArena *arena;
+//Blocks taken from malloc since the arena was taken from the pool, 0 once it has seen a scan as large as this one
+@property (nonatomic, readonly) uint64_t systemAllocations;
+//Allocations and bytes handed out since the arena was taken from the pool
+@property (nonatomic, readonly) uint64_t allocations;
+@property (nonatomic, readonly) size_t bytesUsed;
+
+//Zeroed array of count items, valid while the scan arena is alive. NULL if the memory couldn't be allocated.
+- (nullable void *)allocateCount:(NSUInteger)count size:(size_t)size;
+
+@end
+
+NS_ASSUME_NONNULL_END
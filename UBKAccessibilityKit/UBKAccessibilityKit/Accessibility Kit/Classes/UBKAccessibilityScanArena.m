@@ -0,0 +1,114 @@
+/*
+ File: UBKAccessibilityScanArena.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "UBKAccessibilityScanArena.h"
+
+#import <os/lock.h>
+
+//The inspector, the sampler and the session recorder can each hold on to a refresh
+#define UBKScanArenaPoolSize 3
+
+static UBKArena *UBKScanArenaPool[UBKScanArenaPoolSize];
+static NSUInteger UBKScanArenaPoolCount = 0;
+static os_unfair_lock UBKScanArenaPoolLock = OS_UNFAIR_LOCK_INIT;
+
+@interface UBKAccessibilityScanArena ()
+@property (nonatomic, readwrite) UBKArena *arena;
+@property (nonatomic) uint64_t initialSystemAllocations;
+@end
+
+@implementation UBKAccessibilityScanArena
+
++ (instancetype)scanArena
+{
+    return [[UBKAccessibilityScanArena alloc]init];
+}
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        UBKArena *arena = NULL;
+        os_unfair_lock_lock(&UBKScanArenaPoolLock);
+        if (UBKScanArenaPoolCount > 0)
+        {
+            UBKScanArenaPoolCount--;
+            arena = UBKScanArenaPool[UBKScanArenaPoolCount];
+        }
+        os_unfair_lock_unlock(&UBKScanArenaPoolLock);
+        
+        if (arena == NULL)
+        {
+            arena = malloc(sizeof(UBKArena));
+            if (arena == NULL)
+            {
+                return nil;
+            }
+            UBKArenaInit(arena, 0);
+        }
+        self.arena = arena;
+        self.initialSystemAllocations = arena->stats.systemAllocations;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    UBKArena *arena = self.arena;
+    UBKArenaReset(arena);
+    
+    BOOL isPooled = false;
+    os_unfair_lock_lock(&UBKScanArenaPoolLock);
+    if (UBKScanArenaPoolCount < UBKScanArenaPoolSize)
+    {
+        UBKScanArenaPool[UBKScanArenaPoolCount] = arena;
+        UBKScanArenaPoolCount++;
+        isPooled = true;
+    }
+    os_unfair_lock_unlock(&UBKScanArenaPoolLock);
+    
+    if (!isPooled)
+    {
+        UBKArenaDestroy(arena);
+        free(arena);
+    }
+}
+
+- (uint64_t)systemAllocations
+{
+    return self.arena->stats.systemAllocations - self.initialSystemAllocations;
+}
+
+- (uint64_t)allocations
+{
+    return self.arena->stats.allocations;
+}
+
+- (size_t)bytesUsed
+{
+    return self.arena->stats.bytesUsed;
+}
+
+- (void *)allocateCount:(NSUInteger)count size:(size_t)size
+{
+    return UBKArenaAllocateArray(self.arena, count, size);
+}
+
+@end
@@ -0,0 +1,63 @@
+/*
+ File: UBKAccessibilityScreenPasses.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@class UBKAccessibilitySnapshot, UBKAccessibilityVisibility, UBKAccessibilityTargetSpacing, UBKAccessibilityReadingOrder, UBKAccessibilityLabels, UBKAccessibilityAppearances, UBKAccessibilityColourVision, UBKAccessibilitySubtreeGroups;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//The screen level passes of one audit, run on a finished snapshot before its elements are audited so the element warnings can use them. The manager's settings decide which of the optional passes run.
+@interface UBKAccessibilityScreenPasses : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+//Culls the elements outside visibleBounds, runs the passes and updates the subtree hashes of the snapshot. visibleBounds is in the coordinates of the snapshot frames.
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot visibleBounds:(CGRect)visibleBounds NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) UBKAccessibilitySnapshot *snapshot;
+//nil when the pass is turned off in the manager
+@property (nonatomic, readonly, nullable) UBKAccessibilityVisibility *visibility;
+@property (nonatomic, readonly) UBKAccessibilityTargetSpacing *targetSpacing;
+@property (nonatomic, readonly) UBKAccessibilityReadingOrder *readingOrder;
+@property (nonatomic, readonly) UBKAccessibilityLabels *labels;
+@property (nonatomic, readonly, nullable) UBKAccessibilityAppearances *appearances;
+@property (nonatomic, readonly) UBKAccessibilityColourVision *colourVision;
+@property (nonatomic, readonly, nullable) UBKAccessibilitySubtreeGroups *subtreeGroups;
+//Each pass that ran counts as one rule run in the metrics
+@property (nonatomic, readonly) NSUInteger passCount;
+
+//The passes the validation rules read. The manager's current passes, except inside performAudit:.
+@property (class, nonatomic, readonly, nullable) UBKAccessibilityScreenPasses *auditedPasses;
+//Runs block with these passes as auditedPasses, for audits that are kept apart from the screen in the inspector. Main thread only.
+- (void)performAudit:(void (^)(void))block;
+
+//Removes the elements the visibility pass culled
+- (void)removeCulledElements:(NSMutableArray <UIView *> *)elements;
+//Removes all but the representative of each group of repeated elements
+- (void)removeRepeatedElements:(NSMutableArray <UIView *> *)elements;
+//How many elements the view stands for, 1 unless it represents a group of repeated subtrees
+- (NSUInteger)repeatCountForView:(UIView *)view;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,145 @@
+/*
+ File: UBKAccessibilityScreenPasses.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import "UBKAccessibilityScreenPasses.h"
+#import "UBKAccessibilityManager.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityVisibility.h"
+#import "UBKAccessibilityTargetSpacing.h"
+#import "UBKAccessibilityReadingOrder.h"
+#import "UBKAccessibilityLabels.h"
+#import "UBKAccessibilityAppearances.h"
+#import "UBKAccessibilityColourVision.h"
+#import "UBKAccessibilitySubtreeGroups.h"
+
+@interface UBKAccessibilityScreenPasses ()
+@property (nonatomic, readwrite) UBKAccessibilitySnapshot *snapshot;
+@property (nonatomic, readwrite) UBKAccessibilityVisibility *visibility;
+@property (nonatomic, readwrite) UBKAccessibilityTargetSpacing *targetSpacing;
+@property (nonatomic, readwrite) UBKAccessibilityReadingOrder *readingOrder;
+@property (nonatomic, readwrite) UBKAccessibilityLabels *labels;
+@property (nonatomic, readwrite) UBKAccessibilityAppearances *appearances;
+@property (nonatomic, readwrite) UBKAccessibilityColourVision *colourVision;
+@property (nonatomic, readwrite) UBKAccessibilitySubtreeGroups *subtreeGroups;
+@property (nonatomic, readwrite) NSUInteger passCount;
+@end
+
+//Set by performAudit:
+static UBKAccessibilityScreenPasses *performingPasses = nil;
+
+@implementation UBKAccessibilityScreenPasses
+
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot visibleBounds:(CGRect)visibleBounds
+{
+    if (self = [super init])
+    {
+        self.snapshot = snapshot;
+        [self runPassesWithVisibleBounds:visibleBounds];
+    }
+    return self;
+}
+
+//Culling goes first so the other passes skip invisible elements
+- (void)runPassesWithVisibleBounds:(CGRect)visibleBounds
+{
+    UBKAccessibilityManager *manager = [UBKAccessibilityManager sharedInstance];
+    UBKAccessibilitySnapshot *snapshot = self.snapshot;
+    if (manager.isCullingInvisibleElements)
+    {
+        self.visibility = [[UBKAccessibilityVisibility alloc]initWithSnapshot:snapshot bounds:visibleBounds];
+        [self.visibility cullSnapshot];
+        self.passCount++;
+    }
+    self.targetSpacing = [[UBKAccessibilityTargetSpacing alloc]initWithSnapshot:snapshot spacing:manager.minimumTargetSpacing];
+    [self.targetSpacing combineResultsIntoSnapshot];
+    self.passCount++;
+    self.readingOrder = [[UBKAccessibilityReadingOrder alloc]initWithSnapshot:snapshot];
+    [self.readingOrder combineResultsIntoSnapshot];
+    self.passCount++;
+    self.labels = [[UBKAccessibilityLabels alloc]initWithSnapshot:snapshot];
+    [self.labels combineResultsIntoSnapshot];
+    self.passCount++;
+    if (manager.isAuditingAppearances)
+    {
+        self.appearances = [[UBKAccessibilityAppearances alloc]initWithSnapshot:snapshot];
+        [self.appearances combineResultsIntoSnapshot];
+        self.passCount++;
+    }
+    //Only rates colours that are already in the node hashes, so nothing to combine
+    self.colourVision = [[UBKAccessibilityColourVision alloc]initWithSnapshot:snapshot];
+    self.passCount++;
+    [snapshot updateSubtreeHashes];
+    //Grouped last so the screen level results are part of the structure
+    if (manager.isGroupingRepeatedSubtrees)
+    {
+        self.subtreeGroups = [[UBKAccessibilitySubtreeGroups alloc]initWithSnapshot:snapshot];
+        self.passCount++;
+    }
+}
+
++ (UBKAccessibilityScreenPasses *)auditedPasses
+{
+    return performingPasses ? performingPasses : [UBKAccessibilityManager sharedInstance].currentPasses;
+}
+
+- (void)performAudit:(void (^)(void))block
+{
+    UBKAccessibilityScreenPasses *previousPasses = performingPasses;
+    performingPasses = self;
+    block();
+    performingPasses = previousPasses;
+}
+
+- (void)removeCulledElements:(NSMutableArray<UIView *> *)elements
+{
+    if (self.visibility.culledCount == 0)
+    {
+        return;
+    }
+    NSIndexSet *culledIndexes = [elements indexesOfObjectsPassingTest:^BOOL(UIView *view, NSUInteger idx, BOOL *stop) {
+        return [self.visibility isViewCulled:view];
+    }];
+    [elements removeObjectsAtIndexes:culledIndexes];
+}
+
+- (void)removeRepeatedElements:(NSMutableArray<UIView *> *)elements
+{
+    if (self.subtreeGroups.sharedNodeCount == 0)
+    {
+        return;
+    }
+    NSIndexSet *repeatedIndexes = [elements indexesOfObjectsPassingTest:^BOOL(UIView *view, NSUInteger idx, BOOL *stop) {
+        return [self.subtreeGroups repeatCountForView:view] == 0;
+    }];
+    [elements removeObjectsAtIndexes:repeatedIndexes];
+}
+
+- (NSUInteger)repeatCountForView:(UIView *)view
+{
+    if (self.subtreeGroups == nil)
+    {
+        return 1;
+    }
+    return [self.subtreeGroups repeatCountForView:view];
+}
+
+@end
@@ -0,0 +1,74 @@
+/*
+ File: UBKAccessibilitySessionRecorder.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import "UBKAccessibilityConstants.h"
+
+@class UBKAccessibilitySnapshot, UBKAccessibilityAuditStore;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Compact result for one distinct screen visited during a session. The per element warnings are only written to disk.
+@interface UBKAccessibilityScreenAudit : NSObject
+@property (nonatomic, readonly) uint64_t fingerprint;
+@property (nonatomic, readonly) NSString *screenName;
+@property (nonatomic, readonly) NSDate *date;
+@property (nonatomic, readonly) NSUInteger elementCount;
+@property (nonatomic, readonly) NSUInteger highWarningCount;
+@property (nonatomic, readonly) NSUInteger mediumWarningCount;
+@property (nonatomic, readonly) NSUInteger lowWarningCount;
+//Bit mask of the UBKAccessibilityWarningType values found on the screen, 1 << warningType.
+@property (nonatomic, readonly) uint64_t warningTypeMask;
+@end
+
+//Records every distinct screen visited while the kit is running, eg during a manual QA pass. Screens are identified by the snapshot fingerprint, screens already seen in the session are not audited again.
+//The most recent audits are kept in a fixed size ring buffer and every audit is appended to the file as a line of JSON, so memory stays flat over long sessions.
+@interface UBKAccessibilitySessionRecorder : NSObject
+
+@property (nonatomic, readonly) NSURL *fileURL;
+@property (nonatomic, readonly) NSUInteger capacity;
+
+//When set, each recorded screen also adds a record per element with warnings to the store. Default nil.
+@property (nonatomic, nullable) UBKAccessibilityAuditStore *auditStore;
+
+//Ring buffer contents, oldest first.
+@property (nonatomic, readonly) NSArray <UBKAccessibilityScreenAudit *> *recentAudits;
+
+@property (nonatomic, readonly) NSUInteger recordedScreenCount;
+@property (nonatomic, readonly) NSUInteger skippedSnapshotCount;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+//Audits are appended to the file at fileURL, the file is created if needed.
+- (instancetype)initWithFileURL:(NSURL *)fileURL capacity:(NSUInteger)capacity;
+
+- (BOOL)hasRecordedFingerprint:(uint64_t)fingerprint;
+
+//Audits the snapshot if its screen hasn't been seen in this session. Returns nil when the screen was skipped.
+- (nullable UBKAccessibilityScreenAudit *)recordSnapshot:(UBKAccessibilitySnapshot *)snapshot;
+
+//Forget the screens seen so far, the file is kept.
+- (void)startNewSession;
+
+- (void)closeFile;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,236 @@
+/*
+ File: UBKAccessibilitySessionRecorder.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "UBKAccessibilitySessionRecorder.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilitySection.h"
+#import "UIView+UBKAccessibility.h"
+#import "UBKHash.h"
+#import "UBKAccessibilityAuditStore.h"
+
+@interface UBKAccessibilityScreenAudit ()
+@property (nonatomic, readwrite) uint64_t fingerprint;
+@property (nonatomic, readwrite) NSString *screenName;
+@property (nonatomic, readwrite) NSDate *date;
+@property (nonatomic, readwrite) NSUInteger elementCount;
+@property (nonatomic, readwrite) NSUInteger highWarningCount;
+@property (nonatomic, readwrite) NSUInteger mediumWarningCount;
+@property (nonatomic, readwrite) NSUInteger lowWarningCount;
+@property (nonatomic, readwrite) uint64_t warningTypeMask;
+@end
+
+@implementation UBKAccessibilityScreenAudit
+@end
+
+@interface UBKAccessibilitySessionRecorder ()
+{
+    UBKHashSet _recordedFingerprints;
+}
+@property (nonatomic) NSMutableArray <UBKAccessibilityScreenAudit *> *ringBuffer;
+@property (nonatomic) NSUInteger ringBufferHead;
+@property (nonatomic) NSFileHandle *fileHandle;
+@property (nonatomic) NSISO8601DateFormatter *dateFormatter;
+@property (nonatomic, readwrite) NSUInteger recordedScreenCount;
+@property (nonatomic, readwrite) NSUInteger skippedSnapshotCount;
+@end
+
+@implementation UBKAccessibilitySessionRecorder
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL capacity:(NSUInteger)capacity
+{
+    if (self = [super init])
+    {
+        _fileURL = fileURL;
+        _capacity = MAX(capacity, 1);
+        UBKHashSetInit(&_recordedFingerprints, 64);
+        self.ringBuffer = [[NSMutableArray alloc]initWithCapacity:_capacity];
+        self.dateFormatter = [[NSISO8601DateFormatter alloc]init];
+        
+        if (![[NSFileManager defaultManager]fileExistsAtPath:fileURL.path])
+        {
+            [[NSFileManager defaultManager]createFileAtPath:fileURL.path contents:nil attributes:nil];
+        }
+        self.fileHandle = [NSFileHandle fileHandleForWritingAtPath:fileURL.path];
+        [self.fileHandle seekToEndOfFile];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self closeFile];
+    UBKHashSetDestroy(&_recordedFingerprints);
+}
+
+- (void)closeFile
+{
+    [self.fileHandle synchronizeFile];
+    [self.fileHandle closeFile];
+    self.fileHandle = nil;
+}
+
+- (void)startNewSession
+{
+    UBKHashSetRemoveAll(&_recordedFingerprints);
+    [self.ringBuffer removeAllObjects];
+    self.ringBufferHead = 0;
+}
+
+- (BOOL)hasRecordedFingerprint:(uint64_t)fingerprint
+{
+    return UBKHashSetContains(&_recordedFingerprints, fingerprint);
+}
+
+- (NSArray<UBKAccessibilityScreenAudit *> *)recentAudits
+{
+    if (self.ringBuffer.count < self.capacity)
+    {
+        return [self.ringBuffer copy];
+    }
+    //Buffer is full, the head is the oldest entry
+    NSMutableArray *audits = [[NSMutableArray alloc]initWithCapacity:self.capacity];
+    for (NSUInteger i = 0; i < self.capacity; i++)
+    {
+        [audits addObject:self.ringBuffer[(self.ringBufferHead + i) % self.capacity]];
+    }
+    return audits;
+}
+
+- (UBKAccessibilityScreenAudit *)recordSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    if (!UBKHashSetInsert(&_recordedFingerprints, snapshot.fingerprint))
+    {
+        self.skippedSnapshotCount++;
+        return nil;
+    }
+    
+    UBKAccessibilityScreenAudit *audit = [[UBKAccessibilityScreenAudit alloc]init];
+    audit.fingerprint = snapshot.fingerprint;
+    audit.screenName = snapshot.screenName;
+    audit.date = [NSDate date];
+    
+    NSMutableArray *elementWarnings = [[NSMutableArray alloc]init];
+    const UBKSnapshotNode *nodes = snapshot.nodes;
+    NSData *records = [UBKAccessibilityAuditStore recordsForSnapshot:snapshot buildHash:self.auditStore.buildHash date:audit.date usingBlock:^(NSUInteger index, NSArray<UBKAccessibilitySection *> *sections, uint64_t warningMask) {
+        audit.elementCount++;
+        audit.warningTypeMask |= warningMask;
+        
+        //Only elements with warnings are written, passing elements are counted.
+        if (warningMask == 0)
+        {
+            return;
+        }
+        NSMutableArray *warningTypes = [[NSMutableArray alloc]init];
+        for (UBKAccessibilitySection *section in sections)
+        {
+            if (section.sectionType != SectionDisplayTypeWarnings)
+            {
+                continue;
+            }
+            for (UBKAccessibilityProperty *property in section.items)
+            {
+                [self addWarningLevel:property.warningLevel toAudit:audit];
+                [warningTypes addObject:@(property.warningType)];
+            }
+        }
+        UIView *view = snapshot.views[index];
+        UBKRect frame = nodes[index].frame;
+        [elementWarnings addObject:@{@"class" : NSStringFromClass(view.class),
+                                     @"identifier" : view.accessibilityIdentifier ?: @"",
+                                     @"label" : view.accessibilityLabel ?: @"",
+                                     @"frame" : @[@(frame.x), @(frame.y), @(frame.width), @(frame.height)],
+                                     @"warnings" : warningTypes}];
+    }];
+    
+    if ((self.auditStore) && (records.length > 0))
+    {
+        [self.auditStore appendRecords:records.bytes count:records.length / sizeof(UBKAuditRecord)];
+    }
+    [self writeAudit:audit elementWarnings:elementWarnings];
+    [self addAuditToRingBuffer:audit];
+    self.recordedScreenCount++;
+    return audit;
+}
+
+- (void)addWarningLevel:(UBKAccessibilityWarningLevel)warningLevel toAudit:(UBKAccessibilityScreenAudit *)audit
+{
+    switch (warningLevel)
+    {
+        case UBKAccessibilityWarningLevelHigh:
+        {
+            audit.highWarningCount++;
+            break;
+        }
+        case UBKAccessibilityWarningLevelMedium:
+        {
+            audit.mediumWarningCount++;
+            break;
+        }
+        case UBKAccessibilityWarningLevelLow:
+        {
+            audit.lowWarningCount++;
+            break;
+        }
+        case UBKAccessibilityWarningLevelPass:
+        {
+            break;
+        }
+    }
+}
+
+- (void)addAuditToRingBuffer:(UBKAccessibilityScreenAudit *)audit
+{
+    if (self.ringBuffer.count < self.capacity)
+    {
+        [self.ringBuffer addObject:audit];
+        return;
+    }
+    //Overwrite the oldest entry
+    self.ringBuffer[self.ringBufferHead] = audit;
+    self.ringBufferHead = (self.ringBufferHead + 1) % self.capacity;
+}
+
+//Each audit is one line of JSON so the file can be streamed and appended to across sessions.
+- (void)writeAudit:(UBKAccessibilityScreenAudit *)audit elementWarnings:(NSArray *)elementWarnings
+{
+    if (!self.fileHandle)
+    {
+        return;
+    }
+    
+    NSDictionary *line = @{@"fingerprint" : [NSString stringWithFormat:@"%016llx", audit.fingerprint],
+                           @"screen" : audit.screenName ?: @"",
+                           @"date" : [self.dateFormatter stringFromDate:audit.date],
+                           @"elements" : @(audit.elementCount),
+                           @"high" : @(audit.highWarningCount),
+                           @"medium" : @(audit.mediumWarningCount),
+                           @"low" : @(audit.lowWarningCount),
+                           @"warnings" : elementWarnings};
+    
+    NSMutableData *data = [[NSJSONSerialization dataWithJSONObject:line options:0 error:nil]mutableCopy];
+    if (!data)
+    {
+        return;
+    }
+    [data appendBytes:"\n" length:1];
+    [self.fileHandle writeData:data];
+}
+
+@end
@@ -0,0 +1,74 @@
+/*
+ File: UBKAccessibilitySnapshot.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "UBKSnapshot.h"
+#import "UBKColourValue.h"
+
+@class UBKAccessibilityScanArena;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Snapshot of the window hierarchy taken by UBKAccessibilityManager during configureAllUIElments. Holds the C node array and the views for each node, in the same order.
+@interface UBKAccessibilitySnapshot : NSObject
+
+//Visible view controller path, eg UINavigationController/LoginViewController
+@property (nonatomic, readonly) NSString *screenName;
+@property (nonatomic, readonly) NSArray <UIView *> *views;
+@property (nonatomic, readonly) NSUInteger nodeCount;
+@property (nonatomic, readonly) const UBKSnapshotNode *nodes;
+//Holds the nodes and the compositing results. Screen level passes allocate their buffers from it as well, they keep the snapshot and so the arena alive.
+@property (nonatomic, readonly) UBKAccessibilityScanArena *scanArena;
+
+//Only valid once finishSnapshot has been called.
+@property (nonatomic, readonly) uint64_t fingerprint;
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithScreenName:(NSString *)screenName;
+
+//Adds the view under the current parent and makes it the new parent. Every push that returns true must be matched with a pop once the subviews have been walked. Returns false when the node couldn't be allocated, nothing was added so there is nothing to pop.
+- (BOOL)pushView:(UIView *)view isElement:(BOOL)isElement;
+- (void)popView;
+
+- (void)finishSnapshot;
+
+//Mix a result worked out after the walk into the hash of a node, eg touch target spacing, so the audit cache sees the change. Call updateSubtreeHashes when done.
+- (void)combineHash:(uint64_t)hash intoNodeAtIndex:(NSUInteger)index;
+//Clear flags worked out after the walk, eg UBKSnapshotNodeFlagElement for views that aren't visible. Combine a hash for the change as well.
+- (void)clearFlags:(uint32_t)flags fromNodeAtIndex:(NSUInteger)index;
+- (void)updateSubtreeHashes;
+
+//Fills keys with nodeCount element keys, see UBKSnapshotElementKeys.
+- (void)getElementKeys:(uint64_t *)keys;
+
+//Index of the node for the view, NSNotFound if the view isn't in the snapshot.
+- (NSInteger)indexOfView:(UIView *)view;
+
+//Background seen behind the content of a node. Translucent backgrounds and view alpha are composited down to the first opaque one, or the window background. No components when nothing on the way down has a background.
+- (UBKColourValue)backgroundColourValueAtIndex:(NSUInteger)index;
+//Product of the alpha of the node and its ancestors, how much of what the node draws shows on screen.
+- (float)opacityAtIndex:(NSUInteger)index;
+//Reads the backgrounds and alpha of a node and its descendants from their views again, eg after a colour was edited in the inspector. The hashes are left as they were.
+- (void)updateCompositingOfSubtreeAtIndex:(NSUInteger)index;
+
+@end
+
+NS_ASSUME_NONNULL_END
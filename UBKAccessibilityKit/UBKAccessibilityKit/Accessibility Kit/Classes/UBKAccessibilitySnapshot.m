@@ -0,0 +1,248 @@
+/*
+ File: UBKAccessibilitySnapshot.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityScanArena.h"
+#import "UBKAccessibilityClassInfo.h"
+#import "UBKHash.h"
+#import "UIView+UBKAccessibility.h"
+#import "UIColor+HelperMethods.h"
+#import "UIView+HelperMethods.h"
+
+typedef struct {
+    UBKColourValue background;
+    float opacity;
+} UBKSnapshotCompositing;
+
+@interface UBKAccessibilitySnapshot ()
+{
+    UBKSnapshot _snapshot;
+    //UBKSnapshotCompositing for each node, filled in as the nodes are pushed
+    UBKSnapshotCompositing *_compositing;
+    uint32_t _compositingCapacity;
+}
+@property (nonatomic) NSMutableArray <UIView *> *mutableViews;
+@property (nonatomic) NSMapTable <UIView *, NSNumber *> *viewIndexes;
+@property (nonatomic, readwrite) UBKAccessibilityScanArena *scanArena;
+@property (nonatomic, readwrite) uint64_t fingerprint;
+@end
+
+@implementation UBKAccessibilitySnapshot
+
+- (instancetype)initWithScreenName:(NSString *)screenName
+{
+    if (self = [super init])
+    {
+        self.scanArena = [UBKAccessibilityScanArena scanArena];
+        UBKSnapshotInitWithArena(&_snapshot, self.scanArena.arena);
+        _screenName = [screenName copy];
+        _snapshot.screenHash = UBKHashString(UBKHashInitialValue, screenName.UTF8String);
+        self.mutableViews = [[NSMutableArray alloc]init];
+        self.viewIndexes = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    //The arena is reset once the scan arena is released, after this
+    UBKSnapshotDestroy(&_snapshot);
+}
+
+- (NSArray<UIView *> *)views
+{
+    return self.mutableViews;
+}
+
+- (NSUInteger)nodeCount
+{
+    return _snapshot.count;
+}
+
+- (const UBKSnapshotNode *)nodes
+{
+    return _snapshot.nodes;
+}
+
+- (NSInteger)indexOfView:(UIView *)view
+{
+    NSNumber *index = [self.viewIndexes objectForKey:view];
+    return index ? index.integerValue : NSNotFound;
+}
+
+- (BOOL)pushView:(UIView *)view isElement:(BOOL)isElement
+{
+    UBKSnapshotNode node = {0};
+    node.classHash = [UBKAccessibilityClassInfo classInfoForView:view].classHash;
+    node.identifierHash = UBKHashString(UBKHashInitialValue, view.accessibilityIdentifier.UTF8String);
+    UBKSnapshotCompositing compositing = [self compositingForView:view parent:_snapshot.currentParent];
+    //The opacity changes how the foreground colours composite, so it's part of the background hash as well
+    node.backgroundHash = UBKHashCombine(UBKHashCombine(UBKHashInitialValue, ((uint64_t)compositing.background.hasComponents << 32) | compositing.background.key), (uint64_t)lroundf(compositing.opacity * 255));
+    node.nodeHash = UBKHashCombine(UBKHashCombine(view.ubk_accessibilityAuditHash, node.backgroundHash), isElement);
+    node.structureHash = UBKHashCombine(UBKHashCombine(view.ubk_accessibilityStructureHash, node.backgroundHash), isElement);
+    
+    CGRect frame = [view convertRect:view.bounds toView:nil];
+    node.frame = (UBKRect){frame.origin.x, frame.origin.y, frame.size.width, frame.size.height};
+    
+    if (isElement)
+    {
+        node.flags |= UBKSnapshotNodeFlagElement;
+    }
+    if (view.userInteractionEnabled)
+    {
+        node.flags |= UBKSnapshotNodeFlagUserInteractionEnabled;
+    }
+    if ((view.hidden) || (view.alpha == 0))
+    {
+        node.flags |= UBKSnapshotNodeFlagHidden;
+    }
+    if ([self isViewCovering:view])
+    {
+        node.flags |= UBKSnapshotNodeFlagOpaque;
+    }
+    if (view.alpha < 1)
+    {
+        node.flags |= UBKSnapshotNodeFlagTranslucent;
+    }
+    if (view.clipsToBounds)
+    {
+        node.flags |= UBKSnapshotNodeFlagClipsToBounds;
+    }
+    if (view.isAccessibilityElement)
+    {
+        node.flags |= UBKSnapshotNodeFlagAccessibilityElement;
+    }
+    if (view.shouldGroupAccessibilityChildren)
+    {
+        node.flags |= UBKSnapshotNodeFlagGroupsAccessibilityChildren;
+    }
+    
+    if (_snapshot.count >= _compositingCapacity)
+    {
+        uint32_t capacity = MAX(_compositingCapacity * 2, 64);
+        UBKSnapshotCompositing *resized = UBKArenaResize(self.scanArena.arena, _compositing, _compositingCapacity * sizeof(UBKSnapshotCompositing), capacity * sizeof(UBKSnapshotCompositing));
+        if (resized == NULL)
+        {
+            return false;
+        }
+        _compositing = resized;
+        _compositingCapacity = capacity;
+    }
+    
+    int32_t index = UBKSnapshotPushNode(&_snapshot, &node);
+    if (index < 0)
+    {
+        return false;
+    }
+    [self.mutableViews addObject:view];
+    [self.viewIndexes setObject:@(index) forKey:view];
+    _compositing[index] = compositing;
+    return true;
+}
+
+//UIView.opaque defaults to true, so check what actually gets drawn. Only the view's own alpha is checked here, translucent ancestors are handled by the visibility pass.
+- (BOOL)isViewCovering:(UIView *)view
+{
+    if ((view.alpha < 1) || (view.layer.cornerRadius > 0) || (view.transform.b != 0) || (view.transform.c != 0))
+    {
+        return false;
+    }
+    if (view.backgroundColor == nil)
+    {
+        return false;
+    }
+    return CGColorGetAlpha(view.backgroundColor.CGColor) >= 1;
+}
+
+//Matches ubk_findBackgroundColour:, the view's own background is composited over the background of the parent node. Parents are pushed first so each node is one blend.
+- (UBKSnapshotCompositing)compositingForView:(UIView *)view parent:(int32_t)parentIndex
+{
+    UBKSnapshotCompositing parent;
+    if (parentIndex >= 0)
+    {
+        parent = _compositing[parentIndex];
+    }
+    else
+    {
+        //Top level views are drawn on the window
+        parent.opacity = (view.window != nil) ? view.window.alpha : 1;
+        parent.background = UBKColourValueComposite(view.window.backgroundColor.ubk_colourValue, parent.opacity, UBKColourValueMakeUnknown());
+    }
+    
+    UBKSnapshotCompositing compositing;
+    compositing.opacity = parent.opacity * view.alpha;
+    compositing.background = UBKColourValueComposite([UIView ubk_ownBackgroundColourForView:view].ubk_colourValue, compositing.opacity, parent.background);
+    return compositing;
+}
+
+- (void)updateCompositingOfSubtreeAtIndex:(NSUInteger)index
+{
+    if (index >= _snapshot.count)
+    {
+        return;
+    }
+    //Nodes are in pre-order, so each parent is updated before its children
+    for (uint32_t i = (uint32_t)index; i < _snapshot.nodes[index].subtreeEnd; i++)
+    {
+        _compositing[i] = [self compositingForView:self.mutableViews[i] parent:_snapshot.nodes[i].parent];
+    }
+}
+
+- (UBKColourValue)backgroundColourValueAtIndex:(NSUInteger)index
+{
+    return _compositing[index].background;
+}
+
+- (float)opacityAtIndex:(NSUInteger)index
+{
+    return _compositing[index].opacity;
+}
+
+- (void)popView
+{
+    UBKSnapshotPopNode(&_snapshot);
+}
+
+- (void)finishSnapshot
+{
+    self.fingerprint = UBKSnapshotFingerprint(&_snapshot);
+}
+
+- (void)combineHash:(uint64_t)hash intoNodeAtIndex:(NSUInteger)index
+{
+    UBKSnapshotCombineNodeHash(&_snapshot, (uint32_t)index, hash);
+}
+
+- (void)clearFlags:(uint32_t)flags fromNodeAtIndex:(NSUInteger)index
+{
+    UBKSnapshotClearNodeFlags(&_snapshot, (uint32_t)index, flags);
+}
+
+- (void)updateSubtreeHashes
+{
+    UBKSnapshotUpdateSubtreeHashes(&_snapshot);
+}
+
+- (void)getElementKeys:(uint64_t *)keys
+{
+    UBKSnapshotElementKeys(&_snapshot, keys);
+}
+
+@end
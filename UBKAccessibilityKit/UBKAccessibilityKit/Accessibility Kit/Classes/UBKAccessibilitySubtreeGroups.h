@@ -0,0 +1,47 @@
+/*
+ File: UBKAccessibilitySubtreeGroups.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "UBKSubtreeGroups.h"
+
+@class UBKAccessibilitySnapshot;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Repeated sibling subtrees of a snapshot, see UBKSubtreeGroups.h. Run after the other screen level passes so their results are part of the structure.
+@interface UBKAccessibilitySubtreeGroups : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot NS_DESIGNATED_INITIALIZER;
+
+//Nodes that share the results of a representative
+@property (nonatomic, readonly) NSUInteger sharedNodeCount;
+//One per snapshot node
+@property (nonatomic, readonly) const UBKSubtreeGroup *groups;
+
+//The view whose results the view shares, the view itself when it isn't repeated or isn't in the snapshot
+- (UIView *)representativeOfView:(UIView *)view;
+//How many views share the results of a representative, including itself. 1 for views that aren't repeated and 0 for views that share another view's results.
+- (NSUInteger)repeatCountForView:(UIView *)view;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,66 @@
+/*
+ File: UBKAccessibilitySubtreeGroups.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "UBKAccessibilitySubtreeGroups.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityScanArena.h"
+
+@interface UBKAccessibilitySubtreeGroups ()
+@property (nonatomic) UBKAccessibilitySnapshot *snapshot;
+@property (nonatomic, readwrite) const UBKSubtreeGroup *groups;
+@property (nonatomic, readwrite) NSUInteger sharedNodeCount;
+@end
+
+@implementation UBKAccessibilitySubtreeGroups
+
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    if (self = [super init])
+    {
+        self.snapshot = snapshot;
+        UBKSubtreeGroup *groups = [snapshot.scanArena allocateCount:MAX(snapshot.nodeCount, 1) size:sizeof(UBKSubtreeGroup)];
+        int64_t sharedCount = (groups != NULL) ? UBKSubtreeGroupsFind(snapshot.nodes, (uint32_t)snapshot.nodeCount, groups) : -1;
+        self.groups = groups;
+        self.sharedNodeCount = (sharedCount > 0) ? (NSUInteger)sharedCount : 0;
+    }
+    return self;
+}
+
+- (UIView *)representativeOfView:(UIView *)view
+{
+    NSInteger index = [self.snapshot indexOfView:view];
+    if ((index == NSNotFound) || (self.groups == NULL))
+    {
+        return view;
+    }
+    return self.snapshot.views[self.groups[index].representative];
+}
+
+- (NSUInteger)repeatCountForView:(UIView *)view
+{
+    NSInteger index = [self.snapshot indexOfView:view];
+    if ((index == NSNotFound) || (self.groups == NULL))
+    {
+        return 1;
+    }
+    return self.groups[index].repeatCount;
+}
+
+@end
@@ -0,0 +1,54 @@
+/*
+ File: UBKAccessibilityTargetSpacing.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "UBKTargetSpacing.h"
+
+@class UBKAccessibilitySnapshot;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Screen level touch target check for a snapshot. Targets are the visible, interactive elements, eg controls and views with a button, link or adjustable trait.
+@interface UBKAccessibilityTargetSpacing : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot spacing:(CGFloat)spacing;
+
+@property (nonatomic, readonly) CGFloat spacing;
+@property (nonatomic, readonly) NSUInteger targetCount;
+@property (nonatomic, readonly) NSUInteger overlapCount;
+@property (nonatomic, readonly) NSUInteger tooCloseCount;
+
+//0 for views that pass or aren't targets
+- (UBKTargetSpacingFlags)flagsForView:(UIView *)view;
+
+//Nearest target the view overlaps or is too close to
+- (nullable UIView *)conflictingViewForView:(UIView *)view;
+
+//Folds the results into the snapshot node hashes, so the audit cache re-audits a target when only its neighbours moved. Call updateSubtreeHashes on the snapshot after.
+- (void)combineResultsIntoSnapshot;
+
++ (BOOL)isTargetView:(UIView *)view;
+
+@end
+
+NS_ASSUME_NONNULL_END
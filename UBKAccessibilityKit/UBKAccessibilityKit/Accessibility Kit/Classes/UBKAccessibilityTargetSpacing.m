@@ -0,0 +1,166 @@
+/*
+ File: UBKAccessibilityTargetSpacing.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import "UBKAccessibilityTargetSpacing.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityScanArena.h"
+#import "UBKAccessibilityClassInfo.h"
+
+@interface UBKAccessibilityTargetSpacing ()
+@property (nonatomic) UBKAccessibilitySnapshot *snapshot;
+@property (nonatomic, readwrite) CGFloat spacing;
+@property (nonatomic, readwrite) NSUInteger targetCount;
+@property (nonatomic, readwrite) NSUInteger overlapCount;
+@property (nonatomic, readwrite) NSUInteger tooCloseCount;
+//Snapshot node index for each target
+@property (nonatomic) const uint32_t *targetNodes;
+@property (nonatomic) const UBKTargetSpacingResult *results;
+@property (nonatomic) NSMapTable <UIView *, NSNumber *> *targetIndexes;
+@end
+
+@implementation UBKAccessibilityTargetSpacing
+
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot spacing:(CGFloat)spacing
+{
+    if (self = [super init])
+    {
+        self.snapshot = snapshot;
+        self.spacing = spacing;
+        self.targetIndexes = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        [self analyseSnapshot];
+    }
+    return self;
+}
+
+- (void)analyseSnapshot
+{
+    const UBKSnapshotNode *nodes = self.snapshot.nodes;
+    NSUInteger nodeCount = self.snapshot.nodeCount;
+    NSArray <UIView *> *views = self.snapshot.views;
+    
+    UBKAccessibilityScanArena *scanArena = self.snapshot.scanArena;
+    UBKTarget *targets = [scanArena allocateCount:nodeCount size:sizeof(UBKTarget)];
+    uint32_t *nodeIndexes = [scanArena allocateCount:nodeCount size:sizeof(uint32_t)];
+    BOOL *hidden = [scanArena allocateCount:nodeCount size:sizeof(BOOL)];
+    if ((targets == NULL) || (nodeIndexes == NULL) || (hidden == NULL))
+    {
+        return;
+    }
+    size_t targetCount = 0;
+    
+    for (NSUInteger i = 0; i < nodeCount; i++)
+    {
+        //Parents always come first, so hidden ancestors have already been seen
+        hidden[i] = (nodes[i].flags & UBKSnapshotNodeFlagHidden) || ((nodes[i].parent >= 0) && (hidden[nodes[i].parent]));
+        
+        uint32_t requiredFlags = UBKSnapshotNodeFlagElement | UBKSnapshotNodeFlagUserInteractionEnabled;
+        if (((nodes[i].flags & requiredFlags) != requiredFlags) || (hidden[i]))
+        {
+            continue;
+        }
+        if ((nodes[i].frame.width <= 0) || (nodes[i].frame.height <= 0) || (![UBKAccessibilityTargetSpacing isTargetView:views[i]]))
+        {
+            continue;
+        }
+        targets[targetCount].frame = nodes[i].frame;
+        targets[targetCount].index = (uint32_t)i;
+        targets[targetCount].subtreeEnd = nodes[i].subtreeEnd;
+        nodeIndexes[targetCount] = (uint32_t)i;
+        [self.targetIndexes setObject:@(targetCount) forKey:views[i]];
+        targetCount++;
+    }
+    
+    UBKTargetSpacingResult *results = [scanArena allocateCount:targetCount size:sizeof(UBKTargetSpacingResult)];
+    if ((results == NULL) || (!UBKTargetSpacingAnalyse(targets, targetCount, self.spacing, results)))
+    {
+        [self.targetIndexes removeAllObjects];
+        targetCount = 0;
+    }
+    
+    for (size_t i = 0; i < targetCount; i++)
+    {
+        if (results[i].flags & UBKTargetSpacingFlagOverlap)
+        {
+            self.overlapCount++;
+        }
+        if (results[i].flags & UBKTargetSpacingFlagTooClose)
+        {
+            self.tooCloseCount++;
+        }
+    }
+    
+    self.targetCount = targetCount;
+    self.targetNodes = nodeIndexes;
+    self.results = results;
+}
+
+- (UBKTargetSpacingFlags)flagsForView:(UIView *)view
+{
+    NSNumber *index = [self.targetIndexes objectForKey:view];
+    if (index == nil)
+    {
+        return 0;
+    }
+    const UBKTargetSpacingResult *results = self.results;
+    return results[index.unsignedIntegerValue].flags;
+}
+
+- (UIView *)conflictingViewForView:(UIView *)view
+{
+    NSNumber *index = [self.targetIndexes objectForKey:view];
+    if (index == nil)
+    {
+        return nil;
+    }
+    const UBKTargetSpacingResult *results = self.results;
+    int32_t conflict = results[index.unsignedIntegerValue].conflict;
+    if (conflict < 0)
+    {
+        return nil;
+    }
+    const uint32_t *nodeIndexes = self.targetNodes;
+    return self.snapshot.views[nodeIndexes[conflict]];
+}
+
+- (void)combineResultsIntoSnapshot
+{
+    const UBKTargetSpacingResult *results = self.results;
+    const uint32_t *nodeIndexes = self.targetNodes;
+    for (NSUInteger i = 0; i < self.targetCount; i++)
+    {
+        if (results[i].flags != 0)
+        {
+            [self.snapshot combineHash:results[i].flags intoNodeAtIndex:nodeIndexes[i]];
+        }
+    }
+}
+
++ (BOOL)isTargetView:(UIView *)view
+{
+    if ([UBKAccessibilityClassInfo classInfoForView:view].rules & UBKAccessibilityClassRuleTouchTarget)
+    {
+        return true;
+    }
+    UIAccessibilityTraits targetTraits = UIAccessibilityTraitButton | UIAccessibilityTraitLink | UIAccessibilityTraitAdjustable | UIAccessibilityTraitKeyboardKey;
+    return (view.isAccessibilityElement) && ((view.accessibilityTraits & targetTraits) != 0);
+}
+
+@end
@@ -0,0 +1,56 @@
+/*
+ File: UBKAccessibilityTextRuns.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "UBKAccessibilityValidation.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Contrast of every attribute run of a control's text, see UBKTextRuns.h. Runs without a colour or font attribute use the control's text colour and font, whitespace only runs are skipped.
+@interface UBKAccessibilityTextRuns : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+//backgroundColour is the effective background of the view, the run background colours are drawn over it.
+- (instancetype)initWithAttributedText:(nullable NSAttributedString *)attributedText textColour:(nullable UIColor *)textColour font:(nullable UIFont *)font forView:(UIView *)view backgroundColour:(nullable UIColor *)backgroundColour NS_DESIGNATED_INITIALIZER;
+
+//Runs that can rate differently, at least 1. Text without anything visible is rated as a single empty run in the text colour and font.
+@property (nonatomic, readonly) NSUInteger runCount;
+
+//The run with the lowest rating, then the lowest contrast
+@property (nonatomic, readonly) NSRange worstRunRange;
+@property (nonatomic, readonly) NSString *worstRunText;
+@property (nonatomic, readonly) double worstContrast;
+@property (nonatomic, readonly) ColourContrastRating worstRating;
+@property (nonatomic, readonly) double worstTextSize;
+@property (nonatomic, readonly) BOOL worstBoldFont;
+//The colour the run's text is set to
+@property (nonatomic, readonly, nullable) UIColor *worstTextColour;
+//The run's colours once composited with the run background and the view's opacity, as used for the contrast
+@property (nonatomic, readonly, nullable) UIColor *worstForegroundColour;
+@property (nonatomic, readonly, nullable) UIColor *worstBackgroundColour;
+
+//Copy of attributedText with the text colour of range set to colour, eg to change just the worst run from the inspector
++ (NSAttributedString *)attributedText:(NSAttributedString *)attributedText settingColour:(UIColor *)colour inRange:(NSRange)range;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,128 @@
+/*
+ File: UBKAccessibilityTextRuns.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import "UBKAccessibilityTextRuns.h"
+#import "UBKAccessibilityManager.h"
+#import "UBKTextRuns.h"
+#import "UIColor+HelperMethods.h"
+#import "UIFont+HelperMethods.h"
+
+@interface UBKAccessibilityTextRuns ()
+@property (nonatomic, readwrite) NSUInteger runCount;
+@property (nonatomic, readwrite) NSRange worstRunRange;
+@property (nonatomic, readwrite) NSString *worstRunText;
+@property (nonatomic, readwrite) double worstContrast;
+@property (nonatomic, readwrite) ColourContrastRating worstRating;
+@property (nonatomic, readwrite) double worstTextSize;
+@property (nonatomic, readwrite) BOOL worstBoldFont;
+@property (nonatomic, readwrite) UIColor *worstTextColour;
+@property (nonatomic, readwrite) UIColor *worstForegroundColour;
+@property (nonatomic, readwrite) UIColor *worstBackgroundColour;
+@end
+
+@implementation UBKAccessibilityTextRuns
+
+- (instancetype)initWithAttributedText:(NSAttributedString *)attributedText textColour:(UIColor *)textColour font:(UIFont *)font forView:(UIView *)view backgroundColour:(UIColor *)backgroundColour
+{
+    if (self = [super init])
+    {
+        [self evaluateAttributedText:attributedText textColour:textColour font:font forView:view backgroundColour:backgroundColour];
+    }
+    return self;
+}
+
+- (void)evaluateAttributedText:(NSAttributedString *)attributedText textColour:(UIColor *)textColour font:(UIFont *)font forView:(UIView *)view backgroundColour:(UIColor *)backgroundColour
+{
+    __block UBKTextRunTable table;
+    UBKTextRunTableInit(&table);
+    
+    //Colours keep their UIColor so the worst run can be shown as it was set, fonts are looked up once per font rather than once per run
+    NSMutableArray *runColours = [[NSMutableArray alloc]init];
+    NSMapTable <UIFont *, NSNumber *> *boldFonts = [NSMapTable strongToStrongObjectsMapTable];
+    NSString *string = attributedText.string;
+    NSCharacterSet *visibleCharacters = [[NSCharacterSet whitespaceAndNewlineCharacterSet] invertedSet];
+    [attributedText enumerateAttributesInRange:NSMakeRange(0, attributedText.length) options:0 usingBlock:^(NSDictionary<NSAttributedStringKey, id> *attributes, NSRange range, BOOL *stop) {
+        if ([string rangeOfCharacterFromSet:visibleCharacters options:0 range:range].location == NSNotFound)
+        {
+            return;
+        }
+        UIColor *runColour = attributes[NSForegroundColorAttributeName] ?: textColour;
+        UIColor *runBackgroundColour = attributes[NSBackgroundColorAttributeName];
+        UIFont *runFont = attributes[NSFontAttributeName] ?: font;
+        NSNumber *boldFont = [boldFonts objectForKey:runFont];
+        if ((!boldFont) && (runFont))
+        {
+            boldFont = @([runFont ubk_isFontBold]);
+            [boldFonts setObject:boldFont forKey:runFont];
+        }
+        uint32_t runCount = table.count;
+        if (!UBKTextRunTableAppend(&table, (uint32_t)range.location, (uint32_t)range.length, runColour.ubk_colourValue, runBackgroundColour ? runBackgroundColour.ubk_colourValue : UBKColourValueMakeUnknown(), runFont.pointSize, boldFont.boolValue))
+        {
+            *stop = true;
+            return;
+        }
+        if (table.count > runCount)
+        {
+            [runColours addObject:runColour ?: [NSNull null]];
+        }
+    }];
+    if (table.count == 0)
+    {
+        UBKTextRunTableAppend(&table, 0, 0, textColour.ubk_colourValue, UBKColourValueMakeUnknown(), font.pointSize, [font ubk_isFontBold]);
+        [runColours addObject:textColour ?: [NSNull null]];
+    }
+    
+    int32_t worst = UBKTextRunTableEvaluate(&table, backgroundColour.ubk_colourValue, [UBKAccessibilityValidation getEffectiveOpacity:view], [UBKAccessibilityManager sharedInstance].ruleEvaluator);
+    if (worst >= 0)
+    {
+        const UBKTextRun *run = &table.runs[worst];
+        self.runCount = table.count;
+        self.worstRunRange = NSMakeRange(run->location, run->length);
+        self.worstRunText = (string.length > 0) ? [string substringWithRange:self.worstRunRange] : @"";
+        self.worstContrast = run->contrast;
+        self.worstRating = (ColourContrastRating)run->rating;
+        self.worstTextSize = run->textSize;
+        self.worstBoldFont = run->boldFont;
+        self.worstTextColour = (runColours[worst] != [NSNull null]) ? runColours[worst] : nil;
+        //Opaque text on an opaque background is shown as it was set, the same as getEffectiveForegroundColour:
+        self.worstForegroundColour = UBKColourValueEqual(run->effectiveForeground, run->foreground) ? self.worstTextColour : [UIColor ubk_colourWithColourValue:run->effectiveForeground];
+        self.worstBackgroundColour = (run->background.hasComponents) ? [UIColor ubk_colourWithColourValue:run->effectiveBackground] : backgroundColour;
+    }
+    else
+    {
+        //Only when the table couldn't grow, rate the text as failing rather than hiding it
+        self.worstRunText = @"";
+        self.worstRating = ColourContrastRatingFail;
+    }
+    UBKTextRunTableDestroy(&table);
+}
+
++ (NSAttributedString *)attributedText:(NSAttributedString *)attributedText settingColour:(UIColor *)colour inRange:(NSRange)range
+{
+    NSMutableAttributedString *updatedText = [[NSMutableAttributedString alloc]initWithAttributedString:attributedText];
+    if (NSMaxRange(range) <= updatedText.length)
+    {
+        [updatedText addAttribute:NSForegroundColorAttributeName value:colour range:range];
+    }
+    return updatedText;
+}
+
+@end
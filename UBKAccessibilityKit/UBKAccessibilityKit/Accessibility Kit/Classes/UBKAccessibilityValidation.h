@@ -22,7 +22,7 @@
 #import <UIKit/UIKit.h>
 #import "UBKAccessibilityConstants.h"
 
-@class UBKAccessibilitySection;
+@class UBKAccessibilitySection, UBKAccessibilityProperty, UBKAccessibilityTextRuns, UBKAccessibilityControlStates;
 
 typedef enum : NSUInteger {
     ColourContrastRatingNA,
@@ -50,10 +50,25 @@ typedef enum : NSUInteger {
 + (ColourContrastRating)getColourContrastRatingForText:(CGFloat)contrast withTextSize:(double)textSize withBoldFont:(BOOL)boldFont;
 
 + (CGFloat)getViewContrastRatio:(UIColor *)foregroundColour backgroundColor:(UIColor *)backgroundColour;
+//Background seen behind the view's content with translucent backgrounds and view alpha composited, from the current snapshot when the view is in it.
++ (UIColor *)getEffectiveBackgroundColour:(UIView *)view;
+//Foreground seen over backgroundColour once its own alpha and the opacity of the view and its superviews are composited, eg 50% black text reads as grey. Opaque colours on opaque views are returned as is.
++ (UIColor *)getEffectiveForegroundColour:(UIColor *)foregroundColour forView:(UIView *)view backgroundColour:(UIColor *)backgroundColour;
+//Opacity the view's content is drawn with, its alpha multiplied by the alpha of its superviews, from the current snapshot when the view is in it.
++ (float)getEffectiveOpacity:(UIView *)view;
+//Contrast of the view in the light, dark and increased contrast appearances from the last refresh, empty when it wasn't rated.
++ (NSArray<UBKAccessibilityProperty *> *)getAppearanceContrastProperties:(UIView *)view;
+
+//Colour vision deficiency warnings, only returned when the colours pass for typical colour vision.
++ (NSArray *)checkColourVisionWarningsForText:(UIColor *)foregroundColour backgroundColor:(UIColor *)backgroundColour withTextSize:(double)textSize withBoldFont:(BOOL)boldFont;
++ (NSArray *)checkColourVisionWarningsForNonText:(UIColor *)foregroundColour backgroundColor:(UIColor *)backgroundColour;
 
 //Check if has minimum size warning
 + (BOOL)hasMinimumSizeWarning:(UIView *)view;
 
+//Check if the touch target overlaps or crowds another target on screen, uses the results of the last refresh.
++ (BOOL)hasTargetSpacingWarning:(UIView *)view;
+
 //Check if has accessibility trait warning
 + (BOOL)hasAccessibilityTraitWarning:(UIView *)view;
 
@@ -77,16 +92,16 @@ typedef enum : NSUInteger {
 + (NSArray *)checkBaseAccessibilityWarnings:(UIView *)view;
 
 //UIButton Validation
-//Check if the button has a warning
-+ (NSArray *)checkAccessibilityWarningForButton:(UIButton *)button withContrast:(double)contrast;
+//Check if the button has a warning, controlStates rates the title in the states the button isn't in
++ (NSArray *)checkAccessibilityWarningForButton:(UIButton *)button withTextRuns:(UBKAccessibilityTextRuns *)textRuns withControlStates:(UBKAccessibilityControlStates *)controlStates;
 
 //UILabel Validation
-//Check if the label has a warning
-+ (NSArray *)checkAccessibilityWarningForLabel:(UILabel *)label withContrast:(double)contrast;
+//Check if the label has a warning, the contrast warning is for the worst run of its text
++ (NSArray *)checkAccessibilityWarningForLabel:(UILabel *)label withTextRuns:(UBKAccessibilityTextRuns *)textRuns;
 
 //UISwitch Validation
 //Check if the switch has a warning
-+ (NSArray *)checkAccessibilityWarningForSwitch:(UISwitch *)switchObject;
++ (NSArray *)checkAccessibilityWarningForSwitch:(UISwitch *)switchObject withControlStates:(UBKAccessibilityControlStates *)controlStates;
 
 //ImageView Validation
 //Check if an image label has not been set, accessibility is using the default image name and if the contrast on a template image is set correctly.
@@ -94,15 +109,15 @@ typedef enum : NSUInteger {
 
 //UITextfield Validation
 //Check if the textfield has a warning
-+ (NSArray *)checkAccessibilityWarningForTextfield:(UITextField *)textfield withContrast:(double)contrast;
++ (NSArray *)checkAccessibilityWarningForTextfield:(UITextField *)textfield withTextRuns:(UBKAccessibilityTextRuns *)textRuns;
 
 //UITextView
 //Check if the textview has a warning
-+ (NSArray *)checkAccessibilityWarningForTextView:(UITextView *)textView withContrast:(double)contrast;
++ (NSArray *)checkAccessibilityWarningForTextView:(UITextView *)textView withTextRuns:(UBKAccessibilityTextRuns *)textRuns;
 
 //UISlider
-//Check if the textview has a warning
-+ (NSArray *)checkAccessibilityWarningForSlider:(UISlider *)slider;
+//Check if the slider has a warning
++ (NSArray *)checkAccessibilityWarningForSlider:(UISlider *)slider withControlStates:(UBKAccessibilityControlStates *)controlStates;
 
 //Get the warning level for a warning type
 + (UBKAccessibilityWarningLevel)getWarningLevelForWarningType:(UBKAccessibilityWarningType)warningType;
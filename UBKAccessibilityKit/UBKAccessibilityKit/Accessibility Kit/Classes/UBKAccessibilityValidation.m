@@ -26,9 +26,16 @@
 #import "UBKAccessibilitySection.h"
 #import "UBKAccessibilityProperty.h"
 #import "UBKAccessibilityManager.h"
-
-NSInteger const ColourContrastAARating = 3.5;
-NSInteger const ColourContrastAAARating = 3.5;
+#import "UBKAccessibilityColourVision.h"
+#import "UBKAccessibilityTargetSpacing.h"
+#import "UBKAccessibilityControlStates.h"
+#import "UBKAccessibilityReadingOrder.h"
+#import "UBKAccessibilityLabels.h"
+#import "UBKAccessibilityAppearances.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityScreenPasses.h"
+#import "UBKAccessibilityTextRuns.h"
+#import "UIView+HelperMethods.h"
 
 @implementation UBKAccessibilityValidation
 
@@ -41,18 +48,51 @@ NSInteger const ColourContrastAAARating = 3.5;
 
 + (BOOL)hasMinimumSizeWarning:(UIView *)view
 {
-    if (((view.frame.size.width < 44) || (view.frame.size.height < 44)) && view.userInteractionEnabled == true)
+    const UBKRuleEvaluator *evaluator = [UBKAccessibilityManager sharedInstance].ruleEvaluator;
+    if (UBKRuleEvaluatorIsBelowMinimumTargetSize(evaluator, view.frame.size.width, view.frame.size.height) && view.userInteractionEnabled == true)
     {
         return true;
     }
     return false;
 }
 
++ (BOOL)hasTargetSpacingWarning:(UIView *)view
+{
+    return [[UBKAccessibilityScreenPasses auditedPasses].targetSpacing flagsForView:view] != 0;
+}
+
++ (BOOL)hasReadingOrderWarning:(UIView *)view
+{
+    return [[UBKAccessibilityScreenPasses auditedPasses].readingOrder isViewOutOfOrder:view];
+}
+
++ (BOOL)hasDuplicateLabelWarning:(UIView *)view
+{
+    return ([[UBKAccessibilityScreenPasses auditedPasses].labels flagsForView:view] & UBKLabelFlagDuplicate) != 0;
+}
+
++ (BOOL)hasLabelEchoesNameWarning:(UIView *)view
+{
+    return ([[UBKAccessibilityScreenPasses auditedPasses].labels flagsForView:view] & UBKLabelFlagEchoesName) != 0;
+}
+
++ (BOOL)hasAppearanceContrastWarning:(UIView *)view
+{
+    return [[UBKAccessibilityScreenPasses auditedPasses].appearances hasWarningForView:view];
+}
+
++ (NSArray<UBKAccessibilityProperty *> *)getAppearanceContrastProperties:(UIView *)view
+{
+    UBKAccessibilityAppearances *appearances = [UBKAccessibilityScreenPasses auditedPasses].appearances;
+    return appearances ? [appearances contrastPropertiesForView:view] : @[];
+}
+
 + (NSString *)getMinimumSizeWarningTitle:(UIView *)view
 {
     if ([UBKAccessibilityValidation hasMinimumSizeWarning:view])
     {
-        return @"Less than 44 x 44";
+        double minimumSize = [UBKAccessibilityManager sharedInstance].ruleEvaluator->thresholds.minimumTargetSize;
+        return [NSString stringWithFormat:@"Less than %g x %g", minimumSize, minimumSize];
     }
     return @"No";
 }
@@ -131,7 +171,7 @@ NSInteger const ColourContrastAAARating = 3.5;
         {
             for (UBKAccessibilityProperty *property in [UBKAccessibilityManager sharedInstance].accessibilityColours.defaultColoursArray)
             {
-                if (property.displayColour == colour)
+                if ([property.displayColour ubk_isEqualToColour:colour])
                 {
                     return false;
                 }
@@ -202,6 +242,56 @@ NSInteger const ColourContrastAAARating = 3.5;
             warningTitle = kUBKAccessibilityAttributeTitle_Warning_MinimumSize;
             break;
         }
+        case UBKAccessibilityWarningTypeColourVisionProtanopia:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_Warning_Protanopia;
+            break;
+        }
+        case UBKAccessibilityWarningTypeColourVisionDeuteranopia:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_Warning_Deuteranopia;
+            break;
+        }
+        case UBKAccessibilityWarningTypeColourVisionTritanopia:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_Warning_Tritanopia;
+            break;
+        }
+        case UBKAccessibilityWarningTypeColourVisionAchromatopsia:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_Warning_Achromatopsia;
+            break;
+        }
+        case UBKAccessibilityWarningTypeTargetSpacing:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_Warning_TargetSpacing;
+            break;
+        }
+        case UBKAccessibilityWarningTypeReadingOrder:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_Warning_ReadingOrder;
+            break;
+        }
+        case UBKAccessibilityWarningTypeDuplicateLabel:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_Warning_DuplicateLabel;
+            break;
+        }
+        case UBKAccessibilityWarningTypeLabelEchoesName:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_Warning_LabelEchoesName;
+            break;
+        }
+        case UBKAccessibilityWarningTypeStateColourContrast:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_Warning_StateColourContrast;
+            break;
+        }
+        case UBKAccessibilityWarningTypeAppearanceContrast:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_Warning_AppearanceContrast;
+            break;
+        }
     }
     return warningTitle;
 }
@@ -266,6 +356,28 @@ NSInteger const ColourContrastAAARating = 3.5;
             warningLevel = UBKAccessibilityWarningLevelHigh;
             break;
         }
+        case UBKAccessibilityWarningTypeStateColourContrast:
+        case UBKAccessibilityWarningTypeAppearanceContrast:
+        {
+            warningLevel = UBKAccessibilityWarningLevelHigh;
+            break;
+        }
+        case UBKAccessibilityWarningTypeColourVisionProtanopia:
+        case UBKAccessibilityWarningTypeColourVisionDeuteranopia:
+        case UBKAccessibilityWarningTypeTargetSpacing:
+        case UBKAccessibilityWarningTypeReadingOrder:
+        case UBKAccessibilityWarningTypeDuplicateLabel:
+        case UBKAccessibilityWarningTypeLabelEchoesName:
+        {
+            warningLevel = UBKAccessibilityWarningLevelMedium;
+            break;
+        }
+        case UBKAccessibilityWarningTypeColourVisionTritanopia:
+        case UBKAccessibilityWarningTypeColourVisionAchromatopsia:
+        {
+            warningLevel = UBKAccessibilityWarningLevelLow;
+            break;
+        }
     }
     return warningLevel;
 }
@@ -308,19 +420,37 @@ NSInteger const ColourContrastAAARating = 3.5;
     {
         [warningsArray addObject:@(UBKAccessibilityWarningTypeDisabled)];
     }
+    if ([UBKAccessibilityValidation hasTargetSpacingWarning:view])
+    {
+        [warningsArray addObject:@(UBKAccessibilityWarningTypeTargetSpacing)];
+    }
+    if ([UBKAccessibilityValidation hasReadingOrderWarning:view])
+    {
+        [warningsArray addObject:@(UBKAccessibilityWarningTypeReadingOrder)];
+    }
+    if ([UBKAccessibilityValidation hasDuplicateLabelWarning:view])
+    {
+        [warningsArray addObject:@(UBKAccessibilityWarningTypeDuplicateLabel)];
+    }
+    if ([UBKAccessibilityValidation hasLabelEchoesNameWarning:view])
+    {
+        [warningsArray addObject:@(UBKAccessibilityWarningTypeLabelEchoesName)];
+    }
+    if ([UBKAccessibilityValidation hasAppearanceContrastWarning:view])
+    {
+        [warningsArray addObject:@(UBKAccessibilityWarningTypeAppearanceContrast)];
+    }
     return warningsArray;
 }
 
 #pragma mark - UILabel Validation
 
-+ (NSArray *)checkAccessibilityWarningForLabel:(UILabel *)label withContrast:(double)contrast
++ (NSArray *)checkAccessibilityWarningForLabel:(UILabel *)label withTextRuns:(UBKAccessibilityTextRuns *)textRuns
 {
     NSMutableArray *warningsArray = [[NSMutableArray alloc]initWithArray:[self checkBaseAccessibilityWarnings:label]];
-    double textSize = label.font.pointSize;
-    BOOL boldFont = [label.font ubk_isFontBold];
     UIColor *colour = label.textColor;
 
-    if ([UBKAccessibilityValidation getColourContrastRatingForText:contrast withTextSize:textSize withBoldFont:boldFont] == ColourContrastRatingFail)
+    if (textRuns.worstRating == ColourContrastRatingFail)
     {
         [warningsArray addObject:@(UBKAccessibilityWarningTypeColourContrast)];
     }
@@ -337,7 +467,7 @@ NSInteger const ColourContrastAAARating = 3.5;
 
 #pragma mark - UIButton Validation
 
-+ (NSArray *)checkAccessibilityWarningForButton:(UIButton *)button withContrast:(double)contrast
++ (NSArray *)checkAccessibilityWarningForButton:(UIButton *)button withTextRuns:(UBKAccessibilityTextRuns *)textRuns withControlStates:(UBKAccessibilityControlStates *)controlStates
 {
     NSMutableArray *warningsArray = [[NSMutableArray alloc]initWithArray:[self checkBaseAccessibilityWarnings:button]];
     UIColor *colour = button.titleLabel.textColor;
@@ -348,10 +478,7 @@ NSInteger const ColourContrastAAARating = 3.5;
     }
     if (button.titleLabel.text.length > 0)
     {
-        double textSize = button.titleLabel.font.pointSize;
-        BOOL boldFont = [button.titleLabel.font ubk_isFontBold];
-
-        if ([UBKAccessibilityValidation getColourContrastRatingForText:contrast withTextSize:textSize withBoldFont:boldFont] == ColourContrastRatingFail)
+        if (textRuns.worstRating == ColourContrastRatingFail)
         {
             [warningsArray addObject:@(UBKAccessibilityWarningTypeColourContrast)];
         }
@@ -360,6 +487,10 @@ NSInteger const ColourContrastAAARating = 3.5;
             [warningsArray addObject:@(UBKAccessibilityWarningTypeDynamicTextSize)];
         }
     }
+    if (controlStates.failingCount > 0)
+    {
+        [warningsArray addObject:@(UBKAccessibilityWarningTypeStateColourContrast)];
+    }
     if ([UBKAccessibilityValidation hasColourMatchWarning:colour])
     {
         [warningsArray addObject:@(UBKAccessibilityWarningTypeWrongColour)];
@@ -369,9 +500,13 @@ NSInteger const ColourContrastAAARating = 3.5;
 
 #pragma mark - UISwitch Validation
 
-+ (NSArray *)checkAccessibilityWarningForSwitch:(UISwitch *)switchObject
++ (NSArray *)checkAccessibilityWarningForSwitch:(UISwitch *)switchObject withControlStates:(UBKAccessibilityControlStates *)controlStates
 {
     NSMutableArray *warningsArray = [[NSMutableArray alloc]initWithArray:[self checkBaseAccessibilityWarnings:switchObject]];
+    if (controlStates.failingCount > 0)
+    {
+        [warningsArray addObject:@(UBKAccessibilityWarningTypeStateColourContrast)];
+    }
 
     if (switchObject.isAccessibilityElement)
     {
@@ -416,18 +551,16 @@ NSInteger const ColourContrastAAARating = 3.5;
 
 #pragma mark - UITextfield Validation
 
-+ (NSArray *)checkAccessibilityWarningForTextfield:(UITextField *)textfield withContrast:(double)contrast
++ (NSArray *)checkAccessibilityWarningForTextfield:(UITextField *)textfield withTextRuns:(UBKAccessibilityTextRuns *)textRuns
 {
     NSMutableArray *warningsArray = [[NSMutableArray alloc]initWithArray:[self checkBaseAccessibilityWarnings:textfield]];
-    double textSize = textfield.font.pointSize;
-    BOOL boldFont = [textfield.font ubk_isFontBold];
     UIColor *colour = textfield.textColor;
 
     if ([UBKAccessibilityValidation hasMinimumSizeWarning:textfield])
     {
         [warningsArray addObject:@(UBKAccessibilityWarningTypeMinimumSize)];
     }
-    if ([UBKAccessibilityValidation getColourContrastRatingForText:contrast withTextSize:textSize withBoldFont:boldFont] == ColourContrastRatingFail)
+    if (textRuns.worstRating == ColourContrastRatingFail)
     {
         [warningsArray addObject:@(UBKAccessibilityWarningTypeColourContrast)];
     }
@@ -444,18 +577,16 @@ NSInteger const ColourContrastAAARating = 3.5;
 
 #pragma mark - UITextView Validation
 
-+ (NSArray *)checkAccessibilityWarningForTextView:(UITextView *)textView withContrast:(double)contrast
++ (NSArray *)checkAccessibilityWarningForTextView:(UITextView *)textView withTextRuns:(UBKAccessibilityTextRuns *)textRuns
 {
     NSMutableArray *warningsArray = [[NSMutableArray alloc]initWithArray:[self checkBaseAccessibilityWarnings:textView]];
-    double textSize = textView.font.pointSize;
-    BOOL boldFont = [textView.font ubk_isFontBold];
     UIColor *colour = textView.textColor;
 
     if ([UBKAccessibilityValidation hasMinimumSizeWarning:textView])
     {
         [warningsArray addObject:@(UBKAccessibilityWarningTypeMinimumSize)];
     }
-    if ([UBKAccessibilityValidation getColourContrastRatingForText:contrast withTextSize:textSize withBoldFont:boldFont] == ColourContrastRatingFail)
+    if (textRuns.worstRating == ColourContrastRatingFail)
     {
         [warningsArray addObject:@(UBKAccessibilityWarningTypeColourContrast)];
     }
@@ -472,9 +603,13 @@ NSInteger const ColourContrastAAARating = 3.5;
 
 #pragma mark - UISlider Validation
 
-+ (NSArray *)checkAccessibilityWarningForSlider:(UISlider *)slider
++ (NSArray *)checkAccessibilityWarningForSlider:(UISlider *)slider withControlStates:(UBKAccessibilityControlStates *)controlStates
 {
     NSMutableArray *warningsArray = [[NSMutableArray alloc]initWithArray:[self checkBaseAccessibilityWarnings:slider]];
+    if (controlStates.failingCount > 0)
+    {
+        [warningsArray addObject:@(UBKAccessibilityWarningTypeStateColourContrast)];
+    }
     
     if (slider.isAccessibilityElement)
     {
@@ -535,15 +670,7 @@ NSInteger const ColourContrastAAARating = 3.5;
 
 + (ColourContrastRating)getColourContrastRatingForNonText:(CGFloat)contrast
 {
-    if (contrast >= 4.5)
-    {
-        return ColourContrastRatingAAA;
-    }
-    else if (contrast >= 3.0)
-    {
-        return ColourContrastRatingAA;
-    }
-    return ColourContrastRatingFail; // <= 2.9
+    return (ColourContrastRating)UBKRuleEvaluatorNonTextContrastRating([UBKAccessibilityManager sharedInstance].ruleEvaluator, contrast);
 }
 
 + (NSString *)getTitleColourContrastRatingForText:(CGFloat)contrast withTextSize:(double)textSize withBoldFont:(BOOL)boldFont
@@ -554,45 +681,103 @@ NSInteger const ColourContrastAAARating = 3.5;
 
 + (ColourContrastRating)getColourContrastRatingForText:(CGFloat)contrast withTextSize:(double)textSize withBoldFont:(BOOL)boldFont
 {
-    //Large text has a differet ratio to smaller text
+    //Large text has a differet ratio to smaller text, thresholds come from the selected rule profile
     //https://www.w3.org/TR/WCAG20-TECHS/G18.html
-    if (contrast == 0 && textSize == 0)
+    return (ColourContrastRating)UBKRuleEvaluatorTextContrastRating([UBKAccessibilityManager sharedInstance].ruleEvaluator, contrast, textSize, boldFont);
+}
+
++ (CGFloat)getViewContrastRatio:(UIColor *)foregroundColour backgroundColor:(UIColor *)backgroundColour
+{
+    //Missing colours and colours without components, eg patterns, have no contrast ratio
+    UBKColourValue foregroundValue = foregroundColour.ubk_colourValue;
+    UBKColourValue backgroundValue = backgroundColour.ubk_colourValue;
+    if ((!foregroundValue.hasComponents) || (!backgroundValue.hasComponents))
     {
-        return ColourContrastRatingNA;
+        return 0;
     }
-    if (((textSize >= 18.66) && (boldFont)) || (textSize >= 24))
+    return UBKColourValueContrastRatio(foregroundValue, backgroundValue);
+}
+
++ (UIColor *)getEffectiveBackgroundColour:(UIView *)view
+{
+    UBKAccessibilitySnapshot *snapshot = [UBKAccessibilityScreenPasses auditedPasses].snapshot;
+    NSInteger index = snapshot ? [snapshot indexOfView:view] : NSNotFound;
+    if (index != NSNotFound)
     {
-        if (contrast >= 4.5)
-        {
-            return ColourContrastRatingAAALarge;
-        }
-        else if (contrast >= 3.0)
-        {
-            return ColourContrastRatingAALarge;
-        }
+        return [UIColor ubk_colourWithColourValue:[snapshot backgroundColourValueAtIndex:index]];
+    }
+    return [view ubk_findBackgroundColour:view];
+}
+
++ (UIColor *)getEffectiveForegroundColour:(UIColor *)foregroundColour forView:(UIView *)view backgroundColour:(UIColor *)backgroundColour
+{
+    UBKColourValue foregroundValue = foregroundColour.ubk_colourValue;
+    if (!foregroundValue.hasComponents)
+    {
+        return foregroundColour;
     }
-    else
+    float opacity = [self getEffectiveOpacity:view];
+    if ((foregroundValue.linear[3] * opacity) >= 1)
     {
-        if (contrast >= 7.0)
-        {
-            return ColourContrastRatingAAA;
-        }
-        else if (contrast >= 4.5)
-        {
-            return ColourContrastRatingAA;
-        }
+        return foregroundColour;
     }
-    return ColourContrastRatingFail;
+    return [UIColor ubk_colourWithColourValue:UBKColourValueComposite(foregroundValue, opacity, backgroundColour.ubk_colourValue)];
 }
 
-+ (CGFloat)getViewContrastRatio:(UIColor *)foregroundColour backgroundColor:(UIColor *)backgroundColour
++ (float)getEffectiveOpacity:(UIView *)view
+{
+    UBKAccessibilitySnapshot *snapshot = [UBKAccessibilityScreenPasses auditedPasses].snapshot;
+    NSInteger index = snapshot ? [snapshot indexOfView:view] : NSNotFound;
+    return (index != NSNotFound) ? [snapshot opacityAtIndex:index] : (float)view.ubk_cumulativeAlpha;
+}
+
+#pragma mark - Colour Vision Validation Methods
+
++ (NSArray *)checkColourVisionWarningsForText:(UIColor *)foregroundColour backgroundColor:(UIColor *)backgroundColour withTextSize:(double)textSize withBoldFont:(BOOL)boldFont
+{
+    return [self checkColourVisionWarnings:foregroundColour backgroundColor:backgroundColour withRating:^ColourContrastRating(double contrast) {
+        return [UBKAccessibilityValidation getColourContrastRatingForText:contrast withTextSize:textSize withBoldFont:boldFont];
+    }];
+}
+
++ (NSArray *)checkColourVisionWarningsForNonText:(UIColor *)foregroundColour backgroundColor:(UIColor *)backgroundColour
 {
-    CGFloat contrast = 0;
-    if ((foregroundColour) && (backgroundColour))
+    return [self checkColourVisionWarnings:foregroundColour backgroundColor:backgroundColour withRating:^ColourContrastRating(double contrast) {
+        return [UBKAccessibilityValidation getColourContrastRatingForNonText:contrast];
+    }];
+}
+
++ (NSArray *)checkColourVisionWarnings:(UIColor *)foregroundColour backgroundColor:(UIColor *)backgroundColour withRating:(ColourContrastRating (^)(double contrast))rating
+{
+    NSMutableArray *warningsArray = [[NSMutableArray alloc]init];
+    if ((!foregroundColour) || (!backgroundColour))
     {
-        contrast = [foregroundColour ubk_contrastRatio:backgroundColour];
+        return warningsArray;
     }
-    return contrast;
+    
+    //Already reported as a colour contrast warning. Uses the same full precision ratio as the contrast warning so the two always agree.
+    if (rating([self getViewContrastRatio:foregroundColour backgroundColor:backgroundColour]) == ColourContrastRatingFail)
+    {
+        return warningsArray;
+    }
+    
+    //The screen's pairs were all simulated in one pass before the audit
+    UBKAccessibilityColourVision *colourVision = [UBKAccessibilityScreenPasses auditedPasses].colourVision;
+    NSUInteger pairIndex = colourVision ? [colourVision indexOfPairWithForegroundColour:foregroundColour backgroundColour:backgroundColour] : NSNotFound;
+    if (pairIndex == NSNotFound)
+    {
+        //Colours the pass doesn't see, eg the worst run of attributed text or a colour just changed in the colour picker
+        colourVision = [[UBKAccessibilityColourVision alloc]initWithForegroundColours:@[foregroundColour] backgroundColours:@[backgroundColour]];
+        pairIndex = 0;
+    }
+    for (UBKColourVisionDeficiency deficiency = UBKColourVisionProtanopia; deficiency < UBKColourVisionDeficiencyCount; deficiency++)
+    {
+        if (rating([colourVision contrastRatioForPairAtIndex:pairIndex deficiency:deficiency]) == ColourContrastRatingFail)
+        {
+            [warningsArray addObject:@([UBKAccessibilityColourVision warningTypeForDeficiency:deficiency])];
+        }
+    }
+    return warningsArray;
 }
 
 @end
@@ -0,0 +1,54 @@
+/*
+ File: UBKAccessibilityVisibility.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "UBKVisibility.h"
+
+@class UBKAccessibilitySnapshot;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//Screen level visibility pass for a snapshot, see UBKVisibility.h. Elements that are hidden, empty, clipped or fully covered are culled so the rules don't run on them.
+@interface UBKAccessibilityVisibility : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+//bounds is the visible area in window space, usually the window bounds.
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot bounds:(CGRect)bounds;
+
+@property (nonatomic, readonly) NSUInteger culledCount;
+
+//UBKVisibilityStateVisible for views that aren't in the snapshot
+- (UBKVisibilityState)stateForView:(UIView *)view;
+
+//Visible area left after clipping and occlusion, 0 for views that aren't in the snapshot
+- (CGFloat)visibleAreaForView:(UIView *)view;
+
+//True for elements that aren't visible
+- (BOOL)isViewCulled:(UIView *)view;
+
+//Removes UBKSnapshotNodeFlagElement from culled nodes and folds the state into their hashes. Run before the other screen level passes so they skip the culled elements. Call updateSubtreeHashes on the snapshot after.
+- (void)cullSnapshot;
+
+@end
+
+NS_ASSUME_NONNULL_END
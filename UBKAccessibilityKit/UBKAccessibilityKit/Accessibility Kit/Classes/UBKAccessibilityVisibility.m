@@ -0,0 +1,127 @@
+/*
+ File: UBKAccessibilityVisibility.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import "UBKAccessibilityVisibility.h"
+#import "UBKAccessibilitySnapshot.h"
+#import "UBKAccessibilityScanArena.h"
+
+@interface UBKAccessibilityVisibility ()
+@property (nonatomic) UBKAccessibilitySnapshot *snapshot;
+@property (nonatomic, readwrite) NSUInteger culledCount;
+//Result for each snapshot node, NULL when the analysis failed
+@property (nonatomic) const UBKVisibilityResult *results;
+//BOOL for each snapshot node, kept apart from the element flag which cullSnapshot clears
+@property (nonatomic) const BOOL *culledNodes;
+@end
+
+@implementation UBKAccessibilityVisibility
+
+- (instancetype)initWithSnapshot:(UBKAccessibilitySnapshot *)snapshot bounds:(CGRect)bounds
+{
+    if (self = [super init])
+    {
+        self.snapshot = snapshot;
+        [self analyseSnapshotWithBounds:bounds];
+    }
+    return self;
+}
+
+- (void)analyseSnapshotWithBounds:(CGRect)bounds
+{
+    const UBKSnapshotNode *nodes = self.snapshot.nodes;
+    NSUInteger nodeCount = self.snapshot.nodeCount;
+    UBKVisibilityResult *results = [self.snapshot.scanArena allocateCount:nodeCount size:sizeof(UBKVisibilityResult)];
+    BOOL *culled = [self.snapshot.scanArena allocateCount:nodeCount size:sizeof(BOOL)];
+    if ((results == NULL) || (culled == NULL))
+    {
+        return;
+    }
+    
+    UBKRect visibleBounds = { bounds.origin.x, bounds.origin.y, bounds.size.width, bounds.size.height };
+    if (UBKVisibilityAnalyse(nodes, nodeCount, visibleBounds, results))
+    {
+        for (NSUInteger i = 0; i < nodeCount; i++)
+        {
+            culled[i] = (nodes[i].flags & UBKSnapshotNodeFlagElement) && (results[i].state != UBKVisibilityStateVisible);
+            if (culled[i])
+            {
+                self.culledCount++;
+            }
+        }
+    }
+    else
+    {
+        //Nothing gets culled
+        results = NULL;
+    }
+    self.results = results;
+    self.culledNodes = culled;
+}
+
+- (const UBKVisibilityResult *)resultForView:(UIView *)view
+{
+    NSInteger index = [self.snapshot indexOfView:view];
+    if ((index == NSNotFound) || (self.results == NULL))
+    {
+        return NULL;
+    }
+    return &self.results[index];
+}
+
+- (UBKVisibilityState)stateForView:(UIView *)view
+{
+    const UBKVisibilityResult *result = [self resultForView:view];
+    return result ? result->state : UBKVisibilityStateVisible;
+}
+
+- (CGFloat)visibleAreaForView:(UIView *)view
+{
+    const UBKVisibilityResult *result = [self resultForView:view];
+    return result ? result->visibleArea : 0;
+}
+
+- (BOOL)isViewCulled:(UIView *)view
+{
+    NSInteger index = [self.snapshot indexOfView:view];
+    if ((index == NSNotFound) || (self.culledNodes == NULL))
+    {
+        return false;
+    }
+    return self.culledNodes[index];
+}
+
+- (void)cullSnapshot
+{
+    const UBKVisibilityResult *results = self.results;
+    const BOOL *culled = self.culledNodes;
+    for (NSUInteger i = 0; (results != NULL) && (i < self.snapshot.nodeCount); i++)
+    {
+        if (culled[i])
+        {
+            //Shifted so the hash tells it apart from the other screen level results
+            [self.snapshot combineHash:((uint64_t)results[i].state << 48) intoNodeAtIndex:i];
+            [self.snapshot clearFlags:UBKSnapshotNodeFlagElement fromNodeAtIndex:i];
+        }
+    }
+}
+
+@end
@@ -0,0 +1,111 @@
+/*
+ File: UBKColourTokensBenchmark.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKColourTokens.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define UBKBenchmarkTokensPerTheme 50000
+#define UBKBenchmarkRuns 10
+
+//Light and dark themes of random colours in the W3C design tokens format, about 9.5MB
+static bool writeTokens(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        return false;
+    }
+    srand(1);
+    const char *themes[2] = { "light", "dark" };
+    fputs("{\"color\": {", file);
+    for (int theme = 0; theme < 2; theme++)
+    {
+        fprintf(file, "%s\"%s\": {", (theme == 0) ? "" : ", ", themes[theme]);
+        for (int i = 0; i < UBKBenchmarkTokensPerTheme; i++)
+        {
+            unsigned colour = (((unsigned)rand() << 8) ^ (unsigned)rand()) & 0xFFFFFF;
+            fprintf(file, "%s\"token%d\": {\"$value\": \"#%06X\", \"$type\": \"color\", \"$description\": \"Generated token %d\"}", (i == 0) ? "" : ", ", i, colour, i);
+        }
+        fputs("}", file);
+    }
+    fputs("}}", file);
+    return fclose(file) == 0;
+}
+
+static double secondsSince(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+//Pass a token file to time it instead of the generated one
+int main(int argc, char **argv)
+{
+    char generatedPath[256];
+    const char *path = (argc > 1) ? argv[1] : NULL;
+    if (path == NULL)
+    {
+        const char *directory = getenv("TMPDIR");
+        snprintf(generatedPath, sizeof(generatedPath), "%s/UBKColourTokensBenchmark-%ld.json", ((directory != NULL) && (directory[0] != '\0')) ? directory : "/tmp", (long)getpid());
+        if (!writeTokens(generatedPath))
+        {
+            fprintf(stderr, "Couldn't write %s\n", generatedPath);
+            return EXIT_FAILURE;
+        }
+        path = generatedPath;
+    }
+
+    double best = 0;
+    UBKColourTokens tokens;
+    for (int run = 0; run < UBKBenchmarkRuns; run++)
+    {
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        UBKColourTokensInit(&tokens);
+        bool parsed = UBKColourTokensParseFile(&tokens, path);
+        double seconds = secondsSince(&start);
+        if (!parsed)
+        {
+            fprintf(stderr, "Couldn't parse %s\n", path);
+            UBKColourTokensDestroy(&tokens);
+            return EXIT_FAILURE;
+        }
+        if ((run == 0) || (seconds < best))
+        {
+            best = seconds;
+        }
+        if (run == UBKBenchmarkRuns - 1)
+        {
+            printf("%llu tokens, %u unique colours, best of %d imports %.2f ms\n", (unsigned long long)tokens.tokenCount, tokens.count, UBKBenchmarkRuns, best * 1000);
+        }
+        UBKColourTokensDestroy(&tokens);
+    }
+    if (path == generatedPath)
+    {
+        unlink(generatedPath);
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ File: UBKArenaTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKArena.h"
+#include "UBKSnapshot.h"
+#include "UBKCoreTests.h"
+
+#include <stdint.h>
+#include <string.h>
+
+static void testScansReuseTheArenaBlocks(void)
+{
+    UBKArena arena;
+    UBKArenaInit(&arena, 1024);
+    for (int scan = 0; scan < 5; scan++)
+    {
+        uint64_t systemAllocations = arena.stats.systemAllocations;
+        UBKSnapshot snapshot;
+        UBKSnapshotInitWithArena(&snapshot, &arena);
+        for (uint32_t index = 0; index < 3000; index++)
+        {
+            UBKSnapshotNode node = {0};
+            node.classHash = index;
+            UBKTestAssert(UBKSnapshotPushNode(&snapshot, &node) >= 0);
+            uint32_t *values = UBKArenaAllocateArray(&arena, 3, sizeof(uint32_t));
+            UBKTestAssert((values != NULL) && (((uintptr_t)values % 16) == 0));
+            UBKTestAssert((values[0] == 0) && (values[2] == 0));
+            values[0] = 7;
+            UBKSnapshotPopNode(&snapshot);
+        }
+        for (uint32_t index = 0; index < 3000; index++)
+        {
+            UBKTestAssert(snapshot.nodes[index].classHash == index);
+        }
+
+        //The last allocation grows in place and the new bytes are zeroed
+        unsigned char *bytes = UBKArenaAllocate(&arena, 10);
+        memset(bytes, 1, 10);
+        unsigned char *resized = UBKArenaResize(&arena, bytes, 10, 100);
+        UBKTestAssert((resized == bytes) && (resized[9] == 1) && (resized[10] == 0) && (resized[99] == 0));
+        UBKSnapshotDestroy(&snapshot);
+
+        //Once the blocks have grown to fit a scan, later scans don't allocate
+        if (scan >= 2)
+        {
+            UBKTestAssert(arena.stats.systemAllocations == systemAllocations);
+        }
+        UBKArenaReset(&arena);
+    }
+    UBKArenaDestroy(&arena);
+}
+
+static void testOverflowingSizesFail(void)
+{
+    UBKArena arena;
+    UBKArenaInit(&arena, 1024);
+    UBKTestAssert(UBKArenaAllocateArray(&arena, SIZE_MAX / 2, 4) == NULL);
+    UBKTestAssert(UBKArenaAllocate(&arena, SIZE_MAX - 4) == NULL);
+    UBKArenaDestroy(&arena);
+}
+
+static void testSnapshotWithoutArena(void)
+{
+    UBKSnapshot snapshot;
+    UBKSnapshotInit(&snapshot);
+    UBKSnapshotNode node = {0};
+    UBKTestAssert(UBKSnapshotPushNode(&snapshot, &node) == 0);
+    UBKSnapshotPopNode(&snapshot);
+    UBKSnapshotDestroy(&snapshot);
+}
+
+int main(void)
+{
+    testScansReuseTheArenaBlocks();
+    testOverflowingSizesFail();
+    testSnapshotWithoutArena();
+    return 0;
+}
@@ -0,0 +1,230 @@
+/*
+ File: UBKAuditDiffTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKAuditDiff.h"
+#include "UBKCoreTests.h"
+
+#include <math.h>
+#include <string.h>
+
+static UBKAuditRecord makeRecord(uint64_t screen, uint64_t element, float y, uint64_t warningMask)
+{
+    UBKAuditRecord record;
+    memset(&record, 0, sizeof(record));
+    record.screen = screen;
+    record.element = element;
+    record.y = y;
+    record.width = 10;
+    record.height = 10;
+    record.warningMask = warningMask;
+    return record;
+}
+
+//Some records are screen markers
+static UBKAuditRecord makeRandomRecord(uint64_t screen)
+{
+    if (rand() % 8 == 0)
+    {
+        return makeRecord(screen, 0, 0, 0);
+    }
+    return makeRecord(screen, rand() % 5, (rand() % 4) * 10, 1 + rand() % 7);
+}
+
+static bool hasScreen(const UBKAuditRecord *records, size_t count, uint64_t screen)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (records[i].screen == screen)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//Pairs each head record with the nearest unpaired base record the slow way and checks the entries come out the same
+static void testMatchesPairwiseComparison(void)
+{
+    srand(5);
+    for (int round = 0; round < 300; round++)
+    {
+        size_t baseCount = rand() % 200;
+        size_t headCount = rand() % 200;
+        UBKAuditRecord *base = malloc((baseCount + 1) * sizeof(UBKAuditRecord));
+        UBKAuditRecord *head = malloc((headCount + 1) * sizeof(UBKAuditRecord));
+        for (size_t i = 0; i < baseCount; i++)
+        {
+            base[i] = makeRandomRecord(rand() % 6);
+        }
+        for (size_t i = 0; i < headCount; i++)
+        {
+            head[i] = makeRandomRecord(1 + rand() % 6);
+        }
+        UBKAuditDiff diff;
+        UBKAuditDiffInit(&diff);
+        UBKTestAssert(UBKAuditDiffCompute(&diff, base, baseCount, head, headCount));
+
+        bool *paired = calloc(baseCount + 1, sizeof(bool));
+        size_t entry = 0;
+        for (size_t i = 0; i < headCount; i++)
+        {
+            if (UBKAuditRecordIsScreenMarker(&head[i]) || !hasScreen(base, baseCount, head[i].screen))
+            {
+                continue;
+            }
+            long nearest = -1;
+            float nearestDistance = INFINITY;
+            for (size_t j = 0; j < baseCount; j++)
+            {
+                if (paired[j] || UBKAuditRecordIsScreenMarker(&base[j]) || (base[j].screen != head[i].screen) || (base[j].element != head[i].element))
+                {
+                    continue;
+                }
+                float distance = fabsf(base[j].x - head[i].x) + fabsf(base[j].y - head[i].y);
+                if (distance < nearestDistance)
+                {
+                    nearestDistance = distance;
+                    nearest = (long)j;
+                }
+            }
+            if (nearest < 0)
+            {
+                UBKTestAssert((diff.entries[entry].kind == UBKAuditDiffKindAdded) && (diff.entries[entry].headIndex == i));
+                entry++;
+                continue;
+            }
+            paired[nearest] = true;
+            if (base[nearest].warningMask != head[i].warningMask)
+            {
+                UBKAuditDiffEntry *changed = &diff.entries[entry++];
+                UBKTestAssert((changed->kind == UBKAuditDiffKindChanged) && (changed->baseIndex == (uint32_t)nearest) && (changed->headIndex == i));
+                UBKTestAssert(changed->addedWarnings == (head[i].warningMask & ~base[nearest].warningMask));
+                UBKTestAssert(changed->removedWarnings == (base[nearest].warningMask & ~head[i].warningMask));
+            }
+        }
+        for (size_t j = 0; j < baseCount; j++)
+        {
+            if (!paired[j] && !UBKAuditRecordIsScreenMarker(&base[j]) && hasScreen(head, headCount, base[j].screen))
+            {
+                UBKTestAssert((diff.entries[entry].kind == UBKAuditDiffKindRemoved) && (diff.entries[entry].baseIndex == j));
+                entry++;
+            }
+        }
+        UBKTestAssert(entry == diff.count);
+        UBKAuditDiffDestroy(&diff);
+        free(paired);
+        free(base);
+        free(head);
+    }
+}
+
+//Screens without warnings in one build only have their marker there
+static void testScreensWithoutWarningsAreCompared(void)
+{
+    UBKAuditDiff diff;
+    UBKAuditDiffInit(&diff);
+    UBKAuditRecord clean[1] = { makeRecord(1, 0, 0, 0) };
+    UBKAuditRecord regressed[2] = { makeRecord(1, 0, 0, 0), makeRecord(1, 5, 0, 2) };
+    UBKTestAssert(UBKAuditDiffCompute(&diff, clean, 1, regressed, 2));
+    UBKTestAssert((diff.count == 1) && (diff.entries[0].kind == UBKAuditDiffKindAdded) && (diff.entries[0].headIndex == 1) && (diff.entries[0].addedWarnings == 2));
+    UBKTestAssert((diff.comparedScreenCount == 1) && (diff.headOnlyScreenCount == 0));
+
+    //Every warning fixed
+    UBKTestAssert(UBKAuditDiffCompute(&diff, regressed, 2, clean, 1));
+    UBKTestAssert((diff.count == 1) && (diff.entries[0].kind == UBKAuditDiffKindRemoved) && (diff.entries[0].baseIndex == 1) && (diff.entries[0].removedWarnings == 2));
+
+    //Still clean
+    UBKTestAssert(UBKAuditDiffCompute(&diff, clean, 1, clean, 1));
+    UBKTestAssert((diff.count == 0) && (diff.comparedScreenCount == 1));
+
+    //A screen that wasn't audited in the base build isn't compared
+    UBKAuditRecord otherScreen[1] = { makeRecord(2, 0, 0, 0) };
+    UBKTestAssert(UBKAuditDiffCompute(&diff, otherScreen, 1, regressed, 2));
+    UBKTestAssert((diff.count == 0) && (diff.baseOnlyScreenCount == 1) && (diff.headOnlyScreenCount == 1));
+    UBKAuditDiffDestroy(&diff);
+}
+
+static void testWritesJSONLines(void)
+{
+    UBKAuditRecord base[2] = { makeRecord(1, 1, 0, 1), makeRecord(1, 2, 0, 2) };
+    UBKAuditRecord head[2] = { makeRecord(1, 1, 0, 3), makeRecord(1, 3, 0, 4) };
+    UBKAuditDiff diff;
+    UBKAuditDiffInit(&diff);
+    UBKTestAssert(UBKAuditDiffCompute(&diff, base, 2, head, 2));
+    UBKTestAssert((diff.addedCount == 1) && (diff.removedCount == 1) && (diff.changedCount == 1) && (diff.comparedScreenCount == 1));
+
+    FILE *file = tmpfile();
+    UBKTestAssert(file != NULL);
+    UBKTestAssert(UBKAuditDiffWriteJSONLines(&diff, base, head, file));
+    rewind(file);
+    int lines = 0;
+    char line[1024];
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        UBKTestAssert((line[0] == '{') && (strchr(line, '\n') != NULL));
+        lines++;
+    }
+    fclose(file);
+    UBKTestAssert(lines == 4);
+    UBKAuditDiffDestroy(&diff);
+}
+
+static void testCollectsTheLatestAuditOfEachScreen(void)
+{
+    char path[256];
+    UBKTestTemporaryPath(path, sizeof(path), "UBKAuditDiffTests");
+    UBKAuditStore store;
+    UBKTestAssert(UBKAuditStoreOpen(&store, path, false));
+    UBKAuditRecord records[5] = { makeRecord(1, 1, 0, 1), makeRecord(1, 2, 0, 1), makeRecord(1, 1, 0, 2), makeRecord(2, 1, 0, 1), makeRecord(1, 1, 0, 4) };
+    int64_t timestamps[5] = { 10, 10, 20, 5, 30 };
+    for (int i = 0; i < 5; i++)
+    {
+        records[i].build = (i == 4) ? 8 : 7;
+        records[i].timestamp = timestamps[i];
+    }
+    UBKTestAssert(UBKAuditStoreAppend(&store, records, 5));
+
+    UBKAuditRecord *collected = NULL;
+    size_t count = 0;
+    UBKTestAssert(UBKAuditDiffCollectBuild(&store, 7, &collected, &count));
+    UBKTestAssert((count == 2) && (collected[0].warningMask == 2) && (collected[1].screen == 2));
+    free(collected);
+
+    //A later audit with no warnings only leaves its marker
+    UBKAuditRecord clean = makeRecord(1, 0, 0, 0);
+    clean.build = 7;
+    clean.timestamp = 40;
+    UBKTestAssert(UBKAuditStoreAppend(&store, &clean, 1));
+    UBKTestAssert(UBKAuditDiffCollectBuild(&store, 7, &collected, &count));
+    UBKTestAssert((count == 2) && (collected[0].screen == 2) && UBKAuditRecordIsScreenMarker(&collected[1]) && (collected[1].timestamp == 40));
+    free(collected);
+    UBKAuditStoreClose(&store);
+    unlink(path);
+}
+
+int main(void)
+{
+    testMatchesPairwiseComparison();
+    testScreensWithoutWarningsAreCompared();
+    testWritesJSONLines();
+    testCollectsTheLatestAuditOfEachScreen();
+    return 0;
+}
@@ -0,0 +1,241 @@
+/*
+ File: UBKAuditStoreTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKAuditStore.h"
+#include "UBKCoreTests.h"
+
+#include <string.h>
+
+typedef struct {
+    uint64_t count;
+} UBKTestVisitorCount;
+
+static bool countRecord(const UBKAuditRecord *record, uint64_t recordNumber, void *context)
+{
+    (void)record;
+    (void)recordNumber;
+    ((UBKTestVisitorCount *)context)->count++;
+    return true;
+}
+
+//Checks every record, the store should only use its indexes to skip records that can't match
+static uint64_t countMatchingRecords(const UBKAuditStore *store, const UBKAuditQuery *query)
+{
+    uint64_t count = 0;
+    for (uint64_t i = 0; i < UBKAuditStoreCount(store); i++)
+    {
+        const UBKAuditRecord *record = &store->records[i];
+        bool matches = ((query->warningMask == 0) || ((record->warningMask & query->warningMask) != 0));
+        matches = matches && ((query->screen == 0) || (record->screen == query->screen));
+        matches = matches && ((query->build == 0) || (record->build == query->build));
+        matches = matches && (record->timestamp >= query->fromTimestamp) && ((query->toTimestamp == 0) || (record->timestamp < query->toTimestamp));
+        count += matches ? 1 : 0;
+    }
+    return count;
+}
+
+static UBKAuditRecord randomRecord(size_t index)
+{
+    UBKAuditRecord record;
+    memset(&record, 0, sizeof(record));
+    record.screen = 1 + rand() % 50;
+    record.element = rand() % 300;
+    record.build = 1 + rand() % 4;
+    if (rand() % 4 != 0)
+    {
+        record.warningMask = (1ULL << (rand() % 20)) | ((rand() % 8 == 0) ? (1ULL << (rand() % 20)) : 0);
+    }
+    record.timestamp = 1000 + (int64_t)(index / 1000);
+    record.width = 44;
+    record.height = 44;
+    return record;
+}
+
+static void testQueriesMatchAFullScan(void)
+{
+    char path[256];
+    UBKTestTemporaryPath(path, sizeof(path), "UBKAuditStoreTests");
+    UBKAuditStore store;
+    UBKTestAssert(UBKAuditStoreOpen(&store, path, false));
+
+    srand(3);
+    size_t count = 200000;
+    UBKAuditRecord *records = malloc(count * sizeof(UBKAuditRecord));
+    for (size_t i = 0; i < count; i++)
+    {
+        records[i] = randomRecord(i);
+    }
+    for (size_t i = 0; i < count; i += 10000)
+    {
+        UBKTestAssert(UBKAuditStoreAppend(&store, records + i, 10000));
+    }
+    UBKTestAssert(UBKAuditStoreCount(&store) == count);
+
+    for (int test = 0; test < 200; test++)
+    {
+        UBKAuditQuery query = {0};
+        int fields = rand() % 5;
+        query.screen = (fields & 1) ? (uint64_t)(1 + rand() % 52) : 0;
+        query.build = (fields & 2) ? (uint64_t)(1 + rand() % 5) : 0;
+        if (rand() % 2)
+        {
+            query.warningMask = 1ULL << (rand() % 20);
+        }
+        if (rand() % 3 == 0)
+        {
+            query.fromTimestamp = 1000 + rand() % 200;
+            query.toTimestamp = query.fromTimestamp + rand() % 50;
+        }
+        UBKTestVisitorCount visited = {0};
+        uint64_t matches = UBKAuditStoreQuery(&store, &query, countRecord, &visited);
+        UBKTestAssert(matches == visited.count);
+        UBKTestAssert(matches == countMatchingRecords(&store, &query));
+    }
+
+    //Another reader picks up appended records
+    UBKTestAssert(UBKAuditStoreSync(&store));
+    UBKAuditStore reader;
+    UBKTestAssert(UBKAuditStoreOpen(&reader, path, true));
+    UBKTestAssert(UBKAuditStoreCount(&reader) == count);
+    UBKAuditRecord extra = records[0];
+    extra.timestamp = 99999;
+    UBKTestAssert(UBKAuditStoreAppend(&store, &extra, 1));
+    UBKTestAssert(UBKAuditStoreRefresh(&reader));
+    UBKTestAssert(UBKAuditStoreCount(&reader) == count + 1);
+    UBKAuditStoreClose(&reader);
+
+    UBKAuditStoreClose(&store);
+    free(records);
+    unlink(path);
+}
+
+static void testCompactDropsOldRecordsAndRepeats(void)
+{
+    char path[256];
+    UBKTestTemporaryPath(path, sizeof(path), "UBKAuditStoreCompactTests");
+    UBKAuditStore store;
+    UBKTestAssert(UBKAuditStoreOpen(&store, path, false));
+    UBKAuditRecord records[4];
+    memset(records, 0, sizeof(records));
+    for (int i = 0; i < 4; i++)
+    {
+        records[i].screen = 1;
+        records[i].element = 2;
+        records[i].build = 3;
+        records[i].warningMask = 4;
+        records[i].timestamp = 10 + i;
+    }
+    records[0].timestamp = 1;
+    records[3].warningMask = 8;
+    UBKTestAssert(UBKAuditStoreAppend(&store, records, 4));
+
+    //The first record is too old, the second is repeated by the third
+    UBKTestAssert(UBKAuditStoreCompact(&store, 5));
+    UBKTestAssert(UBKAuditStoreCount(&store) == 2);
+    UBKTestAssert((store.records[0].timestamp == 12) && (store.records[1].warningMask == 8));
+    UBKAuditQuery query = {0};
+    query.warningMask = 4;
+    UBKTestAssert(UBKAuditStoreQuery(&store, &query, NULL, NULL) == 1);
+
+    //Appends after compacting go to the new file
+    UBKTestAssert(UBKAuditStoreAppend(&store, records, 1));
+    UBKAuditStoreClose(&store);
+    UBKTestAssert(UBKAuditStoreOpen(&store, path, false));
+    UBKTestAssert(UBKAuditStoreCount(&store) == 3);
+    UBKAuditStoreClose(&store);
+    unlink(path);
+}
+
+static void testReadersFollowACompaction(void)
+{
+    char path[256];
+    UBKTestTemporaryPath(path, sizeof(path), "UBKAuditStoreReaderTests");
+    UBKAuditStore writer;
+    UBKAuditStore reader;
+    UBKTestAssert(UBKAuditStoreOpen(&writer, path, false));
+    UBKAuditRecord records[3];
+    memset(records, 0, sizeof(records));
+    for (int i = 0; i < 3; i++)
+    {
+        records[i].screen = 1;
+        records[i].timestamp = 10 * (i + 1);
+    }
+    UBKTestAssert(UBKAuditStoreAppend(&writer, records, 3));
+    UBKTestAssert(UBKAuditStoreOpen(&reader, path, true));
+    UBKTestAssert(UBKAuditStoreCount(&reader) == 3);
+
+    //The reader still has the file that was renamed over until it refreshes
+    UBKTestAssert(UBKAuditStoreCompact(&writer, 25));
+    UBKTestAssert(UBKAuditStoreAppend(&writer, records, 1));
+    UBKTestAssert(UBKAuditStoreRefresh(&reader));
+    UBKTestAssert(reader.readOnly && (UBKAuditStoreCount(&reader) == 2));
+    UBKAuditQuery query = {0};
+    query.screen = 1;
+    UBKTestAssert(UBKAuditStoreQuery(&reader, &query, NULL, NULL) == 2);
+    UBKAuditStoreClose(&reader);
+    UBKAuditStoreClose(&writer);
+    unlink(path);
+}
+
+static void testHeaderOnlyFilesGrow(void)
+{
+    char path[256];
+    UBKTestTemporaryPath(path, sizeof(path), "UBKAuditStoreHeaderTests");
+    UBKAuditStore store;
+    UBKTestAssert(UBKAuditStoreOpen(&store, path, false));
+    UBKAuditStoreClose(&store);
+    //Keep only the 64 byte header
+    UBKTestAssert(truncate(path, 64) == 0);
+
+    UBKTestAssert(UBKAuditStoreOpen(&store, path, false));
+    UBKTestAssert(store.capacity == 0);
+    UBKAuditRecord record;
+    memset(&record, 0, sizeof(record));
+    record.screen = 1;
+    UBKTestAssert(UBKAuditStoreAppend(&store, &record, 1));
+    UBKTestAssert((UBKAuditStoreCount(&store) == 1) && (store.capacity > 0));
+    UBKAuditStoreClose(&store);
+    unlink(path);
+}
+
+static void testOtherFilesAreRejected(void)
+{
+    char path[256];
+    UBKTestTemporaryPath(path, sizeof(path), "UBKAuditStoreBadTests");
+    FILE *file = fopen(path, "w");
+    UBKTestAssert(file != NULL);
+    fputs("Not an audit store, but long enough to hold a header and a few records.........", file);
+    fclose(file);
+    UBKAuditStore store;
+    UBKTestAssert(!UBKAuditStoreOpen(&store, path, false));
+    UBKTestAssert(!UBKAuditStoreOpen(&store, path, true));
+    unlink(path);
+}
+
+int main(void)
+{
+    testQueriesMatchAFullScan();
+    testCompactDropsOldRecordsAndRepeats();
+    testReadersFollowACompaction();
+    testHeaderOnlyFilesGrow();
+    testOtherFilesAreRejected();
+    return 0;
+}
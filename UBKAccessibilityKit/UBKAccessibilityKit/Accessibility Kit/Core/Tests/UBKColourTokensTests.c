@@ -0,0 +1,162 @@
+/*
+ File: UBKColourTokensTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKColourTokens.h"
+#include "UBKCoreTests.h"
+
+#include <string.h>
+
+static bool parseColour(const char *text, uint32_t *colour)
+{
+    return UBKColourTokensParseColour(text, strlen(text), colour);
+}
+
+static void parseInChunks(UBKColourTokens *tokens, const char *json, size_t chunkLength)
+{
+    size_t length = strlen(json);
+    for (size_t offset = 0; offset < length; offset += chunkLength)
+    {
+        size_t remaining = length - offset;
+        UBKColourTokensParse(tokens, json + offset, (remaining < chunkLength) ? remaining : chunkLength);
+    }
+}
+
+static void testColourFormats(void)
+{
+    uint32_t colour = 0;
+    UBKTestAssert(parseColour("#F80", &colour) && (colour == 0xFF8800FF));
+    UBKTestAssert(parseColour(" #ff880080 ", &colour) && (colour == 0xFF880080));
+    UBKTestAssert(parseColour("#abcd", &colour) && (colour == 0xAABBCCDD));
+    UBKTestAssert(parseColour("rgb(255, 0, 128)", &colour) && (colour == 0xFF0080FF));
+    UBKTestAssert(parseColour("rgba(255,0,0,0.5)", &colour) && (colour == 0xFF000080));
+    UBKTestAssert(parseColour("rgb(100% 0% 50% / 50%)", &colour) && (colour == 0xFF008080));
+    UBKTestAssert(!parseColour("#abcde", &colour));
+    UBKTestAssert(!parseColour("#ggg", &colour));
+    UBKTestAssert(!parseColour("rgb(1,2)", &colour));
+    UBKTestAssert(!parseColour("rgb(1,2,3,4,5)", &colour));
+    UBKTestAssert(!parseColour("rgb(1,2,3) x", &colour));
+    UBKTestAssert(!parseColour("red", &colour));
+}
+
+static void testChunksCanSplitAnywhere(void)
+{
+    const char *json = "{\"color\": {\"light\": {\"background\": {\"$value\": \"#FFFFFF\", \"$type\": \"color\"}, \"text\": {\"value\": \"#000\"}, \"n\": 12.5e3, \"b\": true, \"x\": null},"
+        " \"dark\": {\"background\": {\"$value\": \"#000000\"}, \"text\": \"#fff\", \"list\": [\"#ff0000\", 1, [\"rgb(0,255,0)\"]]}, \"esc\\u00e9\\\"\": \"#0000ff\", \"emoji\\ud83d\\ude00\": {\"$value\": \"#010203\"}}}";
+    for (size_t chunkLength = 1; chunkLength <= strlen(json); chunkLength = chunkLength * 2 + 1)
+    {
+        UBKColourTokens tokens;
+        UBKColourTokensInit(&tokens);
+        parseInChunks(&tokens, json, chunkLength);
+        UBKTestAssert(UBKColourTokensFinish(&tokens));
+        UBKTestAssert((tokens.tokenCount == 8) && (tokens.count == 6));
+        UBKTestAssert(strcmp(UBKColourTokensName(&tokens, &tokens.entries[0]), "color.light.background") == 0);
+        UBKTestAssert(strcmp(UBKColourTokensName(&tokens, &tokens.entries[1]), "color.light.text") == 0);
+        UBKTestAssert(strcmp(UBKColourTokensName(&tokens, &tokens.entries[2]), "color.dark.list") == 0);
+        //Dark mode repeats the light colours, they count towards the first token with the colour
+        UBKTestAssert((tokens.entries[0].tokenCount == 2) && (tokens.entries[1].tokenCount == 2));
+        int32_t blue = UBKColourTokensFind(&tokens, 0x0000FFFF);
+        UBKTestAssert(blue == 4);
+        UBKTestAssert(strcmp(UBKColourTokensName(&tokens, &tokens.entries[blue]), "color.esc\xc3\xa9\"") == 0);
+        UBKTestAssert(strcmp(UBKColourTokensName(&tokens, &tokens.entries[5]), "color.emoji\xf0\x9f\x98\x80") == 0);
+        UBKTestAssert(UBKColourTokensFind(&tokens, 0x12345678) == -1);
+        UBKColourTokensDestroy(&tokens);
+    }
+}
+
+static void testMalformedJSONFails(void)
+{
+    const char *malformed[] = { "{\"a\": }", "{\"a\" 1}", "[1,]", "{\"a\": \"#fff\"", "{} x", "[\"a\nb\"]", "{\"a\":\"\\q\"}", "{\"a\":1]" };
+    for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++)
+    {
+        UBKColourTokens tokens;
+        UBKColourTokensInit(&tokens);
+        UBKColourTokensParse(&tokens, malformed[i], strlen(malformed[i]));
+        UBKTestAssert(!UBKColourTokensFinish(&tokens));
+        UBKColourTokensDestroy(&tokens);
+    }
+
+    //Containers nested past the depth limit are refused rather than overflowing the stack
+    char deep[UBKColourTokensMaxDepth + 44];
+    memset(deep, '[', sizeof(deep));
+    UBKColourTokens tokens;
+    UBKColourTokensInit(&tokens);
+    UBKTestAssert(!UBKColourTokensParse(&tokens, deep, sizeof(deep)));
+    UBKColourTokensDestroy(&tokens);
+}
+
+static void testTopLevelValues(void)
+{
+    UBKColourTokens tokens;
+    UBKColourTokensInit(&tokens);
+    UBKColourTokensParse(&tokens, "\"#abc\"", 6);
+    UBKTestAssert(UBKColourTokensFinish(&tokens) && (tokens.count == 1) && (tokens.entries[0].nameLength == 0));
+    UBKColourTokensDestroy(&tokens);
+
+    UBKColourTokensInit(&tokens);
+    UBKColourTokensParse(&tokens, " 42 ", 4);
+    UBKTestAssert(UBKColourTokensFinish(&tokens) && (tokens.count == 0));
+    UBKColourTokensDestroy(&tokens);
+
+    //Empty keys still make a path
+    const char *json = "{\"\": \"#fff\", \"a\": {\"\": {\"$value\": \"#000\"}}}";
+    UBKColourTokensInit(&tokens);
+    UBKColourTokensParse(&tokens, json, strlen(json));
+    UBKTestAssert(UBKColourTokensFinish(&tokens) && (tokens.count == 2));
+    UBKTestAssert(strcmp(UBKColourTokensName(&tokens, &tokens.entries[1]), "a.") == 0);
+    UBKColourTokensDestroy(&tokens);
+}
+
+static void testParsesFiles(void)
+{
+    char path[256];
+    UBKTestTemporaryPath(path, sizeof(path), "UBKColourTokensTests.json");
+    FILE *file = fopen(path, "w");
+    UBKTestAssert(file != NULL);
+    fputs("{\"brand\": {", file);
+    for (int i = 0; i < 5000; i++)
+    {
+        fprintf(file, "%s\"token%d\": {\"$value\": \"#%06X\"}", (i == 0) ? "" : ", ", i, (unsigned)(i % 1000) * 16);
+    }
+    fputs("}}", file);
+    fclose(file);
+
+    UBKColourTokens tokens;
+    UBKColourTokensInit(&tokens);
+    UBKTestAssert(UBKColourTokensParseFile(&tokens, path));
+    UBKTestAssert((tokens.tokenCount == 5000) && (tokens.count == 1000));
+    UBKTestAssert(strcmp(UBKColourTokensName(&tokens, &tokens.entries[UBKColourTokensFind(&tokens, 0x000010FF)]), "brand.token1") == 0);
+    UBKColourTokensDestroy(&tokens);
+    unlink(path);
+
+    UBKColourTokensInit(&tokens);
+    UBKTestAssert(!UBKColourTokensParseFile(&tokens, path));
+    UBKColourTokensDestroy(&tokens);
+}
+
+int main(void)
+{
+    testColourFormats();
+    testChunksCanSplitAnywhere();
+    testMalformedJSONFails();
+    testTopLevelValues();
+    testParsesFiles();
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ File: UBKColourValueTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKColourValue.h"
+#include "UBKCoreTests.h"
+
+#include <math.h>
+
+static UBKColourValue makeEncoded(float red, float green, float blue, float alpha)
+{
+    return UBKColourValueMakeLinear(UBKColourValueLinearFromEncoded(red), UBKColourValueLinearFromEncoded(green), UBKColourValueLinearFromEncoded(blue), alpha);
+}
+
+static UBKColourValue makeHex(uint32_t rgb)
+{
+    UBKColourRGBA8 colour = { (uint8_t)(rgb >> 16), (uint8_t)(rgb >> 8), (uint8_t)rgb, 255 };
+    return UBKColourValueMakeRGBA8(colour);
+}
+
+static void testContrastRatios(void)
+{
+    //Values from the WebAIM contrast checker
+    UBKTestAssert(fabs(UBKColourValueContrastRatio(makeHex(0x000000), makeHex(0xFFFFFF)) - 21) < 0.01);
+    UBKTestAssert(fabs(UBKColourValueContrastRatio(makeHex(0x646464), makeHex(0xFFFFFF)) - 5.92) < 0.01);
+    UBKTestAssert(fabs(UBKColourValueContrastRatio(makeHex(0xFFFFFF), makeHex(0xD8D8D8)) - 1.43) < 0.01);
+    UBKTestAssert(UBKColourValueContrastRatio(makeHex(0x123456), makeHex(0x123456)) == 1);
+}
+
+static void testKeysRoundTrip(void)
+{
+    for (uint32_t value = 0; value < 256; value++)
+    {
+        UBKColourRGBA8 colour = { (uint8_t)value, (uint8_t)value, (uint8_t)value, (uint8_t)value };
+        UBKColourValue converted = UBKColourValueMakeRGBA8(colour);
+        UBKTestAssert(converted.key == ((value << 24) | (value << 16) | (value << 8) | value));
+        UBKColourRGBA8 back = UBKColourValueRGBA8(converted);
+        UBKTestAssert((back.r == value) && (back.a == value));
+    }
+    UBKTestAssert(!UBKColourValueMakeUnknown().hasComponents);
+}
+
+static void testCompositing(void)
+{
+    UBKColourValue white = makeEncoded(1, 1, 1, 1);
+    UBKColourValue black = makeEncoded(0, 0, 0, 1);
+    UBKColourValue halfBlack = makeEncoded(0, 0, 0, 0.5f);
+    UBKColourValue unknown = UBKColourValueMakeUnknown();
+
+    //Blended on the encoded values, so half black over white is mid grey
+    UBKColourValue grey = UBKColourValueComposite(halfBlack, 1, white);
+    UBKTestAssert((grey.key == 0x808080FF) || (grey.key == 0x7F7F7FFF));
+    UBKTestAssert(UBKColourValueComposite(black, 0.5f, white).key == grey.key);
+    UBKTestAssert(UBKColourValueComposite(white, 1, black).key == white.key);
+
+    //Nothing known underneath
+    UBKTestAssert(UBKColourValueComposite(halfBlack, 1, unknown).key == halfBlack.key);
+    UBKTestAssert(!UBKColourValueComposite(makeEncoded(0, 0, 0, 0), 1, unknown).hasComponents);
+
+    //Compositing two translucent colours first gives the same result as one after the other
+    UBKColourValue red = makeEncoded(1, 0, 0, 0.5f);
+    UBKColourValue blue = makeEncoded(0, 0, 1, 0.5f);
+    UBKColourValue together = UBKColourValueComposite(UBKColourValueComposite(red, 1, blue), 1, white);
+    UBKColourValue inTurn = UBKColourValueComposite(red, 1, UBKColourValueComposite(blue, 1, white));
+    UBKTestAssert(together.key == inTurn.key);
+}
+
+int main(void)
+{
+    testContrastRatios();
+    testKeysRoundTrip();
+    testCompositing();
+    return 0;
+}
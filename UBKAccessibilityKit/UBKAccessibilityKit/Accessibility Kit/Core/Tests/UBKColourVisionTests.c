@@ -0,0 +1,90 @@
+/*
+ File: UBKColourVisionTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKColourVision.h"
+#include "UBKCoreTests.h"
+
+#include <math.h>
+
+static void testRatiosForEveryDeficiency(void)
+{
+    //Blue on yellow is fine for typical vision and worse with any missing cone type, black on white is the same for everyone
+    size_t pairCount = 70;
+    UBKColourRGBA8 foreground[70];
+    UBKColourRGBA8 background[70];
+    for (size_t i = 0; i < pairCount; i++)
+    {
+        foreground[i] = (UBKColourRGBA8){ 0, 0, 255, 255 };
+        background[i] = (UBKColourRGBA8){ 255, 255, 0, 255 };
+    }
+    foreground[69] = (UBKColourRGBA8){ 0, 0, 0, 255 };
+    background[69] = (UBKColourRGBA8){ 255, 255, 255, 255 };
+    float ratios[70 * UBKColourVisionDeficiencyCount];
+    UBKColourVisionContrastRatios(foreground, background, pairCount, ratios);
+
+    for (size_t i = 1; i < 69; i++)
+    {
+        UBKTestAssert(ratios[i] == ratios[0]);
+    }
+    UBKTestAssert(fabsf(ratios[0] - 8) < 0.01f);
+    UBKTestAssert(ratios[UBKColourVisionProtanopia * pairCount] < 5);
+    UBKTestAssert(ratios[UBKColourVisionDeuteranopia * pairCount] < 7);
+    UBKTestAssert(ratios[UBKColourVisionTritanopia * pairCount] < 6);
+    //Achromatopsia keeps the luminance, so the contrast doesn't change
+    UBKTestAssert(fabsf(ratios[UBKColourVisionAchromatopsia * pairCount] - ratios[0]) < 0.01f);
+    for (int deficiency = 0; deficiency < UBKColourVisionDeficiencyCount; deficiency++)
+    {
+        UBKTestAssert(fabsf(ratios[deficiency * pairCount + 69] - 21) < 0.05f);
+    }
+
+    //W3C ratio for #AAAAAA on white
+    UBKColourRGBA8 grey = { 170, 170, 170, 255 };
+    UBKColourRGBA8 white = { 255, 255, 255, 255 };
+    float greyRatios[UBKColourVisionDeficiencyCount];
+    UBKColourVisionContrastRatios(&grey, &white, 1, greyRatios);
+    UBKTestAssert(fabsf(greyRatios[0] - 2.32f) < 0.01f);
+}
+
+static void testSimulatingPixels(void)
+{
+    UBKColourRGBA8 pixels[3] = { { 12, 34, 56, 255 }, { 200, 100, 50, 128 }, { 0, 0, 0, 0 } };
+    UBKColourRGBA8 output[3];
+    UBKColourVisionSimulatePixels(UBKColourVisionTypical, pixels, 3, output);
+    for (int i = 0; i < 3; i++)
+    {
+        UBKTestAssert((output[i].r == pixels[i].r) && (output[i].g == pixels[i].g) && (output[i].b == pixels[i].b) && (output[i].a == pixels[i].a));
+    }
+
+    //Without any colour vision every pixel is a grey, alpha is left alone, and it can be done in place
+    UBKColourVisionSimulatePixels(UBKColourVisionAchromatopsia, pixels, 3, pixels);
+    for (int i = 0; i < 3; i++)
+    {
+        UBKTestAssert((pixels[i].r == pixels[i].g) && (pixels[i].g == pixels[i].b));
+    }
+    UBKTestAssert((pixels[1].a == 128) && (pixels[2].a == 0));
+}
+
+int main(void)
+{
+    testRatiosForEveryDeficiency();
+    testSimulatingPixels();
+    return 0;
+}
@@ -0,0 +1,56 @@
+/*
+ File: UBKContrastPairsTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKContrastPairs.h"
+#include "UBKCoreTests.h"
+
+static void testPairsAreRatedTogether(void)
+{
+    const UBKRuleEvaluator *evaluator = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG21);
+    UBKColourValue black = UBKColourValueMakeLinear(0, 0, 0, 1);
+    UBKColourValue white = UBKColourValueMakeLinear(1, 1, 1, 1);
+    UBKColourValue grey = UBKColourValueMakeLinear(0.2f, 0.2f, 0.2f, 1);
+    UBKContrastPair pairs[5] = {
+        { .foreground = black, .background = white, .opacity = 1, .textSize = 17, .flags = UBKContrastPairFlagText },
+        { .foreground = grey, .background = white, .opacity = 1, .textSize = 17, .flags = UBKContrastPairFlagText },
+        { .foreground = grey, .background = white, .opacity = 1, .textSize = 17, .flags = UBKContrastPairFlagText | UBKContrastPairFlagInactive },
+        { .foreground = grey, .background = white, .opacity = 1 },
+        { .foreground = black, .background = UBKColourValueMakeUnknown(), .opacity = 1, .flags = UBKContrastPairFlagText },
+    };
+    UBKTestAssert(UBKContrastPairsEvaluate(pairs, 5, evaluator) == 1);
+    UBKTestAssert(!pairs[0].isFailing && (pairs[0].contrast > 20));
+    UBKTestAssert(pairs[1].isFailing);
+    //Inactive pairs are rated but never fail
+    UBKTestAssert(!pairs[2].isFailing && (pairs[2].rating == UBKRuleRatingFail));
+    //Non text has the lower threshold
+    UBKTestAssert(!pairs[3].isFailing);
+    UBKTestAssert((pairs[4].rating == UBKRuleRatingNA) && (pairs[4].contrast == 0) && !pairs[4].isFailing);
+
+    //Opacity fades the foreground into the background
+    pairs[0].opacity = 0.2f;
+    UBKTestAssert(UBKContrastPairsEvaluate(pairs, 1, evaluator) == 1);
+}
+
+int main(void)
+{
+    testPairsAreRatedTogether();
+    return 0;
+}
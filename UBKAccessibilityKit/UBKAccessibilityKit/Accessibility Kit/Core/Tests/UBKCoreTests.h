@@ -0,0 +1,53 @@
+/*
+ File: UBKCoreTests.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKCoreTests_h
+#define UBKCoreTests_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+//Checks that stay on in release builds, unlike assert. A failing check ends the test straight away.
+#define UBKTestAssert(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            fprintf(stderr, "%s:%d: failed: %s\n", __FILE__, __LINE__, #condition); \
+            exit(EXIT_FAILURE); \
+        } \
+    } while (0)
+
+//A path for a test file that isn't shared with other tests running at the same time
+static inline const char *UBKTestTemporaryPath(char *buffer, size_t size, const char *name)
+{
+    const char *directory = getenv("TMPDIR");
+    if ((directory == NULL) || (directory[0] == '\0'))
+    {
+        directory = "/tmp";
+    }
+    snprintf(buffer, size, "%s/%s-%ld", directory, name, (long)getpid());
+    unlink(buffer);
+    return buffer;
+}
+
+#endif /* UBKCoreTests_h */
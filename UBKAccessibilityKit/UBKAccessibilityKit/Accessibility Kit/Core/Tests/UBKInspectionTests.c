@@ -0,0 +1,434 @@
+/*
+ File: UBKInspectionTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKInspection.h"
+#include "UBKCoreTests.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+
+//A tree of count labels, four children to a node. The changed tree moves one node, adds a warning, changes a label and a colour, removes a node and adds a button.
+static void createTree(UBKInspectionTree *tree, uint32_t count, bool changed)
+{
+    UBKInspectionTreeReset(tree);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (changed && (i == 3))
+        {
+            continue;
+        }
+        UBKInspectionNode node = {0};
+        node.key = 1000 + i;
+        node.parentKey = (i == 0) ? 0 : 1000 + (i - 1) / 4;
+        node.siblingIndex = i % 4;
+        node.flags = 1;
+        node.x = (float)i + ((changed && (i == 5)) ? 3 : 0);
+        node.y = (float)i * 2;
+        node.width = 10;
+        node.height = 20;
+        node.warningMask = (changed && (i == 7)) ? 4 : 0;
+        char label[32];
+        snprintf(label, sizeof(label), "Label %u%s", i, (changed && (i == 9)) ? "!" : "");
+        UBKTestAssert(UBKInspectionTreeAddNode(tree, &node, "UILabel", label));
+        if (i % 3 == 0)
+        {
+            UBKTestAssert(UBKInspectionTreeAddColour(tree, "Text colour", 0x112233FF));
+            UBKTestAssert(UBKInspectionTreeAddColour(tree, "Background", (changed && (i == 6)) ? 0xFFFFFFFF : 0xEEEEEEFF));
+        }
+    }
+    if (changed)
+    {
+        UBKInspectionNode node = {0};
+        node.key = 99999;
+        node.parentKey = 1000;
+        node.siblingIndex = 9;
+        UBKTestAssert(UBKInspectionTreeAddNode(tree, &node, "UIButton", "New"));
+        UBKTestAssert(UBKInspectionTreeAddColour(tree, "Tint", 0x0000FFFF));
+    }
+}
+
+static bool sameNodes(const UBKInspectionTree *tree, const UBKInspectionNode *node, const UBKInspectionTree *otherTree, const UBKInspectionNode *otherNode)
+{
+    if ((node->parentKey != otherNode->parentKey) || (node->siblingIndex != otherNode->siblingIndex) || (node->flags != otherNode->flags))
+    {
+        return false;
+    }
+    if ((node->warningMask != otherNode->warningMask) || (node->warningLevel != otherNode->warningLevel))
+    {
+        return false;
+    }
+    if ((node->x != otherNode->x) || (node->y != otherNode->y) || (node->width != otherNode->width) || (node->height != otherNode->height))
+    {
+        return false;
+    }
+    if ((strcmp(UBKInspectionTreeString(tree, node->className), UBKInspectionTreeString(otherTree, otherNode->className)) != 0) || (strcmp(UBKInspectionTreeString(tree, node->label), UBKInspectionTreeString(otherTree, otherNode->label)) != 0))
+    {
+        return false;
+    }
+    if (node->colourCount != otherNode->colourCount)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < node->colourCount; i++)
+    {
+        const UBKInspectionColour *colour = &tree->colours[node->firstColour + i];
+        const UBKInspectionColour *otherColour = &otherTree->colours[otherNode->firstColour + i];
+        if ((colour->rgba != otherColour->rgba) || (strcmp(UBKInspectionTreeString(tree, colour->title), UBKInspectionTreeString(otherTree, otherColour->title)) != 0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool sameTrees(const UBKInspectionTree *tree, const UBKInspectionTree *otherTree)
+{
+    if (tree->count != otherTree->count)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < tree->count; i++)
+    {
+        int64_t otherIndex = UBKInspectionTreeFind(otherTree, tree->nodes[i].key);
+        if ((otherIndex < 0) || !sameNodes(tree, &tree->nodes[i], otherTree, &otherTree->nodes[otherIndex]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void testDeltasRebuildTheTree(void)
+{
+    UBKInspectionTree tree;
+    UBKInspectionTree changedTree;
+    UBKInspectionTree client;
+    UBKInspectionTreeInit(&tree);
+    UBKInspectionTreeInit(&changedTree);
+    UBKInspectionTreeInit(&client);
+    createTree(&tree, 50, false);
+    tree.sequence = 1;
+    createTree(&changedTree, 50, true);
+    changedTree.sequence = 2;
+
+    UBKInspectionBuffer buffer;
+    UBKInspectionBufferInit(&buffer);
+    UBKTestAssert(UBKInspectionEncodeSnapshot(&buffer, &tree));
+    size_t snapshotLength = buffer.length;
+    UBKInspectionFrame frame;
+    UBKTestAssert(UBKInspectionNextFrame(buffer.bytes, buffer.length - 1, &frame) == 0);
+    UBKTestAssert(UBKInspectionNextFrame(buffer.bytes, buffer.length, &frame) == (int64_t)buffer.length);
+    UBKTestAssert(UBKInspectionTreeApplyFrame(&client, &frame));
+    UBKTestAssert(sameTrees(&client, &tree) && (client.sequence == 1));
+
+    buffer.length = 0;
+    bool hasChanges = false;
+    UBKTestAssert(UBKInspectionEncodeDelta(&buffer, &tree, &changedTree, &hasChanges) && hasChanges);
+    UBKTestAssert(buffer.length < snapshotLength / 4);
+    UBKTestAssert(UBKInspectionNextFrame(buffer.bytes, buffer.length, &frame) > 0);
+    UBKTestAssert(UBKInspectionTreeApplyFrame(&client, &frame));
+    UBKTestAssert(sameTrees(&client, &changedTree) && (client.sequence == 2));
+    //The delta was made from sequence 1
+    UBKTestAssert(!UBKInspectionTreeApplyFrame(&client, &frame));
+
+    //Cut short payloads are refused
+    for (size_t length = 0; length < frame.payloadLength; length++)
+    {
+        UBKInspectionFrame truncated = frame;
+        truncated.payloadLength = length;
+        UBKInspectionTree copy;
+        UBKInspectionTreeInit(&copy);
+        UBKTestAssert(UBKInspectionTreeCopy(&copy, &tree));
+        UBKTestAssert(!UBKInspectionTreeApplyFrame(&copy, &truncated));
+        UBKInspectionTreeDestroy(&copy);
+    }
+
+    buffer.length = 0;
+    UBKTestAssert(UBKInspectionEncodeDelta(&buffer, &changedTree, &changedTree, &hasChanges) && !hasChanges && (buffer.length == 0));
+
+    UBKTestAssert(UBKInspectionEncodeSetColour(&buffer, 77, 2, 0xAABBCCDD));
+    UBKTestAssert(UBKInspectionNextFrame(buffer.bytes, buffer.length, &frame) > 0);
+    UBKInspectionCommand command;
+    UBKTestAssert(UBKInspectionDecodeCommand(&frame, &command));
+    UBKTestAssert((command.type == UBKInspectionMessageSetColour) && (command.key == 77) && (command.colourIndex == 2) && (command.rgba == 0xAABBCCDD));
+
+    uint8_t broken[8] = { 0xFF, 0xFF, 0xFF, 0x7F, 1 };
+    UBKTestAssert(UBKInspectionNextFrame(broken, sizeof(broken), &frame) == -1);
+
+    UBKInspectionTreeDestroy(&tree);
+    UBKInspectionTreeDestroy(&changedTree);
+    UBKInspectionTreeDestroy(&client);
+    UBKInspectionBufferDestroy(&buffer);
+}
+
+static void testKeysAreMadeUnique(void)
+{
+    uint64_t keys[6] = { 5, 5, 0, 5, 0, 7 };
+    UBKTestAssert(UBKInspectionMakeKeysUnique(keys, 6));
+    UBKTestAssert((keys[0] == 5) && (keys[5] == 7));
+    for (int i = 0; i < 6; i++)
+    {
+        UBKTestAssert(keys[i] != 0);
+        for (int j = 0; j < i; j++)
+        {
+            UBKTestAssert(keys[i] != keys[j]);
+        }
+    }
+}
+
+typedef struct {
+    int fileDescriptor;
+    UBKInspectionBuffer input;
+    UBKInspectionTree tree;
+    int helloCount;
+    int snapshotCount;
+    int deltaCount;
+    int selectionCount;
+    uint64_t selection;
+} UBKTestClient;
+
+static void sleepMilliseconds(long milliseconds)
+{
+    struct timespec duration = { 0, milliseconds * 1000000L };
+    nanosleep(&duration, NULL);
+}
+
+static void connectClient(UBKTestClient *client, uint16_t port)
+{
+    memset(client, 0, sizeof(UBKTestClient));
+    UBKInspectionBufferInit(&client->input);
+    UBKInspectionTreeInit(&client->tree);
+    client->fileDescriptor = socket(AF_INET, SOCK_STREAM, 0);
+    UBKTestAssert(client->fileDescriptor >= 0);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    UBKTestAssert(connect(client->fileDescriptor, (struct sockaddr *)&address, sizeof(address)) == 0);
+}
+
+static void disconnectClient(UBKTestClient *client)
+{
+    close(client->fileDescriptor);
+    UBKInspectionBufferDestroy(&client->input);
+    UBKInspectionTreeDestroy(&client->tree);
+}
+
+//Polls the server and reads frames until nothing arrives for idleMilliseconds
+static void readFrames(UBKTestClient *client, UBKInspectionServer *server, int idleMilliseconds)
+{
+    int idle = 0;
+    while (idle < idleMilliseconds / 10)
+    {
+        UBKInspectionServerPoll(server, NULL, NULL);
+        struct pollfd pollDescriptor = { client->fileDescriptor, POLLIN, 0 };
+        if (poll(&pollDescriptor, 1, 10) <= 0)
+        {
+            idle++;
+            continue;
+        }
+        idle = 0;
+        uint8_t bytes[65536];
+        ssize_t received = recv(client->fileDescriptor, bytes, sizeof(bytes), 0);
+        if (received <= 0)
+        {
+            break;
+        }
+        if (client->input.length + (size_t)received > client->input.capacity)
+        {
+            client->input.capacity = (client->input.length + (size_t)received) * 2;
+            client->input.bytes = realloc(client->input.bytes, client->input.capacity);
+        }
+        memcpy(client->input.bytes + client->input.length, bytes, (size_t)received);
+        client->input.length += (size_t)received;
+
+        size_t offset = 0;
+        UBKInspectionFrame frame;
+        int64_t frameLength;
+        while ((frameLength = UBKInspectionNextFrame(client->input.bytes + offset, client->input.length - offset, &frame)) > 0)
+        {
+            offset += (size_t)frameLength;
+            if (frame.type == UBKInspectionMessageHello)
+            {
+                client->helloCount++;
+            }
+            else if (frame.type == UBKInspectionMessageSelection)
+            {
+                UBKInspectionCommand command;
+                UBKTestAssert(UBKInspectionDecodeCommand(&frame, &command));
+                client->selection = command.key;
+                client->selectionCount++;
+            }
+            else
+            {
+                UBKTestAssert(UBKInspectionTreeApplyFrame(&client->tree, &frame));
+                if (frame.type == UBKInspectionMessageSnapshot)
+                {
+                    client->snapshotCount++;
+                }
+                else
+                {
+                    client->deltaCount++;
+                }
+            }
+        }
+        UBKTestAssert(frameLength >= 0);
+        memmove(client->input.bytes, client->input.bytes + offset, client->input.length - offset);
+        client->input.length -= offset;
+    }
+}
+
+static UBKInspectionCommand lastCommand;
+static int commandCount;
+
+static void handleCommand(const UBKInspectionCommand *command, void *context)
+{
+    (void)context;
+    lastCommand = *command;
+    commandCount++;
+}
+
+static void pollServer(UBKInspectionServer *server, int times)
+{
+    for (int i = 0; i < times; i++)
+    {
+        sleepMilliseconds(2);
+        UBKInspectionServerPoll(server, handleCommand, NULL);
+    }
+}
+
+static void testLoopbackServer(void)
+{
+    UBKInspectionServer server;
+    UBKTestAssert(UBKInspectionServerOpen(&server, 0));
+    UBKTestAssert(server.port != 0);
+    UBKInspectionTree tree;
+    UBKInspectionTreeInit(&tree);
+    createTree(&tree, 200, false);
+    UBKTestAssert(UBKInspectionServerPublish(&server, &tree));
+
+    //A new client gets a hello and a snapshot
+    UBKTestClient client;
+    connectClient(&client, server.port);
+    readFrames(&client, &server, 200);
+    UBKTestAssert((client.helloCount == 1) && (client.snapshotCount == 1));
+    UBKTestAssert(sameTrees(&client.tree, &tree));
+
+    //Publishing the same screen sends nothing
+    uint64_t bytesSent = server.bytesSent;
+    for (int frame = 0; frame < 60; frame++)
+    {
+        createTree(&tree, 200, false);
+        UBKInspectionServerPublish(&server, &tree);
+        UBKInspectionServerPoll(&server, NULL, NULL);
+    }
+    UBKTestAssert(server.bytesSent == bytesSent);
+
+    createTree(&tree, 200, true);
+    UBKTestAssert(UBKInspectionServerPublish(&server, &tree));
+    readFrames(&client, &server, 200);
+    UBKTestAssert(client.deltaCount == 1);
+    UBKTestAssert(sameTrees(&client.tree, &tree));
+
+    //A second of one node moving at 60Hz
+    bytesSent = server.bytesSent;
+    for (int frame = 0; frame < 60; frame++)
+    {
+        createTree(&tree, 200, false);
+        tree.nodes[10].x = (float)frame;
+        UBKInspectionServerPublish(&server, &tree);
+        UBKInspectionServerPoll(&server, NULL, NULL);
+    }
+    readFrames(&client, &server, 200);
+    UBKTestAssert(sameTrees(&client.tree, &tree));
+    UBKTestAssert(server.bytesSent - bytesSent < 60 * 64);
+
+    //Commands sent a byte at a time still arrive whole
+    UBKInspectionBuffer commands;
+    UBKInspectionBufferInit(&commands);
+    UBKInspectionEncodeSelect(&commands, 1005);
+    UBKInspectionEncodeSetColour(&commands, 1006, 1, 0x00FF00FF);
+    UBKInspectionEncodeRequestSnapshot(&commands);
+    for (size_t i = 0; i < commands.length; i++)
+    {
+        UBKTestAssert(send(client.fileDescriptor, commands.bytes + i, 1, 0) == 1);
+        UBKInspectionServerPoll(&server, handleCommand, NULL);
+    }
+    pollServer(&server, 20);
+    UBKTestAssert((commandCount == 3) && (lastCommand.type == UBKInspectionMessageRequestSnapshot));
+    UBKInspectionBufferDestroy(&commands);
+
+    UBKInspectionServerSendSelection(&server, 1005);
+    readFrames(&client, &server, 200);
+    UBKTestAssert((client.snapshotCount == 2) && (client.selectionCount == 1) && (client.selection == 1005));
+    UBKTestAssert(sameTrees(&client.tree, &tree));
+
+    //A client that doesn't read falls behind, then catches up with a snapshot
+    server.maximumPendingOutput = 4096;
+    UBKTestClient slowClient;
+    connectClient(&slowClient, server.port);
+    pollServer(&server, 10);
+    for (int frame = 0; frame < 3000; frame++)
+    {
+        createTree(&tree, 2000, frame & 1);
+        for (uint32_t i = 0; i < tree.count; i++)
+        {
+            tree.nodes[i].x += (float)frame;
+        }
+        UBKInspectionServerPublish(&server, &tree);
+        UBKInspectionServerPoll(&server, NULL, NULL);
+    }
+    readFrames(&slowClient, &server, 2000);
+    readFrames(&client, &server, 2000);
+    UBKTestAssert(sameTrees(&slowClient.tree, &tree));
+    UBKTestAssert(sameTrees(&client.tree, &tree));
+    UBKTestAssert(slowClient.snapshotCount > 1);
+
+    //Closed connections are dropped
+    disconnectClient(&slowClient);
+    pollServer(&server, 10);
+    UBKTestAssert(server.connectionCount == 1);
+    disconnectClient(&client);
+    for (int i = 0; i < 10; i++)
+    {
+        sleepMilliseconds(1);
+        createTree(&tree, 10, false);
+        UBKInspectionServerPublish(&server, &tree);
+        UBKInspectionServerPoll(&server, NULL, NULL);
+    }
+    UBKTestAssert(server.connectionCount == 0);
+
+    UBKInspectionServerClose(&server);
+    UBKInspectionTreeDestroy(&tree);
+}
+
+int main(void)
+{
+    testDeltasRebuildTheTree();
+    testKeysAreMadeUnique();
+    testLoopbackServer();
+    return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ File: UBKLabelsTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKLabels.h"
+#include "UBKCoreTests.h"
+
+#include <string.h>
+
+static void testLabelsAreComparedAsWords(void)
+{
+    UBKTestAssert(UBKLabelHash("settingsButton", false) == UBKLabelHash("Settings button", false));
+    UBKTestAssert(UBKLabelHash("settings_button", false) == UBKLabelHash("  settings   BUTTON!", false));
+    UBKTestAssert(UBKLabelHash("settings", false) != UBKLabelHash("settings button", false));
+    UBKTestAssert(UBKLabelHash("icon_close", false) != UBKLabelHash("iconclose", false));
+    UBKTestAssert(UBKLabelHash("UIButton", true) == UBKLabelHash("Button", false));
+    UBKTestAssert(UBKLabelHash("UBKMoreButton", true) == UBKLabelHash("more button", false));
+    UBKTestAssert(UBKLabelHash("UIButton", false) == UBKLabelHash("ui button", false));
+    UBKTestAssert((UBKLabelHash("", false) == 0) && (UBKLabelHash("...", false) == 0) && (UBKLabelHash(NULL, false) == 0) && (UBKLabelHash("Button", true) == 0));
+    UBKTestAssert(UBKLabelHash("Caf\xc3\xa9", false) != 0);
+
+    UBKTestAssert(UBKLabelIsCodeLike("icon_close") && UBKLabelIsCodeLike("settingsButton") && UBKLabelIsCodeLike("login.title"));
+    UBKTestAssert(!UBKLabelIsCodeLike("Close") && !UBKLabelIsCodeLike("OK") && !UBKLabelIsCodeLike("Dr. Who") && !UBKLabelIsCodeLike("3.5 stars") && !UBKLabelIsCodeLike("v2.0"));
+}
+
+static void testDuplicatesAndEchoedNames(void)
+{
+    UBKLabelNode nodes[5];
+    memset(nodes, 0, sizeof(nodes));
+    for (int i = 0; i < 3; i++)
+    {
+        nodes[i].label = UBKLabelHash("More", false);
+        nodes[i].isInteractive = true;
+    }
+    //A hint makes the third "More" sound different
+    nodes[2].context = UBKLabelHash("About fees", false);
+    nodes[3].label = UBKLabelHash("icon_close", false);
+    nodes[3].labelIsCodeLike = true;
+    nodes[3].names[UBKLabelNameImage] = UBKLabelHash("icon-close", false);
+    nodes[4].label = UBKLabelHash("Button", false);
+    nodes[4].names[UBKLabelNameClassWithoutPrefix] = UBKLabelHash("UIButton", true);
+    nodes[4].isInteractive = true;
+
+    UBKLabelResult results[5];
+    UBKTestAssert(UBKLabelsAnalyse(nodes, 5, results));
+    UBKTestAssert((results[0].flags == UBKLabelFlagDuplicate) && (results[1].firstDuplicate == 0) && (results[1].duplicateCount == 2));
+    UBKTestAssert(results[2].flags == 0);
+    UBKTestAssert((results[3].flags == UBKLabelFlagEchoesName) && (results[3].echoedName == UBKLabelNameImage));
+    UBKTestAssert(results[4].flags == UBKLabelFlagEchoesName);
+
+    //An image name only counts when the label looks like code too
+    nodes[3].labelIsCodeLike = false;
+    UBKTestAssert(UBKLabelsAnalyse(nodes, 5, results));
+    UBKTestAssert(results[3].flags == 0);
+}
+
+//Random labels checked against comparing every pair of nodes
+static void testDuplicatesMatchPairwiseComparison(void)
+{
+    srand(2);
+    for (int round = 0; round < 200; round++)
+    {
+        size_t count = rand() % 300;
+        UBKLabelNode *nodes = calloc(count + 1, sizeof(UBKLabelNode));
+        UBKLabelResult *results = malloc((count + 1) * sizeof(UBKLabelResult));
+        for (size_t i = 0; i < count; i++)
+        {
+            nodes[i].label = rand() % 6;
+            nodes[i].context = rand() % 3;
+            nodes[i].isInteractive = (rand() % 3 != 0);
+        }
+        UBKTestAssert(UBKLabelsAnalyse(nodes, count, results));
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t duplicateCount = 0;
+            long firstDuplicate = -1;
+            for (size_t j = 0; (j < count) && (nodes[i].label != 0) && nodes[i].isInteractive; j++)
+            {
+                if (nodes[j].isInteractive && (nodes[j].label == nodes[i].label) && (nodes[j].context == nodes[i].context))
+                {
+                    duplicateCount++;
+                    firstDuplicate = (firstDuplicate < 0) ? (long)j : firstDuplicate;
+                }
+            }
+            if (duplicateCount > 1)
+            {
+                UBKTestAssert((results[i].flags & UBKLabelFlagDuplicate) && (results[i].duplicateCount == duplicateCount) && (results[i].firstDuplicate == firstDuplicate));
+            }
+            else
+            {
+                UBKTestAssert(!(results[i].flags & UBKLabelFlagDuplicate));
+            }
+        }
+        free(nodes);
+        free(results);
+    }
+}
+
+int main(void)
+{
+    testLabelsAreComparedAsWords();
+    testDuplicatesAndEchoedNames();
+    testDuplicatesMatchPairwiseComparison();
+    return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ File: UBKMetricsTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKMetrics.h"
+#include "UBKCoreTests.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/socket.h>
+
+static const char *typeNameValues[] = { "disabled", NULL, "label" };
+static const UBKMetricsTypeNames typeNames = { typeNameValues, 3 };
+
+static UBKMetricsRefresh makeRefresh(void)
+{
+    UBKMetricsRefresh refresh;
+    memset(&refresh, 0, sizeof(refresh));
+    refresh.nodes = 120;
+    refresh.elements = 40;
+    refresh.rulesRun = 12;
+    refresh.cacheHits = 100;
+    refresh.cacheMisses = 20;
+    refresh.duration = 0.012;
+    refresh.warningsByType[2] = 3;
+    refresh.warningsByType[7] = 2;
+    refresh.warningsByLevel[0] = 4;
+    refresh.warningsByLevel[1] = 1;
+    return refresh;
+}
+
+static void testPrometheusText(void)
+{
+    UBKMetrics metrics;
+    UBKMetricsInit(&metrics);
+    UBKMetricsRefresh refresh = makeRefresh();
+    UBKMetricsRecordRefresh(&metrics, &refresh);
+    refresh.duration = 2;
+    refresh.warningsByType[2] = 1;
+    UBKMetricsRecordRefresh(&metrics, &refresh);
+
+    char text[8192];
+    size_t neededLength = UBKMetricsFormatPrometheus(&metrics, "ubk", typeNames, NULL, 0);
+    size_t length = UBKMetricsFormatPrometheus(&metrics, "ubk", typeNames, text, sizeof(text));
+    UBKTestAssert((neededLength == length) && (length == strlen(text)));
+    UBKTestAssert(strstr(text, "ubk_refreshes_total 2\n") != NULL);
+    UBKTestAssert(strstr(text, "ubk_warnings_found_total{type=\"label\"} 4\n") != NULL);
+    //Types without a name use their number
+    UBKTestAssert(strstr(text, "ubk_warnings_found_total{type=\"7\"} 4\n") != NULL);
+    //Gauges are from the last refresh
+    UBKTestAssert(strstr(text, "ubk_warnings{type=\"label\"} 1\n") != NULL);
+    UBKTestAssert(strstr(text, "ubk_warnings{type=\"disabled\"} 0\n") != NULL);
+    UBKTestAssert(strstr(text, "ubk_refresh_duration_seconds_bucket{le=\"0.0167\"} 1\n") != NULL);
+    UBKTestAssert(strstr(text, "ubk_refresh_duration_seconds_bucket{le=\"1\"} 1\n") != NULL);
+    UBKTestAssert(strstr(text, "ubk_refresh_duration_seconds_bucket{le=\"+Inf\"} 2\n") != NULL);
+    UBKTestAssert(strstr(text, "ubk_refresh_duration_seconds_count 2\n") != NULL);
+
+    //Cut short but still terminated, and the full length is returned
+    char shortText[32];
+    UBKTestAssert(UBKMetricsFormatPrometheus(&metrics, "ubk", typeNames, shortText, sizeof(shortText)) == length);
+    UBKTestAssert(strlen(shortText) == sizeof(shortText) - 1);
+}
+
+static void testStatsDOverUDP(void)
+{
+    UBKMetrics metrics;
+    UBKMetricsInit(&metrics);
+    UBKMetricsRefresh refresh = makeRefresh();
+    refresh.duration = 2;
+    UBKMetricsRecordRefresh(&metrics, &refresh);
+    char text[8192];
+    size_t length = UBKMetricsFormatStatsD(&refresh, "ubk", typeNames, text, sizeof(text));
+    UBKTestAssert(strstr(text, "ubk.refreshes:1|c\n") != NULL);
+    UBKTestAssert(strstr(text, "ubk.refresh_duration:2000.000|ms\n") != NULL);
+    UBKTestAssert(strstr(text, "ubk.warnings.type.label:3|g\n") != NULL);
+    UBKTestAssert(strstr(text, "ubk.warnings.type.7:2|g\n") != NULL);
+
+    //A listener on a free loopback port
+    int listener = socket(AF_INET, SOCK_DGRAM, 0);
+    UBKTestAssert(listener >= 0);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    UBKTestAssert(bind(listener, (struct sockaddr *)&address, sizeof(address)) == 0);
+    socklen_t addressLength = sizeof(address);
+    UBKTestAssert(getsockname(listener, (struct sockaddr *)&address, &addressLength) == 0);
+
+    UBKMetricsSink sink;
+    UBKTestAssert(UBKMetricsSinkOpenUDP(&sink, "127.0.0.1", ntohs(address.sin_port)));
+    UBKTestAssert(UBKMetricsSinkWrite(&sink, text, length));
+    char received[2048];
+    ssize_t receivedLength = recv(listener, received, sizeof(received) - 1, 0);
+    UBKTestAssert(receivedLength == (ssize_t)length);
+    received[receivedLength] = '\0';
+    UBKTestAssert(strcmp(received, text) == 0);
+
+    //Text longer than a datagram is split between lines
+    length = UBKMetricsFormatPrometheus(&metrics, "ubk", typeNames, text, sizeof(text));
+    UBKTestAssert(UBKMetricsSinkWrite(&sink, text, length));
+    size_t total = 0;
+    int datagrams = 0;
+    while (total < length)
+    {
+        receivedLength = recv(listener, received, sizeof(received), 0);
+        UBKTestAssert((receivedLength > 0) && (receivedLength <= 1432) && (received[receivedLength - 1] == '\n'));
+        UBKTestAssert(memcmp(received, text + total, (size_t)receivedLength) == 0);
+        total += (size_t)receivedLength;
+        datagrams++;
+    }
+    UBKTestAssert((total == length) && (datagrams > 1));
+    UBKMetricsSinkClose(&sink);
+    close(listener);
+}
+
+static void testFileSinks(void)
+{
+    char path[256];
+    char line[64];
+    UBKTestTemporaryPath(path, sizeof(path), "UBKMetricsTests.prom");
+
+    //Replaced on every write, so a scraper never reads half a file
+    UBKMetricsSink sink;
+    UBKTestAssert(UBKMetricsSinkOpenFile(&sink, path, true));
+    UBKTestAssert(UBKMetricsSinkWrite(&sink, "a 1\n", 4));
+    UBKTestAssert(UBKMetricsSinkWrite(&sink, "b 2\n", 4));
+    UBKMetricsSinkClose(&sink);
+    FILE *file = fopen(path, "r");
+    UBKTestAssert(file != NULL);
+    size_t length = fread(line, 1, sizeof(line), file);
+    fclose(file);
+    UBKTestAssert((length == 4) && (memcmp(line, "b 2\n", 4) == 0));
+    char temporaryPath[300];
+    snprintf(temporaryPath, sizeof(temporaryPath), "%s.tmp", path);
+    UBKTestAssert(access(temporaryPath, F_OK) != 0);
+    unlink(path);
+
+    //Appended to
+    UBKTestAssert(UBKMetricsSinkOpenFile(&sink, path, false));
+    UBKTestAssert(UBKMetricsSinkWrite(&sink, "a:1|c\n", 6));
+    UBKTestAssert(UBKMetricsSinkWrite(&sink, "b:1|c\n", 6));
+    UBKMetricsSinkClose(&sink);
+    file = fopen(path, "r");
+    UBKTestAssert(file != NULL);
+    length = fread(line, 1, sizeof(line), file);
+    fclose(file);
+    UBKTestAssert(length == 12);
+    unlink(path);
+
+    UBKTestAssert(!UBKMetricsSinkOpenFile(&sink, "/nonexistent/directory/metrics", false));
+}
+
+static UBKMetrics sharedMetrics;
+
+static void *recordRefreshes(void *argument)
+{
+    UBKMetricsRefresh refresh;
+    memset(&refresh, 0, sizeof(refresh));
+    refresh.nodes = 10;
+    refresh.elements = 4;
+    refresh.duration = 0.003;
+    refresh.warningsByType[2] = 1;
+    refresh.warningsByLevel[0] = 1;
+    for (int i = 0; i < 100000; i++)
+    {
+        UBKMetricsRecordRefresh(&sharedMetrics, &refresh);
+    }
+    return argument;
+}
+
+static void testConcurrentRecording(void)
+{
+    UBKMetricsInit(&sharedMetrics);
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++)
+    {
+        UBKTestAssert(pthread_create(&threads[i], NULL, recordRefreshes, NULL) == 0);
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    UBKMetrics metrics;
+    UBKMetricsRead(&sharedMetrics, &metrics);
+    UBKTestAssert(metrics.counters[UBKMetricsCounterRefreshes] == 400000);
+    UBKTestAssert(metrics.counters[UBKMetricsCounterNodesScanned] == 4000000);
+    UBKTestAssert(metrics.warningsByType[2] == 400000);
+    UBKTestAssert(metrics.durationBuckets[2] == 400000);
+}
+
+int main(void)
+{
+    testPrometheusText();
+    testStatsDOverUDP();
+    testFileSinks();
+    testConcurrentRecording();
+    return 0;
+}
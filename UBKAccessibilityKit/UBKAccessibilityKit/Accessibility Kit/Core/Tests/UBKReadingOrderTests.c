@@ -0,0 +1,132 @@
+/*
+ File: UBKReadingOrderTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKReadingOrder.h"
+#include "UBKCoreTests.h"
+
+static void testRowsAreReadInOrder(void)
+{
+    //Two rows, A B then C D, added to the hierarchy as D A B C, then a group with one member
+    UBKReadingOrderNode nodes[6] = {
+        { { 100, 50, 40, 20 }, -1, false },
+        { { 0, 0, 40, 20 }, -1, false },
+        { { 100, 0, 40, 20 }, -1, false },
+        { { 0, 50, 40, 20 }, -1, false },
+        { { 0, 100, 200, 40 }, -1, true },
+        { { 150, 105, 20, 20 }, 4, false },
+    };
+    uint32_t expectedOrder[6];
+    size_t elementCount = 0;
+    UBKReadingOrderResult results[6];
+    UBKTestAssert(UBKReadingOrderAnalyse(nodes, 6, false, expectedOrder, &elementCount, results));
+    UBKTestAssert(elementCount == 5);
+    uint32_t leftToRight[5] = { 1, 2, 3, 0, 5 };
+    for (size_t i = 0; i < elementCount; i++)
+    {
+        UBKTestAssert(expectedOrder[i] == leftToRight[i]);
+    }
+    //Only D is read out of place
+    UBKTestAssert((results[0].position == 3) && (results[0].flags & UBKReadingOrderFlagOutOfOrder));
+    for (int i = 1; i < 6; i++)
+    {
+        UBKTestAssert(!(results[i].flags & UBKReadingOrderFlagOutOfOrder));
+    }
+    UBKTestAssert(results[4].position == -1);
+
+    UBKTestAssert(UBKReadingOrderAnalyse(nodes, 6, true, expectedOrder, &elementCount, results));
+    uint32_t rightToLeft[5] = { 2, 1, 0, 3, 5 };
+    for (size_t i = 0; i < elementCount; i++)
+    {
+        UBKTestAssert(expectedOrder[i] == rightToLeft[i]);
+    }
+}
+
+//The elements left in order are always a longest increasing run of positions
+static void testOutOfOrderElementsAreTheFewest(void)
+{
+    srand(3);
+    for (int round = 0; round < 2000; round++)
+    {
+        int count = 1 + rand() % 40;
+        UBKReadingOrderNode nodes[40];
+        for (int i = 0; i < count; i++)
+        {
+            nodes[i].frame = (UBKRect){ rand() % 300, rand() % 600, 10 + rand() % 80, 10 + rand() % 60 };
+            nodes[i].isGroup = (rand() % 8 == 0);
+            nodes[i].group = -1;
+            if ((i > 0) && (rand() % 3 == 0))
+            {
+                int group = rand() % i;
+                nodes[i].group = nodes[group].isGroup ? group : -1;
+            }
+        }
+        uint32_t expectedOrder[40];
+        size_t elementCount = 0;
+        UBKReadingOrderResult results[40];
+        UBKTestAssert(UBKReadingOrderAnalyse(nodes, count, rand() % 2, expectedOrder, &elementCount, results));
+
+        int positions[40];
+        int positionCount = 0;
+        for (int i = 0; i < count; i++)
+        {
+            if (!nodes[i].isGroup)
+            {
+                UBKTestAssert(results[i].position >= 0);
+                positions[positionCount++] = results[i].position;
+            }
+        }
+        UBKTestAssert((size_t)positionCount == elementCount);
+
+        int longest = 0;
+        int lengths[40];
+        for (int i = 0; i < positionCount; i++)
+        {
+            lengths[i] = 1;
+            for (int j = 0; j < i; j++)
+            {
+                if ((positions[j] < positions[i]) && (lengths[j] + 1 > lengths[i]))
+                {
+                    lengths[i] = lengths[j] + 1;
+                }
+            }
+            longest = (lengths[i] > longest) ? lengths[i] : longest;
+        }
+        int inOrder = 0;
+        int lastPosition = -1;
+        for (int i = 0; i < count; i++)
+        {
+            if (!nodes[i].isGroup && !(results[i].flags & UBKReadingOrderFlagOutOfOrder))
+            {
+                UBKTestAssert(results[i].position > lastPosition);
+                lastPosition = results[i].position;
+                inOrder++;
+            }
+        }
+        UBKTestAssert(inOrder == longest);
+    }
+}
+
+int main(void)
+{
+    testRowsAreReadInOrder();
+    testOutOfOrderElementsAreTheFewest();
+    return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ File: UBKRuleProfileTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKRuleProfile.h"
+#include "UBKCoreTests.h"
+
+//The ratings the inspector gave before the profiles were added
+static UBKRuleRating expectedTextRating(double contrast, double textSize, bool boldFont)
+{
+    if ((contrast == 0) && (textSize == 0))
+    {
+        return UBKRuleRatingNA;
+    }
+    if (((textSize >= 18.66) && boldFont) || (textSize >= 24))
+    {
+        if (contrast >= 4.5)
+        {
+            return UBKRuleRatingAAALarge;
+        }
+        if (contrast >= 3)
+        {
+            return UBKRuleRatingAALarge;
+        }
+    }
+    else
+    {
+        if (contrast >= 7)
+        {
+            return UBKRuleRatingAAA;
+        }
+        if (contrast >= 4.5)
+        {
+            return UBKRuleRatingAA;
+        }
+    }
+    return UBKRuleRatingFail;
+}
+
+static void testProfilesMatchTheStandards(void)
+{
+    const UBKRuleEvaluator *wcag20 = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG20);
+    const UBKRuleEvaluator *wcag21 = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG21);
+    const UBKRuleEvaluator *wcag22 = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG22);
+    UBKRuleEvaluator custom = UBKRuleEvaluatorMakeCustom(wcag21->thresholds);
+    UBKTestAssert(UBKRuleEvaluatorForProfile(UBKRuleProfileCustom) == NULL);
+
+    srand(1);
+    for (int i = 0; i < 200000; i++)
+    {
+        double contrast = (i % 50 == 0) ? 0 : (rand() % 2200) / 100.0;
+        double textSize = (i % 70 == 0) ? 0 : (rand() % 4000) / 100.0;
+        bool boldFont = rand() & 1;
+        UBKRuleRating rating = expectedTextRating(contrast, textSize, boldFont);
+        UBKTestAssert(UBKRuleEvaluatorTextContrastRating(wcag20, contrast, textSize, boldFont) == rating);
+        UBKTestAssert(UBKRuleEvaluatorTextContrastRating(wcag21, contrast, textSize, boldFont) == rating);
+        UBKTestAssert(UBKRuleEvaluatorTextContrastRating(wcag22, contrast, textSize, boldFont) == rating);
+        UBKTestAssert(UBKRuleEvaluatorTextContrastRating(&custom, contrast, textSize, boldFont) == rating);
+
+        //Non text contrast was added in 2.1
+        UBKRuleRating nonTextRating = (contrast >= 4.5) ? UBKRuleRatingAAA : ((contrast >= 3) ? UBKRuleRatingAA : UBKRuleRatingFail);
+        UBKTestAssert(UBKRuleEvaluatorNonTextContrastRating(wcag21, contrast) == nonTextRating);
+        UBKTestAssert(UBKRuleEvaluatorNonTextContrastRating(&custom, contrast) == nonTextRating);
+        UBKTestAssert(UBKRuleEvaluatorNonTextContrastRating(wcag20, contrast) == UBKRuleRatingNA);
+
+        double width = rand() % 60;
+        double height = rand() % 60;
+        UBKTestAssert(UBKRuleEvaluatorIsBelowMinimumTargetSize(wcag21, width, height) == ((width < 44) || (height < 44)));
+        UBKTestAssert(UBKRuleEvaluatorIsBelowMinimumTargetSize(wcag22, width, height) == ((width < 24) || (height < 24)));
+        UBKTestAssert(!UBKRuleEvaluatorIsBelowMinimumTargetSize(wcag20, width, height));
+    }
+}
+
+static void testCustomThresholds(void)
+{
+    UBKRuleThresholds thresholds = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG22)->thresholds;
+    thresholds.textAAA = 0;
+    thresholds.minimumTargetSize = 30;
+    UBKRuleEvaluator custom = UBKRuleEvaluatorMakeCustom(thresholds);
+    //Without an AAA threshold the best rating is AA
+    UBKTestAssert(UBKRuleEvaluatorTextContrastRating(&custom, 10, 12, false) == UBKRuleRatingAA);
+    UBKTestAssert(UBKRuleEvaluatorIsBelowMinimumTargetSize(&custom, 29, 40));
+    UBKTestAssert(!UBKRuleEvaluatorIsBelowMinimumTargetSize(&custom, 30, 30));
+}
+
+int main(void)
+{
+    testProfilesMatchTheStandards();
+    testCustomThresholds();
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ File: UBKSamplingTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKSampling.h"
+#include "UBKCoreTests.h"
+
+#include <math.h>
+
+static void testSampleRateIsRepeatable(void)
+{
+    UBKSamplingConfiguration configuration = UBKSamplingDefaultConfiguration();
+    configuration.budget = 1;
+    UBKSamplingGovernor governor;
+    UBKSamplingGovernor repeat;
+    UBKSamplingGovernorInit(&governor, &configuration, 7, 0);
+    UBKSamplingGovernorInit(&repeat, &configuration, 7, 0);
+    for (int appearance = 1; appearance <= 10000; appearance++)
+    {
+        UBKTestAssert(UBKSamplingGovernorScreenDidAppear(&governor, appearance) == UBKSamplingGovernorScreenDidAppear(&repeat, appearance));
+    }
+    //About 10% are sampled, the rest are skipped by the rate
+    double sampled = (double)governor.decisionCounts[UBKSamplingDecisionSample];
+    UBKTestAssert(fabs(sampled / 10000 - 0.1) < 0.02);
+    UBKTestAssert(governor.decisionCounts[UBKSamplingDecisionSample] + governor.decisionCounts[UBKSamplingDecisionSkipRate] == 10000);
+}
+
+static void testCreditLimitsTheAudits(void)
+{
+    UBKSamplingConfiguration configuration = UBKSamplingDefaultConfiguration();
+    UBKSamplingGovernor governor;
+    UBKSamplingGovernorInit(&governor, &configuration, 1, 0);
+    //Nothing straight after launch
+    UBKTestAssert(UBKSamplingGovernorAvailableTime(&governor, 0) == 0);
+
+    //0.5% of a second is 5ms, and the credit stops at 50ms
+    UBKTestAssert(fabs(UBKSamplingGovernorAvailableTime(&governor, 1) - 0.005) < 1e-9);
+    UBKTestAssert(fabs(UBKSamplingGovernorAvailableTime(&governor, 100) - 0.05) < 1e-9);
+
+    //The first audit has no estimate, then audits wait until the credit covers theirs
+    UBKTestAssert(UBKSamplingGovernorCanAudit(&governor, 1000, 100));
+    UBKSamplingGovernorRecordAudit(&governor, 1000, 0.02);
+    UBKTestAssert(fabs(UBKSamplingGovernorEstimatedAuditCost(&governor, 2000) - 0.04) < 1e-9);
+    UBKTestAssert(!UBKSamplingGovernorCanAudit(&governor, 2000, 100));
+    UBKTestAssert(UBKSamplingGovernorCanAudit(&governor, 2000, 103));
+
+    //An overdraw is paid back before anything else runs
+    UBKSamplingGovernorSpend(&governor, 0.1);
+    UBKTestAssert(UBKSamplingGovernorAvailableTime(&governor, 103) == 0);
+    UBKTestAssert(!UBKSamplingGovernorCanAudit(&governor, 1, 110));
+    UBKTestAssert(UBKSamplingGovernorCanAudit(&governor, 1, 120));
+    UBKTestAssert(fabs(governor.spentTime - 0.12) < 1e-9);
+
+    //An audit estimated at 60ms never fits in 50ms of credit
+    UBKTestAssert(UBKSamplingGovernorIsAuditTooExpensive(&governor, 3000) && !UBKSamplingGovernorIsAuditTooExpensive(&governor, 2000));
+    UBKTestAssert(!UBKSamplingGovernorCanAudit(&governor, 3000, 1000));
+}
+
+static void testSlowFramesBackOff(void)
+{
+    UBKSamplingConfiguration configuration = UBKSamplingDefaultConfiguration();
+    configuration.sampleRate = 1;
+    UBKSamplingGovernor governor;
+    UBKSamplingGovernorInit(&governor, &configuration, 1, 0);
+    UBKTestAssert(!UBKSamplingGovernorRecordFrame(&governor, 0.016, 10));
+    UBKTestAssert(UBKSamplingGovernorRecordFrame(&governor, 0.1, 10));
+    UBKTestAssert(UBKSamplingGovernorIsBackingOff(&governor, 11) && !UBKSamplingGovernorIsBackingOff(&governor, 12));
+    UBKTestAssert(UBKSamplingGovernorScreenDidAppear(&governor, 11) == UBKSamplingDecisionSkipBackoff);
+    UBKTestAssert(UBKSamplingGovernorScreenDidAppear(&governor, 12) == UBKSamplingDecisionSample);
+
+    //Slow again soon after, the back off doubles
+    UBKTestAssert(UBKSamplingGovernorRecordFrame(&governor, 0.1, 13));
+    UBKTestAssert(UBKSamplingGovernorIsBackingOff(&governor, 16.5) && !UBKSamplingGovernorIsBackingOff(&governor, 17));
+    for (int i = 0; i < 20; i++)
+    {
+        double now = governor.backoffUntil;
+        UBKSamplingGovernorRecordFrame(&governor, 0.1, now);
+    }
+    UBKTestAssert(governor.backoff == configuration.maximumBackoff);
+}
+
+int main(void)
+{
+    testSampleRateIsRepeatable();
+    testCreditLimitsTheAudits();
+    testSlowFramesBackOff();
+    return 0;
+}
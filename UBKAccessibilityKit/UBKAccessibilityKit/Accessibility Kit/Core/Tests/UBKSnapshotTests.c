@@ -0,0 +1,130 @@
+/*
+ File: UBKSnapshotTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKSnapshot.h"
+#include "UBKHash.h"
+#include "UBKCoreTests.h"
+
+static int32_t pushNode(UBKSnapshot *snapshot, uint64_t classHash, uint64_t identifierHash, double y)
+{
+    UBKSnapshotNode node = {0};
+    node.classHash = classHash;
+    node.identifierHash = identifierHash;
+    node.nodeHash = UBKHashCombine(classHash, identifierHash);
+    node.frame = (UBKRect){0, y, 100, 20};
+    return UBKSnapshotPushNode(snapshot, &node);
+}
+
+//A list with three rows, the last one has an identifier
+static void createList(UBKSnapshot *snapshot, double offset)
+{
+    uint64_t noIdentifier = UBKHashInitialValue;
+    pushNode(snapshot, 1, noIdentifier, 0);
+    for (int row = 0; row < 3; row++)
+    {
+        pushNode(snapshot, 2, (row == 2) ? 99 : noIdentifier, offset + row * 20);
+        pushNode(snapshot, 3, noIdentifier, offset + row * 20);
+        UBKSnapshotPopNode(snapshot);
+        UBKSnapshotPopNode(snapshot);
+    }
+    UBKSnapshotPopNode(snapshot);
+}
+
+static void testTreeIsFilledIn(void)
+{
+    UBKSnapshot snapshot;
+    UBKSnapshotInit(&snapshot);
+    createList(&snapshot, 0);
+    UBKTestAssert((snapshot.count == 7) && (snapshot.currentParent == -1));
+    UBKTestAssert((snapshot.nodes[0].parent == -1) && (snapshot.nodes[0].subtreeEnd == 7));
+    UBKTestAssert((snapshot.nodes[3].parent == 0) && (snapshot.nodes[3].depth == 1) && (snapshot.nodes[3].subtreeEnd == 5));
+    UBKTestAssert((snapshot.nodes[4].parent == 3) && (snapshot.nodes[4].depth == 2));
+
+    //The same rows give the same subtree hash, the row with an identifier doesn't
+    UBKTestAssert(snapshot.nodes[1].subtreeHash == snapshot.nodes[3].subtreeHash);
+    UBKTestAssert(snapshot.nodes[1].subtreeHash != snapshot.nodes[5].subtreeHash);
+
+    //Rebuilding the subtree hashes gives the same values as the walk
+    uint64_t rootHash = snapshot.nodes[0].subtreeHash;
+    UBKSnapshotUpdateSubtreeHashes(&snapshot);
+    UBKTestAssert(snapshot.nodes[0].subtreeHash == rootHash);
+
+    //A value combined after the walk reaches the ancestors
+    UBKSnapshotCombineNodeHash(&snapshot, 4, 42);
+    UBKSnapshotUpdateSubtreeHashes(&snapshot);
+    UBKTestAssert(snapshot.nodes[0].subtreeHash != rootHash);
+    UBKTestAssert(snapshot.nodes[3].subtreeHash != snapshot.nodes[1].subtreeHash);
+    UBKSnapshotDestroy(&snapshot);
+}
+
+static void testKeysAndFingerprintIgnoreFrames(void)
+{
+    UBKSnapshot snapshot;
+    UBKSnapshot scrolled;
+    UBKSnapshotInit(&snapshot);
+    UBKSnapshotInit(&scrolled);
+    createList(&snapshot, 0);
+    createList(&scrolled, 300);
+    UBKTestAssert(UBKSnapshotFingerprint(&snapshot) == UBKSnapshotFingerprint(&scrolled));
+
+    uint64_t keys[7];
+    uint64_t scrolledKeys[7];
+    UBKSnapshotElementKeys(&snapshot, keys);
+    UBKSnapshotElementKeys(&scrolled, scrolledKeys);
+    for (int index = 0; index < 7; index++)
+    {
+        UBKTestAssert(keys[index] == scrolledKeys[index]);
+    }
+    //Rows without an identifier share a key, the frames tell them apart
+    UBKTestAssert((keys[1] == keys[3]) && (keys[2] == keys[4]));
+    UBKTestAssert((keys[5] != keys[1]) && (keys[6] != keys[2]) && (keys[1] != keys[2]));
+
+    //Another screen with the same views has another fingerprint
+    scrolled.screenHash = 5;
+    UBKTestAssert(UBKSnapshotFingerprint(&snapshot) != UBKSnapshotFingerprint(&scrolled));
+    UBKSnapshotDestroy(&snapshot);
+    UBKSnapshotDestroy(&scrolled);
+}
+
+static void testHashSet(void)
+{
+    UBKHashSet set;
+    UBKTestAssert(UBKHashSetInit(&set, 4));
+    for (uint64_t value = 0; value < 1000; value++)
+    {
+        UBKTestAssert(UBKHashSetInsert(&set, value * 7919));
+    }
+    UBKTestAssert(!UBKHashSetInsert(&set, 7919));
+    UBKTestAssert(set.count == 1000);
+    UBKTestAssert(UBKHashSetContains(&set, 0) && UBKHashSetContains(&set, 999 * 7919) && !UBKHashSetContains(&set, 1));
+    UBKHashSetRemoveAll(&set);
+    UBKTestAssert((set.count == 0) && !UBKHashSetContains(&set, 7919));
+    UBKHashSetDestroy(&set);
+    UBKTestAssert(UBKHashString(UBKHashInitialValue, "a") != UBKHashString(UBKHashInitialValue, "b"));
+}
+
+int main(void)
+{
+    testTreeIsFilledIn();
+    testKeysAndFingerprintIgnoreFrames();
+    testHashSet();
+    return 0;
+}
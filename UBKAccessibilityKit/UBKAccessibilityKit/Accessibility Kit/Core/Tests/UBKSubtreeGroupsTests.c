@@ -0,0 +1,101 @@
+/*
+ File: UBKSubtreeGroupsTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKSubtreeGroups.h"
+#include "UBKCoreTests.h"
+
+static void pushNode(UBKSnapshot *snapshot, uint64_t structureHash)
+{
+    UBKSnapshotNode node = {0};
+    node.structureHash = structureHash;
+    node.nodeHash = structureHash;
+    node.flags = UBKSnapshotNodeFlagElement;
+    UBKTestAssert(UBKSnapshotPushNode(snapshot, &node) >= 0);
+}
+
+//A table of 50 cells, each with a label and 3 icons. Cell 7 has a different label.
+static void createTable(UBKSnapshot *snapshot)
+{
+    pushNode(snapshot, 1);
+    for (int cell = 0; cell < 50; cell++)
+    {
+        pushNode(snapshot, 2);
+        pushNode(snapshot, (cell == 7) ? 4 : 3);
+        UBKSnapshotPopNode(snapshot);
+        for (int icon = 0; icon < 3; icon++)
+        {
+            pushNode(snapshot, 5);
+            UBKSnapshotPopNode(snapshot);
+        }
+        UBKSnapshotPopNode(snapshot);
+    }
+    UBKSnapshotPopNode(snapshot);
+    //Same structure as a cell but not a sibling of one
+    pushNode(snapshot, 2);
+    UBKSnapshotPopNode(snapshot);
+}
+
+static void testCellsShareTheFirstCell(void)
+{
+    UBKSnapshot snapshot;
+    UBKSnapshotInit(&snapshot);
+    createTable(&snapshot);
+    UBKSubtreeGroup *groups = malloc(snapshot.count * sizeof(UBKSubtreeGroup));
+    UBKTestAssert(UBKSubtreeGroupsFind(snapshot.nodes, snapshot.count, groups) > 0);
+
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < snapshot.count; i++)
+    {
+        int32_t representative = groups[i].representative;
+        UBKTestAssert(groups[representative].representative == representative);
+        if (representative == (int32_t)i)
+        {
+            total += groups[i].repeatCount;
+        }
+        else
+        {
+            UBKTestAssert(groups[i].repeatCount == 0);
+        }
+    }
+    UBKTestAssert(total == snapshot.count);
+
+    //Every cell but 7 shares cell 0, and the icons in a cell share the first icon
+    UBKTestAssert(groups[1].repeatCount == 49);
+    UBKTestAssert((groups[4].representative == 3) && (groups[5].representative == 3));
+    uint32_t cell7 = 1 + 7 * 5;
+    UBKTestAssert((groups[cell7].representative == (int32_t)cell7) && (groups[cell7].repeatCount == 1));
+    UBKTestAssert(groups[cell7 + 3].representative == (int32_t)cell7 + 2);
+    UBKTestAssert(groups[snapshot.count - 1].representative == (int32_t)(snapshot.count - 1));
+
+    //Different flags are a different structure
+    snapshot.nodes[1 + 5 * 2 + 1].flags = UBKSnapshotNodeFlagElement | UBKSnapshotNodeFlagUserInteractionEnabled;
+    UBKSubtreeGroupsFind(snapshot.nodes, snapshot.count, groups);
+    UBKTestAssert(groups[1 + 5 * 2].representative == 1 + 5 * 2);
+
+    free(groups);
+    UBKSnapshotDestroy(&snapshot);
+}
+
+int main(void)
+{
+    testCellsShareTheFirstCell();
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ File: UBKTargetSpacingTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKTargetSpacing.h"
+#include "UBKCoreTests.h"
+
+#include <math.h>
+
+static UBKTarget makeTarget(double x, double y, double width, double height, uint32_t index)
+{
+    UBKTarget target = { { x, y, width, height }, index, index + 1 };
+    return target;
+}
+
+static bool framesOverlap(const UBKRect *first, const UBKRect *second)
+{
+    return (first->x < second->x + second->width) && (second->x < first->x + first->width) && (first->y < second->y + second->height) && (second->y < first->y + first->height);
+}
+
+static bool isUndersized(const UBKRect *frame, double spacing)
+{
+    return (frame->width < spacing) || (frame->height < spacing);
+}
+
+static double distanceToFrame(const UBKRect *frame, double x, double y)
+{
+    double dx = fmax(0, fmax(frame->x - x, x - (frame->x + frame->width)));
+    double dy = fmax(0, fmax(frame->y - y, y - (frame->y + frame->height)));
+    return sqrt(dx * dx + dy * dy);
+}
+
+static void testExamples(void)
+{
+    UBKTargetSpacingResult results[5];
+    UBKTarget targets[5] = { makeTarget(0, 0, 44, 44, 0), makeTarget(30, 30, 44, 44, 1), makeTarget(200, 0, 16, 16, 2), makeTarget(220, 0, 16, 16, 3), makeTarget(0, 400, 16, 16, 4) };
+    UBKTestAssert(UBKTargetSpacingAnalyse(targets, 5, 24, results));
+    UBKTestAssert((results[0].flags == UBKTargetSpacingFlagOverlap) && (results[0].conflict == 1) && (results[0].distance == 0));
+    UBKTestAssert((results[2].flags == UBKTargetSpacingFlagTooClose) && (results[2].conflict == 3) && (results[2].distance == 4));
+    UBKTestAssert((results[4].flags == 0) && (results[4].conflict == -1));
+
+    //Big targets can be right next to each other
+    UBKTarget bigTargets[2] = { makeTarget(0, 0, 44, 44, 0), makeTarget(46, 0, 44, 44, 1) };
+    UBKTargetSpacingAnalyse(bigTargets, 2, 24, results);
+    UBKTestAssert((results[0].flags == 0) && (results[1].flags == 0));
+
+    //A button inside a tappable cell isn't compared with the cell
+    UBKTarget nestedTargets[2] = { makeTarget(0, 0, 320, 60, 0), makeTarget(10, 10, 20, 20, 1) };
+    nestedTargets[0].subtreeEnd = 2;
+    UBKTargetSpacingAnalyse(nestedTargets, 2, 24, results);
+    UBKTestAssert((results[0].flags == 0) && (results[1].flags == 0));
+
+    //Small targets exactly the spacing apart pass
+    UBKTarget spacedTargets[2] = { makeTarget(10, 10, 20, 20, 0), makeTarget(34, 10, 20, 20, 1) };
+    UBKTargetSpacingAnalyse(spacedTargets, 2, 24, results);
+    UBKTestAssert((results[0].flags == 0) && (results[1].flags == 0));
+}
+
+//Random screens checked against comparing every pair of targets
+static void testSweepMatchesPairwiseComparison(void)
+{
+    srand(1);
+    double spacing = 24;
+    for (int round = 0; round < 3000; round++)
+    {
+        int count = 2 + rand() % 60;
+        UBKTarget targets[64];
+        UBKTargetSpacingResult results[64];
+        for (int i = 0; i < count; i++)
+        {
+            double width = 1 + rand() % ((rand() % 5 == 0) ? 200 : 50);
+            double height = 1 + rand() % ((rand() % 5 == 0) ? 300 : 50);
+            targets[i] = makeTarget(rand() % 300, rand() % 600, width, height, (uint32_t)i);
+        }
+        UBKTestAssert(UBKTargetSpacingAnalyse(targets, count, spacing, results));
+        for (int i = 0; i < count; i++)
+        {
+            uint32_t flags = 0;
+            for (int j = 0; j < count; j++)
+            {
+                const UBKRect *first = &targets[i].frame;
+                const UBKRect *second = &targets[j].frame;
+                if (i == j)
+                {
+                    continue;
+                }
+                if (framesOverlap(first, second))
+                {
+                    flags |= UBKTargetSpacingFlagOverlap;
+                    continue;
+                }
+                double firstX = first->x + first->width / 2;
+                double firstY = first->y + first->height / 2;
+                double secondX = second->x + second->width / 2;
+                double secondY = second->y + second->height / 2;
+                bool tooClose = isUndersized(first, spacing) && (distanceToFrame(second, firstX, firstY) < spacing / 2);
+                tooClose = tooClose || (isUndersized(second, spacing) && (distanceToFrame(first, secondX, secondY) < spacing / 2));
+                tooClose = tooClose || (isUndersized(first, spacing) && isUndersized(second, spacing) && (hypot(firstX - secondX, firstY - secondY) < spacing));
+                if (tooClose)
+                {
+                    flags |= UBKTargetSpacingFlagTooClose;
+                }
+            }
+            UBKTestAssert(results[i].flags == flags);
+        }
+    }
+}
+
+int main(void)
+{
+    testExamples();
+    testSweepMatchesPairwiseComparison();
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ File: UBKTextRunsTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKTextRuns.h"
+#include "UBKCoreTests.h"
+
+static void testRunsAreMergedAndRated(void)
+{
+    const UBKRuleEvaluator *evaluator = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG21);
+    UBKColourValue black = UBKColourValueMakeLinear(0, 0, 0, 1);
+    UBKColourValue white = UBKColourValueMakeLinear(1, 1, 1, 1);
+    UBKColourValue grey = UBKColourValueMakeLinear(0.4f, 0.4f, 0.4f, 1);
+    UBKColourValue none = UBKColourValueMakeUnknown();
+    UBKTextRunTable table;
+    UBKTextRunTableInit(&table);
+    UBKTestAssert(UBKTextRunTableEvaluate(&table, white, 1, evaluator) == -1);
+
+    //Runs drawn the same way are one run
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        UBKTestAssert(UBKTextRunTableAppend(&table, i * 2, 2, black, none, 17, false));
+    }
+    UBKTestAssert((table.count == 1) && (table.runs[0].length == 20));
+    UBKTestAssert(UBKTextRunTableAppend(&table, 20, 5, grey, none, 12, false));
+    UBKTestAssert(UBKTextRunTableAppend(&table, 25, 5, black, grey, 17, true));
+    UBKTestAssert(UBKTextRunTableAppend(&table, 30, 5, black, none, 30, false));
+    UBKTestAssert(table.count == 4);
+
+    //The small grey footnote is the worst run
+    UBKTestAssert(UBKTextRunTableEvaluate(&table, white, 1, evaluator) == 1);
+    UBKTestAssert(table.runs[0].contrast > 20);
+    UBKTestAssert(table.runs[1].rating == UBKRuleRatingFail);
+
+    //A pattern background can't be rated
+    UBKTextRunTableEvaluate(&table, none, 1, evaluator);
+    UBKTestAssert(table.runs[0].contrast == 0);
+    UBKTextRunTableDestroy(&table);
+}
+
+static void testOpacityAndSkippedText(void)
+{
+    const UBKRuleEvaluator *evaluator = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG21);
+    UBKColourValue black = UBKColourValueMakeLinear(0, 0, 0, 1);
+    UBKColourValue white = UBKColourValueMakeLinear(1, 1, 1, 1);
+    UBKColourValue none = UBKColourValueMakeUnknown();
+    UBKTextRunTable table;
+    UBKTextRunTableInit(&table);
+    UBKTextRunTableAppend(&table, 0, 4, black, none, 17, false);
+    UBKTestAssert(UBKTextRunTableEvaluate(&table, white, 0.5f, evaluator) == 0);
+    UBKTestAssert(table.runs[0].contrast < 5);
+
+    UBKTextRunTableReset(&table);
+    UBKTextRunTableAppend(&table, 0, 3, black, none, 17, false);
+    UBKTextRunTableAppend(&table, 6, 3, black, none, 17, false);
+    UBKTestAssert((table.count == 1) && (table.runs[0].length == 9));
+    UBKTextRunTableDestroy(&table);
+}
+
+int main(void)
+{
+    testRunsAreMergedAndRated();
+    testOpacityAndSkippedText();
+    return 0;
+}
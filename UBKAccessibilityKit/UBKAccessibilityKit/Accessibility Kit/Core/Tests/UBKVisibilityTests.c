@@ -0,0 +1,124 @@
+/*
+ File: UBKVisibilityTests.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKVisibility.h"
+#include "UBKCoreTests.h"
+
+static void pushNode(UBKSnapshot *snapshot, double x, double y, double width, double height, uint32_t flags)
+{
+    UBKSnapshotNode node = {0};
+    node.frame = (UBKRect){ x, y, width, height };
+    node.flags = flags;
+    UBKTestAssert(UBKSnapshotPushNode(snapshot, &node) >= 0);
+}
+
+static void addNode(UBKSnapshot *snapshot, double x, double y, double width, double height, uint32_t flags)
+{
+    pushNode(snapshot, x, y, width, height, flags);
+    UBKSnapshotPopNode(snapshot);
+}
+
+static void testStates(void)
+{
+    uint32_t element = UBKSnapshotNodeFlagElement;
+    uint32_t opaque = UBKSnapshotNodeFlagOpaque;
+    UBKSnapshot snapshot;
+    UBKSnapshotInit(&snapshot);
+    pushNode(&snapshot, 0, 0, 320, 480, 0);
+    //A scroll view with one element half scrolled out and one all the way out
+    pushNode(&snapshot, 0, 0, 320, 100, UBKSnapshotNodeFlagClipsToBounds);
+    addNode(&snapshot, 0, 90, 100, 20, element);
+    addNode(&snapshot, 0, 150, 100, 20, element);
+    UBKSnapshotPopNode(&snapshot);
+    //Covered by the two opaque views after it
+    addNode(&snapshot, 10, 200, 50, 50, element);
+    addNode(&snapshot, 0, 190, 35, 100, opaque);
+    addNode(&snapshot, 35, 190, 100, 100, opaque);
+    addNode(&snapshot, 500, 0, 10, 10, element);
+    addNode(&snapshot, 5, 5, 0, 10, element);
+    addNode(&snapshot, 5, 5, 10, 10, element | UBKSnapshotNodeFlagHidden);
+    UBKSnapshotPopNode(&snapshot);
+
+    UBKVisibilityResult results[10];
+    UBKTestAssert(UBKVisibilityAnalyse(snapshot.nodes, snapshot.count, (UBKRect){ 0, 0, 320, 480 }, results));
+    UBKTestAssert((results[2].state == UBKVisibilityStateVisible) && (results[2].visibleArea == 100 * 10));
+    UBKTestAssert(results[3].state == UBKVisibilityStateClipped);
+    UBKTestAssert((results[4].state == UBKVisibilityStateOccluded) && (results[4].visibleArea == 0));
+    UBKTestAssert(results[7].state == UBKVisibilityStateClipped);
+    UBKTestAssert(results[8].state == UBKVisibilityStateEmpty);
+    UBKTestAssert(results[9].state == UBKVisibilityStateHidden);
+    UBKSnapshotDestroy(&snapshot);
+}
+
+//Random screens checked against counting the uncovered pixels of each element
+static void testAreasMatchPixelCounts(void)
+{
+    uint32_t element = UBKSnapshotNodeFlagElement;
+    uint32_t opaque = UBKSnapshotNodeFlagOpaque;
+    UBKSnapshot snapshot;
+    UBKSnapshotInit(&snapshot);
+    UBKVisibilityResult results[32];
+    srand(1);
+    for (int round = 0; round < 300; round++)
+    {
+        UBKSnapshotReset(&snapshot);
+        pushNode(&snapshot, 0, 0, 64, 64, 0);
+        int count = 2 + rand() % 30;
+        for (int i = 0; i < count; i++)
+        {
+            addNode(&snapshot, rand() % 60, rand() % 60, 1 + rand() % 30, 1 + rand() % 30, ((rand() % 2) ? element : 0) | ((rand() % 2) ? opaque : 0));
+        }
+        UBKSnapshotPopNode(&snapshot);
+        UBKTestAssert(UBKVisibilityAnalyse(snapshot.nodes, snapshot.count, (UBKRect){ 0, 0, 64, 64 }, results));
+
+        for (uint32_t i = 1; i < snapshot.count; i++)
+        {
+            if (!(snapshot.nodes[i].flags & element))
+            {
+                continue;
+            }
+            UBKRect frame = snapshot.nodes[i].frame;
+            int pixels = 0;
+            for (int y = (int)frame.y; (y < (int)(frame.y + frame.height)) && (y < 64); y++)
+            {
+                for (int x = (int)frame.x; (x < (int)(frame.x + frame.width)) && (x < 64); x++)
+                {
+                    bool covered = false;
+                    for (uint32_t j = i + 1; (j < snapshot.count) && !covered; j++)
+                    {
+                        UBKRect cover = snapshot.nodes[j].frame;
+                        covered = (snapshot.nodes[j].flags & opaque) && (x >= cover.x) && (x < cover.x + cover.width) && (y >= cover.y) && (y < cover.y + cover.height);
+                    }
+                    pixels += covered ? 0 : 1;
+                }
+            }
+            UBKTestAssert(pixels == (int)(results[i].visibleArea + 0.5));
+        }
+    }
+    UBKSnapshotDestroy(&snapshot);
+}
+
+int main(void)
+{
+    testStates();
+    testAreasMatchPixelCounts();
+    return 0;
+}
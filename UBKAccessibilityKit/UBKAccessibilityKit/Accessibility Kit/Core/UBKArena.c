@@ -0,0 +1,211 @@
+/*
+ File: UBKArena.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKArena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define UBKArenaAlignment 16
+
+struct UBKArenaBlock {
+    UBKArenaBlock *next;
+    size_t capacity;
+    size_t used;
+};
+
+//Allocations start after the block header, rounded up so they stay aligned
+#define UBKArenaHeaderSize ((sizeof(UBKArenaBlock) + UBKArenaAlignment - 1) & ~(size_t)(UBKArenaAlignment - 1))
+
+static inline unsigned char *UBKArenaBlockBytes(UBKArenaBlock *block)
+{
+    return (unsigned char *)block + UBKArenaHeaderSize;
+}
+
+static inline size_t UBKArenaAlign(size_t size)
+{
+    return (size + UBKArenaAlignment - 1) & ~(size_t)(UBKArenaAlignment - 1);
+}
+
+void UBKArenaInit(UBKArena *arena, size_t minimumBlockSize)
+{
+    memset(arena, 0, sizeof(*arena));
+    arena->minimumBlockSize = (minimumBlockSize > 0) ? minimumBlockSize : 64 * 1024;
+}
+
+void UBKArenaDestroy(UBKArena *arena)
+{
+    UBKArenaBlock *block = arena->blocks;
+    while (block != NULL)
+    {
+        UBKArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    UBKArenaInit(arena, arena->minimumBlockSize);
+}
+
+static UBKArenaBlock *UBKArenaAddBlock(UBKArena *arena, size_t capacity)
+{
+    if (capacity > SIZE_MAX - UBKArenaHeaderSize)
+    {
+        return NULL;
+    }
+    UBKArenaBlock *block = malloc(UBKArenaHeaderSize + capacity);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+    arena->stats.systemAllocations++;
+    arena->stats.bytesReserved += capacity;
+    return block;
+}
+
+static void UBKArenaUse(UBKArena *arena, size_t size)
+{
+    arena->stats.bytesUsed += size;
+    if (arena->stats.bytesUsed > arena->stats.highWater)
+    {
+        arena->stats.highWater = arena->stats.bytesUsed;
+    }
+}
+
+void *UBKArenaAllocate(UBKArena *arena, size_t size)
+{
+    if (size > SIZE_MAX - UBKArenaAlignment)
+    {
+        return NULL;
+    }
+    size_t alignedSize = UBKArenaAlign(size);
+    UBKArenaBlock *block = arena->current;
+    //Blocks after the current one are left over from before a reset
+    while ((block != NULL) && (block->capacity - block->used < alignedSize))
+    {
+        block = block->next;
+    }
+    if (block == NULL)
+    {
+        size_t capacity = (arena->current != NULL) ? arena->current->capacity * 2 : arena->minimumBlockSize;
+        if (capacity < alignedSize)
+        {
+            capacity = alignedSize;
+        }
+        block = UBKArenaAddBlock(arena, capacity);
+        if (block == NULL)
+        {
+            return NULL;
+        }
+        //Appended to the end so the blocks stay in the order they're used
+        UBKArenaBlock **link = &arena->blocks;
+        while (*link != NULL)
+        {
+            link = &(*link)->next;
+        }
+        *link = block;
+    }
+    
+    unsigned char *allocation = UBKArenaBlockBytes(block) + block->used;
+    block->used += alignedSize;
+    arena->current = block;
+    arena->lastAllocation = allocation;
+    arena->stats.allocations++;
+    UBKArenaUse(arena, alignedSize);
+    memset(allocation, 0, size);
+    return allocation;
+}
+
+void *UBKArenaAllocateArray(UBKArena *arena, size_t count, size_t size)
+{
+    if ((size != 0) && (count > SIZE_MAX / size))
+    {
+        return NULL;
+    }
+    return UBKArenaAllocate(arena, count * size);
+}
+
+void *UBKArenaResize(UBKArena *arena, void *allocation, size_t size, size_t newSize)
+{
+    if (allocation == NULL)
+    {
+        return UBKArenaAllocate(arena, newSize);
+    }
+    if (newSize <= size)
+    {
+        return allocation;
+    }
+    
+    UBKArenaBlock *block = arena->current;
+    if ((allocation == arena->lastAllocation) && (newSize <= SIZE_MAX - UBKArenaAlignment))
+    {
+        size_t offset = (size_t)((unsigned char *)allocation - UBKArenaBlockBytes(block));
+        size_t alignedSize = UBKArenaAlign(size);
+        size_t alignedNewSize = UBKArenaAlign(newSize);
+        if (alignedNewSize <= block->capacity - offset)
+        {
+            block->used = offset + alignedNewSize;
+            UBKArenaUse(arena, alignedNewSize - alignedSize);
+            memset((unsigned char *)allocation + size, 0, newSize - size);
+            return allocation;
+        }
+    }
+    
+    //The old copy stays in the arena until the next reset
+    void *resized = UBKArenaAllocate(arena, newSize);
+    if (resized != NULL)
+    {
+        memcpy(resized, allocation, size);
+    }
+    return resized;
+}
+
+void UBKArenaReset(UBKArena *arena)
+{
+    if ((arena->blocks != NULL) && (arena->blocks->next != NULL))
+    {
+        //One block that fits the whole scan, so the next scan fills a single block
+        size_t capacity = arena->stats.highWater;
+        if (capacity < arena->minimumBlockSize)
+        {
+            capacity = arena->minimumBlockSize;
+        }
+        UBKArenaBlock *block = arena->blocks;
+        while (block != NULL)
+        {
+            UBKArenaBlock *next = block->next;
+            arena->stats.bytesReserved -= block->capacity;
+            free(block);
+            block = next;
+        }
+        arena->blocks = UBKArenaAddBlock(arena, capacity);
+    }
+    else if (arena->blocks != NULL)
+    {
+        arena->blocks->used = 0;
+    }
+    arena->current = arena->blocks;
+    arena->lastAllocation = NULL;
+    arena->stats.allocations = 0;
+    arena->stats.bytesUsed = 0;
+    arena->stats.resets++;
+}
@@ -0,0 +1,77 @@
+/*
+ File: UBKArena.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKArena_h
+#define UBKArena_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Bump allocator for the buffers of one scan, eg the snapshot nodes and the screen level pass results. Nothing is freed on its own, a reset releases every allocation at once and keeps the memory for the next scan. Once an arena has seen the largest scan of a screen, scanning it again takes no memory from the system.
+
+typedef struct UBKArenaBlock UBKArenaBlock;
+
+typedef struct {
+    //Blocks taken from malloc since the arena was made
+    uint64_t systemAllocations;
+    //Allocations and bytes handed out since the last reset
+    uint64_t allocations;
+    size_t bytesUsed;
+    //Most bytes used between two resets
+    size_t highWater;
+    //Bytes held in blocks, used or not
+    size_t bytesReserved;
+    uint64_t resets;
+} UBKArenaStats;
+
+typedef struct {
+    UBKArenaBlock *blocks;
+    //Block allocations are made from, the blocks before it are full
+    UBKArenaBlock *current;
+    size_t minimumBlockSize;
+    //The last allocation can grow in place
+    void *lastAllocation;
+    UBKArenaStats stats;
+} UBKArena;
+
+void UBKArenaInit(UBKArena *arena, size_t minimumBlockSize);
+void UBKArenaDestroy(UBKArena *arena);
+
+//Zeroed memory aligned for any type, NULL if a block couldn't be allocated. Valid until the next reset.
+void *UBKArenaAllocate(UBKArena *arena, size_t size);
+//Like UBKArenaAllocate, NULL if count * size overflows
+void *UBKArenaAllocateArray(UBKArena *arena, size_t count, size_t size);
+//Grows an allocation of size bytes to newSize, in place when it's the last allocation, otherwise by copying. The new bytes are zeroed. allocation can be NULL. Returns NULL and leaves the allocation as it was if it can't grow.
+void *UBKArenaResize(UBKArena *arena, void *allocation, size_t size, size_t newSize);
+
+//Releases every allocation. When the last scan needed more than one block they are replaced by a single block that fits it.
+void UBKArenaReset(UBKArena *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKArena_h */
@@ -0,0 +1,358 @@
+/*
+ File: UBKAuditDiff.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKAuditDiff.h"
+#include "UBKHash.h"
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UBKAuditDiffNone UINT32_MAX
+
+//Open addressing map of 64 bit keys to a record index and a value, sized up front for the number of keys
+typedef struct {
+    uint64_t *keys;
+    uint32_t *indexes;
+    int64_t *values;
+    size_t mask;
+} UBKAuditDiffTable;
+
+static bool UBKAuditDiffTableInit(UBKAuditDiffTable *table, size_t count)
+{
+    size_t capacity = 16;
+    while (capacity < count * 2)
+    {
+        capacity *= 2;
+    }
+    table->mask = capacity - 1;
+    table->keys = malloc(capacity * sizeof(uint64_t));
+    table->indexes = malloc(capacity * sizeof(uint32_t));
+    table->values = malloc(capacity * sizeof(int64_t));
+    if ((table->keys == NULL) || (table->indexes == NULL) || (table->values == NULL))
+    {
+        free(table->keys);
+        free(table->indexes);
+        free(table->values);
+        return false;
+    }
+    memset(table->indexes, 0xff, capacity * sizeof(uint32_t));
+    return true;
+}
+
+static void UBKAuditDiffTableDestroy(UBKAuditDiffTable *table)
+{
+    free(table->keys);
+    free(table->indexes);
+    free(table->values);
+}
+
+//Slot for the key, empty slots have an index of UBKAuditDiffNone
+static inline size_t UBKAuditDiffTableSlot(const UBKAuditDiffTable *table, uint64_t key)
+{
+    size_t slot = (size_t)UBKHashCombine(0, key) & table->mask;
+    while ((table->indexes[slot] != UBKAuditDiffNone) && (table->keys[slot] != key))
+    {
+        slot = (slot + 1) & table->mask;
+    }
+    return slot;
+}
+
+static inline uint64_t UBKAuditDiffJoinKey(const UBKAuditRecord *record)
+{
+    return UBKHashCombine(UBKHashCombine(UBKHashInitialValue, record->screen), record->element);
+}
+
+static bool UBKAuditDiffAppend(UBKAuditDiff *diff, UBKAuditDiffKind kind, uint32_t baseIndex, uint32_t headIndex, uint64_t addedWarnings, uint64_t removedWarnings)
+{
+    if (diff->count == diff->capacity)
+    {
+        size_t capacity = (diff->capacity == 0) ? 64 : diff->capacity * 2;
+        UBKAuditDiffEntry *entries = realloc(diff->entries, capacity * sizeof(UBKAuditDiffEntry));
+        if (entries == NULL)
+        {
+            return false;
+        }
+        diff->entries = entries;
+        diff->capacity = capacity;
+    }
+    UBKAuditDiffEntry *entry = &diff->entries[diff->count++];
+    entry->kind = kind;
+    entry->baseIndex = baseIndex;
+    entry->headIndex = headIndex;
+    entry->addedWarnings = addedWarnings;
+    entry->removedWarnings = removedWarnings;
+    switch (kind)
+    {
+        case UBKAuditDiffKindAdded:
+        {
+            diff->addedCount++;
+            break;
+        }
+        case UBKAuditDiffKindRemoved:
+        {
+            diff->removedCount++;
+            break;
+        }
+        case UBKAuditDiffKindChanged:
+        {
+            diff->changedCount++;
+            break;
+        }
+    }
+    return true;
+}
+
+void UBKAuditDiffInit(UBKAuditDiff *diff)
+{
+    memset(diff, 0, sizeof(UBKAuditDiff));
+}
+
+void UBKAuditDiffDestroy(UBKAuditDiff *diff)
+{
+    free(diff->entries);
+    memset(diff, 0, sizeof(UBKAuditDiff));
+}
+
+//Counts the distinct screens of records and marks them in screens, screen markers included
+static bool UBKAuditDiffCollectScreens(const UBKAuditRecord *records, size_t count, UBKHashSet *screens)
+{
+    if (!UBKHashSetInit(screens, 64))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((!UBKHashSetInsert(screens, records[i].screen)) && (!UBKHashSetContains(screens, records[i].screen)))
+        {
+            UBKHashSetDestroy(screens);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool UBKAuditDiffCompute(UBKAuditDiff *diff, const UBKAuditRecord *base, size_t baseCount, const UBKAuditRecord *head, size_t headCount)
+{
+    UBKAuditDiffDestroy(diff);
+    if ((baseCount >= UBKAuditDiffNone) || (headCount >= UBKAuditDiffNone))
+    {
+        return false;
+    }
+    
+    UBKHashSet baseScreens;
+    UBKHashSet headScreens;
+    if (!UBKAuditDiffCollectScreens(base, baseCount, &baseScreens))
+    {
+        return false;
+    }
+    if (!UBKAuditDiffCollectScreens(head, headCount, &headScreens))
+    {
+        UBKHashSetDestroy(&baseScreens);
+        return false;
+    }
+    
+    //Build side: base records chained by join key. The table holds the first record of each chain.
+    UBKAuditDiffTable table;
+    uint32_t *next = malloc((baseCount + 1) * sizeof(uint32_t));
+    bool *matched = calloc(baseCount + 1, sizeof(bool));
+    bool success = (next != NULL) && (matched != NULL) && UBKAuditDiffTableInit(&table, baseCount);
+    if (!success)
+    {
+        free(next);
+        free(matched);
+        UBKHashSetDestroy(&baseScreens);
+        UBKHashSetDestroy(&headScreens);
+        return false;
+    }
+    for (size_t i = baseCount; i-- > 0;)
+    {
+        if (UBKAuditRecordIsScreenMarker(&base[i]))
+        {
+            continue;
+        }
+        size_t slot = UBKAuditDiffTableSlot(&table, UBKAuditDiffJoinKey(&base[i]));
+        table.keys[slot] = UBKAuditDiffJoinKey(&base[i]);
+        next[i] = table.indexes[slot];
+        table.indexes[slot] = (uint32_t)i;
+    }
+    
+    //Probe side: each head record takes the nearest unmatched base record with the same key
+    for (size_t i = 0; (i < headCount) && (success); i++)
+    {
+        const UBKAuditRecord *record = &head[i];
+        if ((UBKAuditRecordIsScreenMarker(record)) || (!UBKHashSetContains(&baseScreens, record->screen)))
+        {
+            continue;
+        }
+        size_t slot = UBKAuditDiffTableSlot(&table, UBKAuditDiffJoinKey(record));
+        uint32_t nearest = UBKAuditDiffNone;
+        float nearestDistance = INFINITY;
+        for (uint32_t candidate = table.indexes[slot]; candidate != UBKAuditDiffNone; candidate = next[candidate])
+        {
+            if (matched[candidate])
+            {
+                continue;
+            }
+            float distance = fabsf(base[candidate].x - record->x) + fabsf(base[candidate].y - record->y);
+            if (distance < nearestDistance)
+            {
+                nearest = candidate;
+                nearestDistance = distance;
+            }
+        }
+        if (nearest == UBKAuditDiffNone)
+        {
+            success = UBKAuditDiffAppend(diff, UBKAuditDiffKindAdded, UBKAuditDiffNone, (uint32_t)i, record->warningMask, 0);
+            continue;
+        }
+        matched[nearest] = true;
+        uint64_t baseWarnings = base[nearest].warningMask;
+        if (baseWarnings != record->warningMask)
+        {
+            success = UBKAuditDiffAppend(diff, UBKAuditDiffKindChanged, nearest, (uint32_t)i, record->warningMask & ~baseWarnings, baseWarnings & ~record->warningMask);
+        }
+    }
+    for (size_t i = 0; (i < baseCount) && (success); i++)
+    {
+        if ((!matched[i]) && (!UBKAuditRecordIsScreenMarker(&base[i])) && (UBKHashSetContains(&headScreens, base[i].screen)))
+        {
+            success = UBKAuditDiffAppend(diff, UBKAuditDiffKindRemoved, (uint32_t)i, UBKAuditDiffNone, 0, base[i].warningMask);
+        }
+    }
+    
+    //Screen counts
+    size_t sharedScreenCount = 0;
+    for (size_t i = 0; i < headScreens.capacity; i++)
+    {
+        //Zero marks an empty slot, the set stores a real zero as another value so this only skips empty slots
+        if ((headScreens.slots[i] != 0) && (UBKHashSetContains(&baseScreens, headScreens.slots[i])))
+        {
+            sharedScreenCount++;
+        }
+    }
+    diff->comparedScreenCount = sharedScreenCount;
+    diff->baseOnlyScreenCount = baseScreens.count - sharedScreenCount;
+    diff->headOnlyScreenCount = headScreens.count - sharedScreenCount;
+    
+    UBKAuditDiffTableDestroy(&table);
+    free(next);
+    free(matched);
+    UBKHashSetDestroy(&baseScreens);
+    UBKHashSetDestroy(&headScreens);
+    return success;
+}
+
+static void UBKAuditDiffWriteWarnings(FILE *file, const char *name, uint64_t warnings)
+{
+    fprintf(file, ",\"%s\":[", name);
+    bool first = true;
+    for (; warnings != 0; warnings &= warnings - 1)
+    {
+        fprintf(file, first ? "%d" : ",%d", __builtin_ctzll(warnings));
+        first = false;
+    }
+    fputc(']', file);
+}
+
+bool UBKAuditDiffWriteJSONLines(const UBKAuditDiff *diff, const UBKAuditRecord *base, const UBKAuditRecord *head, FILE *file)
+{
+    static const char *kindNames[] = { "added", "removed", "changed" };
+    for (size_t i = 0; i < diff->count; i++)
+    {
+        const UBKAuditDiffEntry *entry = &diff->entries[i];
+        const UBKAuditRecord *record = (entry->headIndex != UBKAuditDiffNone) ? &head[entry->headIndex] : &base[entry->baseIndex];
+        fprintf(file, "{\"change\":\"%s\",\"screen\":\"%016" PRIx64 "\",\"element\":\"%016" PRIx64 "\",\"frame\":[%g,%g,%g,%g]", kindNames[entry->kind], record->screen, record->element, record->x, record->y, record->width, record->height);
+        UBKAuditDiffWriteWarnings(file, "added", entry->addedWarnings);
+        UBKAuditDiffWriteWarnings(file, "removed", entry->removedWarnings);
+        fputs("}\n", file);
+    }
+    fprintf(file, "{\"change\":\"summary\",\"screens\":%zu,\"baseOnlyScreens\":%zu,\"headOnlyScreens\":%zu,\"added\":%zu,\"removed\":%zu,\"changed\":%zu}\n", diff->comparedScreenCount, diff->baseOnlyScreenCount, diff->headOnlyScreenCount, diff->addedCount, diff->removedCount, diff->changedCount);
+    return ferror(file) == 0;
+}
+
+typedef struct {
+    uint32_t *recordNumbers;
+    size_t count;
+} UBKAuditDiffBuildRecords;
+
+static bool UBKAuditDiffVisitBuildRecord(const UBKAuditRecord *record, uint64_t recordNumber, void *context)
+{
+    (void)record;
+    UBKAuditDiffBuildRecords *buildRecords = context;
+    buildRecords->recordNumbers[buildRecords->count++] = (uint32_t)recordNumber;
+    return true;
+}
+
+bool UBKAuditDiffCollectBuild(const UBKAuditStore *store, uint64_t build, UBKAuditRecord **records, size_t *count)
+{
+    *records = NULL;
+    *count = 0;
+    UBKAuditQuery query;
+    memset(&query, 0, sizeof(UBKAuditQuery));
+    query.build = build;
+    size_t matches = (size_t)UBKAuditStoreQuery(store, &query, NULL, NULL);
+    
+    UBKAuditDiffBuildRecords buildRecords = { malloc((matches + 1) * sizeof(uint32_t)), 0 };
+    UBKAuditDiffTable latest;
+    if ((buildRecords.recordNumbers == NULL) || (!UBKAuditDiffTableInit(&latest, matches)))
+    {
+        free(buildRecords.recordNumbers);
+        return false;
+    }
+    UBKAuditStoreQuery(store, &query, UBKAuditDiffVisitBuildRecord, &buildRecords);
+    
+    //Latest audit time of each screen, every record from one audit shares its time
+    for (size_t i = 0; i < buildRecords.count; i++)
+    {
+        const UBKAuditRecord *record = &store->records[buildRecords.recordNumbers[i]];
+        size_t slot = UBKAuditDiffTableSlot(&latest, record->screen);
+        if ((latest.indexes[slot] == UBKAuditDiffNone) || (record->timestamp > latest.values[slot]))
+        {
+            latest.keys[slot] = record->screen;
+            latest.indexes[slot] = (uint32_t)i;
+            latest.values[slot] = record->timestamp;
+        }
+    }
+    
+    UBKAuditRecord *collected = malloc((buildRecords.count + 1) * sizeof(UBKAuditRecord));
+    if (collected == NULL)
+    {
+        UBKAuditDiffTableDestroy(&latest);
+        free(buildRecords.recordNumbers);
+        return false;
+    }
+    size_t collectedCount = 0;
+    for (size_t i = 0; i < buildRecords.count; i++)
+    {
+        const UBKAuditRecord *record = &store->records[buildRecords.recordNumbers[i]];
+        if (record->timestamp == latest.values[UBKAuditDiffTableSlot(&latest, record->screen)])
+        {
+            collected[collectedCount++] = *record;
+        }
+    }
+    UBKAuditDiffTableDestroy(&latest);
+    free(buildRecords.recordNumbers);
+    *records = collected;
+    *count = collectedCount;
+    return true;
+}
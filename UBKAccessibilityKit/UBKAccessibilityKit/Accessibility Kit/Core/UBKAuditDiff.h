@@ -0,0 +1,86 @@
+/*
+ File: UBKAuditDiff.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKAuditDiff_h
+#define UBKAuditDiff_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "UBKAuditStore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Warnings that appeared or went away between two builds, eg for release gating in CI. Records from the two builds are joined on their screen and element key, elements sharing a key are paired with the nearest frame.
+//Only screens audited in both builds are compared. A screen counts as audited when it has any record, its marker is enough, see UBKAuditRecordIsScreenMarker. Only elements with warnings are in the store, so an element missing from one build had no warnings there.
+
+typedef enum {
+    //Element only has warnings in the head build
+    UBKAuditDiffKindAdded,
+    //Element only has warnings in the base build
+    UBKAuditDiffKindRemoved,
+    //Element has different warnings in each build
+    UBKAuditDiffKindChanged
+} UBKAuditDiffKind;
+
+typedef struct {
+    UBKAuditDiffKind kind;
+    //Record index in each build, UINT32_MAX when the element isn't in that build
+    uint32_t baseIndex;
+    uint32_t headIndex;
+    uint64_t addedWarnings;
+    uint64_t removedWarnings;
+} UBKAuditDiffEntry;
+
+typedef struct {
+    UBKAuditDiffEntry *entries;
+    size_t count;
+    size_t capacity;
+    size_t addedCount;
+    size_t removedCount;
+    size_t changedCount;
+    size_t comparedScreenCount;
+    //Screens audited in only one of the builds, these aren't compared
+    size_t baseOnlyScreenCount;
+    size_t headOnlyScreenCount;
+} UBKAuditDiff;
+
+void UBKAuditDiffInit(UBKAuditDiff *diff);
+void UBKAuditDiffDestroy(UBKAuditDiff *diff);
+
+//Fills diff with the changes from base to head. Entries for head records come first in head order, then removed base records in base order. Returns false if memory runs out.
+bool UBKAuditDiffCompute(UBKAuditDiff *diff, const UBKAuditRecord *base, size_t baseCount, const UBKAuditRecord *head, size_t headCount);
+
+//Writes one JSON object per entry and a summary as the last line. Warnings are written as UBKAccessibilityWarningType values.
+bool UBKAuditDiffWriteJSONLines(const UBKAuditDiff *diff, const UBKAuditRecord *base, const UBKAuditRecord *head, FILE *file);
+
+//Copies the records from the latest audit of each screen in a build, older audits of the same screen are left out. Free records when done.
+bool UBKAuditDiffCollectBuild(const UBKAuditStore *store, uint64_t build, UBKAuditRecord **records, size_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKAuditDiff_h */
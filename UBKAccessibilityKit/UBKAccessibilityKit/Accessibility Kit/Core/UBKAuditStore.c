@@ -0,0 +1,528 @@
+/*
+ File: UBKAuditStore.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+//strdup and ftruncate are POSIX, not C11
+#define _POSIX_C_SOURCE 200809L
+
+#include "UBKAuditStore.h"
+#include "UBKHash.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define UBKAuditStoreInitialCapacity 1024
+
+static const char UBKAuditStoreMagic[8] = { 'U', 'B', 'K', 'A', 'U', 'D', 'I', 'T' };
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    //Written after the records it covers, a record past this count is ignored
+    uint64_t recordCount;
+    uint8_t reserved[40];
+} UBKAuditStoreHeader;
+
+static inline UBKAuditStoreHeader *UBKAuditStoreGetHeader(const UBKAuditStore *store)
+{
+    return (UBKAuditStoreHeader *)store->map;
+}
+
+static bool UBKAuditPostingsAppend(UBKAuditPostings *postings, uint32_t recordNumber)
+{
+    if (postings->count == postings->capacity)
+    {
+        uint32_t capacity = (postings->capacity == 0) ? 16 : postings->capacity * 2;
+        uint32_t *recordNumbers = realloc(postings->recordNumbers, capacity * sizeof(uint32_t));
+        if (recordNumbers == NULL)
+        {
+            return false;
+        }
+        postings->recordNumbers = recordNumbers;
+        postings->capacity = capacity;
+    }
+    postings->recordNumbers[postings->count++] = recordNumber;
+    return true;
+}
+
+static void UBKAuditPostingsDestroy(UBKAuditPostings *postings)
+{
+    free(postings->recordNumbers);
+    memset(postings, 0, sizeof(UBKAuditPostings));
+}
+
+static void UBKAuditIndexDestroy(UBKAuditIndex *index)
+{
+    for (size_t i = 0; i < index->capacity; i++)
+    {
+        if (index->used[i])
+        {
+            UBKAuditPostingsDestroy(&index->postings[i]);
+        }
+    }
+    free(index->keys);
+    free(index->used);
+    free(index->postings);
+    memset(index, 0, sizeof(UBKAuditIndex));
+}
+
+static size_t UBKAuditIndexSlot(const UBKAuditIndex *index, uint64_t key)
+{
+    size_t mask = index->capacity - 1;
+    size_t slot = (size_t)UBKHashCombine(0, key) & mask;
+    while (index->used[slot] && index->keys[slot] != key)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static const UBKAuditPostings *UBKAuditIndexFind(const UBKAuditIndex *index, uint64_t key)
+{
+    if (index->capacity == 0)
+    {
+        return NULL;
+    }
+    size_t slot = UBKAuditIndexSlot(index, key);
+    return index->used[slot] ? &index->postings[slot] : NULL;
+}
+
+static bool UBKAuditIndexGrow(UBKAuditIndex *index)
+{
+    UBKAuditIndex grown;
+    grown.capacity = (index->capacity == 0) ? 64 : index->capacity * 2;
+    grown.count = index->count;
+    grown.keys = calloc(grown.capacity, sizeof(uint64_t));
+    grown.used = calloc(grown.capacity, sizeof(bool));
+    grown.postings = calloc(grown.capacity, sizeof(UBKAuditPostings));
+    if ((grown.keys == NULL) || (grown.used == NULL) || (grown.postings == NULL))
+    {
+        free(grown.keys);
+        free(grown.used);
+        free(grown.postings);
+        return false;
+    }
+    for (size_t i = 0; i < index->capacity; i++)
+    {
+        if (index->used[i])
+        {
+            size_t slot = UBKAuditIndexSlot(&grown, index->keys[i]);
+            grown.used[slot] = true;
+            grown.keys[slot] = index->keys[i];
+            grown.postings[slot] = index->postings[i];
+        }
+    }
+    free(index->keys);
+    free(index->used);
+    free(index->postings);
+    *index = grown;
+    return true;
+}
+
+static bool UBKAuditIndexAppend(UBKAuditIndex *index, uint64_t key, uint32_t recordNumber)
+{
+    //Keep the load under 3/4
+    if (((index->count + 1) * 4 > index->capacity * 3) && (!UBKAuditIndexGrow(index)))
+    {
+        return false;
+    }
+    size_t slot = UBKAuditIndexSlot(index, key);
+    if (!index->used[slot])
+    {
+        index->used[slot] = true;
+        index->keys[slot] = key;
+        index->count++;
+    }
+    return UBKAuditPostingsAppend(&index->postings[slot], recordNumber);
+}
+
+static void UBKAuditStoreDestroyIndexes(UBKAuditStore *store)
+{
+    for (int i = 0; i < 64; i++)
+    {
+        UBKAuditPostingsDestroy(&store->warningTypes[i]);
+    }
+    UBKAuditIndexDestroy(&store->screens);
+    UBKAuditIndexDestroy(&store->builds);
+    store->indexedCount = 0;
+}
+
+static bool UBKAuditStoreIndexRecords(UBKAuditStore *store)
+{
+    uint64_t count = UBKAuditStoreCount(store);
+    for (uint64_t i = store->indexedCount; i < count; i++)
+    {
+        const UBKAuditRecord *record = &store->records[i];
+        uint32_t recordNumber = (uint32_t)i;
+        for (uint64_t mask = record->warningMask; mask != 0; mask &= mask - 1)
+        {
+            if (!UBKAuditPostingsAppend(&store->warningTypes[__builtin_ctzll(mask)], recordNumber))
+            {
+                return false;
+            }
+        }
+        if ((!UBKAuditIndexAppend(&store->screens, record->screen, recordNumber)) || (!UBKAuditIndexAppend(&store->builds, record->build, recordNumber)))
+        {
+            return false;
+        }
+        store->indexedCount = i + 1;
+    }
+    return true;
+}
+
+static bool UBKAuditStoreMap(UBKAuditStore *store, size_t length)
+{
+    if (store->map)
+    {
+        munmap(store->map, store->mapLength);
+        store->map = NULL;
+        store->records = NULL;
+    }
+    int protection = store->readOnly ? PROT_READ : (PROT_READ | PROT_WRITE);
+    void *map = mmap(NULL, length, protection, MAP_SHARED, store->fileDescriptor, 0);
+    if (map == MAP_FAILED)
+    {
+        return false;
+    }
+    store->map = map;
+    store->mapLength = length;
+    store->records = (const UBKAuditRecord *)((uint8_t *)map + sizeof(UBKAuditStoreHeader));
+    store->capacity = (length - sizeof(UBKAuditStoreHeader)) / sizeof(UBKAuditRecord);
+    return true;
+}
+
+static bool UBKAuditStoreMapFile(UBKAuditStore *store)
+{
+    struct stat status;
+    if (fstat(store->fileDescriptor, &status) != 0)
+    {
+        return false;
+    }
+    size_t length = (size_t)status.st_size;
+    if (length == 0)
+    {
+        if (store->readOnly)
+        {
+            return false;
+        }
+        //New file
+        length = sizeof(UBKAuditStoreHeader) + (UBKAuditStoreInitialCapacity * sizeof(UBKAuditRecord));
+        if (ftruncate(store->fileDescriptor, (off_t)length) != 0)
+        {
+            return false;
+        }
+        if (!UBKAuditStoreMap(store, length))
+        {
+            return false;
+        }
+        UBKAuditStoreHeader *header = UBKAuditStoreGetHeader(store);
+        memcpy(header->magic, UBKAuditStoreMagic, sizeof(UBKAuditStoreMagic));
+        header->version = UBKAuditStoreVersion;
+        header->recordSize = sizeof(UBKAuditRecord);
+        header->recordCount = 0;
+        return true;
+    }
+    if ((length < sizeof(UBKAuditStoreHeader)) || (!UBKAuditStoreMap(store, length)))
+    {
+        return false;
+    }
+    const UBKAuditStoreHeader *header = UBKAuditStoreGetHeader(store);
+    return (memcmp(header->magic, UBKAuditStoreMagic, sizeof(UBKAuditStoreMagic)) == 0) && (header->version == UBKAuditStoreVersion) && (header->recordSize == sizeof(UBKAuditRecord));
+}
+
+static bool UBKAuditStoreGrow(UBKAuditStore *store, uint64_t capacity)
+{
+    //A file with only a header maps no records
+    uint64_t grownCapacity = (store->capacity > 0) ? store->capacity : UBKAuditStoreInitialCapacity;
+    while (grownCapacity < capacity)
+    {
+        grownCapacity *= 2;
+    }
+    size_t length = sizeof(UBKAuditStoreHeader) + (size_t)(grownCapacity * sizeof(UBKAuditRecord));
+    if (ftruncate(store->fileDescriptor, (off_t)length) != 0)
+    {
+        return false;
+    }
+    return UBKAuditStoreMap(store, length);
+}
+
+bool UBKAuditStoreOpen(UBKAuditStore *store, const char *path, bool readOnly)
+{
+    memset(store, 0, sizeof(UBKAuditStore));
+    store->readOnly = readOnly;
+    store->fileDescriptor = open(path, readOnly ? O_RDONLY : (O_RDWR | O_CREAT), 0644);
+    store->path = strdup(path);
+    if ((store->fileDescriptor < 0) || (store->path == NULL) || (!UBKAuditStoreMapFile(store)) || (!UBKAuditStoreIndexRecords(store)))
+    {
+        UBKAuditStoreClose(store);
+        return false;
+    }
+    return true;
+}
+
+void UBKAuditStoreClose(UBKAuditStore *store)
+{
+    UBKAuditStoreDestroyIndexes(store);
+    if (store->map)
+    {
+        munmap(store->map, store->mapLength);
+    }
+    if (store->fileDescriptor >= 0)
+    {
+        close(store->fileDescriptor);
+    }
+    free(store->path);
+    memset(store, 0, sizeof(UBKAuditStore));
+    store->fileDescriptor = -1;
+}
+
+uint64_t UBKAuditStoreCount(const UBKAuditStore *store)
+{
+    if (store->map == NULL)
+    {
+        return 0;
+    }
+    //A reader can see a count from a writer that has grown the file past this mapping
+    uint64_t count = UBKAuditStoreGetHeader(store)->recordCount;
+    return (count < store->capacity) ? count : store->capacity;
+}
+
+bool UBKAuditStoreAppend(UBKAuditStore *store, const UBKAuditRecord *records, size_t count)
+{
+    if ((store->map == NULL) || (store->readOnly))
+    {
+        return false;
+    }
+    uint64_t recordCount = UBKAuditStoreGetHeader(store)->recordCount;
+    //Record numbers in the indexes are 32 bit
+    if (recordCount + count > UINT32_MAX)
+    {
+        return false;
+    }
+    if ((recordCount + count > store->capacity) && (!UBKAuditStoreGrow(store, recordCount + count)))
+    {
+        return false;
+    }
+    memcpy((UBKAuditRecord *)store->records + recordCount, records, count * sizeof(UBKAuditRecord));
+    UBKAuditStoreGetHeader(store)->recordCount = recordCount + count;
+    return UBKAuditStoreIndexRecords(store);
+}
+
+bool UBKAuditStoreSync(UBKAuditStore *store)
+{
+    if ((store->map == NULL) || (store->readOnly))
+    {
+        return store->map != NULL;
+    }
+    return msync(store->map, store->mapLength, MS_SYNC) == 0;
+}
+
+bool UBKAuditStoreRefresh(UBKAuditStore *store)
+{
+    if (store->map == NULL)
+    {
+        return false;
+    }
+    struct stat status;
+    if (fstat(store->fileDescriptor, &status) != 0)
+    {
+        return false;
+    }
+    //Compacting renames a new file over the path, the open descriptor still reads the old one
+    struct stat pathStatus;
+    if ((stat(store->path, &pathStatus) == 0) && ((pathStatus.st_ino != status.st_ino) || (pathStatus.st_dev != status.st_dev)))
+    {
+        char *path = strdup(store->path);
+        bool readOnly = store->readOnly;
+        UBKAuditStoreClose(store);
+        bool success = (path != NULL) && UBKAuditStoreOpen(store, path, readOnly);
+        free(path);
+        return success;
+    }
+    if (((size_t)status.st_size != store->mapLength) && (!UBKAuditStoreMap(store, (size_t)status.st_size)))
+    {
+        return false;
+    }
+    return UBKAuditStoreIndexRecords(store);
+}
+
+static inline bool UBKAuditQueryMatches(const UBKAuditQuery *query, const UBKAuditRecord *record)
+{
+    return ((query->warningMask == 0) || (record->warningMask & query->warningMask)) &&
+        ((query->screen == 0) || (record->screen == query->screen)) &&
+        ((query->build == 0) || (record->build == query->build)) &&
+        (record->timestamp >= query->fromTimestamp) &&
+        ((query->toTimestamp == 0) || (record->timestamp < query->toTimestamp));
+}
+
+uint64_t UBKAuditStoreQuery(const UBKAuditStore *store, const UBKAuditQuery *query, UBKAuditStoreVisitor visitor, void *context)
+{
+    //Pick the shortest list of candidates, the other conditions are checked on each record
+    const UBKAuditPostings *candidates = NULL;
+    bool hasIndex = false;
+    if (query->screen != 0)
+    {
+        candidates = UBKAuditIndexFind(&store->screens, query->screen);
+        hasIndex = true;
+    }
+    if (query->build != 0)
+    {
+        const UBKAuditPostings *postings = UBKAuditIndexFind(&store->builds, query->build);
+        if ((!hasIndex) || (postings == NULL) || ((candidates != NULL) && (postings->count < candidates->count)))
+        {
+            candidates = postings;
+        }
+        hasIndex = true;
+    }
+    if ((query->warningMask != 0) && ((query->warningMask & (query->warningMask - 1)) == 0))
+    {
+        const UBKAuditPostings *postings = &store->warningTypes[__builtin_ctzll(query->warningMask)];
+        if ((!hasIndex) || ((candidates != NULL) && (postings->count < candidates->count)))
+        {
+            candidates = postings;
+        }
+        hasIndex = true;
+    }
+    
+    uint64_t matches = 0;
+    if (hasIndex)
+    {
+        if (candidates == NULL)
+        {
+            return 0;
+        }
+        for (uint32_t i = 0; i < candidates->count; i++)
+        {
+            uint32_t recordNumber = candidates->recordNumbers[i];
+            const UBKAuditRecord *record = &store->records[recordNumber];
+            if (UBKAuditQueryMatches(query, record))
+            {
+                matches++;
+                if ((visitor) && (!visitor(record, recordNumber, context)))
+                {
+                    break;
+                }
+            }
+        }
+        return matches;
+    }
+    
+    uint64_t count = store->indexedCount;
+    for (uint64_t i = 0; i < count; i++)
+    {
+        const UBKAuditRecord *record = &store->records[i];
+        if (UBKAuditQueryMatches(query, record))
+        {
+            matches++;
+            if ((visitor) && (!visitor(record, i, context)))
+            {
+                break;
+            }
+        }
+    }
+    return matches;
+}
+
+bool UBKAuditStoreCompact(UBKAuditStore *store, int64_t olderThan)
+{
+    if ((store->map == NULL) || (store->readOnly))
+    {
+        return false;
+    }
+    uint64_t count = UBKAuditStoreCount(store);
+    bool *keep = calloc((size_t)count + 1, sizeof(bool));
+    UBKHashSet seen;
+    if ((keep == NULL) || (!UBKHashSetInit(&seen, (size_t)count + 1)))
+    {
+        free(keep);
+        return false;
+    }
+    //Walk back from the newest record so the newest repeat is the one kept
+    uint64_t keptCount = 0;
+    for (uint64_t i = count; i-- > 0;)
+    {
+        const UBKAuditRecord *record = &store->records[i];
+        if (record->timestamp < olderThan)
+        {
+            continue;
+        }
+        uint64_t key = UBKHashCombine(UBKHashCombine(UBKHashCombine(UBKHashInitialValue, record->screen), record->element), record->build);
+        key = UBKHashCombine(UBKHashCombine(key, record->warningMask), UBKHashCombine((uint64_t)lroundf(record->x), (uint64_t)lroundf(record->y)));
+        if (UBKHashSetInsert(&seen, key))
+        {
+            keep[i] = true;
+            keptCount++;
+        }
+    }
+    UBKHashSetDestroy(&seen);
+    
+    //Write the kept records to a new file and swap it in, a failure part way leaves the original untouched
+    size_t pathLength = strlen(store->path);
+    char *compactPath = malloc(pathLength + sizeof(".compact"));
+    if (compactPath == NULL)
+    {
+        free(keep);
+        return false;
+    }
+    memcpy(compactPath, store->path, pathLength);
+    memcpy(compactPath + pathLength, ".compact", sizeof(".compact"));
+    
+    UBKAuditStore compacted;
+    unlink(compactPath);
+    bool success = UBKAuditStoreOpen(&compacted, compactPath, false);
+    if ((success) && (keptCount > compacted.capacity))
+    {
+        success = UBKAuditStoreGrow(&compacted, keptCount);
+    }
+    if (success)
+    {
+        UBKAuditRecord *records = (UBKAuditRecord *)compacted.records;
+        uint64_t written = 0;
+        for (uint64_t i = 0; i < count; i++)
+        {
+            if (keep[i])
+            {
+                records[written++] = store->records[i];
+            }
+        }
+        UBKAuditStoreGetHeader(&compacted)->recordCount = written;
+        success = UBKAuditStoreSync(&compacted);
+        UBKAuditStoreClose(&compacted);
+    }
+    free(keep);
+    if ((success) && (rename(compactPath, store->path) == 0))
+    {
+        char *path = strdup(store->path);
+        free(compactPath);
+        UBKAuditStoreClose(store);
+        success = (path != NULL) && UBKAuditStoreOpen(store, path, false);
+        free(path);
+        return success;
+    }
+    unlink(compactPath);
+    free(compactPath);
+    return false;
+}
@@ -0,0 +1,136 @@
+/*
+ File: UBKAuditStore.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKAuditStore_h
+#define UBKAuditStore_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Append only file of audit results kept across sessions and builds. The file is memory mapped, records are fixed size and written in place so queries read them straight from the mapping. Indexes by warning type, screen and build are kept in memory and rebuilt with a single pass when the store is opened.
+//Nothing in here depends on UIKit so the same file can be queried by offline tooling.
+
+#define UBKAuditStoreVersion 1
+
+typedef struct {
+    //Snapshot fingerprint of the screen
+    uint64_t screen;
+    //Element key, see UBKSnapshotElementKeys
+    uint64_t element;
+    //Hash of the app build, eg version and build number
+    uint64_t build;
+    //Bit mask of the warning types found on the element, 1 << UBKAccessibilityWarningType
+    uint64_t warningMask;
+    //Seconds since 1970
+    int64_t timestamp;
+    //Measured values, 0 when not measured. The frame is in window space.
+    float contrast;
+    float x;
+    float y;
+    float width;
+    float height;
+    float textSize;
+    //Zero, keeps the record size a multiple of 8 on every platform
+    uint32_t reserved;
+} UBKAuditRecord;
+
+//Each audit of a screen also writes a marker record with no element and no warnings, so screens without any warnings are in the store too
+static inline bool UBKAuditRecordIsScreenMarker(const UBKAuditRecord *record)
+{
+    return (record->element == 0) && (record->warningMask == 0);
+}
+
+//Record numbers in append order
+typedef struct {
+    uint32_t *recordNumbers;
+    uint32_t count;
+    uint32_t capacity;
+} UBKAuditPostings;
+
+//Open addressing map of key to postings
+typedef struct {
+    uint64_t *keys;
+    bool *used;
+    UBKAuditPostings *postings;
+    size_t capacity;
+    size_t count;
+} UBKAuditIndex;
+
+typedef struct {
+    int fileDescriptor;
+    bool readOnly;
+    char *path;
+    void *map;
+    size_t mapLength;
+    const UBKAuditRecord *records;
+    //Records the mapping has room for
+    uint64_t capacity;
+    //Records covered by the indexes
+    uint64_t indexedCount;
+    UBKAuditPostings warningTypes[64];
+    UBKAuditIndex screens;
+    UBKAuditIndex builds;
+} UBKAuditStore;
+
+typedef struct {
+    //Records with any of these warning types, 0 for any record
+    uint64_t warningMask;
+    //0 for any screen or build
+    uint64_t screen;
+    uint64_t build;
+    //Records from fromTimestamp up to but not including toTimestamp. A toTimestamp of 0 has no upper limit.
+    int64_t fromTimestamp;
+    int64_t toTimestamp;
+} UBKAuditQuery;
+
+//Return false to stop the query
+typedef bool (*UBKAuditStoreVisitor)(const UBKAuditRecord *record, uint64_t recordNumber, void *context);
+
+//Opens or, unless readOnly, creates the store at path. Returns false if the file can't be opened or isn't an audit store.
+bool UBKAuditStoreOpen(UBKAuditStore *store, const char *path, bool readOnly);
+void UBKAuditStoreClose(UBKAuditStore *store);
+
+uint64_t UBKAuditStoreCount(const UBKAuditStore *store);
+
+bool UBKAuditStoreAppend(UBKAuditStore *store, const UBKAuditRecord *records, size_t count);
+
+//Flushes appended records to disk
+bool UBKAuditStoreSync(UBKAuditStore *store);
+
+//Picks up records appended by another process since the store was opened or last refreshed, and reopens the path if another process compacted it.
+bool UBKAuditStoreRefresh(UBKAuditStore *store);
+
+//Visits the matching records in the order they were appended, visitor can be NULL to count them. The smallest index that applies is used, a full scan is only needed for queries on time or several warning types.
+uint64_t UBKAuditStoreQuery(const UBKAuditStore *store, const UBKAuditQuery *query, UBKAuditStoreVisitor visitor, void *context);
+
+//Rewrites the file without records older than olderThan, and without repeats of a record with the same screen, element, position, build and warnings where only the newest is kept. Pass 0 to only drop repeats.
+bool UBKAuditStoreCompact(UBKAuditStore *store, int64_t olderThan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKAuditStore_h */
@@ -0,0 +1,768 @@
+/*
+ File: UBKColourTokens.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKColourTokens.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UBKColourTokensChunkSize 65536
+
+typedef enum {
+    UBKColourTokensStateValue,
+    //After [, a value or ]
+    UBKColourTokensStateValueOrEnd,
+    //After {, a key or }
+    UBKColourTokensStateKeyOrEnd,
+    UBKColourTokensStateKey,
+    UBKColourTokensStateColon,
+    UBKColourTokensStateCommaOrEnd,
+    UBKColourTokensStateString,
+    UBKColourTokensStateStringEscape,
+    UBKColourTokensStateStringUnicode,
+    //Numbers, true, false and null, their text isn't needed
+    UBKColourTokensStateLiteral,
+    UBKColourTokensStateDone
+} UBKColourTokensState;
+
+static bool UBKColourTokensReserve(char **buffer, size_t *capacity, size_t length)
+{
+    if (length <= *capacity)
+    {
+        return true;
+    }
+    size_t newCapacity = (*capacity > 0) ? *capacity : 64;
+    while (newCapacity < length)
+    {
+        newCapacity *= 2;
+    }
+    char *newBuffer = realloc(*buffer, newCapacity);
+    if (newBuffer == NULL)
+    {
+        return false;
+    }
+    *buffer = newBuffer;
+    *capacity = newCapacity;
+    return true;
+}
+
+void UBKColourTokensInit(UBKColourTokens *tokens)
+{
+    memset(tokens, 0, sizeof(*tokens));
+    tokens->state = UBKColourTokensStateValue;
+}
+
+void UBKColourTokensDestroy(UBKColourTokens *tokens)
+{
+    free(tokens->entries);
+    free(tokens->names);
+    free(tokens->slots);
+    free(tokens->path);
+    free(tokens->string);
+    memset(tokens, 0, sizeof(*tokens));
+}
+
+static inline uint32_t UBKColourTokensSlot(uint32_t colour, uint32_t slotCapacity)
+{
+    //Fibonacci hashing, slotCapacity is a power of 2
+    return (uint32_t)((colour * 2654435769u) & (slotCapacity - 1));
+}
+
+int32_t UBKColourTokensFind(const UBKColourTokens *tokens, uint32_t colour)
+{
+    if (tokens->slotCapacity == 0)
+    {
+        return -1;
+    }
+    uint32_t slot = UBKColourTokensSlot(colour, tokens->slotCapacity);
+    while (tokens->slots[slot] != 0)
+    {
+        uint32_t index = tokens->slots[slot] - 1;
+        if (tokens->entries[index].colour == colour)
+        {
+            return (int32_t)index;
+        }
+        slot = (slot + 1) & (tokens->slotCapacity - 1);
+    }
+    return -1;
+}
+
+static bool UBKColourTokensGrowIndex(UBKColourTokens *tokens)
+{
+    uint32_t slotCapacity = (tokens->slotCapacity > 0) ? tokens->slotCapacity * 2 : 256;
+    uint32_t *slots = calloc(slotCapacity, sizeof(uint32_t));
+    if (slots == NULL)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < tokens->count; i++)
+    {
+        uint32_t slot = UBKColourTokensSlot(tokens->entries[i].colour, slotCapacity);
+        while (slots[slot] != 0)
+        {
+            slot = (slot + 1) & (slotCapacity - 1);
+        }
+        slots[slot] = i + 1;
+    }
+    free(tokens->slots);
+    tokens->slots = slots;
+    tokens->slotCapacity = slotCapacity;
+    return true;
+}
+
+static bool UBKColourTokensAdd(UBKColourTokens *tokens, uint32_t colour, const char *name, size_t nameLength)
+{
+    tokens->tokenCount++;
+    
+    //Keep the load factor at or below a half so probes stay short
+    if (((tokens->count + 1) * 2 > tokens->slotCapacity) && (!UBKColourTokensGrowIndex(tokens)))
+    {
+        return false;
+    }
+    uint32_t slot = UBKColourTokensSlot(colour, tokens->slotCapacity);
+    while (tokens->slots[slot] != 0)
+    {
+        UBKColourTokenEntry *entry = &tokens->entries[tokens->slots[slot] - 1];
+        if (entry->colour == colour)
+        {
+            entry->tokenCount++;
+            return true;
+        }
+        slot = (slot + 1) & (tokens->slotCapacity - 1);
+    }
+    
+    if (tokens->count == tokens->capacity)
+    {
+        uint32_t capacity = (tokens->capacity > 0) ? tokens->capacity * 2 : 64;
+        UBKColourTokenEntry *entries = realloc(tokens->entries, capacity * sizeof(UBKColourTokenEntry));
+        if (entries == NULL)
+        {
+            return false;
+        }
+        tokens->entries = entries;
+        tokens->capacity = capacity;
+    }
+    //Name offsets are 32 bit
+    if ((tokens->namesLength + nameLength + 1 > UINT32_MAX) || (!UBKColourTokensReserve(&tokens->names, &tokens->namesCapacity, tokens->namesLength + nameLength + 1)))
+    {
+        return false;
+    }
+    if (nameLength > 0)
+    {
+        memcpy(tokens->names + tokens->namesLength, name, nameLength);
+    }
+    tokens->names[tokens->namesLength + nameLength] = '\0';
+    
+    UBKColourTokenEntry *entry = &tokens->entries[tokens->count];
+    entry->colour = colour;
+    entry->nameOffset = (uint32_t)tokens->namesLength;
+    entry->nameLength = (uint32_t)nameLength;
+    entry->tokenCount = 1;
+    tokens->namesLength += nameLength + 1;
+    tokens->slots[slot] = tokens->count + 1;
+    tokens->count++;
+    return true;
+}
+
+static inline int UBKColourTokensHexDigit(unsigned char character)
+{
+    if ((character >= '0') && (character <= '9'))
+    {
+        return character - '0';
+    }
+    if ((character >= 'a') && (character <= 'f'))
+    {
+        return character - 'a' + 10;
+    }
+    if ((character >= 'A') && (character <= 'F'))
+    {
+        return character - 'A' + 10;
+    }
+    return -1;
+}
+
+static inline bool UBKColourTokensIsSpace(unsigned char character)
+{
+    return (character == ' ') || (character == '\t') || (character == '\n') || (character == '\r');
+}
+
+static inline uint32_t UBKColourTokensChannel(double value)
+{
+    if (value <= 0)
+    {
+        return 0;
+    }
+    if (value >= 255)
+    {
+        return 255;
+    }
+    return (uint32_t)(value + 0.5);
+}
+
+static bool UBKColourTokensParseHex(const unsigned char *text, size_t length, uint32_t *colour)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        int digit = UBKColourTokensHexDigit(text[i]);
+        if (digit < 0)
+        {
+            return false;
+        }
+        value = (value << 4) | (uint32_t)digit;
+    }
+    switch (length)
+    {
+        case 3:
+        case 4:
+        {
+            //Short forms repeat each digit, #F80 is #FF8800
+            uint32_t expanded = 0;
+            for (size_t i = 0; i < length; i++)
+            {
+                uint32_t digit = (value >> ((length - 1 - i) * 4)) & 0xF;
+                expanded = (expanded << 8) | (digit << 4) | digit;
+            }
+            *colour = (length == 3) ? ((expanded << 8) | 0xFF) : expanded;
+            return true;
+        }
+        case 6:
+        {
+            *colour = (value << 8) | 0xFF;
+            return true;
+        }
+        case 8:
+        {
+            *colour = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+//Reads a decimal number with an optional fraction and percent sign. Returns the number of bytes read, 0 if there isn't a number.
+static size_t UBKColourTokensParseNumber(const unsigned char *text, size_t length, double *value, bool *isPercentage)
+{
+    size_t i = 0;
+    double number = 0;
+    bool hasDigits = false;
+    while ((i < length) && (text[i] >= '0') && (text[i] <= '9'))
+    {
+        number = (number * 10) + (text[i] - '0');
+        hasDigits = true;
+        i++;
+    }
+    if ((i < length) && (text[i] == '.'))
+    {
+        i++;
+        double scale = 0.1;
+        while ((i < length) && (text[i] >= '0') && (text[i] <= '9'))
+        {
+            number += (text[i] - '0') * scale;
+            scale *= 0.1;
+            hasDigits = true;
+            i++;
+        }
+    }
+    if (!hasDigits)
+    {
+        return 0;
+    }
+    *isPercentage = (i < length) && (text[i] == '%');
+    if (*isPercentage)
+    {
+        i++;
+    }
+    *value = number;
+    return i;
+}
+
+static bool UBKColourTokensParseFunction(const unsigned char *text, size_t length, uint32_t *colour)
+{
+    size_t i;
+    if ((length > 5) && (memcmp(text, "rgba(", 5) == 0))
+    {
+        i = 5;
+    }
+    else if ((length > 4) && (memcmp(text, "rgb(", 4) == 0))
+    {
+        i = 4;
+    }
+    else
+    {
+        return false;
+    }
+    
+    double channels[4] = {0, 0, 0, 1};
+    int channelCount = 0;
+    while (true)
+    {
+        while ((i < length) && ((UBKColourTokensIsSpace(text[i])) || (text[i] == ',') || ((text[i] == '/') && (channelCount == 3))))
+        {
+            i++;
+        }
+        if ((i < length) && (text[i] == ')'))
+        {
+            i++;
+            break;
+        }
+        if (channelCount == 4)
+        {
+            return false;
+        }
+        double value;
+        bool isPercentage;
+        size_t used = UBKColourTokensParseNumber(text + i, length - i, &value, &isPercentage);
+        if (used == 0)
+        {
+            return false;
+        }
+        if (channelCount < 3)
+        {
+            channels[channelCount] = isPercentage ? (value * 255 / 100) : value;
+        }
+        else
+        {
+            channels[channelCount] = (isPercentage ? (value / 100) : value) * 255;
+        }
+        channelCount++;
+        i += used;
+    }
+    if ((i != length) || (channelCount < 3))
+    {
+        return false;
+    }
+    if (channelCount == 3)
+    {
+        channels[3] = 255;
+    }
+    *colour = (UBKColourTokensChannel(channels[0]) << 24) | (UBKColourTokensChannel(channels[1]) << 16) | (UBKColourTokensChannel(channels[2]) << 8) | UBKColourTokensChannel(channels[3]);
+    return true;
+}
+
+bool UBKColourTokensParseColour(const char *text, size_t length, uint32_t *colour)
+{
+    const unsigned char *bytes = (const unsigned char *)text;
+    while ((length > 0) && (UBKColourTokensIsSpace(bytes[0])))
+    {
+        bytes++;
+        length--;
+    }
+    while ((length > 0) && (UBKColourTokensIsSpace(bytes[length - 1])))
+    {
+        length--;
+    }
+    if (length == 0)
+    {
+        return false;
+    }
+    if (bytes[0] == '#')
+    {
+        return UBKColourTokensParseHex(bytes + 1, length - 1, colour);
+    }
+    return UBKColourTokensParseFunction(bytes, length, colour);
+}
+
+static inline bool UBKColourTokensAppendString(UBKColourTokens *tokens, const char *bytes, size_t length)
+{
+    if (length == 0)
+    {
+        return true;
+    }
+    if (!UBKColourTokensReserve(&tokens->string, &tokens->stringCapacity, tokens->stringLength + length))
+    {
+        return false;
+    }
+    memcpy(tokens->string + tokens->stringLength, bytes, length);
+    tokens->stringLength += length;
+    return true;
+}
+
+static bool UBKColourTokensAppendCodePoint(UBKColourTokens *tokens, uint32_t codePoint)
+{
+    char utf8[4];
+    size_t length;
+    if (codePoint < 0x80)
+    {
+        utf8[0] = (char)codePoint;
+        length = 1;
+    }
+    else if (codePoint < 0x800)
+    {
+        utf8[0] = (char)(0xC0 | (codePoint >> 6));
+        utf8[1] = (char)(0x80 | (codePoint & 0x3F));
+        length = 2;
+    }
+    else if (codePoint < 0x10000)
+    {
+        utf8[0] = (char)(0xE0 | (codePoint >> 12));
+        utf8[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        utf8[2] = (char)(0x80 | (codePoint & 0x3F));
+        length = 3;
+    }
+    else
+    {
+        utf8[0] = (char)(0xF0 | (codePoint >> 18));
+        utf8[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+        utf8[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        utf8[3] = (char)(0x80 | (codePoint & 0x3F));
+        length = 4;
+    }
+    return UBKColourTokensAppendString(tokens, utf8, length);
+}
+
+static void UBKColourTokensEndValue(UBKColourTokens *tokens)
+{
+    tokens->state = (tokens->depth == 0) ? UBKColourTokensStateDone : UBKColourTokensStateCommaOrEnd;
+}
+
+static bool UBKColourTokensPush(UBKColourTokens *tokens, uint8_t type)
+{
+    if (tokens->depth == UBKColourTokensMaxDepth)
+    {
+        return false;
+    }
+    tokens->containerTypes[tokens->depth] = type;
+    tokens->containerPaths[tokens->depth] = tokens->pathLength;
+    tokens->depth++;
+    tokens->state = (type == '{') ? UBKColourTokensStateKeyOrEnd : UBKColourTokensStateValueOrEnd;
+    return true;
+}
+
+static void UBKColourTokensPop(UBKColourTokens *tokens)
+{
+    tokens->depth--;
+    tokens->pathLength = tokens->containerPaths[tokens->depth];
+    UBKColourTokensEndValue(tokens);
+}
+
+static bool UBKColourTokensEndKey(UBKColourTokens *tokens)
+{
+    size_t base = tokens->containerPaths[tokens->depth - 1];
+    size_t separator = (base > 0) ? 1 : 0;
+    if (!UBKColourTokensReserve(&tokens->path, &tokens->pathCapacity, base + separator + tokens->stringLength))
+    {
+        return false;
+    }
+    if (separator)
+    {
+        tokens->path[base] = '.';
+    }
+    if (tokens->stringLength > 0)
+    {
+        memcpy(tokens->path + base + separator, tokens->string, tokens->stringLength);
+    }
+    tokens->pathLength = base + separator + tokens->stringLength;
+    tokens->state = UBKColourTokensStateColon;
+    return true;
+}
+
+static bool UBKColourTokensEndStringValue(UBKColourTokens *tokens)
+{
+    UBKColourTokensEndValue(tokens);
+    uint32_t colour;
+    if (!UBKColourTokensParseColour(tokens->string, tokens->stringLength, &colour))
+    {
+        return true;
+    }
+    
+    //{"background": {"$value": "#FFF"}} is named background
+    size_t nameLength = tokens->pathLength;
+    if ((tokens->depth > 0) && (tokens->containerTypes[tokens->depth - 1] == '{'))
+    {
+        size_t base = tokens->containerPaths[tokens->depth - 1];
+        size_t keyStart = (base > 0) ? base + 1 : 0;
+        size_t keyLength = tokens->pathLength - keyStart;
+        const char *key = tokens->path + keyStart;
+        if (((keyLength == 6) && (memcmp(key, "$value", 6) == 0)) || ((keyLength == 5) && (memcmp(key, "value", 5) == 0)))
+        {
+            nameLength = base;
+        }
+    }
+    return UBKColourTokensAdd(tokens, colour, tokens->path, nameLength);
+}
+
+static inline bool UBKColourTokensIsLiteral(unsigned char character)
+{
+    return ((character >= '0') && (character <= '9')) || ((character >= 'a') && (character <= 'z')) || ((character >= 'A') && (character <= 'Z')) || (character == '-') || (character == '+') || (character == '.');
+}
+
+//Reads the string up to its closing quote or the end of the chunk. Runs without escapes are copied in one go.
+static size_t UBKColourTokensReadString(UBKColourTokens *tokens, const unsigned char *bytes, size_t length)
+{
+    size_t i = 0;
+    while ((i < length) && (bytes[i] != '"') && (bytes[i] != '\\') && (bytes[i] >= 0x20))
+    {
+        i++;
+    }
+    if (!UBKColourTokensAppendString(tokens, (const char *)bytes, i))
+    {
+        tokens->failed = true;
+        return i;
+    }
+    if (i == length)
+    {
+        return i;
+    }
+    if (bytes[i] == '"')
+    {
+        bool added = tokens->stringIsKey ? UBKColourTokensEndKey(tokens) : UBKColourTokensEndStringValue(tokens);
+        tokens->failed = !added;
+    }
+    else if (bytes[i] == '\\')
+    {
+        tokens->state = UBKColourTokensStateStringEscape;
+    }
+    else
+    {
+        //Control characters have to be escaped
+        tokens->failed = true;
+    }
+    return i + 1;
+}
+
+static void UBKColourTokensReadEscape(UBKColourTokens *tokens, unsigned char character)
+{
+    char unescaped;
+    switch (character)
+    {
+        case '"': unescaped = '"'; break;
+        case '\\': unescaped = '\\'; break;
+        case '/': unescaped = '/'; break;
+        case 'b': unescaped = '\b'; break;
+        case 'f': unescaped = '\f'; break;
+        case 'n': unescaped = '\n'; break;
+        case 'r': unescaped = '\r'; break;
+        case 't': unescaped = '\t'; break;
+        case 'u':
+        {
+            tokens->escape = 0;
+            tokens->escapeDigits = 0;
+            tokens->state = UBKColourTokensStateStringUnicode;
+            return;
+        }
+        default:
+        {
+            tokens->failed = true;
+            return;
+        }
+    }
+    tokens->failed = !UBKColourTokensAppendString(tokens, &unescaped, 1);
+    tokens->state = UBKColourTokensStateString;
+}
+
+static void UBKColourTokensReadUnicode(UBKColourTokens *tokens, unsigned char character)
+{
+    int digit = UBKColourTokensHexDigit(character);
+    if (digit < 0)
+    {
+        tokens->failed = true;
+        return;
+    }
+    tokens->escape = (tokens->escape << 4) | (uint32_t)digit;
+    if (++tokens->escapeDigits < 4)
+    {
+        return;
+    }
+    tokens->state = UBKColourTokensStateString;
+    
+    uint32_t codeUnit = tokens->escape;
+    if ((codeUnit >= 0xD800) && (codeUnit < 0xDC00))
+    {
+        //High surrogate, wait for the low half
+        tokens->highSurrogate = codeUnit;
+        return;
+    }
+    uint32_t codePoint = codeUnit;
+    if ((codeUnit >= 0xDC00) && (codeUnit < 0xE000))
+    {
+        //A low surrogate on its own can't be encoded, use the replacement character
+        codePoint = (tokens->highSurrogate != 0) ? (0x10000 + ((tokens->highSurrogate - 0xD800) << 10) + (codeUnit - 0xDC00)) : 0xFFFD;
+    }
+    tokens->highSurrogate = 0;
+    tokens->failed = !UBKColourTokensAppendCodePoint(tokens, codePoint);
+}
+
+static void UBKColourTokensStartString(UBKColourTokens *tokens, bool isKey)
+{
+    tokens->stringLength = 0;
+    tokens->stringIsKey = isKey;
+    tokens->highSurrogate = 0;
+    tokens->state = UBKColourTokensStateString;
+}
+
+bool UBKColourTokensParse(UBKColourTokens *tokens, const char *bytes, size_t length)
+{
+    const unsigned char *text = (const unsigned char *)bytes;
+    size_t i = 0;
+    while ((i < length) && (!tokens->failed))
+    {
+        unsigned char character = text[i];
+        switch (tokens->state)
+        {
+            case UBKColourTokensStateString:
+            {
+                i += UBKColourTokensReadString(tokens, text + i, length - i);
+                continue;
+            }
+            case UBKColourTokensStateStringEscape:
+            {
+                UBKColourTokensReadEscape(tokens, character);
+                break;
+            }
+            case UBKColourTokensStateStringUnicode:
+            {
+                UBKColourTokensReadUnicode(tokens, character);
+                break;
+            }
+            case UBKColourTokensStateLiteral:
+            {
+                if (UBKColourTokensIsLiteral(character))
+                {
+                    break;
+                }
+                //The literal ended, read the character again as whatever follows it
+                UBKColourTokensEndValue(tokens);
+                continue;
+            }
+            default:
+            {
+                if (UBKColourTokensIsSpace(character))
+                {
+                    break;
+                }
+                switch (tokens->state)
+                {
+                    case UBKColourTokensStateValueOrEnd:
+                    case UBKColourTokensStateValue:
+                    {
+                        if ((character == ']') && (tokens->state == UBKColourTokensStateValueOrEnd))
+                        {
+                            UBKColourTokensPop(tokens);
+                        }
+                        else if ((character == '{') || (character == '['))
+                        {
+                            tokens->failed = !UBKColourTokensPush(tokens, character);
+                        }
+                        else if (character == '"')
+                        {
+                            UBKColourTokensStartString(tokens, false);
+                        }
+                        else if (UBKColourTokensIsLiteral(character))
+                        {
+                            tokens->state = UBKColourTokensStateLiteral;
+                        }
+                        else
+                        {
+                            tokens->failed = true;
+                        }
+                        break;
+                    }
+                    case UBKColourTokensStateKeyOrEnd:
+                    case UBKColourTokensStateKey:
+                    {
+                        if ((character == '}') && (tokens->state == UBKColourTokensStateKeyOrEnd))
+                        {
+                            UBKColourTokensPop(tokens);
+                        }
+                        else if (character == '"')
+                        {
+                            UBKColourTokensStartString(tokens, true);
+                        }
+                        else
+                        {
+                            tokens->failed = true;
+                        }
+                        break;
+                    }
+                    case UBKColourTokensStateColon:
+                    {
+                        tokens->state = UBKColourTokensStateValue;
+                        tokens->failed = (character != ':');
+                        break;
+                    }
+                    case UBKColourTokensStateCommaOrEnd:
+                    {
+                        uint8_t type = tokens->containerTypes[tokens->depth - 1];
+                        if (character == ',')
+                        {
+                            tokens->state = (type == '{') ? UBKColourTokensStateKey : UBKColourTokensStateValue;
+                        }
+                        else if (((character == '}') && (type == '{')) || ((character == ']') && (type == '[')))
+                        {
+                            UBKColourTokensPop(tokens);
+                        }
+                        else
+                        {
+                            tokens->failed = true;
+                        }
+                        break;
+                    }
+                    default:
+                    {
+                        //Only whitespace can follow the document
+                        tokens->failed = true;
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+        i++;
+    }
+    return !tokens->failed;
+}
+
+bool UBKColourTokensFinish(UBKColourTokens *tokens)
+{
+    if ((tokens->state == UBKColourTokensStateLiteral) && (tokens->depth == 0))
+    {
+        tokens->state = UBKColourTokensStateDone;
+    }
+    return (!tokens->failed) && (tokens->state == UBKColourTokensStateDone);
+}
+
+bool UBKColourTokensParseFile(UBKColourTokens *tokens, const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+    char *chunk = malloc(UBKColourTokensChunkSize);
+    if (chunk == NULL)
+    {
+        fclose(file);
+        return false;
+    }
+    
+    bool parsed = true;
+    size_t length;
+    while ((parsed) && ((length = fread(chunk, 1, UBKColourTokensChunkSize, file)) > 0))
+    {
+        parsed = UBKColourTokensParse(tokens, chunk, length);
+    }
+    bool readError = ferror(file) != 0;
+    free(chunk);
+    fclose(file);
+    return (!readError) && (UBKColourTokensFinish(tokens));
+}
@@ -0,0 +1,110 @@
+/*
+ File: UBKColourTokens.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKColourTokens_h
+#define UBKColourTokens_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Palette built from design token JSON, eg the W3C design tokens format or Style Dictionary output. The JSON is fed in chunks through a small state machine, no document tree is built, and every string value that parses as a colour is a token. Tokens are named by the keys leading to them with a trailing $value or value key dropped, eg "color.dark.background".
+//Tokens are deduplicated by their packed colour while they're read, so the palette and its index are built in the same pass. Nothing in here depends on UIKit.
+
+#define UBKColourTokensMaxDepth 256
+
+typedef struct {
+    //Clamped and rounded 8 bit sRGB, 0xRRGGBBAA, the same packing as UBKColourValue.key
+    uint32_t colour;
+    //Name of the first token with this colour, a nul terminated string in names
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    //Tokens with this colour, including the first
+    uint32_t tokenCount;
+} UBKColourTokenEntry;
+
+typedef struct {
+    //Unique colours in the order they were first read
+    UBKColourTokenEntry *entries;
+    uint32_t count;
+    uint32_t capacity;
+    char *names;
+    size_t namesLength;
+    size_t namesCapacity;
+    //Open addressing map of colour to entry index + 1, 0 for empty slots
+    uint32_t *slots;
+    uint32_t slotCapacity;
+    //Colour tokens read, including duplicates
+    uint64_t tokenCount;
+    
+    //Parser state between chunks
+    int state;
+    bool failed;
+    //Keys of the current value joined with dots
+    char *path;
+    size_t pathLength;
+    size_t pathCapacity;
+    //'{' or '[' for each open container, and the path length when it was opened
+    uint8_t containerTypes[UBKColourTokensMaxDepth];
+    size_t containerPaths[UBKColourTokensMaxDepth];
+    uint32_t depth;
+    //String being read, it can span chunks
+    char *string;
+    size_t stringLength;
+    size_t stringCapacity;
+    bool stringIsKey;
+    uint32_t escape;
+    uint32_t escapeDigits;
+    uint32_t highSurrogate;
+} UBKColourTokens;
+
+void UBKColourTokensInit(UBKColourTokens *tokens);
+void UBKColourTokensDestroy(UBKColourTokens *tokens);
+
+//Reads the next chunk of JSON, chunks can split the text anywhere, including inside strings. Returns false once the JSON is malformed or memory couldn't be allocated, later chunks are ignored.
+bool UBKColourTokensParse(UBKColourTokens *tokens, const char *bytes, size_t length);
+
+//Call after the last chunk. Returns false if the JSON was malformed or incomplete, the tokens read before the error are kept.
+bool UBKColourTokensFinish(UBKColourTokens *tokens);
+
+//Streams a file through UBKColourTokensParse in fixed size chunks and calls UBKColourTokensFinish.
+bool UBKColourTokensParseFile(UBKColourTokens *tokens, const char *path);
+
+//Index of the entry with the colour, -1 when no token had it
+int32_t UBKColourTokensFind(const UBKColourTokens *tokens, uint32_t colour);
+
+static inline const char *UBKColourTokensName(const UBKColourTokens *tokens, const UBKColourTokenEntry *entry)
+{
+    return tokens->names + entry->nameOffset;
+}
+
+//Parses #RGB, #RGBA, #RRGGBB, #RRGGBBAA, rgb() and rgba() into 0xRRGGBBAA. rgb channels are 0...255 or percentages, alpha is 0...1 or a percentage, separated by commas, spaces or a slash before the alpha. Leading and trailing spaces are ignored.
+bool UBKColourTokensParseColour(const char *text, size_t length, uint32_t *colour);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKColourTokens_h */
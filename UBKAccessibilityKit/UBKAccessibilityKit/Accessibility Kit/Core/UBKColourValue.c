@@ -0,0 +1,118 @@
+/*
+ File: UBKColourValue.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKColourValue.h"
+
+#include <math.h>
+
+static uint32_t UBKColourValueChannel(float value)
+{
+    if (!(value > 0))
+    {
+        return 0;
+    }
+    if (value >= 1)
+    {
+        return 255;
+    }
+    return (uint32_t)lroundf(value * 255);
+}
+
+float UBKColourValueLinearFromEncoded(float value)
+{
+    float magnitude = fabsf(value);
+    float linear = (magnitude <= 0.04045f) ? magnitude / 12.92f : powf((magnitude + 0.055f) / 1.055f, 2.4f);
+    return copysignf(linear, value);
+}
+
+float UBKColourValueEncodedFromLinear(float value)
+{
+    float magnitude = fabsf(value);
+    float encoded = (magnitude <= 0.0031308f) ? magnitude * 12.92f : (1.055f * powf(magnitude, 1 / 2.4f)) - 0.055f;
+    return copysignf(encoded, value);
+}
+
+UBKColourValue UBKColourValueMakeLinear(float red, float green, float blue, float alpha)
+{
+    UBKColourValue colour;
+    colour.linear[0] = red;
+    colour.linear[1] = green;
+    colour.linear[2] = blue;
+    colour.linear[3] = alpha;
+    
+    colour.key = (UBKColourValueChannel(UBKColourValueEncodedFromLinear(red)) << 24) | (UBKColourValueChannel(UBKColourValueEncodedFromLinear(green)) << 16) | (UBKColourValueChannel(UBKColourValueEncodedFromLinear(blue)) << 8) | UBKColourValueChannel(alpha);
+    
+    //Luminance is a weighted sum of the linear primaries, which still holds for out of gamut values
+    double luminance = (0.2126 * red) + (0.7152 * green) + (0.0722 * blue);
+    colour.luminance = luminance < 0 ? 0 : (luminance > 1 ? 1 : luminance);
+    colour.hasComponents = true;
+    return colour;
+}
+
+UBKColourValue UBKColourValueMakeUnknown(void)
+{
+    UBKColourValue colour = { { 0, 0, 0, 0 }, 0, 0, false };
+    return colour;
+}
+
+UBKColourValue UBKColourValueMakeRGBA8(UBKColourRGBA8 colour)
+{
+    return UBKColourValueMakeLinear(UBKColourValueLinearFromEncoded(colour.r / 255.0f), UBKColourValueLinearFromEncoded(colour.g / 255.0f), UBKColourValueLinearFromEncoded(colour.b / 255.0f), colour.a / 255.0f);
+}
+
+UBKColourValue UBKColourValueComposite(UBKColourValue top, float opacity, UBKColourValue under)
+{
+    float alpha = top.linear[3] * opacity;
+    if ((!top.hasComponents) || (!(alpha > 0)))
+    {
+        return under;
+    }
+    if ((!under.hasComponents) || (alpha >= 1))
+    {
+        return top;
+    }
+    
+    //Premultiplied source over, un-premultiplied again so translucent results can be composited further down
+    float underAlpha = under.linear[3];
+    float resultAlpha = alpha + (underAlpha * (1 - alpha));
+    float encoded[3];
+    for (int i = 0; i < 3; i++)
+    {
+        float topEncoded = UBKColourValueEncodedFromLinear(top.linear[i]);
+        float underEncoded = UBKColourValueEncodedFromLinear(under.linear[i]);
+        float premultiplied = (topEncoded * alpha) + (underEncoded * underAlpha * (1 - alpha));
+        encoded[i] = (resultAlpha > 0) ? premultiplied / resultAlpha : 0;
+    }
+    return UBKColourValueMakeLinear(UBKColourValueLinearFromEncoded(encoded[0]), UBKColourValueLinearFromEncoded(encoded[1]), UBKColourValueLinearFromEncoded(encoded[2]), resultAlpha);
+}
+
+double UBKColourValueContrastRatio(UBKColourValue first, UBKColourValue second)
+{
+    double lighter = first.luminance > second.luminance ? first.luminance : second.luminance;
+    double darker = first.luminance > second.luminance ? second.luminance : first.luminance;
+    return (lighter + 0.05) / (darker + 0.05);
+}
+
+UBKColourRGBA8 UBKColourValueRGBA8(UBKColourValue colour)
+{
+    UBKColourRGBA8 rgba = { (uint8_t)(colour.key >> 24), (uint8_t)(colour.key >> 16), (uint8_t)(colour.key >> 8), (uint8_t)colour.key };
+    return rgba;
+}
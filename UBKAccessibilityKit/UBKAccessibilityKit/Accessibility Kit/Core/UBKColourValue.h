@@ -0,0 +1,72 @@
+/*
+ File: UBKColourValue.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKColourValue_h
+#define UBKColourValue_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "UBKColourVision.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Canonical colour used by every contrast and colour comparison. Colours are converted once into linear sRGB primaries, values outside 0...1 are kept so wide gamut (eg Display P3) and extended range colours keep their real luminance.
+
+typedef struct {
+    //Linear light red, green and blue in sRGB primaries, then alpha
+    float linear[4];
+    //Clamped and rounded 8 bit sRGB, 0xRRGGBBAA. Colours with the same key look the same on an sRGB display, compare keys for equality.
+    uint32_t key;
+    //Relative luminance as defined by WCAG, clamped to 0...1
+    double luminance;
+    //False for colours that can't be converted, eg pattern colours. Everything else is 0.
+    bool hasComponents;
+} UBKColourValue;
+
+UBKColourValue UBKColourValueMakeLinear(float red, float green, float blue, float alpha);
+UBKColourValue UBKColourValueMakeRGBA8(UBKColourRGBA8 colour);
+UBKColourValue UBKColourValueMakeUnknown(void);
+
+//sRGB transfer functions, negative values are mirrored like the extended sRGB colour space
+float UBKColourValueLinearFromEncoded(float value);
+float UBKColourValueEncodedFromLinear(float value);
+
+//Source over compositing of top, with its alpha scaled by opacity, onto under. Colours are blended on their sRGB encoded values the way Core Animation blends them. When under has no components there's nothing known to blend with, so top is returned as is, or under when top is fully transparent.
+UBKColourValue UBKColourValueComposite(UBKColourValue top, float opacity, UBKColourValue under);
+
+//W3C contrast ratio, 1...21
+double UBKColourValueContrastRatio(UBKColourValue first, UBKColourValue second);
+
+UBKColourRGBA8 UBKColourValueRGBA8(UBKColourValue colour);
+
+static inline bool UBKColourValueEqual(UBKColourValue first, UBKColourValue second)
+{
+    return first.key == second.key;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKColourValue_h */
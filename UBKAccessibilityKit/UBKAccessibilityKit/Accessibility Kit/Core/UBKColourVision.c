@@ -0,0 +1,246 @@
+/*
+ File: UBKColourVision.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKColourVision.h"
+
+#include <math.h>
+#include <string.h>
+
+//Pairs are decoded in chunks into separate channel arrays so the per simulation loops are straight line float maths the compiler can vectorise.
+#define UBKColourVisionChunkSize 64
+
+//Linear values are quantised to this many steps before encoding back to 8 bit sRGB.
+#define UBKColourVisionEncodeTableSize 4096
+
+//Linear RGB to simulated linear RGB, row major.
+static const float UBKColourVisionMatrices[UBKColourVisionDeficiencyCount][9] = {
+    //Typical
+    { 1.000000f, 0.000000f, 0.000000f,
+      0.000000f, 1.000000f, 0.000000f,
+      0.000000f, 0.000000f, 1.000000f },
+    //Protanopia
+    { 0.152286f, 1.052583f, -0.204868f,
+      0.114503f, 0.786281f, 0.099216f,
+      -0.003882f, -0.048116f, 1.051998f },
+    //Deuteranopia
+    { 0.367322f, 0.860646f, -0.227968f,
+      0.280085f, 0.672501f, 0.047413f,
+      -0.011820f, 0.042940f, 0.968881f },
+    //Tritanopia
+    { 1.255528f, -0.076749f, -0.178779f,
+      -0.078411f, 0.930809f, 0.147602f,
+      0.004733f, 0.691367f, 0.303900f },
+    //Achromatopsia, every channel becomes the relative luminance
+    { 0.212600f, 0.715200f, 0.072200f,
+      0.212600f, 0.715200f, 0.072200f,
+      0.212600f, 0.715200f, 0.072200f }
+};
+
+//8 bit sRGB to linear, using the W3C 0.03928 threshold so typical vision matches the existing contrast ratio.
+static const float UBKColourVisionLinearTable[256] = {
+    0.000000000f, 0.000303527f, 0.000607054f, 0.000910581f, 0.001214108f, 0.001517635f, 0.001821162f, 0.002124689f,
+    0.002428216f, 0.002731743f, 0.003035270f, 0.003346536f, 0.003676507f, 0.004024717f, 0.004391442f, 0.004776953f,
+    0.005181517f, 0.005605392f, 0.006048833f, 0.006512091f, 0.006995410f, 0.007499032f, 0.008023193f, 0.008568126f,
+    0.009134059f, 0.009721217f, 0.010329823f, 0.010960094f, 0.011612245f, 0.012286488f, 0.012983032f, 0.013702083f,
+    0.014443844f, 0.015208514f, 0.015996293f, 0.016807376f, 0.017641954f, 0.018500220f, 0.019382361f, 0.020288563f,
+    0.021219010f, 0.022173885f, 0.023153366f, 0.024157632f, 0.025186860f, 0.026241222f, 0.027320892f, 0.028426040f,
+    0.029556834f, 0.030713444f, 0.031896033f, 0.033104767f, 0.034339807f, 0.035601315f, 0.036889450f, 0.038204372f,
+    0.039546235f, 0.040915197f, 0.042311411f, 0.043735029f, 0.045186204f, 0.046665086f, 0.048171824f, 0.049706566f,
+    0.051269458f, 0.052860647f, 0.054480276f, 0.056128490f, 0.057805430f, 0.059511238f, 0.061246054f, 0.063010018f,
+    0.064803267f, 0.066625939f, 0.068478170f, 0.070360096f, 0.072271851f, 0.074213568f, 0.076185381f, 0.078187422f,
+    0.080219820f, 0.082282707f, 0.084376212f, 0.086500462f, 0.088655586f, 0.090841711f, 0.093058963f, 0.095307467f,
+    0.097587347f, 0.099898728f, 0.102241733f, 0.104616484f, 0.107023103f, 0.109461711f, 0.111932428f, 0.114435374f,
+    0.116970668f, 0.119538428f, 0.122138772f, 0.124771818f, 0.127437680f, 0.130136477f, 0.132868322f, 0.135633330f,
+    0.138431615f, 0.141263291f, 0.144128471f, 0.147027266f, 0.149959790f, 0.152926152f, 0.155926464f, 0.158960835f,
+    0.162029376f, 0.165132195f, 0.168269400f, 0.171441101f, 0.174647404f, 0.177888416f, 0.181164244f, 0.184474995f,
+    0.187820772f, 0.191201683f, 0.194617830f, 0.198069320f, 0.201556254f, 0.205078736f, 0.208636870f, 0.212230757f,
+    0.215860500f, 0.219526200f, 0.223227957f, 0.226965874f, 0.230740049f, 0.234550582f, 0.238397574f, 0.242281122f,
+    0.246201327f, 0.250158285f, 0.254152094f, 0.258182853f, 0.262250658f, 0.266355605f, 0.270497791f, 0.274677312f,
+    0.278894263f, 0.283148740f, 0.287440838f, 0.291770650f, 0.296138271f, 0.300543794f, 0.304987314f, 0.309468923f,
+    0.313988713f, 0.318546778f, 0.323143209f, 0.327778098f, 0.332451536f, 0.337163615f, 0.341914425f, 0.346704056f,
+    0.351532600f, 0.356400144f, 0.361306780f, 0.366252596f, 0.371237680f, 0.376262123f, 0.381326011f, 0.386429434f,
+    0.391572478f, 0.396755231f, 0.401977780f, 0.407240212f, 0.412542613f, 0.417885071f, 0.423267670f, 0.428690497f,
+    0.434153636f, 0.439657174f, 0.445201195f, 0.450785783f, 0.456411023f, 0.462077000f, 0.467783796f, 0.473531496f,
+    0.479320183f, 0.485149940f, 0.491020850f, 0.496932995f, 0.502886458f, 0.508881321f, 0.514917665f, 0.520995573f,
+    0.527115126f, 0.533276404f, 0.539479489f, 0.545724461f, 0.552011402f, 0.558340390f, 0.564711506f, 0.571124829f,
+    0.577580440f, 0.584078418f, 0.590618841f, 0.597201788f, 0.603827339f, 0.610495571f, 0.617206562f, 0.623960392f,
+    0.630757136f, 0.637596874f, 0.644479682f, 0.651405637f, 0.658374817f, 0.665387298f, 0.672443157f, 0.679542470f,
+    0.686685312f, 0.693871761f, 0.701101892f, 0.708375780f, 0.715693501f, 0.723055129f, 0.730460740f, 0.737910409f,
+    0.745404210f, 0.752942217f, 0.760524505f, 0.768151147f, 0.775822218f, 0.783537792f, 0.791297940f, 0.799102738f,
+    0.806952258f, 0.814846572f, 0.822785754f, 0.830769877f, 0.838799012f, 0.846873232f, 0.854992608f, 0.863157213f,
+    0.871367119f, 0.879622397f, 0.887923118f, 0.896269353f, 0.904661174f, 0.913098652f, 0.921581856f, 0.930110858f,
+    0.938685728f, 0.947306537f, 0.955973353f, 0.964686248f, 0.973445290f, 0.982250550f, 0.991102097f, 1.000000000f
+};
+
+static inline float UBKColourVisionClamp(float value)
+{
+    value = value < 0.0f ? 0.0f : value;
+    return value > 1.0f ? 1.0f : value;
+}
+
+static inline float UBKColourVisionLuminance(const float *matrix, float r, float g, float b)
+{
+    float simulatedR = UBKColourVisionClamp((matrix[0] * r) + (matrix[1] * g) + (matrix[2] * b));
+    float simulatedG = UBKColourVisionClamp((matrix[3] * r) + (matrix[4] * g) + (matrix[5] * b));
+    float simulatedB = UBKColourVisionClamp((matrix[6] * r) + (matrix[7] * g) + (matrix[8] * b));
+    return (0.2126f * simulatedR) + (0.7152f * simulatedG) + (0.0722f * simulatedB);
+}
+
+void UBKColourVisionContrastRatios(const UBKColourRGBA8 *foreground, const UBKColourRGBA8 *background, size_t pairCount, float *ratios)
+{
+    float foregroundR[UBKColourVisionChunkSize];
+    float foregroundG[UBKColourVisionChunkSize];
+    float foregroundB[UBKColourVisionChunkSize];
+    float backgroundR[UBKColourVisionChunkSize];
+    float backgroundG[UBKColourVisionChunkSize];
+    float backgroundB[UBKColourVisionChunkSize];
+    
+    for (size_t start = 0; start < pairCount; start += UBKColourVisionChunkSize)
+    {
+        size_t count = pairCount - start;
+        if (count > UBKColourVisionChunkSize)
+        {
+            count = UBKColourVisionChunkSize;
+        }
+        
+        //Decode each pair once, every simulation reuses the linear values
+        for (size_t i = 0; i < count; i++)
+        {
+            foregroundR[i] = UBKColourVisionLinearTable[foreground[start + i].r];
+            foregroundG[i] = UBKColourVisionLinearTable[foreground[start + i].g];
+            foregroundB[i] = UBKColourVisionLinearTable[foreground[start + i].b];
+            backgroundR[i] = UBKColourVisionLinearTable[background[start + i].r];
+            backgroundG[i] = UBKColourVisionLinearTable[background[start + i].g];
+            backgroundB[i] = UBKColourVisionLinearTable[background[start + i].b];
+        }
+        
+        for (size_t deficiency = 0; deficiency < UBKColourVisionDeficiencyCount; deficiency++)
+        {
+            const float *matrix = UBKColourVisionMatrices[deficiency];
+            float *output = ratios + (deficiency * pairCount) + start;
+            for (size_t i = 0; i < count; i++)
+            {
+                float foregroundLuminance = UBKColourVisionLuminance(matrix, foregroundR[i], foregroundG[i], foregroundB[i]);
+                float backgroundLuminance = UBKColourVisionLuminance(matrix, backgroundR[i], backgroundG[i], backgroundB[i]);
+                float lighter = foregroundLuminance > backgroundLuminance ? foregroundLuminance : backgroundLuminance;
+                float darker = foregroundLuminance > backgroundLuminance ? backgroundLuminance : foregroundLuminance;
+                output[i] = (lighter + 0.05f) / (darker + 0.05f);
+            }
+        }
+    }
+}
+
+static void UBKColourVisionBuildEncodeTable(uint8_t *table)
+{
+    for (size_t i = 0; i < UBKColourVisionEncodeTableSize; i++)
+    {
+        float linear = (float)i / (float)(UBKColourVisionEncodeTableSize - 1);
+        float encoded = linear <= 0.0031308f ? linear * 12.92f : (1.055f * powf(linear, 1.0f / 2.4f)) - 0.055f;
+        table[i] = (uint8_t)(UBKColourVisionClamp(encoded) * 255.0f + 0.5f);
+    }
+}
+
+static inline uint8_t UBKColourVisionEncode(const uint8_t *table, float linear)
+{
+    return table[(size_t)(linear * (float)(UBKColourVisionEncodeTableSize - 1) + 0.5f)];
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+
+//Four pixels per step, one lane per pixel. Uses the compiler vector extensions so the same code maps to NEON on device and SSE on the simulator or Linux.
+typedef float UBKFloat4 __attribute__((vector_size(16)));
+typedef int32_t UBKInt4 __attribute__((vector_size(16)));
+
+static inline UBKFloat4 UBKFloat4Clamp(UBKFloat4 value)
+{
+    const UBKFloat4 zero = { 0.0f, 0.0f, 0.0f, 0.0f };
+    const UBKFloat4 one = { 1.0f, 1.0f, 1.0f, 1.0f };
+    UBKInt4 below = (UBKInt4)(value < zero);
+    UBKInt4 above = (UBKInt4)(value > one);
+    UBKInt4 bits = (UBKInt4)value & ~below;
+    bits = (bits & ~above) | ((UBKInt4)one & above);
+    return (UBKFloat4)bits;
+}
+
+static void UBKColourVisionSimulateBlock(const float *matrix, const uint8_t *encodeTable, const UBKColourRGBA8 *pixels, UBKColourRGBA8 *output)
+{
+    UBKFloat4 r = { UBKColourVisionLinearTable[pixels[0].r], UBKColourVisionLinearTable[pixels[1].r], UBKColourVisionLinearTable[pixels[2].r], UBKColourVisionLinearTable[pixels[3].r] };
+    UBKFloat4 g = { UBKColourVisionLinearTable[pixels[0].g], UBKColourVisionLinearTable[pixels[1].g], UBKColourVisionLinearTable[pixels[2].g], UBKColourVisionLinearTable[pixels[3].g] };
+    UBKFloat4 b = { UBKColourVisionLinearTable[pixels[0].b], UBKColourVisionLinearTable[pixels[1].b], UBKColourVisionLinearTable[pixels[2].b], UBKColourVisionLinearTable[pixels[3].b] };
+    
+    UBKFloat4 simulatedR = UBKFloat4Clamp((matrix[0] * r) + (matrix[1] * g) + (matrix[2] * b));
+    UBKFloat4 simulatedG = UBKFloat4Clamp((matrix[3] * r) + (matrix[4] * g) + (matrix[5] * b));
+    UBKFloat4 simulatedB = UBKFloat4Clamp((matrix[6] * r) + (matrix[7] * g) + (matrix[8] * b));
+    
+    for (int lane = 0; lane < 4; lane++)
+    {
+        output[lane].r = UBKColourVisionEncode(encodeTable, simulatedR[lane]);
+        output[lane].g = UBKColourVisionEncode(encodeTable, simulatedG[lane]);
+        output[lane].b = UBKColourVisionEncode(encodeTable, simulatedB[lane]);
+        output[lane].a = pixels[lane].a;
+    }
+}
+
+void UBKColourVisionSimulatePixels(UBKColourVisionDeficiency deficiency, const UBKColourRGBA8 *pixels, size_t pixelCount, UBKColourRGBA8 *output)
+{
+    uint8_t encodeTable[UBKColourVisionEncodeTableSize];
+    UBKColourVisionBuildEncodeTable(encodeTable);
+    const float *matrix = UBKColourVisionMatrices[deficiency];
+    
+    size_t index = 0;
+    for (; index + 4 <= pixelCount; index += 4)
+    {
+        UBKColourVisionSimulateBlock(matrix, encodeTable, pixels + index, output + index);
+    }
+    
+    //Pad the last few pixels out to a full block
+    if (index < pixelCount)
+    {
+        UBKColourRGBA8 tail[4];
+        memset(tail, 0, sizeof(tail));
+        memcpy(tail, pixels + index, (pixelCount - index) * sizeof(UBKColourRGBA8));
+        UBKColourVisionSimulateBlock(matrix, encodeTable, tail, tail);
+        memcpy(output + index, tail, (pixelCount - index) * sizeof(UBKColourRGBA8));
+    }
+}
+
+#else
+
+void UBKColourVisionSimulatePixels(UBKColourVisionDeficiency deficiency, const UBKColourRGBA8 *pixels, size_t pixelCount, UBKColourRGBA8 *output)
+{
+    uint8_t encodeTable[UBKColourVisionEncodeTableSize];
+    UBKColourVisionBuildEncodeTable(encodeTable);
+    const float *matrix = UBKColourVisionMatrices[deficiency];
+    
+    for (size_t i = 0; i < pixelCount; i++)
+    {
+        float r = UBKColourVisionLinearTable[pixels[i].r];
+        float g = UBKColourVisionLinearTable[pixels[i].g];
+        float b = UBKColourVisionLinearTable[pixels[i].b];
+        uint8_t alpha = pixels[i].a;
+        output[i].r = UBKColourVisionEncode(encodeTable, UBKColourVisionClamp((matrix[0] * r) + (matrix[1] * g) + (matrix[2] * b)));
+        output[i].g = UBKColourVisionEncode(encodeTable, UBKColourVisionClamp((matrix[3] * r) + (matrix[4] * g) + (matrix[5] * b)));
+        output[i].b = UBKColourVisionEncode(encodeTable, UBKColourVisionClamp((matrix[6] * r) + (matrix[7] * g) + (matrix[8] * b)));
+        output[i].a = alpha;
+    }
+}
+
+#endif
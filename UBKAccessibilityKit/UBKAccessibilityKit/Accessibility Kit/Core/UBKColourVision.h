@@ -0,0 +1,61 @@
+/*
+ File: UBKColourVision.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKColourVision_h
+#define UBKColourVision_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Colour vision deficiency simulation on raw colour buffers. The matrices are the full severity Machado, Oliveira and Fernandes (2009) transforms, applied in linear RGB.
+
+typedef enum {
+    UBKColourVisionTypical,
+    UBKColourVisionProtanopia,
+    UBKColourVisionDeuteranopia,
+    UBKColourVisionTritanopia,
+    UBKColourVisionAchromatopsia,
+    UBKColourVisionDeficiencyCount
+} UBKColourVisionDeficiency;
+
+//8 bit sRGB colour, the same precision the W3C contrast ratio is calculated with.
+typedef struct {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+} UBKColourRGBA8;
+
+//Contrast ratio of every foreground and background pair under every simulation, including typical vision. Ratios must hold pairCount * UBKColourVisionDeficiencyCount values and is filled deficiency first, ie ratios[deficiency * pairCount + pair].
+void UBKColourVisionContrastRatios(const UBKColourRGBA8 *foreground, const UBKColourRGBA8 *background, size_t pairCount, float *ratios);
+
+//Simulate a deficiency on packed RGBA pixels, eg a window capture. Alpha is copied through untouched and output may be the same buffer as pixels.
+void UBKColourVisionSimulatePixels(UBKColourVisionDeficiency deficiency, const UBKColourRGBA8 *pixels, size_t pixelCount, UBKColourRGBA8 *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKColourVision_h */
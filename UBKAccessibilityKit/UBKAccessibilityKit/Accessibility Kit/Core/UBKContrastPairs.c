@@ -0,0 +1,54 @@
+/*
+ File: UBKContrastPairs.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKContrastPairs.h"
+
+uint32_t UBKContrastPairsEvaluate(UBKContrastPair *pairs, uint32_t count, const UBKRuleEvaluator *evaluator)
+{
+    uint32_t failingCount = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        UBKContrastPair *pair = &pairs[i];
+        if ((!pair->foreground.hasComponents) || (!pair->background.hasComponents))
+        {
+            pair->contrast = 0;
+            pair->rating = UBKRuleRatingNA;
+            pair->isFailing = false;
+            continue;
+        }
+        UBKColourValue foreground = UBKColourValueComposite(pair->foreground, pair->opacity, pair->background);
+        pair->contrast = UBKColourValueContrastRatio(foreground, pair->background);
+        if (pair->flags & UBKContrastPairFlagText)
+        {
+            pair->rating = UBKRuleEvaluatorTextContrastRating(evaluator, pair->contrast, pair->textSize, pair->boldFont);
+        }
+        else
+        {
+            pair->rating = UBKRuleEvaluatorNonTextContrastRating(evaluator, pair->contrast);
+        }
+        pair->isFailing = (pair->rating == UBKRuleRatingFail) && (!(pair->flags & UBKContrastPairFlagInactive));
+        if (pair->isFailing)
+        {
+            failingCount++;
+        }
+    }
+    return failingCount;
+}
@@ -0,0 +1,67 @@
+/*
+ File: UBKContrastPairs.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKContrastPairs_h
+#define UBKContrastPairs_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "UBKColourValue.h"
+#include "UBKRuleProfile.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Foreground and background colour pairs of a control that aren't on screen at the moment, eg the title colour of a button in its highlighted state or the thumb of a switch over its on track. All the pairs of a control are captured together and rated with one call.
+
+typedef enum {
+    //Rated against the text thresholds with textSize and boldFont, everything else against the non text threshold
+    UBKContrastPairFlagText = 1 << 0,
+    //Shown but not rated as failing, eg the disabled state. WCAG has no contrast requirement for inactive components.
+    UBKContrastPairFlagInactive = 1 << 1
+} UBKContrastPairFlags;
+
+typedef struct {
+    //Colours as set, the foreground is composited over the background with opacity before rating
+    UBKColourValue foreground;
+    UBKColourValue background;
+    float opacity;
+    double textSize;
+    bool boldFont;
+    uint32_t flags;
+    //Caller's tag for the pair, eg the UIControlState
+    uint32_t tag;
+    //Filled in by UBKContrastPairsEvaluate. Pairs with a colour that has no components, eg a background image, have a contrast of 0 and UBKRuleRatingNA.
+    double contrast;
+    UBKRuleRating rating;
+    bool isFailing;
+} UBKContrastPair;
+
+//Rates every pair in one pass and returns how many are failing
+uint32_t UBKContrastPairsEvaluate(UBKContrastPair *pairs, uint32_t count, const UBKRuleEvaluator *evaluator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKContrastPairs_h */
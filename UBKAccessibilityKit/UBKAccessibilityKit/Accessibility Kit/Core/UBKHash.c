@@ -0,0 +1,172 @@
+/*
+ File: UBKHash.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "UBKHash.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define UBKHashPrime 0x100000001b3ULL
+
+//Zero marks an empty slot, so a real zero hash is stored as this value instead.
+#define UBKHashSetZeroReplacement 0x9e3779b97f4a7c15ULL
+
+uint64_t UBKHashBytes(uint64_t hash, const void *bytes, size_t length)
+{
+    const uint8_t *byte = (const uint8_t *)bytes;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= byte[i];
+        hash *= UBKHashPrime;
+    }
+    return hash;
+}
+
+uint64_t UBKHashString(uint64_t hash, const char *string)
+{
+    if (string == NULL)
+    {
+        return hash;
+    }
+    for (; *string; string++)
+    {
+        hash ^= (uint8_t)*string;
+        hash *= UBKHashPrime;
+    }
+    return hash;
+}
+
+static inline uint64_t UBKHashSetKey(uint64_t hash)
+{
+    return (hash == 0) ? UBKHashSetZeroReplacement : hash;
+}
+
+static size_t UBKHashSetRoundCapacity(size_t capacity)
+{
+    size_t rounded = 16;
+    while (rounded < capacity)
+    {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+bool UBKHashSetInit(UBKHashSet *set, size_t capacity)
+{
+    set->capacity = UBKHashSetRoundCapacity(capacity);
+    set->count = 0;
+    set->slots = calloc(set->capacity, sizeof(uint64_t));
+    if (set->slots == NULL)
+    {
+        set->capacity = 0;
+        return false;
+    }
+    return true;
+}
+
+void UBKHashSetDestroy(UBKHashSet *set)
+{
+    free(set->slots);
+    set->slots = NULL;
+    set->capacity = 0;
+    set->count = 0;
+}
+
+void UBKHashSetRemoveAll(UBKHashSet *set)
+{
+    if (set->slots)
+    {
+        memset(set->slots, 0, set->capacity * sizeof(uint64_t));
+    }
+    set->count = 0;
+}
+
+bool UBKHashSetContains(const UBKHashSet *set, uint64_t hash)
+{
+    if (set->capacity == 0)
+    {
+        return false;
+    }
+    uint64_t key = UBKHashSetKey(hash);
+    size_t mask = set->capacity - 1;
+    for (size_t slot = key & mask; ; slot = (slot + 1) & mask)
+    {
+        if (set->slots[slot] == key)
+        {
+            return true;
+        }
+        if (set->slots[slot] == 0)
+        {
+            return false;
+        }
+    }
+}
+
+static void UBKHashSetInsertKey(uint64_t *slots, size_t capacity, uint64_t key)
+{
+    size_t mask = capacity - 1;
+    size_t slot = key & mask;
+    while (slots[slot] != 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+    slots[slot] = key;
+}
+
+//Keep the load factor under 70% so probes stay short.
+static bool UBKHashSetGrowIfNeeded(UBKHashSet *set)
+{
+    if ((set->capacity != 0) && ((set->count + 1) * 10 < set->capacity * 7))
+    {
+        return true;
+    }
+    size_t capacity = (set->capacity == 0) ? 16 : set->capacity * 2;
+    uint64_t *slots = calloc(capacity, sizeof(uint64_t));
+    if (slots == NULL)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < set->capacity; i++)
+    {
+        if (set->slots[i] != 0)
+        {
+            UBKHashSetInsertKey(slots, capacity, set->slots[i]);
+        }
+    }
+    free(set->slots);
+    set->slots = slots;
+    set->capacity = capacity;
+    return true;
+}
+
+bool UBKHashSetInsert(UBKHashSet *set, uint64_t hash)
+{
+    if (UBKHashSetContains(set, hash))
+    {
+        return false;
+    }
+    if (!UBKHashSetGrowIfNeeded(set))
+    {
+        return false;
+    }
+    UBKHashSetInsertKey(set->slots, set->capacity, UBKHashSetKey(hash));
+    set->count++;
+    return true;
+}
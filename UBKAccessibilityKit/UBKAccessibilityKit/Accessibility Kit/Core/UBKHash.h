@@ -0,0 +1,68 @@
+/*
+ File: UBKHash.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef UBKHash_h
+#define UBKHash_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Portable hashing helpers shared by the snapshot, recorder and diff code. Nothing in here depends on UIKit.
+
+#define UBKHashInitialValue 0xcbf29ce484222325ULL
+
+//64 bit FNV-1a. Pass UBKHashInitialValue or a previous hash as the seed to chain values.
+uint64_t UBKHashBytes(uint64_t hash, const void *bytes, size_t length);
+uint64_t UBKHashString(uint64_t hash, const char *string);
+
+//Order dependent mix of a value into a hash.
+static inline uint64_t UBKHashCombine(uint64_t hash, uint64_t value)
+{
+    hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    hash ^= hash >> 31;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    return hash ^ (hash >> 29);
+}
+
+//Open addressing set of 64 bit hashes.
+typedef struct {
+    uint64_t *slots;
+    size_t capacity;
+    size_t count;
+} UBKHashSet;
+
+bool UBKHashSetInit(UBKHashSet *set, size_t capacity);
+void UBKHashSetDestroy(UBKHashSet *set);
+void UBKHashSetRemoveAll(UBKHashSet *set);
+bool UBKHashSetContains(const UBKHashSet *set, uint64_t hash);
+
+//Returns true if the hash was added, false if it was already in the set or the set couldn't grow.
+bool UBKHashSetInsert(UBKHashSet *set, uint64_t hash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKHash_h */
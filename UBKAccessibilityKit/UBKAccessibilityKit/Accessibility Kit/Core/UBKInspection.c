@@ -0,0 +1,1228 @@
+/*
+ File: UBKInspection.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKInspection.h"
+#include "UBKHash.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+//Type byte and length
+#define UBKInspectionFrameHeaderLength 5
+#define UBKInspectionMaximumStringLength 0xFFFF
+
+void UBKInspectionTreeInit(UBKInspectionTree *tree)
+{
+    memset(tree, 0, sizeof(*tree));
+}
+
+void UBKInspectionTreeDestroy(UBKInspectionTree *tree)
+{
+    free(tree->nodes);
+    free(tree->colours);
+    free(tree->strings);
+    UBKInspectionTreeInit(tree);
+}
+
+void UBKInspectionTreeReset(UBKInspectionTree *tree)
+{
+    tree->count = 0;
+    tree->colourCount = 0;
+    tree->stringsLength = 0;
+}
+
+static bool UBKInspectionGrow(void **items, uint32_t *capacity, uint32_t needed, size_t itemSize)
+{
+    if (needed <= *capacity)
+    {
+        return true;
+    }
+    uint64_t newCapacity = (*capacity == 0) ? 64 : *capacity;
+    while (newCapacity < needed)
+    {
+        newCapacity *= 2;
+    }
+    if (newCapacity > UINT32_MAX)
+    {
+        return false;
+    }
+    void *grown = realloc(*items, (size_t)newCapacity * itemSize);
+    if (grown == NULL)
+    {
+        return false;
+    }
+    *items = grown;
+    *capacity = (uint32_t)newCapacity;
+    return true;
+}
+
+//Returns the offset of the copy, 0 for empty strings, or UINT32_MAX if the pool couldn't grow
+static uint32_t UBKInspectionTreeAddString(UBKInspectionTree *tree, const char *string, size_t length)
+{
+    if (tree->stringsLength == 0)
+    {
+        //Offset 0 is kept for the empty string
+        if (!UBKInspectionGrow((void **)&tree->strings, &tree->stringsCapacity, 1, 1))
+        {
+            return UINT32_MAX;
+        }
+        tree->strings[0] = 0;
+        tree->stringsLength = 1;
+    }
+    if ((string == NULL) || (length == 0))
+    {
+        return 0;
+    }
+    if (length > UBKInspectionMaximumStringLength)
+    {
+        length = UBKInspectionMaximumStringLength;
+    }
+    if ((uint64_t)tree->stringsLength + length + 1 > UINT32_MAX)
+    {
+        return UINT32_MAX;
+    }
+    if (!UBKInspectionGrow((void **)&tree->strings, &tree->stringsCapacity, tree->stringsLength + (uint32_t)length + 1, 1))
+    {
+        return UINT32_MAX;
+    }
+    uint32_t offset = tree->stringsLength;
+    memcpy(tree->strings + offset, string, length);
+    tree->strings[offset + length] = 0;
+    tree->stringsLength += (uint32_t)length + 1;
+    return offset;
+}
+
+const char *UBKInspectionTreeString(const UBKInspectionTree *tree, uint32_t offset)
+{
+    if ((tree->strings == NULL) || (offset >= tree->stringsLength))
+    {
+        return "";
+    }
+    return tree->strings + offset;
+}
+
+bool UBKInspectionTreeAddNode(UBKInspectionTree *tree, const UBKInspectionNode *node, const char *className, const char *label)
+{
+    if (!UBKInspectionGrow((void **)&tree->nodes, &tree->capacity, tree->count + 1, sizeof(UBKInspectionNode)))
+    {
+        return false;
+    }
+    UBKInspectionNode copy = *node;
+    copy.className = UBKInspectionTreeAddString(tree, className, className ? strlen(className) : 0);
+    copy.label = UBKInspectionTreeAddString(tree, label, label ? strlen(label) : 0);
+    if ((copy.className == UINT32_MAX) || (copy.label == UINT32_MAX))
+    {
+        return false;
+    }
+    copy.firstColour = tree->colourCount;
+    copy.colourCount = 0;
+    tree->nodes[tree->count++] = copy;
+    return true;
+}
+
+bool UBKInspectionTreeAddColour(UBKInspectionTree *tree, const char *title, uint32_t rgba)
+{
+    //The colour count goes out as a byte
+    if ((tree->count == 0) || (tree->nodes[tree->count - 1].colourCount == UINT8_MAX))
+    {
+        return false;
+    }
+    if (!UBKInspectionGrow((void **)&tree->colours, &tree->colourCapacity, tree->colourCount + 1, sizeof(UBKInspectionColour)))
+    {
+        return false;
+    }
+    uint32_t titleOffset = UBKInspectionTreeAddString(tree, title, title ? strlen(title) : 0);
+    if (titleOffset == UINT32_MAX)
+    {
+        return false;
+    }
+    tree->colours[tree->colourCount++] = (UBKInspectionColour){titleOffset, rgba};
+    tree->nodes[tree->count - 1].colourCount++;
+    return true;
+}
+
+bool UBKInspectionTreeCopy(UBKInspectionTree *tree, const UBKInspectionTree *source)
+{
+    if ((!UBKInspectionGrow((void **)&tree->nodes, &tree->capacity, source->count, sizeof(UBKInspectionNode))) ||
+        (!UBKInspectionGrow((void **)&tree->colours, &tree->colourCapacity, source->colourCount, sizeof(UBKInspectionColour))) ||
+        (!UBKInspectionGrow((void **)&tree->strings, &tree->stringsCapacity, source->stringsLength, 1)))
+    {
+        return false;
+    }
+    if (source->count > 0)
+    {
+        memcpy(tree->nodes, source->nodes, source->count * sizeof(UBKInspectionNode));
+    }
+    if (source->colourCount > 0)
+    {
+        memcpy(tree->colours, source->colours, source->colourCount * sizeof(UBKInspectionColour));
+    }
+    if (source->stringsLength > 0)
+    {
+        memcpy(tree->strings, source->strings, source->stringsLength);
+    }
+    tree->count = source->count;
+    tree->colourCount = source->colourCount;
+    tree->stringsLength = source->stringsLength;
+    tree->sequence = source->sequence;
+    return true;
+}
+
+int64_t UBKInspectionTreeFind(const UBKInspectionTree *tree, uint64_t key)
+{
+    for (uint32_t i = 0; i < tree->count; i++)
+    {
+        if (tree->nodes[i].key == key)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool UBKInspectionMakeKeysUnique(uint64_t *keys, size_t count)
+{
+    UBKHashSet seen;
+    if (!UBKHashSetInit(&seen, count * 2))
+    {
+        return false;
+    }
+    bool success = true;
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t key = (keys[i] != 0) ? keys[i] : 1;
+        uint64_t repeat = 0;
+        while (UBKHashSetContains(&seen, key) || (key == 0))
+        {
+            key = UBKHashCombine(keys[i], ++repeat);
+        }
+        if (!UBKHashSetInsert(&seen, key))
+        {
+            success = false;
+            break;
+        }
+        keys[i] = key;
+    }
+    UBKHashSetDestroy(&seen);
+    return success;
+}
+
+//Key to node index, open addressing with the index stored plus one so 0 is empty
+typedef struct {
+    uint64_t *keys;
+    uint32_t *indexes;
+    size_t mask;
+} UBKInspectionKeyIndex;
+
+static void UBKInspectionKeyIndexDestroy(UBKInspectionKeyIndex *index)
+{
+    free(index->keys);
+    free(index->indexes);
+    index->keys = NULL;
+    index->indexes = NULL;
+}
+
+static bool UBKInspectionKeyIndexInit(UBKInspectionKeyIndex *index, const UBKInspectionTree *tree)
+{
+    size_t capacity = 16;
+    while (capacity < (size_t)tree->count * 2)
+    {
+        capacity *= 2;
+    }
+    index->keys = calloc(capacity, sizeof(uint64_t));
+    index->indexes = calloc(capacity, sizeof(uint32_t));
+    index->mask = capacity - 1;
+    if ((index->keys == NULL) || (index->indexes == NULL))
+    {
+        UBKInspectionKeyIndexDestroy(index);
+        return false;
+    }
+    for (uint32_t i = 0; i < tree->count; i++)
+    {
+        size_t slot = (tree->nodes[i].key * 0x9E3779B97F4A7C15ULL) >> 32 & index->mask;
+        while (index->indexes[slot] != 0)
+        {
+            slot = (slot + 1) & index->mask;
+        }
+        index->keys[slot] = tree->nodes[i].key;
+        index->indexes[slot] = i + 1;
+    }
+    return true;
+}
+
+static int64_t UBKInspectionKeyIndexFind(const UBKInspectionKeyIndex *index, uint64_t key)
+{
+    size_t slot = (key * 0x9E3779B97F4A7C15ULL) >> 32 & index->mask;
+    while (index->indexes[slot] != 0)
+    {
+        if (index->keys[slot] == key)
+        {
+            return (int64_t)index->indexes[slot] - 1;
+        }
+        slot = (slot + 1) & index->mask;
+    }
+    return -1;
+}
+
+void UBKInspectionBufferInit(UBKInspectionBuffer *buffer)
+{
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+void UBKInspectionBufferDestroy(UBKInspectionBuffer *buffer)
+{
+    free(buffer->bytes);
+    UBKInspectionBufferInit(buffer);
+}
+
+//Writers remember a failed allocation so a frame can be written without checking every value
+typedef struct {
+    UBKInspectionBuffer *buffer;
+    size_t frameStart;
+    bool failed;
+} UBKInspectionWriter;
+
+static void UBKInspectionWrite(UBKInspectionWriter *writer, const void *bytes, size_t length)
+{
+    UBKInspectionBuffer *buffer = writer->buffer;
+    if ((writer->failed) || (length == 0))
+    {
+        return;
+    }
+    if (buffer->length + length > buffer->capacity)
+    {
+        size_t capacity = (buffer->capacity == 0) ? 4096 : buffer->capacity;
+        while (capacity < buffer->length + length)
+        {
+            capacity *= 2;
+        }
+        uint8_t *bytesGrown = realloc(buffer->bytes, capacity);
+        if (bytesGrown == NULL)
+        {
+            writer->failed = true;
+            return;
+        }
+        buffer->bytes = bytesGrown;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->bytes + buffer->length, bytes, length);
+    buffer->length += length;
+}
+
+static void UBKInspectionWriteUInt8(UBKInspectionWriter *writer, uint8_t value)
+{
+    UBKInspectionWrite(writer, &value, 1);
+}
+
+static void UBKInspectionWriteUInt32(UBKInspectionWriter *writer, uint32_t value)
+{
+    uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    UBKInspectionWrite(writer, bytes, sizeof(bytes));
+}
+
+static void UBKInspectionWriteUInt64(UBKInspectionWriter *writer, uint64_t value)
+{
+    UBKInspectionWriteUInt32(writer, (uint32_t)value);
+    UBKInspectionWriteUInt32(writer, (uint32_t)(value >> 32));
+}
+
+static void UBKInspectionWriteFloat(UBKInspectionWriter *writer, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    UBKInspectionWriteUInt32(writer, bits);
+}
+
+static void UBKInspectionWriteString(UBKInspectionWriter *writer, const char *string)
+{
+    size_t length = strlen(string);
+    uint8_t header[2] = {(uint8_t)length, (uint8_t)(length >> 8)};
+    UBKInspectionWrite(writer, header, sizeof(header));
+    UBKInspectionWrite(writer, string, length);
+}
+
+static UBKInspectionWriter UBKInspectionBeginFrame(UBKInspectionBuffer *buffer, UBKInspectionMessageType type)
+{
+    UBKInspectionWriter writer = {buffer, buffer->length, false};
+    //The length is filled in by UBKInspectionEndFrame
+    UBKInspectionWriteUInt32(&writer, 0);
+    UBKInspectionWriteUInt8(&writer, (uint8_t)type);
+    return writer;
+}
+
+static bool UBKInspectionEndFrame(UBKInspectionWriter *writer)
+{
+    UBKInspectionBuffer *buffer = writer->buffer;
+    size_t frameLength = buffer->length - writer->frameStart - 4;
+    if ((writer->failed) || (frameLength > UBKInspectionMaximumFrameLength))
+    {
+        buffer->length = writer->frameStart;
+        return false;
+    }
+    uint8_t *lengthBytes = buffer->bytes + writer->frameStart;
+    lengthBytes[0] = (uint8_t)frameLength;
+    lengthBytes[1] = (uint8_t)(frameLength >> 8);
+    lengthBytes[2] = (uint8_t)(frameLength >> 16);
+    lengthBytes[3] = (uint8_t)(frameLength >> 24);
+    return true;
+}
+
+static void UBKInspectionWriteFields(UBKInspectionWriter *writer, const UBKInspectionTree *tree, const UBKInspectionNode *node, uint8_t fields)
+{
+    UBKInspectionWriteUInt64(writer, node->key);
+    UBKInspectionWriteUInt8(writer, fields);
+    if (fields & UBKInspectionFieldParent)
+    {
+        UBKInspectionWriteUInt64(writer, node->parentKey);
+        UBKInspectionWriteUInt32(writer, node->siblingIndex);
+    }
+    if (fields & UBKInspectionFieldFlags)
+    {
+        UBKInspectionWriteUInt32(writer, node->flags);
+    }
+    if (fields & UBKInspectionFieldWarnings)
+    {
+        UBKInspectionWriteUInt64(writer, node->warningMask);
+        UBKInspectionWriteUInt8(writer, (uint8_t)node->warningLevel);
+    }
+    if (fields & UBKInspectionFieldFrame)
+    {
+        UBKInspectionWriteFloat(writer, node->x);
+        UBKInspectionWriteFloat(writer, node->y);
+        UBKInspectionWriteFloat(writer, node->width);
+        UBKInspectionWriteFloat(writer, node->height);
+    }
+    if (fields & UBKInspectionFieldClassName)
+    {
+        UBKInspectionWriteString(writer, UBKInspectionTreeString(tree, node->className));
+    }
+    if (fields & UBKInspectionFieldLabel)
+    {
+        UBKInspectionWriteString(writer, UBKInspectionTreeString(tree, node->label));
+    }
+    if (fields & UBKInspectionFieldColours)
+    {
+        UBKInspectionWriteUInt8(writer, (uint8_t)node->colourCount);
+        for (uint32_t i = 0; i < node->colourCount; i++)
+        {
+            const UBKInspectionColour *colour = &tree->colours[node->firstColour + i];
+            UBKInspectionWriteString(writer, UBKInspectionTreeString(tree, colour->title));
+            UBKInspectionWriteUInt32(writer, colour->rgba);
+        }
+    }
+}
+
+static uint8_t UBKInspectionChangedFields(const UBKInspectionTree *previousTree, const UBKInspectionNode *previous, const UBKInspectionTree *tree, const UBKInspectionNode *node)
+{
+    uint8_t fields = 0;
+    if ((previous->parentKey != node->parentKey) || (previous->siblingIndex != node->siblingIndex))
+    {
+        fields |= UBKInspectionFieldParent;
+    }
+    if (previous->flags != node->flags)
+    {
+        fields |= UBKInspectionFieldFlags;
+    }
+    if ((previous->warningMask != node->warningMask) || (previous->warningLevel != node->warningLevel))
+    {
+        fields |= UBKInspectionFieldWarnings;
+    }
+    if ((previous->x != node->x) || (previous->y != node->y) || (previous->width != node->width) || (previous->height != node->height))
+    {
+        fields |= UBKInspectionFieldFrame;
+    }
+    if (strcmp(UBKInspectionTreeString(previousTree, previous->className), UBKInspectionTreeString(tree, node->className)) != 0)
+    {
+        fields |= UBKInspectionFieldClassName;
+    }
+    if (strcmp(UBKInspectionTreeString(previousTree, previous->label), UBKInspectionTreeString(tree, node->label)) != 0)
+    {
+        fields |= UBKInspectionFieldLabel;
+    }
+    if (previous->colourCount != node->colourCount)
+    {
+        fields |= UBKInspectionFieldColours;
+    }
+    else
+    {
+        for (uint32_t i = 0; i < node->colourCount; i++)
+        {
+            const UBKInspectionColour *previousColour = &previousTree->colours[previous->firstColour + i];
+            const UBKInspectionColour *colour = &tree->colours[node->firstColour + i];
+            if ((previousColour->rgba != colour->rgba) || (strcmp(UBKInspectionTreeString(previousTree, previousColour->title), UBKInspectionTreeString(tree, colour->title)) != 0))
+            {
+                fields |= UBKInspectionFieldColours;
+                break;
+            }
+        }
+    }
+    return fields;
+}
+
+bool UBKInspectionEncodeHello(UBKInspectionBuffer *buffer)
+{
+    UBKInspectionWriter writer = UBKInspectionBeginFrame(buffer, UBKInspectionMessageHello);
+    UBKInspectionWriteUInt32(&writer, UBKInspectionProtocolVersion);
+    return UBKInspectionEndFrame(&writer);
+}
+
+bool UBKInspectionEncodeSnapshot(UBKInspectionBuffer *buffer, const UBKInspectionTree *tree)
+{
+    UBKInspectionWriter writer = UBKInspectionBeginFrame(buffer, UBKInspectionMessageSnapshot);
+    UBKInspectionWriteUInt64(&writer, tree->sequence);
+    UBKInspectionWriteUInt32(&writer, tree->count);
+    for (uint32_t i = 0; i < tree->count; i++)
+    {
+        UBKInspectionWriteFields(&writer, tree, &tree->nodes[i], UBKInspectionFieldAll);
+    }
+    return UBKInspectionEndFrame(&writer);
+}
+
+bool UBKInspectionEncodeDelta(UBKInspectionBuffer *buffer, const UBKInspectionTree *previous, const UBKInspectionTree *tree, bool *hasChanges)
+{
+    *hasChanges = false;
+    UBKInspectionKeyIndex previousIndex;
+    UBKInspectionKeyIndex index;
+    if (!UBKInspectionKeyIndexInit(&previousIndex, previous))
+    {
+        return false;
+    }
+    if (!UBKInspectionKeyIndexInit(&index, tree))
+    {
+        UBKInspectionKeyIndexDestroy(&previousIndex);
+        return false;
+    }
+    
+    UBKInspectionWriter writer = UBKInspectionBeginFrame(buffer, UBKInspectionMessageDelta);
+    UBKInspectionWriteUInt64(&writer, previous->sequence);
+    UBKInspectionWriteUInt64(&writer, tree->sequence);
+    
+    //Counts are written once known
+    size_t removedCountOffset = buffer->length;
+    UBKInspectionWriteUInt32(&writer, 0);
+    uint32_t removedCount = 0;
+    for (uint32_t i = 0; i < previous->count; i++)
+    {
+        if (UBKInspectionKeyIndexFind(&index, previous->nodes[i].key) < 0)
+        {
+            UBKInspectionWriteUInt64(&writer, previous->nodes[i].key);
+            removedCount++;
+        }
+    }
+    
+    size_t changedCountOffset = buffer->length;
+    UBKInspectionWriteUInt32(&writer, 0);
+    uint32_t changedCount = 0;
+    for (uint32_t i = 0; i < tree->count; i++)
+    {
+        const UBKInspectionNode *node = &tree->nodes[i];
+        int64_t previousNode = UBKInspectionKeyIndexFind(&previousIndex, node->key);
+        uint8_t fields = (previousNode < 0) ? UBKInspectionFieldAll : UBKInspectionChangedFields(previous, &previous->nodes[previousNode], tree, node);
+        if (fields != 0)
+        {
+            UBKInspectionWriteFields(&writer, tree, node, fields);
+            changedCount++;
+        }
+    }
+    UBKInspectionKeyIndexDestroy(&previousIndex);
+    UBKInspectionKeyIndexDestroy(&index);
+    
+    if ((!writer.failed) && (removedCount == 0) && (changedCount == 0))
+    {
+        buffer->length = writer.frameStart;
+        return true;
+    }
+    if (!writer.failed)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            buffer->bytes[removedCountOffset + i] = (uint8_t)(removedCount >> (i * 8));
+            buffer->bytes[changedCountOffset + i] = (uint8_t)(changedCount >> (i * 8));
+        }
+    }
+    *hasChanges = UBKInspectionEndFrame(&writer);
+    return *hasChanges;
+}
+
+static bool UBKInspectionEncodeKey(UBKInspectionBuffer *buffer, UBKInspectionMessageType type, uint64_t key)
+{
+    UBKInspectionWriter writer = UBKInspectionBeginFrame(buffer, type);
+    UBKInspectionWriteUInt64(&writer, key);
+    return UBKInspectionEndFrame(&writer);
+}
+
+bool UBKInspectionEncodeSelection(UBKInspectionBuffer *buffer, uint64_t key)
+{
+    return UBKInspectionEncodeKey(buffer, UBKInspectionMessageSelection, key);
+}
+
+bool UBKInspectionEncodeSelect(UBKInspectionBuffer *buffer, uint64_t key)
+{
+    return UBKInspectionEncodeKey(buffer, UBKInspectionMessageSelect, key);
+}
+
+bool UBKInspectionEncodeSetColour(UBKInspectionBuffer *buffer, uint64_t key, uint32_t colourIndex, uint32_t rgba)
+{
+    UBKInspectionWriter writer = UBKInspectionBeginFrame(buffer, UBKInspectionMessageSetColour);
+    UBKInspectionWriteUInt64(&writer, key);
+    UBKInspectionWriteUInt8(&writer, (uint8_t)colourIndex);
+    UBKInspectionWriteUInt32(&writer, rgba);
+    return UBKInspectionEndFrame(&writer);
+}
+
+bool UBKInspectionEncodeRequestSnapshot(UBKInspectionBuffer *buffer)
+{
+    UBKInspectionWriter writer = UBKInspectionBeginFrame(buffer, UBKInspectionMessageRequestSnapshot);
+    return UBKInspectionEndFrame(&writer);
+}
+
+typedef struct {
+    const uint8_t *bytes;
+    size_t length;
+    size_t offset;
+    bool failed;
+} UBKInspectionReader;
+
+static const uint8_t *UBKInspectionRead(UBKInspectionReader *reader, size_t length)
+{
+    if ((reader->failed) || (reader->length - reader->offset < length))
+    {
+        reader->failed = true;
+        return NULL;
+    }
+    const uint8_t *bytes = reader->bytes + reader->offset;
+    reader->offset += length;
+    return bytes;
+}
+
+static uint8_t UBKInspectionReadUInt8(UBKInspectionReader *reader)
+{
+    const uint8_t *bytes = UBKInspectionRead(reader, 1);
+    return bytes ? bytes[0] : 0;
+}
+
+static uint32_t UBKInspectionReadUInt32(UBKInspectionReader *reader)
+{
+    const uint8_t *bytes = UBKInspectionRead(reader, 4);
+    return bytes ? ((uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24)) : 0;
+}
+
+static uint64_t UBKInspectionReadUInt64(UBKInspectionReader *reader)
+{
+    uint64_t low = UBKInspectionReadUInt32(reader);
+    return low | ((uint64_t)UBKInspectionReadUInt32(reader) << 32);
+}
+
+static float UBKInspectionReadFloat(UBKInspectionReader *reader)
+{
+    uint32_t bits = UBKInspectionReadUInt32(reader);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+//Strings aren't nul terminated in the stream, they are copied straight into the tree
+static uint32_t UBKInspectionReadString(UBKInspectionReader *reader, UBKInspectionTree *tree)
+{
+    const uint8_t *header = UBKInspectionRead(reader, 2);
+    size_t length = header ? ((size_t)header[0] | ((size_t)header[1] << 8)) : 0;
+    const uint8_t *bytes = UBKInspectionRead(reader, length);
+    if (reader->failed)
+    {
+        return 0;
+    }
+    uint32_t offset = UBKInspectionTreeAddString(tree, (const char *)bytes, length);
+    if (offset == UINT32_MAX)
+    {
+        reader->failed = true;
+        return 0;
+    }
+    return offset;
+}
+
+int64_t UBKInspectionNextFrame(const uint8_t *bytes, size_t length, UBKInspectionFrame *frame)
+{
+    if (length < UBKInspectionFrameHeaderLength)
+    {
+        return 0;
+    }
+    uint32_t frameLength = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    if ((frameLength == 0) || (frameLength > UBKInspectionMaximumFrameLength))
+    {
+        return -1;
+    }
+    if (length - 4 < frameLength)
+    {
+        return 0;
+    }
+    frame->type = bytes[4];
+    frame->payload = bytes + UBKInspectionFrameHeaderLength;
+    frame->payloadLength = frameLength - 1;
+    return (int64_t)frameLength + 4;
+}
+
+//Reads the fields of one node into tree, starting from base when the node was already known
+static bool UBKInspectionReadNode(UBKInspectionReader *reader, UBKInspectionTree *tree, const UBKInspectionTree *baseTree, const UBKInspectionNode *base)
+{
+    UBKInspectionNode node = {0};
+    node.key = UBKInspectionReadUInt64(reader);
+    uint8_t fields = UBKInspectionReadUInt8(reader);
+    if ((reader->failed) || (node.key == 0) || ((base == NULL) && (fields != UBKInspectionFieldAll)))
+    {
+        return false;
+    }
+    if (base)
+    {
+        node = *base;
+        node.className = UBKInspectionTreeAddString(tree, UBKInspectionTreeString(baseTree, base->className), strlen(UBKInspectionTreeString(baseTree, base->className)));
+        node.label = UBKInspectionTreeAddString(tree, UBKInspectionTreeString(baseTree, base->label), strlen(UBKInspectionTreeString(baseTree, base->label)));
+    }
+    if (fields & UBKInspectionFieldParent)
+    {
+        node.parentKey = UBKInspectionReadUInt64(reader);
+        node.siblingIndex = UBKInspectionReadUInt32(reader);
+    }
+    if (fields & UBKInspectionFieldFlags)
+    {
+        node.flags = UBKInspectionReadUInt32(reader);
+    }
+    if (fields & UBKInspectionFieldWarnings)
+    {
+        node.warningMask = UBKInspectionReadUInt64(reader);
+        node.warningLevel = UBKInspectionReadUInt8(reader);
+    }
+    if (fields & UBKInspectionFieldFrame)
+    {
+        node.x = UBKInspectionReadFloat(reader);
+        node.y = UBKInspectionReadFloat(reader);
+        node.width = UBKInspectionReadFloat(reader);
+        node.height = UBKInspectionReadFloat(reader);
+    }
+    if (fields & UBKInspectionFieldClassName)
+    {
+        node.className = UBKInspectionReadString(reader, tree);
+    }
+    if (fields & UBKInspectionFieldLabel)
+    {
+        node.label = UBKInspectionReadString(reader, tree);
+    }
+    if ((reader->failed) || (node.className == UINT32_MAX) || (node.label == UINT32_MAX))
+    {
+        return false;
+    }
+    
+    //Colours always follow their node, so the node is added first
+    if (!UBKInspectionGrow((void **)&tree->nodes, &tree->capacity, tree->count + 1, sizeof(UBKInspectionNode)))
+    {
+        return false;
+    }
+    node.firstColour = tree->colourCount;
+    node.colourCount = 0;
+    tree->nodes[tree->count++] = node;
+    if (fields & UBKInspectionFieldColours)
+    {
+        uint8_t colourCount = UBKInspectionReadUInt8(reader);
+        for (uint8_t i = 0; i < colourCount; i++)
+        {
+            //Read into the tree's pool directly, then attach
+            uint32_t title = UBKInspectionReadString(reader, tree);
+            uint32_t rgba = UBKInspectionReadUInt32(reader);
+            if ((reader->failed) || (!UBKInspectionGrow((void **)&tree->colours, &tree->colourCapacity, tree->colourCount + 1, sizeof(UBKInspectionColour))))
+            {
+                return false;
+            }
+            tree->colours[tree->colourCount++] = (UBKInspectionColour){title, rgba};
+            tree->nodes[tree->count - 1].colourCount++;
+        }
+    }
+    else if (base)
+    {
+        for (uint32_t i = 0; i < base->colourCount; i++)
+        {
+            const UBKInspectionColour *colour = &baseTree->colours[base->firstColour + i];
+            if (!UBKInspectionTreeAddColour(tree, UBKInspectionTreeString(baseTree, colour->title), colour->rgba))
+            {
+                return false;
+            }
+        }
+    }
+    return !reader->failed;
+}
+
+//Copies a node unchanged from another tree
+static bool UBKInspectionTreeCopyNode(UBKInspectionTree *tree, const UBKInspectionTree *source, const UBKInspectionNode *node)
+{
+    if (!UBKInspectionTreeAddNode(tree, node, UBKInspectionTreeString(source, node->className), UBKInspectionTreeString(source, node->label)))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < node->colourCount; i++)
+    {
+        const UBKInspectionColour *colour = &source->colours[node->firstColour + i];
+        if (!UBKInspectionTreeAddColour(tree, UBKInspectionTreeString(source, colour->title), colour->rgba))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool UBKInspectionApplySnapshot(UBKInspectionTree *tree, UBKInspectionReader *reader)
+{
+    UBKInspectionTree result;
+    UBKInspectionTreeInit(&result);
+    result.sequence = UBKInspectionReadUInt64(reader);
+    uint32_t count = UBKInspectionReadUInt32(reader);
+    bool success = !reader->failed;
+    for (uint32_t i = 0; (success) && (i < count); i++)
+    {
+        success = UBKInspectionReadNode(reader, &result, NULL, NULL);
+    }
+    if ((success) && (!reader->failed) && (reader->offset == reader->length))
+    {
+        UBKInspectionTreeDestroy(tree);
+        *tree = result;
+        return true;
+    }
+    UBKInspectionTreeDestroy(&result);
+    return false;
+}
+
+//The nodes that are kept stay in their order, added nodes go on the end
+static bool UBKInspectionApplyDelta(UBKInspectionTree *tree, UBKInspectionReader *reader)
+{
+    uint64_t baseSequence = UBKInspectionReadUInt64(reader);
+    uint64_t sequence = UBKInspectionReadUInt64(reader);
+    if ((reader->failed) || (baseSequence != tree->sequence))
+    {
+        return false;
+    }
+    
+    //Removed and changed nodes are marked, the rest are copied across afterwards
+    uint8_t *replaced = calloc(tree->count + 1, 1);
+    UBKInspectionKeyIndex index;
+    if ((replaced == NULL) || (!UBKInspectionKeyIndexInit(&index, tree)))
+    {
+        free(replaced);
+        return false;
+    }
+    UBKInspectionTree changes;
+    UBKInspectionTreeInit(&changes);
+    bool success = true;
+    
+    uint32_t removedCount = UBKInspectionReadUInt32(reader);
+    for (uint32_t i = 0; (success) && (i < removedCount); i++)
+    {
+        int64_t node = UBKInspectionKeyIndexFind(&index, UBKInspectionReadUInt64(reader));
+        success = (!reader->failed) && (node >= 0);
+        if (success)
+        {
+            replaced[node] = 1;
+        }
+    }
+    uint32_t changedCount = success ? UBKInspectionReadUInt32(reader) : 0;
+    for (uint32_t i = 0; (success) && (i < changedCount); i++)
+    {
+        //Peek at the key to find the base node
+        size_t start = reader->offset;
+        uint64_t key = UBKInspectionReadUInt64(reader);
+        reader->offset = start;
+        int64_t node = UBKInspectionKeyIndexFind(&index, key);
+        success = (!reader->failed) && UBKInspectionReadNode(reader, &changes, tree, (node >= 0) ? &tree->nodes[node] : NULL);
+        if ((success) && (node >= 0))
+        {
+            replaced[node] = 2;
+        }
+    }
+    success = (success) && (!reader->failed) && (reader->offset == reader->length);
+    
+    UBKInspectionTree result;
+    UBKInspectionTreeInit(&result);
+    if (success)
+    {
+        //Changed nodes keep their place
+        UBKInspectionKeyIndex changesIndex = {0};
+        success = UBKInspectionKeyIndexInit(&changesIndex, &changes);
+        uint8_t *added = success ? calloc(changes.count + 1, 1) : NULL;
+        success = (success) && (added != NULL);
+        for (uint32_t i = 0; (success) && (i < tree->count); i++)
+        {
+            if (replaced[i] == 0)
+            {
+                success = UBKInspectionTreeCopyNode(&result, tree, &tree->nodes[i]);
+            }
+            else if (replaced[i] == 2)
+            {
+                int64_t change = UBKInspectionKeyIndexFind(&changesIndex, tree->nodes[i].key);
+                added[change] = 1;
+                success = UBKInspectionTreeCopyNode(&result, &changes, &changes.nodes[change]);
+            }
+        }
+        for (uint32_t i = 0; (success) && (i < changes.count); i++)
+        {
+            if (!added[i])
+            {
+                success = UBKInspectionTreeCopyNode(&result, &changes, &changes.nodes[i]);
+            }
+        }
+        free(added);
+        UBKInspectionKeyIndexDestroy(&changesIndex);
+    }
+    
+    free(replaced);
+    UBKInspectionKeyIndexDestroy(&index);
+    UBKInspectionTreeDestroy(&changes);
+    if (!success)
+    {
+        UBKInspectionTreeDestroy(&result);
+        return false;
+    }
+    result.sequence = sequence;
+    UBKInspectionTreeDestroy(tree);
+    *tree = result;
+    return true;
+}
+
+bool UBKInspectionTreeApplyFrame(UBKInspectionTree *tree, const UBKInspectionFrame *frame)
+{
+    UBKInspectionReader reader = {frame->payload, frame->payloadLength, 0, false};
+    switch (frame->type)
+    {
+        case UBKInspectionMessageSnapshot:
+            return UBKInspectionApplySnapshot(tree, &reader);
+        case UBKInspectionMessageDelta:
+            return UBKInspectionApplyDelta(tree, &reader);
+        default:
+            return false;
+    }
+}
+
+bool UBKInspectionDecodeCommand(const UBKInspectionFrame *frame, UBKInspectionCommand *command)
+{
+    UBKInspectionReader reader = {frame->payload, frame->payloadLength, 0, false};
+    memset(command, 0, sizeof(*command));
+    command->type = (UBKInspectionMessageType)frame->type;
+    switch (frame->type)
+    {
+        case UBKInspectionMessageSelection:
+        case UBKInspectionMessageSelect:
+        {
+            command->key = UBKInspectionReadUInt64(&reader);
+            break;
+        }
+        case UBKInspectionMessageSetColour:
+        {
+            command->key = UBKInspectionReadUInt64(&reader);
+            command->colourIndex = UBKInspectionReadUInt8(&reader);
+            command->rgba = UBKInspectionReadUInt32(&reader);
+            break;
+        }
+        case UBKInspectionMessageRequestSnapshot:
+        {
+            break;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+    return (!reader.failed) && (reader.offset == reader.length);
+}
+
+static bool UBKInspectionSetNonBlocking(int fileDescriptor)
+{
+    int flags = fcntl(fileDescriptor, F_GETFL);
+    return (flags >= 0) && (fcntl(fileDescriptor, F_SETFL, flags | O_NONBLOCK) == 0);
+}
+
+bool UBKInspectionServerOpen(UBKInspectionServer *server, uint16_t port)
+{
+    memset(server, 0, sizeof(*server));
+    server->listenFileDescriptor = -1;
+    server->maximumPendingOutput = 1 << 20;
+    UBKInspectionTreeInit(&server->published);
+    
+    int fileDescriptor = socket(AF_INET, SOCK_STREAM, 0);
+    if (fileDescriptor < 0)
+    {
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(fileDescriptor, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    
+    //Loopback only, the hierarchy never leaves the device
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    socklen_t addressLength = sizeof(address);
+    if ((bind(fileDescriptor, (struct sockaddr *)&address, sizeof(address)) != 0) ||
+        (listen(fileDescriptor, UBKInspectionServerMaximumConnections) != 0) ||
+        (!UBKInspectionSetNonBlocking(fileDescriptor)) ||
+        (getsockname(fileDescriptor, (struct sockaddr *)&address, &addressLength) != 0))
+    {
+        close(fileDescriptor);
+        return false;
+    }
+    server->listenFileDescriptor = fileDescriptor;
+    server->port = ntohs(address.sin_port);
+    return true;
+}
+
+static void UBKInspectionServerDropConnection(UBKInspectionServer *server, uint32_t index)
+{
+    UBKInspectionConnection *connection = &server->connections[index];
+    close(connection->fileDescriptor);
+    UBKInspectionBufferDestroy(&connection->input);
+    UBKInspectionBufferDestroy(&connection->output);
+    server->connections[index] = server->connections[--server->connectionCount];
+}
+
+void UBKInspectionServerClose(UBKInspectionServer *server)
+{
+    while (server->connectionCount > 0)
+    {
+        UBKInspectionServerDropConnection(server, server->connectionCount - 1);
+    }
+    if (server->listenFileDescriptor >= 0)
+    {
+        close(server->listenFileDescriptor);
+        server->listenFileDescriptor = -1;
+    }
+    UBKInspectionTreeDestroy(&server->published);
+}
+
+static void UBKInspectionServerAccept(UBKInspectionServer *server)
+{
+    while (true)
+    {
+        int fileDescriptor = accept(server->listenFileDescriptor, NULL, NULL);
+        if (fileDescriptor < 0)
+        {
+            return;
+        }
+        if ((server->connectionCount == UBKInspectionServerMaximumConnections) || (!UBKInspectionSetNonBlocking(fileDescriptor)))
+        {
+            close(fileDescriptor);
+            continue;
+        }
+#ifdef SO_NOSIGPIPE
+        int noSignal = 1;
+        setsockopt(fileDescriptor, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+#endif
+        //Deltas are small, send them straight away
+        int noDelay = 1;
+        setsockopt(fileDescriptor, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        
+        UBKInspectionConnection *connection = &server->connections[server->connectionCount++];
+        memset(connection, 0, sizeof(*connection));
+        connection->fileDescriptor = fileDescriptor;
+        connection->needsSnapshot = true;
+        UBKInspectionEncodeHello(&connection->output);
+    }
+}
+
+//Returns false if the connection closed or failed
+static bool UBKInspectionConnectionFlush(UBKInspectionServer *server, UBKInspectionConnection *connection)
+{
+    while (connection->outputOffset < connection->output.length)
+    {
+#ifdef MSG_NOSIGNAL
+        ssize_t written = send(connection->fileDescriptor, connection->output.bytes + connection->outputOffset, connection->output.length - connection->outputOffset, MSG_NOSIGNAL);
+#else
+        ssize_t written = send(connection->fileDescriptor, connection->output.bytes + connection->outputOffset, connection->output.length - connection->outputOffset, 0);
+#endif
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return (errno == EAGAIN) || (errno == EWOULDBLOCK);
+        }
+        connection->outputOffset += (size_t)written;
+        server->bytesSent += (uint64_t)written;
+    }
+    connection->output.length = 0;
+    connection->outputOffset = 0;
+    return true;
+}
+
+//Returns false if the connection closed, failed or sent a broken stream
+static bool UBKInspectionConnectionRead(UBKInspectionConnection *connection, UBKInspectionCommandHandler handler, void *context)
+{
+    uint8_t bytes[4096];
+    while (true)
+    {
+        ssize_t length = recv(connection->fileDescriptor, bytes, sizeof(bytes), 0);
+        if (length == 0)
+        {
+            return false;
+        }
+        if (length < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+            {
+                return false;
+            }
+            break;
+        }
+        UBKInspectionWriter writer = {&connection->input, 0, false};
+        UBKInspectionWrite(&writer, bytes, (size_t)length);
+        if (writer.failed)
+        {
+            return false;
+        }
+    }
+    
+    size_t offset = 0;
+    UBKInspectionFrame frame;
+    int64_t frameLength;
+    while ((frameLength = UBKInspectionNextFrame(connection->input.bytes + offset, connection->input.length - offset, &frame)) > 0)
+    {
+        offset += (size_t)frameLength;
+        UBKInspectionCommand command;
+        if (!UBKInspectionDecodeCommand(&frame, &command))
+        {
+            //Unknown commands are skipped so newer clients still work
+            continue;
+        }
+        if (command.type == UBKInspectionMessageRequestSnapshot)
+        {
+            connection->needsSnapshot = true;
+        }
+        if (handler)
+        {
+            handler(&command, context);
+        }
+    }
+    if (frameLength < 0)
+    {
+        return false;
+    }
+    if (offset > 0)
+    {
+        memmove(connection->input.bytes, connection->input.bytes + offset, connection->input.length - offset);
+        connection->input.length -= offset;
+    }
+    return true;
+}
+
+void UBKInspectionServerPoll(UBKInspectionServer *server, UBKInspectionCommandHandler handler, void *context)
+{
+    if (server->listenFileDescriptor < 0)
+    {
+        return;
+    }
+    UBKInspectionServerAccept(server);
+    
+    uint32_t index = 0;
+    while (index < server->connectionCount)
+    {
+        UBKInspectionConnection *connection = &server->connections[index];
+        bool isOpen = UBKInspectionConnectionRead(connection, handler, context) && UBKInspectionConnectionFlush(server, connection);
+        //A snapshot replaces everything the connection missed, so it waits for the output to drain
+        if ((isOpen) && (connection->needsSnapshot) && (connection->output.length == 0))
+        {
+            connection->needsSnapshot = false;
+            isOpen = UBKInspectionEncodeSnapshot(&connection->output, &server->published) && UBKInspectionConnectionFlush(server, connection);
+        }
+        if (!isOpen)
+        {
+            //The last connection is moved into this slot
+            UBKInspectionServerDropConnection(server, index);
+            continue;
+        }
+        index++;
+    }
+}
+
+bool UBKInspectionServerPublish(UBKInspectionServer *server, UBKInspectionTree *tree)
+{
+    tree->sequence = server->published.sequence + 1;
+    
+    //The delta is made once and copied to each connection
+    UBKInspectionBuffer delta;
+    UBKInspectionBufferInit(&delta);
+    bool hasChanges = false;
+    bool success = true;
+    if (server->connectionCount > 0)
+    {
+        success = UBKInspectionEncodeDelta(&delta, &server->published, tree, &hasChanges);
+    }
+    for (uint32_t i = 0; i < server->connectionCount; i++)
+    {
+        UBKInspectionConnection *connection = &server->connections[i];
+        if ((connection->needsSnapshot) || (!hasChanges))
+        {
+            continue;
+        }
+        UBKInspectionWriter writer = {&connection->output, 0, false};
+        if (connection->output.length - connection->outputOffset + delta.length > server->maximumPendingOutput)
+        {
+            writer.failed = true;
+        }
+        UBKInspectionWrite(&writer, delta.bytes, delta.length);
+        if ((!success) || (writer.failed))
+        {
+            //Too far behind, or the delta couldn't be made. A snapshot catches it up.
+            connection->needsSnapshot = true;
+        }
+    }
+    UBKInspectionBufferDestroy(&delta);
+    
+    if ((!hasChanges) && (server->connectionCount > 0) && (success))
+    {
+        //Nothing was sent, the connections stay on the published sequence
+        tree->sequence = server->published.sequence;
+        return true;
+    }
+    if (!UBKInspectionTreeCopy(&server->published, tree))
+    {
+        //The connections can't be told what changed
+        for (uint32_t i = 0; i < server->connectionCount; i++)
+        {
+            server->connections[i].needsSnapshot = true;
+        }
+        return false;
+    }
+    return true;
+}
+
+void UBKInspectionServerSendSelection(UBKInspectionServer *server, uint64_t key)
+{
+    for (uint32_t i = 0; i < server->connectionCount; i++)
+    {
+        UBKInspectionEncodeSelection(&server->connections[i].output, key);
+    }
+}
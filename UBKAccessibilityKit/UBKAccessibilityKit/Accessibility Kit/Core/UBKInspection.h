@@ -0,0 +1,209 @@
+/*
+ File: UBKInspection.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKInspection_h
+#define UBKInspection_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Protocol and loopback server for inspecting the hierarchy from a desktop viewer.
+//Messages are frames of a 32 bit length, a type byte and a payload, all values little endian. A client gets a hello and a full snapshot when it connects, then a delta for each change: the keys of removed nodes, and for each added or changed node its key, a mask of the fields that changed and those fields. An unchanged screen sends nothing.
+//Nothing in here depends on UIKit so the same code can be used by a desktop client.
+
+#define UBKInspectionProtocolVersion 1
+//Frames over this are treated as a broken stream
+#define UBKInspectionMaximumFrameLength (16u << 20)
+
+typedef enum {
+    //Server to client
+    UBKInspectionMessageHello = 1,
+    UBKInspectionMessageSnapshot = 2,
+    UBKInspectionMessageDelta = 3,
+    UBKInspectionMessageSelection = 4,
+    //Client to server
+    UBKInspectionMessageSelect = 16,
+    UBKInspectionMessageSetColour = 17,
+    UBKInspectionMessageRequestSnapshot = 18
+} UBKInspectionMessageType;
+
+//Fields sent for an added or changed node
+typedef enum {
+    UBKInspectionFieldParent = 1 << 0,
+    UBKInspectionFieldFlags = 1 << 1,
+    UBKInspectionFieldWarnings = 1 << 2,
+    UBKInspectionFieldFrame = 1 << 3,
+    UBKInspectionFieldClassName = 1 << 4,
+    UBKInspectionFieldLabel = 1 << 5,
+    UBKInspectionFieldColours = 1 << 6,
+    UBKInspectionFieldAll = (1 << 7) - 1
+} UBKInspectionField;
+
+typedef struct {
+    //Unique within the tree and stable between trees of the same screen, never 0
+    uint64_t key;
+    //0 for top level nodes
+    uint64_t parentKey;
+    uint32_t siblingIndex;
+    //UBKSnapshotNodeFlags
+    uint32_t flags;
+    //1 << UBKAccessibilityWarningType for each warning, and the highest UBKAccessibilityWarningLevel
+    uint64_t warningMask;
+    uint32_t warningLevel;
+    //Window space
+    float x;
+    float y;
+    float width;
+    float height;
+    //Offsets into the string pool
+    uint32_t className;
+    uint32_t label;
+    uint32_t firstColour;
+    uint32_t colourCount;
+} UBKInspectionNode;
+
+//A colour that can be changed with UBKInspectionMessageSetColour, eg the text colour of a label
+typedef struct {
+    uint32_t title;
+    //0xRRGGBBAA
+    uint32_t rgba;
+} UBKInspectionColour;
+
+typedef struct {
+    UBKInspectionNode *nodes;
+    uint32_t count;
+    uint32_t capacity;
+    UBKInspectionColour *colours;
+    uint32_t colourCount;
+    uint32_t colourCapacity;
+    //Nul terminated strings, offset 0 is the empty string
+    char *strings;
+    uint32_t stringsLength;
+    uint32_t stringsCapacity;
+    //Changes with every snapshot or delta, deltas only apply to the sequence they were made from
+    uint64_t sequence;
+} UBKInspectionTree;
+
+void UBKInspectionTreeInit(UBKInspectionTree *tree);
+void UBKInspectionTreeDestroy(UBKInspectionTree *tree);
+//Removes all nodes but keeps the allocated storage and the sequence
+void UBKInspectionTreeReset(UBKInspectionTree *tree);
+bool UBKInspectionTreeCopy(UBKInspectionTree *tree, const UBKInspectionTree *source);
+
+//Appends a node, the string offsets and colours of node are ignored and the strings are copied. Colours are added to the last node with UBKInspectionTreeAddColour. Returns false if the tree couldn't grow.
+bool UBKInspectionTreeAddNode(UBKInspectionTree *tree, const UBKInspectionNode *node, const char *className, const char *label);
+bool UBKInspectionTreeAddColour(UBKInspectionTree *tree, const char *title, uint32_t rgba);
+const char *UBKInspectionTreeString(const UBKInspectionTree *tree, uint32_t offset);
+//Index of the node with key, -1 if there isn't one. Linear, for clients and tests.
+int64_t UBKInspectionTreeFind(const UBKInspectionTree *tree, uint64_t key);
+
+//Makes keys that repeat, eg UBKSnapshotElementKeys for table cells, unique by mixing in how many times they were seen before. Keys of 0 are replaced.
+bool UBKInspectionMakeKeysUnique(uint64_t *keys, size_t count);
+
+typedef struct {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+} UBKInspectionBuffer;
+
+void UBKInspectionBufferInit(UBKInspectionBuffer *buffer);
+void UBKInspectionBufferDestroy(UBKInspectionBuffer *buffer);
+
+//Encoders append a whole frame, or nothing if the buffer couldn't grow
+bool UBKInspectionEncodeHello(UBKInspectionBuffer *buffer);
+bool UBKInspectionEncodeSnapshot(UBKInspectionBuffer *buffer, const UBKInspectionTree *tree);
+//Appends nothing and sets hasChanges to false when the trees match. The delta moves a client from previous->sequence to tree->sequence.
+bool UBKInspectionEncodeDelta(UBKInspectionBuffer *buffer, const UBKInspectionTree *previous, const UBKInspectionTree *tree, bool *hasChanges);
+bool UBKInspectionEncodeSelection(UBKInspectionBuffer *buffer, uint64_t key);
+bool UBKInspectionEncodeSelect(UBKInspectionBuffer *buffer, uint64_t key);
+bool UBKInspectionEncodeSetColour(UBKInspectionBuffer *buffer, uint64_t key, uint32_t colourIndex, uint32_t rgba);
+bool UBKInspectionEncodeRequestSnapshot(UBKInspectionBuffer *buffer);
+
+typedef struct {
+    uint8_t type;
+    const uint8_t *payload;
+    size_t payloadLength;
+} UBKInspectionFrame;
+
+//Returns the bytes used by the first frame, 0 if more bytes are needed or -1 if the stream is broken
+int64_t UBKInspectionNextFrame(const uint8_t *bytes, size_t length, UBKInspectionFrame *frame);
+
+//Applies a snapshot or delta frame, returns false for other frames, malformed frames or a delta made from another sequence
+bool UBKInspectionTreeApplyFrame(UBKInspectionTree *tree, const UBKInspectionFrame *frame);
+
+typedef struct {
+    UBKInspectionMessageType type;
+    uint64_t key;
+    uint32_t colourIndex;
+    uint32_t rgba;
+} UBKInspectionCommand;
+
+//Selection and client commands
+bool UBKInspectionDecodeCommand(const UBKInspectionFrame *frame, UBKInspectionCommand *command);
+
+#define UBKInspectionServerMaximumConnections 4
+
+typedef struct {
+    int fileDescriptor;
+    UBKInspectionBuffer input;
+    UBKInspectionBuffer output;
+    //Bytes of output already written
+    size_t outputOffset;
+    //Set for new connections and connections that fell behind, they get a full snapshot once their output has drained
+    bool needsSnapshot;
+} UBKInspectionConnection;
+
+typedef struct {
+    int listenFileDescriptor;
+    //Filled in when the server opens, useful after opening on port 0
+    uint16_t port;
+    UBKInspectionConnection connections[UBKInspectionServerMaximumConnections];
+    uint32_t connectionCount;
+    //The last published tree, every connection that doesn't need a snapshot is at its sequence
+    UBKInspectionTree published;
+    //A connection with more unwritten bytes than this skips deltas and is sent a snapshot later. Default 1MB.
+    size_t maximumPendingOutput;
+    uint64_t bytesSent;
+} UBKInspectionServer;
+
+typedef void (*UBKInspectionCommandHandler)(const UBKInspectionCommand *command, void *context);
+
+//Listens on the loopback interface only. Pass 0 for any free port.
+bool UBKInspectionServerOpen(UBKInspectionServer *server, uint16_t port);
+void UBKInspectionServerClose(UBKInspectionServer *server);
+
+//Never blocks: accepts connections, reads commands and passes them to handler, and writes what it can. Call often, eg once a frame.
+void UBKInspectionServerPoll(UBKInspectionServer *server, UBKInspectionCommandHandler handler, void *context);
+
+//Queues the changes since the last published tree for every connection, they are written by the next poll. The tree's sequence is set. Returns false if the tree couldn't be copied.
+bool UBKInspectionServerPublish(UBKInspectionServer *server, UBKInspectionTree *tree);
+void UBKInspectionServerSendSelection(UBKInspectionServer *server, uint64_t key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKInspection_h */
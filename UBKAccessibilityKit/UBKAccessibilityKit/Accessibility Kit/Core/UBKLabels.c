@@ -0,0 +1,218 @@
+/*
+ File: UBKLabels.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKLabels.h"
+#include "UBKHash.h"
+
+#include <stdlib.h>
+
+//Bytes outside ASCII are treated as letters so UTF-8 text stays in one word
+static inline bool UBKLabelIsWordByte(unsigned char byte)
+{
+    return ((byte >= 'a') && (byte <= 'z')) || ((byte >= 'A') && (byte <= 'Z')) || ((byte >= '0') && (byte <= '9')) || (byte >= 0x80);
+}
+
+static inline bool UBKLabelIsDigit(unsigned char byte)
+{
+    return (byte >= '0') && (byte <= '9');
+}
+
+static inline bool UBKLabelIsUpper(unsigned char byte)
+{
+    return (byte >= 'A') && (byte <= 'Z');
+}
+
+static inline bool UBKLabelIsLower(unsigned char byte)
+{
+    return ((byte >= 'a') && (byte <= 'z')) || UBKLabelIsDigit(byte);
+}
+
+//A new word starts at byte i when it follows a lowercase letter or digit, eg settings|Button, or ends a run of capitals, eg UI|Button
+static inline bool UBKLabelIsCamelBoundary(const unsigned char *text, size_t i)
+{
+    if ((i == 0) || (!UBKLabelIsUpper(text[i])))
+    {
+        return false;
+    }
+    if (UBKLabelIsLower(text[i - 1]))
+    {
+        return true;
+    }
+    return UBKLabelIsUpper(text[i - 1]) && (text[i + 1] >= 'a') && (text[i + 1] <= 'z');
+}
+
+uint64_t UBKLabelHash(const char *text, bool dropFirstWord)
+{
+    if (text == NULL)
+    {
+        return 0;
+    }
+    const unsigned char *bytes = (const unsigned char *)text;
+    uint64_t hash = UBKHashInitialValue;
+    size_t wordCount = 0;
+    bool inWord = false;
+    bool skipping = false;
+    for (size_t i = 0; bytes[i]; i++)
+    {
+        unsigned char byte = bytes[i];
+        if (!UBKLabelIsWordByte(byte))
+        {
+            inWord = false;
+            continue;
+        }
+        if ((!inWord) || (UBKLabelIsCamelBoundary(bytes, i)))
+        {
+            wordCount++;
+            skipping = dropFirstWord && (wordCount == 1);
+            //Words are joined with a single space
+            if ((!skipping) && (wordCount > (dropFirstWord ? 2 : 1)))
+            {
+                hash ^= ' ';
+                hash *= 0x100000001b3ULL;
+            }
+            inWord = true;
+        }
+        if (skipping)
+        {
+            continue;
+        }
+        if (UBKLabelIsUpper(byte))
+        {
+            byte = (unsigned char)(byte - 'A' + 'a');
+        }
+        hash ^= byte;
+        hash *= 0x100000001b3ULL;
+    }
+    if (wordCount <= (dropFirstWord ? 1 : 0))
+    {
+        return 0;
+    }
+    //Zero is kept for no label
+    return (hash == 0) ? 1 : hash;
+}
+
+bool UBKLabelIsCodeLike(const char *text)
+{
+    if (text == NULL)
+    {
+        return false;
+    }
+    const unsigned char *bytes = (const unsigned char *)text;
+    for (size_t i = 0; bytes[i]; i++)
+    {
+        if ((bytes[i] == '_') && (i > 0) && (UBKLabelIsWordByte(bytes[i - 1])) && (UBKLabelIsWordByte(bytes[i + 1])))
+        {
+            return true;
+        }
+        //Dots between letters, eg login.title, but not numbers like 3.5
+        if ((bytes[i] == '.') && (i > 0) && (UBKLabelIsWordByte(bytes[i - 1])) && (!UBKLabelIsDigit(bytes[i - 1])) && (UBKLabelIsWordByte(bytes[i + 1])) && (!UBKLabelIsDigit(bytes[i + 1])))
+        {
+            return true;
+        }
+        //Lowercase into uppercase, eg settingsButton. A run of capitals alone, eg "OK", is normal text.
+        if ((UBKLabelIsUpper(bytes[i])) && (i > 0) && (bytes[i - 1] >= 'a') && (bytes[i - 1] <= 'z'))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool UBKLabelsAnalyse(const UBKLabelNode *nodes, size_t count, UBKLabelResult *results)
+{
+    //Open addressing map of label and context to the first node and the group size
+    size_t capacity = 16;
+    while (capacity < count * 2)
+    {
+        capacity *= 2;
+    }
+    uint64_t *keys = malloc(capacity * sizeof(uint64_t));
+    int32_t *firstIndexes = malloc(capacity * sizeof(int32_t));
+    uint32_t *groupCounts = calloc(capacity, sizeof(uint32_t));
+    size_t *slots = malloc((count + 1) * sizeof(size_t));
+    if ((keys == NULL) || (firstIndexes == NULL) || (groupCounts == NULL) || (slots == NULL))
+    {
+        free(keys);
+        free(firstIndexes);
+        free(groupCounts);
+        free(slots);
+        return false;
+    }
+    size_t mask = capacity - 1;
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        const UBKLabelNode *node = &nodes[i];
+        results[i].flags = 0;
+        results[i].firstDuplicate = -1;
+        results[i].duplicateCount = 0;
+        results[i].echoedName = -1;
+        slots[i] = SIZE_MAX;
+        if (node->label == 0)
+        {
+            continue;
+        }
+        
+        for (int name = 0; name < UBKLabelNameCount; name++)
+        {
+            if ((node->names[name] == node->label) && ((name >= UBKLabelNameClass) || (node->labelIsCodeLike)))
+            {
+                results[i].flags |= UBKLabelFlagEchoesName;
+                results[i].echoedName = name;
+                break;
+            }
+        }
+        
+        if (!node->isInteractive)
+        {
+            continue;
+        }
+        uint64_t key = UBKHashCombine(node->label, node->context);
+        size_t slot = (size_t)key & mask;
+        while ((groupCounts[slot] != 0) && (keys[slot] != key))
+        {
+            slot = (slot + 1) & mask;
+        }
+        if (groupCounts[slot] == 0)
+        {
+            keys[slot] = key;
+            firstIndexes[slot] = (int32_t)i;
+        }
+        groupCounts[slot]++;
+        slots[i] = slot;
+    }
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((slots[i] != SIZE_MAX) && (groupCounts[slots[i]] > 1))
+        {
+            results[i].flags |= UBKLabelFlagDuplicate;
+            results[i].firstDuplicate = firstIndexes[slots[i]];
+            results[i].duplicateCount = groupCounts[slots[i]];
+        }
+    }
+    
+    free(keys);
+    free(firstIndexes);
+    free(groupCounts);
+    free(slots);
+    return true;
+}
@@ -0,0 +1,86 @@
+/*
+ File: UBKLabels.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKLabels_h
+#define UBKLabels_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Screen level label checks. Controls that VoiceOver reads the same way, eg five buttons that all say "More", can't be told apart. Labels that repeat a name from code, eg "icon_close" or "Button", don't describe anything.
+//Labels and names are compared as normalised words: split on punctuation and camel case, ASCII lowercased, so "settingsButton", "settings_button" and "Settings button" match. Fold case and diacritics outside ASCII before hashing.
+
+typedef enum {
+    UBKLabelNameIdentifier,
+    UBKLabelNameImage,
+    //Class names match any label written the same way, eg "Button" for UIButton. The other names only match labels written like code.
+    UBKLabelNameClass,
+    //Class name without its leading prefix word, eg "Button" for UIButton
+    UBKLabelNameClassWithoutPrefix,
+    UBKLabelNameCount
+} UBKLabelName;
+
+typedef struct {
+    //UBKLabelHash of the label, 0 when there isn't one
+    uint64_t label;
+    //Hash of the hint and value, 0 when neither is set. Elements with the same label and context sound the same.
+    uint64_t context;
+    //UBKLabelHash of each name, 0 for names that aren't set
+    uint64_t names[UBKLabelNameCount];
+    //See UBKLabelIsCodeLike
+    bool labelIsCodeLike;
+    //Only interactive elements are checked for duplicates
+    bool isInteractive;
+} UBKLabelNode;
+
+typedef enum {
+    UBKLabelFlagDuplicate = 1 << 0,
+    UBKLabelFlagEchoesName = 1 << 1
+} UBKLabelFlags;
+
+typedef struct {
+    uint32_t flags;
+    //Index of the first node with the same label and context, and how many nodes share them. -1 and 0 for nodes that aren't duplicates.
+    int32_t firstDuplicate;
+    uint32_t duplicateCount;
+    //The UBKLabelName the label repeats, -1 when it doesn't
+    int32_t echoedName;
+} UBKLabelResult;
+
+//Hash of the normalised words of text, 0 for NULL or text without any letters or digits. Pass true for dropFirstWord to skip a prefix, eg UI in UIButton.
+uint64_t UBKLabelHash(const char *text, bool dropFirstWord);
+
+//True for text that looks like it came from code rather than a translation: words joined by underscores or dots, or camel case inside a word.
+bool UBKLabelIsCodeLike(const char *text);
+
+//Groups the nodes by label and context with a hash map, O(n). Results must hold count values. Returns false if the working memory couldn't be allocated.
+bool UBKLabelsAnalyse(const UBKLabelNode *nodes, size_t count, UBKLabelResult *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKLabels_h */
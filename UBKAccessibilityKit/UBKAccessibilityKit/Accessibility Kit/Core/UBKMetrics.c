@@ -0,0 +1,419 @@
+/*
+ File: UBKMetrics.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+//Needed for getaddrinfo and strdup
+#define _POSIX_C_SOURCE 200809L
+
+#include "UBKMetrics.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+//Leaves room for IP and UDP headers inside a typical 1500 byte MTU
+#define UBKMetricsDatagramSize 1432
+
+const double UBKMetricsDurationBounds[UBKMetricsDurationBucketCount - 1] = {0.001, 0.002, 0.005, 0.01, 0.0167, 0.0333, 0.05, 0.1, 0.25, 0.5, 1};
+
+static const char *const UBKMetricsCounterNames[UBKMetricsCounterCount] = {"refreshes", "nodes_scanned", "elements_scanned", "rules_run", "cache_hits", "cache_misses", "arena_allocations", "warnings_found"};
+static const char *const UBKMetricsCounterHelp[UBKMetricsCounterCount] = {
+    "Hierarchy refreshes.",
+    "Snapshot nodes walked.",
+    "Elements audited, reused or not.",
+    "Element audits not served by the audit cache plus screen level passes.",
+    "Snapshot nodes reused from the audit cache.",
+    "Snapshot nodes recomputed by the audit cache.",
+    "Memory blocks the scan arenas took from the system.",
+    "Warnings found, summed over refreshes."
+};
+static const char *const UBKMetricsLevelNames[UBKMetricsWarningLevelCount] = {"high", "medium", "low", "pass"};
+
+static inline void UBKMetricsAdd(uint64_t *value, uint64_t amount)
+{
+    if (amount > 0)
+    {
+        __atomic_fetch_add(value, amount, __ATOMIC_RELAXED);
+    }
+}
+
+static inline void UBKMetricsStore(uint64_t *value, uint64_t newValue)
+{
+    __atomic_store_n(value, newValue, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t UBKMetricsLoad(const uint64_t *value)
+{
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+}
+
+void UBKMetricsInit(UBKMetrics *metrics)
+{
+    memset(metrics, 0, sizeof(*metrics));
+}
+
+void UBKMetricsRecordRefresh(UBKMetrics *metrics, const UBKMetricsRefresh *refresh)
+{
+    uint64_t warnings = 0;
+    for (size_t i = 0; i < UBKMetricsWarningTypeCount; i++)
+    {
+        UBKMetricsAdd(&metrics->warningsByType[i], refresh->warningsByType[i]);
+        UBKMetricsStore(&metrics->currentWarningsByType[i], refresh->warningsByType[i]);
+        warnings += refresh->warningsByType[i];
+    }
+    for (size_t i = 0; i < UBKMetricsWarningLevelCount; i++)
+    {
+        UBKMetricsAdd(&metrics->warningsByLevel[i], refresh->warningsByLevel[i]);
+        UBKMetricsStore(&metrics->currentWarningsByLevel[i], refresh->warningsByLevel[i]);
+    }
+    UBKMetricsStore(&metrics->elements, refresh->elements);
+    UBKMetricsStore(&metrics->arenaBytes, refresh->arenaBytes);
+    
+    UBKMetricsAdd(&metrics->counters[UBKMetricsCounterNodesScanned], refresh->nodes);
+    UBKMetricsAdd(&metrics->counters[UBKMetricsCounterElementsScanned], refresh->elements);
+    UBKMetricsAdd(&metrics->counters[UBKMetricsCounterRulesRun], refresh->rulesRun);
+    UBKMetricsAdd(&metrics->counters[UBKMetricsCounterCacheHits], refresh->cacheHits);
+    UBKMetricsAdd(&metrics->counters[UBKMetricsCounterCacheMisses], refresh->cacheMisses);
+    UBKMetricsAdd(&metrics->counters[UBKMetricsCounterArenaAllocations], refresh->arenaAllocations);
+    UBKMetricsAdd(&metrics->counters[UBKMetricsCounterWarnings], warnings);
+    
+    size_t bucket = 0;
+    while ((bucket < UBKMetricsDurationBucketCount - 1) && (refresh->duration > UBKMetricsDurationBounds[bucket]))
+    {
+        bucket++;
+    }
+    UBKMetricsAdd(&metrics->durationBuckets[bucket], 1);
+    UBKMetricsAdd(&metrics->durationSumNanoseconds, (refresh->duration > 0) ? (uint64_t)(refresh->duration * 1e9) : 0);
+    //Counted last, a reader that sees the refresh count has seen most of the refresh
+    UBKMetricsAdd(&metrics->counters[UBKMetricsCounterRefreshes], 1);
+}
+
+void UBKMetricsRead(const UBKMetrics *metrics, UBKMetrics *copy)
+{
+    //UBKMetrics is only made of uint64_t values
+    const uint64_t *source = (const uint64_t *)metrics;
+    uint64_t *destination = (uint64_t *)copy;
+    for (size_t i = 0; i < sizeof(UBKMetrics) / sizeof(uint64_t); i++)
+    {
+        destination[i] = UBKMetricsLoad(&source[i]);
+    }
+}
+
+typedef struct {
+    char *buffer;
+    size_t capacity;
+    size_t length;
+} UBKMetricsText;
+
+static void UBKMetricsAppend(UBKMetricsText *text, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+static void UBKMetricsAppend(UBKMetricsText *text, const char *format, ...)
+{
+    size_t available = (text->length < text->capacity) ? text->capacity - text->length : 0;
+    va_list arguments;
+    va_start(arguments, format);
+    int written = vsnprintf((available > 0) ? text->buffer + text->length : NULL, available, format, arguments);
+    va_end(arguments);
+    if (written > 0)
+    {
+        text->length += (size_t)written;
+    }
+}
+
+static inline const char *UBKMetricsTypeName(UBKMetricsTypeNames typeNames, size_t type)
+{
+    return ((type < typeNames.count) && (typeNames.names[type] != NULL)) ? typeNames.names[type] : NULL;
+}
+
+//Named types are always written so their series read 0 rather than disappearing, unnamed types only when they have a value
+static void UBKMetricsAppendTypeValues(UBKMetricsText *text, const char *format, const char *unnamedFormat, const char *prefix, UBKMetricsTypeNames typeNames, const uint64_t *values)
+{
+    for (size_t type = 0; type < UBKMetricsWarningTypeCount; type++)
+    {
+        const char *name = UBKMetricsTypeName(typeNames, type);
+        if (name != NULL)
+        {
+            UBKMetricsAppend(text, format, prefix, name, (unsigned long long)values[type]);
+        }
+        else if (values[type] > 0)
+        {
+            UBKMetricsAppend(text, unnamedFormat, prefix, (unsigned)type, (unsigned long long)values[type]);
+        }
+    }
+}
+
+size_t UBKMetricsFormatPrometheus(const UBKMetrics *metrics, const char *prefix, UBKMetricsTypeNames typeNames, char *buffer, size_t capacity)
+{
+    UBKMetrics values;
+    UBKMetricsRead(metrics, &values);
+    UBKMetricsText text = {buffer, capacity, 0};
+    if (capacity > 0)
+    {
+        buffer[0] = '\0';
+    }
+    
+    for (size_t i = 0; i < UBKMetricsCounterCount; i++)
+    {
+        const char *name = UBKMetricsCounterNames[i];
+        UBKMetricsAppend(&text, "# HELP %s_%s_total %s\n# TYPE %s_%s_total counter\n", prefix, name, UBKMetricsCounterHelp[i], prefix, name);
+        if (i == UBKMetricsCounterWarnings)
+        {
+            UBKMetricsAppendTypeValues(&text, "%s_warnings_found_total{type=\"%s\"} %llu\n", "%s_warnings_found_total{type=\"%u\"} %llu\n", prefix, typeNames, values.warningsByType);
+            //Levels are a separate family so summing either family doesn't count a warning twice
+            UBKMetricsAppend(&text, "# HELP %s_warnings_found_by_level_total Warnings found, summed over refreshes.\n# TYPE %s_warnings_found_by_level_total counter\n", prefix, prefix);
+            for (size_t level = 0; level < UBKMetricsWarningLevelCount; level++)
+            {
+                UBKMetricsAppend(&text, "%s_warnings_found_by_level_total{level=\"%s\"} %llu\n", prefix, UBKMetricsLevelNames[level], (unsigned long long)values.warningsByLevel[level]);
+            }
+        }
+        else
+        {
+            UBKMetricsAppend(&text, "%s_%s_total %llu\n", prefix, name, (unsigned long long)values.counters[i]);
+        }
+    }
+    
+    UBKMetricsAppend(&text, "# HELP %s_elements Elements on screen after the latest refresh.\n# TYPE %s_elements gauge\n%s_elements %llu\n", prefix, prefix, prefix, (unsigned long long)values.elements);
+    UBKMetricsAppend(&text, "# HELP %s_arena_bytes Scan arena bytes used by the latest refresh.\n# TYPE %s_arena_bytes gauge\n%s_arena_bytes %llu\n", prefix, prefix, prefix, (unsigned long long)values.arenaBytes);
+    UBKMetricsAppend(&text, "# HELP %s_warnings Warnings on screen after the latest refresh.\n# TYPE %s_warnings gauge\n", prefix, prefix);
+    UBKMetricsAppendTypeValues(&text, "%s_warnings{type=\"%s\"} %llu\n", "%s_warnings{type=\"%u\"} %llu\n", prefix, typeNames, values.currentWarningsByType);
+    UBKMetricsAppend(&text, "# HELP %s_warnings_by_level Warnings on screen after the latest refresh.\n# TYPE %s_warnings_by_level gauge\n", prefix, prefix);
+    for (size_t level = 0; level < UBKMetricsWarningLevelCount; level++)
+    {
+        UBKMetricsAppend(&text, "%s_warnings_by_level{level=\"%s\"} %llu\n", prefix, UBKMetricsLevelNames[level], (unsigned long long)values.currentWarningsByLevel[level]);
+    }
+    
+    UBKMetricsAppend(&text, "# HELP %s_refresh_duration_seconds Time spent on each refresh.\n# TYPE %s_refresh_duration_seconds histogram\n", prefix, prefix);
+    uint64_t cumulative = 0;
+    for (size_t bucket = 0; bucket < UBKMetricsDurationBucketCount; bucket++)
+    {
+        cumulative += values.durationBuckets[bucket];
+        if (bucket < UBKMetricsDurationBucketCount - 1)
+        {
+            UBKMetricsAppend(&text, "%s_refresh_duration_seconds_bucket{le=\"%g\"} %llu\n", prefix, UBKMetricsDurationBounds[bucket], (unsigned long long)cumulative);
+        }
+        else
+        {
+            UBKMetricsAppend(&text, "%s_refresh_duration_seconds_bucket{le=\"+Inf\"} %llu\n", prefix, (unsigned long long)cumulative);
+        }
+    }
+    UBKMetricsAppend(&text, "%s_refresh_duration_seconds_sum %.9f\n%s_refresh_duration_seconds_count %llu\n", prefix, values.durationSumNanoseconds / 1e9, prefix, (unsigned long long)cumulative);
+    return text.length;
+}
+
+size_t UBKMetricsFormatStatsD(const UBKMetricsRefresh *refresh, const char *prefix, UBKMetricsTypeNames typeNames, char *buffer, size_t capacity)
+{
+    UBKMetricsText text = {buffer, capacity, 0};
+    if (capacity > 0)
+    {
+        buffer[0] = '\0';
+    }
+    
+    uint64_t warnings = 0;
+    uint64_t warningsByType[UBKMetricsWarningTypeCount];
+    for (size_t type = 0; type < UBKMetricsWarningTypeCount; type++)
+    {
+        warningsByType[type] = refresh->warningsByType[type];
+        warnings += refresh->warningsByType[type];
+    }
+    const uint64_t counters[UBKMetricsCounterCount] = {1, refresh->nodes, refresh->elements, refresh->rulesRun, refresh->cacheHits, refresh->cacheMisses, refresh->arenaAllocations, warnings};
+    for (size_t i = 0; i < UBKMetricsCounterCount; i++)
+    {
+        UBKMetricsAppend(&text, "%s.%s:%llu|c\n", prefix, UBKMetricsCounterNames[i], (unsigned long long)counters[i]);
+    }
+    UBKMetricsAppend(&text, "%s.refresh_duration:%.3f|ms\n", prefix, refresh->duration * 1000);
+    UBKMetricsAppend(&text, "%s.elements:%llu|g\n", prefix, (unsigned long long)refresh->elements);
+    UBKMetricsAppend(&text, "%s.arena_bytes:%llu|g\n", prefix, (unsigned long long)refresh->arenaBytes);
+    for (size_t level = 0; level < UBKMetricsWarningLevelCount; level++)
+    {
+        UBKMetricsAppend(&text, "%s.warnings.level.%s:%u|g\n", prefix, UBKMetricsLevelNames[level], refresh->warningsByLevel[level]);
+    }
+    UBKMetricsAppendTypeValues(&text, "%s.warnings.type.%s:%llu|g\n", "%s.warnings.type.%u:%llu|g\n", prefix, typeNames, warningsByType);
+    return text.length;
+}
+
+bool UBKMetricsSinkOpenUDP(UBKMetricsSink *sink, const char *host, uint16_t port)
+{
+    memset(sink, 0, sizeof(*sink));
+    sink->fileDescriptor = -1;
+    sink->type = UBKMetricsSinkTypeUDP;
+    
+    char portString[8];
+    snprintf(portString, sizeof(portString), "%u", (unsigned)port);
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    struct addrinfo *addresses = NULL;
+    if (getaddrinfo(host, portString, &hints, &addresses) != 0)
+    {
+        return false;
+    }
+    for (struct addrinfo *address = addresses; address != NULL; address = address->ai_next)
+    {
+        int fileDescriptor = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fileDescriptor < 0)
+        {
+            continue;
+        }
+        //Connected so writes can use send, and never blocking the thread that records refreshes
+        if ((connect(fileDescriptor, address->ai_addr, address->ai_addrlen) == 0) && (fcntl(fileDescriptor, F_SETFL, fcntl(fileDescriptor, F_GETFL) | O_NONBLOCK) == 0))
+        {
+            sink->fileDescriptor = fileDescriptor;
+            break;
+        }
+        close(fileDescriptor);
+    }
+    freeaddrinfo(addresses);
+    return sink->fileDescriptor >= 0;
+}
+
+bool UBKMetricsSinkOpenFile(UBKMetricsSink *sink, const char *path, bool replace)
+{
+    memset(sink, 0, sizeof(*sink));
+    sink->fileDescriptor = -1;
+    sink->type = replace ? UBKMetricsSinkTypeReplaceFile : UBKMetricsSinkTypeAppendFile;
+    sink->path = strdup(path);
+    if (sink->path == NULL)
+    {
+        return false;
+    }
+    if (replace)
+    {
+        //Opened for each write
+        return true;
+    }
+    sink->fileDescriptor = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (sink->fileDescriptor < 0)
+    {
+        UBKMetricsSinkClose(sink);
+        return false;
+    }
+    return true;
+}
+
+static bool UBKMetricsWriteAll(int fileDescriptor, const char *text, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t written = write(fileDescriptor, text, length);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        text += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+static bool UBKMetricsSendDatagrams(int fileDescriptor, const char *text, size_t length)
+{
+    bool sent = true;
+    while (length > 0)
+    {
+        //As many whole lines as fit, or one line on its own if it's longer than a datagram
+        size_t datagramLength = 0;
+        while (datagramLength < length)
+        {
+            const char *newline = memchr(text + datagramLength, '\n', length - datagramLength);
+            size_t lineEnd = (newline != NULL) ? (size_t)(newline - text) + 1 : length;
+            if ((lineEnd > UBKMetricsDatagramSize) && (datagramLength > 0))
+            {
+                break;
+            }
+            datagramLength = lineEnd;
+        }
+        //StatsD and most listeners drop packets that fail, keep sending the rest
+        if (send(fileDescriptor, text, datagramLength, 0) < 0)
+        {
+            sent = false;
+        }
+        text += datagramLength;
+        length -= datagramLength;
+    }
+    return sent;
+}
+
+bool UBKMetricsSinkWrite(UBKMetricsSink *sink, const char *text, size_t length)
+{
+    switch (sink->type)
+    {
+        case UBKMetricsSinkTypeUDP:
+        {
+            return (sink->fileDescriptor >= 0) && (UBKMetricsSendDatagrams(sink->fileDescriptor, text, length));
+        }
+        case UBKMetricsSinkTypeAppendFile:
+        {
+            return (sink->fileDescriptor >= 0) && (UBKMetricsWriteAll(sink->fileDescriptor, text, length));
+        }
+        case UBKMetricsSinkTypeReplaceFile:
+        {
+            if (sink->path == NULL)
+            {
+                return false;
+            }
+            //Readers see the old file or the new one, never a partial write
+            size_t pathLength = strlen(sink->path);
+            char *temporaryPath = malloc(pathLength + 5);
+            if (temporaryPath == NULL)
+            {
+                return false;
+            }
+            memcpy(temporaryPath, sink->path, pathLength);
+            memcpy(temporaryPath + pathLength, ".tmp", 5);
+            
+            int fileDescriptor = open(temporaryPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            bool written = (fileDescriptor >= 0) && (UBKMetricsWriteAll(fileDescriptor, text, length));
+            if ((fileDescriptor >= 0) && (close(fileDescriptor) != 0))
+            {
+                written = false;
+            }
+            written = written && (rename(temporaryPath, sink->path) == 0);
+            if (!written)
+            {
+                unlink(temporaryPath);
+            }
+            free(temporaryPath);
+            return written;
+        }
+    }
+    return false;
+}
+
+void UBKMetricsSinkClose(UBKMetricsSink *sink)
+{
+    if (sink->fileDescriptor >= 0)
+    {
+        close(sink->fileDescriptor);
+    }
+    free(sink->path);
+    sink->path = NULL;
+    sink->fileDescriptor = -1;
+}
@@ -0,0 +1,133 @@
+/*
+ File: UBKMetrics.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKMetrics_h
+#define UBKMetrics_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Running totals of what each refresh cost and found, cheap enough to leave on. Values are only changed with relaxed atomic adds and stores, so one thread can record refreshes while another reads and exports without a lock.
+//Exported as StatsD lines, one batch per refresh, or as Prometheus text with cumulative totals, over UDP or to a file.
+
+#define UBKMetricsWarningTypeCount 64
+#define UBKMetricsWarningLevelCount 4
+//Refresh durations are counted in buckets up to each bound, the last bucket has no upper bound
+#define UBKMetricsDurationBucketCount 12
+
+extern const double UBKMetricsDurationBounds[UBKMetricsDurationBucketCount - 1];
+
+typedef enum {
+    UBKMetricsCounterRefreshes,
+    UBKMetricsCounterNodesScanned,
+    UBKMetricsCounterElementsScanned,
+    //Element audits that weren't reused from the audit cache, plus the screen level passes
+    UBKMetricsCounterRulesRun,
+    //Snapshot nodes reused from and recomputed by the audit cache
+    UBKMetricsCounterCacheHits,
+    UBKMetricsCounterCacheMisses,
+    //Blocks the scan arenas took from the system, stays flat once screens have been seen before
+    UBKMetricsCounterArenaAllocations,
+    UBKMetricsCounterWarnings,
+    UBKMetricsCounterCount
+} UBKMetricsCounter;
+
+//What a single refresh did
+typedef struct {
+    uint64_t nodes;
+    uint64_t elements;
+    uint64_t rulesRun;
+    uint64_t cacheHits;
+    uint64_t cacheMisses;
+    //System allocations made by the refresh's scan arena and the bytes it handed out
+    uint64_t arenaAllocations;
+    uint64_t arenaBytes;
+    //Seconds spent on the refresh, not counting the frames an incremental walk waited for
+    double duration;
+    //Warnings on screen after the refresh
+    uint32_t warningsByType[UBKMetricsWarningTypeCount];
+    uint32_t warningsByLevel[UBKMetricsWarningLevelCount];
+} UBKMetricsRefresh;
+
+typedef struct {
+    uint64_t counters[UBKMetricsCounterCount];
+    uint64_t warningsByType[UBKMetricsWarningTypeCount];
+    uint64_t warningsByLevel[UBKMetricsWarningLevelCount];
+    //Refreshes in each duration bucket, not cumulative
+    uint64_t durationBuckets[UBKMetricsDurationBucketCount];
+    uint64_t durationSumNanoseconds;
+    //Gauges set by the latest refresh
+    uint64_t elements;
+    uint64_t arenaBytes;
+    uint64_t currentWarningsByType[UBKMetricsWarningTypeCount];
+    uint64_t currentWarningsByLevel[UBKMetricsWarningLevelCount];
+} UBKMetrics;
+
+void UBKMetricsInit(UBKMetrics *metrics);
+
+void UBKMetricsRecordRefresh(UBKMetrics *metrics, const UBKMetricsRefresh *refresh);
+
+//Copies every value with an atomic load. A refresh recorded at the same time can be partly included.
+void UBKMetricsRead(const UBKMetrics *metrics, UBKMetrics *copy);
+
+//Names used for the warning type labels, eg colour_contrast. Types without a name, or past typeNameCount, are labelled with their number.
+typedef struct {
+    const char *const *names;
+    size_t count;
+} UBKMetricsTypeNames;
+
+//Formatters work like snprintf, they write at most capacity bytes including the nul and return the length the whole text needs.
+//Prometheus text exposition format, every metric is prefixed, eg ubk_refreshes_total.
+size_t UBKMetricsFormatPrometheus(const UBKMetrics *metrics, const char *prefix, UBKMetricsTypeNames typeNames, char *buffer, size_t capacity);
+//StatsD lines for one refresh: counters, the duration as a timer and the warnings on screen as gauges, eg ubk.warnings.type.colour_contrast:3|g
+size_t UBKMetricsFormatStatsD(const UBKMetricsRefresh *refresh, const char *prefix, UBKMetricsTypeNames typeNames, char *buffer, size_t capacity);
+
+typedef enum {
+    //Each write is sent as UDP datagrams, split between lines
+    UBKMetricsSinkTypeUDP,
+    //Each write is appended, eg StatsD lines
+    UBKMetricsSinkTypeAppendFile,
+    //Each write replaces the file in one rename, eg for a Prometheus textfile collector
+    UBKMetricsSinkTypeReplaceFile
+} UBKMetricsSinkType;
+
+typedef struct {
+    UBKMetricsSinkType type;
+    int fileDescriptor;
+    char *path;
+} UBKMetricsSink;
+
+//host is a name or a numeric IPv4 or IPv6 address, eg 127.0.0.1 for a local StatsD agent
+bool UBKMetricsSinkOpenUDP(UBKMetricsSink *sink, const char *host, uint16_t port);
+bool UBKMetricsSinkOpenFile(UBKMetricsSink *sink, const char *path, bool replace);
+bool UBKMetricsSinkWrite(UBKMetricsSink *sink, const char *text, size_t length);
+void UBKMetricsSinkClose(UBKMetricsSink *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKMetrics_h */
@@ -0,0 +1,253 @@
+/*
+ File: UBKReadingOrder.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKReadingOrder.h"
+
+#include <stdlib.h>
+
+typedef struct {
+    double top;
+    double bottom;
+    double x;
+    uint32_t row;
+    uint32_t node;
+} UBKReadingOrderEntry;
+
+typedef struct {
+    const UBKReadingOrderNode *nodes;
+    //Children of each container, the top level is container 0 and node i is container i + 1
+    const uint32_t *childOffsets;
+    const uint32_t *children;
+    uint32_t *expectedOrder;
+    size_t position;
+    UBKReadingOrderResult *results;
+} UBKReadingOrderContext;
+
+static int UBKReadingOrderCompareTop(const void *first, const void *second)
+{
+    const UBKReadingOrderEntry *firstEntry = first;
+    const UBKReadingOrderEntry *secondEntry = second;
+    if (firstEntry->top != secondEntry->top)
+    {
+        return firstEntry->top < secondEntry->top ? -1 : 1;
+    }
+    if (firstEntry->x != secondEntry->x)
+    {
+        return firstEntry->x < secondEntry->x ? -1 : 1;
+    }
+    return (firstEntry->node > secondEntry->node) - (firstEntry->node < secondEntry->node);
+}
+
+static int UBKReadingOrderCompareRow(const void *first, const void *second)
+{
+    const UBKReadingOrderEntry *firstEntry = first;
+    const UBKReadingOrderEntry *secondEntry = second;
+    if (firstEntry->row != secondEntry->row)
+    {
+        return firstEntry->row < secondEntry->row ? -1 : 1;
+    }
+    if (firstEntry->x != secondEntry->x)
+    {
+        return firstEntry->x < secondEntry->x ? -1 : 1;
+    }
+    return UBKReadingOrderCompareTop(first, second);
+}
+
+//Sorts the children of one container into reading order, entries is scratch space big enough for them.
+static void UBKReadingOrderSortChildren(const UBKReadingOrderNode *nodes, uint32_t *children, size_t childCount, bool rightToLeft, UBKReadingOrderEntry *entries)
+{
+    for (size_t i = 0; i < childCount; i++)
+    {
+        const UBKRect *frame = &nodes[children[i]].frame;
+        entries[i].top = frame->y;
+        entries[i].bottom = frame->y + frame->height;
+        //Negating x reads each row from the right
+        entries[i].x = rightToLeft ? -(frame->x + frame->width) : frame->x;
+        entries[i].row = 0;
+        entries[i].node = children[i];
+    }
+    qsort(entries, childCount, sizeof(UBKReadingOrderEntry), UBKReadingOrderCompareTop);
+    
+    //A node joins the current row when its vertical centre is above the bottom of the row
+    uint32_t row = 0;
+    double rowBottom = entries[0].bottom;
+    for (size_t i = 1; i < childCount; i++)
+    {
+        double centre = (entries[i].top + entries[i].bottom) / 2;
+        if (centre >= rowBottom)
+        {
+            row++;
+            rowBottom = entries[i].bottom;
+        }
+        else if (entries[i].bottom > rowBottom)
+        {
+            rowBottom = entries[i].bottom;
+        }
+        entries[i].row = row;
+    }
+    qsort(entries, childCount, sizeof(UBKReadingOrderEntry), UBKReadingOrderCompareRow);
+    
+    for (size_t i = 0; i < childCount; i++)
+    {
+        children[i] = entries[i].node;
+    }
+}
+
+static void UBKReadingOrderEmit(UBKReadingOrderContext *context, uint32_t container)
+{
+    for (uint32_t i = context->childOffsets[container]; i < context->childOffsets[container + 1]; i++)
+    {
+        uint32_t node = context->children[i];
+        if (context->nodes[node].isGroup)
+        {
+            UBKReadingOrderEmit(context, node + 1);
+        }
+        else
+        {
+            context->results[node].position = (int32_t)context->position;
+            context->expectedOrder[context->position] = node;
+            context->position++;
+        }
+    }
+}
+
+//Marks every element outside the longest run whose expected positions increase in hierarchy order.
+static bool UBKReadingOrderMarkOutOfOrder(const UBKReadingOrderNode *nodes, size_t count, size_t elementCount, UBKReadingOrderResult *results)
+{
+    //tails[k] is the node ending the best run of length k + 1 found so far, previous links each node to the one before it in its run
+    uint32_t *tails = malloc(elementCount * sizeof(uint32_t));
+    int32_t *previous = malloc(count * sizeof(int32_t));
+    if ((tails == NULL) || (previous == NULL))
+    {
+        free(tails);
+        free(previous);
+        return false;
+    }
+    
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (nodes[i].isGroup)
+        {
+            continue;
+        }
+        int32_t position = results[i].position;
+        size_t low = 0;
+        size_t high = length;
+        while (low < high)
+        {
+            size_t middle = low + ((high - low) / 2);
+            if (results[tails[middle]].position < position)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        previous[i] = (low > 0) ? (int32_t)tails[low - 1] : -1;
+        tails[low] = (uint32_t)i;
+        if (low == length)
+        {
+            length++;
+        }
+    }
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!nodes[i].isGroup)
+        {
+            results[i].flags |= UBKReadingOrderFlagOutOfOrder;
+        }
+    }
+    if (length > 0)
+    {
+        for (int32_t node = (int32_t)tails[length - 1]; node >= 0; node = previous[node])
+        {
+            results[node].flags &= ~(uint32_t)UBKReadingOrderFlagOutOfOrder;
+        }
+    }
+    
+    free(tails);
+    free(previous);
+    return true;
+}
+
+bool UBKReadingOrderAnalyse(const UBKReadingOrderNode *nodes, size_t count, bool rightToLeft, uint32_t *expectedOrder, size_t *elementCount, UBKReadingOrderResult *results)
+{
+    *elementCount = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        results[i].position = -1;
+        results[i].flags = 0;
+    }
+    if (count == 0)
+    {
+        return true;
+    }
+    
+    uint32_t *childOffsets = calloc(count + 3, sizeof(uint32_t));
+    uint32_t *children = malloc(count * sizeof(uint32_t));
+    UBKReadingOrderEntry *entries = malloc(count * sizeof(UBKReadingOrderEntry));
+    if ((childOffsets == NULL) || (children == NULL) || (entries == NULL))
+    {
+        free(childOffsets);
+        free(children);
+        free(entries);
+        return false;
+    }
+    
+    //Bucket the nodes by container, keeping hierarchy order within each. Container c is counted at c + 2 and filled from c + 1, which leaves c + 1 pointing at its end.
+    for (size_t i = 0; i < count; i++)
+    {
+        childOffsets[nodes[i].group + 3]++;
+    }
+    for (size_t i = 3; i < count + 3; i++)
+    {
+        childOffsets[i] += childOffsets[i - 1];
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        children[childOffsets[nodes[i].group + 2]++] = (uint32_t)i;
+    }
+    
+    //childOffsets[c] is now the start of container c
+    for (size_t container = 0; container < count + 1; container++)
+    {
+        size_t childCount = childOffsets[container + 1] - childOffsets[container];
+        if (childCount > 1)
+        {
+            UBKReadingOrderSortChildren(nodes, children + childOffsets[container], childCount, rightToLeft, entries);
+        }
+    }
+    
+    UBKReadingOrderContext context = { nodes, childOffsets, children, expectedOrder, 0, results };
+    UBKReadingOrderEmit(&context, 0);
+    *elementCount = context.position;
+    
+    bool success = UBKReadingOrderMarkOutOfOrder(nodes, count, context.position, results);
+    
+    free(childOffsets);
+    free(children);
+    free(entries);
+    return success;
+}
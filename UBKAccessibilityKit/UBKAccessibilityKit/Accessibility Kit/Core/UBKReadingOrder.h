@@ -0,0 +1,63 @@
+/*
+ File: UBKReadingOrder.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKReadingOrder_h
+#define UBKReadingOrder_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "UBKSnapshot.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Expected VoiceOver reading order worked out from frames. Within each container, nodes are clustered into rows top to bottom and read left to right (right to left for RTL layouts). A node that spans several rows on one side, eg a tall image beside a list, is read before the rows next to it, so columns stay together. Groups, eg views with shouldGroupAccessibilityChildren, are read as one block in place of their members.
+
+typedef struct {
+    //Frame in window space
+    UBKRect frame;
+    //Index of the enclosing group node, -1 at the top level. Groups have to come before their members.
+    int32_t group;
+    bool isGroup;
+} UBKReadingOrderNode;
+
+typedef enum {
+    //The element isn't part of the longest run of elements that are already in reading order, ie focus jumps to or from it
+    UBKReadingOrderFlagOutOfOrder = 1 << 0
+} UBKReadingOrderFlags;
+
+typedef struct {
+    //Position in the expected reading order, -1 for groups
+    int32_t position;
+    uint32_t flags;
+} UBKReadingOrderResult;
+
+//Nodes are passed in hierarchy order, the order focus moves in when the frames are ignored. Results must hold count values and expectedOrder is filled with the element node indexes in reading order, elementCount of them. The out of order elements are the fewest that need to move to match, found with a longest increasing subsequence. O(n log n). Returns false if the working memory couldn't be allocated.
+bool UBKReadingOrderAnalyse(const UBKReadingOrderNode *nodes, size_t count, bool rightToLeft, uint32_t *expectedOrder, size_t *elementCount, UBKReadingOrderResult *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKReadingOrder_h */
@@ -0,0 +1,149 @@
+/*
+ File: UBKRuleProfile.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKRuleProfile.h"
+
+#include <stddef.h>
+
+//Large text sizes are 14pt bold and 18pt in CSS points, https://www.w3.org/TR/WCAG20-TECHS/G18.html
+#define UBK_RULE_THRESHOLDS_WCAG20 { 4.5, 7.0, 3.0, 4.5, 0, 0, 24, 18.66, 0 }
+#define UBK_RULE_THRESHOLDS_WCAG21 { 4.5, 7.0, 3.0, 4.5, 3.0, 4.5, 24, 18.66, 44 }
+#define UBK_RULE_THRESHOLDS_WCAG22 { 4.5, 7.0, 3.0, 4.5, 3.0, 4.5, 24, 18.66, 24 }
+
+static inline UBKRuleRating UBKRuleTextContrastRating(const UBKRuleThresholds *thresholds, double contrast, double textSize, bool boldFont)
+{
+    if ((contrast == 0) && (textSize == 0))
+    {
+        return UBKRuleRatingNA;
+    }
+    if (((textSize >= thresholds->largeBoldTextSize) && (boldFont)) || (textSize >= thresholds->largeTextSize))
+    {
+        if ((thresholds->largeTextAAA > 0) && (contrast >= thresholds->largeTextAAA))
+        {
+            return UBKRuleRatingAAALarge;
+        }
+        else if (contrast >= thresholds->largeTextAA)
+        {
+            return UBKRuleRatingAALarge;
+        }
+    }
+    else
+    {
+        if ((thresholds->textAAA > 0) && (contrast >= thresholds->textAAA))
+        {
+            return UBKRuleRatingAAA;
+        }
+        else if (contrast >= thresholds->textAA)
+        {
+            return UBKRuleRatingAA;
+        }
+    }
+    return UBKRuleRatingFail;
+}
+
+static inline UBKRuleRating UBKRuleNonTextContrastRating(const UBKRuleThresholds *thresholds, double contrast)
+{
+    if (thresholds->nonTextAA <= 0)
+    {
+        return UBKRuleRatingNA;
+    }
+    if ((thresholds->nonTextAAA > 0) && (contrast >= thresholds->nonTextAAA))
+    {
+        return UBKRuleRatingAAA;
+    }
+    else if (contrast >= thresholds->nonTextAA)
+    {
+        return UBKRuleRatingAA;
+    }
+    return UBKRuleRatingFail;
+}
+
+static inline bool UBKRuleIsBelowMinimumTargetSize(const UBKRuleThresholds *thresholds, double width, double height)
+{
+    return (thresholds->minimumTargetSize > 0) && ((width < thresholds->minimumTargetSize) || (height < thresholds->minimumTargetSize));
+}
+
+//Each built in profile gets its own copy of the rules with the thresholds as constants, the compiler folds them into the comparisons and drops checks the profile turns off.
+#define UBK_RULE_PROFILE(name) \
+static const UBKRuleThresholds UBKRuleThresholds##name = UBK_RULE_THRESHOLDS_##name; \
+static UBKRuleRating UBKRuleTextContrastRating##name(const UBKRuleThresholds *thresholds, double contrast, double textSize, bool boldFont) \
+{ \
+    (void)thresholds; \
+    return UBKRuleTextContrastRating(&UBKRuleThresholds##name, contrast, textSize, boldFont); \
+} \
+static UBKRuleRating UBKRuleNonTextContrastRating##name(const UBKRuleThresholds *thresholds, double contrast) \
+{ \
+    (void)thresholds; \
+    return UBKRuleNonTextContrastRating(&UBKRuleThresholds##name, contrast); \
+} \
+static bool UBKRuleIsBelowMinimumTargetSize##name(const UBKRuleThresholds *thresholds, double width, double height) \
+{ \
+    (void)thresholds; \
+    return UBKRuleIsBelowMinimumTargetSize(&UBKRuleThresholds##name, width, height); \
+}
+
+#define UBK_RULE_EVALUATOR(name) { UBKRuleProfile##name, UBK_RULE_THRESHOLDS_##name, UBKRuleTextContrastRating##name, UBKRuleNonTextContrastRating##name, UBKRuleIsBelowMinimumTargetSize##name }
+
+UBK_RULE_PROFILE(WCAG20)
+UBK_RULE_PROFILE(WCAG21)
+UBK_RULE_PROFILE(WCAG22)
+
+static const UBKRuleEvaluator UBKRuleEvaluators[] = {
+    UBK_RULE_EVALUATOR(WCAG20),
+    UBK_RULE_EVALUATOR(WCAG21),
+    UBK_RULE_EVALUATOR(WCAG22)
+};
+
+//Custom profiles read their thresholds through the evaluator
+static UBKRuleRating UBKRuleTextContrastRatingCustom(const UBKRuleThresholds *thresholds, double contrast, double textSize, bool boldFont)
+{
+    return UBKRuleTextContrastRating(thresholds, contrast, textSize, boldFont);
+}
+
+static UBKRuleRating UBKRuleNonTextContrastRatingCustom(const UBKRuleThresholds *thresholds, double contrast)
+{
+    return UBKRuleNonTextContrastRating(thresholds, contrast);
+}
+
+static bool UBKRuleIsBelowMinimumTargetSizeCustom(const UBKRuleThresholds *thresholds, double width, double height)
+{
+    return UBKRuleIsBelowMinimumTargetSize(thresholds, width, height);
+}
+
+const UBKRuleEvaluator *UBKRuleEvaluatorForProfile(UBKRuleProfileIdentifier profile)
+{
+    if (profile >= UBKRuleProfileCustom)
+    {
+        return NULL;
+    }
+    return &UBKRuleEvaluators[profile];
+}
+
+UBKRuleEvaluator UBKRuleEvaluatorMakeCustom(UBKRuleThresholds thresholds)
+{
+    UBKRuleEvaluator evaluator;
+    evaluator.identifier = UBKRuleProfileCustom;
+    evaluator.thresholds = thresholds;
+    evaluator.textContrastRating = UBKRuleTextContrastRatingCustom;
+    evaluator.nonTextContrastRating = UBKRuleNonTextContrastRatingCustom;
+    evaluator.isBelowMinimumTargetSize = UBKRuleIsBelowMinimumTargetSizeCustom;
+    return evaluator;
+}
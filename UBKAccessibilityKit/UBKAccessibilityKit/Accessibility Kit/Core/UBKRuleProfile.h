@@ -0,0 +1,99 @@
+/*
+ File: UBKRuleProfile.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKRuleProfile_h
+#define UBKRuleProfile_h
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Same order as ColourContrastRating so ratings can be cast across
+typedef enum {
+    UBKRuleRatingNA,
+    UBKRuleRatingFail,
+    UBKRuleRatingAA,
+    UBKRuleRatingAALarge,
+    UBKRuleRatingAAA,
+    UBKRuleRatingAAALarge
+} UBKRuleRating;
+
+typedef enum {
+    //Text contrast only, WCAG 2.0 has no non text contrast or target size criteria
+    UBKRuleProfileWCAG20,
+    //Adds 1.4.11 non text contrast, targets checked against 2.5.5 (44 x 44, also the Apple minimum)
+    UBKRuleProfileWCAG21,
+    //Targets checked against 2.5.8 (24 x 24)
+    UBKRuleProfileWCAG22,
+    //Thresholds supplied at runtime
+    UBKRuleProfileCustom,
+    UBKRuleProfileCount
+} UBKRuleProfileIdentifier;
+
+//Contrast ratios are the minimum passing ratio for each rating, sizes are in points. A zero ratio or size turns that check off.
+typedef struct {
+    double textAA;
+    double textAAA;
+    double largeTextAA;
+    double largeTextAAA;
+    double nonTextAA;
+    double nonTextAAA;
+    //Text at least this size is large, or at least largeBoldTextSize when bold
+    double largeTextSize;
+    double largeBoldTextSize;
+    double minimumTargetSize;
+} UBKRuleThresholds;
+
+//Built in profiles point at evaluators specialised for their thresholds, the thresholds argument is only read by custom evaluators.
+typedef struct {
+    UBKRuleProfileIdentifier identifier;
+    UBKRuleThresholds thresholds;
+    UBKRuleRating (*textContrastRating)(const UBKRuleThresholds *thresholds, double contrast, double textSize, bool boldFont);
+    UBKRuleRating (*nonTextContrastRating)(const UBKRuleThresholds *thresholds, double contrast);
+    bool (*isBelowMinimumTargetSize)(const UBKRuleThresholds *thresholds, double width, double height);
+} UBKRuleEvaluator;
+
+//Evaluator for a built in profile, NULL for UBKRuleProfileCustom
+const UBKRuleEvaluator *UBKRuleEvaluatorForProfile(UBKRuleProfileIdentifier profile);
+UBKRuleEvaluator UBKRuleEvaluatorMakeCustom(UBKRuleThresholds thresholds);
+
+static inline UBKRuleRating UBKRuleEvaluatorTextContrastRating(const UBKRuleEvaluator *evaluator, double contrast, double textSize, bool boldFont)
+{
+    return evaluator->textContrastRating(&evaluator->thresholds, contrast, textSize, boldFont);
+}
+
+static inline UBKRuleRating UBKRuleEvaluatorNonTextContrastRating(const UBKRuleEvaluator *evaluator, double contrast)
+{
+    return evaluator->nonTextContrastRating(&evaluator->thresholds, contrast);
+}
+
+static inline bool UBKRuleEvaluatorIsBelowMinimumTargetSize(const UBKRuleEvaluator *evaluator, double width, double height)
+{
+    return evaluator->isBelowMinimumTargetSize(&evaluator->thresholds, width, height);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKRuleProfile_h */
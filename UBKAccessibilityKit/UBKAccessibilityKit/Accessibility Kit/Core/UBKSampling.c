@@ -0,0 +1,216 @@
+/*
+ File: UBKSampling.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKSampling.h"
+
+//Weight of the newest value in the moving averages
+#define UBKSamplingAverageWeight 0.125
+
+UBKSamplingConfiguration UBKSamplingDefaultConfiguration(void)
+{
+    UBKSamplingConfiguration configuration;
+    configuration.sampleRate = 0.1;
+    configuration.budget = 0.005;
+    configuration.maximumCredit = 0.05;
+    configuration.slowFrameDuration = 0.025;
+    configuration.minimumBackoff = 2;
+    configuration.maximumBackoff = 120;
+    return configuration;
+}
+
+void UBKSamplingGovernorInit(UBKSamplingGovernor *governor, const UBKSamplingConfiguration *configuration, uint64_t seed, double now)
+{
+    *governor = (UBKSamplingGovernor){0};
+    governor->configuration = *configuration;
+    governor->lastUpdate = now;
+    //xorshift can't start from 0
+    governor->randomState = (seed != 0) ? seed : 0x9E3779B97F4A7C15ULL;
+}
+
+//xorshift64*, top 53 bits as a double in [0, 1)
+static double UBKSamplingRandom(UBKSamplingGovernor *governor)
+{
+    uint64_t x = governor->randomState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    governor->randomState = x;
+    return (double)((x * 0x2545F4914F6CDD1DULL) >> 11) / (double)(1ULL << 53);
+}
+
+static void UBKSamplingRefill(UBKSamplingGovernor *governor, double now)
+{
+    if (now > governor->lastUpdate)
+    {
+        governor->credit += (now - governor->lastUpdate) * governor->configuration.budget;
+        if (governor->credit > governor->configuration.maximumCredit)
+        {
+            governor->credit = governor->configuration.maximumCredit;
+        }
+        governor->lastUpdate = now;
+    }
+}
+
+UBKSamplingDecision UBKSamplingGovernorScreenDidAppear(UBKSamplingGovernor *governor, double now)
+{
+    governor->appearanceCount++;
+    UBKSamplingRefill(governor, now);
+    
+    UBKSamplingDecision decision;
+    //The random number is drawn for every appearance so the sampled appearances don't depend on the back offs
+    if (UBKSamplingRandom(governor) >= governor->configuration.sampleRate)
+    {
+        decision = UBKSamplingDecisionSkipRate;
+    }
+    else if (UBKSamplingGovernorIsBackingOff(governor, now))
+    {
+        decision = UBKSamplingDecisionSkipBackoff;
+    }
+    else if (governor->credit <= 0)
+    {
+        decision = UBKSamplingDecisionSkipBudget;
+    }
+    else
+    {
+        decision = UBKSamplingDecisionSample;
+    }
+    governor->decisionCounts[decision]++;
+    return decision;
+}
+
+bool UBKSamplingGovernorRecordFrame(UBKSamplingGovernor *governor, double frameDuration, double now)
+{
+    if (frameDuration <= 0)
+    {
+        return false;
+    }
+    if (governor->averageFrameDuration == 0)
+    {
+        governor->averageFrameDuration = frameDuration;
+    }
+    else
+    {
+        governor->averageFrameDuration += (frameDuration - governor->averageFrameDuration) * UBKSamplingAverageWeight;
+    }
+    
+    //A single dropped frame is only slow when it's well over, a run of slightly long frames shows in the average
+    double slowFrameDuration = governor->configuration.slowFrameDuration;
+    if ((frameDuration < slowFrameDuration * 2) && (governor->averageFrameDuration < slowFrameDuration))
+    {
+        return false;
+    }
+    if (UBKSamplingGovernorIsBackingOff(governor, now))
+    {
+        return false;
+    }
+    
+    const UBKSamplingConfiguration *configuration = &governor->configuration;
+    if ((governor->backoff > 0) && (now < governor->backoffUntil + governor->backoff))
+    {
+        governor->backoff *= 2;
+        if (governor->backoff > configuration->maximumBackoff)
+        {
+            governor->backoff = configuration->maximumBackoff;
+        }
+    }
+    else
+    {
+        governor->backoff = configuration->minimumBackoff;
+    }
+    governor->backoffUntil = now + governor->backoff;
+    //Start the next run with the frames after the back off
+    governor->averageFrameDuration = 0;
+    return true;
+}
+
+bool UBKSamplingGovernorIsBackingOff(const UBKSamplingGovernor *governor, double now)
+{
+    return now < governor->backoffUntil;
+}
+
+double UBKSamplingGovernorAvailableTime(UBKSamplingGovernor *governor, double now)
+{
+    UBKSamplingRefill(governor, now);
+    if ((UBKSamplingGovernorIsBackingOff(governor, now)) || (governor->credit <= 0))
+    {
+        return 0;
+    }
+    return governor->credit;
+}
+
+void UBKSamplingGovernorSpend(UBKSamplingGovernor *governor, double seconds)
+{
+    if (seconds > 0)
+    {
+        governor->credit -= seconds;
+        governor->spentTime += seconds;
+    }
+}
+
+double UBKSamplingGovernorEstimatedAuditCost(const UBKSamplingGovernor *governor, uint32_t nodeCount)
+{
+    return governor->auditCostPerNode * nodeCount;
+}
+
+bool UBKSamplingGovernorIsAuditTooExpensive(const UBKSamplingGovernor *governor, uint32_t nodeCount)
+{
+    return UBKSamplingGovernorEstimatedAuditCost(governor, nodeCount) > governor->configuration.maximumCredit;
+}
+
+bool UBKSamplingGovernorCanAudit(UBKSamplingGovernor *governor, uint32_t nodeCount, double now)
+{
+    if (UBKSamplingGovernorIsAuditTooExpensive(governor, nodeCount))
+    {
+        return false;
+    }
+    double available = UBKSamplingGovernorAvailableTime(governor, now);
+    return (available > 0) && (available >= UBKSamplingGovernorEstimatedAuditCost(governor, nodeCount));
+}
+
+void UBKSamplingGovernorRecordAudit(UBKSamplingGovernor *governor, uint32_t nodeCount, double seconds)
+{
+    UBKSamplingGovernorSpend(governor, seconds);
+    if ((nodeCount == 0) || (seconds <= 0))
+    {
+        return;
+    }
+    double costPerNode = seconds / nodeCount;
+    if (governor->auditCostPerNode == 0)
+    {
+        governor->auditCostPerNode = costPerNode;
+    }
+    else
+    {
+        governor->auditCostPerNode += (costPerNode - governor->auditCostPerNode) * UBKSamplingAverageWeight;
+    }
+}
+
+void UBKSamplingGovernorFinishSample(UBKSamplingGovernor *governor, bool completed)
+{
+    if (completed)
+    {
+        governor->completedCount++;
+    }
+    else
+    {
+        governor->abandonedCount++;
+    }
+}
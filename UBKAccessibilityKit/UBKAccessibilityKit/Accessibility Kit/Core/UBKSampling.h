@@ -0,0 +1,114 @@
+/*
+ File: UBKSampling.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKSampling_h
+#define UBKSampling_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Decides which screen appearances are audited when the kit runs without the inspector, eg in beta builds, and how much main thread time the audits may take.
+//Main thread time is a token bucket: credit builds up at budget seconds per second while idle, up to maximumCredit, and audit work is taken from it. Work can overdraw the credit, later audits wait until the debt is paid back, so over time audits never use more than the budget.
+//Slow frames start a back off, doubled each time frames are slow again soon after, so audits stay out of the way while the app is busy.
+
+typedef struct {
+    //Fraction of screen appearances audited, 0 to 1
+    double sampleRate;
+    //Fraction of main thread time audits may use, eg 0.005
+    double budget;
+    //Seconds of main thread time that can build up while idle
+    double maximumCredit;
+    //A frame this long, or an average frame this long, counts as slow
+    double slowFrameDuration;
+    //Length of the first back off, each back off that follows within its own length is twice as long
+    double minimumBackoff;
+    double maximumBackoff;
+} UBKSamplingConfiguration;
+
+typedef enum {
+    UBKSamplingDecisionSample,
+    //Not picked by the sample rate
+    UBKSamplingDecisionSkipRate,
+    //Frames have been slow
+    UBKSamplingDecisionSkipBackoff,
+    //Earlier audits used up the budget
+    UBKSamplingDecisionSkipBudget,
+    UBKSamplingDecisionCount
+} UBKSamplingDecision;
+
+typedef struct {
+    UBKSamplingConfiguration configuration;
+    //Seconds of main thread time that can be spent, negative while in debt
+    double credit;
+    double lastUpdate;
+    double backoff;
+    double backoffUntil;
+    //Moving average of the frame durations, 0 before the first frame
+    double averageFrameDuration;
+    //Moving average of the seconds an audit takes per node, 0 before the first audit
+    double auditCostPerNode;
+    uint64_t randomState;
+    
+    uint64_t appearanceCount;
+    uint64_t decisionCounts[UBKSamplingDecisionCount];
+    uint64_t completedCount;
+    uint64_t abandonedCount;
+    //Total main thread seconds spent
+    double spentTime;
+} UBKSamplingGovernor;
+
+//10% of screens, 0.5% of the main thread with up to 50ms saved up, frames over 25ms are slow, back offs from 2 seconds to 2 minutes
+UBKSamplingConfiguration UBKSamplingDefaultConfiguration(void);
+
+//Times are seconds on any monotonic clock. The credit starts empty so nothing is audited straight after launch. The seed picks the sampled appearances, pass the same seed to repeat them.
+void UBKSamplingGovernorInit(UBKSamplingGovernor *governor, const UBKSamplingConfiguration *configuration, uint64_t seed, double now);
+
+UBKSamplingDecision UBKSamplingGovernorScreenDidAppear(UBKSamplingGovernor *governor, double now);
+
+//Returns true if the frame started a back off
+bool UBKSamplingGovernorRecordFrame(UBKSamplingGovernor *governor, double frameDuration, double now);
+bool UBKSamplingGovernorIsBackingOff(const UBKSamplingGovernor *governor, double now);
+
+//Seconds of work that can be done now, 0 while backing off or in debt
+double UBKSamplingGovernorAvailableTime(UBKSamplingGovernor *governor, double now);
+void UBKSamplingGovernorSpend(UBKSamplingGovernor *governor, double seconds);
+
+//Estimated seconds to audit a walked hierarchy, 0 before the first audit has been measured
+double UBKSamplingGovernorEstimatedAuditCost(const UBKSamplingGovernor *governor, uint32_t nodeCount);
+//True for audits estimated over maximumCredit, the credit can never cover them so the sample should be given up
+bool UBKSamplingGovernorIsAuditTooExpensive(const UBKSamplingGovernor *governor, uint32_t nodeCount);
+//Audits can't be split, so one starts once the available time covers its estimate. Audits that are too expensive never start.
+bool UBKSamplingGovernorCanAudit(UBKSamplingGovernor *governor, uint32_t nodeCount, double now);
+//Spends the audit time and updates the estimate
+void UBKSamplingGovernorRecordAudit(UBKSamplingGovernor *governor, uint32_t nodeCount, double seconds);
+
+//Counts a sampled appearance as finished, or given up because the screen changed, frames got slow or it never fit the budget
+void UBKSamplingGovernorFinishSample(UBKSamplingGovernor *governor, bool completed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKSampling_h */
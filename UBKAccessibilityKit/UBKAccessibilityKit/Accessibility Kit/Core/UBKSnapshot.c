@@ -0,0 +1,182 @@
+/*
+ File: UBKSnapshot.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "UBKSnapshot.h"
+#include "UBKHash.h"
+
+#include <stdlib.h>
+
+void UBKSnapshotInit(UBKSnapshot *snapshot)
+{
+    UBKSnapshotInitWithArena(snapshot, NULL);
+}
+
+void UBKSnapshotInitWithArena(UBKSnapshot *snapshot, UBKArena *arena)
+{
+    snapshot->nodes = NULL;
+    snapshot->count = 0;
+    snapshot->capacity = 0;
+    snapshot->currentParent = -1;
+    snapshot->screenHash = 0;
+    snapshot->arena = arena;
+}
+
+void UBKSnapshotDestroy(UBKSnapshot *snapshot)
+{
+    if (snapshot->arena == NULL)
+    {
+        free(snapshot->nodes);
+    }
+    UBKSnapshotInitWithArena(snapshot, snapshot->arena);
+}
+
+void UBKSnapshotReset(UBKSnapshot *snapshot)
+{
+    snapshot->count = 0;
+    snapshot->currentParent = -1;
+    snapshot->screenHash = 0;
+}
+
+static bool UBKSnapshotReserve(UBKSnapshot *snapshot, uint32_t count)
+{
+    if (count <= snapshot->capacity)
+    {
+        return true;
+    }
+    uint32_t capacity = (snapshot->capacity == 0) ? 256 : snapshot->capacity * 2;
+    while (capacity < count)
+    {
+        capacity *= 2;
+    }
+    UBKSnapshotNode *nodes;
+    if (snapshot->arena != NULL)
+    {
+        nodes = UBKArenaResize(snapshot->arena, snapshot->nodes, snapshot->capacity * sizeof(UBKSnapshotNode), capacity * sizeof(UBKSnapshotNode));
+    }
+    else
+    {
+        nodes = realloc(snapshot->nodes, capacity * sizeof(UBKSnapshotNode));
+    }
+    if (nodes == NULL)
+    {
+        return false;
+    }
+    snapshot->nodes = nodes;
+    snapshot->capacity = capacity;
+    return true;
+}
+
+int32_t UBKSnapshotPushNode(UBKSnapshot *snapshot, const UBKSnapshotNode *node)
+{
+    if (!UBKSnapshotReserve(snapshot, snapshot->count + 1))
+    {
+        return -1;
+    }
+    int32_t index = (int32_t)snapshot->count;
+    UBKSnapshotNode *newNode = &snapshot->nodes[index];
+    *newNode = *node;
+    newNode->parent = snapshot->currentParent;
+    newNode->depth = (snapshot->currentParent < 0) ? 0 : snapshot->nodes[snapshot->currentParent].depth + 1;
+    newNode->subtreeEnd = (uint32_t)index + 1;
+    newNode->subtreeHash = node->nodeHash;
+    snapshot->count++;
+    snapshot->currentParent = index;
+    return index;
+}
+
+void UBKSnapshotPopNode(UBKSnapshot *snapshot)
+{
+    if (snapshot->currentParent < 0)
+    {
+        return;
+    }
+    UBKSnapshotNode *node = &snapshot->nodes[snapshot->currentParent];
+    node->subtreeEnd = snapshot->count;
+    snapshot->currentParent = node->parent;
+    
+    //Children are folded in order, so reordering siblings changes the parent hash.
+    if (node->parent >= 0)
+    {
+        UBKSnapshotNode *parent = &snapshot->nodes[node->parent];
+        parent->subtreeHash = UBKHashCombine(parent->subtreeHash, node->subtreeHash);
+    }
+}
+
+void UBKSnapshotCombineNodeHash(UBKSnapshot *snapshot, uint32_t index, uint64_t value)
+{
+    if (index < snapshot->count)
+    {
+        snapshot->nodes[index].nodeHash = UBKHashCombine(snapshot->nodes[index].nodeHash, value);
+        snapshot->nodes[index].structureHash = UBKHashCombine(snapshot->nodes[index].structureHash, value);
+    }
+}
+
+void UBKSnapshotClearNodeFlags(UBKSnapshot *snapshot, uint32_t index, uint32_t flags)
+{
+    if (index < snapshot->count)
+    {
+        snapshot->nodes[index].flags &= ~flags;
+    }
+}
+
+void UBKSnapshotUpdateSubtreeHashes(UBKSnapshot *snapshot)
+{
+    //Children always come after their parent, so walking backwards finishes every child first
+    for (uint32_t i = snapshot->count; i > 0; i--)
+    {
+        UBKSnapshotNode *node = &snapshot->nodes[i - 1];
+        node->subtreeHash = node->nodeHash;
+        for (uint32_t child = i; child < node->subtreeEnd; child = snapshot->nodes[child].subtreeEnd)
+        {
+            node->subtreeHash = UBKHashCombine(node->subtreeHash, snapshot->nodes[child].subtreeHash);
+        }
+    }
+}
+
+uint64_t UBKSnapshotFingerprint(const UBKSnapshot *snapshot)
+{
+    uint64_t hash = UBKHashCombine(UBKHashInitialValue, snapshot->screenHash);
+    for (uint32_t i = 0; i < snapshot->count; i++)
+    {
+        const UBKSnapshotNode *node = &snapshot->nodes[i];
+        hash = UBKHashCombine(hash, node->depth);
+        hash = UBKHashCombine(hash, node->classHash);
+        hash = UBKHashCombine(hash, node->identifierHash);
+    }
+    return hash;
+}
+
+void UBKSnapshotElementKeys(const UBKSnapshot *snapshot, uint64_t *keys)
+{
+    for (uint32_t i = 0; i < snapshot->count; i++)
+    {
+        const UBKSnapshotNode *node = &snapshot->nodes[i];
+        if (node->identifierHash != UBKHashInitialValue)
+        {
+            keys[i] = UBKHashCombine(UBKHashCombine(UBKHashInitialValue, node->classHash), node->identifierHash);
+        }
+        else
+        {
+            //Parents come before their children
+            uint64_t parentKey = (node->parent < 0) ? UBKHashInitialValue : keys[node->parent];
+            keys[i] = UBKHashCombine(parentKey, node->classHash);
+        }
+    }
+}
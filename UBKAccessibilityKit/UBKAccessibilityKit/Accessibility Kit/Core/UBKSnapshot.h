@@ -0,0 +1,124 @@
+/*
+ File: UBKSnapshot.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef UBKSnapshot_h
+#define UBKSnapshot_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "UBKArena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//A flat, pre-order copy of the parts of the view hierarchy the audits care about. Nodes are appended while walking the window and are plain C so the screen level passes can run on them without touching UIKit.
+
+typedef struct {
+    double x;
+    double y;
+    double width;
+    double height;
+} UBKRect;
+
+typedef enum {
+    //The view is in the elements list and is audited
+    UBKSnapshotNodeFlagElement = 1 << 0,
+    UBKSnapshotNodeFlagUserInteractionEnabled = 1 << 1,
+    //hidden or alpha of 0
+    UBKSnapshotNodeFlagHidden = 1 << 2,
+    //Fully covers the views behind its frame, ie a solid background, no transparency, rounded corners or rotation
+    UBKSnapshotNodeFlagOpaque = 1 << 3,
+    UBKSnapshotNodeFlagClipsToBounds = 1 << 4,
+    UBKSnapshotNodeFlagAccessibilityElement = 1 << 5,
+    //shouldGroupAccessibilityChildren, VoiceOver reads the children before moving on
+    UBKSnapshotNodeFlagGroupsAccessibilityChildren = 1 << 6,
+    //alpha below 1, the views behind show through the node and its descendants
+    UBKSnapshotNodeFlagTranslucent = 1 << 7
+} UBKSnapshotNodeFlags;
+
+typedef struct {
+    //Index of the parent node, -1 for the top level views of the window
+    int32_t parent;
+    uint32_t depth;
+    //Index after the last descendant, the subtree of a node is [index, subtreeEnd)
+    uint32_t subtreeEnd;
+    uint32_t flags;
+    uint64_t classHash;
+    uint64_t identifierHash;
+    //Hash of the effective background colour, the first ancestor (or the node itself) with a background
+    uint64_t backgroundHash;
+    //Hash of the audited properties of the node, including its effective background
+    uint64_t nodeHash;
+    //Merkle hash of the node and its descendants, complete once the node has been popped
+    uint64_t subtreeHash;
+    //Like nodeHash but without content such as text and position, nodes with the same structure hash get the same warnings, see UBKSubtreeGroups.h
+    uint64_t structureHash;
+    //Frame in window space
+    UBKRect frame;
+} UBKSnapshotNode;
+
+typedef struct {
+    UBKSnapshotNode *nodes;
+    uint32_t count;
+    uint32_t capacity;
+    //Index of the node new nodes are added under, -1 at the top level
+    int32_t currentParent;
+    //Hash of the visible view controller path
+    uint64_t screenHash;
+    //Nodes are allocated from the arena when set, otherwise with malloc
+    UBKArena *arena;
+} UBKSnapshot;
+
+void UBKSnapshotInit(UBKSnapshot *snapshot);
+//The nodes live in the arena, the snapshot can't be used after the arena is reset
+void UBKSnapshotInitWithArena(UBKSnapshot *snapshot, UBKArena *arena);
+void UBKSnapshotDestroy(UBKSnapshot *snapshot);
+
+//Removes all nodes but keeps the allocated storage
+void UBKSnapshotReset(UBKSnapshot *snapshot);
+
+//Appends a node as a child of the current parent and makes it the current parent. parent, depth, subtreeEnd and subtreeHash are filled in. Returns the node index or -1 if the snapshot couldn't grow.
+int32_t UBKSnapshotPushNode(UBKSnapshot *snapshot, const UBKSnapshotNode *node);
+
+//Closes the current parent node, its subtree is complete. The node's subtree hash is folded into its parent's.
+void UBKSnapshotPopNode(UBKSnapshot *snapshot);
+
+//Mixes a value worked out after the walk, eg a screen level result, into the node and structure hashes of a node. Call UBKSnapshotUpdateSubtreeHashes once every value has been added.
+void UBKSnapshotCombineNodeHash(UBKSnapshot *snapshot, uint32_t index, uint64_t value);
+
+//Removes flags worked out after the walk, eg the element flag from a node that isn't visible. The node hash isn't changed, combine a value for the reason.
+void UBKSnapshotClearNodeFlags(UBKSnapshot *snapshot, uint32_t index, uint32_t flags);
+
+//Rebuilds every subtree hash from the node hashes, folding children in the same order as UBKSnapshotPopNode.
+void UBKSnapshotUpdateSubtreeHashes(UBKSnapshot *snapshot);
+
+//Screen fingerprint built from the screen hash and, for each node, its depth, class and identifier. Frames, text and visibility are left out so a screen keeps its fingerprint while its content updates.
+uint64_t UBKSnapshotFingerprint(const UBKSnapshot *snapshot);
+
+//Fills keys, one per node, with a key that finds the same element in other snapshots and builds. Nodes with an accessibility identifier are keyed by their class and identifier, other nodes by their class and the key of their parent. Nodes can share a key, eg table cells, use their frames to tell them apart.
+void UBKSnapshotElementKeys(const UBKSnapshot *snapshot, uint64_t *keys);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKSnapshot_h */
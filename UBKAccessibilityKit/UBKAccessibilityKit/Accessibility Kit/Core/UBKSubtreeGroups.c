@@ -0,0 +1,136 @@
+/*
+ File: UBKSubtreeGroups.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "UBKSubtreeGroups.h"
+#include "UBKHash.h"
+
+#include <stdlib.h>
+
+int64_t UBKSubtreeGroupsFind(const UBKSnapshotNode *nodes, uint32_t count, UBKSubtreeGroup *groups)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        groups[i].representative = (int32_t)i;
+        groups[i].repeatCount = 1;
+    }
+    if (count < 2)
+    {
+        return 0;
+    }
+    
+    //Structure of each subtree, built bottom up the same way as UBKSnapshotUpdateSubtreeHashes
+    uint64_t *subtreeHashes = malloc(count * sizeof(uint64_t));
+    //Open addressing map of parent and subtree structure to the first subtree seen
+    size_t capacity = 16;
+    while (capacity < (size_t)count * 2)
+    {
+        capacity *= 2;
+    }
+    uint64_t *keys = malloc(capacity * sizeof(uint64_t));
+    int32_t *firstIndexes = malloc(capacity * sizeof(int32_t));
+    //The representative subtree of each group root, -1 for the other nodes
+    int32_t *matches = malloc(count * sizeof(int32_t));
+    if ((subtreeHashes == NULL) || (keys == NULL) || (firstIndexes == NULL) || (matches == NULL))
+    {
+        free(subtreeHashes);
+        free(keys);
+        free(firstIndexes);
+        free(matches);
+        return -1;
+    }
+    size_t mask = capacity - 1;
+    
+    for (uint32_t i = count; i > 0; i--)
+    {
+        const UBKSnapshotNode *node = &nodes[i - 1];
+        uint64_t hash = UBKHashCombine(UBKHashCombine(node->structureHash, node->flags), node->subtreeEnd - (i - 1));
+        for (uint32_t child = i; child < node->subtreeEnd; child = nodes[child].subtreeEnd)
+        {
+            hash = UBKHashCombine(hash, subtreeHashes[child]);
+        }
+        subtreeHashes[i - 1] = hash;
+    }
+    
+    for (size_t slot = 0; slot < capacity; slot++)
+    {
+        firstIndexes[slot] = -1;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        matches[i] = -1;
+        //Siblings only, keyed by the parent as well
+        uint64_t key = UBKHashCombine(subtreeHashes[i], (uint64_t)(nodes[i].parent + 1));
+        size_t slot = (size_t)key & mask;
+        while ((firstIndexes[slot] >= 0) && (keys[slot] != key))
+        {
+            slot = (slot + 1) & mask;
+        }
+        if (firstIndexes[slot] < 0)
+        {
+            keys[slot] = key;
+            firstIndexes[slot] = (int32_t)i;
+            continue;
+        }
+        
+        //Hashes can collide, check the subtrees really match node for node
+        int32_t first = firstIndexes[slot];
+        uint32_t length = nodes[i].subtreeEnd - i;
+        bool isMatch = (nodes[first].parent == nodes[i].parent) && (nodes[first].subtreeEnd - (uint32_t)first == length);
+        for (uint32_t k = 0; (isMatch) && (k < length); k++)
+        {
+            const UBKSnapshotNode *a = &nodes[(uint32_t)first + k];
+            const UBKSnapshotNode *b = &nodes[i + k];
+            isMatch = (a->structureHash == b->structureHash) && (a->flags == b->flags) && (a->subtreeEnd - ((uint32_t)first + k) == b->subtreeEnd - (i + k));
+        }
+        if (isMatch)
+        {
+            matches[i] = first;
+        }
+    }
+    
+    //Representatives come before the subtrees that share them, so their nested groups are already worked out
+    int64_t sharedCount = 0;
+    uint32_t index = 0;
+    while (index < count)
+    {
+        if (matches[index] < 0)
+        {
+            index++;
+            continue;
+        }
+        uint32_t first = (uint32_t)matches[index];
+        uint32_t length = nodes[index].subtreeEnd - index;
+        for (uint32_t k = 0; k < length; k++)
+        {
+            int32_t representative = groups[first + k].representative;
+            groups[index + k].representative = representative;
+            groups[index + k].repeatCount = 0;
+            groups[representative].repeatCount++;
+        }
+        sharedCount += length;
+        index += length;
+    }
+    
+    free(subtreeHashes);
+    free(keys);
+    free(firstIndexes);
+    free(matches);
+    return sharedCount;
+}
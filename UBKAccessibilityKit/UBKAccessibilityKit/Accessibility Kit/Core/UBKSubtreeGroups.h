@@ -0,0 +1,50 @@
+/*
+ File: UBKSubtreeGroups.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef UBKSubtreeGroups_h
+#define UBKSubtreeGroups_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "UBKSnapshot.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Groups sibling subtrees with the same structure, eg the visible cells of a table. The first subtree of each group is its representative, only the representative is audited and the other subtrees share its warnings.
+//Two sibling subtrees have the same structure when they have the same number of nodes and each pair of nodes has the same structure hash and flags.
+
+typedef struct {
+    //Index of the node whose results this node shares, the node itself when it isn't part of a repeated subtree
+    int32_t representative;
+    //For a representative, how many nodes share its results, including itself. 0 for the other nodes of a group.
+    uint32_t repeatCount;
+} UBKSubtreeGroup;
+
+//Fills groups, one per snapshot node. Subtrees nested in a repeated subtree share the results of the matching node in the representative, so a cell's repeated icons are grouped once. Returns the number of nodes that share another node's results, or -1 if the working memory couldn't be allocated, in which case every node is its own representative.
+int64_t UBKSubtreeGroupsFind(const UBKSnapshotNode *nodes, uint32_t count, UBKSubtreeGroup *groups);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKSubtreeGroups_h */
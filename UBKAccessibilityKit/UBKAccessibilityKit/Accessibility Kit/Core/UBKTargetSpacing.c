@@ -0,0 +1,238 @@
+/*
+ File: UBKTargetSpacing.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKTargetSpacing.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+//Expired targets left in the active list are only swept out once it has grown past this size.
+#define UBKTargetSpacingMinimumCompactCount 64
+
+typedef struct {
+    double minX;
+    uint32_t target;
+} UBKTargetEvent;
+
+static int UBKTargetEventCompare(const void *first, const void *second)
+{
+    double firstX = ((const UBKTargetEvent *)first)->minX;
+    double secondX = ((const UBKTargetEvent *)second)->minX;
+    return (firstX > secondX) - (firstX < secondX);
+}
+
+static inline double UBKTargetSpacingMax(double first, double second)
+{
+    return first > second ? first : second;
+}
+
+static bool UBKTargetIsUndersized(const UBKRect *frame, double spacing)
+{
+    return (frame->width < spacing) || (frame->height < spacing);
+}
+
+static bool UBKTargetsOverlap(const UBKRect *first, const UBKRect *second)
+{
+    //Touching edges don't overlap
+    return (first->x < second->x + second->width) && (second->x < first->x + first->width) && (first->y < second->y + second->height) && (second->y < first->y + first->height);
+}
+
+static double UBKTargetGap(const UBKRect *first, const UBKRect *second)
+{
+    double dx = UBKTargetSpacingMax(0, UBKTargetSpacingMax(first->x - (second->x + second->width), second->x - (first->x + first->width)));
+    double dy = UBKTargetSpacingMax(0, UBKTargetSpacingMax(first->y - (second->y + second->height), second->y - (first->y + first->height)));
+    return sqrt((dx * dx) + (dy * dy));
+}
+
+static double UBKTargetCentreDistance(const UBKRect *frame, double x, double y)
+{
+    double dx = UBKTargetSpacingMax(0, UBKTargetSpacingMax(frame->x - x, x - (frame->x + frame->width)));
+    double dy = UBKTargetSpacingMax(0, UBKTargetSpacingMax(frame->y - y, y - (frame->y + frame->height)));
+    return sqrt((dx * dx) + (dy * dy));
+}
+
+static bool UBKTargetsAreNested(const UBKTarget *first, const UBKTarget *second)
+{
+    return ((second->index >= first->index) && (second->index < first->subtreeEnd)) || ((first->index >= second->index) && (first->index < second->subtreeEnd));
+}
+
+static void UBKTargetSpacingRecord(UBKTargetSpacingResult *result, uint32_t flags, uint32_t conflict, double distance)
+{
+    result->flags |= flags;
+    if ((result->conflict < 0) || (distance < result->distance))
+    {
+        result->conflict = (int32_t)conflict;
+        result->distance = distance;
+    }
+}
+
+static void UBKTargetSpacingCompare(const UBKTarget *targets, uint32_t first, uint32_t second, double spacing, UBKTargetSpacingResult *results)
+{
+    if (UBKTargetsAreNested(&targets[first], &targets[second]))
+    {
+        return;
+    }
+    
+    const UBKRect *firstFrame = &targets[first].frame;
+    const UBKRect *secondFrame = &targets[second].frame;
+    uint32_t flags = 0;
+    double distance = 0;
+    
+    if (UBKTargetsOverlap(firstFrame, secondFrame))
+    {
+        flags = UBKTargetSpacingFlagOverlap;
+    }
+    else
+    {
+        double radius = spacing / 2;
+        double firstX = firstFrame->x + (firstFrame->width / 2);
+        double firstY = firstFrame->y + (firstFrame->height / 2);
+        double secondX = secondFrame->x + (secondFrame->width / 2);
+        double secondY = secondFrame->y + (secondFrame->height / 2);
+        bool firstUndersized = UBKTargetIsUndersized(firstFrame, spacing);
+        bool secondUndersized = UBKTargetIsUndersized(secondFrame, spacing);
+        
+        if ((firstUndersized) && (UBKTargetCentreDistance(secondFrame, firstX, firstY) < radius))
+        {
+            flags = UBKTargetSpacingFlagTooClose;
+        }
+        else if ((secondUndersized) && (UBKTargetCentreDistance(firstFrame, secondX, secondY) < radius))
+        {
+            flags = UBKTargetSpacingFlagTooClose;
+        }
+        else if ((firstUndersized) && (secondUndersized) && (hypot(firstX - secondX, firstY - secondY) < spacing))
+        {
+            flags = UBKTargetSpacingFlagTooClose;
+        }
+        distance = UBKTargetGap(firstFrame, secondFrame);
+    }
+    
+    if (flags != 0)
+    {
+        UBKTargetSpacingRecord(&results[first], flags, second, distance);
+        UBKTargetSpacingRecord(&results[second], flags, first, distance);
+    }
+}
+
+//First position in the active list with a top edge at or below y.
+static size_t UBKTargetSpacingLowerBound(const UBKTarget *targets, const uint32_t *active, size_t activeCount, double y)
+{
+    size_t low = 0;
+    size_t high = activeCount;
+    while (low < high)
+    {
+        size_t middle = low + ((high - low) / 2);
+        if (targets[active[middle]].frame.y < y)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+bool UBKTargetSpacingAnalyse(const UBKTarget *targets, size_t count, double spacing, UBKTargetSpacingResult *results)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        results[i].flags = 0;
+        results[i].conflict = -1;
+        results[i].distance = 0;
+    }
+    if (count < 2)
+    {
+        return true;
+    }
+    
+    UBKTargetEvent *events = malloc(count * sizeof(UBKTargetEvent));
+    uint32_t *active = malloc(count * sizeof(uint32_t));
+    if ((events == NULL) || (active == NULL))
+    {
+        free(events);
+        free(active);
+        return false;
+    }
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        events[i].minX = targets[i].frame.x;
+        events[i].target = (uint32_t)i;
+    }
+    qsort(events, count, sizeof(UBKTargetEvent), UBKTargetEventCompare);
+    
+    //Targets that could still be within the spacing of the sweep line, ordered by their top edge
+    size_t activeCount = 0;
+    size_t compactCount = UBKTargetSpacingMinimumCompactCount;
+    double maximumHeight = 0;
+    
+    for (size_t e = 0; e < count; e++)
+    {
+        uint32_t current = events[e].target;
+        const UBKRect *frame = &targets[current].frame;
+        
+        //Drop everything the sweep line has moved past
+        if (activeCount >= compactCount)
+        {
+            size_t kept = 0;
+            for (size_t k = 0; k < activeCount; k++)
+            {
+                const UBKRect *activeFrame = &targets[active[k]].frame;
+                if (activeFrame->x + activeFrame->width + spacing >= frame->x)
+                {
+                    active[kept++] = active[k];
+                }
+            }
+            activeCount = kept;
+            compactCount = activeCount * 2 > UBKTargetSpacingMinimumCompactCount ? activeCount * 2 : UBKTargetSpacingMinimumCompactCount;
+        }
+        
+        //Anything that starts above this band is too far away vertically
+        double top = frame->y - spacing - maximumHeight;
+        double bottom = frame->y + frame->height + spacing;
+        size_t k = UBKTargetSpacingLowerBound(targets, active, activeCount, top);
+        while ((k < activeCount) && (targets[active[k]].frame.y <= bottom))
+        {
+            const UBKRect *activeFrame = &targets[active[k]].frame;
+            if (activeFrame->x + activeFrame->width + spacing < frame->x)
+            {
+                memmove(&active[k], &active[k + 1], (activeCount - k - 1) * sizeof(uint32_t));
+                activeCount--;
+                continue;
+            }
+            UBKTargetSpacingCompare(targets, current, active[k], spacing, results);
+            k++;
+        }
+        
+        size_t position = UBKTargetSpacingLowerBound(targets, active, activeCount, frame->y);
+        memmove(&active[position + 1], &active[position], (activeCount - position) * sizeof(uint32_t));
+        active[position] = current;
+        activeCount++;
+        maximumHeight = UBKTargetSpacingMax(maximumHeight, frame->height);
+    }
+    
+    free(events);
+    free(active);
+    return true;
+}
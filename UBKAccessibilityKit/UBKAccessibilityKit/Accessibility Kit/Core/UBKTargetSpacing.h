@@ -0,0 +1,65 @@
+/*
+ File: UBKTargetSpacing.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKTargetSpacing_h
+#define UBKTargetSpacing_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "UBKSnapshot.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Screen level touch target check, following WCAG 2.2 2.5.8 target size (minimum). A target smaller than the spacing in either direction gets a circle of that diameter on its centre, the circle can't reach another target or the circle of another undersized target. Overlapping targets are always reported.
+
+typedef struct {
+    //Frame in window space
+    UBKRect frame;
+    //Snapshot range of the target, [index, subtreeEnd). Targets nested inside each other, eg a button in a tappable cell, aren't compared.
+    uint32_t index;
+    uint32_t subtreeEnd;
+} UBKTarget;
+
+typedef enum {
+    UBKTargetSpacingFlagOverlap = 1 << 0,
+    UBKTargetSpacingFlagTooClose = 1 << 1
+} UBKTargetSpacingFlags;
+
+typedef struct {
+    uint32_t flags;
+    //Index into the targets of the nearest conflicting target, -1 if there isn't one
+    int32_t conflict;
+    //Gap between the frames of the target and the conflicting target, 0 when they overlap
+    double distance;
+} UBKTargetSpacingResult;
+
+//Sweeps the targets left to right keeping the targets still in reach ordered by y, so only neighbours are compared. O(n log n) for screens without very tall targets. Results must hold count values. Returns false if the working memory couldn't be allocated.
+bool UBKTargetSpacingAnalyse(const UBKTarget *targets, size_t count, double spacing, UBKTargetSpacingResult *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKTargetSpacing_h */
@@ -0,0 +1,147 @@
+/*
+ File: UBKTextRuns.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKTextRuns.h"
+
+#include <stdlib.h>
+
+void UBKTextRunTableInit(UBKTextRunTable *table)
+{
+    table->runs = NULL;
+    table->count = 0;
+    table->capacity = 0;
+}
+
+void UBKTextRunTableDestroy(UBKTextRunTable *table)
+{
+    free(table->runs);
+    UBKTextRunTableInit(table);
+}
+
+void UBKTextRunTableReset(UBKTextRunTable *table)
+{
+    table->count = 0;
+}
+
+static bool UBKTextRunTableReserve(UBKTextRunTable *table, uint32_t count)
+{
+    if (count <= table->capacity)
+    {
+        return true;
+    }
+    //Most text is a single run
+    uint32_t capacity = (table->capacity == 0) ? 4 : table->capacity * 2;
+    while (capacity < count)
+    {
+        capacity *= 2;
+    }
+    UBKTextRun *runs = realloc(table->runs, capacity * sizeof(UBKTextRun));
+    if (runs == NULL)
+    {
+        return false;
+    }
+    table->runs = runs;
+    table->capacity = capacity;
+    return true;
+}
+
+bool UBKTextRunTableAppend(UBKTextRunTable *table, uint32_t location, uint32_t length, UBKColourValue foreground, UBKColourValue background, double textSize, bool boldFont)
+{
+    if (table->count > 0)
+    {
+        UBKTextRun *last = &table->runs[table->count - 1];
+        if ((last->location + last->length <= location) && (last->foreground.hasComponents == foreground.hasComponents) && (UBKColourValueEqual(last->foreground, foreground)) && (last->background.hasComponents == background.hasComponents) && (UBKColourValueEqual(last->background, background)) && (last->textSize == textSize) && (last->boldFont == boldFont))
+        {
+            last->length = location + length - last->location;
+            return true;
+        }
+    }
+    if (!UBKTextRunTableReserve(table, table->count + 1))
+    {
+        return false;
+    }
+    UBKTextRun *run = &table->runs[table->count];
+    run->location = location;
+    run->length = length;
+    run->foreground = foreground;
+    run->background = background;
+    run->textSize = textSize;
+    run->boldFont = boldFont;
+    run->effectiveForeground = foreground;
+    run->effectiveBackground = background;
+    run->contrast = 0;
+    run->rating = UBKRuleRatingNA;
+    table->count++;
+    return true;
+}
+
+//Fail first, then the AA ratings, then the AAA ratings
+static int UBKTextRunRatingRank(UBKRuleRating rating)
+{
+    switch (rating)
+    {
+        case UBKRuleRatingFail:
+            return 0;
+        case UBKRuleRatingAA:
+        case UBKRuleRatingAALarge:
+            return 1;
+        case UBKRuleRatingAAA:
+        case UBKRuleRatingAAALarge:
+            return 2;
+        case UBKRuleRatingNA:
+            break;
+    }
+    return 3;
+}
+
+int32_t UBKTextRunTableEvaluate(UBKTextRunTable *table, UBKColourValue viewBackground, float opacity, const UBKRuleEvaluator *evaluator)
+{
+    int32_t worst = -1;
+    for (uint32_t i = 0; i < table->count; i++)
+    {
+        UBKTextRun *run = &table->runs[i];
+        run->effectiveBackground = UBKColourValueComposite(run->background, opacity, viewBackground);
+        run->effectiveForeground = (run->foreground.hasComponents) ? UBKColourValueComposite(run->foreground, opacity, run->effectiveBackground) : run->foreground;
+        if ((run->foreground.hasComponents) && (run->effectiveBackground.hasComponents))
+        {
+            run->contrast = UBKColourValueContrastRatio(run->effectiveForeground, run->effectiveBackground);
+        }
+        else
+        {
+            run->contrast = 0;
+        }
+        run->rating = UBKRuleEvaluatorTextContrastRating(evaluator, run->contrast, run->textSize, run->boldFont);
+        
+        if (worst < 0)
+        {
+            worst = (int32_t)i;
+            continue;
+        }
+        const UBKTextRun *worstRun = &table->runs[worst];
+        int rank = UBKTextRunRatingRank(run->rating);
+        int worstRank = UBKTextRunRatingRank(worstRun->rating);
+        if ((rank < worstRank) || ((rank == worstRank) && (run->contrast < worstRun->contrast)))
+        {
+            worst = (int32_t)i;
+        }
+    }
+    return worst;
+}
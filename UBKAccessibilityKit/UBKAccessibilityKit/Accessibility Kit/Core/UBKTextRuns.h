@@ -0,0 +1,75 @@
+/*
+ File: UBKTextRuns.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKTextRuns_h
+#define UBKTextRuns_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "UBKColourValue.h"
+#include "UBKRuleProfile.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Attribute runs of a control's text, eg an attributed label with a grey footnote in a smaller font. Every run is checked for contrast on its own and the worst run is reported for the control.
+
+typedef struct {
+    //Character range of the run in the text
+    uint32_t location;
+    uint32_t length;
+    //Text colour and the run's own background colour as set. The background has no components when the run doesn't set one.
+    UBKColourValue foreground;
+    UBKColourValue background;
+    double textSize;
+    bool boldFont;
+    //Filled in by UBKTextRunTableEvaluate, the colours seen once composited with their contrast ratio and rating
+    UBKColourValue effectiveForeground;
+    UBKColourValue effectiveBackground;
+    double contrast;
+    UBKRuleRating rating;
+} UBKTextRun;
+
+typedef struct {
+    UBKTextRun *runs;
+    uint32_t count;
+    uint32_t capacity;
+} UBKTextRunTable;
+
+void UBKTextRunTableInit(UBKTextRunTable *table);
+void UBKTextRunTableDestroy(UBKTextRunTable *table);
+
+//Removes all runs but keeps the allocated storage
+void UBKTextRunTableReset(UBKTextRunTable *table);
+
+//Appends a run, or extends the last run over this one when they're drawn the same way, taking in any text skipped between them, eg whitespace. The table only holds runs that can rate differently. Runs must be appended in order. Returns false if the table couldn't grow.
+bool UBKTextRunTableAppend(UBKTextRunTable *table, uint32_t location, uint32_t length, UBKColourValue foreground, UBKColourValue background, double textSize, bool boldFont);
+
+//Rates every run in one pass. Each run's background is composited over viewBackground and its text over that, both with the view's opacity. Colours without components, eg patterns, have a contrast of 0. Returns the index of the worst run, the lowest rating and then the lowest contrast, or -1 when the table is empty.
+int32_t UBKTextRunTableEvaluate(UBKTextRunTable *table, UBKColourValue viewBackground, float opacity, const UBKRuleEvaluator *evaluator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKTextRuns_h */
@@ -0,0 +1,256 @@
+/*
+ File: UBKVisibility.c
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#include "UBKVisibility.h"
+
+#include <stdlib.h>
+
+//Fragments are split by every occluder that cuts into them. Past this many the node is left visible rather than doing unbounded work.
+#define UBKVisibilityMaximumFragments 64
+
+//Less than this much area left counts as fully covered, it absorbs rounding in converted frames
+#define UBKVisibilityMinimumArea 0.5
+
+typedef struct {
+    double minX;
+    double minY;
+    double maxX;
+    double maxY;
+} UBKVisibilityBox;
+
+typedef struct {
+    UBKVisibilityBox box;
+    //Occluders only cover nodes before them in pre-order
+    uint32_t index;
+} UBKVisibilityOccluder;
+
+static UBKVisibilityBox UBKVisibilityBoxFromRect(UBKRect rect)
+{
+    UBKVisibilityBox box = { rect.x, rect.y, rect.x + rect.width, rect.y + rect.height };
+    return box;
+}
+
+static UBKVisibilityBox UBKVisibilityBoxIntersect(UBKVisibilityBox first, UBKVisibilityBox second)
+{
+    UBKVisibilityBox box;
+    box.minX = first.minX > second.minX ? first.minX : second.minX;
+    box.minY = first.minY > second.minY ? first.minY : second.minY;
+    box.maxX = first.maxX < second.maxX ? first.maxX : second.maxX;
+    box.maxY = first.maxY < second.maxY ? first.maxY : second.maxY;
+    return box;
+}
+
+static bool UBKVisibilityBoxIsEmpty(UBKVisibilityBox box)
+{
+    return (box.maxX <= box.minX) || (box.maxY <= box.minY);
+}
+
+static double UBKVisibilityBoxArea(UBKVisibilityBox box)
+{
+    return UBKVisibilityBoxIsEmpty(box) ? 0 : (box.maxX - box.minX) * (box.maxY - box.minY);
+}
+
+//Replaces the fragment at index with the parts of it outside cover, at most four. Returns the new fragment count, or 0 with *overflow set if there wasn't room.
+static size_t UBKVisibilitySubtract(UBKVisibilityBox *fragments, size_t count, size_t index, UBKVisibilityBox cover, bool *overflow)
+{
+    UBKVisibilityBox fragment = fragments[index];
+    UBKVisibilityBox overlap = UBKVisibilityBoxIntersect(fragment, cover);
+    if (UBKVisibilityBoxIsEmpty(overlap))
+    {
+        return count;
+    }
+    
+    UBKVisibilityBox pieces[4];
+    size_t pieceCount = 0;
+    //Full width bands above and below the overlap, then the sides between them
+    if (overlap.minY > fragment.minY)
+    {
+        pieces[pieceCount++] = (UBKVisibilityBox){ fragment.minX, fragment.minY, fragment.maxX, overlap.minY };
+    }
+    if (overlap.maxY < fragment.maxY)
+    {
+        pieces[pieceCount++] = (UBKVisibilityBox){ fragment.minX, overlap.maxY, fragment.maxX, fragment.maxY };
+    }
+    if (overlap.minX > fragment.minX)
+    {
+        pieces[pieceCount++] = (UBKVisibilityBox){ fragment.minX, overlap.minY, overlap.minX, overlap.maxY };
+    }
+    if (overlap.maxX < fragment.maxX)
+    {
+        pieces[pieceCount++] = (UBKVisibilityBox){ overlap.maxX, overlap.minY, fragment.maxX, overlap.maxY };
+    }
+    
+    if (count - 1 + pieceCount > UBKVisibilityMaximumFragments)
+    {
+        *overflow = true;
+        return 0;
+    }
+    
+    //The last fragment fills the hole, the pieces go on the end. Pieces are disjoint so the fragments stay disjoint.
+    count--;
+    fragments[index] = fragments[count];
+    for (size_t i = 0; i < pieceCount; i++)
+    {
+        fragments[count++] = pieces[i];
+    }
+    return count;
+}
+
+//Area of box left after subtracting the occluders, from first onwards. Returns -1 if it needed too many fragments.
+static double UBKVisibilityUncoveredArea(UBKVisibilityBox box, const UBKVisibilityOccluder *occluders, size_t first, size_t occluderCount, UBKVisibilityBox *fragments)
+{
+    size_t count = 1;
+    fragments[0] = box;
+    for (size_t i = first; (i < occluderCount) && (count > 0); i++)
+    {
+        UBKVisibilityBox cover = occluders[i].box;
+        if (UBKVisibilityBoxIsEmpty(UBKVisibilityBoxIntersect(box, cover)))
+        {
+            continue;
+        }
+        //Walk backwards, new pieces are appended past the current fragment
+        for (size_t fragment = count; fragment > 0; fragment--)
+        {
+            bool overflow = false;
+            count = UBKVisibilitySubtract(fragments, count, fragment - 1, cover, &overflow);
+            if (overflow)
+            {
+                return -1;
+            }
+        }
+    }
+    
+    double area = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        area += UBKVisibilityBoxArea(fragments[i]);
+    }
+    return area;
+}
+
+bool UBKVisibilityAnalyse(const UBKSnapshotNode *nodes, size_t count, UBKRect bounds, UBKVisibilityResult *results)
+{
+    if (count == 0)
+    {
+        return true;
+    }
+    
+    //Per node, the clip its descendants get and whether they're drawn with transparency
+    UBKVisibilityBox *childClips = malloc(count * sizeof(UBKVisibilityBox));
+    bool *translucent = malloc(count * sizeof(bool));
+    UBKVisibilityOccluder *occluders = malloc(count * sizeof(UBKVisibilityOccluder));
+    UBKVisibilityBox *fragments = malloc((UBKVisibilityMaximumFragments + 4) * sizeof(UBKVisibilityBox));
+    if ((childClips == NULL) || (translucent == NULL) || (occluders == NULL) || (fragments == NULL))
+    {
+        free(childClips);
+        free(translucent);
+        free(occluders);
+        free(fragments);
+        return false;
+    }
+    
+    //Clipping, parents always come first
+    UBKVisibilityBox windowBox = UBKVisibilityBoxFromRect(bounds);
+    size_t occluderCount = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const UBKSnapshotNode *node = &nodes[i];
+        int32_t parent = node->parent;
+        bool parentHidden = (parent >= 0) && (results[parent].state == UBKVisibilityStateHidden);
+        UBKVisibilityBox clip = (parent >= 0) ? childClips[parent] : windowBox;
+        UBKVisibilityBox frame = UBKVisibilityBoxFromRect(node->frame);
+        UBKVisibilityBox clipped = UBKVisibilityBoxIntersect(frame, clip);
+        
+        translucent[i] = ((parent >= 0) && (translucent[parent])) || (node->flags & UBKSnapshotNodeFlagTranslucent);
+        childClips[i] = (node->flags & UBKSnapshotNodeFlagClipsToBounds) ? clipped : clip;
+        
+        UBKVisibilityResult *result = &results[i];
+        result->clippedFrame = (UBKRect){ clipped.minX, clipped.minY, 0, 0 };
+        result->visibleArea = 0;
+        if ((parentHidden) || (node->flags & UBKSnapshotNodeFlagHidden))
+        {
+            result->state = UBKVisibilityStateHidden;
+        }
+        else if ((node->frame.width <= 0) || (node->frame.height <= 0))
+        {
+            result->state = UBKVisibilityStateEmpty;
+        }
+        else if (UBKVisibilityBoxIsEmpty(clipped))
+        {
+            result->state = UBKVisibilityStateClipped;
+        }
+        else
+        {
+            result->state = UBKVisibilityStateVisible;
+            result->clippedFrame.width = clipped.maxX - clipped.minX;
+            result->clippedFrame.height = clipped.maxY - clipped.minY;
+            result->visibleArea = UBKVisibilityBoxArea(clipped);
+            if ((node->flags & UBKSnapshotNodeFlagOpaque) && (!translucent[i]))
+            {
+                occluders[occluderCount].box = clipped;
+                occluders[occluderCount].index = (uint32_t)i;
+                occluderCount++;
+            }
+        }
+    }
+    
+    //Occlusion, only the occluders past the node's subtree are in front of it. Occluders are in pre-order so a binary search finds the first one.
+    for (size_t i = 0; i < count; i++)
+    {
+        UBKVisibilityResult *result = &results[i];
+        if ((result->state != UBKVisibilityStateVisible) || (!(nodes[i].flags & UBKSnapshotNodeFlagElement)))
+        {
+            continue;
+        }
+        size_t low = 0;
+        size_t high = occluderCount;
+        while (low < high)
+        {
+            size_t middle = low + ((high - low) / 2);
+            if (occluders[middle].index < nodes[i].subtreeEnd)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        
+        UBKRect rect = result->clippedFrame;
+        double area = UBKVisibilityUncoveredArea(UBKVisibilityBoxFromRect(rect), occluders, low, occluderCount, fragments);
+        if (area < 0)
+        {
+            continue;
+        }
+        result->visibleArea = area;
+        if (area < UBKVisibilityMinimumArea)
+        {
+            result->state = UBKVisibilityStateOccluded;
+        }
+    }
+    
+    free(childClips);
+    free(translucent);
+    free(occluders);
+    free(fragments);
+    return true;
+}
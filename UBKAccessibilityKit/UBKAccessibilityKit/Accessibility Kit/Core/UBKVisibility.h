@@ -0,0 +1,64 @@
+/*
+ File: UBKVisibility.h
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#ifndef UBKVisibility_h
+#define UBKVisibility_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "UBKSnapshot.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Works out which snapshot nodes can actually be seen. Nodes are clipped by the window bounds and by every clipsToBounds ancestor, then element nodes have the opaque nodes in front of them subtracted. Nodes later in pre-order are drawn on top, apart from descendants, which are part of the node.
+
+typedef enum {
+    UBKVisibilityStateVisible,
+    //The node or an ancestor is hidden or has an alpha of 0
+    UBKVisibilityStateHidden,
+    //Zero width or height
+    UBKVisibilityStateEmpty,
+    //Outside the window or a clipping ancestor, eg scrolled out of a scroll view
+    UBKVisibilityStateClipped,
+    //Covered by opaque views in front
+    UBKVisibilityStateOccluded
+} UBKVisibilityState;
+
+typedef struct {
+    UBKVisibilityState state;
+    //Frame after clipping, in window space
+    UBKRect clippedFrame;
+    //Area left after clipping and, for element nodes, occlusion
+    double visibleArea;
+} UBKVisibilityResult;
+
+//Results must hold a value for every node. Occlusion is only worked out for element nodes, other nodes are at most clipped. Returns false if the working memory couldn't be allocated.
+bool UBKVisibilityAnalyse(const UBKSnapshotNode *nodes, size_t count, UBKRect bounds, UBKVisibilityResult *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBKVisibility_h */
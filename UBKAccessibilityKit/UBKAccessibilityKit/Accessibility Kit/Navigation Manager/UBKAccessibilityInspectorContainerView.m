@@ -22,6 +22,7 @@
 #import "UBKNavigationController.h"
 #import "UBKContainerDragButton.h"
 #import "UBKAccessibilityInspectorGutterContainerView.h"
+#import "UBKAccessibilityWindow.h"
 
 const CGFloat minimumInspectorHeight = 280;
 typedef void (^AnimationCompletionBlock)(void);
@@ -216,6 +217,11 @@ typedef void (^AnimationCompletionBlock)(void);
     else
     {
         [self setFrame:CGRectMake(touchPoint.x - (self.customWidthAnchor.constant/2), touchPoint.y, self.customWidthAnchor.constant, self.customHeightAnchor.constant)];
+        //The frame was changed without a layout pass, let the window know its touch exclusion rects are stale.
+        if ([self.window isKindOfClass:[UBKAccessibilityWindow class]])
+        {
+            [(UBKAccessibilityWindow *)self.window setNeedsTouchExclusionUpdate];
+        }
         self.alpha = 0.7;        
         [self.gutterView initalizeGutterViews];
         [self.gutterView highlightGutterUnderTouchPoint:touchPoint];
@@ -33,6 +33,7 @@ NS_ASSUME_NONNULL_BEGIN
 - (instancetype)initWithRootViewController:(UIViewController *)rootViewController NS_UNAVAILABLE;
 - (instancetype)initWithUIElementsViewController:(UBKAccessibilityElementsTableViewController *)rootViewController;
 - (void)updateAllElements:(NSArray *)elementsArray;
+- (void)updateElementsProgress:(double)progress;
 - (void)selectElement:(UIView *)selectedElement;
 - (void)updateNearbyTouchedElement:(NSArray *)elementsArray;
 @end
@@ -44,6 +44,11 @@
     self.elementsViewController.elementsArray = elementsArray;
 }
 
+- (void)updateElementsProgress:(double)progress
+{
+    self.elementsViewController.walkProgress = progress;
+}
+
 - (void)selectElement:(UIView *)selectedElement
 {
     self.elementsViewController.selectedElement = selectedElement;
@@ -34,6 +34,47 @@ FOUNDATION_EXPORT const unsigned char UBKAccessibilityKitVersionString[];
 #import <UBKAccessibilityKit/UBKAccessibilityWindow.h>
 #import <UBKAccessibilityKit/UBKAccessibilityManager.h>
 #import <UBKAccessibilityKit/UBKAccessibilityValidation.h>
+#import <UBKAccessibilityKit/UBKAccessibilitySnapshot.h>
+#import <UBKAccessibilityKit/UBKAccessibilitySessionRecorder.h>
+#import <UBKAccessibilityKit/UBKAccessibilityAuditCache.h>
+#import <UBKAccessibilityKit/UBKAccessibilityColourVision.h>
+#import <UBKAccessibilityKit/UBKAccessibilityTargetSpacing.h>
+#import <UBKAccessibilityKit/UBKAccessibilityReadingOrder.h>
+#import <UBKAccessibilityKit/UBKAccessibilityVisibility.h>
+#import <UBKAccessibilityKit/UBKAccessibilityAuditStore.h>
+#import <UBKAccessibilityKit/UBKAccessibilityLabels.h>
+#import <UBKAccessibilityKit/UBKAccessibilityHierarchyWalker.h>
+#import <UBKAccessibilityKit/UBKAccessibilityMetrics.h>
+#import <UBKAccessibilityKit/UBKAccessibilitySampler.h>
+#import <UBKAccessibilityKit/UBKAccessibilityInspectionServer.h>
+#import <UBKAccessibilityKit/UBKAccessibilitySubtreeGroups.h>
+#import <UBKAccessibilityKit/UBKAccessibilityTextRuns.h>
+#import <UBKAccessibilityKit/UBKAccessibilityControlStates.h>
+#import <UBKAccessibilityKit/UBKAccessibilityAppearances.h>
+#import <UBKAccessibilityKit/UBKAccessibilityScanArena.h>
+#import <UBKAccessibilityKit/UBKAccessibilityClassInfo.h>
+#import <UBKAccessibilityKit/UBKAccessibilityScreenPasses.h>
+#import <UBKAccessibilityKit/UBKAccessibilityComponentAudit.h>
+
+#import <UBKAccessibilityKit/UBKHash.h>
+#import <UBKAccessibilityKit/UBKSnapshot.h>
+#import <UBKAccessibilityKit/UBKColourVision.h>
+#import <UBKAccessibilityKit/UBKColourValue.h>
+#import <UBKAccessibilityKit/UBKTargetSpacing.h>
+#import <UBKAccessibilityKit/UBKReadingOrder.h>
+#import <UBKAccessibilityKit/UBKVisibility.h>
+#import <UBKAccessibilityKit/UBKRuleProfile.h>
+#import <UBKAccessibilityKit/UBKAuditStore.h>
+#import <UBKAccessibilityKit/UBKAuditDiff.h>
+#import <UBKAccessibilityKit/UBKLabels.h>
+#import <UBKAccessibilityKit/UBKColourTokens.h>
+#import <UBKAccessibilityKit/UBKMetrics.h>
+#import <UBKAccessibilityKit/UBKSampling.h>
+#import <UBKAccessibilityKit/UBKInspection.h>
+#import <UBKAccessibilityKit/UBKSubtreeGroups.h>
+#import <UBKAccessibilityKit/UBKTextRuns.h>
+#import <UBKAccessibilityKit/UBKContrastPairs.h>
+#import <UBKAccessibilityKit/UBKArena.h>
 
 #import <UBKAccessibilityKit/UIColor+HelperMethods.h>
 #import <UBKAccessibilityKit/NSArray+HelperMethods.h>
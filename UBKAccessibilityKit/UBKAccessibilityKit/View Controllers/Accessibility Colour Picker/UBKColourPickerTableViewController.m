@@ -122,14 +122,13 @@
     {
         self.accessibilityBackground.colourUpdateCompletionBlock(self.customBackgroundColour);
     }
-    self.accessibilityBackground.displayColour = self.customBackgroundColour;
     
     if (self.accessibilityProperty.colourUpdateCompletionBlock)
     {
         self.accessibilityProperty.colourUpdateCompletionBlock(self.customForegroundColour);
     }
-    self.accessibilityProperty.displayColour = self.customForegroundColour;
     
+    [[UBKAccessibilityManager sharedInstance] invalidateAccessibilityDetailsForView:self.selectedElement];
     [self createContrastSuggestedCells];
 }
 
@@ -204,13 +203,15 @@
     [self presentViewController:alertController animated:YES completion:nil];
 }
 
-//Updates the contrast warning and rating based on current colours for the foreground and background
-- (void)checkContrastSetting
+//Font size and weight don't change while picking colours, so they're read once when the element is set rather than on every colour change.
+- (void)setSelectedElement:(UIView *)selectedElement
 {
-    self.contrastRating = [UBKAccessibilityValidation getViewContrastRatio:self.customForegroundColour backgroundColor:self.customBackgroundColour];
-    self.contrastWarningRating = [UBKAccessibilityValidation getColourContrastRatingForNonText:self.contrastRating];
-    NSArray *itemsArray = self.selectedElement.ubk_accessibilityDetails;
+    _selectedElement = selectedElement;
+    self.boldFont = false;
+    self.accessibilityFont = nil;
+    self.checkingTextContrast = false;
     
+    NSArray *itemsArray = [[UBKAccessibilityManager sharedInstance] accessibilityDetailsForView:selectedElement];
     for (UBKAccessibilitySection *section in itemsArray)
     {
         if ([section getPropertyForTitleKey:kUBKAccessibilityAttributeTitle_FontBold])
@@ -229,12 +230,25 @@
         if ([section getPropertyForTitleKey:kUBKAccessibilityAttributeTitle_FontSize])
         {
             self.accessibilityFont = [section getPropertyForTitleKey:kUBKAccessibilityAttributeTitle_FontSize];
-            self.contrastWarningRating = [UBKAccessibilityValidation getColourContrastRatingForText:self.contrastRating withTextSize:[self.accessibilityFont.displayValue doubleValue] withBoldFont:self.boldFont];
             self.checkingTextContrast = true;
         }
     }
 }
 
+//Updates the contrast warning and rating based on current colours for the foreground and background
+- (void)checkContrastSetting
+{
+    self.contrastRating = [UBKAccessibilityValidation getViewContrastRatio:self.customForegroundColour backgroundColor:self.customBackgroundColour];
+    if (self.checkingTextContrast)
+    {
+        self.contrastWarningRating = [UBKAccessibilityValidation getColourContrastRatingForText:self.contrastRating withTextSize:[self.accessibilityFont.displayValue doubleValue] withBoldFont:self.boldFont];
+    }
+    else
+    {
+        self.contrastWarningRating = [UBKAccessibilityValidation getColourContrastRatingForNonText:self.contrastRating];
+    }
+}
+
 //Checks if any suggestions can be provided for the current colour contrast
 - (void)createContrastSuggestedCells
 {
@@ -255,7 +269,7 @@
             {
                 double contrast = [alternateColourTwo ubk_contrastRatio:self.customBackgroundColour];
                 alternateColourTwo = [UIColor ubk_findBetterContrastColour:alternateColourTwo backgroundColour:self.customBackgroundColour previousContrast:contrast];
-                if (![[alternateColourOne ubk_hexStringFromColour] isEqualToString:[alternateColourTwo ubk_hexStringFromColour]])
+                if (![alternateColourOne ubk_isEqualToColour:alternateColourTwo])
                 {
                     [[UBKAccessibilityManager sharedInstance].accessibilityColours addSuggestedColour:alternateColourTwo withTitle:kUBKAccessibilityAttributeTitle_ColourSuggestionTwo];
                 }
@@ -267,7 +281,7 @@
             {
                 double contrast = [alternateColourThree ubk_contrastRatio:self.customBackgroundColour];
                 alternateColourThree = [UIColor ubk_findBetterContrastColour:alternateColourThree backgroundColour:self.customBackgroundColour previousContrast:contrast];
-                if (![[alternateColourOne ubk_hexStringFromColour] isEqualToString:[alternateColourThree ubk_hexStringFromColour]])
+                if (![alternateColourOne ubk_isEqualToColour:alternateColourThree])
                 {
                     [[UBKAccessibilityManager sharedInstance].accessibilityColours addSuggestedColour:alternateColourThree withTitle:kUBKAccessibilityAttributeTitle_ColourSuggestionThree];
                 }
@@ -299,7 +313,6 @@
         {
             self.accessibilityBackground.colourUpdateCompletionBlock(colour);
         }
-        self.accessibilityBackground.displayColour = colour;
         self.customBackgroundColour = colour;
     }
     else
@@ -308,10 +321,11 @@
         {
             self.accessibilityProperty.colourUpdateCompletionBlock(colour);
         }
-        self.accessibilityProperty.displayColour = colour;
         self.customForegroundColour = colour;
     }
     
+    //Only the selected element and the views that inherit its colours need auditing again
+    [[UBKAccessibilityManager sharedInstance] invalidateAccessibilityDetailsForView:self.selectedElement];
     [self createContrastSuggestedCells];
 }
 
@@ -362,14 +376,14 @@
     
     if (self.changingBackgroundColour)
     {
-        if (self.customBackgroundColour == property.displayColour)
+        if ([self.customBackgroundColour ubk_isEqualToColour:property.displayColour])
         {
             cell.accessoryType = UITableViewCellAccessoryCheckmark;
         }
     }
     else
     {
-        if (self.customForegroundColour == property.displayColour)
+        if ([self.customForegroundColour ubk_isEqualToColour:property.displayColour])
         {
             cell.accessoryType = UITableViewCellAccessoryCheckmark;
         }
@@ -23,6 +23,7 @@
 //View Controllers
 #import "UBKColourPickerTableViewController.h"
 
+#import "UBKAccessibilityManager.h"
 #import "UBKAccessibilityConstants.h"
 #import "UBKAccessibilitySuggestionViewController.h"
 
@@ -97,7 +98,10 @@ typedef enum : NSUInteger {
         }
         else
         {
+            //Returning from a detail view, eg the colour picker, only refresh what it changed
             self.loadingDetailView = false;
+            [self reloadChangedViewItems];
+            return;
         }
         [self.tableView reloadData];
     }
@@ -214,17 +218,8 @@ typedef enum : NSUInteger {
         [self.pickerView selectRow:index inComponent:0 animated:FALSE];
     }
 
-    if (!self.itemsArray)
-    {
-        self.itemsArray = [[NSMutableArray alloc]init];
-    }
-    else
-    {
-        [self.itemsArray removeAllObjects];
-    }
-    
-    //Extension, check if control responds to protocol and if so use those properties.
-    self.itemsArray = control.ubk_accessibilityDetails.mutableCopy;
+    //The view may have changed since the last refresh, audit it again when it's selected. Segment changes then reuse the results.
+    [[UBKAccessibilityManager sharedInstance] invalidateAccessibilityDetailsForView:control];
     [self reloadViewItems];
 }
 
@@ -241,7 +236,59 @@ typedef enum : NSUInteger {
 //Used to filter out the items to display on screen. This is based on the segment control selected index (SegmentControlView value)
 - (void)reloadViewItems
 {
-    self.itemsArray = self.selectedItem.ubk_accessibilityDetails.mutableCopy;
+    self.itemsArray = [self loadViewItems];
+    [self.tableView reloadData];
+}
+
+//Reloads only the rows whose values changed since the items were loaded. Falls back to reloading everything when sections or rows were added or removed.
+- (void)reloadChangedViewItems
+{
+    NSArray *previousItems = self.itemsArray;
+    NSMutableArray *items = [self loadViewItems];
+    self.itemsArray = items;
+    
+    if (previousItems.count != items.count)
+    {
+        [self.tableView reloadData];
+        return;
+    }
+    
+    NSMutableArray <NSIndexPath *> *changedRows = [[NSMutableArray alloc]init];
+    for (NSInteger section = 0; section < items.count; section++)
+    {
+        UBKAccessibilitySection *previousSection = previousItems[section];
+        UBKAccessibilitySection *accessibilitySection = items[section];
+        if ((![previousSection.headerTitle isEqualToString:accessibilitySection.headerTitle]) || (previousSection.items.count != accessibilitySection.items.count))
+        {
+            [self.tableView reloadData];
+            return;
+        }
+        if ([accessibilitySection.headerTitle isEqualToString:kUBKAccessibilityAttributeTitle_Warning_Header])
+        {
+            //Displayed warnings are sorted, sort the new ones the same way before comparing rows
+            [accessibilitySection sortWarningsByLevel];
+        }
+        for (NSInteger row = 0; row < accessibilitySection.items.count; row++)
+        {
+            UBKAccessibilityProperty *previousProperty = previousSection.items[row];
+            UBKAccessibilityProperty *accessibilityProperty = accessibilitySection.items[row];
+            if (![accessibilityProperty hasSameDisplayAsProperty:previousProperty])
+            {
+                [changedRows addObject:[NSIndexPath indexPathForRow:row inSection:section]];
+            }
+        }
+    }
+    
+    if (changedRows.count > 0)
+    {
+        [self.tableView reloadRowsAtIndexPaths:changedRows withRowAnimation:UITableViewRowAnimationNone];
+    }
+}
+
+//Sections for the selected item, filtered by the segment control. Details come from the manager so results that haven't changed since the last refresh aren't worked out again.
+- (NSMutableArray *)loadViewItems
+{
+    NSArray *details = [[UBKAccessibilityManager sharedInstance] accessibilityDetailsForView:self.selectedItem];
 
     NSArray *sectionsForView = nil;
     switch (self.viewSelectionControl.selectedSegmentIndex)
@@ -263,8 +310,7 @@ typedef enum : NSUInteger {
         }
     }
 
-    self.itemsArray = [self filterItemsFromArray:self.itemsArray showingSections:sectionsForView];
-    [self.tableView reloadData];
+    return [self filterItemsFromArray:details showingSections:sectionsForView];
 }
 
 - (NSMutableArray *)filterItemsFromArray:(NSArray *)array showingSections:(NSArray *)viewSections
@@ -445,6 +491,9 @@ typedef enum : NSUInteger {
         case UBKAccessibilityWarningTypeDisabled:
         case UBKAccessibilityWarningTypeMissingLabel:
         case UBKAccessibilityWarningTypeDynamicTextSize:
+        case UBKAccessibilityWarningTypeReadingOrder:
+        case UBKAccessibilityWarningTypeDuplicateLabel:
+        case UBKAccessibilityWarningTypeLabelEchoesName:
         {
             [self.viewSelectionControl setSelectedSegmentIndex:SegmentControlViewAccessibility];
             matchingSectionTitle = kUBKAccessibilityAttributeTitle_AccessibilityAttributes;
@@ -453,12 +502,19 @@ typedef enum : NSUInteger {
         case UBKAccessibilityWarningTypeColourContrast:
         case UBKAccessibilityWarningTypeColourContrastBackground:
         case UBKAccessibilityWarningTypeWrongColour:
+        case UBKAccessibilityWarningTypeColourVisionProtanopia:
+        case UBKAccessibilityWarningTypeColourVisionDeuteranopia:
+        case UBKAccessibilityWarningTypeColourVisionTritanopia:
+        case UBKAccessibilityWarningTypeColourVisionAchromatopsia:
+        case UBKAccessibilityWarningTypeStateColourContrast:
+        case UBKAccessibilityWarningTypeAppearanceContrast:
         {
             [self.viewSelectionControl setSelectedSegmentIndex:SegmentControlViewColours];
             matchingSectionTitle = kUBKAccessibilityAttributeTitle_Colours;
             break;
         }
         case UBKAccessibilityWarningTypeMinimumSize:
+        case UBKAccessibilityWarningTypeTargetSpacing:
         {
             [self.viewSelectionControl setSelectedSegmentIndex:SegmentControlViewAttributes];
             matchingSectionTitle = kUBKAccessibilityAttributeTitle_Attributes;
@@ -476,6 +532,9 @@ typedef enum : NSUInteger {
         }
         case UBKAccessibilityWarningTypeLabel:
         case UBKAccessibilityWarningTypeMissingLabel:
+        case UBKAccessibilityWarningTypeReadingOrder:
+        case UBKAccessibilityWarningTypeDuplicateLabel:
+        case UBKAccessibilityWarningTypeLabelEchoesName:
         {
             warningTitle =kUBKAccessibilityAttributeTitle_Label;
             break;
@@ -511,11 +570,34 @@ typedef enum : NSUInteger {
             warningTitle = kUBKAccessibilityAttributeTitle_BackgroundColour;
             break;
         }
+        case UBKAccessibilityWarningTypeColourVisionProtanopia:
+        case UBKAccessibilityWarningTypeColourVisionDeuteranopia:
+        case UBKAccessibilityWarningTypeColourVisionTritanopia:
+        case UBKAccessibilityWarningTypeColourVisionAchromatopsia:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_W3CContrastRatio;
+            break;
+        }
         case UBKAccessibilityWarningTypeMinimumSize:
         {
             warningTitle = kUBKAccessibilityAttributeTitle_MinimumSizeWarning;
             break;
         }
+        case UBKAccessibilityWarningTypeTargetSpacing:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_Frame;
+            break;
+        }
+        case UBKAccessibilityWarningTypeStateColourContrast:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_NormalStateColour;
+            break;
+        }
+        case UBKAccessibilityWarningTypeAppearanceContrast:
+        {
+            warningTitle = kUBKAccessibilityAttributeTitle_LightAppearanceContrast;
+            break;
+        }
     }
     
     //Now that the segment control has been changed we filter out the sections based on the section and reload the TableView.
@@ -129,6 +129,56 @@
             suggestionString = @"Colour used for this user interface element does not match the supplied colours. Check you've set the correct colour.";
             break;
         }
+        case UBKAccessibilityWarningTypeColourVisionProtanopia:
+        {
+            suggestionString = @"Colour contrast meets the W3C guidelines for typical colour vision but not when simulated for protanopia (no red cones). \n\nRed and green colours lose most of their difference in brightness. Try changing the lightness of the colours rather than the hue.";
+            break;
+        }
+        case UBKAccessibilityWarningTypeColourVisionDeuteranopia:
+        {
+            suggestionString = @"Colour contrast meets the W3C guidelines for typical colour vision but not when simulated for deuteranopia (no green cones). \n\nRed and green colours lose most of their difference in brightness. Try changing the lightness of the colours rather than the hue.";
+            break;
+        }
+        case UBKAccessibilityWarningTypeColourVisionTritanopia:
+        {
+            suggestionString = @"Colour contrast meets the W3C guidelines for typical colour vision but not when simulated for tritanopia (no blue cones). \n\nBlue and yellow colours lose most of their difference in brightness. Try changing the lightness of the colours rather than the hue.";
+            break;
+        }
+        case UBKAccessibilityWarningTypeColourVisionAchromatopsia:
+        {
+            suggestionString = @"Colour contrast meets the W3C guidelines for typical colour vision but not when simulated for achromatopsia (no colour vision). \n\nOnly the difference in brightness remains. Try changing the lightness of the colours.";
+            break;
+        }
+        case UBKAccessibilityWarningTypeTargetSpacing:
+        {
+            suggestionString = @"This touch target overlaps another target, or is smaller than the minimum target spacing and too close to another target. \n\nWCAG 2.2 asks for undersized targets to have enough space around them that a 24 x 24 circle on each target doesn't reach a neighbouring target. Try making the target larger or moving it away from its neighbours.";
+            break;
+        }
+        case UBKAccessibilityWarningTypeReadingOrder:
+        {
+            suggestionString = @"VoiceOver reaches this element out of the order it appears on screen. VoiceOver follows the view hierarchy, and the expected order reads rows top to bottom and each row in the reading direction. \n\nTry reordering the subviews to match the layout, grouping related views with shouldGroupAccessibilityChildren, or setting accessibilityElements on the container.";
+            break;
+        }
+        case UBKAccessibilityWarningTypeDuplicateLabel:
+        {
+            suggestionString = @"Another control on screen has the same accessibilityLabel, and neither has a hint or value to tell them apart. VoiceOver and Voice Control users can't tell which one they are on. \n\nTry making the label specific, eg \"More about savings\" rather than \"More\", or set an accessibilityValue or accessibilityHint that describes the difference.";
+            break;
+        }
+        case UBKAccessibilityWarningTypeLabelEchoesName:
+        {
+            suggestionString = @"The accessibilityLabel repeats a name from the code, eg the accessibilityIdentifier, the image asset name or the class name. VoiceOver reads names like \"icon_close\" or \"Button\" as they are written. \n\nSet an accessibilityLabel that describes what the element is or does, eg \"Close\".";
+            break;
+        }
+        case UBKAccessibilityWarningTypeStateColourContrast:
+        {
+            suggestionString = @"Colour contrast doesn't meet the minimum W3C guidelines in a state the control isn't showing right now, eg a highlighted or selected button title, or for the track or thumb tint of a switch or slider. \n\nDisabled controls are exempt. Check the contrast of each state in the colours section and try changing the colour for the failing state.";
+            break;
+        }
+        case UBKAccessibilityWarningTypeAppearanceContrast:
+        {
+            suggestionString = @"Colour contrast meets the W3C guidelines in the appearance on screen but not in light, dark or increased contrast mode. Each dynamic colour is checked in every appearance without changing the system settings. \n\nCheck the contrast of each appearance in the colours section and try changing the failing variant of the colour in the asset catalog or dynamic colour provider.";
+            break;
+        }
     }
     
     self.suggestionTextView.attributedText = [self configureAttributedStringTitle:self.accessibilityProperty.displayTitle withBody:suggestionString];
@@ -25,6 +25,8 @@
 #import "UBKAccessibilitySection.h"
 #import "UBKAccessibilityTitleValueTableViewCell.h"
 #import "UIColor+HelperMethods.h"
+#import "UBKAccessibilityManager.h"
+#import "UBKAccessibilityFilter.h"
 
 @interface UBKReportUIElementCollectionViewCell ()
 @property (nonatomic, weak) IBOutlet UILabel *numberLabel;
@@ -71,7 +73,7 @@
 
 - (void)configureAppearanceForView:(UIView *)view
 {
-    NSArray *itemsArray = view.ubk_accessibilityDetails;
+    NSArray *itemsArray = [[UBKAccessibilityManager sharedInstance] accessibilityDetailsForView:view];
     for (UBKAccessibilitySection *section in itemsArray)
     {
         if (section.sectionType == SectionDisplayTypeWarnings)
@@ -133,7 +135,7 @@
         else if (section.sectionType == SectionDisplayTypeComponentAttributes)
         {
             UBKAccessibilityProperty *className = [section getPropertyForTitleKey:kUBKAccessibilityAttributeTitle_ClassName];
-            self.classNameLabel.text = className.displayValue;
+            self.classNameLabel.text = [UBKAccessibilityFilter titleForElementTitle:className.displayValue repeatCount:[[UBKAccessibilityManager sharedInstance] repeatCountForView:view]];
         }
     }
     
@@ -25,6 +25,9 @@
 #import "UBKAccessibilitySection.h"
 #import "UBKAccessibilityProperty.h"
 #import "UBKAccessibilityConstants.h"
+#import "UBKAccessibilityManager.h"
+#import "UBKAccessibilityFilter.h"
+#import "UBKAccessibilityClassInfo.h"
 
 @interface UBKUIElementTableViewCell ()
 @property (nonatomic) IBOutlet UILabel *cellTitleLabel;
@@ -106,7 +109,7 @@
 
 - (void)configureCellAppearance
 {
-    NSArray *itemsArray = self.elementView.ubk_accessibilityDetails;
+    NSArray *itemsArray = [[UBKAccessibilityManager sharedInstance] accessibilityDetailsForView:self.elementView];
 
     UBKAccessibilityProperty *backgroundProperty = nil;
     UBKAccessibilityProperty *foregroundProperty = nil;
@@ -151,7 +154,7 @@
         }
     }
     
-    self.cellTitleLabel.text = NSStringFromClass([self.elementView class]);
+    self.cellTitleLabel.text = [UBKAccessibilityFilter titleForElementTitle:NSStringFromClass([self.elementView class]) repeatCount:[[UBKAccessibilityManager sharedInstance] repeatCountForView:self.elementView]];
     
     self.cellForegroundColourView.backgroundColor = foregroundProperty.displayColour;
     self.cellBackgroundColourView.backgroundColor = backgroundProperty.displayColour;
@@ -192,7 +195,7 @@
     }
     
     //Displays the icon for the class, eg UIImageView, UIView, UIButton etc
-    UIImage *classImage = [UIImage imageNamed:self.elementView.ubk_classIconName inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:[UITraitCollection traitCollectionWithDisplayScale:[UIScreen mainScreen].scale]];
+    UIImage *classImage = [UIImage imageNamed:[UBKAccessibilityClassInfo classInfoForView:self.elementView].iconName inBundle:[NSBundle bundleForClass:[self class]] compatibleWithTraitCollection:[UITraitCollection traitCollectionWithDisplayScale:[UIScreen mainScreen].scale]];
     
     //If no image is returned for the class, use the defect unknown icon
     if (classImage == nil)
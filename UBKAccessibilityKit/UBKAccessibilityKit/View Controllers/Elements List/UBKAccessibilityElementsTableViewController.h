@@ -26,6 +26,8 @@ NS_ASSUME_NONNULL_BEGIN
 @interface UBKAccessibilityElementsTableViewController : UIViewController
 @property (nonatomic) UIView *selectedElement;
 @property (nonatomic) NSArray *elementsArray;
+//Progress of the hierarchy walk from 0 to 1, shown in the title while the walk is running.
+@property (nonatomic) double walkProgress;
 @end
 
 NS_ASSUME_NONNULL_END
@@ -42,6 +42,7 @@
 @property (nonatomic) UIBarButtonItem *warningButton;
 @property (nonatomic) UIBarButtonItem *filterButton;
 @property (nonatomic) UIBarButtonItem *settingsButton;
+@property (nonatomic) UIBarButtonItem *readingOrderButton;
 @property (nonatomic) IBOutlet UIBarButtonItem *highlightButton;
 @property (nonatomic) IBOutlet UILabel *noResultsLabel;
 @property (nonatomic, weak) UIButton *previousSelectedButton;
@@ -56,6 +57,19 @@
     [self.tableView reloadData];
 }
 
+- (void)setWalkProgress:(double)walkProgress
+{
+    _walkProgress = walkProgress;
+    if (walkProgress < 1)
+    {
+        self.title = [NSString stringWithFormat:@"Scanning %d%%", (int)(walkProgress * 100)];
+    }
+    else
+    {
+        self.title = @"UI Elements";
+    }
+}
+
 - (void)setSelectedUIElementIndex:(NSIndexPath *)selectedUIElementIndex
 {
     if (self.selectedUIElementIndex)
@@ -87,7 +101,7 @@
             [self.filteredList addObject:uiElement];
         }
         
-        NSArray *itemsArray = uiElement.ubk_accessibilityDetails;
+        NSArray *itemsArray = [[UBKAccessibilityManager sharedInstance] accessibilityDetailsForView:uiElement];
         //Get the warning section, if no section, remove outline
         UBKAccessibilitySection *section = [itemsArray ubk_sectionForTitleKey:kUBKAccessibilityAttributeTitle_Warning_Header];
         if ((section) && ([UBKAccessibilityManager sharedInstance].isShowingHighlightedUI))
@@ -150,7 +164,7 @@
         [self.tableView.refreshControl endRefreshing];
     });
     
-    [[UBKAccessibilityManager sharedInstance]configureAllUIElments];
+    [[UBKAccessibilityManager sharedInstance]configureAllUIElmentsIncrementally];
 }
 
 - (void)viewDidLoad
@@ -177,7 +191,11 @@
     self.settingsButton = [[UIBarButtonItem alloc]initWithImage:imageTmp style:UIBarButtonItemStylePlain target:self action:@selector(showSettings)];
     self.settingsButton.accessibilityLabel = @"Settings";
     
-    self.navigationItem.leftBarButtonItems = @[self.settingsButton, self.filterButton];
+    self.readingOrderButton = [[UIBarButtonItem alloc]initWithTitle:@"123" style:UIBarButtonItemStylePlain target:self action:@selector(showReadingOrder)];
+    self.readingOrderButton.accessibilityLabel = @"Reading order: off";
+    self.readingOrderButton.accessibilityHint = @"Number UI elements in their expected VoiceOver reading order.";
+    
+    self.navigationItem.leftBarButtonItems = @[self.settingsButton, self.filterButton, self.readingOrderButton];
 
     self.isFilteringWarnings = false;
     self.filteredList = [[NSMutableArray alloc]init];
@@ -232,7 +250,7 @@
 - (IBAction)showWarningsOnUIElements:(id)sender
 {
     [UBKAccessibilityManager sharedInstance].isShowingHighlightedUI = ![UBKAccessibilityManager sharedInstance].isShowingHighlightedUI;
-    [[UBKAccessibilityManager sharedInstance]configureAllUIElments];
+    [[UBKAccessibilityManager sharedInstance]configureAllUIElmentsIncrementally];
     
     //Only showing warnings
     NSString *outlineLabelString = @"Outline warnings: off";
@@ -243,6 +261,22 @@
     self.highlightButton.title = outlineLabelString;
 }
 
+- (void)showReadingOrder
+{
+    [UBKAccessibilityManager sharedInstance].isShowingReadingOrder = ![UBKAccessibilityManager sharedInstance].isShowingReadingOrder;
+    
+    if ([UBKAccessibilityManager sharedInstance].isShowingReadingOrder)
+    {
+        self.readingOrderButton.accessibilityLabel = @"Reading order: on";
+        self.readingOrderButton.tintColor = [UIColor ubk_warningLevelMediumBackgroundColour];
+    }
+    else
+    {
+        self.readingOrderButton.accessibilityLabel = @"Reading order: off";
+        self.readingOrderButton.tintColor = nil;
+    }
+}
+
 - (void)outlineElement:(UIButton *)button
 {
     UIView *selectedUI = [self getUIElementForIndex:button.tag];
@@ -31,6 +31,8 @@ NS_ASSUME_NONNULL_BEGIN
 + (NSString *)warningNameForWarningType:(UBKAccessibilityWarningType)warningType;
 + (NSString *)warningNameForWarningLevel:(UBKAccessibilityWarningLevel)warningLevel;
 + (NSString *)objectClassNameForObjectClassNames:(UBKAccessibilityObjectClass)objectClass;
+//Title for an entry that stands for repeatCount identical elements, see UBKAccessibilityManager isGroupingRepeatedSubtrees. title is returned as is for a single element.
++ (NSString *)titleForElementTitle:(NSString *)title repeatCount:(NSUInteger)repeatCount;
 
 @property (nonatomic) NSMutableArray *filteredObjects;
 
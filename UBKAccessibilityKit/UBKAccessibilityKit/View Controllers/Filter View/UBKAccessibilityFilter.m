@@ -23,6 +23,8 @@
 #import "UBKAccessibilitySection.h"
 #import "NSArray+HelperMethods.h"
 #import "UBKAccessibilityConstants.h"
+#import "UBKAccessibilityManager.h"
+#import "UBKAccessibilityClassInfo.h"
 
 @import UIKit;
 
@@ -55,7 +57,6 @@
     
     [self configureWarningTypesForWarningLevels];
     
-    ///TODO: add in filtering for object types
     [self toggleObjectClassToObjectClassNames:UBKAccessibilityObjectClassUIButton];
     [self toggleObjectClassToObjectClassNames:UBKAccessibilityObjectClassUIImageView];
     [self toggleObjectClassToObjectClassNames:UBKAccessibilityObjectClassUILabel];
@@ -96,6 +97,8 @@
     [self toggleSelectedWarningType:UBKAccessibilityWarningTypeColourContrastBackground];
     [self toggleSelectedWarningType:UBKAccessibilityWarningTypeWrongColour];
     [self toggleSelectedWarningType:UBKAccessibilityWarningTypeMinimumSize];
+    [self toggleSelectedWarningType:UBKAccessibilityWarningTypeStateColourContrast];
+    [self toggleSelectedWarningType:UBKAccessibilityWarningTypeAppearanceContrast];
 
     [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeLabel withArray:self.warningTypesAvailable];
     [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeMissingLabel withArray:self.warningTypesAvailable];
@@ -103,6 +106,8 @@
     [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeColourContrastBackground withArray:self.warningTypesAvailable];
     [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeWrongColour withArray:self.warningTypesAvailable];
     [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeMinimumSize withArray:self.warningTypesAvailable];
+    [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeStateColourContrast withArray:self.warningTypesAvailable];
+    [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeAppearanceContrast withArray:self.warningTypesAvailable];
     
     self.warningTypesAvailable = [[NSMutableArray alloc]initWithArray:[self.warningTypesAvailable sortedArrayUsingSelector: @selector(compare:)]];
 }
@@ -114,24 +119,39 @@
     [self toggleSelectedWarningType:UBKAccessibilityWarningTypeValue];
     [self toggleSelectedWarningType:UBKAccessibilityWarningTypeDisabled];
     [self toggleSelectedWarningType:UBKAccessibilityWarningTypeDynamicTextSize];
+    [self toggleSelectedWarningType:UBKAccessibilityWarningTypeColourVisionProtanopia];
+    [self toggleSelectedWarningType:UBKAccessibilityWarningTypeColourVisionDeuteranopia];
+    [self toggleSelectedWarningType:UBKAccessibilityWarningTypeTargetSpacing];
+    [self toggleSelectedWarningType:UBKAccessibilityWarningTypeReadingOrder];
+    [self toggleSelectedWarningType:UBKAccessibilityWarningTypeDuplicateLabel];
+    [self toggleSelectedWarningType:UBKAccessibilityWarningTypeLabelEchoesName];
 
     //Update the available warning types, this displays all available for the medium warning type.
     [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeTrait withArray:self.warningTypesAvailable];
     [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeValue withArray:self.warningTypesAvailable];
     [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeDisabled withArray:self.warningTypesAvailable];
     [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeDynamicTextSize withArray:self.warningTypesAvailable];
+    [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeColourVisionProtanopia withArray:self.warningTypesAvailable];
+    [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeColourVisionDeuteranopia withArray:self.warningTypesAvailable];
+    [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeTargetSpacing withArray:self.warningTypesAvailable];
+    [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeReadingOrder withArray:self.warningTypesAvailable];
+    [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeDuplicateLabel withArray:self.warningTypesAvailable];
+    [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeLabelEchoesName withArray:self.warningTypesAvailable];
     
     self.warningTypesAvailable = [[NSMutableArray alloc]initWithArray:[self.warningTypesAvailable sortedArrayUsingSelector: @selector(compare:)]];
 }
 
-//No low warnings are currently being used in the framework. This is available for future use.
 - (void)loadWarningsForLow
 {
     //Updates the selected warning types, this shows a tick next to each cell in the available list.
     [self toggleSelectedWarningType:UBKAccessibilityWarningTypeHint];
+    [self toggleSelectedWarningType:UBKAccessibilityWarningTypeColourVisionTritanopia];
+    [self toggleSelectedWarningType:UBKAccessibilityWarningTypeColourVisionAchromatopsia];
 
     //Update the available warning types, this displays all available for the medium warning type.
     [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeHint withArray:self.warningTypesAvailable];
+    [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeColourVisionTritanopia withArray:self.warningTypesAvailable];
+    [self toggleWarningTypeToWarningTypes:UBKAccessibilityWarningTypeColourVisionAchromatopsia withArray:self.warningTypesAvailable];
     
     self.warningTypesAvailable = [[NSMutableArray alloc]initWithArray:[self.warningTypesAvailable sortedArrayUsingSelector: @selector(compare:)]];
 }
@@ -233,6 +253,56 @@
             warningString = @"Dynamic text size";
             break;
         }
+        case UBKAccessibilityWarningTypeColourVisionProtanopia:
+        {
+            warningString = @"Colour vision - Protanopia";
+            break;
+        }
+        case UBKAccessibilityWarningTypeColourVisionDeuteranopia:
+        {
+            warningString = @"Colour vision - Deuteranopia";
+            break;
+        }
+        case UBKAccessibilityWarningTypeColourVisionTritanopia:
+        {
+            warningString = @"Colour vision - Tritanopia";
+            break;
+        }
+        case UBKAccessibilityWarningTypeColourVisionAchromatopsia:
+        {
+            warningString = @"Colour vision - Achromatopsia";
+            break;
+        }
+        case UBKAccessibilityWarningTypeTargetSpacing:
+        {
+            warningString = @"Target spacing";
+            break;
+        }
+        case UBKAccessibilityWarningTypeReadingOrder:
+        {
+            warningString = @"Reading order";
+            break;
+        }
+        case UBKAccessibilityWarningTypeDuplicateLabel:
+        {
+            warningString = @"Duplicate label";
+            break;
+        }
+        case UBKAccessibilityWarningTypeLabelEchoesName:
+        {
+            warningString = @"Label repeats a name";
+            break;
+        }
+        case UBKAccessibilityWarningTypeStateColourContrast:
+        {
+            warningString = @"Colour contrast - States";
+            break;
+        }
+        case UBKAccessibilityWarningTypeAppearanceContrast:
+        {
+            warningString = @"Colour contrast - Appearances";
+            break;
+        }
     }
     return warningString;
 }
@@ -315,6 +385,15 @@
     return warningString;
 }
 
++ (NSString *)titleForElementTitle:(NSString *)title repeatCount:(NSUInteger)repeatCount
+{
+    if (repeatCount <= 1)
+    {
+        return title;
+    }
+    return [NSString stringWithFormat:@"%@ (%lu identical)", title, (unsigned long)repeatCount];
+}
+
 - (void)applyFilter
 {
     self.filteredObjects = [self filterObjects:self.filteredObjects];
@@ -335,15 +414,15 @@
 
 - (BOOL)filterObject:(UIView *)view
 {
-    ///WIP: Check class
-//    if (![self.objectClassNames containsObject:NSStringFromClass([view class])])
-//    {
-//        return false;
-//    }
+    //Check class
+    if (![self.objectClassNames containsObject:@([UBKAccessibilityClassInfo classInfoForView:view].objectClass)])
+    {
+        return false;
+    }
     
     //Check warning type and level
     BOOL addObject = false;
-    NSArray *itemsArray = view.ubk_accessibilityDetails;
+    NSArray *itemsArray = [[UBKAccessibilityManager sharedInstance] accessibilityDetailsForView:view];
     UBKAccessibilitySection *section = [itemsArray ubk_sectionForTitleKey:kUBKAccessibilityAttributeTitle_Warning_Header];
     if (section)
     {
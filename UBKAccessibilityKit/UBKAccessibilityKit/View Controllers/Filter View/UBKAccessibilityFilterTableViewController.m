@@ -45,7 +45,7 @@ typedef enum : NSUInteger {
 {
     [super viewWillDisappear:animated];
     [[UBKAccessibilityManager sharedInstance]removeAllOutlines];
-    [[UBKAccessibilityManager sharedInstance]configureAllUIElments];
+    [[UBKAccessibilityManager sharedInstance]configureAllUIElmentsIncrementally];
 }
 
 - (void)viewDidAppear:(BOOL)animated
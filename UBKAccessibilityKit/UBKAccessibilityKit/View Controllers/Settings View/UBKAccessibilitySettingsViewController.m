@@ -20,6 +20,7 @@
 
 #import "UBKAccessibilitySettingsViewController.h"
 #import "UBKAccessibilityManager.h"
+#import "UBKAccessibilityColourVision.h"
 
 typedef enum : NSUInteger {
     UBKAccessibilitySettingsSectionGlobalAccessibilitySettings,
@@ -28,6 +29,7 @@ typedef enum : NSUInteger {
 
 typedef enum : NSUInteger {
     UBKAccessibilitySettingsVisualShowTouches,
+    UBKAccessibilitySettingsVisualColourVisionSimulation,
 } UBKAccessibilitySettings;
 
 @interface UBKAccessibilitySettingsViewController () <UITableViewDataSource, UITableViewDelegate>
@@ -55,6 +57,13 @@ typedef enum : NSUInteger {
     [UBKAccessibilityManager sharedInstance].isShowingTouchAnimations = toggleSwitch.isOn;
 }
 
+//Steps through each deficiency and back to off
+- (void)selectNextColourVisionSimulation
+{
+    UBKColourVisionDeficiency deficiency = [UBKAccessibilityManager sharedInstance].colourVisionSimulation + 1;
+    [UBKAccessibilityManager sharedInstance].colourVisionSimulation = (deficiency < UBKColourVisionDeficiencyCount) ? deficiency : UBKColourVisionTypical;
+}
+
 #pragma mark - Table view data source
 
 - (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView
@@ -70,7 +79,7 @@ typedef enum : NSUInteger {
     }
     else if (section == UBKAccessibilitySettingsSectionVisual)
     {
-        return 1;
+        return UBKAccessibilitySettingsVisualColourVisionSimulation + 1;
     }
     return 0;
 }
@@ -122,6 +131,13 @@ typedef enum : NSUInteger {
         }
         return cell;
     }
+    else if ((indexPath.section == UBKAccessibilitySettingsSectionVisual) && (indexPath.row == UBKAccessibilitySettingsVisualColourVisionSimulation))
+    {
+        UITableViewCell *cell = [[UITableViewCell alloc]initWithStyle:UITableViewCellStyleValue1 reuseIdentifier:@"Settings"];
+        cell.textLabel.text = @"Simulate colour vision";
+        cell.detailTextLabel.text = [UBKAccessibilityColourVision nameForDeficiency:[UBKAccessibilityManager sharedInstance].colourVisionSimulation];
+        return cell;
+    }
     else if (indexPath.section == UBKAccessibilitySettingsSectionVisual)
     {
         cell.textLabel.text = @"Show touches on screen";
@@ -151,6 +167,11 @@ typedef enum : NSUInteger {
             [toggleSwitch setOn:!toggleSwitch.isOn animated:true];
             [self toggleShowTouches:toggleSwitch];
         }
+        else if (indexPath.row == UBKAccessibilitySettingsVisualColourVisionSimulation)
+        {
+            [self selectNextColourVisionSimulation];
+            [tableView reloadRowsAtIndexPaths:@[indexPath] withRowAnimation:UITableViewRowAnimationNone];
+        }
     }
 }
 
@@ -0,0 +1,142 @@
+/*
+ File: UBKAccessibilityAppearancesTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+
+#import <XCTest/XCTest.h>
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityAppearancesTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityAppearancesTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (UBKAccessibilitySnapshot *)snapshotForContainerView:(UIView *)containerView
+{
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Test"];
+    [snapshot pushView:containerView isElement:false];
+    for (UIView *view in containerView.subviews)
+    {
+        [snapshot pushView:view isElement:true];
+        [snapshot popView];
+    }
+    [snapshot popView];
+    [snapshot finishSnapshot];
+    return snapshot;
+}
+
+- (void)testDynamicColoursAreRatedInEveryAppearance
+{
+    if (@available(iOS 13.0, *))
+    {
+        UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+        containerView.backgroundColor = [UIColor colorWithDynamicProvider:^UIColor * _Nonnull(UITraitCollection * _Nonnull traitCollection) {
+            return (traitCollection.userInterfaceStyle == UIUserInterfaceStyleDark) ? [UIColor blackColor] : [UIColor whiteColor];
+        }];
+        containerView.overrideUserInterfaceStyle = UIUserInterfaceStyleLight;
+        
+        //Fixed dark text only passes in light
+        UILabel *fixedLabel = [[UILabel alloc]initWithFrame:CGRectMake(10, 10, 300, 44)];
+        fixedLabel.text = @"Balance";
+        fixedLabel.font = [UIFont systemFontOfSize:17];
+        fixedLabel.textColor = [UIColor colorWithWhite:0.2 alpha:1];
+        [containerView addSubview:fixedLabel];
+        
+        //Dynamic text only fails with increased contrast, where the provider returns a light grey
+        UILabel *dynamicLabel = [[UILabel alloc]initWithFrame:CGRectMake(10, 100, 300, 44)];
+        dynamicLabel.text = @"Fees";
+        dynamicLabel.font = [UIFont systemFontOfSize:17];
+        dynamicLabel.textColor = [UIColor colorWithDynamicProvider:^UIColor * _Nonnull(UITraitCollection * _Nonnull traitCollection) {
+            BOOL isDark = (traitCollection.userInterfaceStyle == UIUserInterfaceStyleDark);
+            if (traitCollection.accessibilityContrast == UIAccessibilityContrastHigh)
+            {
+                return [UIColor colorWithWhite:0.8 alpha:1];
+            }
+            return isDark ? [UIColor whiteColor] : [UIColor blackColor];
+        }];
+        [containerView addSubview:dynamicLabel];
+        
+        //Views that don't draw text or a template image aren't rated
+        UIView *plainView = [[UIView alloc]initWithFrame:CGRectMake(10, 200, 44, 44)];
+        [containerView addSubview:plainView];
+        
+        UBKAccessibilitySnapshot *snapshot = [self snapshotForContainerView:containerView];
+        UBKAccessibilityAppearances *appearances = [[UBKAccessibilityAppearances alloc]initWithSnapshot:snapshot];
+        XCTAssertEqual(appearances.elementCount, 2);
+        XCTAssertEqual(appearances.failingCount, 2);
+        
+        XCTAssertEqual([UBKAccessibilityAppearances appearanceForView:fixedLabel], UBKAccessibilityAppearanceLight);
+        XCTAssertEqual([appearances failingAppearancesForView:fixedLabel], (1 << UBKAccessibilityAppearanceDark) | (1 << UBKAccessibilityAppearanceDarkIncreasedContrast));
+        XCTAssertTrue([appearances hasWarningForView:fixedLabel]);
+        XCTAssertEqual([appearances failingAppearancesForView:dynamicLabel], (1 << UBKAccessibilityAppearanceLightIncreasedContrast));
+        XCTAssertEqual([appearances failingAppearancesForView:plainView], 0);
+        
+        NSArray <UBKAccessibilityProperty *> *properties = [appearances contrastPropertiesForView:fixedLabel];
+        XCTAssertEqual(properties.count, UBKAccessibilityAppearanceCount);
+        XCTAssertEqualObjects(properties[UBKAccessibilityAppearanceDark].displayTitle, kUBKAccessibilityAttributeTitle_DarkAppearanceContrast);
+        XCTAssertTrue(properties[UBKAccessibilityAppearanceDark].displayWarning);
+        XCTAssertFalse(properties[UBKAccessibilityAppearanceLight].displayWarning);
+        
+        uint64_t subtreeHash = snapshot.nodes[0].subtreeHash;
+        [appearances combineResultsIntoSnapshot];
+        [snapshot updateSubtreeHashes];
+        XCTAssertNotEqual(snapshot.nodes[0].subtreeHash, subtreeHash);
+    }
+}
+
+- (void)testFailingInTheCurrentAppearanceIsLeftToTheContrastCheck
+{
+    if (@available(iOS 13.0, *))
+    {
+        UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+        containerView.backgroundColor = [UIColor whiteColor];
+        containerView.overrideUserInterfaceStyle = UIUserInterfaceStyleLight;
+        UILabel *label = [[UILabel alloc]initWithFrame:CGRectMake(10, 10, 300, 44)];
+        label.text = @"Balance";
+        label.textColor = [UIColor colorWithWhite:0.9 alpha:1];
+        [containerView addSubview:label];
+        
+        UBKAccessibilityAppearances *appearances = [[UBKAccessibilityAppearances alloc]initWithSnapshot:[self snapshotForContainerView:containerView]];
+        XCTAssertEqual([appearances failingAppearancesForView:label], (1 << UBKAccessibilityAppearanceCount) - 1);
+        //Fails in every appearance, the other appearances still get the warning
+        XCTAssertTrue([appearances hasWarningForView:label]);
+        
+        //Only the light appearance fails, which is the one on screen
+        label.textColor = [UIColor colorWithDynamicProvider:^UIColor * _Nonnull(UITraitCollection * _Nonnull traitCollection) {
+            BOOL isLight = (traitCollection.userInterfaceStyle != UIUserInterfaceStyleDark) && (traitCollection.accessibilityContrast != UIAccessibilityContrastHigh);
+            return isLight ? [UIColor colorWithWhite:0.9 alpha:1] : [UIColor blackColor];
+        }];
+        appearances = [[UBKAccessibilityAppearances alloc]initWithSnapshot:[self snapshotForContainerView:containerView]];
+        XCTAssertEqual(appearances.failingCount, 0);
+        XCTAssertFalse([appearances hasWarningForView:label]);
+    }
+}
+
+@end
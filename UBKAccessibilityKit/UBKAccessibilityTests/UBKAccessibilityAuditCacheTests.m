@@ -0,0 +1,153 @@
+/*
+ File: UBKAccessibilityAuditCacheTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityAuditCacheTests : XCTestCase
+@property (nonatomic) UIView *containerView;
+@property (nonatomic) UIView *groupView;
+@property (nonatomic) UILabel *label;
+@property (nonatomic) UIButton *button;
+@end
+
+@implementation UBKAccessibilityAuditCacheTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+    self.containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    self.containerView.backgroundColor = [UIColor whiteColor];
+    self.groupView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 100)];
+    [self.containerView addSubview:self.groupView];
+    self.label = [[UILabel alloc]initWithFrame:CGRectMake(0, 0, 100, 20)];
+    self.label.text = @"test";
+    [self.groupView addSubview:self.label];
+    self.button = [UIButton buttonWithType:UIButtonTypeSystem];
+    self.button.frame = CGRectMake(0, 200, 60, 44);
+    [self.button setTitle:@"Button" forState:UIControlStateNormal];
+    [self.containerView addSubview:self.button];
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (UBKAccessibilitySnapshot *)createSnapshot
+{
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Test"];
+    [self pushView:self.containerView toSnapshot:snapshot];
+    [snapshot finishSnapshot];
+    return snapshot;
+}
+
+- (void)pushView:(UIView *)view toSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    [snapshot pushView:view isElement:(view != self.containerView) && (view != self.groupView)];
+    for (UIView *subview in view.subviews)
+    {
+        [self pushView:subview toSnapshot:snapshot];
+    }
+    [snapshot popView];
+}
+
+- (void)testUnchangedTreeIsReused
+{
+    UBKAccessibilityAuditCache *cache = [[UBKAccessibilityAuditCache alloc]init];
+    [cache updateWithSnapshot:[self createSnapshot]];
+    XCTAssertEqual(cache.reusedNodeCount, 0);
+    XCTAssertEqual(cache.recomputedNodeCount, 4);
+    
+    [cache updateWithSnapshot:[self createSnapshot]];
+    XCTAssertEqual(cache.reusedNodeCount, 4);
+    XCTAssertEqual(cache.recomputedNodeCount, 0);
+}
+
+- (void)testChangedLabelIsRecomputed
+{
+    UBKAccessibilityAuditCache *cache = [[UBKAccessibilityAuditCache alloc]init];
+    [cache updateWithSnapshot:[self createSnapshot]];
+    
+    self.label.textColor = [UIColor colorWithWhite:0.9 alpha:1];
+    [cache updateWithSnapshot:[self createSnapshot]];
+    //Only the label changed, its ancestors are reused node by node and the button subtree is reused whole
+    XCTAssertEqual(cache.recomputedNodeCount, 1);
+    XCTAssertEqual(cache.reusedNodeCount, 3);
+    
+    NSArray *cachedDetails = [cache accessibilityDetailsForView:self.label];
+    XCTAssertEqual(cachedDetails.count, self.label.ubk_accessibilityDetails.count);
+}
+
+- (void)testInheritedBackgroundChangeIsRecomputed
+{
+    UBKAccessibilityAuditCache *cache = [[UBKAccessibilityAuditCache alloc]init];
+    [cache updateWithSnapshot:[self createSnapshot]];
+    
+    //The label and button inherit the container background, so both need to be audited again
+    self.containerView.backgroundColor = [UIColor blackColor];
+    [cache updateWithSnapshot:[self createSnapshot]];
+    XCTAssertEqual(cache.recomputedNodeCount, 4);
+}
+
+- (void)testInvalidate
+{
+    UBKAccessibilityAuditCache *cache = [[UBKAccessibilityAuditCache alloc]init];
+    [cache updateWithSnapshot:[self createSnapshot]];
+    [cache invalidate];
+    [cache updateWithSnapshot:[self createSnapshot]];
+    XCTAssertEqual(cache.reusedNodeCount, 0);
+    XCTAssertEqual(cache.totalRecomputedNodeCount, 8);
+}
+
+- (void)testInvalidateSubtreeOfView
+{
+    UBKAccessibilityAuditCache *cache = [[UBKAccessibilityAuditCache alloc]init];
+    [cache updateWithSnapshot:[self createSnapshot]];
+    
+    //Edit the group and put it back, the hashes match the previous snapshot again but the group and label were edited in between
+    self.groupView.backgroundColor = [UIColor blackColor];
+    [cache invalidateSubtreeOfView:self.groupView];
+    NSArray *details = [cache accessibilityDetailsForView:self.label];
+    XCTAssertEqual(details.count, self.label.ubk_accessibilityDetails.count);
+    self.groupView.backgroundColor = nil;
+    
+    [cache updateWithSnapshot:[self createSnapshot]];
+    XCTAssertEqual(cache.recomputedNodeCount, 2);
+    XCTAssertEqual(cache.reusedNodeCount, 2);
+}
+
+- (void)testInvalidateSubtreeUpdatesTheBackgrounds
+{
+    UBKAccessibilityAuditCache *cache = [[UBKAccessibilityAuditCache alloc]init];
+    UBKAccessibilitySnapshot *snapshot = [self createSnapshot];
+    [cache updateWithSnapshot:snapshot];
+    NSInteger labelIndex = [snapshot indexOfView:self.label];
+    NSInteger buttonIndex = [snapshot indexOfView:self.button];
+    UBKColourValue buttonBackground = [snapshot backgroundColourValueAtIndex:buttonIndex];
+    
+    //The label is drawn on the edited group, the button isn't in the edited subtree
+    self.groupView.backgroundColor = [UIColor blackColor];
+    [cache invalidateSubtreeOfView:self.groupView];
+    XCTAssertTrue(UBKColourValueEqual([snapshot backgroundColourValueAtIndex:labelIndex], [UIColor blackColor].ubk_colourValue));
+    XCTAssertTrue(UBKColourValueEqual([snapshot backgroundColourValueAtIndex:buttonIndex], buttonBackground));
+}
+
+@end
@@ -0,0 +1,237 @@
+/*
+ File: UBKAccessibilityAuditStoreTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityAuditStoreTests : XCTestCase
+@property (nonatomic) NSURL *fileURL;
+@end
+
+@implementation UBKAccessibilityAuditStoreTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+    self.fileURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()]URLByAppendingPathComponent:[NSString stringWithFormat:@"%@.audits", [NSUUID UUID].UUIDString]];
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+    [[NSFileManager defaultManager]removeItemAtURL:self.fileURL error:nil];
+}
+
+- (UBKAuditRecord)recordForScreen:(uint64_t)screen element:(uint64_t)element build:(uint64_t)build warningType:(UBKAccessibilityWarningType)warningType timestamp:(int64_t)timestamp
+{
+    UBKAuditRecord record;
+    memset(&record, 0, sizeof(UBKAuditRecord));
+    record.screen = screen;
+    record.element = element;
+    record.build = build;
+    record.warningMask = 1ULL << warningType;
+    record.timestamp = timestamp;
+    return record;
+}
+
+- (void)testIndexedQueriesMatchScan
+{
+    UBKAuditStore store;
+    XCTAssertTrue(UBKAuditStoreOpen(&store, self.fileURL.fileSystemRepresentation, false));
+    
+    //More records than the initial capacity so the file has to grow
+    const size_t count = 5000;
+    UBKAuditRecord *records = malloc(count * sizeof(UBKAuditRecord));
+    for (size_t i = 0; i < count; i++)
+    {
+        records[i] = [self recordForScreen:1 + (i % 13) element:i % 97 build:1 + (i % 3) warningType:(UBKAccessibilityWarningType)(i % 7) timestamp:1000 + (int64_t)i];
+    }
+    XCTAssertTrue(UBKAuditStoreAppend(&store, records, count));
+    XCTAssertEqual(UBKAuditStoreCount(&store), count);
+    
+    UBKAuditQuery queries[4] = {
+        { 1ULL << 3, 0, 0, 0, 0 },
+        { 0, 5, 0, 0, 0 },
+        { 1ULL << 2, 4, 2, 0, 0 },
+        { (1ULL << 1) | (1ULL << 4), 0, 0, 2000, 3000 }
+    };
+    for (int q = 0; q < 4; q++)
+    {
+        UBKAuditQuery query = queries[q];
+        uint64_t expected = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            const UBKAuditRecord *record = &records[i];
+            if (((query.warningMask == 0) || (record->warningMask & query.warningMask)) && ((query.screen == 0) || (record->screen == query.screen)) && ((query.build == 0) || (record->build == query.build)) && (record->timestamp >= query.fromTimestamp) && ((query.toTimestamp == 0) || (record->timestamp < query.toTimestamp)))
+            {
+                expected++;
+            }
+        }
+        XCTAssertEqual(UBKAuditStoreQuery(&store, &query, NULL, NULL), expected);
+    }
+    
+    UBKAuditQuery missingScreen = { 0, 99, 0, 0, 0 };
+    XCTAssertEqual(UBKAuditStoreQuery(&store, &missingScreen, NULL, NULL), 0);
+    UBKAuditStoreClose(&store);
+    free(records);
+}
+
+- (void)testReopenAndCompact
+{
+    UBKAccessibilityAuditStore *auditStore = [[UBKAccessibilityAuditStore alloc]initWithFileURL:self.fileURL buildIdentifier:@"1.0 (1)"];
+    XCTAssertNotNil(auditStore);
+    uint64_t build = auditStore.buildHash;
+    UBKAuditRecord records[4] = {
+        [self recordForScreen:1 element:1 build:build warningType:UBKAccessibilityWarningTypeColourContrast timestamp:100],
+        [self recordForScreen:1 element:1 build:build warningType:UBKAccessibilityWarningTypeColourContrast timestamp:200],
+        [self recordForScreen:2 element:1 build:build warningType:UBKAccessibilityWarningTypeColourContrast timestamp:300],
+        [self recordForScreen:2 element:2 build:build warningType:UBKAccessibilityWarningTypeMinimumSize timestamp:400]
+    };
+    XCTAssertTrue([auditStore appendRecords:records count:4]);
+    [auditStore close];
+    
+    auditStore = [[UBKAccessibilityAuditStore alloc]initWithFileURL:self.fileURL buildIdentifier:@"1.0 (1)"];
+    XCTAssertEqual(auditStore.recordCount, 4);
+    UBKAuditQuery contrastQuery = { 1ULL << UBKAccessibilityWarningTypeColourContrast, 0, build, 0, 0 };
+    NSSet *screens = [auditStore screensMatchingQuery:contrastQuery];
+    XCTAssertEqualObjects(screens, ([NSSet setWithObjects:@(1), @(2), nil]));
+    
+    //The repeat on screen one is dropped, the newest copy is kept
+    XCTAssertTrue([auditStore compactRemovingRecordsOlderThan:nil]);
+    XCTAssertEqual(auditStore.recordCount, 3);
+    __block int64_t timestamp = 0;
+    UBKAuditQuery screenQuery = { 0, 1, 0, 0, 0 };
+    [auditStore enumerateRecordsMatchingQuery:screenQuery usingBlock:^(const UBKAuditRecord *record, BOOL *stop) {
+        timestamp = record->timestamp;
+    }];
+    XCTAssertEqual(timestamp, 200);
+    
+    XCTAssertTrue([auditStore compactRemovingRecordsOlderThan:[NSDate dateWithTimeIntervalSince1970:350]]);
+    XCTAssertEqual(auditStore.recordCount, 1);
+}
+
+- (void)testRecorderWritesToStore
+{
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    UIButton *button = [UIButton buttonWithType:UIButtonTypeSystem];
+    button.frame = CGRectMake(0, 40, 20, 20);
+    [containerView addSubview:button];
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"StoreScreen"];
+    [snapshot pushView:containerView isElement:false];
+    [snapshot pushView:button isElement:true];
+    [snapshot popView];
+    [snapshot popView];
+    [snapshot finishSnapshot];
+    
+    NSURL *recorderURL = [self.fileURL URLByAppendingPathExtension:@"jsonl"];
+    UBKAccessibilitySessionRecorder *recorder = [[UBKAccessibilitySessionRecorder alloc]initWithFileURL:recorderURL capacity:2];
+    recorder.auditStore = [[UBKAccessibilityAuditStore alloc]initWithFileURL:self.fileURL];
+    [recorder recordSnapshot:snapshot];
+    [recorder closeFile];
+    [[NSFileManager defaultManager]removeItemAtURL:recorderURL error:nil];
+    
+    UBKAuditQuery query = { 1ULL << UBKAccessibilityWarningTypeMinimumSize, snapshot.fingerprint, 0, 0, 0 };
+    __block UBKAuditRecord found;
+    memset(&found, 0, sizeof(UBKAuditRecord));
+    XCTAssertEqual([recorder.auditStore countRecordsMatchingQuery:query], 1);
+    [recorder.auditStore enumerateRecordsMatchingQuery:query usingBlock:^(const UBKAuditRecord *record, BOOL *stop) {
+        found = *record;
+    }];
+    XCTAssertEqualWithAccuracy(found.width, 20, 0.001);
+    XCTAssertEqual(found.build, recorder.auditStore.buildHash);
+    
+    //The screen's marker is stored with the element's record
+    UBKAuditQuery screenQuery = { 0, snapshot.fingerprint, 0, 0, 0 };
+    __block NSUInteger markerCount = 0;
+    [recorder.auditStore enumerateRecordsMatchingQuery:screenQuery usingBlock:^(const UBKAuditRecord *record, BOOL *stop) {
+        markerCount += UBKAuditRecordIsScreenMarker(record) ? 1 : 0;
+    }];
+    XCTAssertEqual([recorder.auditStore countRecordsMatchingQuery:screenQuery], 2);
+    XCTAssertEqual(markerCount, 1);
+}
+
+- (void)testDiffBetweenBuilds
+{
+    UBKAuditRecord base[4] = {
+        [self recordForScreen:1 element:10 build:1 warningType:UBKAccessibilityWarningTypeColourContrast timestamp:100],
+        [self recordForScreen:1 element:11 build:1 warningType:UBKAccessibilityWarningTypeMinimumSize timestamp:100],
+        //Two cells sharing a key, paired by frame
+        [self recordForScreen:1 element:12 build:1 warningType:UBKAccessibilityWarningTypeMinimumSize timestamp:100],
+        [self recordForScreen:1 element:12 build:1 warningType:UBKAccessibilityWarningTypeColourContrast timestamp:100]
+    };
+    base[2].y = 0;
+    base[3].y = 44;
+    UBKAuditRecord head[4] = {
+        [self recordForScreen:1 element:10 build:2 warningType:UBKAccessibilityWarningTypeColourContrast timestamp:200],
+        [self recordForScreen:1 element:12 build:2 warningType:UBKAccessibilityWarningTypeColourContrast timestamp:200],
+        [self recordForScreen:1 element:12 build:2 warningType:UBKAccessibilityWarningTypeMinimumSize timestamp:200],
+        //Only audited in the head build, not compared
+        [self recordForScreen:2 element:10 build:2 warningType:UBKAccessibilityWarningTypeColourContrast timestamp:200]
+    };
+    head[1].y = 44;
+    head[2].y = 0;
+    
+    UBKAuditDiff diff;
+    UBKAuditDiffInit(&diff);
+    XCTAssertTrue(UBKAuditDiffCompute(&diff, base, 4, head, 4));
+    XCTAssertEqual(diff.comparedScreenCount, 1);
+    XCTAssertEqual(diff.headOnlyScreenCount, 1);
+    XCTAssertEqual(diff.changedCount, 0);
+    XCTAssertEqual(diff.addedCount, 0);
+    XCTAssertEqual(diff.removedCount, 1);
+    XCTAssertEqual(diff.entries[0].baseIndex, 1);
+    XCTAssertEqual(diff.entries[0].removedWarnings, 1ULL << UBKAccessibilityWarningTypeMinimumSize);
+    
+    //A warning added to an element that already had one
+    head[0].warningMask |= 1ULL << UBKAccessibilityWarningTypeMinimumSize;
+    XCTAssertTrue(UBKAuditDiffCompute(&diff, base, 4, head, 4));
+    XCTAssertEqual(diff.changedCount, 1);
+    XCTAssertEqual(diff.entries[0].kind, UBKAuditDiffKindChanged);
+    XCTAssertEqual(diff.entries[0].addedWarnings, 1ULL << UBKAccessibilityWarningTypeMinimumSize);
+    UBKAuditDiffDestroy(&diff);
+}
+
+- (void)testElementKeys
+{
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    UILabel *firstLabel = [[UILabel alloc]initWithFrame:CGRectMake(0, 0, 100, 20)];
+    [containerView addSubview:firstLabel];
+    UILabel *secondLabel = [[UILabel alloc]initWithFrame:CGRectMake(0, 40, 100, 20)];
+    [containerView addSubview:secondLabel];
+    UILabel *identifiedLabel = [[UILabel alloc]initWithFrame:CGRectMake(0, 80, 100, 20)];
+    identifiedLabel.accessibilityIdentifier = @"title";
+    [containerView addSubview:identifiedLabel];
+    
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Keys"];
+    [snapshot pushView:containerView isElement:false];
+    for (UIView *view in containerView.subviews)
+    {
+        [snapshot pushView:view isElement:true];
+        [snapshot popView];
+    }
+    [snapshot popView];
+    
+    uint64_t keys[4];
+    [snapshot getElementKeys:keys];
+    XCTAssertEqual(keys[1], keys[2], @"Labels without identifiers share their class path");
+    XCTAssertNotEqual(keys[1], keys[3]);
+}
+
+@end
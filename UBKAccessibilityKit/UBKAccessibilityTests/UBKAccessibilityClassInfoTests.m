@@ -0,0 +1,156 @@
+/*
+ File: UBKAccessibilityClassInfoTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityClassInfoTestButton : UIButton
+@end
+
+@implementation UBKAccessibilityClassInfoTestButton
+@end
+
+@interface UBKAccessibilityClassInfoTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityClassInfoTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (void)testClassInfoIsSharedByEveryViewOfAClass
+{
+    UILabel *labelOne = [[UILabel alloc]init];
+    UILabel *labelTwo = [[UILabel alloc]init];
+    UBKAccessibilityClassInfo *classInfo = [UBKAccessibilityClassInfo classInfoForView:labelOne];
+    XCTAssertEqual(classInfo, [UBKAccessibilityClassInfo classInfoForView:labelTwo]);
+    XCTAssertFalse(classInfo.isPrivate);
+    XCTAssertEqual(classInfo.objectClass, UBKAccessibilityObjectClassUILabel);
+    XCTAssertEqual(classInfo.rules, UBKAccessibilityClassRuleText);
+    XCTAssertEqualObjects(classInfo.iconName, [labelOne ubk_classIconName]);
+    XCTAssertNotEqual(classInfo.classHash, [UBKAccessibilityClassInfo classInfoForView:[[UIView alloc]init]].classHash);
+}
+
+- (void)testSubclassesAreClassified
+{
+    UBKAccessibilityClassInfo *buttonInfo = [UBKAccessibilityClassInfo classInfoForView:[[UBKAccessibilityClassInfoTestButton alloc]init]];
+    XCTAssertNotEqual(buttonInfo, [UBKAccessibilityClassInfo classInfoForView:[[UIButton alloc]init]]);
+    XCTAssertEqual(buttonInfo.objectClass, UBKAccessibilityObjectClassUIButton);
+    XCTAssertTrue(buttonInfo.rules & UBKAccessibilityClassRuleControlStates);
+    
+    //Controls the filter doesn't list are still touch targets
+    UBKAccessibilityClassInfo *stepperInfo = [UBKAccessibilityClassInfo classInfoForView:[[UIStepper alloc]init]];
+    XCTAssertEqual(stepperInfo.objectClass, UBKAccessibilityObjectClassUIView);
+    XCTAssertEqual(stepperInfo.rules, UBKAccessibilityClassRuleTouchTarget);
+    XCTAssertEqual([UBKAccessibilityClassInfo classInfoForView:[[UIImageView alloc]init]].rules, 0);
+}
+
+- (void)testAuditView
+{
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    containerView.backgroundColor = [UIColor whiteColor];
+    UILabel *label = [[UILabel alloc]initWithFrame:CGRectMake(10, 10, 300, 44)];
+    label.text = @"Balance";
+    label.textColor = [UIColor colorWithWhite:0.9 alpha:1];
+    [containerView addSubview:label];
+    UIButton *button = [UIButton buttonWithType:UIButtonTypeSystem];
+    button.frame = CGRectMake(10, 100, 100, 44);
+    [button setTitle:@"Pay" forState:UIControlStateNormal];
+    [containerView addSubview:button];
+    
+    //The component doesn't have to be on screen, and the view passed in is audited as well
+    UBKAccessibilityComponentAudit *componentAudit = [[UBKAccessibilityManager sharedInstance] auditView:containerView];
+    XCTAssertTrue([componentAudit.elements containsObject:containerView]);
+    XCTAssertTrue([componentAudit.elements containsObject:label]);
+    XCTAssertTrue([componentAudit.elements containsObject:button]);
+    
+    UBKAccessibilitySection *section = [[componentAudit accessibilityDetailsForView:label] ubk_sectionForTitleKey:kUBKAccessibilityAttributeTitle_Warning_Header];
+    XCTAssertNotNil([section getPropertyForTitleKey:kUBKAccessibilityAttributeTitle_Warning_ColourContrast]);
+    
+    //A single view on its own
+    componentAudit = [[UBKAccessibilityManager sharedInstance] auditView:button];
+    XCTAssertEqualObjects(componentAudit.elements, @[button]);
+}
+
+- (void)testAuditViewController
+{
+    UIViewController *viewController = [[UIViewController alloc]init];
+    viewController.view.frame = CGRectMake(0, 0, 320, 480);
+    UISwitch *switchView = [[UISwitch alloc]initWithFrame:CGRectMake(10, 10, 51, 31)];
+    [viewController.view addSubview:switchView];
+    
+    UBKAccessibilityComponentAudit *componentAudit = [[UBKAccessibilityManager sharedInstance] auditViewController:viewController];
+    XCTAssertTrue([componentAudit.elements containsObject:switchView]);
+    XCTAssertEqualObjects(componentAudit.snapshot.screenName, @"UIViewController");
+}
+
+- (void)testAuditViewLeavesWindowResults
+{
+    UBKAccessibilityManager *manager = [UBKAccessibilityManager sharedInstance];
+    UIWindow *window = [[UIWindow alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    window.backgroundColor = [UIColor whiteColor];
+    UILabel *windowLabel = [[UILabel alloc]initWithFrame:CGRectMake(10, 10, 300, 44)];
+    windowLabel.text = @"Balance";
+    windowLabel.textColor = [UIColor colorWithWhite:0.9 alpha:1];
+    [window addSubview:windowLabel];
+    UBKAccessibilityHierarchyWalker *hierarchyWalker = [manager hierarchyWalkerForWindow:window];
+    [hierarchyWalker walkToEnd];
+    [manager auditHierarchyWalk:hierarchyWalker visibleBounds:window.bounds walkDuration:0];
+    
+    UBKAccessibilitySnapshot *windowSnapshot = manager.currentSnapshot;
+    UBKAccessibilityScreenPasses *windowPasses = manager.currentPasses;
+    NSArray *windowElements = [manager.accessibilityFilter.filteredObjects copy];
+    NSArray <UBKAccessibilitySection *> *windowDetails = [manager accessibilityDetailsForView:windowLabel];
+    XCTAssertTrue([windowElements containsObject:windowLabel]);
+    
+    //A component with a label that reads the same, it would be a duplicate label if it was audited with the window
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 100)];
+    containerView.backgroundColor = [UIColor blackColor];
+    UILabel *componentLabel = [[UILabel alloc]initWithFrame:CGRectMake(10, 10, 300, 44)];
+    componentLabel.text = @"Balance";
+    componentLabel.textColor = [UIColor whiteColor];
+    [containerView addSubview:componentLabel];
+    UBKAccessibilityComponentAudit *componentAudit = [manager auditView:containerView];
+    XCTAssertTrue([componentAudit.elements containsObject:componentLabel]);
+    XCTAssertNotEqual(componentAudit.snapshot, windowSnapshot);
+    
+    XCTAssertEqual(manager.currentSnapshot, windowSnapshot);
+    XCTAssertEqual(manager.currentPasses, windowPasses);
+    XCTAssertEqualObjects(manager.accessibilityFilter.filteredObjects, windowElements);
+    XCTAssertEqual([manager accessibilityDetailsForView:windowLabel], windowDetails);
+    XCTAssertFalse([manager.accessibilityFilter.filteredObjects containsObject:componentLabel]);
+    
+    //Each is rated against its own background
+    UBKAccessibilitySection *windowWarnings = [windowDetails ubk_sectionForTitleKey:kUBKAccessibilityAttributeTitle_Warning_Header];
+    XCTAssertNotNil([windowWarnings getPropertyForTitleKey:kUBKAccessibilityAttributeTitle_Warning_ColourContrast]);
+    UBKAccessibilitySection *componentWarnings = [[componentAudit accessibilityDetailsForView:componentLabel] ubk_sectionForTitleKey:kUBKAccessibilityAttributeTitle_Warning_Header];
+    XCTAssertNil([componentWarnings getPropertyForTitleKey:kUBKAccessibilityAttributeTitle_Warning_ColourContrast]);
+}
+
+@end
@@ -55,4 +55,80 @@
     XCTAssertEqualWithAccuracy(contrastRatioFive, 1.43, 0.01);
 }
 
+//Colours from other colour spaces convert to the same canonical value
+- (void)testColourValueConversion
+{
+    UIColor *greyColour = [UIColor colorWithWhite:0.5 alpha:1];
+    UIColor *rgbColour = [UIColor colorWithRed:0.5 green:0.5 blue:0.5 alpha:1];
+    XCTAssertTrue([greyColour ubk_isEqualToColour:rgbColour]);
+    XCTAssertEqualWithAccuracy([greyColour ubk_contrastRatio:[UIColor whiteColor]], [rgbColour ubk_contrastRatio:[UIColor whiteColor]], 0.001);
+    XCTAssertEqualObjects([greyColour ubk_hexStringFromColour], @"#808080");
+    
+    //Display P3 red is outside sRGB, it keeps its own luminance rather than coming back as black
+    UIColor *displayP3Red = [UIColor colorWithDisplayP3Red:1 green:0 blue:0 alpha:1];
+    UBKColourValue displayP3Value = displayP3Red.ubk_colourValue;
+    XCTAssertTrue(displayP3Value.hasComponents);
+    XCTAssertGreaterThan(displayP3Value.linear[0], 1);
+    XCTAssertLessThan(displayP3Value.linear[1], 0);
+    XCTAssertEqualObjects([displayP3Red ubk_hexStringFromColour], @"#FF0000");
+    XCTAssertGreaterThan(displayP3Value.luminance, [UIColor redColor].ubk_colourValue.luminance);
+    
+    UIColor *hexColour = [UIColor ubk_colourFromHexString:@"646464"];
+    XCTAssertTrue([hexColour ubk_isEqualToColour:[UIColor colorWithRed:100/255.0 green:100/255.0 blue:100/255.0 alpha:1]]);
+    XCTAssertFalse([hexColour ubk_isEqualToColour:[UIColor colorWithRed:101/255.0 green:100/255.0 blue:100/255.0 alpha:1]]);
+    XCTAssertFalse([hexColour ubk_isEqualToColour:nil]);
+}
+
+//Pattern colours have no contrast ratio instead of being treated as black
+- (void)testPatternColourContrast
+{
+    UIGraphicsBeginImageContext(CGSizeMake(2, 2));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    UIColor *patternColour = [UIColor colorWithPatternImage:image];
+    XCTAssertFalse(patternColour.ubk_colourValue.hasComponents);
+    XCTAssertEqual([UBKAccessibilityValidation getViewContrastRatio:[UIColor whiteColor] backgroundColor:patternColour], 0);
+}
+
+//Translucent backgrounds, view alpha and text alpha are composited instead of being treated as opaque
+- (void)testTranslucentBackgroundCompositing
+{
+    UBKColourValue white = [UIColor whiteColor].ubk_colourValue;
+    UBKColourValue halfBlack = [UIColor colorWithWhite:0 alpha:0.5].ubk_colourValue;
+    UBKColourValue composited = UBKColourValueComposite(halfBlack, 1, white);
+    XCTAssertEqual(composited.linear[3], 1);
+    XCTAssertEqualWithAccuracy(UBKColourValueEncodedFromLinear(composited.linear[0]), 0.5, 0.01);
+    XCTAssertEqual(UBKColourValueComposite(halfBlack, 1, UBKColourValueMakeUnknown()).key, halfBlack.key);
+    XCTAssertEqual(UBKColourValueComposite([UIColor blackColor].ubk_colourValue, 0, white).key, white.key);
+    
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    containerView.backgroundColor = [UIColor whiteColor];
+    UIView *cardView = [[UIView alloc]initWithFrame:CGRectMake(10, 10, 300, 200)];
+    cardView.backgroundColor = [UIColor colorWithWhite:0 alpha:0.5];
+    [containerView addSubview:cardView];
+    UILabel *label = [[UILabel alloc]initWithFrame:CGRectMake(10, 10, 200, 20)];
+    label.textColor = [UIColor colorWithWhite:0 alpha:0.5];
+    label.alpha = 0.5;
+    [cardView addSubview:label];
+    
+    UIColor *background = [UBKAccessibilityValidation getEffectiveBackgroundColour:label];
+    XCTAssertTrue([background ubk_isEqualToColour:[UIColor ubk_colourWithColourValue:composited]]);
+    UIColor *foreground = [UBKAccessibilityValidation getEffectiveForegroundColour:label.textColor forView:label backgroundColour:background];
+    UBKColourValue expected = UBKColourValueComposite(halfBlack, 0.5, composited);
+    XCTAssertTrue([foreground ubk_isEqualToColour:[UIColor ubk_colourWithColourValue:expected]]);
+    XCTAssertLessThan([UBKAccessibilityValidation getViewContrastRatio:foreground backgroundColor:background], [UBKAccessibilityValidation getViewContrastRatio:label.textColor backgroundColor:background]);
+    
+    //The snapshot composites the same way in one pass
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Test"];
+    [snapshot pushView:containerView isElement:false];
+    [snapshot pushView:cardView isElement:true];
+    [snapshot pushView:label isElement:true];
+    [snapshot popView];
+    [snapshot popView];
+    [snapshot popView];
+    XCTAssertEqual([snapshot backgroundColourValueAtIndex:2].key, composited.key);
+    XCTAssertEqual([snapshot opacityAtIndex:2], 0.5);
+    XCTAssertEqual([snapshot backgroundColourValueAtIndex:0].key, white.key);
+}
+
 @end
@@ -0,0 +1,122 @@
+/*
+ File: UBKAccessibilityColourTokensTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityColourTokensTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityColourTokensTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (NSString *)tokensJSON
+{
+    return @"{\"color\": {\"light\": {\"background\": {\"$value\": \"#FFFFFF\", \"$type\": \"color\"}, \"text\": {\"value\": \"#000\"}, \"spacing\": 12},"
+            " \"dark\": {\"background\": {\"$value\": \"#000000\"}, \"text\": \"rgb(255, 255, 255)\", \"accent\": \"#0FA11580\"}}}";
+}
+
+- (void)testColourParsing
+{
+    uint32_t colour = 0;
+    XCTAssertTrue(UBKColourTokensParseColour("#F80", 4, &colour));
+    XCTAssertEqual(colour, 0xFF8800FF);
+    XCTAssertTrue(UBKColourTokensParseColour("rgba(255, 0, 0, 0.5)", 20, &colour));
+    XCTAssertEqual(colour, 0xFF000080);
+    XCTAssertFalse(UBKColourTokensParseColour("#FFFFF", 6, &colour));
+    XCTAssertFalse(UBKColourTokensParseColour("red", 3, &colour));
+    
+    XCTAssertNil([UIColor ubk_colourFromHexString:@"zzzzzz"]);
+    XCTAssertTrue([[UIColor ubk_colourFromHexString:@"#ffffff"] ubk_isEqualToColour:[UIColor whiteColor]]);
+}
+
+//Chunks can end anywhere, including inside keys and strings
+- (void)testTokensAreDeduplicatedAcrossChunks
+{
+    const char *json = [self tokensJSON].UTF8String;
+    size_t length = strlen(json);
+    for (size_t chunkSize = 1; chunkSize <= length; chunkSize += 7)
+    {
+        UBKColourTokens tokens;
+        UBKColourTokensInit(&tokens);
+        for (size_t i = 0; i < length; i += chunkSize)
+        {
+            UBKColourTokensParse(&tokens, json + i, MIN(chunkSize, length - i));
+        }
+        XCTAssertTrue(UBKColourTokensFinish(&tokens));
+        XCTAssertEqual(tokens.tokenCount, 5);
+        XCTAssertEqual(tokens.count, 3);
+        XCTAssertEqualObjects(@(UBKColourTokensName(&tokens, &tokens.entries[0])), @"color.light.background");
+        XCTAssertEqual(tokens.entries[0].tokenCount, 2);
+        XCTAssertEqualObjects(@(UBKColourTokensName(&tokens, &tokens.entries[1])), @"color.light.text");
+        XCTAssertEqual(UBKColourTokensFind(&tokens, 0x0FA11580), 2);
+        UBKColourTokensDestroy(&tokens);
+    }
+}
+
+- (void)testLoadDesignTokens
+{
+    UBKAccessibilityColours *colours = [[UBKAccessibilityColours alloc]init];
+    XCTAssertTrue([colours loadDesignTokensFromData:[[self tokensJSON] dataUsingEncoding:NSUTF8StringEncoding]]);
+    XCTAssertEqual(colours.defaultColoursArray.count, 3);
+    XCTAssertEqualObjects(colours.defaultColoursArray[0].displayTitle, @"color.light.background");
+    
+    //Already in the palette
+    [colours addDefaultColour:[UIColor blackColor] withTitle:@"Black"];
+    XCTAssertEqual(colours.defaultColoursArray.count, 3);
+    
+    //Malformed JSON keeps the current colours
+    XCTAssertFalse([colours loadDesignTokensFromData:[@"{\"color\": " dataUsingEncoding:NSUTF8StringEncoding]]);
+    XCTAssertEqual(colours.defaultColoursArray.count, 3);
+}
+
+- (void)testLoadPerformance
+{
+    //100k tokens, light and dark variants of 50k names sharing 4k colours
+    NSMutableString *json = [[NSMutableString alloc]initWithString:@"{\"color\": {"];
+    for (NSString *mode in @[@"light", @"dark"])
+    {
+        [json appendFormat:@"%@\"%@\": {", [mode isEqualToString:@"light"] ? @"" : @", ", mode];
+        for (NSUInteger i = 0; i < 50000; i++)
+        {
+            [json appendFormat:@"%@\"token%lu\": {\"$value\": \"#%06lX\", \"$type\": \"color\"}", (i > 0) ? @", " : @"", (unsigned long)i, (unsigned long)(((i * 7919) % 4000) * 4099) & 0xFFFFFF];
+        }
+        [json appendString:@"}"];
+    }
+    [json appendString:@"}}"];
+    NSData *data = [json dataUsingEncoding:NSUTF8StringEncoding];
+    
+    [self measureBlock:^{
+        UBKAccessibilityColours *colours = [[UBKAccessibilityColours alloc]init];
+        XCTAssertTrue([colours loadDesignTokensFromData:data]);
+        XCTAssertEqual(colours.defaultColoursArray.count, 4000);
+    }];
+}
+
+@end
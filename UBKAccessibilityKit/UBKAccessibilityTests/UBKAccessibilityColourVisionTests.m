@@ -0,0 +1,199 @@
+/*
+ File: UBKAccessibilityColourVisionTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityColourVisionTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityColourVisionTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (void)testTypicalVisionMatchesContrastRatio
+{
+    NSArray *foregroundColours = @[[UIColor blackColor], [UIColor redColor], [UIColor colorWithRed:0.2 green:0.4 blue:0.6 alpha:1]];
+    NSArray *backgroundColours = @[[UIColor whiteColor], [UIColor greenColor], [UIColor colorWithRed:0.9 green:0.8 blue:0.7 alpha:1]];
+    UBKAccessibilityColourVision *colourVision = [[UBKAccessibilityColourVision alloc]initWithForegroundColours:foregroundColours backgroundColours:backgroundColours];
+    XCTAssertEqual(colourVision.pairCount, 3);
+    for (NSUInteger i = 0; i < foregroundColours.count; i++)
+    {
+        double expected = [foregroundColours[i] ubk_contrastRatio:backgroundColours[i]];
+        XCTAssertEqualWithAccuracy([colourVision contrastRatioForPairAtIndex:i deficiency:UBKColourVisionTypical], expected, 0.01);
+    }
+}
+
+- (void)testBatchAcrossChunks
+{
+    //More pairs than a single kernel chunk, the last pair should still be evaluated
+    NSMutableArray *foregroundColours = [[NSMutableArray alloc]init];
+    NSMutableArray *backgroundColours = [[NSMutableArray alloc]init];
+    for (NSUInteger i = 0; i < 100; i++)
+    {
+        [foregroundColours addObject:[UIColor redColor]];
+        [backgroundColours addObject:[UIColor blackColor]];
+    }
+    [foregroundColours addObject:[UIColor blackColor]];
+    [backgroundColours addObject:[UIColor whiteColor]];
+    
+    UBKAccessibilityColourVision *colourVision = [[UBKAccessibilityColourVision alloc]initWithForegroundColours:foregroundColours backgroundColours:backgroundColours];
+    XCTAssertEqualWithAccuracy([colourVision contrastRatioForPairAtIndex:99 deficiency:UBKColourVisionTypical], 5.25, 0.01);
+    XCTAssertLessThan([colourVision contrastRatioForPairAtIndex:99 deficiency:UBKColourVisionProtanopia], 4.5);
+    for (UBKColourVisionDeficiency deficiency = UBKColourVisionTypical; deficiency < UBKColourVisionDeficiencyCount; deficiency++)
+    {
+        XCTAssertEqualWithAccuracy([colourVision contrastRatioForPairAtIndex:100 deficiency:deficiency], 21, 0.01);
+    }
+}
+
+- (void)testLabelColourVisionWarning
+{
+    //Red on black passes AA for typical vision but not for protanopia
+    UILabel *label = [[UILabel alloc]initWithFrame:CGRectMake(0, 0, 100, 20)];
+    label.text = @"Error";
+    label.font = [UIFont systemFontOfSize:14];
+    label.textColor = [UIColor redColor];
+    label.backgroundColor = [UIColor blackColor];
+    
+    NSArray *warnings = [UBKAccessibilityValidation checkColourVisionWarningsForText:label.textColor backgroundColor:label.backgroundColor withTextSize:label.font.pointSize withBoldFont:false];
+    XCTAssertTrue([warnings containsObject:@(UBKAccessibilityWarningTypeColourVisionProtanopia)]);
+    XCTAssertFalse([warnings containsObject:@(UBKAccessibilityWarningTypeColourVisionDeuteranopia)]);
+    
+    BOOL foundWarning = false;
+    for (UBKAccessibilitySection *section in label.ubk_accessibilityDetails)
+    {
+        if (section.sectionType == SectionDisplayTypeWarnings)
+        {
+            for (UBKAccessibilityProperty *property in section.items)
+            {
+                if (property.warningType == UBKAccessibilityWarningTypeColourVisionProtanopia)
+                {
+                    foundWarning = true;
+                }
+            }
+        }
+    }
+    XCTAssertTrue(foundWarning);
+}
+
+- (void)testFailingContrastHasNoColourVisionWarning
+{
+    NSArray *warnings = [UBKAccessibilityValidation checkColourVisionWarningsForText:[UIColor lightGrayColor] backgroundColor:[UIColor whiteColor] withTextSize:14 withBoldFont:false];
+    XCTAssertEqual(warnings.count, 0);
+}
+
+- (void)testScreenPassSharesPairs
+{
+    //Three red on black labels and a template icon on a black container, the labels share one pair
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 200)];
+    containerView.backgroundColor = [UIColor blackColor];
+    NSMutableArray <UIView *> *views = [[NSMutableArray alloc]init];
+    for (NSUInteger i = 0; i < 3; i++)
+    {
+        UILabel *label = [[UILabel alloc]initWithFrame:CGRectMake(0, i * 30, 100, 20)];
+        label.text = @"Error";
+        label.textColor = [UIColor redColor];
+        [views addObject:label];
+    }
+    UIGraphicsBeginImageContext(CGSizeMake(20, 20));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    UIImageView *iconView = [[UIImageView alloc]initWithImage:[image imageWithRenderingMode:UIImageRenderingModeAlwaysTemplate]];
+    iconView.tintColor = [UIColor whiteColor];
+    [views addObject:iconView];
+    
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Test"];
+    [snapshot pushView:containerView isElement:false];
+    for (UIView *view in views)
+    {
+        [containerView addSubview:view];
+        [snapshot pushView:view isElement:true];
+        [snapshot popView];
+    }
+    [snapshot popView];
+    [snapshot finishSnapshot];
+    
+    UBKAccessibilityColourVision *colourVision = [[UBKAccessibilityColourVision alloc]initWithSnapshot:snapshot];
+    XCTAssertEqual(colourVision.pairCount, 2);
+    NSUInteger labelPair = [colourVision indexOfPairWithForegroundColour:[UIColor redColor] backgroundColour:[UIColor blackColor]];
+    XCTAssertNotEqual(labelPair, NSNotFound);
+    XCTAssertEqualWithAccuracy([colourVision contrastRatioForPairAtIndex:labelPair deficiency:UBKColourVisionTypical], 5.25, 0.01);
+    XCTAssertLessThan([colourVision contrastRatioForPairAtIndex:labelPair deficiency:UBKColourVisionProtanopia], 4.5);
+    XCTAssertNotEqual([colourVision indexOfPairWithForegroundColour:[UIColor whiteColor] backgroundColour:[UIColor blackColor]], NSNotFound);
+    XCTAssertEqual([colourVision indexOfPairWithForegroundColour:[UIColor greenColor] backgroundColour:[UIColor blackColor]], NSNotFound);
+}
+
+- (void)testSimulatedImageOfViews
+{
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 40, 20)];
+    UIView *redView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 20, 20)];
+    redView.backgroundColor = [UIColor redColor];
+    UIView *coveringView = [[UIView alloc]initWithFrame:containerView.bounds];
+    coveringView.backgroundColor = [UIColor blueColor];
+    [containerView addSubview:redView];
+    [containerView addSubview:coveringView];
+    
+    //Only the views passed in are drawn, at the size of the container
+    UIImage *image = [UBKAccessibilityColourVision simulatedImageOfViews:@[redView] inView:containerView deficiency:UBKColourVisionAchromatopsia];
+    XCTAssertNotNil(image);
+    XCTAssertEqual(image.size.width, 40);
+    XCTAssertEqual(image.size.height, 20);
+}
+
+- (void)testSimulatePixels
+{
+    UBKColourRGBA8 pixels[5] = {
+        { 255, 0, 0, 255 },
+        { 0, 255, 0, 10 },
+        { 0, 0, 255, 255 },
+        { 128, 128, 128, 255 },
+        { 255, 255, 255, 255 }
+    };
+    UBKColourVisionSimulatePixels(UBKColourVisionAchromatopsia, pixels, 5, pixels);
+    for (NSUInteger i = 0; i < 5; i++)
+    {
+        XCTAssertEqual(pixels[i].r, pixels[i].g);
+        XCTAssertEqual(pixels[i].g, pixels[i].b);
+    }
+    XCTAssertEqual(pixels[1].a, 10);
+    XCTAssertEqual(pixels[3].r, 128);
+    XCTAssertEqual(pixels[4].r, 255);
+    
+    UBKColourRGBA8 typical[3] = { { 12, 34, 56, 255 }, { 200, 100, 50, 255 }, { 0, 0, 0, 0 } };
+    UBKColourRGBA8 output[3];
+    UBKColourVisionSimulatePixels(UBKColourVisionTypical, typical, 3, output);
+    for (NSUInteger i = 0; i < 3; i++)
+    {
+        XCTAssertEqualWithAccuracy(output[i].r, typical[i].r, 1);
+        XCTAssertEqualWithAccuracy(output[i].g, typical[i].g, 1);
+        XCTAssertEqualWithAccuracy(output[i].b, typical[i].b, 1);
+    }
+}
+
+@end
@@ -0,0 +1,139 @@
+/*
+ File: UBKAccessibilityControlStatesTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+
+#import <XCTest/XCTest.h>
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityControlStatesTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityControlStatesTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (UIButton *)createButton
+{
+    UIButton *button = [UIButton buttonWithType:UIButtonTypeCustom];
+    button.frame = CGRectMake(0, 0, 200, 44);
+    button.backgroundColor = [UIColor whiteColor];
+    button.titleLabel.font = [UIFont systemFontOfSize:17];
+    [button setTitle:@"Continue" forState:UIControlStateNormal];
+    [button setTitleColor:[UIColor blackColor] forState:UIControlStateNormal];
+    return button;
+}
+
+- (void)testButtonStatesAreRated
+{
+    UIButton *button = [self createButton];
+    [button setTitleColor:[UIColor colorWithWhite:0.85 alpha:1] forState:UIControlStateHighlighted];
+    [button setTitleColor:[UIColor colorWithWhite:0.9 alpha:1] forState:UIControlStateDisabled];
+    [button setTitleColor:[UIColor colorWithWhite:0.2 alpha:1] forState:UIControlStateSelected];
+    
+    UBKAccessibilityControlStates *controlStates = [[UBKAccessibilityControlStates alloc]initWithControl:button backgroundColour:[UIColor whiteColor]];
+    XCTAssertFalse([controlStates isFailingForState:UIControlStateNormal]);
+    XCTAssertTrue([controlStates isFailingForState:UIControlStateHighlighted]);
+    XCTAssertFalse([controlStates isFailingForState:UIControlStateSelected]);
+    //Disabled controls are exempt from contrast requirements
+    XCTAssertFalse([controlStates isFailingForState:UIControlStateDisabled]);
+    XCTAssertEqual(controlStates.failingCount, 1);
+    XCTAssertEqual(controlStates.contrastProperties.count, 4);
+    
+    NSArray *warnings = [UBKAccessibilityValidation checkAccessibilityWarningForButton:button withTextRuns:nil withControlStates:controlStates];
+    XCTAssertTrue([warnings containsObject:@(UBKAccessibilityWarningTypeStateColourContrast)]);
+}
+
+- (void)testCurrentStateIsLeftToTheTextRuns
+{
+    UIButton *button = [self createButton];
+    [button setTitleColor:[UIColor colorWithWhite:0.85 alpha:1] forState:UIControlStateSelected];
+    button.selected = true;
+    
+    UBKAccessibilityControlStates *controlStates = [[UBKAccessibilityControlStates alloc]initWithControl:button backgroundColour:[UIColor whiteColor]];
+    XCTAssertTrue([controlStates isFailingForState:UIControlStateSelected]);
+    XCTAssertEqual(controlStates.failingCount, 0);
+}
+
+- (void)testButtonBackgroundImages
+{
+    UIButton *button = [self createButton];
+    UIGraphicsBeginImageContext(CGSizeMake(4, 4));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    button.tintColor = [UIColor blackColor];
+    [button setTitleColor:[UIColor whiteColor] forState:UIControlStateHighlighted];
+    [button setBackgroundImage:[image imageWithRenderingMode:UIImageRenderingModeAlwaysTemplate] forState:UIControlStateHighlighted];
+    [button setTitleColor:[UIColor whiteColor] forState:UIControlStateSelected];
+    [button setBackgroundImage:[image imageWithRenderingMode:UIImageRenderingModeAlwaysOriginal] forState:UIControlStateSelected];
+    
+    //White text on the black tint passes, the original image can't be rated so selected has no contrast
+    UBKAccessibilityControlStates *controlStates = [[UBKAccessibilityControlStates alloc]initWithControl:button backgroundColour:[UIColor whiteColor]];
+    XCTAssertFalse([controlStates isFailingForState:UIControlStateHighlighted]);
+    XCTAssertFalse([controlStates isFailingForState:UIControlStateSelected]);
+    XCTAssertEqual(controlStates.failingCount, 0);
+    for (UBKAccessibilityProperty *property in controlStates.contrastProperties)
+    {
+        XCTAssertNotEqualObjects(property.displayTitle, kUBKAccessibilityAttributeTitle_SelectedStateContrast);
+    }
+}
+
+- (void)testSwitchTints
+{
+    UISwitch *switchObject = [[UISwitch alloc]init];
+    UBKAccessibilityControlStates *controlStates = [[UBKAccessibilityControlStates alloc]initWithControl:switchObject backgroundColour:[UIColor whiteColor]];
+    XCTAssertEqual(controlStates.contrastProperties.count, 0);
+    
+    switchObject.onTintColor = [UIColor colorWithWhite:0.95 alpha:1];
+    switchObject.thumbTintColor = [UIColor whiteColor];
+    controlStates = [[UBKAccessibilityControlStates alloc]initWithControl:switchObject backgroundColour:[UIColor whiteColor]];
+    XCTAssertEqual(controlStates.contrastProperties.count, 3);
+    XCTAssertEqual(controlStates.failingCount, 3);
+    XCTAssertTrue([[UBKAccessibilityValidation checkAccessibilityWarningForSwitch:switchObject withControlStates:controlStates] containsObject:@(UBKAccessibilityWarningTypeStateColourContrast)]);
+    
+    switchObject.onTintColor = [UIColor blackColor];
+    switchObject.thumbTintColor = [UIColor colorWithWhite:0.4 alpha:1];
+    controlStates = [[UBKAccessibilityControlStates alloc]initWithControl:switchObject backgroundColour:[UIColor whiteColor]];
+    XCTAssertEqual(controlStates.failingCount, 0);
+}
+
+- (void)testSliderTints
+{
+    UISlider *slider = [[UISlider alloc]initWithFrame:CGRectMake(0, 0, 200, 44)];
+    slider.minimumTrackTintColor = [UIColor blackColor];
+    slider.maximumTrackTintColor = [UIColor colorWithWhite:0.9 alpha:1];
+    
+    UBKAccessibilityControlStates *controlStates = [[UBKAccessibilityControlStates alloc]initWithControl:slider backgroundColour:[UIColor whiteColor]];
+    XCTAssertEqual(controlStates.contrastProperties.count, 2);
+    XCTAssertEqual(controlStates.failingCount, 1);
+    XCTAssertEqualObjects(controlStates.contrastProperties.lastObject.displayTitle, kUBKAccessibilityAttributeTitle_MaximumTrackContrast);
+    XCTAssertTrue(controlStates.contrastProperties.lastObject.displayWarning);
+    XCTAssertTrue([[UBKAccessibilityValidation checkAccessibilityWarningForSlider:slider withControlStates:controlStates] containsObject:@(UBKAccessibilityWarningTypeStateColourContrast)]);
+}
+
+@end
@@ -0,0 +1,136 @@
+/*
+ File: UBKAccessibilityHierarchyWalkerTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityHierarchyWalkerTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityHierarchyWalkerTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+//Uneven tree with some hidden, skipped and pass through views
+- (void)addSubviewsToView:(UIView *)view depth:(NSUInteger)depth
+{
+    if (depth == 0)
+    {
+        return;
+    }
+    for (NSUInteger i = 0; i < depth + 1; i++)
+    {
+        UIView *subview = [[UIView alloc]initWithFrame:CGRectMake(i * 10, depth * 10, 8, 8)];
+        subview.tag = (NSInteger)(depth * 10 + i);
+        subview.hidden = (i == 2);
+        [view addSubview:subview];
+        [self addSubviewsToView:subview depth:depth - 1];
+    }
+}
+
+- (UBKAccessibilityHierarchyWalker *)walkerForRootView:(UIView *)rootView
+{
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Test"];
+    return [[UBKAccessibilityHierarchyWalker alloc]initWithRootViews:@[rootView] snapshot:snapshot actionForView:^UBKAccessibilityWalkAction(UIView *view) {
+        if (view.tag % 7 == 0)
+        {
+            return UBKAccessibilityWalkActionSkip;
+        }
+        if (view.tag % 5 == 0)
+        {
+            return UBKAccessibilityWalkActionSubviewsOnly;
+        }
+        return UBKAccessibilityWalkActionElement;
+    }];
+}
+
+- (void)testSlicedWalkMatchesFullWalk
+{
+    UIView *rootView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    [self addSubviewsToView:rootView depth:6];
+    
+    UBKAccessibilityHierarchyWalker *fullWalker = [self walkerForRootView:rootView];
+    [fullWalker walkToEnd];
+    XCTAssertTrue(fullWalker.isFinished);
+    XCTAssertEqual(fullWalker.progress, 1);
+    [fullWalker.snapshot finishSnapshot];
+    
+    //A budget of 0 walks one batch per call
+    UBKAccessibilityHierarchyWalker *slicedWalker = [self walkerForRootView:rootView];
+    NSUInteger slices = 0;
+    double progress = 0;
+    while (![slicedWalker walkForDuration:0])
+    {
+        XCTAssertGreaterThanOrEqual(slicedWalker.progress, progress);
+        XCTAssertLessThan(slicedWalker.progress, 1);
+        progress = slicedWalker.progress;
+        slices++;
+    }
+    XCTAssertGreaterThan(slices, 1);
+    XCTAssertEqual(slicedWalker.progress, 1);
+    [slicedWalker.snapshot finishSnapshot];
+    
+    XCTAssertEqual(slicedWalker.visitedCount, fullWalker.visitedCount);
+    XCTAssertEqualObjects(slicedWalker.elements, fullWalker.elements);
+    XCTAssertEqual(slicedWalker.snapshot.nodeCount, fullWalker.snapshot.nodeCount);
+    XCTAssertEqual(slicedWalker.snapshot.nodeCount, slicedWalker.elements.count + 1);
+    for (NSUInteger i = 0; i < fullWalker.snapshot.nodeCount; i++)
+    {
+        XCTAssertEqual(slicedWalker.snapshot.nodes[i].parent, fullWalker.snapshot.nodes[i].parent);
+        XCTAssertEqual(slicedWalker.snapshot.nodes[i].subtreeEnd, fullWalker.snapshot.nodes[i].subtreeEnd);
+        XCTAssertEqual(slicedWalker.snapshot.nodes[i].subtreeHash, fullWalker.snapshot.nodes[i].subtreeHash);
+    }
+    XCTAssertEqual(slicedWalker.snapshot.fingerprint, fullWalker.snapshot.fingerprint);
+}
+
+- (void)testSkippedAndPassThroughViews
+{
+    UIView *rootView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    UIView *skippedView = [[UIView alloc]init];
+    skippedView.tag = 7;
+    [skippedView addSubview:[[UIView alloc]init]];
+    [rootView addSubview:skippedView];
+    UIView *passThroughView = [[UIView alloc]init];
+    passThroughView.tag = 5;
+    UIView *childView = [[UIView alloc]init];
+    childView.tag = 1;
+    [passThroughView addSubview:childView];
+    [rootView addSubview:passThroughView];
+    
+    UBKAccessibilityHierarchyWalker *walker = [self walkerForRootView:rootView];
+    [walker walkToEnd];
+    XCTAssertEqualObjects(walker.elements, @[childView]);
+    XCTAssertEqual(walker.snapshot.nodeCount, 2);
+    //The pass through view has no node, its subview hangs off the root view
+    XCTAssertEqual(walker.snapshot.nodes[1].parent, 0);
+}
+
+@end
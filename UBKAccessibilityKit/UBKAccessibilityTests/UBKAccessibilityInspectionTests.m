@@ -0,0 +1,285 @@
+/*
+ File: UBKAccessibilityInspectionTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <XCTest/XCTest.h>
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+#import <arpa/inet.h>
+#import <netinet/in.h>
+#import <sys/socket.h>
+
+@interface UBKAccessibilityInspectionTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityInspectionTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (void)buildTree:(UBKInspectionTree *)tree nodeCount:(uint32_t)nodeCount offset:(float)offset
+{
+    UBKInspectionTreeReset(tree);
+    for (uint32_t i = 0; i < nodeCount; i++)
+    {
+        UBKInspectionNode node = {0};
+        node.key = 1000 + i;
+        node.parentKey = (i > 0) ? 1000 + (i - 1) / 4 : 0;
+        node.siblingIndex = (i > 0) ? (i - 1) % 4 : 0;
+        node.flags = UBKSnapshotNodeFlagElement;
+        node.warningMask = (i % 3 == 0) ? (1ULL << UBKAccessibilityWarningTypeMinimumSize) : 0;
+        node.warningLevel = (i % 3 == 0) ? UBKAccessibilityWarningLevelMedium : UBKAccessibilityWarningLevelPass;
+        node.x = i + offset;
+        node.y = i * 2;
+        node.width = 44;
+        node.height = 44;
+        NSString *label = [NSString stringWithFormat:@"Label %u", i];
+        XCTAssertTrue(UBKInspectionTreeAddNode(tree, &node, "UILabel", label.UTF8String));
+        XCTAssertTrue(UBKInspectionTreeAddColour(tree, "Text colour", 0x112233FF));
+    }
+}
+
+- (BOOL)applyBuffer:(UBKInspectionBuffer *)buffer toTree:(UBKInspectionTree *)tree
+{
+    UBKInspectionFrame frame;
+    int64_t length = UBKInspectionNextFrame(buffer->bytes, buffer->length, &frame);
+    return (length == (int64_t)buffer->length) && (UBKInspectionTreeApplyFrame(tree, &frame));
+}
+
+- (void)assertTree:(const UBKInspectionTree *)tree matchesTree:(const UBKInspectionTree *)expected
+{
+    XCTAssertEqual(tree->sequence, expected->sequence);
+    XCTAssertEqual(tree->count, expected->count);
+    for (uint32_t i = 0; (i < tree->count) && (i < expected->count); i++)
+    {
+        int64_t index = UBKInspectionTreeFind(tree, expected->nodes[i].key);
+        XCTAssertTrue(index >= 0);
+        if (index < 0)
+        {
+            continue;
+        }
+        const UBKInspectionNode *node = &tree->nodes[index];
+        XCTAssertEqual(node->parentKey, expected->nodes[i].parentKey);
+        XCTAssertEqual(node->warningMask, expected->nodes[i].warningMask);
+        XCTAssertEqual(node->x, expected->nodes[i].x);
+        XCTAssertEqual(strcmp(UBKInspectionTreeString(tree, node->label), UBKInspectionTreeString(expected, expected->nodes[i].label)), 0);
+        XCTAssertEqual(node->colourCount, expected->nodes[i].colourCount);
+    }
+}
+
+- (void)testSnapshotAndDelta
+{
+    UBKInspectionTree previous, tree, client;
+    UBKInspectionTreeInit(&previous);
+    UBKInspectionTreeInit(&tree);
+    UBKInspectionTreeInit(&client);
+    UBKInspectionBuffer buffer;
+    UBKInspectionBufferInit(&buffer);
+    
+    [self buildTree:&previous nodeCount:50 offset:0];
+    previous.sequence = 1;
+    XCTAssertTrue(UBKInspectionEncodeSnapshot(&buffer, &previous));
+    size_t snapshotLength = buffer.length;
+    XCTAssertTrue([self applyBuffer:&buffer toTree:&client]);
+    [self assertTree:&client matchesTree:&previous];
+    
+    //The same tree makes no delta
+    [self buildTree:&tree nodeCount:50 offset:0];
+    tree.sequence = 2;
+    bool hasChanges = true;
+    buffer.length = 0;
+    XCTAssertTrue(UBKInspectionEncodeDelta(&buffer, &previous, &tree, &hasChanges));
+    XCTAssertFalse(hasChanges);
+    XCTAssertEqual(buffer.length, 0);
+    
+    //One moved node and one removed node only send those nodes
+    tree.nodes[10].x += 5;
+    tree.count--;
+    XCTAssertTrue(UBKInspectionEncodeDelta(&buffer, &previous, &tree, &hasChanges));
+    XCTAssertTrue(hasChanges);
+    XCTAssertTrue(buffer.length < snapshotLength / 10);
+    XCTAssertTrue([self applyBuffer:&buffer toTree:&client]);
+    [self assertTree:&client matchesTree:&tree];
+    
+    //A delta from another sequence is rejected
+    XCTAssertFalse([self applyBuffer:&buffer toTree:&client]);
+    
+    UBKInspectionBufferDestroy(&buffer);
+    UBKInspectionTreeDestroy(&previous);
+    UBKInspectionTreeDestroy(&tree);
+    UBKInspectionTreeDestroy(&client);
+}
+
+- (void)testTruncatedFrames
+{
+    UBKInspectionTree tree, client;
+    UBKInspectionTreeInit(&tree);
+    UBKInspectionTreeInit(&client);
+    UBKInspectionBuffer buffer;
+    UBKInspectionBufferInit(&buffer);
+    [self buildTree:&tree nodeCount:5 offset:0];
+    XCTAssertTrue(UBKInspectionEncodeSnapshot(&buffer, &tree));
+    
+    UBKInspectionFrame frame;
+    for (size_t length = 0; length < buffer.length; length++)
+    {
+        XCTAssertEqual(UBKInspectionNextFrame(buffer.bytes, length, &frame), 0);
+    }
+    
+    //A frame that claims to be shorter than its contents is rejected
+    uint32_t frameLength = (uint32_t)(buffer.length - sizeof(uint32_t)) - 3;
+    for (NSUInteger i = 0; i < sizeof(uint32_t); i++)
+    {
+        buffer.bytes[i] = (uint8_t)(frameLength >> (i * 8));
+    }
+    XCTAssertTrue(UBKInspectionNextFrame(buffer.bytes, buffer.length, &frame) > 0);
+    XCTAssertFalse(UBKInspectionTreeApplyFrame(&client, &frame));
+    
+    UBKInspectionBufferDestroy(&buffer);
+    UBKInspectionTreeDestroy(&tree);
+    UBKInspectionTreeDestroy(&client);
+}
+
+- (void)testCommands
+{
+    UBKInspectionBuffer buffer;
+    UBKInspectionBufferInit(&buffer);
+    XCTAssertTrue(UBKInspectionEncodeSetColour(&buffer, 1005, 1, 0x00FF00FF));
+    
+    UBKInspectionFrame frame;
+    XCTAssertEqual(UBKInspectionNextFrame(buffer.bytes, buffer.length, &frame), (int64_t)buffer.length);
+    UBKInspectionCommand command;
+    XCTAssertTrue(UBKInspectionDecodeCommand(&frame, &command));
+    XCTAssertEqual(command.type, UBKInspectionMessageSetColour);
+    XCTAssertEqual(command.key, 1005);
+    XCTAssertEqual(command.colourIndex, 1);
+    XCTAssertEqual(command.rgba, 0x00FF00FF);
+    UBKInspectionBufferDestroy(&buffer);
+}
+
+- (void)testUniqueKeys
+{
+    uint64_t keys[] = { 7, 7, 0, 9, 7 };
+    XCTAssertTrue(UBKInspectionMakeKeysUnique(keys, 5));
+    for (NSUInteger i = 0; i < 5; i++)
+    {
+        XCTAssertNotEqual(keys[i], 0);
+        for (NSUInteger j = i + 1; j < 5; j++)
+        {
+            XCTAssertNotEqual(keys[i], keys[j]);
+        }
+    }
+    XCTAssertEqual(keys[0], 7);
+    XCTAssertEqual(keys[3], 9);
+}
+
+//Reads frames from the server into tree until it reaches sequence
+- (void)readFromSocket:(int)fileDescriptor server:(UBKInspectionServer *)server intoTree:(UBKInspectionTree *)tree untilSequence:(uint64_t)sequence
+{
+    NSMutableData *data = [[NSMutableData alloc]init];
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5];
+    while ((tree->sequence != sequence) && ([deadline timeIntervalSinceNow] > 0))
+    {
+        UBKInspectionServerPoll(server, NULL, NULL);
+        uint8_t bytes[4096];
+        ssize_t length = recv(fileDescriptor, bytes, sizeof(bytes), MSG_DONTWAIT);
+        if (length > 0)
+        {
+            [data appendBytes:bytes length:(NSUInteger)length];
+        }
+        size_t offset = 0;
+        UBKInspectionFrame frame;
+        int64_t frameLength;
+        while ((frameLength = UBKInspectionNextFrame((const uint8_t *)data.bytes + offset, data.length - offset, &frame)) > 0)
+        {
+            offset += (size_t)frameLength;
+            if ((frame.type == UBKInspectionMessageSnapshot) || (frame.type == UBKInspectionMessageDelta))
+            {
+                XCTAssertTrue(UBKInspectionTreeApplyFrame(tree, &frame));
+            }
+        }
+        XCTAssertTrue(frameLength >= 0);
+        [data replaceBytesInRange:NSMakeRange(0, offset) withBytes:NULL length:0];
+        if (length <= 0)
+        {
+            usleep(1000);
+        }
+    }
+}
+
+- (void)testLoopbackServer
+{
+    UBKInspectionServer server;
+    XCTAssertTrue(UBKInspectionServerOpen(&server, 0));
+    XCTAssertNotEqual(server.port, 0);
+    
+    UBKInspectionTree tree, client;
+    UBKInspectionTreeInit(&tree);
+    UBKInspectionTreeInit(&client);
+    [self buildTree:&tree nodeCount:200 offset:0];
+    XCTAssertTrue(UBKInspectionServerPublish(&server, &tree));
+    
+    int fileDescriptor = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address = {0};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(server.port);
+    XCTAssertEqual(connect(fileDescriptor, (struct sockaddr *)&address, sizeof(address)), 0);
+    
+    //A new client gets the whole tree
+    [self readFromSocket:fileDescriptor server:&server intoTree:&client untilSequence:tree.sequence];
+    [self assertTree:&client matchesTree:&tree];
+    
+    //Unchanged trees cost nothing
+    uint64_t bytesSent = server.bytesSent;
+    for (NSUInteger i = 0; i < 60; i++)
+    {
+        [self buildTree:&tree nodeCount:200 offset:0];
+        XCTAssertTrue(UBKInspectionServerPublish(&server, &tree));
+        UBKInspectionServerPoll(&server, NULL, NULL);
+    }
+    XCTAssertEqual(server.bytesSent, bytesSent);
+    
+    //A second of one moving node costs about one snapshot
+    for (NSUInteger i = 1; i <= 60; i++)
+    {
+        [self buildTree:&tree nodeCount:200 offset:0];
+        tree.nodes[10].x = i;
+        XCTAssertTrue(UBKInspectionServerPublish(&server, &tree));
+        UBKInspectionServerPoll(&server, NULL, NULL);
+    }
+    [self readFromSocket:fileDescriptor server:&server intoTree:&client untilSequence:tree.sequence];
+    [self assertTree:&client matchesTree:&tree];
+    XCTAssertTrue(server.bytesSent - bytesSent < 8192);
+    
+    close(fileDescriptor);
+    UBKInspectionServerClose(&server);
+    UBKInspectionTreeDestroy(&tree);
+    UBKInspectionTreeDestroy(&client);
+}
+
+@end
@@ -0,0 +1,151 @@
+/*
+ File: UBKAccessibilityLabelsTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityLabelsTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityLabelsTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (void)testLabelHash
+{
+    XCTAssertEqual(UBKLabelHash(NULL, false), 0);
+    XCTAssertEqual(UBKLabelHash(" - ", false), 0);
+    XCTAssertEqual(UBKLabelHash("settingsButton", false), UBKLabelHash("Settings button", false));
+    XCTAssertEqual(UBKLabelHash("settings_button", false), UBKLabelHash("SETTINGS  BUTTON!", false));
+    XCTAssertNotEqual(UBKLabelHash("settings", false), UBKLabelHash("settings button", false));
+    XCTAssertEqual(UBKLabelHash("UIButton", true), UBKLabelHash("Button", false));
+    
+    XCTAssertTrue(UBKLabelIsCodeLike("icon_close"));
+    XCTAssertTrue(UBKLabelIsCodeLike("closeButton"));
+    XCTAssertTrue(UBKLabelIsCodeLike("home.icon"));
+    XCTAssertFalse(UBKLabelIsCodeLike("Close"));
+    XCTAssertFalse(UBKLabelIsCodeLike("Rate 3.5"));
+}
+
+- (void)testAnalyse
+{
+    UBKLabelNode nodes[4] = {0};
+    //Two buttons that both say More, the third has a hint to tell it apart
+    for (size_t i = 0; i < 3; i++)
+    {
+        nodes[i].label = UBKLabelHash("More", false);
+        nodes[i].isInteractive = true;
+    }
+    nodes[2].context = UBKLabelHash("Opens savings", false);
+    //An image labelled with its asset name
+    nodes[3].label = UBKLabelHash("icon_close", false);
+    nodes[3].labelIsCodeLike = true;
+    nodes[3].names[UBKLabelNameImage] = UBKLabelHash("icon_close", false);
+    
+    UBKLabelResult results[4];
+    XCTAssertTrue(UBKLabelsAnalyse(nodes, 4, results));
+    XCTAssertEqual(results[0].flags, UBKLabelFlagDuplicate);
+    XCTAssertEqual(results[1].flags, UBKLabelFlagDuplicate);
+    XCTAssertEqual(results[1].firstDuplicate, 0);
+    XCTAssertEqual(results[1].duplicateCount, 2);
+    XCTAssertEqual(results[2].flags, 0);
+    XCTAssertEqual(results[3].flags, UBKLabelFlagEchoesName);
+    XCTAssertEqual(results[3].echoedName, UBKLabelNameImage);
+}
+
+- (void)testSnapshotLabels
+{
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    UIButton *firstButton = [UIButton buttonWithType:UIButtonTypeSystem];
+    firstButton.frame = CGRectMake(10, 10, 100, 44);
+    [firstButton setTitle:@"More" forState:UIControlStateNormal];
+    [containerView addSubview:firstButton];
+    UIButton *secondButton = [UIButton buttonWithType:UIButtonTypeSystem];
+    secondButton.frame = CGRectMake(10, 100, 100, 44);
+    [secondButton setTitle:@"more" forState:UIControlStateNormal];
+    [containerView addSubview:secondButton];
+    UIButton *hiddenButton = [UIButton buttonWithType:UIButtonTypeSystem];
+    hiddenButton.frame = CGRectMake(10, 200, 100, 44);
+    [hiddenButton setTitle:@"More" forState:UIControlStateNormal];
+    hiddenButton.hidden = true;
+    [containerView addSubview:hiddenButton];
+    UIButton *closeButton = [UIButton buttonWithType:UIButtonTypeSystem];
+    closeButton.frame = CGRectMake(10, 300, 44, 44);
+    closeButton.accessibilityIdentifier = @"closeButton";
+    closeButton.accessibilityLabel = @"close_button";
+    [containerView addSubview:closeButton];
+    
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Test"];
+    [snapshot pushView:containerView isElement:false];
+    for (UIView *view in containerView.subviews)
+    {
+        [snapshot pushView:view isElement:true];
+        [snapshot popView];
+    }
+    [snapshot popView];
+    [snapshot finishSnapshot];
+    
+    UBKAccessibilityLabels *labels = [[UBKAccessibilityLabels alloc]initWithSnapshot:snapshot];
+    XCTAssertEqual(labels.labelledCount, 3);
+    XCTAssertEqual(labels.duplicateCount, 2);
+    XCTAssertEqual(labels.echoCount, 1);
+    XCTAssertEqual([labels flagsForView:firstButton], UBKLabelFlagDuplicate);
+    XCTAssertEqualObjects([labels duplicatesOfView:firstButton], @[secondButton]);
+    XCTAssertEqual([labels flagsForView:hiddenButton], 0);
+    XCTAssertEqual([labels flagsForView:closeButton], UBKLabelFlagEchoesName);
+    XCTAssertEqual([labels echoedNameForView:closeButton], UBKLabelNameIdentifier);
+    
+    uint64_t subtreeHash = snapshot.nodes[0].subtreeHash;
+    [labels combineResultsIntoSnapshot];
+    [snapshot updateSubtreeHashes];
+    XCTAssertNotEqual(snapshot.nodes[0].subtreeHash, subtreeHash);
+}
+
+- (void)testImageNames
+{
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc]initWithSize:CGSizeMake(4, 4)];
+    UIImage *image = [renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+        [context fillRect:CGRectMake(0, 0, 4, 4)];
+    }];
+    UIImageView *imageView = [[UIImageView alloc]initWithImage:image];
+    XCTAssertNil([UBKAccessibilityLabels imageNameForView:imageView]);
+    
+    [UBKAccessibilityLabels setImageName:@"icon_close" forImage:image];
+    XCTAssertEqualObjects([UBKAccessibilityLabels imageNameForView:imageView], @"icon_close");
+    //The image's own identifier comes first
+    image.accessibilityIdentifier = @"icon_back";
+    XCTAssertEqualObjects([UBKAccessibilityLabels imageNameForView:imageView], @"icon_back");
+    image.accessibilityIdentifier = nil;
+    [UBKAccessibilityLabels setImageName:nil forImage:image];
+    XCTAssertNil([UBKAccessibilityLabels imageNameForView:imageView]);
+}
+
+@end
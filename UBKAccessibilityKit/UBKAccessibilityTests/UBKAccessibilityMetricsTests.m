@@ -0,0 +1,145 @@
+/*
+ File: UBKAccessibilityMetricsTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <XCTest/XCTest.h>
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+#import <arpa/inet.h>
+#import <netinet/in.h>
+#import <sys/socket.h>
+
+@interface UBKAccessibilityMetricsTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityMetricsTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (UBKMetricsRefresh)refresh
+{
+    UBKMetricsRefresh refresh = {0};
+    refresh.nodes = 40;
+    refresh.elements = 12;
+    refresh.rulesRun = 7;
+    refresh.cacheHits = 30;
+    refresh.cacheMisses = 10;
+    refresh.arenaAllocations = 1;
+    refresh.arenaBytes = 4096;
+    refresh.duration = 0.004;
+    refresh.warningsByType[UBKAccessibilityWarningTypeColourContrast] = 2;
+    refresh.warningsByLevel[UBKAccessibilityWarningLevelHigh] = 2;
+    return refresh;
+}
+
+- (void)testRecordRefresh
+{
+    UBKAccessibilityMetrics *metrics = [[UBKAccessibilityMetrics alloc]init];
+    __block NSUInteger handlerCount = 0;
+    metrics.refreshHandler = ^(UBKAccessibilityMetrics *metrics, const UBKMetricsRefresh *refresh) {
+        handlerCount++;
+    };
+    UBKMetricsRefresh refresh = [self refresh];
+    [metrics recordRefresh:&refresh];
+    [metrics recordRefresh:&refresh];
+    
+    XCTAssertEqual(handlerCount, 2);
+    XCTAssertEqual(metrics.metrics->counters[UBKMetricsCounterRefreshes], 2);
+    XCTAssertEqual(metrics.metrics->counters[UBKMetricsCounterElementsScanned], 24);
+    XCTAssertEqual(metrics.metrics->warningsByType[UBKAccessibilityWarningTypeColourContrast], 4);
+    XCTAssertEqual(metrics.metrics->currentWarningsByType[UBKAccessibilityWarningTypeColourContrast], 2);
+    XCTAssertEqualWithAccuracy(metrics.cacheHitRate, 0.75, 0.0001);
+    
+    NSString *text = [metrics prometheusText];
+    XCTAssertTrue([text containsString:@"ubk_refreshes_total 2\n"]);
+    XCTAssertTrue([text containsString:@"ubk_refresh_duration_seconds_bucket{le=\"0.005\"} 2\n"]);
+    XCTAssertTrue([text containsString:@"ubk_arena_allocations_total 2\n"]);
+    XCTAssertTrue([text containsString:@"ubk_arena_bytes 4096\n"]);
+    NSString *contrastName = [UBKAccessibilityMetrics metricNameForWarningType:UBKAccessibilityWarningTypeColourContrast];
+    XCTAssertTrue([text containsString:[NSString stringWithFormat:@"ubk_warnings_found_total{type=\"%@\"} 4\n", contrastName]]);
+    
+    text = [metrics statsDTextForRefresh:&refresh];
+    XCTAssertTrue([text containsString:@"ubk.elements_scanned:12|c\n"]);
+    XCTAssertTrue([text containsString:[NSString stringWithFormat:@"ubk.warnings.type.%@:2|g\n", contrastName]]);
+}
+
+- (void)testMetricNames
+{
+    NSCharacterSet *invalidCharacters = [[NSCharacterSet characterSetWithCharactersInString:@"abcdefghijklmnopqrstuvwxyz0123456789_"] invertedSet];
+    for (NSUInteger type = 0; type <= UBKAccessibilityWarningTypeAppearanceContrast; type++)
+    {
+        NSString *name = [UBKAccessibilityMetrics metricNameForWarningType:type];
+        XCTAssertTrue(name.length > 0);
+        XCTAssertEqual([name rangeOfCharacterFromSet:invalidCharacters].location, NSNotFound);
+    }
+}
+
+- (void)testExportToLocalListener
+{
+    int listener = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in address = {0};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    XCTAssertEqual(bind(listener, (struct sockaddr *)&address, sizeof(address)), 0);
+    socklen_t addressLength = sizeof(address);
+    getsockname(listener, (struct sockaddr *)&address, &addressLength);
+    struct timeval timeout = {2, 0};
+    setsockopt(listener, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    UBKAccessibilityMetrics *metrics = [[UBKAccessibilityMetrics alloc]init];
+    XCTAssertTrue([metrics startExportingToHost:@"127.0.0.1" port:ntohs(address.sin_port) format:UBKAccessibilityMetricsFormatStatsD]);
+    UBKMetricsRefresh refresh = [self refresh];
+    [metrics recordRefresh:&refresh];
+    [metrics stopExporting];
+    
+    char buffer[2048];
+    ssize_t length = recv(listener, buffer, sizeof(buffer) - 1, 0);
+    close(listener);
+    XCTAssertTrue(length > 0);
+    NSString *text = [[NSString alloc]initWithBytes:buffer length:MAX(length, 0) encoding:NSUTF8StringEncoding];
+    XCTAssertTrue([text hasPrefix:@"ubk.refreshes:1|c\n"]);
+}
+
+- (void)testExportToFile
+{
+    NSURL *fileURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:@"ubk_metrics.prom"];
+    UBKAccessibilityMetrics *metrics = [[UBKAccessibilityMetrics alloc]init];
+    XCTAssertTrue([metrics startExportingToFileURL:fileURL format:UBKAccessibilityMetricsFormatPrometheus]);
+    UBKMetricsRefresh refresh = [self refresh];
+    [metrics recordRefresh:&refresh];
+    [metrics recordRefresh:&refresh];
+    [metrics stopExporting];
+    
+    //Each export replaces the last one
+    NSString *text = [NSString stringWithContentsOfURL:fileURL encoding:NSUTF8StringEncoding error:nil];
+    XCTAssertTrue([text containsString:@"ubk_refreshes_total 2\n"]);
+    XCTAssertFalse([text containsString:@"ubk_refreshes_total 1\n"]);
+    [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+}
+
+@end
@@ -0,0 +1,151 @@
+/*
+ File: UBKAccessibilityReadingOrderTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityReadingOrderTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityReadingOrderTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (UBKReadingOrderNode)nodeWithFrame:(UBKRect)frame group:(int32_t)group isGroup:(bool)isGroup
+{
+    UBKReadingOrderNode node;
+    node.frame = frame;
+    node.group = group;
+    node.isGroup = isGroup;
+    return node;
+}
+
+- (void)testRowsAndGroups
+{
+    UBKReadingOrderNode nodes[6] = {
+        //Second row, right
+        [self nodeWithFrame:(UBKRect){100, 50, 40, 20} group:-1 isGroup:false],
+        //First row, left then right
+        [self nodeWithFrame:(UBKRect){0, 0, 40, 20} group:-1 isGroup:false],
+        [self nodeWithFrame:(UBKRect){100, 0, 40, 20} group:-1 isGroup:false],
+        //Second row, left
+        [self nodeWithFrame:(UBKRect){0, 50, 40, 20} group:-1 isGroup:false],
+        //Group on the third row, read as one block
+        [self nodeWithFrame:(UBKRect){0, 100, 200, 40} group:-1 isGroup:true],
+        [self nodeWithFrame:(UBKRect){150, 105, 20, 20} group:4 isGroup:false]
+    };
+    uint32_t expectedOrder[6];
+    size_t elementCount = 0;
+    UBKReadingOrderResult results[6];
+    XCTAssertTrue(UBKReadingOrderAnalyse(nodes, 6, false, expectedOrder, &elementCount, results));
+    
+    XCTAssertEqual(elementCount, 5);
+    uint32_t leftToRight[5] = {1, 2, 3, 0, 5};
+    for (size_t i = 0; i < elementCount; i++)
+    {
+        XCTAssertEqual(expectedOrder[i], leftToRight[i]);
+    }
+    XCTAssertEqual(results[4].position, -1);
+    //Only the first node jumps, the rest are already in order
+    XCTAssertEqual(results[0].flags, UBKReadingOrderFlagOutOfOrder);
+    for (size_t i = 1; i < 6; i++)
+    {
+        XCTAssertEqual(results[i].flags, 0);
+    }
+    
+    XCTAssertTrue(UBKReadingOrderAnalyse(nodes, 6, true, expectedOrder, &elementCount, results));
+    uint32_t rightToLeft[5] = {2, 1, 0, 3, 5};
+    for (size_t i = 0; i < elementCount; i++)
+    {
+        XCTAssertEqual(expectedOrder[i], rightToLeft[i]);
+    }
+}
+
+- (void)testColumns
+{
+    //A tall image beside two rows of text is read before the text
+    UBKReadingOrderNode nodes[3] = {
+        [self nodeWithFrame:(UBKRect){80, 0, 200, 20} group:-1 isGroup:false],
+        [self nodeWithFrame:(UBKRect){80, 30, 200, 20} group:-1 isGroup:false],
+        [self nodeWithFrame:(UBKRect){0, 0, 60, 60} group:-1 isGroup:false]
+    };
+    uint32_t expectedOrder[3];
+    size_t elementCount = 0;
+    UBKReadingOrderResult results[3];
+    XCTAssertTrue(UBKReadingOrderAnalyse(nodes, 3, false, expectedOrder, &elementCount, results));
+    XCTAssertEqual(expectedOrder[0], 2);
+    XCTAssertEqual(expectedOrder[1], 0);
+    XCTAssertEqual(expectedOrder[2], 1);
+}
+
+- (void)testSnapshotReadingOrder
+{
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    UILabel *bottomLabel = [[UILabel alloc]initWithFrame:CGRectMake(10, 200, 100, 20)];
+    bottomLabel.isAccessibilityElement = true;
+    [containerView addSubview:bottomLabel];
+    UILabel *topLabel = [[UILabel alloc]initWithFrame:CGRectMake(10, 10, 100, 20)];
+    topLabel.isAccessibilityElement = true;
+    [containerView addSubview:topLabel];
+    UILabel *middleLabel = [[UILabel alloc]initWithFrame:CGRectMake(10, 100, 100, 20)];
+    middleLabel.isAccessibilityElement = true;
+    [containerView addSubview:middleLabel];
+    UILabel *hiddenLabel = [[UILabel alloc]initWithFrame:CGRectMake(10, 0, 100, 20)];
+    hiddenLabel.isAccessibilityElement = true;
+    hiddenLabel.hidden = true;
+    [containerView addSubview:hiddenLabel];
+    
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Test"];
+    [snapshot pushView:containerView isElement:false];
+    for (UIView *view in containerView.subviews)
+    {
+        [snapshot pushView:view isElement:true];
+        [snapshot popView];
+    }
+    [snapshot popView];
+    [snapshot finishSnapshot];
+    
+    UBKAccessibilityReadingOrder *readingOrder = [[UBKAccessibilityReadingOrder alloc]initWithSnapshot:snapshot rightToLeft:false];
+    XCTAssertEqual(readingOrder.elementCount, 3);
+    NSArray *expectedViews = @[topLabel, middleLabel, bottomLabel];
+    XCTAssertEqualObjects(readingOrder.orderedViews, expectedViews);
+    XCTAssertEqual([readingOrder readingPositionForView:bottomLabel], 2);
+    XCTAssertEqual([readingOrder readingPositionForView:hiddenLabel], NSNotFound);
+    XCTAssertEqual(readingOrder.outOfOrderCount, 1);
+    XCTAssertTrue([readingOrder isViewOutOfOrder:bottomLabel]);
+    XCTAssertFalse([readingOrder isViewOutOfOrder:topLabel]);
+    
+    uint64_t subtreeHash = snapshot.nodes[0].subtreeHash;
+    [readingOrder combineResultsIntoSnapshot];
+    [snapshot updateSubtreeHashes];
+    XCTAssertNotEqual(snapshot.nodes[0].subtreeHash, subtreeHash);
+}
+
+@end
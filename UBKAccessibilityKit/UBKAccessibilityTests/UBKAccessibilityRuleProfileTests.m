@@ -0,0 +1,115 @@
+/*
+ File: UBKAccessibilityRuleProfileTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityRuleProfileTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityRuleProfileTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+    [UBKAccessibilityManager sharedInstance].ruleProfile = UBKRuleProfileWCAG21;
+}
+
+- (void)testTextContrastRatings
+{
+    const UBKRuleEvaluator *evaluator = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG21);
+    XCTAssertEqual(UBKRuleEvaluatorTextContrastRating(evaluator, 0, 0, false), UBKRuleRatingNA);
+    XCTAssertEqual(UBKRuleEvaluatorTextContrastRating(evaluator, 7.0, 14, false), UBKRuleRatingAAA);
+    XCTAssertEqual(UBKRuleEvaluatorTextContrastRating(evaluator, 4.5, 14, false), UBKRuleRatingAA);
+    XCTAssertEqual(UBKRuleEvaluatorTextContrastRating(evaluator, 4.49, 14, false), UBKRuleRatingFail);
+    //Large text
+    XCTAssertEqual(UBKRuleEvaluatorTextContrastRating(evaluator, 3.0, 18.66, true), UBKRuleRatingAALarge);
+    XCTAssertEqual(UBKRuleEvaluatorTextContrastRating(evaluator, 3.0, 18.66, false), UBKRuleRatingFail);
+    XCTAssertEqual(UBKRuleEvaluatorTextContrastRating(evaluator, 4.5, 24, false), UBKRuleRatingAAALarge);
+}
+
+- (void)testBuiltInProfiles
+{
+    const UBKRuleEvaluator *wcag20 = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG20);
+    const UBKRuleEvaluator *wcag21 = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG21);
+    const UBKRuleEvaluator *wcag22 = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG22);
+    XCTAssertTrue(UBKRuleEvaluatorForProfile(UBKRuleProfileCustom) == NULL);
+    
+    //Non text contrast arrived in 2.1
+    XCTAssertEqual(UBKRuleEvaluatorNonTextContrastRating(wcag20, 1.5), UBKRuleRatingNA);
+    XCTAssertEqual(UBKRuleEvaluatorNonTextContrastRating(wcag21, 1.5), UBKRuleRatingFail);
+    XCTAssertEqual(UBKRuleEvaluatorNonTextContrastRating(wcag21, 3.0), UBKRuleRatingAA);
+    XCTAssertEqual(UBKRuleEvaluatorNonTextContrastRating(wcag22, 4.5), UBKRuleRatingAAA);
+    
+    XCTAssertFalse(UBKRuleEvaluatorIsBelowMinimumTargetSize(wcag20, 10, 10));
+    XCTAssertTrue(UBKRuleEvaluatorIsBelowMinimumTargetSize(wcag21, 30, 44));
+    XCTAssertFalse(UBKRuleEvaluatorIsBelowMinimumTargetSize(wcag21, 44, 44));
+    XCTAssertFalse(UBKRuleEvaluatorIsBelowMinimumTargetSize(wcag22, 30, 24));
+    XCTAssertTrue(UBKRuleEvaluatorIsBelowMinimumTargetSize(wcag22, 23, 30));
+}
+
+- (void)testCustomProfileMatchesBuiltIn
+{
+    //A custom profile with the same thresholds gives the same answers as the specialised one
+    const UBKRuleEvaluator *wcag22 = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG22);
+    UBKRuleEvaluator custom = UBKRuleEvaluatorMakeCustom(wcag22->thresholds);
+    for (int size = 0; size <= 30; size++)
+    {
+        for (int contrast = 0; contrast <= 210; contrast++)
+        {
+            double ratio = contrast / 10.0;
+            XCTAssertEqual(UBKRuleEvaluatorTextContrastRating(&custom, ratio, size, size % 2), UBKRuleEvaluatorTextContrastRating(wcag22, ratio, size, size % 2));
+            XCTAssertEqual(UBKRuleEvaluatorNonTextContrastRating(&custom, ratio), UBKRuleEvaluatorNonTextContrastRating(wcag22, ratio));
+        }
+        XCTAssertEqual(UBKRuleEvaluatorIsBelowMinimumTargetSize(&custom, size, 40), UBKRuleEvaluatorIsBelowMinimumTargetSize(wcag22, size, 40));
+    }
+}
+
+- (void)testManagerProfileSelection
+{
+    UBKAccessibilityManager *manager = [UBKAccessibilityManager sharedInstance];
+    UIButton *button = [UIButton buttonWithType:UIButtonTypeSystem];
+    button.frame = CGRectMake(0, 0, 30, 30);
+    
+    manager.ruleProfile = UBKRuleProfileWCAG21;
+    XCTAssertTrue([UBKAccessibilityValidation hasMinimumSizeWarning:button]);
+    XCTAssertEqualObjects([UBKAccessibilityValidation getMinimumSizeWarningTitle:button], @"Less than 44 x 44");
+    
+    manager.ruleProfile = UBKRuleProfileWCAG22;
+    XCTAssertFalse([UBKAccessibilityValidation hasMinimumSizeWarning:button]);
+    
+    UBKRuleThresholds thresholds = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG22)->thresholds;
+    thresholds.minimumTargetSize = 32;
+    thresholds.textAA = 5;
+    manager.customRuleThresholds = thresholds;
+    manager.ruleProfile = UBKRuleProfileCustom;
+    XCTAssertTrue([UBKAccessibilityValidation hasMinimumSizeWarning:button]);
+    XCTAssertEqualObjects([UBKAccessibilityValidation getMinimumSizeWarningTitle:button], @"Less than 32 x 32");
+    XCTAssertEqual([UBKAccessibilityValidation getColourContrastRatingForText:4.6 withTextSize:14 withBoldFont:false], ColourContrastRatingFail);
+    manager.customRuleThresholds = UBKRuleEvaluatorForProfile(UBKRuleProfileWCAG21)->thresholds;
+}
+
+@end
@@ -0,0 +1,125 @@
+/*
+ File: UBKAccessibilitySamplingTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <XCTest/XCTest.h>
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilitySamplingTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilitySamplingTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (void)testSampleRate
+{
+    UBKSamplingConfiguration configuration = UBKSamplingDefaultConfiguration();
+    configuration.budget = 1;
+    UBKSamplingGovernor governor;
+    UBKSamplingGovernorInit(&governor, &configuration, 42, 0);
+    NSUInteger sampledCount = 0;
+    for (NSUInteger i = 1; i <= 10000; i++)
+    {
+        if (UBKSamplingGovernorScreenDidAppear(&governor, i) == UBKSamplingDecisionSample)
+        {
+            sampledCount++;
+        }
+    }
+    XCTAssertEqualWithAccuracy(sampledCount, 1000, 100);
+    XCTAssertEqual(governor.decisionCounts[UBKSamplingDecisionSkipRate], 10000 - sampledCount);
+}
+
+- (void)testBudget
+{
+    UBKSamplingConfiguration configuration = UBKSamplingDefaultConfiguration();
+    configuration.sampleRate = 1;
+    UBKSamplingGovernor governor;
+    UBKSamplingGovernorInit(&governor, &configuration, 1, 0);
+    
+    //Nothing is saved up at launch
+    XCTAssertEqual(UBKSamplingGovernorScreenDidAppear(&governor, 0), UBKSamplingDecisionSkipBudget);
+    XCTAssertEqualWithAccuracy(UBKSamplingGovernorAvailableTime(&governor, 2), 0.01, 0.000001);
+    XCTAssertEqualWithAccuracy(UBKSamplingGovernorAvailableTime(&governor, 1000), configuration.maximumCredit, 0.000001);
+    
+    //Overspending is paid back before anything else runs
+    UBKSamplingGovernorSpend(&governor, 0.15);
+    XCTAssertEqual(UBKSamplingGovernorAvailableTime(&governor, 1019), 0);
+    XCTAssertTrue(UBKSamplingGovernorAvailableTime(&governor, 1021) > 0);
+    
+    //Spending everything on offer for an hour of frames stays within the budget
+    UBKSamplingGovernorInit(&governor, &configuration, 1, 0);
+    for (double now = 0; now < 3600; now += 1.0 / 60)
+    {
+        double available = UBKSamplingGovernorAvailableTime(&governor, now);
+        if (available > 0)
+        {
+            UBKSamplingGovernorSpend(&governor, available + 0.003);
+        }
+    }
+    XCTAssertTrue(governor.spentTime <= 3600 * configuration.budget + configuration.maximumCredit + 0.003);
+}
+
+- (void)testBackoff
+{
+    UBKSamplingConfiguration configuration = UBKSamplingDefaultConfiguration();
+    UBKSamplingGovernor governor;
+    UBKSamplingGovernorInit(&governor, &configuration, 1, 0);
+    for (NSUInteger i = 0; i < 10; i++)
+    {
+        XCTAssertFalse(UBKSamplingGovernorRecordFrame(&governor, 1.0 / 60, i / 60.0));
+    }
+    XCTAssertFalse(UBKSamplingGovernorRecordFrame(&governor, 0.03, 1));
+    XCTAssertTrue(UBKSamplingGovernorRecordFrame(&governor, 0.06, 1.1));
+    XCTAssertEqual(governor.backoff, configuration.minimumBackoff);
+    XCTAssertEqual(UBKSamplingGovernorAvailableTime(&governor, 3), 0);
+    
+    //Slow again soon after, the back off doubles
+    XCTAssertTrue(UBKSamplingGovernorRecordFrame(&governor, 0.06, 4));
+    XCTAssertEqual(governor.backoff, configuration.minimumBackoff * 2);
+    
+    //Slow again much later, it starts over
+    XCTAssertTrue(UBKSamplingGovernorRecordFrame(&governor, 0.06, 100));
+    XCTAssertEqual(governor.backoff, configuration.minimumBackoff);
+}
+
+- (void)testAuditCost
+{
+    UBKSamplingConfiguration configuration = UBKSamplingDefaultConfiguration();
+    UBKSamplingGovernor governor;
+    UBKSamplingGovernorInit(&governor, &configuration, 1, 0);
+    UBKSamplingGovernorRecordAudit(&governor, 100, 0.01);
+    XCTAssertEqualWithAccuracy(UBKSamplingGovernorEstimatedAuditCost(&governor, 200), 0.02, 0.000001);
+    XCTAssertFalse(UBKSamplingGovernorCanAudit(&governor, 100, 3));
+    XCTAssertTrue(UBKSamplingGovernorCanAudit(&governor, 100, 5));
+    //Audits bigger than the saved up credit never start
+    XCTAssertTrue(UBKSamplingGovernorIsAuditTooExpensive(&governor, 100000));
+    XCTAssertFalse(UBKSamplingGovernorCanAudit(&governor, 100000, 100));
+}
+
+@end
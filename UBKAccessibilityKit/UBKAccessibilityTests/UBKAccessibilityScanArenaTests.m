@@ -0,0 +1,129 @@
+/*
+ File: UBKAccessibilityScanArenaTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityScanArenaTests : XCTestCase
+@property (nonatomic) UIView *containerView;
+@end
+
+@implementation UBKAccessibilityScanArenaTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+    self.containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    self.containerView.backgroundColor = [UIColor whiteColor];
+    //Enough nodes to need more than one block the first time
+    for (NSUInteger i = 0; i < 1000; i++)
+    {
+        UILabel *label = [[UILabel alloc]initWithFrame:CGRectMake(0, i * 20, 100, 20)];
+        label.text = [NSString stringWithFormat:@"Row %lu", (unsigned long)i];
+        [self.containerView addSubview:label];
+    }
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (UBKAccessibilitySnapshot *)createSnapshot
+{
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Test"];
+    [snapshot pushView:self.containerView isElement:false];
+    for (UIView *view in self.containerView.subviews)
+    {
+        [snapshot pushView:view isElement:true];
+        [snapshot popView];
+    }
+    [snapshot popView];
+    [snapshot finishSnapshot];
+    return snapshot;
+}
+
+- (void)testRepeatedScansTakeNoMemoryFromTheSystem
+{
+    size_t firstBytesUsed = 0;
+    for (NSUInteger scan = 0; scan < 4; scan++)
+    {
+        @autoreleasepool {
+            UBKAccessibilitySnapshot *snapshot = [self createSnapshot];
+            UBKAccessibilityVisibility *visibility = [[UBKAccessibilityVisibility alloc]initWithSnapshot:snapshot bounds:self.containerView.bounds];
+            UBKAccessibilityTargetSpacing *targetSpacing = [[UBKAccessibilityTargetSpacing alloc]initWithSnapshot:snapshot spacing:24];
+            UBKAccessibilityReadingOrder *readingOrder = [[UBKAccessibilityReadingOrder alloc]initWithSnapshot:snapshot rightToLeft:false];
+            UBKAccessibilityLabels *labels = [[UBKAccessibilityLabels alloc]initWithSnapshot:snapshot];
+            UBKAccessibilitySubtreeGroups *subtreeGroups = [[UBKAccessibilitySubtreeGroups alloc]initWithSnapshot:snapshot];
+            XCTAssertEqual(readingOrder.elementCount, 1000);
+            XCTAssertNotNil(visibility);
+            XCTAssertNotNil(targetSpacing);
+            XCTAssertNotNil(labels);
+            XCTAssertNotNil(subtreeGroups);
+            
+            XCTAssertGreaterThan(snapshot.scanArena.allocations, 0);
+            if (scan == 0)
+            {
+                firstBytesUsed = snapshot.scanArena.bytesUsed;
+            }
+            else
+            {
+                //The arena from the last scan comes back from the pool, already big enough
+                XCTAssertEqual(snapshot.scanArena.systemAllocations, 0);
+                XCTAssertEqual(snapshot.scanArena.bytesUsed, firstBytesUsed);
+            }
+        }
+    }
+}
+
+- (void)testPassesKeepTheArenaAlive
+{
+    __weak UBKAccessibilityScanArena *weakScanArena = nil;
+    UBKAccessibilityLabels *labels = nil;
+    @autoreleasepool {
+        UBKAccessibilitySnapshot *snapshot = [self createSnapshot];
+        weakScanArena = snapshot.scanArena;
+        labels = [[UBKAccessibilityLabels alloc]initWithSnapshot:snapshot];
+    }
+    @autoreleasepool {
+        XCTAssertNotNil(weakScanArena);
+        XCTAssertEqual(labels.labelledCount, 1000);
+        XCTAssertEqual([labels flagsForView:self.containerView.subviews.firstObject], 0);
+    }
+    
+    labels = nil;
+    XCTAssertNil(weakScanArena);
+}
+
+- (void)testAllocationsAreZeroed
+{
+    UBKAccessibilityScanArena *scanArena = [UBKAccessibilityScanArena scanArena];
+    uint64_t *values = [scanArena allocateCount:100 size:sizeof(uint64_t)];
+    XCTAssertTrue(values != NULL);
+    XCTAssertEqual((uintptr_t)values % 16, 0);
+    for (NSUInteger i = 0; i < 100; i++)
+    {
+        XCTAssertEqual(values[i], 0);
+    }
+    XCTAssertTrue([scanArena allocateCount:SIZE_MAX / 4 size:8] == NULL);
+}
+
+@end
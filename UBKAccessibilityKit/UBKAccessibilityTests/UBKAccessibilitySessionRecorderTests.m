@@ -0,0 +1,129 @@
+/*
+ File: UBKAccessibilitySessionRecorderTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilitySessionRecorderTests : XCTestCase
+@property (nonatomic) NSURL *fileURL;
+@end
+
+@implementation UBKAccessibilitySessionRecorderTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+    self.fileURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()]URLByAppendingPathComponent:[NSString stringWithFormat:@"%@.jsonl", [NSUUID UUID].UUIDString]];
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+    [[NSFileManager defaultManager]removeItemAtURL:self.fileURL error:nil];
+}
+
+- (UBKAccessibilitySnapshot *)createSnapshotWithScreenName:(NSString *)screenName buttonIdentifier:(NSString *)identifier
+{
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    UILabel *label = [[UILabel alloc]initWithFrame:CGRectMake(0, 0, 100, 20)];
+    label.text = @"test";
+    [containerView addSubview:label];
+    UIButton *button = [UIButton buttonWithType:UIButtonTypeSystem];
+    button.frame = CGRectMake(0, 40, 20, 20);
+    button.accessibilityIdentifier = identifier;
+    [containerView addSubview:button];
+    
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:screenName];
+    [snapshot pushView:containerView isElement:false];
+    for (UIView *view in containerView.subviews)
+    {
+        [snapshot pushView:view isElement:true];
+        [snapshot popView];
+    }
+    [snapshot popView];
+    [snapshot finishSnapshot];
+    return snapshot;
+}
+
+- (void)testHashSet
+{
+    UBKHashSet set;
+    XCTAssertTrue(UBKHashSetInit(&set, 4));
+    for (uint64_t i = 0; i < 1000; i++)
+    {
+        XCTAssertTrue(UBKHashSetInsert(&set, i * 7919));
+    }
+    XCTAssertEqual(set.count, 1000);
+    XCTAssertFalse(UBKHashSetInsert(&set, 0), @"Zero hash should already be in the set");
+    XCTAssertTrue(UBKHashSetContains(&set, 999 * 7919));
+    XCTAssertFalse(UBKHashSetContains(&set, 1));
+    UBKHashSetDestroy(&set);
+}
+
+- (void)testSnapshotStructure
+{
+    UBKAccessibilitySnapshot *snapshot = [self createSnapshotWithScreenName:@"TestViewController" buttonIdentifier:@"button"];
+    XCTAssertEqual(snapshot.nodeCount, 3);
+    XCTAssertEqual(snapshot.nodes[0].parent, -1);
+    XCTAssertEqual(snapshot.nodes[0].subtreeEnd, 3);
+    XCTAssertEqual(snapshot.nodes[2].parent, 0);
+    XCTAssertEqual(snapshot.nodes[2].depth, 1);
+    XCTAssertTrue(snapshot.nodes[2].flags & UBKSnapshotNodeFlagElement);
+}
+
+- (void)testScreenFingerprint
+{
+    UBKAccessibilitySnapshot *snapshotOne = [self createSnapshotWithScreenName:@"TestViewController" buttonIdentifier:@"button"];
+    UBKAccessibilitySnapshot *snapshotTwo = [self createSnapshotWithScreenName:@"TestViewController" buttonIdentifier:@"button"];
+    UBKAccessibilitySnapshot *snapshotThree = [self createSnapshotWithScreenName:@"TestViewController" buttonIdentifier:@"otherButton"];
+    UBKAccessibilitySnapshot *snapshotFour = [self createSnapshotWithScreenName:@"OtherViewController" buttonIdentifier:@"button"];
+    
+    XCTAssertEqual(snapshotOne.fingerprint, snapshotTwo.fingerprint, @"Same structure should have the same fingerprint");
+    XCTAssertNotEqual(snapshotOne.fingerprint, snapshotThree.fingerprint, @"Identifiers should change the fingerprint");
+    XCTAssertNotEqual(snapshotOne.fingerprint, snapshotFour.fingerprint, @"Screen name should change the fingerprint");
+}
+
+- (void)testRecorderDeduplication
+{
+    UBKAccessibilitySessionRecorder *recorder = [[UBKAccessibilitySessionRecorder alloc]initWithFileURL:self.fileURL capacity:2];
+    
+    XCTAssertNotNil([recorder recordSnapshot:[self createSnapshotWithScreenName:@"ScreenOne" buttonIdentifier:@"button"]]);
+    XCTAssertNil([recorder recordSnapshot:[self createSnapshotWithScreenName:@"ScreenOne" buttonIdentifier:@"button"]], @"Screen already recorded");
+    UBKAccessibilityScreenAudit *audit = [recorder recordSnapshot:[self createSnapshotWithScreenName:@"ScreenTwo" buttonIdentifier:@"button"]];
+    [recorder recordSnapshot:[self createSnapshotWithScreenName:@"ScreenThree" buttonIdentifier:@"button"]];
+    
+    XCTAssertEqual(audit.elementCount, 2);
+    XCTAssertTrue(audit.warningTypeMask & (1ULL << UBKAccessibilityWarningTypeMinimumSize), @"Small button not failing");
+    XCTAssertEqual(recorder.recordedScreenCount, 3);
+    XCTAssertEqual(recorder.skippedSnapshotCount, 1);
+    
+    //Ring buffer only keeps the last two screens
+    NSArray *recentAudits = recorder.recentAudits;
+    XCTAssertEqual(recentAudits.count, 2);
+    XCTAssertEqualObjects([recentAudits.firstObject screenName], @"ScreenTwo");
+    XCTAssertEqualObjects([recentAudits.lastObject screenName], @"ScreenThree");
+    
+    //Every recorded screen is a line in the file
+    [recorder closeFile];
+    NSString *contents = [NSString stringWithContentsOfURL:self.fileURL encoding:NSUTF8StringEncoding error:nil];
+    NSArray *lines = [[contents stringByTrimmingCharactersInSet:[NSCharacterSet newlineCharacterSet]]componentsSeparatedByString:@"\n"];
+    XCTAssertEqual(lines.count, 3);
+}
+
+@end
@@ -0,0 +1,162 @@
+/*
+ File: UBKAccessibilitySubtreeGroupsTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <XCTest/XCTest.h>
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilitySubtreeGroupsTests : XCTestCase
+@property (nonatomic) UIView *containerView;
+@property (nonatomic) NSMutableArray <UILabel *> *titleLabels;
+@end
+
+@implementation UBKAccessibilitySubtreeGroupsTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+    //A list of 20 rows, each with a title and two icons. The titles all say something different.
+    self.containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 2000)];
+    self.containerView.backgroundColor = [UIColor whiteColor];
+    self.titleLabels = [[NSMutableArray alloc]init];
+    for (NSUInteger row = 0; row < 20; row++)
+    {
+        UIView *rowView = [[UIView alloc]initWithFrame:CGRectMake(0, row * 60, 320, 60)];
+        [self.containerView addSubview:rowView];
+        UILabel *titleLabel = [[UILabel alloc]initWithFrame:CGRectMake(10, 10, 200, 20)];
+        titleLabel.text = [NSString stringWithFormat:@"Row %lu", (unsigned long)row];
+        [rowView addSubview:titleLabel];
+        [self.titleLabels addObject:titleLabel];
+        for (NSUInteger icon = 0; icon < 2; icon++)
+        {
+            UIImageView *iconView = [[UIImageView alloc]initWithFrame:CGRectMake(220 + icon * 44, 10, 30, 30)];
+            [rowView addSubview:iconView];
+        }
+    }
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (UBKAccessibilitySnapshot *)createSnapshot
+{
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Test"];
+    [self pushView:self.containerView toSnapshot:snapshot];
+    [snapshot finishSnapshot];
+    return snapshot;
+}
+
+- (void)pushView:(UIView *)view toSnapshot:(UBKAccessibilitySnapshot *)snapshot
+{
+    [snapshot pushView:view isElement:(view.subviews.count == 0)];
+    for (UIView *subview in view.subviews)
+    {
+        [self pushView:subview toSnapshot:snapshot];
+    }
+    [snapshot popView];
+}
+
+- (void)testRepeatedRowsAreGrouped
+{
+    UBKAccessibilitySnapshot *snapshot = [self createSnapshot];
+    UBKAccessibilitySubtreeGroups *groups = [[UBKAccessibilitySubtreeGroups alloc]initWithSnapshot:snapshot];
+    
+    //Every row after the first shares the first row's results, and the second icon shares the first icon's
+    UIView *firstRow = self.containerView.subviews[0];
+    XCTAssertEqual(groups.sharedNodeCount, 19 * 4 + 1);
+    XCTAssertEqual([groups repeatCountForView:firstRow], 20);
+    XCTAssertEqual([groups repeatCountForView:self.titleLabels[0]], 20);
+    XCTAssertEqual([groups repeatCountForView:firstRow.subviews[1]], 40);
+    XCTAssertEqual([groups repeatCountForView:self.titleLabels[5]], 0);
+    XCTAssertEqual([groups representativeOfView:self.titleLabels[5]], self.titleLabels[0]);
+    XCTAssertEqual([groups representativeOfView:self.containerView.subviews[7].subviews[2]], firstRow.subviews[1]);
+    XCTAssertEqual([groups repeatCountForView:self.containerView], 1);
+}
+
+- (void)testDifferentRowIsNotGrouped
+{
+    //A row with a failing contrast doesn't share the results of the others
+    self.titleLabels[3].textColor = [UIColor colorWithWhite:0.9 alpha:1];
+    self.titleLabels[8].text = nil;
+    UBKAccessibilitySubtreeGroups *groups = [[UBKAccessibilitySubtreeGroups alloc]initWithSnapshot:[self createSnapshot]];
+    XCTAssertEqual([groups repeatCountForView:self.titleLabels[0]], 18);
+    XCTAssertEqual([groups representativeOfView:self.titleLabels[3]], self.titleLabels[3]);
+    XCTAssertEqual([groups representativeOfView:self.titleLabels[8]], self.titleLabels[8]);
+    //The icons of those rows still match the icons of the other rows
+    XCTAssertEqual([groups representativeOfView:self.containerView.subviews[3].subviews[1]], self.containerView.subviews[3].subviews[1]);
+    XCTAssertEqual([groups repeatCountForView:self.containerView.subviews[3].subviews[1]], 2);
+}
+
+- (void)testRuleRelevantPropertiesOfControlsAndImagesAreNotGrouped
+{
+    //Only template images get the tint contrast check
+    UIGraphicsBeginImageContext(CGSizeMake(30, 30));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    for (UIView *rowView in self.containerView.subviews)
+    {
+        ((UIImageView *)rowView.subviews[1]).image = image;
+        ((UIImageView *)rowView.subviews[2]).image = image;
+    }
+    UIImageView *templateIconView = self.containerView.subviews[4].subviews[1];
+    templateIconView.image = [image imageWithRenderingMode:UIImageRenderingModeAlwaysTemplate];
+
+    //Buttons with different title colours for a state rate differently
+    for (UIView *rowView in self.containerView.subviews)
+    {
+        UIButton *button = [UIButton buttonWithType:UIButtonTypeSystem];
+        button.frame = CGRectMake(10, 30, 100, 30);
+        [button setTitle:@"Open" forState:UIControlStateNormal];
+        [rowView addSubview:button];
+    }
+    UIButton *disabledColourButton = self.containerView.subviews[6].subviews[3];
+    [disabledColourButton setTitleColor:[UIColor colorWithWhite:0.95 alpha:1] forState:UIControlStateDisabled];
+
+    UBKAccessibilitySubtreeGroups *groups = [[UBKAccessibilitySubtreeGroups alloc]initWithSnapshot:[self createSnapshot]];
+    XCTAssertEqual([groups representativeOfView:templateIconView], templateIconView);
+    XCTAssertEqual([groups representativeOfView:disabledColourButton], disabledColourButton);
+    XCTAssertEqual([groups repeatCountForView:self.containerView.subviews[0]], 18);
+}
+
+- (void)testAuditCacheSharesResults
+{
+    UBKAccessibilitySnapshot *snapshot = [self createSnapshot];
+    UBKAccessibilitySubtreeGroups *groups = [[UBKAccessibilitySubtreeGroups alloc]initWithSnapshot:snapshot];
+    UBKAccessibilityAuditCache *cache = [[UBKAccessibilityAuditCache alloc]init];
+    [cache updateWithSnapshot:snapshot subtreeGroups:groups];
+    
+    //One title and one icon are audited
+    XCTAssertEqual(cache.recomputedElementCount, 2);
+    XCTAssertEqual(cache.sharedElementCount, 58);
+    
+    //A shared view still gets its own details when they're read, eg for the inspector
+    NSArray *details = [cache accessibilityDetailsForView:self.titleLabels[5]];
+    XCTAssertEqual(details.count, self.titleLabels[5].ubk_accessibilityDetails.count);
+    XCTAssertNotEqual(details, [cache accessibilityDetailsForView:self.titleLabels[0]]);
+    
+    //An unchanged list is reused whole on the next refresh
+    snapshot = [self createSnapshot];
+    [cache updateWithSnapshot:snapshot subtreeGroups:[[UBKAccessibilitySubtreeGroups alloc]initWithSnapshot:snapshot]];
+    XCTAssertEqual(cache.recomputedNodeCount, 0);
+    XCTAssertEqual(cache.reusedNodeCount, snapshot.nodeCount);
+}
+
+@end
@@ -0,0 +1,179 @@
+/*
+ File: UBKAccessibilityTargetSpacingTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityTargetSpacingTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityTargetSpacingTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (UBKTarget)targetWithFrame:(UBKRect)frame index:(uint32_t)index
+{
+    UBKTarget target;
+    target.frame = frame;
+    target.index = index;
+    target.subtreeEnd = index + 1;
+    return target;
+}
+
+- (void)testOverlapAndSpacing
+{
+    UBKTarget targets[5] = {
+        //Overlapping pair
+        [self targetWithFrame:(UBKRect){0, 0, 44, 44} index:0],
+        [self targetWithFrame:(UBKRect){30, 30, 44, 44} index:1],
+        //Small targets 4pt apart
+        [self targetWithFrame:(UBKRect){200, 0, 16, 16} index:2],
+        [self targetWithFrame:(UBKRect){220, 0, 16, 16} index:3],
+        //On its own
+        [self targetWithFrame:(UBKRect){0, 400, 16, 16} index:4]
+    };
+    UBKTargetSpacingResult results[5];
+    XCTAssertTrue(UBKTargetSpacingAnalyse(targets, 5, 24, results));
+    
+    XCTAssertEqual(results[0].flags, UBKTargetSpacingFlagOverlap);
+    XCTAssertEqual(results[0].conflict, 1);
+    XCTAssertEqual(results[1].flags, UBKTargetSpacingFlagOverlap);
+    XCTAssertEqual(results[2].flags, UBKTargetSpacingFlagTooClose);
+    XCTAssertEqual(results[3].conflict, 2);
+    XCTAssertEqualWithAccuracy(results[3].distance, 4, 0.001);
+    XCTAssertEqual(results[4].flags, 0);
+    XCTAssertEqual(results[4].conflict, -1);
+}
+
+- (void)testLargeTargetsOnlyCheckOverlap
+{
+    //Targets at least the spacing in size can sit next to each other
+    UBKTarget targets[2] = {
+        [self targetWithFrame:(UBKRect){0, 0, 44, 44} index:0],
+        [self targetWithFrame:(UBKRect){46, 0, 44, 44} index:1]
+    };
+    UBKTargetSpacingResult results[2];
+    XCTAssertTrue(UBKTargetSpacingAnalyse(targets, 2, 24, results));
+    XCTAssertEqual(results[0].flags, 0);
+    XCTAssertEqual(results[1].flags, 0);
+}
+
+- (void)testNestedTargetsAreSkipped
+{
+    UBKTarget targets[2] = {
+        [self targetWithFrame:(UBKRect){0, 0, 320, 60} index:0],
+        [self targetWithFrame:(UBKRect){10, 10, 20, 20} index:1]
+    };
+    targets[0].subtreeEnd = 2;
+    UBKTargetSpacingResult results[2];
+    XCTAssertTrue(UBKTargetSpacingAnalyse(targets, 2, 24, results));
+    XCTAssertEqual(results[0].flags, 0);
+    XCTAssertEqual(results[1].flags, 0);
+}
+
+- (void)testSweepMatchesPairwise
+{
+    //Keyboard like grid, compare the sweep against checking every pair on its own
+    const size_t count = 400;
+    UBKTarget *targets = malloc(count * sizeof(UBKTarget));
+    UBKTargetSpacingResult *results = malloc(count * sizeof(UBKTargetSpacingResult));
+    for (size_t i = 0; i < count; i++)
+    {
+        double x = (i % 20) * (18 + (i % 3));
+        double y = (i / 20) * (22 + (i % 5));
+        targets[i] = [self targetWithFrame:(UBKRect){x, y, 16 + (i % 7), 16 + (i % 11)} index:(uint32_t)i];
+    }
+    XCTAssertTrue(UBKTargetSpacingAnalyse(targets, count, 24, results));
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t expectedFlags = 0;
+        for (size_t j = 0; j < count; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+            UBKTarget pair[2] = { targets[i], targets[j] };
+            pair[0].index = 0;
+            pair[0].subtreeEnd = 1;
+            pair[1].index = 1;
+            pair[1].subtreeEnd = 2;
+            UBKTargetSpacingResult pairResults[2];
+            UBKTargetSpacingAnalyse(pair, 2, 24, pairResults);
+            expectedFlags |= pairResults[0].flags;
+        }
+        XCTAssertEqual(results[i].flags, expectedFlags);
+    }
+    free(targets);
+    free(results);
+}
+
+- (void)testSnapshotTargets
+{
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    UIButton *firstButton = [UIButton buttonWithType:UIButtonTypeSystem];
+    firstButton.frame = CGRectMake(10, 10, 20, 20);
+    [containerView addSubview:firstButton];
+    UIButton *secondButton = [UIButton buttonWithType:UIButtonTypeSystem];
+    secondButton.frame = CGRectMake(30, 10, 20, 20);
+    [containerView addSubview:secondButton];
+    UILabel *label = [[UILabel alloc]initWithFrame:CGRectMake(10, 34, 100, 20)];
+    [containerView addSubview:label];
+    UIButton *hiddenButton = [UIButton buttonWithType:UIButtonTypeSystem];
+    hiddenButton.frame = CGRectMake(10, 10, 20, 20);
+    hiddenButton.hidden = true;
+    [containerView addSubview:hiddenButton];
+    
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Test"];
+    [snapshot pushView:containerView isElement:false];
+    for (UIView *view in containerView.subviews)
+    {
+        [snapshot pushView:view isElement:true];
+        [snapshot popView];
+    }
+    [snapshot popView];
+    [snapshot finishSnapshot];
+    
+    UBKAccessibilityTargetSpacing *targetSpacing = [[UBKAccessibilityTargetSpacing alloc]initWithSnapshot:snapshot spacing:24];
+    XCTAssertEqual(targetSpacing.targetCount, 2);
+    XCTAssertEqual(targetSpacing.tooCloseCount, 2);
+    XCTAssertEqual(targetSpacing.overlapCount, 0);
+    XCTAssertEqual([targetSpacing flagsForView:firstButton], UBKTargetSpacingFlagTooClose);
+    XCTAssertEqual([targetSpacing conflictingViewForView:firstButton], secondButton);
+    XCTAssertEqual([targetSpacing flagsForView:label], 0);
+    XCTAssertEqual([targetSpacing flagsForView:hiddenButton], 0);
+    
+    uint64_t subtreeHash = snapshot.nodes[0].subtreeHash;
+    [targetSpacing combineResultsIntoSnapshot];
+    [snapshot updateSubtreeHashes];
+    XCTAssertNotEqual(snapshot.nodes[0].subtreeHash, subtreeHash);
+}
+
+@end
@@ -0,0 +1,138 @@
+/*
+ File: UBKAccessibilityTextRunsTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <XCTest/XCTest.h>
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityTextRunsTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityTextRunsTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (UILabel *)createLabelWithText:(NSAttributedString *)attributedText
+{
+    UILabel *label = [[UILabel alloc]initWithFrame:CGRectMake(0, 0, 300, 44)];
+    label.textColor = [UIColor blackColor];
+    label.backgroundColor = [UIColor whiteColor];
+    label.font = [UIFont systemFontOfSize:17];
+    label.attributedText = attributedText;
+    return label;
+}
+
+- (UBKAccessibilityTextRuns *)textRunsForLabel:(UILabel *)label
+{
+    return [[UBKAccessibilityTextRuns alloc]initWithAttributedText:label.attributedText textColour:label.textColor font:label.font forView:label backgroundColour:label.backgroundColor];
+}
+
+- (void)testPlainTextIsOneRun
+{
+    UILabel *label = [self createLabelWithText:[[NSAttributedString alloc]initWithString:@"Account balance"]];
+    UBKAccessibilityTextRuns *textRuns = [self textRunsForLabel:label];
+    XCTAssertEqual(textRuns.runCount, 1);
+    XCTAssertEqualWithAccuracy(textRuns.worstContrast, 21, 0.01);
+    XCTAssertNotEqual(textRuns.worstRating, ColourContrastRatingFail);
+    
+    //Empty text is still rated with the label's colour and font
+    label.text = nil;
+    textRuns = [self textRunsForLabel:label];
+    XCTAssertEqual(textRuns.runCount, 1);
+    XCTAssertEqual(textRuns.worstRunRange.length, 0);
+    XCTAssertEqualWithAccuracy(textRuns.worstTextSize, 17, 0.01);
+}
+
+- (void)testWorstRunIsReported
+{
+    NSMutableAttributedString *text = [[NSMutableAttributedString alloc]initWithString:@"Balance $10.00 Fees apply"];
+    NSRange feesRange = [text.string rangeOfString:@"Fees apply"];
+    [text addAttribute:NSForegroundColorAttributeName value:[UIColor colorWithWhite:0.75 alpha:1] range:feesRange];
+    [text addAttribute:NSFontAttributeName value:[UIFont systemFontOfSize:11] range:feesRange];
+    [text addAttribute:NSFontAttributeName value:[UIFont boldSystemFontOfSize:17] range:[text.string rangeOfString:@"$10.00"]];
+    UILabel *label = [self createLabelWithText:text];
+    
+    UBKAccessibilityTextRuns *textRuns = [self textRunsForLabel:label];
+    XCTAssertEqual(textRuns.runCount, 3);
+    XCTAssertTrue(NSEqualRanges(textRuns.worstRunRange, feesRange));
+    XCTAssertEqualObjects(textRuns.worstRunText, @"Fees apply");
+    XCTAssertEqual(textRuns.worstRating, ColourContrastRatingFail);
+    XCTAssertEqualWithAccuracy(textRuns.worstTextSize, 11, 0.01);
+    
+    //The label gets a contrast warning even though its text colour passes
+    UBKAccessibilitySection *warningsSection = [[label ubk_accessibilityDetails] ubk_sectionForTitleKey:kUBKAccessibilityAttributeTitle_Warning_Header];
+    XCTAssertNotNil([warningsSection getPropertyForTitleKey:kUBKAccessibilityAttributeTitle_Warning_ColourContrast]);
+    UBKAccessibilitySection *coloursSection = [[label ubk_accessibilityDetails] ubk_sectionForTitleKey:kUBKAccessibilityAttributeTitle_Colours];
+    XCTAssertEqualObjects([coloursSection getPropertyForTitleKey:kUBKAccessibilityAttributeTitle_LowestContrastRun].displayValue, @"Fees apply");
+    
+    //Changing the colour of the worst run leaves the rest of the text alone
+    UBKAccessibilityProperty *runColourProperty = [coloursSection getPropertyForTitleKey:kUBKAccessibilityAttributeTitle_LowestContrastRunColour];
+    runColourProperty.colourUpdateCompletionBlock([UIColor darkGrayColor]);
+    XCTAssertEqualObjects([label.attributedText attribute:NSForegroundColorAttributeName atIndex:feesRange.location effectiveRange:nil], [UIColor darkGrayColor]);
+    XCTAssertEqualWithAccuracy(((UIFont *)[label.attributedText attribute:NSFontAttributeName atIndex:feesRange.location effectiveRange:nil]).pointSize, 11, 0.01);
+    XCTAssertNotEqual([self textRunsForLabel:label].worstRating, ColourContrastRatingFail);
+}
+
+- (void)testRunBackgroundColour
+{
+    //White text is only readable on its own background
+    NSMutableAttributedString *text = [[NSMutableAttributedString alloc]initWithString:@"SALE" attributes:@{NSForegroundColorAttributeName: [UIColor whiteColor], NSBackgroundColorAttributeName: [UIColor blackColor]}];
+    UBKAccessibilityTextRuns *textRuns = [self textRunsForLabel:[self createLabelWithText:text]];
+    XCTAssertEqualWithAccuracy(textRuns.worstContrast, 21, 0.01);
+    XCTAssertEqualObjects(textRuns.worstBackgroundColour.ubk_hexStringFromColour, [UIColor blackColor].ubk_hexStringFromColour);
+    
+    [text removeAttribute:NSBackgroundColorAttributeName range:NSMakeRange(0, text.length)];
+    textRuns = [self textRunsForLabel:[self createLabelWithText:text]];
+    XCTAssertEqual(textRuns.worstRating, ColourContrastRatingFail);
+}
+
+- (void)testWhitespaceRunsAreSkipped
+{
+    NSMutableAttributedString *text = [[NSMutableAttributedString alloc]initWithString:@"One   Two"];
+    [text addAttribute:NSForegroundColorAttributeName value:[UIColor colorWithWhite:0.95 alpha:1] range:NSMakeRange(3, 3)];
+    UBKAccessibilityTextRuns *textRuns = [self textRunsForLabel:[self createLabelWithText:text]];
+    XCTAssertEqual(textRuns.runCount, 1);
+    XCTAssertTrue(NSEqualRanges(textRuns.worstRunRange, NSMakeRange(0, text.length)));
+    XCTAssertNotEqual(textRuns.worstRating, ColourContrastRatingFail);
+}
+
+- (void)testButtonSetColourKeepsRunColours
+{
+    UIButton *button = [UIButton buttonWithType:UIButtonTypeSystem];
+    NSMutableAttributedString *title = [[NSMutableAttributedString alloc]initWithString:@"Pay now" attributes:@{NSForegroundColorAttributeName: [UIColor blackColor]}];
+    [title addAttribute:NSForegroundColorAttributeName value:[UIColor redColor] range:NSMakeRange(4, 3)];
+    [button setAttributedTitle:title forState:UIControlStateNormal];
+    [button layoutIfNeeded];
+    button.titleLabel.textColor = [UIColor blackColor];
+    
+    [button ubk_setColour:[UIColor blueColor]];
+    XCTAssertEqualObjects([button.currentAttributedTitle attribute:NSForegroundColorAttributeName atIndex:0 effectiveRange:nil], [UIColor blueColor]);
+    XCTAssertEqualObjects([button.currentAttributedTitle attribute:NSForegroundColorAttributeName atIndex:4 effectiveRange:nil], [UIColor redColor]);
+}
+
+@end
@@ -0,0 +1,136 @@
+/*
+ File: UBKAccessibilityVisibilityTests.m
+ Project: UBKAccessibilityKit
+ Version: 1.0
+ 
+ Copyright 2019 UBank - a division of National Australia Bank Limited
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+ http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+
+
+#import <XCTest/XCTest.h>
+
+#import <UBKAccessibilityKit/UBKAccessibilityKit.h>
+
+@interface UBKAccessibilityVisibilityTests : XCTestCase
+
+@end
+
+@implementation UBKAccessibilityVisibilityTests
+
+- (void)setUp {
+    // Put setup code here. This method is called before the invocation of each test method in the class.
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+}
+
+- (void)pushNodeWithFrame:(UBKRect)frame flags:(uint32_t)flags intoSnapshot:(UBKSnapshot *)snapshot
+{
+    UBKSnapshotNode node = {0};
+    node.frame = frame;
+    node.flags = flags;
+    UBKSnapshotPushNode(snapshot, &node);
+}
+
+- (void)testClippingAndOcclusion
+{
+    UBKSnapshot snapshot;
+    UBKSnapshotInit(&snapshot);
+    uint32_t element = UBKSnapshotNodeFlagElement;
+    
+    [self pushNodeWithFrame:(UBKRect){0, 0, 320, 480} flags:0 intoSnapshot:&snapshot];
+    //Scroll view showing its first 100pt
+    [self pushNodeWithFrame:(UBKRect){0, 0, 320, 100} flags:UBKSnapshotNodeFlagClipsToBounds intoSnapshot:&snapshot];
+    [self pushNodeWithFrame:(UBKRect){0, 90, 100, 20} flags:element intoSnapshot:&snapshot];
+    UBKSnapshotPopNode(&snapshot);
+    [self pushNodeWithFrame:(UBKRect){0, 150, 100, 20} flags:element intoSnapshot:&snapshot];
+    UBKSnapshotPopNode(&snapshot);
+    UBKSnapshotPopNode(&snapshot);
+    //Covered by the two opaque views after it, neither covers it alone
+    [self pushNodeWithFrame:(UBKRect){10, 200, 50, 50} flags:element intoSnapshot:&snapshot];
+    UBKSnapshotPopNode(&snapshot);
+    [self pushNodeWithFrame:(UBKRect){0, 190, 35, 100} flags:UBKSnapshotNodeFlagOpaque intoSnapshot:&snapshot];
+    UBKSnapshotPopNode(&snapshot);
+    [self pushNodeWithFrame:(UBKRect){35, 190, 100, 100} flags:UBKSnapshotNodeFlagOpaque intoSnapshot:&snapshot];
+    UBKSnapshotPopNode(&snapshot);
+    //Translucent views don't cover anything
+    [self pushNodeWithFrame:(UBKRect){10, 300, 50, 50} flags:element intoSnapshot:&snapshot];
+    UBKSnapshotPopNode(&snapshot);
+    [self pushNodeWithFrame:(UBKRect){0, 300, 100, 100} flags:UBKSnapshotNodeFlagOpaque | UBKSnapshotNodeFlagTranslucent intoSnapshot:&snapshot];
+    UBKSnapshotPopNode(&snapshot);
+    //Off screen and empty
+    [self pushNodeWithFrame:(UBKRect){500, 0, 10, 10} flags:element intoSnapshot:&snapshot];
+    UBKSnapshotPopNode(&snapshot);
+    [self pushNodeWithFrame:(UBKRect){5, 5, 0, 10} flags:element intoSnapshot:&snapshot];
+    UBKSnapshotPopNode(&snapshot);
+    UBKSnapshotPopNode(&snapshot);
+    
+    UBKVisibilityResult results[11];
+    XCTAssertEqual(snapshot.count, 11);
+    XCTAssertTrue(UBKVisibilityAnalyse(snapshot.nodes, snapshot.count, (UBKRect){0, 0, 320, 480}, results));
+    
+    XCTAssertEqual(results[2].state, UBKVisibilityStateVisible);
+    XCTAssertEqualWithAccuracy(results[2].visibleArea, 1000, 0.001);
+    XCTAssertEqual(results[3].state, UBKVisibilityStateClipped);
+    XCTAssertEqual(results[4].state, UBKVisibilityStateOccluded);
+    XCTAssertEqual(results[7].state, UBKVisibilityStateVisible);
+    XCTAssertEqualWithAccuracy(results[7].visibleArea, 2500, 0.001);
+    XCTAssertEqual(results[9].state, UBKVisibilityStateClipped);
+    XCTAssertEqual(results[10].state, UBKVisibilityStateEmpty);
+    
+    UBKSnapshotDestroy(&snapshot);
+}
+
+- (void)testSnapshotCulling
+{
+    UIView *containerView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 320, 480)];
+    UILabel *coveredLabel = [[UILabel alloc]initWithFrame:CGRectMake(10, 10, 100, 20)];
+    [containerView addSubview:coveredLabel];
+    UIView *coverView = [[UIView alloc]initWithFrame:CGRectMake(0, 0, 200, 100)];
+    coverView.backgroundColor = [UIColor whiteColor];
+    [containerView addSubview:coverView];
+    UILabel *visibleLabel = [[UILabel alloc]initWithFrame:CGRectMake(10, 200, 100, 20)];
+    [containerView addSubview:visibleLabel];
+    
+    UBKAccessibilitySnapshot *snapshot = [[UBKAccessibilitySnapshot alloc]initWithScreenName:@"Test"];
+    [snapshot pushView:containerView isElement:false];
+    for (UIView *view in containerView.subviews)
+    {
+        [snapshot pushView:view isElement:true];
+        [snapshot popView];
+    }
+    [snapshot popView];
+    [snapshot finishSnapshot];
+    
+    UBKAccessibilityVisibility *visibility = [[UBKAccessibilityVisibility alloc]initWithSnapshot:snapshot bounds:containerView.bounds];
+    XCTAssertEqual(visibility.culledCount, 1);
+    XCTAssertEqual([visibility stateForView:coveredLabel], UBKVisibilityStateOccluded);
+    XCTAssertTrue([visibility isViewCulled:coveredLabel]);
+    XCTAssertFalse([visibility isViewCulled:visibleLabel]);
+    XCTAssertFalse([visibility isViewCulled:coverView]);
+    
+    uint64_t subtreeHash = snapshot.nodes[0].subtreeHash;
+    [visibility cullSnapshot];
+    [snapshot updateSubtreeHashes];
+    NSInteger coveredIndex = [snapshot indexOfView:coveredLabel];
+    XCTAssertEqual(snapshot.nodes[coveredIndex].flags & UBKSnapshotNodeFlagElement, 0);
+    XCTAssertNotEqual(snapshot.nodes[0].subtreeHash, subtreeHash);
+    //Still culled once the element flag is gone
+    XCTAssertTrue([visibility isViewCulled:coveredLabel]);
+}
+
+@end